@@ -73,6 +73,7 @@ OPTION ( CF_ENABLE_TESTCASES          "Enable checking testcases from CMake syst
 OPTION ( CF_ENABLE_UNITTESTS          "Enable creation of unit tests"            OFF )
 OPTION ( CF_ENABLE_WARNINGS           "Enable lots of warnings while compiling"  ON )
 OPTION ( CF_ENABLE_STDASSERT          "Enable standard assert() functions "  ON )
+OPTION ( CF_ENABLE_CPU_KERNELS        "Enable CPU build of the cell-based FiniteVolumeCUDA kernels" OFF )
 
 OPTION ( CF_ENABLE_PARALLEL_VERBOSE   "Enable extra output in the parallel interface" OFF  )
 OPTION ( CF_ENABLE_PARALLEL_DEBUG     "Enable debug code on the parallel interface"  OFF  )
@@ -11,6 +11,9 @@
 # - MPI (default: if HAVE_MPI then runs the case on default number of processors)
 #      number of processors to use for call with mpirun (it can be a list of numbers)
 #      the keyword "default" will take the global number CF_TESTING_NB_PROCS
+# - DEPENDS
+#      CFcases (relative to CASEDIR) which must run before this one, e.g. because
+#      they write the files it reads; they must be added before this case
 #
 # The two master switches turns each type on and off
 #   - CF_ENABLE_UNIT_CASES
@@ -30,7 +33,7 @@ function( cf_add_case )
 
   set( single_value_args UCASE PCASE CASEDIR )
 #  set( multi_value_args  MPI)
-  set( multi_value_args  MPI CASEFILES)
+  set( multi_value_args  MPI CASEFILES DEPENDS)
   
   set( _TEST_DIR ${CMAKE_CURRENT_BINARY_DIR} )
 
@@ -217,21 +220,52 @@ function( cf_add_case )
     CONFIGURE_FILE ( ${CMAKE_SOURCE_DIR}/${_TEST_CFCASE_SHORT} ${CMAKE_BINARY_DIR}/${_TEST_CFCASE_SHORT} @ONLY )
 
     # prepare test
+    set(_TEST_NAMES "")
     if(_RUN_MPI)
       foreach(nprocs ${_PAR_MPI})
         if ( "${nprocs}" STREQUAL "default" )
           add_test(NAME ${_TEST_TARGETNAME}_dprocs COMMAND ${CF_MPIRUN_PROGRAM} -np ${CF_TESTING_NB_PROCS} ${_TEST_COMMAND})
           #add_test(NAME ${_TEST_TARGETNAME}_dprocs WORKING_DIRECTORY ${_TEST_WDIR} COMMAND ${CF_MPIRUN_PROGRAM} -np ${CF_TESTING_NB_PROCS} ${_TEST_COMMAND})
+          list(APPEND _TEST_NAMES ${_TEST_TARGETNAME}_dprocs)
         else()
           add_test(NAME ${_TEST_TARGETNAME}_${nprocs}procs COMMAND ${CF_MPIRUN_PROGRAM} -np ${nprocs} ${_TEST_COMMAND})
           #add_test(NAME ${_TEST_TARGETNAME}_${nprocs}procs WORKING_DIRECTORY ${_TEST_WDIR} COMMAND ${CF_MPIRUN_PROGRAM} -np ${nprocs} ${_TEST_COMMAND})
+          list(APPEND _TEST_NAMES ${_TEST_TARGETNAME}_${nprocs}procs)
         endif()
       endforeach()
     else()
       add_test(NAME   ${_TEST_TARGETNAME}_serial COMMAND ${_TEST_COMMAND})
       #add_test(NAME   ${_TEST_TARGETNAME}_serial WORKING_DIRECTORY ${_TEST_WDIR} COMMAND ${_TEST_COMMAND})
+      list(APPEND _TEST_NAMES ${_TEST_TARGETNAME}_serial)
    endif()
 
+    # remember the tests of this case for the cases depending on it
+    set_property(GLOBAL PROPERTY CF_CASE_TESTS_${_TEST_TARGETNAME} ${_TEST_NAMES})
+
+    # the cases which this one depends on run first and, with fixtures (CMake >= 3.7),
+    # also when only this case is selected, which is skipped if they fail
+    foreach(adep ${_PAR_DEPENDS})
+      set(_DEP_TARGETNAME ${CMAKE_CURRENT_SOURCE_DIR}/${_PAR_CASEDIR}/${adep})
+      string(REPLACE ".CFcase" "" _DEP_TARGETNAME ${_DEP_TARGETNAME})
+      string(REPLACE "${CMAKE_SOURCE_DIR}/" "" _DEP_TARGETNAME ${_DEP_TARGETNAME})
+      string(REPLACE "/" "-" _DEP_TARGETNAME ${_DEP_TARGETNAME})
+      if(_PAR_UCASE)
+        set(_DEP_TARGETNAME "case-unit-${_DEP_TARGETNAME}")
+      else()
+        set(_DEP_TARGETNAME "case-perf-${_DEP_TARGETNAME}")
+      endif()
+      get_property(_DEP_TESTS GLOBAL PROPERTY CF_CASE_TESTS_${_DEP_TARGETNAME})
+      if(_DEP_TESTS)
+        set_property(TEST ${_TEST_NAMES} APPEND PROPERTY DEPENDS ${_DEP_TESTS})
+        if(NOT CMAKE_VERSION VERSION_LESS 3.7)
+          set_property(TEST ${_DEP_TESTS} APPEND PROPERTY FIXTURES_SETUP ${_DEP_TARGETNAME})
+          set_property(TEST ${_TEST_NAMES} APPEND PROPERTY FIXTURES_REQUIRED ${_DEP_TARGETNAME})
+        endif()
+      else()
+        message(WARNING "Test case ${_TEST_CFCASE_SHORT} depends on ${_PAR_CASEDIR}/${adep}, which is not added (yet): the dependency is ignored")
+      endif()
+    endforeach()
+
   endif( _TEST_BUILDS )
 
   # if installing
@@ -0,0 +1,464 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include "Common/CFLog.hh"
+#include "Framework/BadFormatException.hh"
+
+#include "CFmeshFileReader/ASCIIListParser.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+    namespace CFmeshFileReader {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// version of the format of the index file
+static const CFuint INDEX_FILE_VERSION = 1;
+
+/// powers of 10 which are exactly representable as double
+static const double EXACT_POWERS_OF_TEN[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// table of the white space characters
+struct SpaceTable {
+  SpaceTable()
+  {
+    for (CFuint i = 0; i < 256; ++i) {
+      isSpace[i] = false;
+    }
+    isSpace[static_cast<unsigned char>(' ')]  = true;
+    isSpace[static_cast<unsigned char>('\n')] = true;
+    isSpace[static_cast<unsigned char>('\r')] = true;
+    isSpace[static_cast<unsigned char>('\t')] = true;
+    isSpace[static_cast<unsigned char>('\v')] = true;
+    isSpace[static_cast<unsigned char>('\f')] = true;
+  }
+  bool isSpace[256];
+};
+
+static const SpaceTable SPACES;
+
+/// @return true if the character is a white space
+static inline bool isSpace(const char c)
+{
+  return SPACES.isSpace[static_cast<unsigned char>(c)];
+}
+
+/// @return true if the character is a decimal digit
+static inline bool isDigit(const char c)
+{
+  return static_cast<unsigned char>(c - '0') < 10;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ASCIIListParser::ASCIIListParser() :
+  m_file(),
+  m_fileName(),
+  m_pos(CFNULL),
+  m_end(CFNULL),
+  m_chunkSize(1),
+  m_indexes(),
+  m_newIndexes(false)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ASCIIListParser::~ASCIIListParser()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ASCIIListParser::open(const std::string& fileName, const CFuint chunkSize)
+{
+  m_file.open(fileName);
+  m_fileName = fileName;
+  m_pos = m_file.data();
+  m_end = m_file.data() + m_file.size();
+  m_chunkSize = std::max(chunkSize, static_cast<CFuint>(1));
+  m_indexes.clear();
+  m_newIndexes = false;
+
+  readIndexFile();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ASCIIListParser::close(const bool saveIndex)
+{
+  if (saveIndex && m_newIndexes) {
+    writeIndexFile();
+  }
+
+  m_file.close();
+  m_pos = CFNULL;
+  m_end = CFNULL;
+  m_indexes.clear();
+  m_newIndexes = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ASCIIListParser::seek(const size_t offset)
+{
+  cf_assert(offset <= m_file.size());
+  m_pos = m_file.data() + offset;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+const ASCIIListParser::ListIndex& ASCIIListParser::getListIndex
+(const std::string& key, const std::vector<RecordGroup>& groups)
+{
+  const size_t start = tell();
+  CFuint nbRecords = 0;
+  CFuint nbTokens = 0;
+  for (CFuint iGroup = 0; iGroup < groups.size(); ++iGroup) {
+    nbRecords += groups[iGroup].first;
+    nbTokens  += groups[iGroup].first*groups[iGroup].second;
+  }
+
+  map<string, ListIndex>::iterator itr = m_indexes.find(key);
+  if (itr != m_indexes.end() && itr->second.start == start &&
+      itr->second.nbRecords == nbRecords && itr->second.nbTokens == nbTokens) {
+    return itr->second;
+  }
+
+  CFLog(INFO, "ASCIIListParser::getListIndex() => indexing " << key << "\n");
+
+  // scan the list without converting the tokens
+  ListIndex& index = m_indexes[key];
+  index.start = start;
+  index.nbRecords = nbRecords;
+  index.nbTokens = nbTokens;
+  index.chunkSize = m_chunkSize;
+  index.offsets.clear();
+  index.offsets.reserve(nbRecords/m_chunkSize + 1);
+
+  CFuint iRecord = 0;
+  for (CFuint iGroup = 0; iGroup < groups.size(); ++iGroup) {
+    const CFuint nbTokensInRecord = groups[iGroup].second;
+    for (CFuint i = 0; i < groups[iGroup].first; ++i, ++iRecord) {
+      if (iRecord%m_chunkSize == 0) {
+        index.offsets.push_back(tell());
+      }
+      skip(nbTokensInRecord);
+    }
+  }
+  index.end = tell();
+
+  seek(start);
+  m_newIndexes = true;
+  return index;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint ASCIIListParser::seekChunk(const ListIndex& index, const CFuint iRecord)
+{
+  cf_assert(iRecord < index.nbRecords);
+  const CFuint iChunk = iRecord/index.chunkSize;
+  cf_assert(iChunk < index.offsets.size());
+  seek(index.offsets[iChunk]);
+  return iChunk*index.chunkSize;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ASCIIListParser::moveToRecord(const ListIndex& index, CFuint& iRecord,
+                                   const CFuint target, const CFuint nbTokens)
+{
+  // jump if the target is before the current record or in another chunk
+  if (target < iRecord || target/index.chunkSize != iRecord/index.chunkSize) {
+    iRecord = seekChunk(index, target);
+  }
+
+  skip((target - iRecord)*nbTokens);
+  iRecord = target;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ASCIIListParser::skipSpaces()
+{
+  while (m_pos < m_end && isSpace(*m_pos)) {
+    ++m_pos;
+  }
+
+  if (m_pos == m_end) {
+    throw BadFormatException
+      (FromHere(), "ASCIIListParser: unexpected end of file " + m_fileName);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ASCIIListParser::skip(const CFuint nbTokens)
+{
+  for (CFuint i = 0; i < nbTokens; ++i) {
+    skipSpaces();
+    while (m_pos < m_end && !isSpace(*m_pos)) {
+      ++m_pos;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ASCIIListParser& ASCIIListParser::operator>> (CFreal& value)
+{
+  skipSpaces();
+
+  const char* p = m_pos;
+  const bool negative = (*p == '-');
+  if (*p == '-' || *p == '+') {
+    ++p;
+  }
+
+  // accumulate up to 19 significant digits in an integer mantissa
+  boost::uint64_t mantissa = 0;
+  CFint exponent = 0;
+  CFuint nbDigits = 0;
+  bool hasDigits = false;
+  bool truncated = false;
+
+  for (; p < m_end && isDigit(*p); ++p) {
+    hasDigits = true;
+    if (nbDigits < 19) {
+      mantissa = 10*mantissa + (*p - '0');
+      if (mantissa > 0) ++nbDigits;
+    }
+    else {
+      ++exponent;
+      truncated = truncated || (*p != '0');
+    }
+  }
+
+  if (p < m_end && *p == '.') {
+    for (++p; p < m_end && isDigit(*p); ++p) {
+      hasDigits = true;
+      if (nbDigits < 19) {
+        mantissa = 10*mantissa + (*p - '0');
+        if (mantissa > 0) ++nbDigits;
+        --exponent;
+      }
+      else {
+        truncated = truncated || (*p != '0');
+      }
+    }
+  }
+
+  if (hasDigits && p < m_end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    const bool negativeExp = (p < m_end && *p == '-');
+    if (p < m_end && (*p == '-' || *p == '+')) {
+      ++p;
+    }
+
+    if (p == m_end || !isDigit(*p)) {
+      hasDigits = false;
+    }
+
+    CFint expValue = 0;
+    for (; p < m_end && isDigit(*p); ++p) {
+      if (expValue < 100000) expValue = 10*expValue + (*p - '0');
+    }
+    exponent += negativeExp ? -expValue : expValue;
+  }
+
+  // if the mantissa and the power of 10 are both exactly representable,
+  // a single multiplication or division gives the correctly rounded value
+  const boost::uint64_t maxExactMantissa = static_cast<boost::uint64_t>(1) << 53;
+  if (!hasDigits || truncated || (p < m_end && !isSpace(*p)) ||
+      mantissa > maxExactMantissa || exponent < -22 || exponent > 22) {
+    value = parseRealSlow(m_pos);
+    return *this;
+  }
+
+  double result = static_cast<double>(mantissa);
+  result = (exponent < 0) ? result/EXACT_POWERS_OF_TEN[-exponent] :
+    result*EXACT_POWERS_OF_TEN[exponent];
+  value = negative ? -result : result;
+  m_pos = p;
+  return *this;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal ASCIIListParser::parseRealSlow(const char* begin)
+{
+  const char* end = begin;
+  while (end < m_end && !isSpace(*end)) {
+    ++end;
+  }
+
+  // copy the token to have it null terminated
+  char token[64];
+  const size_t length = end - begin;
+  if (length >= sizeof(token)) {
+    throw BadFormatException
+      (FromHere(), "ASCIIListParser: token too long in " + m_fileName);
+  }
+  std::copy(begin, end, token);
+  token[length] = '\0';
+
+  char* tokenEnd = CFNULL;
+  const double value = strtod(token, &tokenEnd);
+  if (tokenEnd != token + length) {
+    throw BadFormatException
+      (FromHere(), "ASCIIListParser: could not read " + std::string(token) +
+       " as a real number in " + m_fileName);
+  }
+
+  m_pos = end;
+  return value;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ASCIIListParser& ASCIIListParser::operator>> (CFuint& value)
+{
+  skipSpaces();
+
+  const char* p = m_pos;
+  CFuint result = 0;
+  for (; p < m_end && isDigit(*p); ++p) {
+    result = 10*result + (*p - '0');
+  }
+
+  if (p == m_pos || (p < m_end && !isSpace(*p))) {
+    const char* end = m_pos;
+    while (end < m_end && !isSpace(*end)) {
+      ++end;
+    }
+    throw BadFormatException
+      (FromHere(), "ASCIIListParser: could not read " + std::string(m_pos, end) +
+       " as an unsigned integer in " + m_fileName);
+  }
+
+  value = result;
+  m_pos = p;
+  return *this;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ASCIIListParser& ASCIIListParser::operator>> (RealVector& values)
+{
+  for (CFuint i = 0; i < values.size(); ++i) {
+    *this >> values[i];
+  }
+  return *this;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ASCIIListParser::readIndexFile()
+{
+  const std::string indexFileName = m_fileName + ".idx";
+  if (!boost::filesystem::exists(indexFileName)) {
+    return;
+  }
+
+  if (boost::filesystem::last_write_time(indexFileName) <
+      boost::filesystem::last_write_time(m_fileName)) {
+    CFLog(WARN, "ASCIIListParser: ignoring " << indexFileName
+          << " which is older than the mesh file\n");
+    return;
+  }
+
+  ifstream fin(indexFileName.c_str());
+  std::string tag;
+  CFuint version = 0;
+  size_t fileSize = 0;
+  fin >> tag >> version >> fileSize;
+  if (!fin || tag != "!CFMESH_INDEX" || version != INDEX_FILE_VERSION ||
+      fileSize != m_file.size()) {
+    CFLog(WARN, "ASCIIListParser: ignoring " << indexFileName
+          << " which does not match the mesh file\n");
+    return;
+  }
+
+  std::string key;
+  while (fin >> key) {
+    ListIndex index;
+    CFuint nbOffsets = 0;
+    fin >> index.start >> index.nbRecords >> index.nbTokens
+        >> index.chunkSize >> index.end >> nbOffsets;
+    index.offsets.resize(nbOffsets);
+    for (CFuint i = 0; i < nbOffsets; ++i) {
+      fin >> index.offsets[i];
+    }
+
+    if (!fin || index.chunkSize == 0 || index.end > m_file.size()) {
+      CFLog(WARN, "ASCIIListParser: ignoring corrupted " << indexFileName << "\n");
+      m_indexes.clear();
+      return;
+    }
+    m_indexes[key] = index;
+  }
+
+  CFLog(VERBOSE, "ASCIIListParser: read " << m_indexes.size()
+        << " list indexes from " << indexFileName << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ASCIIListParser::writeIndexFile() const
+{
+  const std::string indexFileName = m_fileName + ".idx";
+  const std::string tmpFileName = indexFileName + ".tmp";
+
+  ofstream fout(tmpFileName.c_str());
+  fout << "!CFMESH_INDEX " << INDEX_FILE_VERSION << " " << m_file.size() << "\n";
+  for (map<string, ListIndex>::const_iterator itr = m_indexes.begin();
+       itr != m_indexes.end(); ++itr) {
+    const ListIndex& index = itr->second;
+    fout << itr->first << " " << index.start << " " << index.nbRecords << " "
+         << index.nbTokens << " " << index.chunkSize << " " << index.end << " "
+         << index.offsets.size() << "\n";
+    for (CFuint i = 0; i < index.offsets.size(); ++i) {
+      fout << index.offsets[i] << "\n";
+    }
+  }
+  fout.close();
+
+  // the index is saved next to the mesh, which can be in a read-only place
+  if (!fout || std::rename(tmpFileName.c_str(), indexFileName.c_str()) != 0) {
+    CFLog(WARN, "ASCIIListParser: could not write " << indexFileName << "\n");
+    std::remove(tmpFileName.c_str());
+    return;
+  }
+
+  CFLog(INFO, "ASCIIListParser: written " << indexFileName << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace CFmeshFileReader
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
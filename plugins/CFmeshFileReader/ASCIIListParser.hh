@@ -0,0 +1,166 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_CFmeshFileReader_ASCIIListParser_hh
+#define COOLFluiD_CFmeshFileReader_ASCIIListParser_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Common/MemoryMappedFile.hh"
+#include "MathTools/RealVector.hh"
+
+#include "CFmeshFileReader/CFmeshFileReaderAPI.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace CFmeshFileReader {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class parses the lists of numbers of an ASCII CFmesh file directly
+/// from its memory-mapped content, without going through the iostreams and
+/// without allocating memory for each token.
+/// An index holding the byte offset of every chunkSize-th record of each
+/// list lets the processes jump to the records they need instead of parsing
+/// the whole list. The index is built the first time a list is read and it is
+/// saved in a file next to the mesh (<mesh file>.idx), so that the next runs
+/// can use it straight away.
+class CFmeshFileReader_API ASCIIListParser {
+public:
+
+  /// Number of records and number of tokens per record of a group of
+  /// consecutive records of a list (e.g. all the elements of the same type)
+  typedef std::pair<CFuint, CFuint> RecordGroup;
+
+  /// Byte offsets of the records of a list
+  struct ListIndex {
+    /// offset of the first record
+    size_t start;
+    /// total number of records
+    CFuint nbRecords;
+    /// total number of tokens
+    CFuint nbTokens;
+    /// number of records between two stored offsets
+    CFuint chunkSize;
+    /// offsets of the records 0, chunkSize, 2*chunkSize, ...
+    std::vector<size_t> offsets;
+    /// offset of the end of the list
+    size_t end;
+  };
+
+  /// Constructor
+  ASCIIListParser();
+
+  /// Destructor
+  ~ASCIIListParser();
+
+  /// Map the given file and load its index if it exists and matches the file
+  /// @param fileName   name of the CFmesh file
+  /// @param chunkSize  number of records between two offsets in a new index
+  /// @throw Common::FilesystemException if the file cannot be mapped
+  void open(const std::string& fileName, const CFuint chunkSize);
+
+  /// Unmap the file
+  /// @param saveIndex  if true, write the index file if new lists were indexed
+  void close(const bool saveIndex);
+
+  /// Tells if a file is currently mapped
+  bool isOpen() const {return m_file.isOpen();}
+
+  /// Get the current position in the file
+  size_t tell() const {return m_pos - m_file.data();}
+
+  /// Set the current position in the file
+  void seek(const size_t offset);
+
+  /// Get the index of the list starting at the current position, building
+  /// it by scanning the list if it is not known yet. The position is left
+  /// unchanged.
+  /// @param key     keyword of the list
+  /// @param groups  groups of records that make up the list
+  const ListIndex& getListIndex(const std::string& key,
+                                const std::vector<RecordGroup>& groups);
+
+  /// Move to the beginning of the chunk holding the given record
+  /// @return the ID of the first record of the chunk
+  CFuint seekChunk(const ListIndex& index, const CFuint iRecord);
+
+  /// Move to a record of a list whose records all have the same size,
+  /// skipping the records in between or jumping with the index
+  /// @param index      index of the list
+  /// @param iRecord    ID of the record at the current position, updated
+  /// @param target     ID of the record to move to
+  /// @param nbTokens   number of tokens in each record
+  void moveToRecord(const ListIndex& index, CFuint& iRecord,
+                    const CFuint target, const CFuint nbTokens);
+
+  /// Skip the given number of tokens
+  void skip(const CFuint nbTokens);
+
+  /// Read a real number
+  ASCIIListParser& operator>> (CFreal& value);
+
+  /// Read an unsigned integer
+  ASCIIListParser& operator>> (CFuint& value);
+
+  /// Read as many real numbers as the size of the given vector
+  ASCIIListParser& operator>> (RealVector& values);
+
+private: // functions
+
+  /// Skip the white spaces before the next token
+  /// @throw Framework::BadFormatException if the end of the file is reached
+  void skipSpaces();
+
+  /// Parse a real number which is not handled by the fast path
+  CFreal parseRealSlow(const char* begin);
+
+  /// Load the index file
+  void readIndexFile();
+
+  /// Write the index file
+  void writeIndexFile() const;
+
+private: // data
+
+  /// mapped CFmesh file
+  Common::MemoryMappedFile m_file;
+
+  /// name of the CFmesh file
+  std::string m_fileName;
+
+  /// current position
+  const char* m_pos;
+
+  /// end of the file
+  const char* m_end;
+
+  /// number of records between two offsets in a new index
+  CFuint m_chunkSize;
+
+  /// indexes of the lists of the file
+  std::map<std::string, ListIndex> m_indexes;
+
+  /// flag telling if some lists were indexed since the file was opened
+  bool m_newIndexes;
+
+}; // class ASCIIListParser
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace CFmeshFileReader
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_CFmeshFileReader_ASCIIListParser_hh
@@ -16,6 +16,7 @@
 #include "Common/SwapEmpty.hh"
 #include "Common/BadValueException.hh"
 #include "Common/MPI/MPIIOFunctions.hh"
+#include "Common/ShuffleCompressor.hh"
 
 #include "Environment/FileHandlerInput.hh"
 #include "Environment/SingleBehaviorFactory.hh"
@@ -47,7 +48,8 @@ ParCFmeshBinaryFileReader::ParCFmeshBinaryFileReader() :
   ParCFmeshFileReader(), // here you have to pass the name of this object to configure
   m_mapString2ReaderFun(),
   m_fh(),
-  m_status()
+  m_status(),
+  m_compressedList(false)
 {
   addConfigOptionsTo(this);
   
@@ -108,6 +110,8 @@ void ParCFmeshBinaryFileReader::setMapString2Readers()
   m_mapString2ReaderFun["!SOL_POLYORDER"]      = &ParCFmeshBinaryFileReader::readSolutionPolyOrder;
   m_mapString2ReaderFun["!LIST_NODE"]          = &ParCFmeshBinaryFileReader::readNodeList;
   m_mapString2ReaderFun["!LIST_STATE"]         = &ParCFmeshBinaryFileReader::readStateList;
+  m_mapString2ReaderFun["!LIST_NODE_Z"]        = &ParCFmeshBinaryFileReader::readCompressedNodeList;
+  m_mapString2ReaderFun["!LIST_STATE_Z"]       = &ParCFmeshBinaryFileReader::readCompressedStateList;
   m_mapString2ReaderFun["!NB_TRSs"]            = &ParCFmeshBinaryFileReader::readNbTRSs;
   m_mapString2ReaderFun["!TRS_NAME"]           = &ParCFmeshBinaryFileReader::readTRSName;
   m_mapString2ReaderFun["!NB_TRs"]             = &ParCFmeshBinaryFileReader::readNbTRs;
@@ -123,6 +127,7 @@ void ParCFmeshBinaryFileReader::setMapString2Readers()
   m_mapString2ReaderFun["!GROUP_ELEM_NB"]      = &ParCFmeshBinaryFileReader::readGroupElementNb;
   m_mapString2ReaderFun["!GROUP_ELEM_LIST"]    = &ParCFmeshBinaryFileReader::readGroupElementList;
   m_mapString2ReaderFun["!LIST_ELEM"]          = &ParCFmeshBinaryFileReader::readElementList;
+  m_mapString2ReaderFun["!LIST_ELEM_Z"]        = &ParCFmeshBinaryFileReader::readCompressedElementList;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -712,6 +717,33 @@ void ParCFmeshBinaryFileReader::readElementList(MPI_File* fh)
 
 //////////////////////////////////////////////////////////////////////////////
 
+void ParCFmeshBinaryFileReader::readCompressedElementList(MPI_File* fh)
+{
+  m_compressedList = true;
+  readElementList(fh);
+  m_compressedList = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshBinaryFileReader::readCompressedNodeList(MPI_File* fh)
+{
+  m_compressedList = true;
+  readNodeList(fh);
+  m_compressedList = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshBinaryFileReader::readCompressedStateList(MPI_File* fh)
+{
+  m_compressedList = true;
+  readStateList(fh);
+  m_compressedList = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void ParCFmeshBinaryFileReader::readElemListRank(PartitionerData& pdata,
 						 MPI_File* fh)
 {
@@ -789,11 +821,38 @@ void ParCFmeshBinaryFileReader::readElemListRank(PartitionerData& pdata,
   MPI_Offset startPos = offset + elemOffset + 1;    // the "1" is for the character "\n" 
   MPI_Offset endPos   = offset + elemMaxOffset + 1; // the "1" is for the character "\n" 
   
-  CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readElemListRank() => elements read in position [" << offset + 1 << ", " << endPos << "]\n");
-  CFLog(VERBOSE, "P[" << m_myRank << "] reads " << localElemSize  << " elements starting from position " << startPos << "\n");
-  
-  MPIIOFunctions::readAll("ParCFmeshBinaryFileReader::readElemListRank()", fh, startPos, &buf[0], 
-			  (CFuint)buf.size(), m_maxBuffSize, m_comm, m_myRank);
+  if (m_compressedList) {
+    // the element types are stored as consecutive compressed lists
+    MPI_Offset typeOffset = offset + 1;
+    CFuint typeBegin = 0;
+    CFuint bufID = 0;
+    for (CFuint iType = 0; iType < m_totNbElemTypes; ++iType) {
+      const CFuint nbNodesStates = (*elementType)[iType].getNbNodes() + (*elementType)[iType].getNbStates();
+      const CFuint nbElementsPerType = (*elementType)[iType].getNbElems();
+      const CFuint typeEnd = typeBegin + nbElementsPerType;
+      const CFuint first = std::max(start, typeBegin);
+      const CFuint last  = std::min(end, typeEnd);
+      const CFuint nbRecords = (last > first) ? last - first : 0;
+      CFuint* typeBuf = (nbRecords > 0) ? &buf[bufID] : CFNULL;
+      
+      typeOffset = readCompressedList("ParCFmeshBinaryFileReader::readElemListRank()", fh, typeOffset, 
+				      nbElementsPerType, nbNodesStates, (nbRecords > 0) ? first - typeBegin : 0,
+				      nbRecords, typeBuf);
+      bufID += nbRecords*nbNodesStates;
+      typeBegin = typeEnd;
+    }
+    cf_assert(bufID == buf.size());
+    endPos = typeOffset;
+    
+    CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readElemListRank() => compressed elements read in position [" << offset + 1 << ", " << endPos << "]\n");
+  }
+  else {
+    CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readElemListRank() => elements read in position [" << offset + 1 << ", " << endPos << "]\n");
+    CFLog(VERBOSE, "P[" << m_myRank << "] reads " << localElemSize  << " elements starting from position " << startPos << "\n");
+    
+    MPIIOFunctions::readAll("ParCFmeshBinaryFileReader::readElemListRank()", fh, startPos, &buf[0], 
+			    (CFuint)buf.size(), m_maxBuffSize, m_comm, m_myRank);
+  }
   
   CFLog(DEBUG_MAX, CFPrintContainer<vector<CFuint> >("buf = ", &buf));
   
@@ -1595,8 +1654,16 @@ void ParCFmeshBinaryFileReader::readNodeList(MPI_File* fh)
   CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readNodeList() => nodes read in position [" << startPos << 
 	", " << startPos + sizeRead*sizeof(CFreal) << "]\n");
   
-  MPIIOFunctions::readAll("ParCFmeshBinaryFileReader::readNodeList()", fh, startPos, &buf[0], 
-			  (CFuint)sizeRead, m_maxBuffSize, m_comm, m_myRank);
+  MPI_Offset endPos = startListOffset + m_totNbNodes*nodeSize*sizeof(CFreal);
+  if (m_compressedList) {
+    endPos = readCompressedList("ParCFmeshBinaryFileReader::readNodeList()", fh, startListOffset, 
+				m_totNbNodes, nodeSize, ranges[m_myRank].first, 
+				nbNodesPerProc[m_myRank], &buf[0]);
+  }
+  else {
+    MPIIOFunctions::readAll("ParCFmeshBinaryFileReader::readNodeList()", fh, startPos, &buf[0], 
+			    (CFuint)sizeRead, m_maxBuffSize, m_comm, m_myRank);
+  }
   
   vector<CFreal> localNodesData(m_localNodeIDs.size()*nodeSize);
   getLocalData(buf, ranges, m_localNodeIDs, nodeSize, localNodesData);
@@ -1610,7 +1677,6 @@ void ParCFmeshBinaryFileReader::readNodeList(MPI_File* fh)
   createNodesAll(localNodesData, ghostNodesData, nodes);
   
   MPI_Barrier(m_comm);
-  MPI_Offset endPos = startListOffset + m_totNbNodes*nodeSize*sizeof(CFreal);
   MPI_File_seek(*fh, endPos, MPI_SEEK_SET);
   
   CFLogDebugMin("m_localNodeIDs.size() = " << m_localNodeIDs.size() << "\n");
@@ -2214,6 +2280,7 @@ void ParCFmeshBinaryFileReader::readStateList(MPI_File* fh)
     ghostStatesData.resize(m_ghostStateIDs.size()*stateSize);
   }
   
+  MPI_Offset endPos = startListOffset + m_totNbStates*stateSize*sizeof(CFreal);
   if (isWithSolution)  { 
     // set the number of states to read in each processor
     vector<CFuint> nbStatesPerProc(m_nbProc);
@@ -2231,8 +2298,15 @@ void ParCFmeshBinaryFileReader::readStateList(MPI_File* fh)
     CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readStateList() => states read in position [" << startPos << 
 	  ", " << startPos + sizeRead*sizeof(CFreal) << "]\n");
     
-    MPIIOFunctions::readAll("ParCFmeshBinaryFileReader::readStateList()", fh, startPos, &buf[0], 
-			    (CFuint)sizeRead, m_maxBuffSize, m_comm, m_myRank);
+    if (m_compressedList) {
+      endPos = readCompressedList("ParCFmeshBinaryFileReader::readStateList()", fh, startListOffset, 
+				  m_totNbStates, stateSize, ranges[m_myRank].first, 
+				  nbStatesPerProc[m_myRank], &buf[0]);
+    }
+    else {
+      MPIIOFunctions::readAll("ParCFmeshBinaryFileReader::readStateList()", fh, startPos, &buf[0], 
+			      (CFuint)sizeRead, m_maxBuffSize, m_comm, m_myRank);
+    }
     getLocalData(buf, ranges, m_localStateIDs, stateSize, localStatesData);
     
     if (m_ghostStateIDs.size() > 0) {
@@ -2244,7 +2318,6 @@ void ParCFmeshBinaryFileReader::readStateList(MPI_File* fh)
   
   if (isWithSolution)  { 
     MPI_Barrier(m_comm);
-    MPI_Offset endPos = startListOffset + m_totNbStates*stateSize*sizeof(CFreal);
     MPI_File_seek(*fh, endPos, MPI_SEEK_SET);
   }
   
@@ -2254,6 +2327,86 @@ void ParCFmeshBinaryFileReader::readStateList(MPI_File* fh)
   CFLogDebugMin( "ParCFmeshBinaryFileReader::readStateList() end\n");
 }
       
+template <typename T>
+MPI_Offset ParCFmeshBinaryFileReader::readCompressedList
+(const std::string& name, MPI_File* fh, const MPI_Offset offset, 
+ const CFuint nbEntries, const CFuint stride, const CFuint first, 
+ const CFuint nbRecords, T* buf)
+{
+  // the header (nbEntries, stride, chunkSize, nbChunks) and the offsets of the 
+  // chunk boundaries are read by the first process and broadcast to the others
+  CFuint header[4] = {0, 0, 0, 0};
+  if (m_myRank == 0) {
+    MPI_File_read_at(*fh, offset, &header[0], 4, MPIStructDef::getMPIType(&header[0]), &m_status);
+  }
+  MPI_Bcast(&header[0], 4, MPIStructDef::getMPIType(&header[0]), 0, m_comm);
+  
+  const CFuint chunkSize = header[2];
+  const CFuint nbChunks  = header[3];
+  if (header[0] != nbEntries || header[1] != stride || chunkSize == 0 || 
+      nbChunks != (nbEntries + chunkSize - 1)/chunkSize) {
+    throw BadFormatException 
+      (FromHere(), name + " => header of the compressed list does not match the mesh");
+  }
+  
+  vector<MPI_Offset> chunkOffsets(nbChunks + 1, 0);
+  if (m_myRank == 0) {
+    MPI_File_read_at(*fh, offset + 4*sizeof(CFuint), &chunkOffsets[0], (int)(nbChunks + 1), 
+		     MPIStructDef::getMPIOffsetType(), &m_status);
+  }
+  MPI_Bcast(&chunkOffsets[0], (int)(nbChunks + 1), MPIStructDef::getMPIOffsetType(), 0, m_comm);
+  const MPI_Offset dataStart = offset + 4*sizeof(CFuint) + (nbChunks + 1)*sizeof(MPI_Offset);
+  
+  // only the chunks holding the records [first, first + nbRecords) are read
+  const CFuint firstChunk = (nbRecords > 0) ? first/chunkSize : 0;
+  const CFuint endChunk   = (nbRecords > 0) ? (first + nbRecords - 1)/chunkSize + 1 : 0;
+  cf_assert(endChunk <= nbChunks);
+  const CFuint nbBytes = (CFuint)(chunkOffsets[endChunk] - chunkOffsets[firstChunk]);
+  vector<char> compressed(std::max(nbBytes, (CFuint)1));
+  
+  // read in pieces of at most MaxBuffSize bytes
+  const CFuint maxReadSize = std::max((CFuint)m_maxBuffSize, (CFuint)1);
+  CFuint nbReads = (nbBytes + maxReadSize - 1)/maxReadSize;
+  CFuint maxNbReads = 0;
+  MPI_Allreduce(&nbReads, &maxNbReads, 1, MPIStructDef::getMPIType(&nbReads), MPI_MAX, m_comm);
+  
+  for (CFuint ir = 0; ir < maxNbReads; ++ir) {
+    const CFuint readStart = std::min(ir*maxReadSize, nbBytes);
+    const CFuint readSize  = std::min(maxReadSize, nbBytes - readStart);
+    const MPI_Offset readOffset = dataStart + chunkOffsets[firstChunk] + readStart;
+    
+    CFLog(VERBOSE, m_myRank << " in " << name << " reads compressed buffer of size " 
+	  << readSize << " starting from " << readOffset << "\n");
+    
+    MPIError::getInstance().check
+      ("MPI_File_read_at_all", name,
+       MPI_File_read_at_all(*fh, readOffset, &compressed[0] + readStart, (int)readSize, 
+			    MPIStructDef::getMPIType(&compressed[0]), &m_status));
+  }
+  
+  // decompress the chunks and copy the requested records 
+  vector<T> chunk;
+  if (endChunk > firstChunk) {
+    chunk.resize(std::min(chunkSize, nbEntries)*stride);
+  }
+  for (CFuint ic = firstChunk; ic < endChunk; ++ic) {
+    const CFuint chunkStart = ic*chunkSize;
+    const CFuint chunkEnd   = std::min(chunkStart + chunkSize, nbEntries);
+    ShuffleCompressor::decompress(&compressed[0] + (chunkOffsets[ic] - chunkOffsets[firstChunk]), 
+				  (size_t)(chunkOffsets[ic+1] - chunkOffsets[ic]), 
+				  (chunkEnd - chunkStart)*stride, sizeof(T), 
+				  reinterpret_cast<char*>(&chunk[0]));
+    
+    const CFuint copyStart = std::max(first, chunkStart);
+    const CFuint copyEnd   = std::min(first + nbRecords, chunkEnd);
+    std::copy(&chunk[0] + (copyStart - chunkStart)*stride, 
+	      &chunk[0] + (copyEnd - chunkStart)*stride, 
+	      buf + (copyStart - first)*stride);
+  }
+  
+  return dataStart + chunkOffsets[nbChunks];
+}
+
 //////////////////////////////////////////////////////////////////////
 
     } // namespace CFmeshFileReader
@@ -176,6 +176,15 @@ private: // member functions
 
   /// Reads the data concerning the elements
   void readElementList(MPI_File* fh);
+  
+  /// Reads the compressed list of nodes
+  void readCompressedNodeList(MPI_File* fh);
+  
+  /// Reads the compressed list of state tensors and initialize the dofs
+  void readCompressedStateList(MPI_File* fh);
+  
+  /// Reads the data concerning the elements from a compressed list
+  void readCompressedElementList(MPI_File* fh);
 
   /// Reads the number of topological region sets and initialize the vector
   /// that will contain the all the topological region sets
@@ -274,6 +283,23 @@ private: // member functions
 			std::vector<std::pair<CFuint, CFuint> >& ranges, 
 			std::vector<CFuint>& nbNodesPerProc);
   
+  /// Reads a range of records from a compressed list, decompressing only the 
+  /// chunks which hold them (all the processes must call it)
+  /// @param name      name of the calling function (for error messages)
+  /// @param offset    offset of the start of the list in the file
+  /// @param nbEntries total number of records in the list
+  /// @param stride    size of each record
+  /// @param first     ID of the first record to read
+  /// @param nbRecords number of records to read
+  /// @param buf       buffer of size nbRecords*stride where to store the records
+  /// @return the offset of the end of the list in the file
+  /// @throw Framework::BadFormatException if the list does not match 
+  template <typename T>
+  MPI_Offset readCompressedList(const std::string& name, MPI_File* fh, 
+				const MPI_Offset offset, const CFuint nbEntries, 
+				const CFuint stride, const CFuint first, 
+				const CFuint nbRecords, T* buf);
+  
  private: // data
   
   /// map each string with a corresponding pointer to member
@@ -289,6 +315,9 @@ private: // member functions
   /// maximu size of the buffer to write with MPI I/O
   int m_maxBuffSize;
   
+  /// flag telling if the list being read is compressed
+  bool m_compressedList;
+  
 }; // class ParCFmeshBinaryFileReader
 
 //////////////////////////////////////////////////////////////////////////////
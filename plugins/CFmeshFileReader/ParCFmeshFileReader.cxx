@@ -74,7 +74,8 @@ ParCFmeshFileReader::ParCFmeshFileReader() :
   m_hasPastNodes(false),
   m_hasPastStates(false),
   m_hasInterNodes(false),
-  m_hasInterStates(false)
+  m_hasInterStates(false),
+  m_parser()
 {
   addConfigOptionsTo(this);
 
@@ -93,6 +94,12 @@ ParCFmeshFileReader::ParCFmeshFileReader() :
   
   m_inputToUpdateVecStr = "Identity";
   setParameter("InputToUpdate",&m_inputToUpdateVecStr);
+  
+  m_fastASCIIParser = false;
+  setParameter("FastASCIIParser",&m_fastASCIIParser);
+  
+  m_indexChunkSize = 1024;
+  setParameter("IndexChunkSize",&m_indexChunkSize);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -112,6 +119,12 @@ void ParCFmeshFileReader::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< std::vector<std::string> > ("MergeTRS", "Topological regions sets to be merged");
 
   options.addConfigOption< std::string >("InputToUpdate", "Transformer from input to update variables");
+  
+  options.addConfigOption< bool >
+    ("FastASCIIParser", "Parse the lists of nodes, states and elements from the memory-mapped file, using an index saved next to the mesh");
+  
+  options.addConfigOption< CFuint >
+    ("IndexChunkSize", "Number of records between two offsets in the index of the lists");
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -196,6 +209,28 @@ void ParCFmeshFileReader::setup()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void ParCFmeshFileReader::readFromFile(const boost::filesystem::path& filepath)
+{
+  if (m_fastASCIIParser) {
+    try {
+      m_parser.open(filepath.string(), m_indexChunkSize);
+    }
+    catch (FilesystemException& e) {
+      CFLog(WARN, "ParCFmeshFileReader::readFromFile() => " << e.what() 
+	    << "\nFalling back to the standard parser\n");
+    }
+  }
+  
+  FileReader::readFromFile(filepath);
+  
+  // only one process saves the index of the lists
+  if (m_parser.isOpen()) {
+    m_parser.close(m_myRank == 0);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void ParCFmeshFileReader::setMapString2Readers()
 {
   m_mapString2Reader["!COOLFLUID_VERSION"]     = &ParCFmeshFileReader::readCFVersion;
@@ -808,55 +843,67 @@ void ParCFmeshFileReader::readNodeList(ifstream& fin)
   getReadData().prepareNodalExtraVars();
 
   CFuint countLocals = 0;
-  for (CFuint iNode = 0; iNode < m_totNbNodes; ++iNode) {
-
-    // read the node
-    fin >> tmpNode;
-
-    if (m_hasPastNodes) {
-      fin >> tmpPastNode;
-    }
-
-    if (m_hasInterNodes) {
-      fin >> tmpInterNode;
-    }
-
-    if (nbExtraVars > 0) {
-      fin >> extraVars;
-    }
-
-    CFuint localID = 0;
-    bool isGhost = false;
-    bool isFound = false;
-    if (hasEntry(m_localNodeIDs, iNode)) {
-      countLocals++;
-      localID = nodes.addLocalPoint (iNode);
-      cf_assert(localID < nbLocalNodes);
-      isFound = true;
-    }
-    else if (hasEntry(m_ghostNodeIDs, iNode)) {
+  if (m_parser.isOpen()) {
+    // only the records of the local and ghost nodes are parsed, the others
+    // are skipped or jumped over with the index of the list
+    m_parser.seek(fin.tellg());
+    const CFuint nbValues = getNbNodeRecordValues();
+    const ASCIIListParser::ListIndex& index = m_parser.getListIndex
+      ("!LIST_NODE", vector<ASCIIListParser::RecordGroup>
+       (1, ASCIIListParser::RecordGroup(m_totNbNodes, nbValues)));
+    
+    vector<pair<CFuint, bool> > nodeIDs;
+    mergeLocalGhostIDs(m_localNodeIDs, m_ghostNodeIDs, nodeIDs);
+    
+    CFuint iRecord = 0;
+    for (CFuint i = 0; i < nodeIDs.size(); ++i) {
+      const CFuint iNode = nodeIDs[i].first;
+      m_parser.moveToRecord(index, iRecord, iNode, nbValues);
+      
+      m_parser >> tmpNode;
+      if (m_hasPastNodes) {
+	m_parser >> tmpPastNode;
+      }
+      if (m_hasInterNodes) {
+	m_parser >> tmpInterNode;
+      }
+      if (nbExtraVars > 0) {
+	m_parser >> extraVars;
+      }
+      ++iRecord;
+      
+      addNode(nodes, iNode, nodeIDs[i].second, tmpNode, tmpPastNode, tmpInterNode, extraVars);
       countLocals++;
-      localID = nodes.addGhostPoint (iNode);
-      cf_assert(localID < nbLocalNodes);
-      isGhost = true;
-      isFound = true;
     }
-
-    if (isFound) {
-      Node* newNode = getReadData().createNode
-  (localID, nodes.getGlobalData(localID), tmpNode, !isGhost);
-      newNode->setGlobalID(iNode);
+    
+    m_parser.seek(index.end);
+    fin.seekg(index.end);
+  }
+  else {
+    for (CFuint iNode = 0; iNode < m_totNbNodes; ++iNode) {
+      
+      // read the node
+      fin >> tmpNode;
+      
       if (m_hasPastNodes) {
-        getReadData().setPastNode(localID, tmpPastNode);
+	fin >> tmpPastNode;
       }
-     if (m_hasInterNodes) {
-        getReadData().setInterNode(localID, tmpInterNode);
+      
+      if (m_hasInterNodes) {
+	fin >> tmpInterNode;
       }
-
-
-      // set the nodal extra variable
+      
       if (nbExtraVars > 0) {
-  getReadData().setNodalExtraVar(localID, extraVars);
+	fin >> extraVars;
+      }
+      
+      if (hasEntry(m_localNodeIDs, iNode)) {
+	addNode(nodes, iNode, false, tmpNode, tmpPastNode, tmpInterNode, extraVars);
+	countLocals++;
+      }
+      else if (hasEntry(m_ghostNodeIDs, iNode)) {
+	addNode(nodes, iNode, true, tmpNode, tmpPastNode, tmpInterNode, extraVars);
+	countLocals++;
       }
     }
   }
@@ -873,6 +920,70 @@ void ParCFmeshFileReader::readNodeList(ifstream& fin)
 
 //////////////////////////////////////////////////////////////////////////////
 
+void ParCFmeshFileReader::addNode(DataHandle<Node*,GLOBAL>& nodes,
+				  CFuint globalID, bool isGhost, const RealVector& node,
+				  const RealVector& pastNode, const RealVector& interNode,
+				  const RealVector& extraVars)
+{
+  const CFuint localID = isGhost ? nodes.addGhostPoint(globalID) : 
+    nodes.addLocalPoint(globalID);
+  
+  Node* newNode = getReadData().createNode
+    (localID, nodes.getGlobalData(localID), node, !isGhost);
+  newNode->setGlobalID(globalID);
+  
+  if (m_hasPastNodes) {
+    getReadData().setPastNode(localID, pastNode);
+  }
+  
+  if (m_hasInterNodes) {
+    getReadData().setInterNode(localID, interNode);
+  }
+  
+  // set the nodal extra variable
+  if (extraVars.size() > 0) {
+    getReadData().setNodalExtraVar(localID, extraVars);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint ParCFmeshFileReader::getNbNodeRecordValues()
+{
+  const CFuint dim = PhysicalModelStack::getActive()->getDim();
+  const vector<CFuint>& strides = *getReadData().getExtraNodalVarStrides();
+  const CFuint sizeExtraVars = (getReadData().getNbExtraNodalVars() > 0) ? 
+    std::accumulate(strides.begin(), strides.end(), 0) : 0;
+  
+  return dim*(1 + (m_hasPastNodes ? 1 : 0) + (m_hasInterNodes ? 1 : 0)) + sizeExtraVars;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshFileReader::mergeLocalGhostIDs(const vector<CFuint>& localIDs,
+					     const vector<CFuint>& ghostIDs,
+					     vector<pair<CFuint, bool> >& ids)
+{
+  ids.clear();
+  ids.reserve(localIDs.size() + ghostIDs.size());
+  
+  CFuint iLocal = 0;
+  CFuint iGhost = 0;
+  while (iLocal < localIDs.size() || iGhost < ghostIDs.size()) {
+    const bool isGhost = (iLocal == localIDs.size()) ||
+      (iGhost < ghostIDs.size() && ghostIDs[iGhost] < localIDs[iLocal]);
+    const CFuint id = isGhost ? ghostIDs[iGhost++] : localIDs[iLocal++];
+    
+    // an ID which is both local and ghost is considered local
+    if (!isGhost && iGhost < ghostIDs.size() && ghostIDs[iGhost] == id) {
+      ++iGhost;
+    }
+    ids.push_back(pair<CFuint, bool>(id, isGhost));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void ParCFmeshFileReader::emptyNodeListRead(ifstream& fin)
 {
   CFLogDebugMin( "ParCFmeshFileReader::emptyNodeListRead() start" << "\n");
@@ -913,6 +1024,17 @@ void ParCFmeshFileReader::emptyNodeListRead(ifstream& fin)
 
   getReadData().prepareNodalExtraVars();
 
+  if (m_parser.isOpen()) {
+    // the list is only indexed here, it is parsed during the second reading
+    m_parser.seek(fin.tellg());
+    fin.seekg(m_parser.getListIndex
+	      ("!LIST_NODE", vector<ASCIIListParser::RecordGroup>
+	       (1, ASCIIListParser::RecordGroup(m_totNbNodes, getNbNodeRecordValues()))).end);
+    
+    CFLogDebugMin( "ParCFmeshFileReader::emptyNodeListRead() end" << "\n");
+    return;
+  }
+  
   for (CFuint n = 0; n < m_totNbNodes; ++n) {
     fin >> node;
 
@@ -1050,47 +1172,61 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
     m_inputToUpdateVecTrans->setup(1);
   }
   
+  // in case the original nb of equations in the file is bigger than the
+  // current number of equations, with init values the rest of the states
+  // is read and discarded
+  const CFuint nbDiscardedValues = (isWithSolution && m_useInitValues.size() > 0 && 
+				    m_originalNbEqs > nbEqs) ? m_originalNbEqs - nbEqs : 0;
+  
   CFuint countLocals = 0;
-  for (CFuint iState = 0; iState < m_totNbStates; ++iState)
-  {
-    // read the state
-    if (isWithSolution) 
-    {      
-      // no init values were used
-      if (m_useInitValues.size() == 0)
-      {
-	fin >> readState;
-
-        if (m_hasPastStates) 
-        {
-          fin >> tmpPastState;
-        }
+  if (m_parser.isOpen()) {
+    // only the records of the local and ghost states are parsed, the others
+    // are skipped or jumped over with the index of the list
+    m_parser.seek(fin.tellg());
+    const CFuint nbValues = getNbStateRecordValues(isWithSolution);
+    const ASCIIListParser::ListIndex& index = m_parser.getListIndex
+      ("!LIST_STATE", vector<ASCIIListParser::RecordGroup>
+       (1, ASCIIListParser::RecordGroup(m_totNbStates, nbValues)));
+    
+    vector<pair<CFuint, bool> > stateIDs;
+    mergeLocalGhostIDs(m_localStateIDs, m_ghostStateIDs, stateIDs);
+    
+    CFuint iRecord = 0;
+    for (CFuint i = 0; i < stateIDs.size(); ++i) {
+      const CFuint iState = stateIDs[i].first;
+      
+      if (isWithSolution) {
+	m_parser.moveToRecord(index, iRecord, iState, nbValues);
 	
+	m_parser >> readState;
+	if (m_hasPastStates) {
+	  m_parser >> tmpPastState;
+	}
 	if (m_hasInterStates) {
-          fin >> tmpInterState;
-        }
-
-        if (nbExtraVars > 0) {
-          fin >> extraVars;
-        }
-
-        if (!hasTransformer) {
-          const CFuint currNbEqs = std::min(nbEqs,m_originalNbEqs); // AL: why min????
-          for (CFuint iEq = 0; iEq < currNbEqs; ++iEq) {
-            tmpState[iEq] = readState[iEq];
-          }
-        }
-        else {
-          for (CFuint iEq = 0; iEq < m_originalNbEqs; ++iEq) {
-            dummyReadState[iEq] = readState[iEq];
-          }
-          tmpState = *m_inputToUpdateVecTrans->transform(&dummyReadState);
-        }
+	  m_parser >> tmpInterState;
+	}
+	if (nbExtraVars > 0) {
+	  m_parser >> extraVars;
+	}
+	m_parser.skip(nbDiscardedValues);
+	++iRecord;
+	
+	setStateValues(nbEqs, hasTransformer, readState, dummyReadState, tmpState);
       }
       
-      // using init values
-      else {
-	cf_assert(m_useInitValues.size() == nbEqs);
+      addState(states, iState, stateIDs[i].second, tmpState, tmpPastState, tmpInterState, extraVars);
+      countLocals++;
+    }
+    
+    m_parser.seek(index.end);
+    fin.seekg(index.end);
+  }
+  else {
+    for (CFuint iState = 0; iState < m_totNbStates; ++iState)
+    {
+      // read the state
+      if (isWithSolution) 
+      {
 	fin >> readState;
 	
 	if (m_hasPastStates) {
@@ -1105,86 +1241,126 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
 	  fin >> extraVars;
 	}
 	
-	for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
-	  if (!m_useInitValues[iEq] && iEq < m_originalNbEqs) {
-	    cf_assert(iEq < tmpState.size());
-	    tmpState[iEq] = readState[iEq];
-	  }
-          else {
-	    // user must specify either all initial values or values IDs, NOT BOTH
-	    cf_assert(m_initValues.size() != m_initValuesIDs.size());
-	    
-	    if (m_initValues.size() > 0) {
-              cf_assert(m_initValuesIDs.size() == 0);
-	      cf_assert(iEq < tmpState.size());
-	      cf_assert(iEq < m_initValues.size());
-              tmpState[iEq] = m_initValues[iEq];
-            }
-	    
-            if (m_initValuesIDs.size() > 0) {
-	      cf_assert(m_initValues.size() == 0);
-	      const CFuint currID = m_initValuesIDs[iEq];
-	      // if the current ID is >= nbEqs set this variable to 0.0
-	      tmpState[iEq] = (currID < m_originalNbEqs) ? readState[currID] : 0.0;
-	    }
-          }
-        }
+	setStateValues(nbEqs, hasTransformer, readState, dummyReadState, tmpState);
 	
-        // in case the original nb of equations in the file
-        // is bigger than the current number of equations
-        // we read the rest of the states and discard them
-        if (m_originalNbEqs > nbEqs)
-        {
-	  for (CFuint iEq = nbEqs; iEq < m_originalNbEqs; ++iEq)
-	  {
-            fin >> readState[iEq];
-          }
-        }
+	for (CFuint iEq = 0; iEq < nbDiscardedValues; ++iEq) {
+	  fin >> readState[nbEqs + iEq];
+	}
+      }
+      
+      if (hasEntry(m_localStateIDs, iState)) {
+	addState(states, iState, false, tmpState, tmpPastState, tmpInterState, extraVars);
+	countLocals++;
+      }
+      else if (hasEntry(m_ghostStateIDs, iState)) {
+	addState(states, iState, true, tmpState, tmpPastState, tmpInterState, extraVars);
+	countLocals++;
       }
     }
+  }
 
-    CFuint localID = 0;
-    bool isGhost = false;
-    bool isFound = false;
-    if (hasEntry(m_localStateIDs, iState)) {
-      countLocals++;
-      localID = states.addLocalPoint (iState);
-      cf_assert(localID < nbLocalStates);
-      isFound = true;
-    }
-    else if (hasEntry(m_ghostStateIDs, iState)) {
-      countLocals++;
-      localID = states.addGhostPoint (iState);
-      cf_assert(localID < nbLocalStates);
-      isGhost = true;
-      isFound = true;
-    }
+  cf_assert(countLocals == nbLocalStates);
 
-    if (isFound) {
-      State* newState = getReadData().createState
-  (localID, states.getGlobalData(localID), tmpState, !isGhost);
-      newState->setGlobalID(iState);
+  CFLogDebugMin( "ParCFmeshFileReader::readStateList() end\n");
+}
 
-      if (m_hasPastStates) {
-        getReadData().setPastState(localID, tmpPastState);
-      }
+//////////////////////////////////////////////////////////////////////////////
 
-      if (m_hasInterStates) {
-        getReadData().setInterState(localID, tmpInterState);
+void ParCFmeshFileReader::setStateValues(CFuint nbEqs, bool hasTransformer,
+					 const RealVector& readState,
+					 State& dummyReadState,
+					 State& state)
+{
+  // no init values were used
+  if (m_useInitValues.size() == 0) {
+    if (!hasTransformer) {
+      const CFuint currNbEqs = std::min(nbEqs,m_originalNbEqs); // AL: why min????
+      for (CFuint iEq = 0; iEq < currNbEqs; ++iEq) {
+	state[iEq] = readState[iEq];
       }
-      // set the nodal extra variable
-      if (nbExtraVars > 0) {
-  getReadData().setStateExtraVar(localID, extraVars);
+    }
+    else {
+      for (CFuint iEq = 0; iEq < m_originalNbEqs; ++iEq) {
+	dummyReadState[iEq] = readState[iEq];
       }
-
-      // getReadData().setStateLocalToGlobal (localID, globalID);
-      // getReadData().setLocalState(localID, !isGhost);
+      state = *m_inputToUpdateVecTrans->transform(&dummyReadState);
     }
+    return;
   }
+  
+  // using init values
+  cf_assert(m_useInitValues.size() == nbEqs);
+  for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+    if (!m_useInitValues[iEq] && iEq < m_originalNbEqs) {
+      cf_assert(iEq < state.size());
+      state[iEq] = readState[iEq];
+    }
+    else {
+      // user must specify either all initial values or values IDs, NOT BOTH
+      cf_assert(m_initValues.size() != m_initValuesIDs.size());
+      
+      if (m_initValues.size() > 0) {
+	cf_assert(m_initValuesIDs.size() == 0);
+	cf_assert(iEq < state.size());
+	cf_assert(iEq < m_initValues.size());
+	state[iEq] = m_initValues[iEq];
+      }
+      
+      if (m_initValuesIDs.size() > 0) {
+	cf_assert(m_initValues.size() == 0);
+	const CFuint currID = m_initValuesIDs[iEq];
+	// if the current ID is >= nbEqs set this variable to 0.0
+	state[iEq] = (currID < m_originalNbEqs) ? readState[currID] : 0.0;
+      }
+    }
+  }
+}
 
-  cf_assert(countLocals == nbLocalStates);
+//////////////////////////////////////////////////////////////////////////////
 
-  CFLogDebugMin( "ParCFmeshFileReader::readStateList() end\n");
+void ParCFmeshFileReader::addState(DataHandle<State*,GLOBAL>& states,
+				   CFuint globalID, bool isGhost, const State& state,
+				   const RealVector& pastState, const RealVector& interState,
+				   const RealVector& extraVars)
+{
+  const CFuint localID = isGhost ? states.addGhostPoint(globalID) : 
+    states.addLocalPoint(globalID);
+  
+  State* newState = getReadData().createState
+    (localID, states.getGlobalData(localID), state, !isGhost);
+  newState->setGlobalID(globalID);
+  
+  if (m_hasPastStates) {
+    getReadData().setPastState(localID, pastState);
+  }
+  
+  if (m_hasInterStates) {
+    getReadData().setInterState(localID, interState);
+  }
+  
+  // set the state extra variable
+  if (extraVars.size() > 0) {
+    getReadData().setStateExtraVar(localID, extraVars);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint ParCFmeshFileReader::getNbStateRecordValues(bool isWithSolution)
+{
+  if (!isWithSolution) {
+    return 0;
+  }
+  
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const vector<CFuint>& strides = *getReadData().getExtraStateVarStrides();
+  const CFuint sizeExtraVars = (getReadData().getNbExtraStateVars() > 0) ? 
+    std::accumulate(strides.begin(), strides.end(), 0) : 0;
+  const CFuint nbDiscardedValues = (m_useInitValues.size() > 0 && m_originalNbEqs > nbEqs) ?
+    m_originalNbEqs - nbEqs : 0;
+  
+  return m_originalNbEqs + nbEqs*((m_hasPastStates ? 1 : 0) + (m_hasInterStates ? 1 : 0)) + 
+    sizeExtraVars + nbDiscardedValues;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -1221,6 +1397,17 @@ void ParCFmeshFileReader::emptyStateListRead(ifstream& fin)
 
   getReadData().prepareStateExtraVars();
 
+  if (m_parser.isOpen()) {
+    // the list is only indexed here, it is parsed during the second reading
+    m_parser.seek(fin.tellg());
+    fin.seekg(m_parser.getListIndex
+	      ("!LIST_STATE", vector<ASCIIListParser::RecordGroup>
+	       (1, ASCIIListParser::RecordGroup(m_totNbStates, getNbStateRecordValues(isWithSolution)))).end);
+    
+    CFLogDebugMin( "ParCFmeshFileReader::emptyStateListRead() end" << "\n");
+    return;
+  }
+  
   if (isWithSolution) {
     for (CFuint s = 0; s < m_totNbStates; ++s) {
       // read the state values if they exist
@@ -1363,6 +1550,11 @@ void ParCFmeshFileReader::readElementList(ifstream& fin)
 void ParCFmeshFileReader::readElemListRank(PartitionerData& pdata,
 					   ifstream& fin)
 {
+  if (m_parser.isOpen()) {
+    readElemListRankFast(pdata, fin);
+    return;
+  }
+  
   CFuint start = 0;
   for (CFuint rank = 0; rank < m_myRank; ++rank) {
     start += m_nbElemPerProc[rank];
@@ -1435,6 +1627,82 @@ void ParCFmeshFileReader::readElemListRank(PartitionerData& pdata,
 
 //////////////////////////////////////////////////////////////////////////////
 
+void ParCFmeshFileReader::readElemListRankFast(PartitionerData& pdata,
+					       ifstream& fin)
+{
+  CFuint start = 0;
+  for (CFuint rank = 0; rank < m_myRank; ++rank) {
+    start += m_nbElemPerProc[rank];
+  }
+  const CFuint ne = m_nbElemPerProc[m_myRank];
+  
+  SafePtr< vector<ElementTypeData> > elementType =
+    getReadData().getElementTypeData();
+  
+  // the elements of each type make a group of records of the same size
+  vector<ASCIIListParser::RecordGroup> groups(m_totNbElemTypes);
+  for (CFuint iType = 0; iType < m_totNbElemTypes; ++iType) {
+    groups[iType].first  = (*elementType)[iType].getNbElems();
+    groups[iType].second = (*elementType)[iType].getNbNodes() + 
+      (*elementType)[iType].getNbStates();
+  }
+  
+  m_parser.seek(fin.tellg());
+  const ASCIIListParser::ListIndex& index = m_parser.getListIndex("!LIST_ELEM", groups);
+  
+  vector<PartitionerData::IndexT>& eNode  = pdata.elemNode;
+  vector<PartitionerData::IndexT>& eState = pdata.elemState;
+  vector<PartitionerData::IndexT>& eptrn  = pdata.eptrn;
+  vector<PartitionerData::IndexT>& eptrs  = pdata.eptrs;
+  
+  CFuint ncount = 0;
+  CFuint scount = 0;
+  CFuint ipos = 0;
+  if (ne > 0) {
+    // jump close to the first element of this rank
+    CFuint iElem = m_parser.seekChunk(index, start);
+    CFuint iElemBegin = 0;
+    CFuint dofID = 0;
+    
+    for (CFuint iType = 0; iType < m_totNbElemTypes && ipos < ne; ++iType) {
+      const CFuint nbNodesInElem  = (*elementType)[iType].getNbNodes();
+      const CFuint nbStatesInElem = (*elementType)[iType].getNbStates();
+      const CFuint iElemEnd = iElemBegin + groups[iType].first;
+      
+      // skip the elements of this chunk which come before the first one of this rank
+      for (; iElem < std::min(start, iElemEnd); ++iElem) {
+	m_parser.skip(nbNodesInElem + nbStatesInElem);
+      }
+      
+      for (; iElem < iElemEnd && ipos < ne; ++iElem, ++ipos) {
+	eptrn[ipos] = ncount;
+	eptrs[ipos] = scount;
+	
+	for (CFuint j = 0; j < nbNodesInElem; ++j, ++ncount) {
+	  m_parser >> dofID;
+	  checkDofID("node", iElem, j, dofID, m_totNbNodes);
+	  eNode[ncount] = dofID;
+	}
+	for (CFuint j = 0; j < nbStatesInElem; ++j, ++scount) {
+	  m_parser >> dofID;
+	  checkDofID("state", iElem, j, dofID, m_totNbStates);
+	  eState[scount] = dofID;
+	}
+      }
+      
+      iElemBegin = iElemEnd;
+    }
+  }
+  cf_assert(ipos == ne);
+  eptrn[ne] = ncount;
+  eptrs[ne] = scount;
+  
+  m_parser.seek(index.end);
+  fin.seekg(index.end);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void ParCFmeshFileReader::readNbTRSs(ifstream& fin)
 {
   CFLogDebugMin( "ParCFmeshFileReader::readNbTRSs() start\n");
@@ -21,6 +21,7 @@
 #include "Framework/ElementDataArray.hh"
 
 #include "CFmeshFileReader/CFmeshFileReaderAPI.hh"
+#include "CFmeshFileReader/ASCIIListParser.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -59,6 +60,11 @@ public: // member functions
   
   /// Sets up private data
   virtual void setup();
+  
+  /// Read the given file. If the fast parser is used, the file is also
+  /// mapped in memory to parse the lists of nodes, states and elements
+  /// @throw Common::FilesystemException
+  virtual void readFromFile(const boost::filesystem::path& filepath);
     
   /// Sets the pointer to the stored data
   void setReadData(const Common::SafePtr<Framework::CFmeshReaderSource>& data)
@@ -316,6 +322,10 @@ protected: // member functions
 
   /// Reads the element list corresponding for the current rank
   void readElemListRank( Framework::PartitionerData& pdata, std::ifstream& fin);
+  
+  /// Reads the element list corresponding for the current rank from the
+  /// memory-mapped file, jumping to the first element of the rank
+  void readElemListRankFast( Framework::PartitionerData& pdata, std::ifstream& fin);
 
   /// Reads the number of groups in the mesh
   void readNbGroups(std::ifstream& fin);
@@ -334,6 +344,36 @@ protected: // member functions
 
   /// Ineffective reading of the state list
   void emptyStateListRead(std::ifstream& fin);
+  
+  /// Get the number of values of each record of the node list
+  CFuint getNbNodeRecordValues();
+  
+  /// Get the number of values of each record of the state list
+  CFuint getNbStateRecordValues(bool isWithSolution);
+  
+  /// Merge the sorted local and ghost IDs in a single list sorted by ID
+  /// @param ids  global IDs with a flag telling if they are ghost
+  void mergeLocalGhostIDs(const std::vector<CFuint>& localIDs,
+			  const std::vector<CFuint>& ghostIDs,
+			  std::vector<std::pair<CFuint, bool> >& ids);
+  
+  /// Create a local or ghost node and set its additional values
+  void addNode(Framework::DataHandle<Framework::Node*,Framework::GLOBAL>& nodes,
+	       CFuint globalID, bool isGhost, const RealVector& node,
+	       const RealVector& pastNode, const RealVector& interNode,
+	       const RealVector& extraVars);
+  
+  /// Compute the state values from the values read in the file
+  void setStateValues(CFuint nbEqs, bool hasTransformer,
+		      const RealVector& readState,
+		      Framework::State& dummyReadState,
+		      Framework::State& state);
+  
+  /// Create a local or ghost state and set its additional values
+  void addState(Framework::DataHandle<Framework::State*,Framework::GLOBAL>& states,
+		CFuint globalID, bool isGhost, const Framework::State& state,
+		const RealVector& pastState, const RealVector& interState,
+		const RealVector& extraVars);
 
  protected:
   
@@ -556,6 +596,15 @@ protected: // member functions
   /// Vector transformer from input to update variables
   Common::SelfRegistPtr<Framework::VarSetTransformer> m_inputToUpdateVecTrans;
 
+  /// flag telling if the lists are parsed from the memory-mapped file
+  bool m_fastASCIIParser;
+
+  /// number of records between two offsets in the index of the lists
+  CFuint m_indexChunkSize;
+
+  /// parser of the lists of the memory-mapped file
+  ASCIIListParser m_parser;
+
 }; // class ParCFmeshFileReader
 
 //////////////////////////////////////////////////////////////////////////////
@@ -56,6 +56,10 @@ private: // data
   /// user option to renumber the states
   bool m_renumber;
   
+  /// local renumbering of elements, states and nodes after partitioning
+  /// ("None", "RCM", "Hilbert" or "Morton")
+  std::string m_renumberMethod;
+  
 }; // class ParReadCFmesh
 
 //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,221 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test ASCII CFmesh list parser"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include "Framework/BadFormatException.hh"
+#include "CFmeshFileReader/ASCIIListParser.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::CFmeshFileReader;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct ASCIIListParser_Fixture
+{
+  /// common setup for each test case
+  ASCIIListParser_Fixture() : fileName("utest-asciiListParser.CFmesh")
+  {
+    removeFiles();
+  }
+  /// common tear-down for each test case
+  ~ASCIIListParser_Fixture()
+  {
+    removeFiles();
+  }
+
+  /// remove the test file and its index
+  void removeFiles()
+  {
+    boost::filesystem::remove(fileName);
+    boost::filesystem::remove(fileName + ".idx");
+  }
+
+  /// write the given tokens to the test file, one per line
+  void writeTokens(const vector<std::string>& tokens)
+  {
+    ofstream fout(fileName.c_str());
+    for (CFuint i = 0; i < tokens.size(); ++i) {
+      fout << tokens[i] << "\n";
+    }
+  }
+
+  /// check that the parser reads every token with the same bits as strtod()
+  void checkTokens(const vector<std::string>& tokens)
+  {
+    writeTokens(tokens);
+    ASCIIListParser parser;
+    parser.open(fileName, 1);
+    for (CFuint i = 0; i < tokens.size(); ++i) {
+      CFreal value = 0.;
+      parser >> value;
+      const double expected = strtod(tokens[i].c_str(), CFNULL);
+      BOOST_CHECK_MESSAGE( memcmp(&value, &expected, sizeof(double)) == 0,
+			   tokens[i] << " read as " << value << " instead of " << expected );
+    }
+    parser.close(false);
+  }
+
+  /// deterministic pseudo-random integer in [0,32767]
+  CFuint random(CFuint& seed)
+  {
+    seed = seed*1103515245u + 12345u;
+    return (seed/65536u) % 32768u;
+  }
+
+  /// name of the test file
+  std::string fileName;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ASCIIListParser_TestSuite, ASCIIListParser_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_realEdgeCases )
+{
+  const char* tokens[] = {
+    // signs, zeros and missing integer or fractional parts
+    "0", "-0", "+0", "0.0", "-0.0", "1", "-1", "+1.5", ".5", "-.5", "5.", "1e0",
+    // leading zeros, which are not significant digits
+    "000123", "0.000123", "-0000.0000001", "00000000000000000000000001.5",
+    "0.00000000000000000000000000000000000000001",
+    // up to 19 significant digits, and the truncation after them
+    "1234567890123456789", "12345678901234567890", "12345678901234567891",
+    "1234567890123456789000000", "0.1234567890123456789", "0.12345678901234567891",
+    "1.000000000000000000000000001", "9999999999999999999", "99999999999999999999",
+    // mantissas around 2^53
+    "9007199254740992", "9007199254740993", "9007199254740991", "900719925474099.3",
+    // exponents at and beyond the exactly representable powers of 10
+    "1e22", "1e23", "1e-22", "1e-23", "123e20", "123e-24", "4.5e-21", "1.5E22",
+    "1.5E+22", "1.5e-022", "0.001e25", "1000e-25",
+    // values which need the slow path
+    "1e308", "1.7976931348623157e308", "1e309", "2.2250738585072014e-308",
+    "4.9406564584124654e-324", "1e-400", "1e100000000", "inf", "-inf", "nan",
+    "0x1p3", "3.141592653589793238462643383279"
+  };
+  checkTokens(vector<std::string>(tokens, tokens + sizeof(tokens)/sizeof(tokens[0])));
+}
+
+BOOST_AUTO_TEST_CASE( test_realRandom )
+{
+  // random values printed as CFmesh writers do, and random digit strings
+  CFuint seed = 3;
+  vector<std::string> tokens;
+  char buffer[64];
+  for (CFuint i = 0; i < 20000; ++i) {
+    const double mantissa = (random(seed)*32768. + random(seed))/1073741824.;
+    const int exponent = static_cast<int>(random(seed)%61) - 30;
+    const double value = ((random(seed)%2 == 0) ? 1. : -1.)*mantissa*std::pow(10., exponent);
+    const char* formats[4] = {"%.17g", "%.15e", "%.6e", "%.12f"};
+    sprintf(buffer, formats[i%4], value);
+    tokens.push_back(buffer);
+
+    std::string digits;
+    const CFuint nbDigits = 1 + random(seed)%25;
+    const CFuint point = random(seed)%(nbDigits+1);
+    for (CFuint d = 0; d < nbDigits; ++d) {
+      if (d == point) digits += '.';
+      digits += static_cast<char>('0' + random(seed)%10);
+    }
+    sprintf(buffer, "e%d", static_cast<int>(random(seed)%61) - 30);
+    tokens.push_back(digits + buffer);
+  }
+  checkTokens(tokens);
+}
+
+BOOST_AUTO_TEST_CASE( test_badFormat )
+{
+  const char* tokens[] = {"1.5x", "1e", "abc"};
+  for (CFuint i = 0; i < 3; ++i) {
+    writeTokens(vector<std::string>(1, tokens[i]));
+    ASCIIListParser parser;
+    parser.open(fileName, 1);
+    CFreal value = 0.;
+    BOOST_CHECK_THROW( parser >> value, BadFormatException );
+    parser.close(false);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_indexReuse )
+{
+  // a header followed by a list of nbRecords records of 3 tokens
+  const CFuint nbRecords = 50;
+  const CFuint nbTokens = 3;
+  {
+    ofstream fout(fileName.c_str());
+    fout << "!LIST " << nbRecords << "\n";
+    for (CFuint i = 0; i < nbRecords; ++i) {
+      fout << i << " " << i*0.5 << " " << i*0.25 << "\n";
+    }
+  }
+  const vector<ASCIIListParser::RecordGroup> groups(1, ASCIIListParser::RecordGroup(nbRecords, nbTokens));
+  const CFuint targets[] = {0, 7, 8, 3, 49, 12, 13, 48, 0, 25};
+
+  // the index is built with a chunk size of 4, then read back by parsers
+  // configured with other chunk sizes, which must use the stored one
+  const CFuint chunkSizes[] = {4, 7, 1, 5};
+  for (CFuint iRun = 0; iRun < 4; ++iRun) {
+    ASCIIListParser parser;
+    parser.open(fileName, chunkSizes[iRun]);
+    CFuint nb = 0;
+    parser.skip(1);
+    parser >> nb;
+    BOOST_CHECK_EQUAL( nb, nbRecords );
+
+    const ASCIIListParser::ListIndex& index = parser.getListIndex("LIST", groups);
+    const CFuint chunkSize = (iRun < 3) ? 4 : 5;
+    BOOST_CHECK_EQUAL( index.chunkSize, chunkSize );
+    BOOST_CHECK_EQUAL( index.offsets.size(), (nbRecords+chunkSize-1)/chunkSize );
+    BOOST_CHECK_EQUAL( index.nbRecords, nbRecords );
+    BOOST_CHECK_EQUAL( index.nbTokens, nbRecords*nbTokens );
+
+    CFuint iRecord = 0;
+    for (CFuint t = 0; t < sizeof(targets)/sizeof(targets[0]); ++t) {
+      parser.moveToRecord(index, iRecord, targets[t], nbTokens);
+      CFuint id = 0;
+      RealVector values(2);
+      parser >> id >> values;
+      ++iRecord;
+      BOOST_CHECK_EQUAL( id, targets[t] );
+      BOOST_CHECK_EQUAL( values[0], targets[t]*0.5 );
+      BOOST_CHECK_EQUAL( values[1], targets[t]*0.25 );
+    }
+
+    parser.seek(index.end);
+    BOOST_CHECK_THROW( parser.skip(1), BadFormatException );
+    parser.close(true);
+    BOOST_CHECK( boost::filesystem::exists(fileName + ".idx") );
+
+    // the last run rebuilds the index with a new chunk size
+    if (iRun == 2) {
+      boost::filesystem::remove(fileName + ".idx");
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
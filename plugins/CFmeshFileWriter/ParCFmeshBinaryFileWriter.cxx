@@ -20,6 +20,7 @@
 #include "Common/CFMultiMap.hh"
 #include "Common/CFPrintContainer.hh"
 #include "Common/MPI/MPIIOFunctions.hh"
+#include "Common/ShuffleCompressor.hh"
 
 #include "Environment/SingleBehaviorFactory.hh"
 
@@ -57,7 +58,11 @@ void cmpAndTakeMaxAbs2(CFreal* invec, CFreal* inoutvec, int* len,
 ParCFmeshBinaryFileWriter::ParCFmeshBinaryFileWriter() :
   ParFileWriter(), 
   ConfigObject("ParCFmeshBinaryFileWriter"),
-  _writeData()
+  _writeData(),
+  _collectiveIO(),
+  _compress(),
+  _compressionLevel(),
+  _compressionChunkSize()
 { 
   addConfigOptionsTo(this);
   
@@ -66,6 +71,18 @@ ParCFmeshBinaryFileWriter::ParCFmeshBinaryFileWriter() :
   
   _maxBuffSize = 2147479200; // (CFuint) std::numeric_limits<int>::max();
   setParameter("MaxBuffSize",&_maxBuffSize);
+  
+  _collectiveIO = false;
+  setParameter("CollectiveIO",&_collectiveIO);
+  
+  _compress = false;
+  setParameter("Compress",&_compress);
+  
+  _compressionLevel = 6;
+  setParameter("CompressionLevel",&_compressionLevel);
+  
+  _compressionChunkSize = 4096;
+  setParameter("CompressionChunkSize",&_compressionChunkSize);
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -80,6 +97,10 @@ void ParCFmeshBinaryFileWriter::defineConfigOptions(Config::OptionList& options)
 {
   options.addConfigOption< CFuint >("NbWriters", "Number of writers (and MPI groups)");
   options.addConfigOption< int >("MaxBuffSize", "Maximum buffer size for MPI I/O");
+  options.addConfigOption< bool >("CollectiveIO", "All the processes write their part of the lists with collective MPI I/O (NbWriters becomes the number of aggregators)");
+  options.addConfigOption< bool >("Compress", "Nodes, states and elements are written in independently compressed chunks (requires zlib, implies CollectiveIO)");
+  options.addConfigOption< CFuint >("CompressionLevel", "zlib compression level, from 1 (fastest) to 9 (smallest)");
+  options.addConfigOption< CFuint >("CompressionChunkSize", "Number of records (nodes, states or elements) in each compressed chunk");
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -88,6 +109,19 @@ void ParCFmeshBinaryFileWriter::setup()
 {
   ParFileWriter::setWriterGroup();
   _offset.resize(1);
+  
+  if (_compress) {
+    if (!ShuffleCompressor::isAvailable()) {
+      CFLog(WARN, "ParCFmeshBinaryFileWriter::setup() => COOLFluiD was built without zlib: Compress is ignored\n");
+      _compress = false;
+    }
+    else if (!_collectiveIO) {
+      CFLog(WARN, "ParCFmeshBinaryFileWriter::setup() => Compress requires CollectiveIO, which is switched on\n");
+      _collectiveIO = true;
+    }
+    _compressionLevel = std::max(std::min(_compressionLevel, (CFuint)9), (CFuint)1);
+    _compressionChunkSize = std::max(_compressionChunkSize, (CFuint)1);
+  }
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -109,12 +143,18 @@ void ParCFmeshBinaryFileWriter::writeToFile(const boost::filesystem::path& filep
   // the partitioning is not well balanced
   // make sure that only writer ranks contribute to the selection by assigning 
   // huge number of elements to the oher processors 
-  CFuint nbLocalElements = (_isWriterRank) ? getWriteData().getNbElements() : std::numeric_limits<CFuint>::max();
-  CFuint minNumberElements = 0;
-  MPI_Allreduce(&nbLocalElements, &minNumberElements, 1, MPIStructDef::getMPIType(&nbLocalElements), MPI_MIN, _comm);
-  CFuint rank = (minNumberElements == nbLocalElements)  ? _myRank : 0;
-  // IO rank is maximum rank whose corresponding process has minimum number of elements
-  MPI_Allreduce(&rank, &_ioRank, 1, MPIStructDef::getMPIType(&rank), MPI_MAX, _comm);    
+  // with collective I/O the IO rank only writes the headers, which are small
+  if (_collectiveIO) {
+    _ioRank = 0;
+  }
+  else {
+    CFuint nbLocalElements = (_isWriterRank) ? getWriteData().getNbElements() : std::numeric_limits<CFuint>::max();
+    CFuint minNumberElements = 0;
+    MPI_Allreduce(&nbLocalElements, &minNumberElements, 1, MPIStructDef::getMPIType(&nbLocalElements), MPI_MIN, _comm);
+    CFuint rank = (minNumberElements == nbLocalElements)  ? _myRank : 0;
+    // IO rank is maximum rank whose corresponding process has minimum number of elements
+    MPI_Allreduce(&rank, &_ioRank, 1, MPIStructDef::getMPIType(&rank), MPI_MAX, _comm);    
+  }
   CFLog(INFO, "ParCFmeshBinaryFileWriter::writeToFile() => IO rank is " << _ioRank << "\n");
   
   // if the file has already been processed once, open in I/O mode
@@ -150,7 +190,20 @@ void ParCFmeshBinaryFileWriter::writeToFileStream
   CFLog(VERBOSE, "wg.globalRanks.size() = " << wg.globalRanks.size() << "\n");
   CFLog(VERBOSE, "wg.groupRanks.size() = " << wg.groupRanks.size() << "\n");  
   // all writers open the file for the second or more time
-  if (_isWriterRank) {
+  if (_collectiveIO) {
+    // all the processes open the file: collective buffering aggregates 
+    // the data on NbWriters processes before they hit the file system
+    MPI_Info info;
+    MPI_Info_create(&info);
+    MPI_Info_set(info, const_cast<char*>("romio_cb_write"), const_cast<char*>("enable"));
+    if (_nbWriters > 1) {
+      const string cbNodes = StringOps::to_str(_nbWriters);
+      MPI_Info_set(info, const_cast<char*>("cb_nodes"), const_cast<char*>(cbNodes.c_str()));
+    }
+    MPI_File_open(_comm, fileName, MPI_MODE_RDWR | MPI_MODE_CREATE, info, &_fh); 
+    MPI_Info_free(&info);
+  }
+  else if (_isWriterRank) {
     MPI_File_open(wg.comm, fileName, MPI_MODE_RDWR | MPI_MODE_CREATE, MPI_INFO_NULL, &_fh); 
   }
   
@@ -204,7 +257,7 @@ void ParCFmeshBinaryFileWriter::writeToFileStream
   // terminate the file
   writeEndFile(&_fh);
   
-  if (_isWriterRank) {
+  if (_isWriterRank || _collectiveIO) {
     MPI_File_close(&_fh);
   }
   
@@ -400,7 +453,7 @@ void ParCFmeshBinaryFileWriter::writeElementList(MPI_File* fh)
   CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeElementList() start\n");
   
   if (_myRank  == _ioRank) {
-    MPIIOFunctions::writeKeyValue<char>(fh, "\n!LIST_ELEM");
+    MPIIOFunctions::writeKeyValue<char>(fh, (_compress) ? "\n!LIST_ELEM_Z" : "\n!LIST_ELEM");
     MPIIOFunctions::writeKeyValue<char>(fh, "\n");
   }
   
@@ -450,6 +503,55 @@ void ParCFmeshBinaryFileWriter::writeElementList(MPI_File* fh)
   CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeElementList() => offsets = [" 
 	<<  _offset[0].elems.first << ", " << _offset[0].elems.second << "]\n");
   
+  if (_collectiveIO) {
+    SafePtr<TopologicalRegionSet> elements = MeshDataStack::getActive()->getTrs("InnerCells");
+    DataHandle < Framework::Node*, Framework::GLOBAL > nodes =
+      MeshDataStack::getActive()->getNodeDataSocketSink().getDataHandle();
+    DataHandle < Framework::State*, Framework::GLOBAL > states =
+      MeshDataStack::getActive()->getStateDataSocketSink().getDataHandle();
+    Common::SafePtr< vector<CFuint> > globalElementIDs = 
+      MeshDataStack::getActive()->getGlobalElementIDs();
+    
+    // the element types are written one after the other
+    MPI_Offset typeOffset = _offset[0].elems.first;
+    vector<CFuint> typeGlobalIDs;
+    vector<CFuint> elementData;
+    CFuint elemID = 0;
+    for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
+      const CFuint nbNodesInType  = (*me)[iType].getNbNodes();
+      const CFuint nbStatesInType = (*me)[iType].getNbStates();
+      const CFuint nodesPlusStates = nbNodesInType + nbStatesInType;
+      const CFuint nbLocalElementsInType = (*me)[iType].getNbElems();
+      
+      typeGlobalIDs.resize(nbLocalElementsInType);
+      elementData.resize(nbLocalElementsInType*nodesPlusStates);
+      CFuint isend = 0;
+      for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem, ++elemID) {
+	typeGlobalIDs[iElem] = (*globalElementIDs)[elemID];
+	for (CFuint in = 0; in < nbNodesInType; ++in, ++isend) {
+	  elementData[isend] = nodes[elements->getNodeID(elemID, in)]->getGlobalID();
+	}
+	for (CFuint in = 0; in < nbStatesInType; ++in, ++isend) {
+	  elementData[isend] = states[elements->getStateID(elemID, in)]->getGlobalID();
+	}
+      }
+      
+      const CFuint nbElementsInType = (*me)[iType].getNbTotalElems();
+      typeOffset = writeListCollective("ParCFmeshBinaryFileWriter::writeElementList()", fh, typeOffset, 
+				       nbElementsInType, nodesPlusStates, (CFuint)0, typeGlobalIDs, 
+				       elementData, _compress);
+    }
+    _offset[0].elems.second = typeOffset;
+    
+    if (_isWriterRank) {
+      MPI_File_seek(*fh, _offset[0].elems.second, MPI_SEEK_SET);
+    }
+    
+    CFLogInfo("Element written \n"); 
+    CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeElementList() end\n");
+    return;
+  }
+  
   Common::SafePtr< vector<CFuint> > globalElementIDs = 
     MeshDataStack::getActive()->getGlobalElementIDs();
   cf_assert(globalElementIDs->size() == nbLocalElements);
@@ -709,7 +811,7 @@ void ParCFmeshBinaryFileWriter::writeNodeList(MPI_File* fh)
   }
   
   if (_myRank == _ioRank) {
-    MPIIOFunctions::MPIIOFunctions::writeKeyValue<char>(fh, "\n!LIST_NODE");
+    MPIIOFunctions::MPIIOFunctions::writeKeyValue<char>(fh, (_compress) ? "\n!LIST_NODE_Z" : "\n!LIST_NODE");
     MPIIOFunctions::MPIIOFunctions::writeKeyValue<char>(fh, "\n");
   }
   
@@ -754,6 +856,53 @@ void ParCFmeshBinaryFileWriter::writeNodeList(MPI_File* fh)
   CFuint nodesStride = dim + totalNbExtraNodalVars;
   if (storePastNodes) {nodesStride += dim;}
   
+  if (_collectiveIO) {
+    _offset[0].nodes.first  = offset;
+    _offset[0].nodes.second = _offset[0].nodes.first + sizeof(CFreal)*totNbNodes*nodesStride;
+    
+    // each node is written by the process which updates it
+    vector<CFuint> globalIDs;
+    vector<CFreal> nodeData;
+    globalIDs.reserve(nodes.size());
+    nodeData.reserve(nodes.size()*nodesStride);
+    for (CFuint iNode = 0; iNode < nodes.size(); ++iNode) {
+      if (nodes[iNode]->isParUpdatable()) {
+	globalIDs.push_back(nodes[iNode]->getGlobalID());
+	for (CFuint in = 0; in < dim; ++in) {
+	  nodeData.push_back((*nodes[iNode])[in]*refL);
+	}
+	
+	if (storePastNodes) {
+	  const RealVector* pastNodesValues = getWriteData().getPastNode(iNode);
+	  cf_assert(pastNodesValues->size() == dim);
+	  for (CFuint in = 0; in < dim; ++in) {
+	    nodeData.push_back((*pastNodesValues)[in]);
+	  }
+	}
+	
+	if (nbExtraNodalVars > 0) {
+	  const RealVector& extraNodalValues = getWriteData().getExtraNodalValues(iNode);
+	  cf_assert(extraNodalValues.size() == totalNbExtraNodalVars);
+	  for (CFuint in = 0; in < totalNbExtraNodalVars; ++in) {
+	    nodeData.push_back(extraNodalValues[in]);
+	  }
+	}
+      }
+    }
+    
+    _offset[0].nodes.second = writeListCollective
+      ("ParCFmeshBinaryFileWriter::writeNodeList()", fh, offset, 
+       totNbNodes, nodesStride, (CFreal)0, globalIDs, nodeData, _compress);
+    
+    if (_isWriterRank) {
+      MPI_File_seek(*fh, _offset[0].nodes.second, MPI_SEEK_SET);
+    }
+    
+    CFLogInfo("Nodes written \n");
+    CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeNodeList() end\n");
+    return;
+  }
+  
   // fill in the writer ist
   CFuint totalToSend = 0;
   elementList.fill(totNbNodes, nodesStride, totalToSend);
@@ -904,7 +1053,8 @@ void ParCFmeshBinaryFileWriter::writeStateList(MPI_File* fh)
   }
   
   if (_myRank == _ioRank) {
-    MPIIOFunctions::MPIIOFunctions::writeKeyValue<CFuint>(fh, "\n!LIST_STATE ", false, getWriteData().isWithSolution());
+    MPIIOFunctions::MPIIOFunctions::writeKeyValue<CFuint>
+      (fh, (_compress) ? "\n!LIST_STATE_Z " : "\n!LIST_STATE ", false, getWriteData().isWithSolution());
     MPIIOFunctions::MPIIOFunctions::writeKeyValue<char>(fh, "\n");
   }
   
@@ -951,6 +1101,61 @@ void ParCFmeshBinaryFileWriter::writeStateList(MPI_File* fh)
     if (storePastStates)  {statesStride += dim;}
     if (storeInterStates) {statesStride += dim;}
     
+    if (_collectiveIO) {
+      _offset[0].states.first  = offset;
+      _offset[0].states.second = _offset[0].states.first + sizeof(CFreal)*totNbStates*statesStride;
+      
+      // each state is written by the process which updates it
+      vector<CFuint> globalIDs;
+      vector<CFreal> stateData;
+      globalIDs.reserve(states.size());
+      stateData.reserve(states.size()*statesStride);
+      for (CFuint iState = 0; iState < states.size(); ++iState) {
+	if (states[iState]->isParUpdatable()) {
+	  globalIDs.push_back(states[iState]->getGlobalID());
+	  for (CFuint in = 0; in < dim; ++in) {
+	    stateData.push_back((*states[iState])[in]);
+	  }
+	  
+	  if (storePastStates) {
+	    const RealVector* pastStatesValues = getWriteData().getPastState(iState);
+	    cf_assert(pastStatesValues->size() == dim);
+	    for (CFuint in = 0; in < dim; ++in) {
+	      stateData.push_back((*pastStatesValues)[in]);
+	    }
+	  }
+	  
+	  if (storeInterStates) {
+	    const RealVector* interStatesValues = getWriteData().getInterState(iState);
+	    cf_assert(interStatesValues->size() == dim);
+	    for (CFuint in = 0; in < dim; ++in) {
+	      stateData.push_back((*interStatesValues)[in]);
+	    }
+	  }
+	  
+	  if (nbExtraStateVars > 0) {
+	    const RealVector& extraStateValues = getWriteData().getExtraStateValues(iState);
+	    cf_assert(extraStateValues.size() == totalNbExtraStateVars);
+	    for (CFuint in = 0; in < totalNbExtraStateVars; ++in) {
+	      stateData.push_back(extraStateValues[in]);
+	    }
+	  }
+	}
+      }
+      
+      _offset[0].states.second = writeListCollective
+	("ParCFmeshBinaryFileWriter::writeStateList()", fh, offset, 
+	 totNbStates, statesStride, (CFreal)0, globalIDs, stateData, _compress);
+      
+      if (_isWriterRank) {
+	MPI_File_seek(*fh, _offset[0].states.second, MPI_SEEK_SET);
+      }
+      
+      CFLogInfo("States written \n");
+      CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeStateList() end\n");
+      return;
+    }
+    
     // fill in the writer ist
     CFuint totalToSend = 0;
     elementList.fill(totNbStates, statesStride, totalToSend);
@@ -1222,6 +1427,57 @@ void ParCFmeshBinaryFileWriter::writeGeoList(CFuint iTRS, MPI_File* fh)
     MPI_File_seek(*fh, _offset[0].TRS[iTRS].first, MPI_SEEK_SET);
   }
   
+  if (_collectiveIO) {
+    DataHandle < Framework::Node*, Framework::GLOBAL > nodes =
+      MeshDataStack::getActive()->getNodeDataSocketSink().getDataHandle();
+    DataHandle < Framework::State*, Framework::GLOBAL > states =
+      MeshDataStack::getActive()->getStateDataSocketSink().getDataHandle();
+    
+    // the TRs are written one after the other, missing nodes and states are set to -1
+    MPI_Offset trOffset = _offset[0].TRS[iTRS].first;
+    vector<CFuint> trGlobalIDs;
+    vector<CFint> geoData;
+    for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
+      const CFuint maxNbNodesInType  = nbNodesStatesInTRGeo(iType, 0);
+      const CFuint maxNbStatesInType = nbNodesStatesInTRGeo(iType, 1);
+      const CFuint maxNodesPlusStates = maxNbNodesInType + maxNbStatesInType + 2;
+      const CFuint nbLocalElementsInType = (*trs)[iType]->getLocalNbGeoEnts();
+      
+      trGlobalIDs.resize(nbLocalElementsInType);
+      geoData.assign(nbLocalElementsInType*maxNodesPlusStates, -1);
+      for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
+	trGlobalIDs[iElem] = (*globalGeoIDS)[iTRS][iType][iElem];
+	
+	CFuint isend = iElem*maxNodesPlusStates;
+	const CFuint nbNodesInTRGeo  = (*trs)[iType]->getNbNodesInGeo(iElem);
+	const CFuint nbStatesInTRGeo = (isFVMCC) ? 1 : (*trs)[iType]->getNbStatesInGeo(iElem);
+	geoData[isend++] = nbNodesInTRGeo;
+	geoData[isend++] = nbStatesInTRGeo;
+	
+	for (CFuint in = 0; in < nbNodesInTRGeo; ++in) {
+	  geoData[isend + in] = nodes[(*trs)[iType]->getNodeID(iElem, in)]->getGlobalID();
+	}
+	isend += maxNbNodesInType;
+	
+	for (CFuint in = 0; in < nbStatesInTRGeo; ++in) {
+	  geoData[isend + in] = states[(*trs)[iType]->getStateID(iElem, in)]->getGlobalID();
+	}
+      }
+      
+      const CFuint nbElementsInType = trsInfo[iTRS][iType];
+      writeListCollective("ParCFmeshBinaryFileWriter::writeGeoList()", fh, trOffset, 
+			  nbElementsInType, maxNodesPlusStates, (CFint)-1, trGlobalIDs, geoData);
+      trOffset += (MPI_Offset)(nbElementsInType*maxNodesPlusStates)*sizeof(CFint);
+    }
+    
+    if (_isWriterRank) {
+      MPI_File_seek(*fh, _offset[0].TRS[iTRS].second, MPI_SEEK_SET);
+    }
+    
+    CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeGeoList() end\n");
+    return;
+  }
+  
   // insert in the write list the local IDs of the elements
   // the range ID is automatically determined inside the WriteListMap
   for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
@@ -1399,6 +1655,184 @@ void ParCFmeshBinaryFileWriter::writeEndFile(MPI_File* fh)
   CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeEndFile() end\n");
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+MPI_Offset ParCFmeshBinaryFileWriter::writeListCollective
+(const std::string& name, MPI_File* fh, MPI_Offset offset, 
+ const CFuint nbEntries, const CFuint stride, const T fillValue,
+ const vector<CFuint>& globalIDs, const vector<T>& records, const bool compress)
+{
+  cf_assert(records.size() == globalIDs.size()*stride);
+  
+  // each process owns a contiguous block of global IDs 
+  CFuint blockSize = std::max((nbEntries + _nbProc - 1)/_nbProc, (CFuint)1);
+  
+  // compressed blocks are made of whole chunks, so that each chunk
+  // is compressed by a single process
+  const CFuint chunkSize = _compressionChunkSize;
+  if (compress) {
+    blockSize = ((blockSize + chunkSize - 1)/chunkSize)*chunkSize;
+  }
+  
+  // counts for the records to send to each process
+  vector<int> sendCount(_nbProc, 0);
+  for (CFuint i = 0; i < globalIDs.size(); ++i) {
+    cf_assert(globalIDs[i] < nbEntries);
+    ++sendCount[globalIDs[i]/blockSize];
+  }
+  
+  vector<int> recvCount(_nbProc, 0);
+  MPIError::getInstance().check
+    ("MPI_Alltoall", name, 
+     MPI_Alltoall(&sendCount[0], 1, MPIStructDef::getMPIType(&sendCount[0]), 
+		  &recvCount[0], 1, MPIStructDef::getMPIType(&recvCount[0]), _comm));
+  
+  vector<int> sendDispl(_nbProc, 0);
+  vector<int> recvDispl(_nbProc, 0);
+  for (CFuint p = 1; p < _nbProc; ++p) {
+    sendDispl[p] = sendDispl[p-1] + sendCount[p-1];
+    recvDispl[p] = recvDispl[p-1] + recvCount[p-1];
+  }
+  const CFuint nbRecv = recvDispl.back() + recvCount.back();
+  
+  // sort the global IDs and the records by destination process
+  vector<CFuint> sendIDs(std::max(globalIDs.size(), (size_t)1));
+  vector<T> sendBuf(std::max(records.size(), (size_t)1));
+  vector<int> sendPos(sendDispl);
+  for (CFuint i = 0; i < globalIDs.size(); ++i) {
+    const CFuint is = sendPos[globalIDs[i]/blockSize]++;
+    sendIDs[is] = globalIDs[i];
+    std::copy(&records[i*stride], &records[i*stride] + stride, &sendBuf[is*stride]);
+  }
+  
+  vector<CFuint> recvIDs(std::max(nbRecv, (CFuint)1));
+  MPIError::getInstance().check
+    ("MPI_Alltoallv", name, 
+     MPI_Alltoallv(&sendIDs[0], &sendCount[0], &sendDispl[0], 
+		   MPIStructDef::getMPIType(&sendIDs[0]), 
+		   &recvIDs[0], &recvCount[0], &recvDispl[0], 
+		   MPIStructDef::getMPIType(&recvIDs[0]), _comm));
+  
+  // the records are exchanged as arrays of stride entries
+  for (CFuint p = 0; p < _nbProc; ++p) {
+    sendCount[p] *= stride;
+    sendDispl[p] *= stride;
+    recvCount[p] *= stride;
+    recvDispl[p] *= stride;
+  }
+  
+  vector<T> recvBuf(std::max(nbRecv*stride, (CFuint)1));
+  MPIError::getInstance().check
+    ("MPI_Alltoallv", name, 
+     MPI_Alltoallv(&sendBuf[0], &sendCount[0], &sendDispl[0], 
+		   MPIStructDef::getMPIType(&sendBuf[0]), 
+		   &recvBuf[0], &recvCount[0], &recvDispl[0], 
+		   MPIStructDef::getMPIType(&recvBuf[0]), _comm));
+  
+  // assemble the block of this process (records received more than once are equal)
+  const CFuint start = std::min(_myRank*blockSize, nbEntries);
+  const CFuint end   = std::min(start + blockSize, nbEntries);
+  vector<T> block((end - start)*stride, fillValue);
+  for (CFuint i = 0; i < nbRecv; ++i) {
+    cf_assert(recvIDs[i] >= start && recvIDs[i] < end);
+    std::copy(&recvBuf[i*stride], &recvBuf[i*stride] + stride, &block[(recvIDs[i] - start)*stride]);
+  }
+  
+  if (!compress) {
+    // the position of the block in the list is the sum of the sizes of the previous blocks
+    CFuint blockBufSize = block.size();
+    CFuint blockStart = 0;
+    MPI_Exscan(&blockBufSize, &blockStart, 1, MPIStructDef::getMPIType(&blockBufSize), MPI_SUM, _comm);
+    if (_myRank == 0) {
+      blockStart = 0;
+    }
+    
+    T emptyBuf = fillValue;
+    T* buf = (block.size() > 0) ? &block[0] : &emptyBuf;
+    writeAtAll(name, fh, offset + (MPI_Offset)blockStart*sizeof(T), buf, (CFuint)block.size());
+    return offset + (MPI_Offset)nbEntries*stride*sizeof(T);
+  }
+  
+  // the compressed list is made of a header (nbEntries, stride, chunkSize, nbChunks), 
+  // the offsets of the nbChunks+1 chunk boundaries relative to the end of the  
+  // header and the compressed chunks, one after the other
+  const CFuint nbChunks = (nbEntries + chunkSize - 1)/chunkSize;
+  vector<int> chunkCount(_nbProc, 0);
+  vector<int> chunkDispl(_nbProc, 0);
+  for (CFuint p = 0; p < _nbProc; ++p) {
+    const CFuint pStart = std::min(p*blockSize, nbEntries);
+    const CFuint pEnd   = std::min(pStart + blockSize, nbEntries);
+    chunkCount[p] = (pEnd - pStart + chunkSize - 1)/chunkSize;
+    chunkDispl[p] = pStart/chunkSize;
+  }
+  
+  vector<char> compressed;
+  vector<MPI_Offset> localChunkSizes(std::max(chunkCount[_myRank], 1), 0);
+  for (int ic = 0; ic < chunkCount[_myRank]; ++ic) {
+    const CFuint first = ic*chunkSize;
+    const CFuint nbRecords = std::min(chunkSize, end - start - first);
+    const size_t compressedStart = compressed.size();
+    ShuffleCompressor::compress(reinterpret_cast<const char*>(&block[first*stride]), 
+				nbRecords*stride, sizeof(T), (int)_compressionLevel, compressed);
+    localChunkSizes[ic] = compressed.size() - compressedStart;
+  }
+  
+  vector<MPI_Offset> chunkOffsets(nbChunks + 1, 0);
+  MPIError::getInstance().check
+    ("MPI_Allgatherv", name, 
+     MPI_Allgatherv(&localChunkSizes[0], chunkCount[_myRank], MPIStructDef::getMPIOffsetType(), 
+		    &chunkOffsets[0] + 1, &chunkCount[0], &chunkDispl[0], 
+		    MPIStructDef::getMPIOffsetType(), _comm));
+  for (CFuint ic = 0; ic < nbChunks; ++ic) {
+    chunkOffsets[ic+1] += chunkOffsets[ic];
+  }
+  
+  CFuint header[4] = {nbEntries, stride, chunkSize, nbChunks};
+  const MPI_Offset dataStart = offset + 4*sizeof(CFuint) + (nbChunks + 1)*sizeof(MPI_Offset);
+  if (_myRank == _ioRank) {
+    MPI_File_write_at(*fh, offset, &header[0], 4, MPIStructDef::getMPIType(&header[0]), &_status);
+    MPI_File_write_at(*fh, offset + 4*sizeof(CFuint), &chunkOffsets[0], (int)(nbChunks + 1), 
+		      MPIStructDef::getMPIOffsetType(), &_status);
+  }
+  
+  char emptyBuf = 0;
+  char* buf = (compressed.size() > 0) ? &compressed[0] : &emptyBuf;
+  writeAtAll(name, fh, dataStart + chunkOffsets[chunkDispl[_myRank]], buf, (CFuint)compressed.size());
+  
+  CFLog(VERBOSE, name << " => " << nbEntries*stride*sizeof(T) << " bytes compressed to " 
+	<< chunkOffsets[nbChunks] << " in " << nbChunks << " chunks\n");
+  
+  return dataStart + chunkOffsets[nbChunks];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void ParCFmeshBinaryFileWriter::writeAtAll
+(const std::string& name, MPI_File* fh, MPI_Offset offset, T* buf, const CFuint bufSize)
+{
+  // write the buffer in chunks of at most MaxBuffSize bytes
+  const CFuint maxChunkSize = std::max(_maxBuffSize/sizeof(T), (size_t)1);
+  CFuint nbChunks = (bufSize + maxChunkSize - 1)/maxChunkSize;
+  CFuint maxNbChunks = 0;
+  MPI_Allreduce(&nbChunks, &maxNbChunks, 1, MPIStructDef::getMPIType(&nbChunks), MPI_MAX, _comm);
+  
+  for (CFuint ic = 0; ic < maxNbChunks; ++ic) {
+    const CFuint first = std::min(ic*maxChunkSize, bufSize);
+    const CFuint chunkSize = std::min(maxChunkSize, bufSize - first);
+    const MPI_Offset chunkOffset = offset + (MPI_Offset)first*sizeof(T);
+    
+    CFLog(VERBOSE, _myRank << " in " << name << " writes buffer of size " 
+	  << chunkSize << " starting from " << chunkOffset << "\n");
+    
+    MPIError::getInstance().check
+      ("MPI_File_write_at_all", name, 
+       MPI_File_write_at_all(*fh, chunkOffset, buf + first, (int)chunkSize, 
+			     MPIStructDef::getMPIType(buf), &_status));
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
  
     } // namespace CFmeshFileWriter
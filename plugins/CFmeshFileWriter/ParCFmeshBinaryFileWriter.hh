@@ -118,11 +118,51 @@ protected: // helper functions
   /// Writes the end of the file
   void writeEndFile(MPI_File* fh);
   
+  /// Writes a list of fixed size records ordered by global ID with collective
+  /// MPI-IO: the records are redistributed so that each process owns a contiguous
+  /// block of global IDs, then each process writes its block at the offset
+  /// given by an exclusive scan of the block sizes
+  /// @param name      name of the calling function (for error messages)
+  /// @param offset    offset of the start of the list in the file
+  /// @param nbEntries total number of records in the list
+  /// @param stride    size of each record
+  /// @param fillValue value of the unset record components
+  /// @param globalIDs global IDs of the local records (possibly duplicated on
+  ///                  other processes, in which case the records must be equal)
+  /// @param records   local records, one after the other
+  /// @param compress  if true, the list is split in chunks of CompressionChunkSize
+  ///                  records which are compressed independently and preceded
+  ///                  by a header and by the offsets of the chunks
+  /// @return the offset of the end of the list in the file
+  template <typename T>
+  MPI_Offset writeListCollective(const std::string& name, MPI_File* fh, MPI_Offset offset,
+				 const CFuint nbEntries, const CFuint stride, const T fillValue,
+				 const std::vector<CFuint>& globalIDs, 
+				 const std::vector<T>& records, const bool compress = false);
+  
+  /// Writes a buffer at the given offset with collective MPI-IO, in pieces
+  /// of at most MaxBuffSize bytes (all the processes must call it)
+  template <typename T>
+  void writeAtAll(const std::string& name, MPI_File* fh, MPI_Offset offset,
+		  T* buf, const CFuint bufSize);
+  
 protected: // data
   
   /// acquaintance of the data present in the CFmesh file
   Common::SafePtr<Framework::CFmeshWriterSource> _writeData;
   
+  /// flag telling if all the processes write their data with collective MPI-IO
+  bool _collectiveIO;
+  
+  /// flag telling if the nodes, states and elements lists are compressed
+  bool _compress;
+  
+  /// zlib compression level
+  CFuint _compressionLevel;
+  
+  /// number of records in each compressed chunk
+  CFuint _compressionChunkSize;
+  
 }; // class ParCFmeshBinaryFileWriter
 
 //////////////////////////////////////////////////////////////////////////////
@@ -1,10 +1,12 @@
 #include "Common/COOLFluiD.hh"
+#include "Common/OMPHelper.hh"
 
 #include "MathTools/MathFunctions.hh"
 
 #include "Framework/MethodCommandProvider.hh"
 #include "Framework/LSSMatrix.hh"
 #include "Framework/BlockAccumulator.hh"
+#include "Framework/CFSide.hh"
 
 #include "DiscontGalerkin/StdBaseSolve.hh"
 #include "DiscontGalerkin/DiscontGalerkin.hh"
@@ -26,9 +28,23 @@ MethodCommandProvider< StdBaseSolve,DiscontGalerkinSolverData,DiscontGalerkinMod
 
 //////////////////////////////////////////////////////////////////////////////
 
+void StdBaseSolve::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< CFuint >("NbThreadsOMP","Number of OMP threads computing the local matrices of the cells and of the faces (0 = all available).");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 StdBaseSolve::StdBaseSolve(const std::string& name)
-  : DiscontGalerkinSolverCom(name)
+  : DiscontGalerkinSolverCom(name),
+    m_state(CFNULL),
+    m_threadData(),
+    m_nbThreads(1),
+    m_nbSlots(1)
 {
+  addConfigOptionsTo(this);
+  m_nbThreadsOMP = 1;
+  setParameter("NbThreadsOMP",&m_nbThreadsOMP);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -43,6 +59,49 @@ void StdBaseSolve::setup()
 {
   CFAUTOTRACE;
   m_state = new Framework::State;
+
+  const CFuint nbDim = PhysicalModelStack::getActive()->getDim();
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+
+  // the geometric data of the entities are gathered serially, in blocks
+  // large enough to keep all the threads busy
+  m_nbThreads = getNbThreadsOMP(m_nbThreadsOMP);
+  m_nbSlots = (m_nbThreads > 1) ? 16*m_nbThreads : 1;
+  CFLog(VERBOSE, "StdBaseSolve::setup() => " << m_nbThreads << " thread(s), "
+        << m_nbSlots << " entities per block\n");
+
+  m_threadData.resize(m_nbThreads);
+  for (CFuint iThread = 0; iThread < m_nbThreads; ++iThread)
+  {
+    ThreadData& thd = m_threadData[iThread];
+    thd.state  = new Framework::State;
+    thd.stateA = new Framework::State;
+    thd.aMatrix.resize(nbDim);
+    for (CFuint s = 0; s < nbDim; ++s)
+    {
+      thd.aMatrix[s].resize(nbEqs,nbEqs);
+      thd.aMatrix[s] = 0.;
+    }
+    thd.kMatrix.resize(2);
+    for (CFuint iSide = 0; iSide < 2; ++iSide)
+    {
+      thd.kMatrix[iSide].resize(nbDim);
+      for (CFuint s = 0; s < nbDim; ++s)
+      {
+        thd.kMatrix[iSide][s].resize(nbDim);
+        for (CFuint k = 0; k < nbDim; ++k)
+        {
+          thd.kMatrix[iSide][s][k].resize(nbEqs,nbEqs);
+          thd.kMatrix[iSide][s][k] = 0.;
+        }
+      }
+    }
+    thd.T.resize(nbEqs,nbEqs);
+    thd.T1.resize(nbEqs,nbEqs);
+    thd.Pplus.resize(nbEqs,nbEqs);
+    thd.Pminus.resize(nbEqs,nbEqs);
+    thd.EigenVal.resize(2,nbEqs);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -50,6 +109,201 @@ void StdBaseSolve::setup()
 void StdBaseSolve::unsetup()
 {
   CFAUTOTRACE;
+
+  for (CFuint iThread = 0; iThread < m_threadData.size(); ++iThread)
+  {
+    deletePtr(m_threadData[iThread].state);
+    deletePtr(m_threadData[iThread].stateA);
+  }
+  m_threadData.clear();
+
+  deletePtr(m_state);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdBaseSolve::createElemData(const std::vector< CFuint >& nbStatesPerEntity,
+                                  std::vector< CFMap< CFuint, DGElemTypeData > >& mapElemData)
+{
+  CFAUTOTRACE;
+
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+
+  // each slot of a block has its own accumulators, so that the local
+  // matrices of a block can be computed concurrently
+  mapElemData.resize(m_nbSlots);
+  for (CFuint iSlot = 0; iSlot < m_nbSlots; ++iSlot)
+  {
+    for (CFuint iType = 0; iType < nbStatesPerEntity.size(); ++iType)
+    {
+      const CFuint nbStatesInType = nbStatesPerEntity[iType];
+      if (mapElemData[iSlot].exists(nbStatesInType)) continue;
+
+      BlockAccumulator* ptr = getMethodData().getLinearSystemSolver()[0]->
+        createBlockAccumulator(nbStatesInType,nbStatesInType,nbEqs);
+      RealVector* vec = new RealVector(nbStatesInType*nbEqs);
+      RealMatrix* mat = new RealMatrix(nbStatesInType*nbEqs,nbStatesInType*nbEqs);
+      const RealVector stateResidual(nbEqs);
+      vector<RealVector>* residual = new vector<RealVector>(nbStatesInType,stateResidual);
+
+      DGElemTypeData elemTypeData(ptr,mat,vec,residual);
+
+      mapElemData[iSlot].insert(nbStatesInType, elemTypeData);
+      mapElemData[iSlot].sortKeys();
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdBaseSolve::deleteElemData(std::vector< CFMap< CFuint, DGElemTypeData > >& mapElemData)
+{
+  CFAUTOTRACE;
+
+  for (CFuint iSlot = 0; iSlot < mapElemData.size(); ++iSlot)
+  {
+    for (CFuint iType = 0; iType < mapElemData[iSlot].size(); ++iType)
+    {
+      DGElemTypeData& elemTypeData = mapElemData[iSlot][iType];
+      deletePtr(elemTypeData.first);
+      deletePtr(elemTypeData.second);
+      deletePtr(elemTypeData.third);
+      deletePtr(elemTypeData.fourth);
+    }
+  }
+  mapElemData.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdBaseSolve::setCellData(GeometricEntity& cell, DGCellData& data)
+{
+  const CFuint nbDim = PhysicalModelStack::getActive()->getDim();
+
+  data.states = *cell.getStates();
+  data.isUpdatable = data.states[0]->isParUpdatable();
+  if (!data.isUpdatable) return;
+
+  SafePtr<VolumeIntegrator> integrator = getMethodData().getVolumeIntegrator();
+
+  //compute shape function in quadrature points
+  data.shapeFunctions = &integrator->getSolutionIntegrator(&cell)->computeShapeFunctionsAtQuadraturePoints();
+
+  //numbers of quadrature points
+  data.nbQuadPnts = integrator->getSolutionIntegrator(&cell)->getIntegratorPattern()[0];
+
+  //set weights for element quadrature
+  data.weights = &integrator->getSolutionIntegrator(&cell)->getCoeff();
+
+  //compute gradient of shape functions in quadrature points
+  const std::vector<RealVector>& coord = integrator->getSolutionIntegrator(&cell)->getQuadraturePointsCoordinates();
+  data.gradients = cell.computeSolutionShapeFunctionGradientsInMappedCoordinates(coord);
+
+  //computation of the Jacobi determinant of mapping from refference element to cell
+  /// @todo this must be generalized
+  data.detJacobi = abs(cell.computeVolume())*((nbDim == 2) ? 2.0 : 6.0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdBaseSolve::setFaceData(GeometricEntity& face,
+                               const std::vector< CFuint >& integrationIndex,
+                               const RealVector& normal,
+                               const bool needsGradients, DGFaceData& data)
+{
+  const CFuint nbDim = PhysicalModelStack::getActive()->getDim();
+
+  //nodes of the actual face
+  std::vector<Node*>& nodes = *face.getNodes();
+  GeometricEntity* cellLeft  = face.getNeighborGeo(LEFT);
+  GeometricEntity* cellRight = face.getNeighborGeo(RIGHT);
+
+  data.leftStates  = *cellLeft->getStates();
+  data.rightStates = *cellRight->getStates();
+  data.leftNodes   = *cellLeft->getNodes();
+
+  data.avgMassCell = (abs(cellRight->computeVolume()) + abs(cellLeft->computeVolume()))/2.0;
+  if (nbDim == 2)
+  {
+    RealVector hlp = *nodes[1] - *nodes[0];
+    data.detJacobi = sqrt(hlp[0]*hlp[0]+hlp[1]*hlp[1]);
+  }
+  else
+  {
+    RealVector hlp1 = *nodes[1] - *nodes[0];
+    RealVector hlp2 = *nodes[2] - *nodes[0];
+    data.detJacobi = sqrt((hlp1[1]*hlp2[2] - hlp1[2]*hlp2[1])*(hlp1[1]*hlp2[2] - hlp1[2]*hlp2[1]) + (hlp1[2]*hlp2[0] - hlp1[0]*hlp2[2])*(hlp1[2]*hlp2[0] - hlp1[0]*hlp2[2])+(hlp1[0]*hlp2[1] - hlp1[1]*hlp2[0])*(hlp1[0]*hlp2[1] - hlp1[1]*hlp2[0]));
+  }
+
+  SafePtr<ContourIntegrator> integrator = getMethodData().getContourIntegrator();
+
+  //compute shape function in quadrature points
+  data.leftShapeFunctions  = &integrator->getSolutionIntegrator(cellLeft)->computeShapeFunctionsAtQuadraturePoints();
+  data.rightShapeFunctions = &integrator->getSolutionIntegrator(cellRight)->computeShapeFunctionsAtQuadraturePoints();
+
+  //numbers of quadrature points
+  const CFuint nbQuadPnts = integrator->getSolutionIntegrator(cellLeft)->getIntegratorPattern()[0];
+
+  //set weights for element quadrature
+  data.weights = &integrator->getSolutionIntegrator(cellLeft)->getCoeff();
+
+  //get coordinates of quadrature points
+  data.leftCoords = &integrator->getSolutionIntegrator(cellLeft)->getQuadraturePointsCoordinates();
+  const std::vector<RealVector>& rightCoord = integrator->getSolutionIntegrator(cellRight)->getQuadraturePointsCoordinates();
+
+  //compute gradient of shape functions in quadrature points
+  if (needsGradients)
+  {
+    data.leftGradients  = cellLeft->computeSolutionShapeFunctionGradientsInMappedCoordinates(*data.leftCoords);
+    data.rightGradients = cellRight->computeSolutionShapeFunctionGradientsInMappedCoordinates(rightCoord);
+  }
+
+  data.normal.resize(nbDim);
+  for(CFuint i=0;i<nbDim;i++) data.normal[i]=normal[i];
+
+  //indexes of the quadrature points of the face in the left and in the right cell
+  const CFuint m_idxFaceFromLeftCell=integrationIndex[0];
+  const CFuint m_idxFaceFromRightCell=integrationIndex[1];
+  const CFuint rightHlpIndex=integrationIndex[2];
+  const CFuint swifted = integrationIndex[3];
+
+  data.leftIdx.resize(nbQuadPnts);
+  data.rightIdx.resize(nbQuadPnts);
+  for(CFuint kvadrature_point = 0; kvadrature_point < nbQuadPnts; kvadrature_point++ )
+  {
+    CFuint leftIndex  = m_idxFaceFromLeftCell*nbQuadPnts + kvadrature_point;
+    CFuint rightIndex;
+    if (nbDim == 2)
+    {
+      rightIndex = m_idxFaceFromRightCell*nbQuadPnts + nbQuadPnts - 1 - kvadrature_point;
+    }
+    else
+    {
+      if (kvadrature_point!=0)
+      {
+        if (swifted == 1)
+        {
+          rightIndex = m_idxFaceFromRightCell*nbQuadPnts + 1 + ((kvadrature_point-1)/3)*3 + (2-(7+rightHlpIndex-kvadrature_point +1)%3);
+        }
+        else
+        {
+          rightIndex = m_idxFaceFromRightCell*nbQuadPnts + 1 + ((kvadrature_point-1)/3)*3 + (2-(kvadrature_point+rightHlpIndex)%3);
+        }
+      }
+      else
+      {
+        rightIndex = m_idxFaceFromRightCell*nbQuadPnts + kvadrature_point;
+      }
+    }
+
+    RealVector hlpVector=cellLeft->computeCoordFromMappedCoord((*data.leftCoords)[leftIndex]) - cellRight->computeCoordFromMappedCoord(rightCoord[rightIndex]);
+    cf_assert((hlpVector.norm1()/data.detJacobi < 0.0001));
+
+    data.leftIdx[kvadrature_point]  = leftIndex;
+    data.rightIdx[kvadrature_point] = rightIndex;
+  }
+
+  data.maxEigenval = 0.;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -15,6 +15,72 @@ namespace COOLFluiD {
 
 //////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Geometric data of a cell needed by its volume integral.
+ * The geometric entities and the shape functions use static scratch data,
+ * therefore these data are gathered serially before the local matrices of
+ * a block of cells are computed concurrently.
+ */
+struct DGCellData {
+  /// states of the cell
+  std::vector< Framework::State* > states;
+  /// shape functions in the quadrature points (owned by the integrator)
+  const std::vector< RealVector >* shapeFunctions;
+  /// quadrature weights (owned by the integrator)
+  const std::valarray< CFreal >* weights;
+  /// gradients of the shape functions in the quadrature points
+  std::vector< RealMatrix > gradients;
+  /// number of quadrature points
+  CFuint nbQuadPnts;
+  /// determinant of the Jacobi matrix
+  CFreal detJacobi;
+  /// flag telling if the cell is parallel updatable
+  bool isUpdatable;
+  /// block accumulator and local matrix of the cell
+  DGElemTypeData elemData;
+};
+
+/**
+ * Geometric data of an inner face needed by its contour integral
+ * (see DGCellData).
+ */
+struct DGFaceData {
+  /// states of the left cell
+  std::vector< Framework::State* > leftStates;
+  /// states of the right cell
+  std::vector< Framework::State* > rightStates;
+  /// nodes of the left cell
+  std::vector< Framework::Node* > leftNodes;
+  /// shape functions of the left cell in the quadrature points (owned by the integrator)
+  const std::vector< RealVector >* leftShapeFunctions;
+  /// shape functions of the right cell in the quadrature points (owned by the integrator)
+  const std::vector< RealVector >* rightShapeFunctions;
+  /// quadrature weights (owned by the integrator)
+  const std::vector< RealVector >* weights;
+  /// mapped coordinates of the quadrature points in the left cell (owned by the integrator)
+  const std::vector< RealVector >* leftCoords;
+  /// gradients of the shape functions of the left cell in the quadrature points
+  std::vector< RealMatrix > leftGradients;
+  /// gradients of the shape functions of the right cell in the quadrature points
+  std::vector< RealMatrix > rightGradients;
+  /// index of each quadrature point of the face among those of the left cell
+  std::vector< CFuint > leftIdx;
+  /// index of each quadrature point of the face among those of the right cell
+  std::vector< CFuint > rightIdx;
+  /// face normal
+  RealVector normal;
+  /// determinant of the Jacobi matrix of the face
+  CFreal detJacobi;
+  /// average volume of the two cells
+  CFreal avgMassCell;
+  /// maximum eigenvalue scaled by detJacobi/avgMassCell
+  CFreal maxEigenval;
+  /// block accumulator and local matrix of the face
+  DGElemTypeData elemData;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
 /**
  * This is a standard command to assemble the system using Empty solver
  * @author Martin Holik
@@ -23,6 +89,12 @@ class StdBaseSolve : public DiscontGalerkinSolverCom {
 
 public: // functions
 
+  /**
+   * Defines the Config Option's of this class
+   * @param options a OptionList where to add the Option's
+   */
+  static void defineConfigOptions(Config::OptionList& options);
+
   /// Constructor
   explicit StdBaseSolve(const std::string& name);
 
@@ -52,11 +124,82 @@ public: // functions
    */
   virtual void unsetup();
 
+protected: // types
+
+  /// scratch data of a thread
+  struct ThreadData {
+    /// state in a quadrature point
+    Framework::State* state;
+    /// average state in a quadrature point of a face
+    Framework::State* stateA;
+    /// jacobi matrices of the inviscid terms A[s]
+    std::vector< RealMatrix > aMatrix;
+    /// viscous matrices K[side][s][k]
+    std::vector< std::vector< std::vector< RealMatrix > > > kMatrix;
+    /// matrices of the eigenvector decomposition and of the numerical flux
+    RealMatrix T;
+    RealMatrix T1;
+    RealMatrix Pplus;
+    RealMatrix Pminus;
+    RealMatrix EigenVal;
+  };
+
+protected: // functions
+
+  /// @return the number of threads integrating the cells and the faces
+  CFuint getNbThreads() const
+  {
+    return m_nbThreads;
+  }
+
+  /// @return the number of cells or faces gathered in a block, whose local
+  ///         matrices are then computed concurrently
+  CFuint getNbSlots() const
+  {
+    return m_nbSlots;
+  }
+
+  /// Create one block accumulator and local matrix for each number of
+  /// states, for each slot of a block
+  /// @param nbStatesPerEntity number of states of the entities (sum of
+  ///                          the two neighbour cells for a face)
+  void createElemData(const std::vector< CFuint >& nbStatesPerEntity,
+                      std::vector< Common::CFMap< CFuint, DGElemTypeData > >& mapElemData);
+
+  /// Delete the block accumulators and local matrices created by createElemData()
+  void deleteElemData(std::vector< Common::CFMap< CFuint, DGElemTypeData > >& mapElemData);
+
+  /// Gather the geometric data of a cell
+  void setCellData(Framework::GeometricEntity& cell, DGCellData& data);
+
+  /// Gather the geometric data of an inner face
+  /// @param integrationIndex integration indexes of the face
+  /// @param normal           normal of the face
+  /// @param needsGradients   if true, compute also the gradients of the shape functions
+  void setFaceData(Framework::GeometricEntity& face,
+                   const std::vector< CFuint >& integrationIndex,
+                   const RealVector& normal,
+                   const bool needsGradients, DGFaceData& data);
+
 protected: // data
 
   ///temporary variable to store state;
   Framework::State *m_state;
 
+  /// scratch data of each thread
+  std::vector< ThreadData > m_threadData;
+
+private: // data
+
+  /// number of threads (user option)
+  CFuint m_nbThreadsOMP;
+
+  /// number of threads actually used
+  CFuint m_nbThreads;
+
+  /// number of entities in a block
+  CFuint m_nbSlots;
+
 }; // class StdBaseSolve
 
 //////////////////////////////////////////////////////////////////////////////
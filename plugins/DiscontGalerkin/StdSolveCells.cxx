@@ -1,3 +1,5 @@
+#include "Common/OMPHelper.hh"
+
 #include "Framework/MethodCommandProvider.hh"
 #include "Framework/LSSMatrix.hh"
 #include "Framework/BlockAccumulator.hh"
@@ -26,6 +28,7 @@ MethodCommandProvider< StdSolveCells,DiscontGalerkinSolverData,DiscontGalerkinMo
 StdSolveCells::StdSolveCells(const std::string& name)
   : StdBaseSolve(name),
     m_mapElemData(),
+    m_cellData(),
     socket_rhs("rhs"),
     socket_states("states"),
     socket_old_states("old_states"),
@@ -48,15 +51,7 @@ void StdSolveCells::setup()
   m_Alpha = getMethodData().getAlpha();
   m_MaxCFL = getMethodData().getMaxCFL();
 //   CFreal gamma = 1.4;
-  const CFuint nbDim = PhysicalModelStack::getActive()->getDim();
   const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
-  // set Amatix to zero and set constant part of them
-  m_aMatrix.resize(nbDim);
-  for (CFuint i =0; i<nbDim; i++)
-  {
-    m_aMatrix[i].resize(nbEqs,nbEqs);
-    m_aMatrix[i] = 0.;
-  }
 
   // set a pointer to the inner cells
   m_cells.reset(MeshDataStack::getActive()->getTrs("InnerCells"));
@@ -77,26 +72,15 @@ void StdSolveCells::setup()
   }
 
   const CFuint nbElemTypes = elementType->size();
+  vector<CFuint> nbStatesPerType(nbElemTypes);
 
   // loop over types since it can happen to deal with an hybrid mesh
   for (CFuint iType = 0; iType < nbElemTypes; ++iType) {
-
-     const CFuint nbStatesInType = (*elementType)[iType].getNbStates();
-
-     BlockAccumulator* ptr = getMethodData().getLinearSystemSolver()[0]->
-       createBlockAccumulator(nbStatesInType,nbStatesInType,nbEqs);
-     RealVector* vec = new RealVector(nbStatesInType*nbEqs);
-     RealVector* vec2 = new RealVector(nbEqs);
-     RealMatrix* mat = new RealMatrix(nbStatesInType*nbEqs,nbStatesInType*nbEqs);
-     vector<RealVector>* residual = new vector<RealVector>(nbStatesInType,*vec2);
-
-     DGElemTypeData elemTypeData(ptr,mat,vec,residual);
-
-     m_mapElemData.insert(nbStatesInType, elemTypeData);
+     nbStatesPerType[iType] = (*elementType)[iType].getNbStates();
   }
 
-  m_mapElemData.sortKeys();
-
+  createElemData(nbStatesPerType, m_mapElemData);
+  m_cellData.resize(getNbSlots());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -104,6 +88,7 @@ void StdSolveCells::setup()
 void StdSolveCells::unsetup()
 {
   CFAUTOTRACE;
+  deleteElemData(m_mapElemData);
   StdBaseSolve::unsetup();
 
   // deallocate our memory
@@ -119,11 +104,9 @@ void StdSolveCells::unsetup()
 void StdSolveCells::execute()
 {
   CFAUTOTRACE;
-  CFuint m_nbKvadrPoint;
   CFout << "StdSolveCells applied to " << m_cells->getName() << CFendl;
   static CFreal tau = 0.0;
   const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
-  const CFuint nbDim = PhysicalModelStack::getActive()->getDim();
 
   // get rhs
   DataHandle<CFreal> rhs = socket_rhs.getDataHandle();
@@ -166,164 +149,166 @@ void StdSolveCells::execute()
   //set that we use only data of inner cells trs
   geoData.trs = trs;
 
-  //loop over all inner cells
-  for(CFuint iGeoEnt = 0; iGeoEnt < nbGeos; ++iGeoEnt) {
-    CFLogDebugMax("Cell " << iGeoEnt << "\n");
-
-    // build the GeometricEntity (cell)
-    //set index of cell
-    geoData.idx = iGeoEnt;
-    //geo builder make cell
-    GeometricEntity& cell = *geoBuilder->buildGE();
-    //read vector of states on element (cell)
-    std::vector<State*>& cellStates = *(cell.getStates());
-    //read number of states on element (cell)
-    const CFuint nbStatesInCell = cellStates.size();
-    //read vector of nodes on element (cell)
-
-    if (cellStates[0]->isParUpdatable())
-    {
-      //*****************************************************************
-      //*****************************************************************
-      //SET Integrator
-      //compute shape function in quadrature points
-      const std::vector<RealVector>& shapeFunctions =  getMethodData().getVolumeIntegrator()->getSolutionIntegrator(&cell)->computeShapeFunctionsAtQuadraturePoints();
-
-      //numbers of quadrature points
-      m_nbKvadrPoint = getMethodData().getVolumeIntegrator()->getSolutionIntegrator(&cell)->getIntegratorPattern()[0];
-
-      //set weights for element quadrature
-      const std::valarray<CFreal>& weight = getMethodData().getVolumeIntegrator()->getSolutionIntegrator(&cell)->getCoeff();
-
-      //get coordinates of quadrature points
-      const std::vector<RealVector>& coord = getMethodData().getVolumeIntegrator()->getSolutionIntegrator(&cell)->getQuadraturePointsCoordinates();
-
-      //compute gradient of shape functions in quadrature points
-      std::vector<RealMatrix> gradient = cell.computeSolutionShapeFunctionGradientsInMappedCoordinates(coord);
-
-      //*****************************************************************
-      //*****************************************************************
-
-      /// @todo this must be improved. Finding in a map
-      /// for every cell is efficiently speaking not acceptable.
-      //make block acumulator with size of sum of states in cell
-      DGElemTypeData elemData = m_mapElemData.find(nbStatesInCell);
-      BlockAccumulator& acc = *elemData.first;
-      RealMatrix& elemMat = *elemData.second;
-      RealVector& elemVec = *elemData.third;
-
-      elemVec = 0.0;
-      //set matrix in blockaccumulator to 0
-      elemMat=0.0;
-      acc.setValuesM(elemMat);
-
-      //computation of the Jacobi determinant of mapping from refference element to cell
-      /// @todo this must be generalized
-      if (nbDim == 2)
+  const CFuint nbThreads = getNbThreads();
+  const CFuint nbSlots = getNbSlots();
+
+  //loop over blocks of inner cells
+  for(CFuint blockStart = 0; blockStart < nbGeos; blockStart += nbSlots) {
+    const CFuint nbCellsInBlock = std::min(nbSlots, nbGeos - blockStart);
+
+    //gather the geometric data of the block (the shape functions are not thread-safe)
+    for(CFuint iSlot = 0; iSlot < nbCellsInBlock; ++iSlot) {
+      CFLogDebugMax("Cell " << blockStart + iSlot << "\n");
+
+      // build the GeometricEntity (cell)
+      //set index of cell
+      geoData.idx = blockStart + iSlot;
+      //geo builder make cell
+      GeometricEntity& cell = *geoBuilder->buildGE();
+      DGCellData& data = m_cellData[iSlot];
+      setCellData(cell, data);
+      if (data.isUpdatable)
       {
-        detJacobi = abs(cell.computeVolume())*2.0;
+        data.elemData = m_mapElemData[iSlot].find(data.states.size());
       }
-      else
+      //release the GeometricEntity
+      geoBuilder->releaseGE();
+    }
+
+    //compute the local matrices of the block concurrently
+    const CFint nbSlotsInBlock = static_cast<CFint>(nbCellsInBlock);
+#pragma omp parallel for schedule(dynamic) num_threads(nbThreads) if(nbThreads > 1)
+    for(CFint iSlot = 0; iSlot < nbSlotsInBlock; ++iSlot) {
+      if (m_cellData[iSlot].isUpdatable)
       {
-        detJacobi = abs(cell.computeVolume())*6.0;
+        computeCellMatrix(m_cellData[iSlot], m_threadData[getThreadIDOMP()], tau, rhs);
       }
+    }
 
-      // set the IDs on the blockaccumulator (we use setRowColIndex() )
-      //connection between local and global state ID
-      for (CFuint iState = 0; iState < nbStatesInCell; ++iState) {
-        const CFuint stateID = cellStates[iState]->getLocalID();
-        acc.setRowColIndex(iState, stateID);
+    // add the values in the jacobian matrix, in the order of the cells
+    for(CFuint iSlot = 0; iSlot < nbCellsInBlock; ++iSlot) {
+      if (m_cellData[iSlot].isUpdatable)
+      {
+        jacobMatrix->addValues(*m_cellData[iSlot].elemData.first);
       }
+    }
+  }
+  CFout << " ... OK\n" << CFendl;
 
-      //loop over kvadrature point on the cell
-      for(CFuint kvadrature_point = 0; kvadrature_point < m_nbKvadrPoint; kvadrature_point++ )
-      {
-        //set elemMat to 0 if isn't
-        if (kvadrature_point!=0) elemMat=0.0;
+//  jacobMatrix->finalAssembly();
+//  jacobMatrix->printToFile("inside");
+}
 
-        //computation of state in point of quadrature
-        for (CFuint iEq = 0; iEq < nbEqs; ++iEq) //loop over members of state - set to zero
-        {
-          (*m_state)[iEq] = 0.;
-        }
-        for (CFuint iState = 0; iState < nbStatesInCell; ++iState) //loop over states in cell
-        {
-          RealVector &states = *cellStates[iState]->getData();
-          for (CFuint iEq = 0; iEq < nbEqs; ++iEq) //loop over members of state
-          {
-            (*m_state)[iEq] += shapeFunctions[kvadrature_point][iState]*states[iEq];
-          }
-        }
+//////////////////////////////////////////////////////////////////////////////
 
-        //add local rhs to global rhs
-        for (CFuint iState = 0; iState < nbStatesInCell; ++iState)
-        {
-          const CFuint stateID = cellStates[iState]->getLocalID();
-          for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
-          {
-            rhs(stateID, iEq, nbEqs) += (*m_state)[iEq]*shapeFunctions[kvadrature_point][iState]*weight[kvadrature_point]/tau*detJacobi;
-          }
-        }
+void StdSolveCells::computeCellMatrix(DGCellData& data, ThreadData& thd,
+                                      const CFreal tau, DataHandle<CFreal>& rhs)
+{
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const CFuint nbDim = PhysicalModelStack::getActive()->getDim();
 
-        //computation of A_matrix of the cell in point of kvadrature
-        if (nbDim == 2)
-        {
-          compute_Amatrix2D((*m_state),&m_aMatrix);
-        }
-        else
-        {
-          compute_Amatrix3D((*m_state),&m_aMatrix);
-        }
+  const std::vector<State*>& cellStates = data.states;
+  const CFuint nbStatesInCell = cellStates.size();
+  const std::vector<RealVector>& shapeFunctions = *data.shapeFunctions;
+  const std::valarray<CFreal>& weight = *data.weights;
+  const std::vector<RealMatrix>& gradient = data.gradients;
+  const CFreal detJacobi = data.detJacobi;
+
+  State& state = *thd.state;
+  std::vector< RealMatrix >& aMatrix = thd.aMatrix;
+
+  BlockAccumulator& acc = *data.elemData.first;
+  RealMatrix& elemMat = *data.elemData.second;
+  RealVector& elemVec = *data.elemData.third;
+
+  elemVec = 0.0;
+  //set matrix in blockaccumulator to 0
+  elemMat=0.0;
+  acc.setValuesM(elemMat);
+
+  // set the IDs on the blockaccumulator (we use setRowColIndex() )
+  //connection between local and global state ID
+  for (CFuint iState = 0; iState < nbStatesInCell; ++iState) {
+    const CFuint stateID = cellStates[iState]->getLocalID();
+    acc.setRowColIndex(iState, stateID);
+  }
+
+  //loop over kvadrature point on the cell
+  for(CFuint kvadrature_point = 0; kvadrature_point < data.nbQuadPnts; kvadrature_point++ )
+  {
+    //set elemMat to 0 if isn't
+    if (kvadrature_point!=0) elemMat=0.0;
+
+    //computation of state in point of quadrature
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq) //loop over members of state - set to zero
+    {
+      state[iEq] = 0.;
+    }
+    for (CFuint iState = 0; iState < nbStatesInCell; ++iState) //loop over states in cell
+    {
+      RealVector &states = *cellStates[iState]->getData();
+      for (CFuint iEq = 0; iEq < nbEqs; ++iEq) //loop over members of state
+      {
+        state[iEq] += shapeFunctions[kvadrature_point][iState]*states[iEq];
+      }
+    }
 
+    //add local rhs to global rhs (the states of a cell belong to no other cell)
+    for (CFuint iState = 0; iState < nbStatesInCell; ++iState)
+    {
+      const CFuint stateID = cellStates[iState]->getLocalID();
+      for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
+      {
+        rhs(stateID, iEq, nbEqs) += state[iEq]*shapeFunctions[kvadrature_point][iState]*weight[kvadrature_point]/tau*detJacobi;
+      }
+    }
 
+    //computation of A_matrix of the cell in point of kvadrature
+    if (nbDim == 2)
+    {
+      compute_Amatrix2D(state,&aMatrix);
+    }
+    else
+    {
+      compute_Amatrix3D(state,&aMatrix);
+    }
 
-        for(CFuint s = 0; s < nbDim; s++ ) //loop over index 's' of a matrices
+    for(CFuint s = 0; s < nbDim; s++ ) //loop over index 's' of a matrices
+    {
+      //compute inner face term
+      //loop over test function
+      for(CFuint row = 0; row < nbStatesInCell; row++ )
+      {
+        //loop over base function of solution
+        for(CFuint col = 0; col < nbStatesInCell; col++ )
         {
-          //compute inner face term
-          //loop over test function
-          for(CFuint row = 0; row < nbStatesInCell; row++ )
-          {
-            //loop over base function of solution
-            for(CFuint col = 0; col < nbStatesInCell; col++ )
+          for(CFuint i = 0; i < nbEqs; i++ )
+            for(CFuint j = 0; j < nbEqs; j++ )
             {
-              for(CFuint i = 0; i < nbEqs; i++ )
-                for(CFuint j = 0; j < nbEqs; j++ )
-                {
-                  //inviscid part
-                  elemMat(row*nbEqs + i, col*nbEqs + j) -= (m_aMatrix[s](i,j))*gradient[kvadrature_point](row,s)*shapeFunctions[kvadrature_point][col];
-                }
+              //inviscid part
+              elemMat(row*nbEqs + i, col*nbEqs + j) -= (aMatrix[s](i,j))*gradient[kvadrature_point](row,s)*shapeFunctions[kvadrature_point][col];
             }
-          }
         }
-        //loop over test function
-        for(CFuint row = 0; row < nbStatesInCell; row++ )
+      }
+    }
+    //loop over test function
+    for(CFuint row = 0; row < nbStatesInCell; row++ )
+    {
+      //loop over base function of solution
+      for(CFuint col = 0; col < nbStatesInCell; col++ )
+      {
+        for(CFuint i = 0; i < nbEqs; i++ )
         {
-          //loop over base function of solution
-          for(CFuint col = 0; col < nbStatesInCell; col++ )
-          {
-            for(CFuint i = 0; i < nbEqs; i++ )
-            {
-              elemMat(row*nbEqs + i, col*nbEqs + i)+=shapeFunctions[kvadrature_point][row]*shapeFunctions[kvadrature_point][col]/tau;
-            }
-          }
+          elemMat(row*nbEqs + i, col*nbEqs + i)+=shapeFunctions[kvadrature_point][row]*shapeFunctions[kvadrature_point][col]/tau;
         }
-
-        //finaly multiply by quadrature weight
-        elemMat*=weight[kvadrature_point]*detJacobi;
-        // add local matrix to matrix of linear solver using block accumulator
-        acc.addValuesM(elemMat);
       }
-  //       acc.printToScreen();
-      // add the values in the jacobian matrix
-      jacobMatrix->addValues(acc);
     }
-    //release the GeometricEntity
-    geoBuilder->releaseGE();
-  }
-  CFout << " ... OK\n" << CFendl;
 
-//  jacobMatrix->finalAssembly();
-//  jacobMatrix->printToFile("inside");
+    //finaly multiply by quadrature weight
+    elemMat*=weight[kvadrature_point]*detJacobi;
+    // add local matrix to matrix of linear solver using block accumulator
+    acc.addValuesM(elemMat);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
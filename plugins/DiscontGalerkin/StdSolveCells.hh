@@ -64,8 +64,20 @@ public: // functions
    */
   CFreal setTimeStep(CFreal tau);
 
-  /// map of LSSMatrix accumulators, one for each cell type
-  Common::CFMap<CFuint,DGElemTypeData> m_mapElemData;
+  /**
+   * Compute the local matrix of a cell and add its contribution to the rhs
+   * @param data geometric data of the cell
+   * @param thd  scratch data of the calling thread
+   * @param tau  time step
+   * @param rhs  right hand side
+   */
+  void computeCellMatrix(DGCellData& data, ThreadData& thd,
+                         const CFreal tau, Framework::DataHandle<CFreal>& rhs);
+
+  /// maps of LSSMatrix accumulators, one for each cell type, for each slot of a block
+  std::vector< Common::CFMap<CFuint,DGElemTypeData> > m_mapElemData;
+  /// geometric data of the cells of a block
+  std::vector< DGCellData > m_cellData;
   /// socket for Rhs
   Framework::DataSocketSink<CFreal> socket_rhs;
   /// the socket to the data handle of the state's
@@ -89,9 +101,6 @@ private: // data
   CFreal detJacobi;
 
 
-  /// jacobi matrix of inviscid terms A[s](x,x)
-  std::vector < RealMatrix > m_aMatrix;
-
   ///temporary variable to store old state;
   Framework::State *m_oldState;
 
@@ -57,11 +57,21 @@ public: // functions
 
 private :
 
+  /**
+   * Compute the local matrix of an inner face
+   * @param data geometric data of the face
+   * @param thd  scratch data of the calling thread
+   */
+  void computeFaceMatrix(DGFaceData& data, ThreadData& thd);
+
   /// handle for the InnerCells trs
   Common::SafePtr<Framework::TopologicalRegionSet> m_cells;
 
-  /// map of LSSMatrix accumulators, one for each cell type
-  Common::CFMap<CFuint,DGElemTypeData> m_mapElemData;
+  /// maps of LSSMatrix accumulators, one for each pair of cell types, for each slot of a block
+  std::vector< Common::CFMap<CFuint,DGElemTypeData> > m_mapElemData;
+
+  /// geometric data of the faces of a block
+  std::vector< DGFaceData > m_faceData;
 
   /// socket for Rhs
   Framework::DataSocketSink<CFreal> socket_rhs;
@@ -49,6 +49,7 @@ void ViscousBaseSolve::setup()
 void ViscousBaseSolve::unsetup()
 {
   CFAUTOTRACE;
+  StdBaseSolve::unsetup();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -1,3 +1,5 @@
+#include "Common/OMPHelper.hh"
+
 #include "Framework/MethodCommandProvider.hh"
 #include "Framework/LSSMatrix.hh"
 #include "Framework/BlockAccumulator.hh"
@@ -26,6 +28,7 @@ MethodCommandProvider< ViscousSolveCells,DiscontGalerkinSolverData,DiscontGalerk
 ViscousSolveCells::ViscousSolveCells(const std::string& name)
   : ViscousBaseSolve(name),
     m_mapElemData(),
+    m_cellData(),
     socket_rhs("rhs"),
     socket_states("states"),
     socket_old_states("old_states"),
@@ -47,25 +50,9 @@ void ViscousSolveCells::setup()
   ViscousBaseSolve::setup();
   m_Alpha = getMethodData().getAlpha();
   m_MaxCFL = getMethodData().getMaxCFL();
-  const CFuint nbDim = PhysicalModelStack::getActive()->getDim();
   const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
 //   CFreal gamma = 1.4;
 
-  // set Amatix and Kmatrix to zero
-  m_aMatrix.resize(nbDim);
-  m_kMatrix.resize(nbDim);
-  for (CFuint i =0; i<nbDim; i++)
-  {
-    m_aMatrix[i].resize(nbEqs,nbEqs);
-    m_aMatrix[i] = 0.;
-    m_kMatrix[i].resize(nbDim);
-    for (CFuint j =0; j<nbDim; j++)
-    {
-      m_kMatrix[i][j].resize(nbEqs,nbEqs);
-      m_kMatrix[i][j]=0.;
-    }
-  }
-
   // set a pointer to the inner cells
   m_cells.reset(MeshDataStack::getActive()->getTrs("InnerCells"));
 
@@ -85,26 +72,15 @@ void ViscousSolveCells::setup()
   }
 
   const CFuint nbElemTypes = elementType->size();
+  vector<CFuint> nbStatesPerType(nbElemTypes);
 
   // loop over types since it can happen to deal with an hybrid mesh
   for (CFuint iType = 0; iType < nbElemTypes; ++iType) {
-
-     const CFuint nbStatesInType = (*elementType)[iType].getNbStates();
-
-     BlockAccumulator* ptr = getMethodData().getLinearSystemSolver()[0]->
-       createBlockAccumulator(nbStatesInType,nbStatesInType,nbEqs);
-     RealVector* vec = new RealVector(nbStatesInType*nbEqs);
-     RealVector* vec2 = new RealVector(nbEqs);
-     RealMatrix* mat = new RealMatrix(nbStatesInType*nbEqs,nbStatesInType*nbEqs);
-     vector<RealVector>* residual = new vector<RealVector>(nbStatesInType,*vec2);
-
-     DGElemTypeData elemTypeData(ptr,mat,vec,residual);
-
-     m_mapElemData.insert(nbStatesInType, elemTypeData);
+     nbStatesPerType[iType] = (*elementType)[iType].getNbStates();
   }
 
-  m_mapElemData.sortKeys();
-
+  createElemData(nbStatesPerType, m_mapElemData);
+  m_cellData.resize(getNbSlots());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -112,6 +88,7 @@ void ViscousSolveCells::setup()
 void ViscousSolveCells::unsetup()
 {
   CFAUTOTRACE;
+  deleteElemData(m_mapElemData);
   ViscousBaseSolve::unsetup();
 
   // deallocate our memory
@@ -127,11 +104,9 @@ void ViscousSolveCells::unsetup()
 void ViscousSolveCells::execute()
 {
   CFAUTOTRACE;
-  CFuint m_nbKvadrPoint;
   CFout << "ViscousSolveCells applied to " << m_cells->getName() << CFendl;
   static CFreal tau = 0.0;
   const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
-  const CFuint nbDim = PhysicalModelStack::getActive()->getDim();
 
   // get rhs
   DataHandle<CFreal> rhs = socket_rhs.getDataHandle();
@@ -174,195 +149,174 @@ void ViscousSolveCells::execute()
   //set that we use only data of inner cells trs
   geoData.trs = trs;
 
-  //loop over all inner cells
-  for(CFuint iGeoEnt = 0; iGeoEnt < nbGeos; ++iGeoEnt) {
-    CFLogDebugMax("Cell " << iGeoEnt << "\n");
-
-    // build the GeometricEntity (cell)
-    //set index of cell
-    geoData.idx = iGeoEnt;
-    //geo builder make cell
-    GeometricEntity& cell = *geoBuilder->buildGE();
-    //read vector of states on element (cell)
-    std::vector<State*>& cellStates = *(cell.getStates());
-//     std::vector<Node*>& cellNodes = *(cell.getNodes());
-// CFout << iGeoEnt << " " << cellNodes[0]->getLocalID() << " / " << cellNodes[1]->getLocalID() << " / " << cellNodes[2]->getLocalID() << "\n";
-    //read number of states on element (cell)
-    const CFuint nbStatesInCell = cellStates.size();
-    //read vector of nodes on element (cell)
-
-    if (cellStates[0]->isParUpdatable())
-    {
-      //*****************************************************************
-      //*****************************************************************
-      //SET Integrator
-      //compute shape function in quadrature points
-      const std::vector<RealVector>& shapeFunctions =  getMethodData().getVolumeIntegrator()->getSolutionIntegrator(&cell)->computeShapeFunctionsAtQuadraturePoints();
-
-      //numbers of quadrature points
-      m_nbKvadrPoint = getMethodData().getVolumeIntegrator()->getSolutionIntegrator(&cell)->getIntegratorPattern()[0];
+  const CFuint nbThreads = getNbThreads();
+  const CFuint nbSlots = getNbSlots();
+
+  //loop over blocks of inner cells
+  for(CFuint blockStart = 0; blockStart < nbGeos; blockStart += nbSlots) {
+    const CFuint nbCellsInBlock = std::min(nbSlots, nbGeos - blockStart);
+
+    //gather the geometric data of the block (the shape functions are not thread-safe)
+    for(CFuint iSlot = 0; iSlot < nbCellsInBlock; ++iSlot) {
+      CFLogDebugMax("Cell " << blockStart + iSlot << "\n");
+
+      // build the GeometricEntity (cell)
+      //set index of cell
+      geoData.idx = blockStart + iSlot;
+      //geo builder make cell
+      GeometricEntity& cell = *geoBuilder->buildGE();
+      DGCellData& data = m_cellData[iSlot];
+      setCellData(cell, data);
+      if (data.isUpdatable)
+      {
+        data.elemData = m_mapElemData[iSlot].find(data.states.size());
+      }
+      //release the GeometricEntity
+      geoBuilder->releaseGE();
+    }
 
-      //set weights for element quadrature
-      const std::valarray<CFreal>& weight = getMethodData().getVolumeIntegrator()->getSolutionIntegrator(&cell)->getCoeff();
+    //compute the local matrices of the block concurrently
+    const CFint nbSlotsInBlock = static_cast<CFint>(nbCellsInBlock);
+#pragma omp parallel for schedule(dynamic) num_threads(nbThreads) if(nbThreads > 1)
+    for(CFint iSlot = 0; iSlot < nbSlotsInBlock; ++iSlot) {
+      if (m_cellData[iSlot].isUpdatable)
+      {
+        computeCellMatrix(m_cellData[iSlot], m_threadData[getThreadIDOMP()], tau, rhs);
+      }
+    }
 
-      //get coordinates of quadrature points
-      const std::vector<RealVector>& coord = getMethodData().getVolumeIntegrator()->getSolutionIntegrator(&cell)->getQuadraturePointsCoordinates();
+    // add the values in the jacobian matrix, in the order of the cells
+    for(CFuint iSlot = 0; iSlot < nbCellsInBlock; ++iSlot) {
+      if (m_cellData[iSlot].isUpdatable)
+      {
+        jacobMatrix->addValues(*m_cellData[iSlot].elemData.first);
+      }
+    }
+  }
+  CFout << " ... OK\n" << CFendl;
 
-      //compute gradient of shape functions in quadrature points
-      std::vector<RealMatrix> gradient = cell.computeSolutionShapeFunctionGradientsInMappedCoordinates(coord);
+//  jacobMatrix->finalAssembly();
+//  jacobMatrix->printToFile("inside");
+}
 
-      //*****************************************************************
-      //*****************************************************************
+//////////////////////////////////////////////////////////////////////////////
 
+void ViscousSolveCells::computeCellMatrix(DGCellData& data, ThreadData& thd,
+                                          const CFreal tau, DataHandle<CFreal>& rhs)
+{
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const CFuint nbDim = PhysicalModelStack::getActive()->getDim();
 
-      /// @todo this must be improved. Finding in a map
-      /// for every cell is efficiently speaking not acceptable.
-      //make block acumulator with size of sum of states in cell
-      DGElemTypeData elemData = m_mapElemData.find(nbStatesInCell);
-      BlockAccumulator& acc = *elemData.first;
-      RealMatrix& elemMat = *elemData.second;
-      RealVector& elemVec = *elemData.third;
+  const std::vector<State*>& cellStates = data.states;
+  const CFuint nbStatesInCell = cellStates.size();
+  const std::vector<RealVector>& shapeFunctions = *data.shapeFunctions;
+  const std::valarray<CFreal>& weight = *data.weights;
+  const std::vector<RealMatrix>& gradient = data.gradients;
+  const CFreal detJacobi = data.detJacobi;
+
+  State& state = *thd.state;
+  std::vector< RealMatrix >& aMatrix = thd.aMatrix;
+  std::vector< std::vector< RealMatrix > >& kMatrix = thd.kMatrix[0];
+
+  BlockAccumulator& acc = *data.elemData.first;
+  RealMatrix& elemMat = *data.elemData.second;
+  RealVector& elemVec = *data.elemData.third;
+
+  elemVec = 0.0;
+  //set matrix in blockaccumulator to 0
+  elemMat=0.0;
+  acc.setValuesM(elemMat);
+
+  // set the IDs on the blockaccumulator (we use setRowColIndex() )
+  //connection between local and global state ID
+  for (CFuint iState = 0; iState < nbStatesInCell; ++iState) {
+    const CFuint stateID = cellStates[iState]->getLocalID();
+    acc.setRowColIndex(iState, stateID);
+  }
 
-      elemVec = 0.0;
-      //set matrix in blockaccumulator to 0
-      elemMat=0.0;
-      acc.setValuesM(elemMat);
+  //loop over kvadrature point on the cell
+  for(CFuint kvadrature_point = 0; kvadrature_point < data.nbQuadPnts; kvadrature_point++ )
+  {
+    //set elemMat to 0 if isn't
+    if (kvadrature_point!=0) elemMat=0.0;
 
-      //computation of the Jacobi determinant of mapping from refference element to cell
-      /// @todo this must be generalized
-      if (nbDim == 2)
-      {
-        detJacobi = abs(cell.computeVolume())*2.0;
-      }
-      else
+    //computation of state in point of quadrature
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq) //loop over members of state - set to zero
+    {
+      state[iEq] = 0.;
+    }
+    for (CFuint iState = 0; iState < nbStatesInCell; ++iState) //loop over states in cell
+    {
+      RealVector &states = *cellStates[iState]->getData();
+      for (CFuint iEq = 0; iEq < nbEqs; ++iEq) //loop over members of state
       {
-        detJacobi = abs(cell.computeVolume())*6.0;
-      }
-//    //computation of the inverse Jacobi matrix of mapping from refference element to cell
-//    invJacobi[0] = (*nodes[2])[YY] - (*nodes[0])[YY];
-//    invJacobi[1] = - (*nodes[2])[XX] + (*nodes[0])[XX];
-//    invJacobi[2] = - (*nodes[1])[YY] + (*nodes[0])[YY];
-//    invJacobi[3] = (*nodes[1])[XX] - (*nodes[0])[XX];
-//    //computation of the Jacobi determinant of mapping from refference element to cell
-//    detJacobi = abs(cell.computeVolume())*2.0;
-//    //detJacobi = invJacobi[0]*invJacobi[3] - invJacobi[1]*invJacobi[2];
-
-      // set the IDs on the blockaccumulator (we use setRowColIndex() )
-      //connection between local and global state ID
-      for (CFuint iState = 0; iState < nbStatesInCell; ++iState) {
-        const CFuint stateID = cellStates[iState]->getLocalID();
-        acc.setRowColIndex(iState, stateID);
+        state[iEq] += shapeFunctions[kvadrature_point][iState]*states[iEq];
       }
+    }
 
-      //loop over kvadrature point on the cell
-      for(CFuint kvadrature_point = 0; kvadrature_point < m_nbKvadrPoint; kvadrature_point++ )
+    //add local rhs to global rhs (the states of a cell belong to no other cell)
+    for (CFuint iState = 0; iState < nbStatesInCell; ++iState)
+    {
+      const CFuint stateID = cellStates[iState]->getLocalID();
+      for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
       {
+        rhs(stateID, iEq, nbEqs) += state[iEq]*shapeFunctions[kvadrature_point][iState]*weight[kvadrature_point]/tau*detJacobi;
+      }
+    }
 
+    //computation of K_matrix and A_matrix of the cell in point of kvadrature
+    if (nbDim == 2)
+    {
+      compute_Amatrix2D(state,&aMatrix);
+      compute_Kmatrix2D(state,&kMatrix);
+    }
+    else
+    {
+      compute_Amatrix3D(state,&aMatrix);
+      compute_Kmatrix3D(state,&kMatrix);
+    }
 
-//         if (iGeoEnt == 271)
-// {
-//           CFout << "\n";
-// 
-//         for(CFuint i=0;i<nbStatesInCell;++i)
-//         {
-//           CFout << "\n";
-//           for(CFuint j=0;j<nbDim;++j)
-//             CFout << gradient[kvadrature_point](i,j) << " ";
-//         }
-// }
-
-        //set elemMat to 0 if isn't
-        if (kvadrature_point!=0) elemMat=0.0;
-
-        //computation of state in point of quadrature
-        for (CFuint iEq = 0; iEq < nbEqs; ++iEq) //loop over members of state - set to zero
-        {
-          (*m_state)[iEq] = 0.;
-        }
-        for (CFuint iState = 0; iState < nbStatesInCell; ++iState) //loop over states in cell
-        {
-          RealVector &states = *cellStates[iState]->getData();
-          for (CFuint iEq = 0; iEq < nbEqs; ++iEq) //loop over members of state
-          {
-            (*m_state)[iEq] += shapeFunctions[kvadrature_point][iState]*states[iEq];
-          }
-        }
-
-        //add local rhs to global rhs
-        for (CFuint iState = 0; iState < nbStatesInCell; ++iState)
-        {
-          const CFuint stateID = cellStates[iState]->getLocalID();
-          for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
-          {
-            rhs(stateID, iEq, nbEqs) += (*m_state)[iEq]*shapeFunctions[kvadrature_point][iState]*weight[kvadrature_point]/tau*detJacobi;
-          }
-        }
-
-        //computation of K_matrix and A_matrix of the left cell in point of kvadrature
-        if (nbDim == 2)
-        {
-          compute_Amatrix2D((*m_state),&m_aMatrix);
-          compute_Kmatrix2D((*m_state),&m_kMatrix);
-        }
-        else
-        {
-          compute_Amatrix3D((*m_state),&m_aMatrix);
-          compute_Kmatrix3D((*m_state),&m_kMatrix);
-        }
-
-        for(CFuint s = 0; s < nbDim; s++ ) //loop over index 's' of a matrices
+    for(CFuint s = 0; s < nbDim; s++ ) //loop over index 's' of a matrices
+    {
+      //compute inner face term
+      //loop over test function
+      for(CFuint row = 0; row < nbStatesInCell; row++ )
+      {
+        //loop over base function of solution
+        for(CFuint col = 0; col < nbStatesInCell; col++ )
         {
-          //compute inner face term
-          //loop over test function
-          for(CFuint row = 0; row < nbStatesInCell; row++ )
-          {
-            //loop over base function of solution
-            for(CFuint col = 0; col < nbStatesInCell; col++ )
+          for(CFuint i = 0; i < nbEqs; i++ )
+            for(CFuint j = 0; j < nbEqs; j++ )
             {
-              for(CFuint i = 0; i < nbEqs; i++ )
-                for(CFuint j = 0; j < nbEqs; j++ )
-                {
-                  //inviscid part
-                  elemMat(row*nbEqs + i, col*nbEqs + j) -= (m_aMatrix[s](i,j))*gradient[kvadrature_point](row,s)*shapeFunctions[kvadrature_point][col];
-                  //viscous part
-                  for(CFuint k=0;k<nbDim;k++)
-                  {
-                    elemMat(row*nbEqs + i, col*nbEqs + j) += (m_kMatrix[s][k](i,j))*gradient[kvadrature_point](row,s)*gradient[kvadrature_point](col,k);
-                  }
-                }
+              //inviscid part
+              elemMat(row*nbEqs + i, col*nbEqs + j) -= (aMatrix[s](i,j))*gradient[kvadrature_point](row,s)*shapeFunctions[kvadrature_point][col];
+              //viscous part
+              for(CFuint k=0;k<nbDim;k++)
+              {
+                elemMat(row*nbEqs + i, col*nbEqs + j) += (kMatrix[s][k](i,j))*gradient[kvadrature_point](row,s)*gradient[kvadrature_point](col,k);
+              }
             }
-          }
         }
-        //loop over test function
-        for(CFuint row = 0; row < nbStatesInCell; row++ )
+      }
+    }
+    //loop over test function
+    for(CFuint row = 0; row < nbStatesInCell; row++ )
+    {
+      //loop over base function of solution
+      for(CFuint col = 0; col < nbStatesInCell; col++ )
+      {
+        for(CFuint i = 0; i < nbEqs; i++ )
         {
-          //loop over base function of solution
-          for(CFuint col = 0; col < nbStatesInCell; col++ )
-          {
-            for(CFuint i = 0; i < nbEqs; i++ )
-            {
-              elemMat(row*nbEqs + i, col*nbEqs + i)+=shapeFunctions[kvadrature_point][row]*shapeFunctions[kvadrature_point][col]/tau;
-            }
-          }
+          elemMat(row*nbEqs + i, col*nbEqs + i)+=shapeFunctions[kvadrature_point][row]*shapeFunctions[kvadrature_point][col]/tau;
         }
-
-        //finaly multiply by quadrature weight
-        elemMat*=weight[kvadrature_point]*detJacobi;
-        // add local matrix to matrix of linear solver using block accumulator
-        acc.addValuesM(elemMat);
       }
-//         if (iGeoEnt == 271)
-//         acc.printToScreen();
-      // add the values in the jacobian matrix
-      jacobMatrix->addValues(acc);
     }
-    //release the GeometricEntity
-    geoBuilder->releaseGE();
-  }
-  CFout << " ... OK\n" << CFendl;
 
-//  jacobMatrix->finalAssembly();
-//  jacobMatrix->printToFile("inside");
+    //finaly multiply by quadrature weight
+    elemMat*=weight[kvadrature_point]*detJacobi;
+    // add local matrix to matrix of linear solver using block accumulator
+    acc.addValuesM(elemMat);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
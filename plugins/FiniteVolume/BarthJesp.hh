@@ -9,10 +9,12 @@
 #include "FiniteVolume/CellCenterFVMData.hh"
 
 #ifdef CF_HAVE_CUDA
+#include "Common/CUDA/CudaEnv.hh"
+#endif
+#ifdef CF_HAVE_DEVICE_KERNELS
 #include "FiniteVolume/CellData.hh"
 #include "FiniteVolume/FluxData.hh"
 #include "FiniteVolume/KernelData.hh"
-#include "Common/CUDA/CudaEnv.hh"
 #include "Common/CUDA/CFVec.hh"
 #endif
 
@@ -40,7 +42,7 @@ namespace COOLFluiD {
 class BarthJesp : public Framework::Limiter<CellCenterFVMData> {
 public:
   
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
   /**
    * This nested class holds configurable options for this object
    *
@@ -93,12 +95,14 @@ public:
     DeviceConfigOptions<NOTYPE>* m_dco;
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the Framework::DEVICE
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
     CudaEnv::copyHost2Dev(&dco->alpha, &m_alpha, 1);
     CudaEnv::copyHost2Dev(&dco->useFullStencil, &m_useFullStencil, 1);
   } 
+#endif
   
   /// copy the local configuration options to the Framework::DEVICE
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -158,7 +162,7 @@ private:
 
 //////////////////////////////////////////////////////////////////////////////
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
 
 template <typename PHYS>
 void BarthJesp::DeviceFunc<PHYS>::limit(const KernelData<CFreal>* kd, 
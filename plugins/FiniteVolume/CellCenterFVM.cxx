@@ -1,6 +1,7 @@
 #include "Environment/ObjectProvider.hh"
 
 #include "FiniteVolume/CellCenterFVM.hh"
+#include "FiniteVolume/FVMCC_ComputeRHS.hh"
 #include "FiniteVolume/FiniteVolume.hh"
 #include "FiniteVolume/DerivativeComputer.hh"
 #include "FiniteVolume/ComputeDiffusiveFlux.hh"
@@ -464,6 +465,17 @@ void CellCenterFVM::postProcessSolutionImpl()
 
 //////////////////////////////////////////////////////////////////////////////
 
+bool CellCenterFVM::canOverlapSync() const
+{
+  // only the standard residual computation can process the inner faces
+  // of the partition before the ghost states are received
+  if (_computeSpaceRHS.isNull()) return false;
+  FVMCC_ComputeRHS *const rhs = dynamic_cast<FVMCC_ComputeRHS*>(_computeSpaceRHS.getPtr());
+  return (rhs != CFNULL) && rhs->canOverlapSync();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void CellCenterFVM::setMethodImpl()
 {
   CFAUTOTRACE;
@@ -118,6 +118,9 @@ protected: // interface implementation functions
   /// Postprocess the solution.
   void postProcessSolutionImpl();
 
+  /// Tells if the space residual can be computed while the states are being synchronized
+  bool canOverlapSync() const;
+
   /// Action which is executed by the ActionLinstener for the "CF_ON_MESHADAPTER_BEFOREMESHUPDATE" Event
   /// @param eBefore the event which provoked this action
   /// @return an Event with a message in its body
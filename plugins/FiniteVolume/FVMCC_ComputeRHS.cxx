@@ -1,10 +1,15 @@
+#include "Common/BadValueException.hh"
+#include "Common/OMPHelper.hh"
+#include "Environment/Factory.hh"
 #include "FiniteVolume/FiniteVolume.hh"
 #include "FVMCC_ComputeRHS.hh"
 #include "Framework/MethodCommandProvider.hh"
 #include "Framework/MeshData.hh"
+#include "Framework/BaseTerm.hh"
 #include "MathTools/MatrixInverter.hh"
 #include "FiniteVolume/FVMCC_BC.hh"
 #include "FiniteVolume/DerivativeComputer.hh"
+#include "FiniteVolume/ConstantPolyRec.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -12,6 +17,7 @@ using namespace std;
 using namespace COOLFluiD::Framework;
 using namespace COOLFluiD::Common;
 using namespace COOLFluiD::MathTools;
+using namespace COOLFluiD::Environment;
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -42,6 +48,7 @@ FVMCC_ComputeRHS::FVMCC_ComputeRHS(const std::string& name) :
   socket_limiter("limiter"),
   socket_gstates("gstates"),
   socket_nodes("nodes"),
+  socket_stencil("stencil", false),
   _fluxSplitter(CFNULL),
   _diffusiveFlux(CFNULL),
   _reconstrVar(CFNULL),
@@ -74,7 +81,20 @@ FVMCC_ComputeRHS::FVMCC_ComputeRHS(const std::string& name) :
   _fluxData(CFNULL),
   _tempUnitNormal(),
   _rExtraVars(),
-  _inverter(CFNULL)  
+  _inverter(CFNULL),
+  _faceTable(),
+  _isInnerFace(),
+  _syncBFaces(),
+  _useTableFaces(false),
+  _nbThreads(1),
+  _threadedFluxSplitter(CFNULL),
+  _threadData(),
+  _threadFlux(),
+  _faceFlux(),
+  _faceUpdateCoeff(),
+  _isFaceComputed(),
+  _stateFacePtr(),
+  _stateFaces()
 {
   addConfigOptionsTo(this);
 
@@ -89,6 +109,15 @@ FVMCC_ComputeRHS::FVMCC_ComputeRHS(const std::string& name) :
   
   _useAnalyticalMatrix = true;
   setParameter("useAnalyticalMatrix",&_useAnalyticalMatrix);
+  
+  _useFaceTable = false;
+  setParameter("UseFaceTable",&_useFaceTable);
+  
+  _nbThreadsOMP = 1;
+  setParameter("NbThreadsOMP",&_nbThreadsOMP);
+  
+  _checkThreadsOMP = false;
+  setParameter("CheckThreadsOMP",&_checkThreadsOMP);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -107,6 +136,11 @@ void FVMCC_ComputeRHS::unsetup()
     deletePtr(_rExtraVars[i]);
   }
   
+  for (CFuint i = 0; i < _threadData.size(); ++i) {
+    deletePtr(_threadData[i]);
+  }
+  _threadData.clear();
+  
   CellCenterFVMCom::unsetup();
 }
 
@@ -125,6 +159,15 @@ void FVMCC_ComputeRHS::defineConfigOptions(Config::OptionList& options)
 
   options.addConfigOption< bool >
     ("useAnalyticalMatrix", "Flag telling if to use analytical matrix."); 
+  
+  options.addConfigOption< bool >
+    ("UseFaceTable", "Process the faces from a precomputed table of the face connectivity: the first order fluxes are computed without building the faces when possible.");
+  
+  options.addConfigOption< CFuint >
+    ("NbThreadsOMP", "Number of OMP threads computing the first order fluxes on the faces without BC (1 = serial loop, 0 = all available).");
+  
+  options.addConfigOption< bool >
+    ("CheckThreadsOMP", "Check at each iteration that the face loop over the face table (threaded or not) gives the same RHS as the standard one (for testing).");
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -142,17 +185,78 @@ void FVMCC_ComputeRHS::execute()
  
   CFLog(VERBOSE, "FVMCC_ComputeRHS::execute() START\n");
   
-  initializeComputationRHS();
+  // no variable perturbation is needed in explicit residual computation
+  getMethodData().setIsPerturb(false);
+  
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  // the exchange is left pending only with ConvergenceMethod::OverlapSync
+  if (states.isSyncPending() && canOverlapSync() && canOverlapInnerFaces() && 
+      !(_useTableFaces && _checkThreadsOMP)) {
+    // only the fluxes in the interior of the partition are computed while
+    // the ghost states are still being exchanged
+    if (_isInnerFace.size() == 0) {
+      flagInnerFaces();
+    }
+    
+    // the gradients and the nodal states computed here from the outdated 
+    // ghost states are not used by the inner faces and are updated after the sync
+    initializeComputationRHS();
+    processFaces(INNER_FACES);
+    states.endSync();
+    updateAfterSync();
+    processFaces(OUTER_FACES);
+  }
+  else {
+    // gradients and nodal states need the ghost states of the partition
+    states.endSync();
+    initializeComputationRHS();
+    
+    if (_useTableFaces && _checkThreadsOMP) {
+      checkTableFaces();
+    }
+    else {
+      processFaces(ALL_FACES);
+    }
+  }
+  
+  finalizeComputationRHS();
+  
+  CFLog(VERBOSE, "FVMCC_ComputeRHS::execute() END\n");
   
+  CFTRACEEND;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool FVMCC_ComputeRHS::canOverlapInnerFaces()
+{
+  // the gradients, the nodal states and the source terms are only available 
+  // once the ghost states have been received
+  return (dynamic_cast<ConstantPolyRec*>(&(*_polyRec)) != CFNULL) && !_hasDiffusiveTerm &&
+    !getMethodData().hasSourceTerm() && !getMethodData().isAxisymmetric();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool FVMCC_ComputeRHS::hasFluxesOnTrs(SafePtr<TopologicalRegionSet> trs)
+{
+  // the faces on the boundary of the partition don't have to
+  // be processed (their fluxes could give NaN)
+  const vector<string>& noBCTRS = getMethodData().getTRSsWithNoBC();
+  return (trs->getName() != "PartitionFaces" && trs->getName() != "InnerCells" && 
+	  !binary_search(noBCTRS.begin(), noBCTRS.end(), trs->getName()));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::processFaces(const FaceSubset subset)
+{
   // set the list of faces
   vector<SafePtr<TopologicalRegionSet> > trs = MeshDataStack::getActive()->getTrsList();
   const CFuint nbTRSs = trs.size();
 
   _faceIdx = 0;
   
-  // no variable perturbation is needed in explicit residual computation
-  getMethodData().setIsPerturb(false);
-  
   // prepare the building of the faces
   Common::SafePtr<GeometricEntityPool<FaceCellTrsGeoBuilder> > geoBuilder = getMethodData().getFaceCellTrsGeoBuilder();
   geoBuilder->getGeoBuilder()->setDataSockets(socket_states, socket_gstates, socket_nodes);
@@ -164,17 +268,21 @@ void FVMCC_ComputeRHS::execute()
   // a MethodStrategy could set it to a different value afterwards, before entering here
   geoData.allCells = getMethodData().getBuildAllCells();
   
-  const vector<string>& noBCTRS = getMethodData().getTRSsWithNoBC();
   SafePtr<CFMap<CFuint, FVMCC_BC*> > bcMap = getMethodData().getMapBC();
   
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  if (_useFaceTable || _useTableFaces) {
+    if (_faceTable.getNbFaces() == 0) {
+      _faceTable.build();
+    }
+    geoBuilder->getGeoBuilder()->setFaceTable(&_faceTable);
+  }
+  
   for (CFuint iTRS = 0; iTRS < nbTRSs; ++iTRS) {
     SafePtr<TopologicalRegionSet> currTrs = trs[iTRS];
     
     CFLog(VERBOSE, "TRS name = " << currTrs->getName() << "\n");
-    // the faces on the boundary of the partition don't have to
-    // be processed (their fluxes could give NaN)
-    if (currTrs->getName() != "PartitionFaces" && currTrs->getName() != "InnerCells" && 
-	!binary_search(noBCTRS.begin(), noBCTRS.end(), currTrs->getName())) {
+    if (hasFluxesOnTrs(currTrs)) {
       
       if (currTrs->hasTag("writable")) {
 	_currBC = bcMap->find(iTRS);
@@ -195,6 +303,12 @@ void FVMCC_ComputeRHS::execute()
 	_polyRec->setZeroGradient(&zeroGrad);
       }
       
+      // the GeometricEntity is only built for the faces with BC
+      if (_useTableFaces && !geoData.isBFace) {
+	processFacesFromTable(currTrs, iTRS, subset);
+	continue;
+      }
+      
       // set the current TRS in the geoData
       geoData.faces = currTrs;
       
@@ -202,6 +316,15 @@ void FVMCC_ComputeRHS::execute()
       for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace, ++_faceIdx) {
         CFLogDebugMed( "iFace = " << iFace << "\n");
 	
+	if (subset != ALL_FACES && _isInnerFace[_faceIdx] != (subset == INNER_FACES)) continue;
+	
+	// faces with no updatable state are skipped without being built
+	if (_useFaceTable || _useTableFaces) {
+	  const CFuint faceID = currTrs->getLocalGeoID(iFace);
+	  if (!states[_faceTable.getStateID(faceID, 0)]->isParUpdatable() &&
+	      (_faceTable.isBFace(faceID) || !states[_faceTable.getStateID(faceID, 1)]->isParUpdatable())) continue;
+	}
+	
     	// reset the equation subsystem descriptor
 	PhysicalModelStack::getActive()->resetEquationSubSysDescriptor();
 	
@@ -297,23 +420,442 @@ void FVMCC_ComputeRHS::execute()
       }
     }
   }
+  
+  // the builder is shared with other commands
+  geoBuilder->getGeoBuilder()->setFaceTable(CFNULL);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::processFacesFromTable(SafePtr<TopologicalRegionSet> trs,
+					     const CFuint iTRS, const FaceSubset subset)
+{
+  const CFuint nbTrsFaces = trs->getLocalNbGeoEnts();
+  const CFuint firstFaceIdx = _faceIdx;
+  _faceIdx += nbTrsFaces;
+  
+  _threadedFluxSplitter->prepareThreadedFlux();
+  PhysicalModelStack::getActive()->resetEquationSubSysDescriptor();
+  
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  if (_nbThreads == 1) {
+    CFreal faceUpdateCoeff[2];
+    CFreal *const flux = &_faceFlux[0];
+    for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+      if (subset != ALL_FACES && _isInnerFace[firstFaceIdx + iFace] != (subset == INNER_FACES)) continue;
+      const CFuint faceID = trs->getLocalGeoID(iFace);
+      if (computeFaceFromTable(faceID, 0, flux, faceUpdateCoeff)) {
+	addFaceFromTable(_faceTable.getStateID(faceID, 0), 0, flux, faceUpdateCoeff[0]);
+	addFaceFromTable(_faceTable.getStateID(faceID, 1), 1, flux, faceUpdateCoeff[1]);
+      }
+    }
+    return;
+  }
+  
+  // faces around each state, sorted like in the serial loop
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  const CFuint nbStates = states.size();
+  if (_stateFacePtr[iTRS].size() == 0) {
+    vector<CFuint>& ptr = _stateFacePtr[iTRS];
+    ptr.assign(nbStates+1, 0);
+    for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+      const CFuint faceID = trs->getLocalGeoID(iFace);
+      ptr[_faceTable.getStateID(faceID, 0)+1]++;
+      ptr[_faceTable.getStateID(faceID, 1)+1]++;
+    }
+    for (CFuint iState = 0; iState < nbStates; ++iState) {
+      ptr[iState+1] += ptr[iState];
+    }
     
-  finalizeComputationRHS();
+    // each entry is 2*iFace + side of the state in the face
+    _stateFaces[iTRS].resize(ptr[nbStates]);
+    vector<CFuint> fill(ptr.begin(), ptr.end()-1);
+    for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+      const CFuint faceID = trs->getLocalGeoID(iFace);
+      _stateFaces[iTRS][fill[_faceTable.getStateID(faceID, 0)]++] = 2*iFace;
+      _stateFaces[iTRS][fill[_faceTable.getStateID(faceID, 1)]++] = 2*iFace+1;
+    }
+  }
   
+  if (_faceFlux.size() < nbTrsFaces*nbEqs) {
+    _faceFlux.resize(nbTrsFaces*nbEqs);
+    _faceUpdateCoeff.resize(2*nbTrsFaces);
+    _isFaceComputed.resize(nbTrsFaces);
+  }
   
-  //   const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
-  //   DataHandle<CFreal> rhs = socket_rhs.getDataHandle();
-  //   DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
-//   for (CFuint iState = 0; iState < states.size(); ++iState) {
-//     for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
-//       cout.precision(14); cout.setf(ios::scientific,ios::floatfield); cout << rhs(iState, iEq, nbEqs) << " ";
-//     }
-//     cout << endl;
-//   }
- 
-  CFLog(VERBOSE, "FVMCC_ComputeRHS::execute() END\n");
+  // the fluxes of all the faces are computed concurrently and stored
+  const CFint nbFaces = static_cast<CFint>(nbTrsFaces);
+#pragma omp parallel for schedule(static) num_threads(_nbThreads)
+  for (CFint k = 0; k < nbFaces; ++k) {
+    const CFuint iFace = k;
+    _isFaceComputed[iFace] = 
+      (subset == ALL_FACES || _isInnerFace[firstFaceIdx + iFace] == (subset == INNER_FACES)) &&
+      computeFaceFromTable(trs->getLocalGeoID(iFace), getThreadIDOMP(),
+			   &_faceFlux[iFace*nbEqs], &_faceUpdateCoeff[2*iFace]);
+  }
   
-  CFTRACEEND;
+  // each thread then sums the fluxes of the states it owns, in the same
+  // order as the serial loop: the RHS and the update coefficients are the same
+  const vector<CFuint>& ptr = _stateFacePtr[iTRS];
+  const vector<CFuint>& stateFaces = _stateFaces[iTRS];
+  const CFint nbStatesInt = static_cast<CFint>(nbStates);
+#pragma omp parallel for schedule(static) num_threads(_nbThreads)
+  for (CFint k = 0; k < nbStatesInt; ++k) {
+    const CFuint iState = k;
+    for (CFuint i = ptr[iState]; i < ptr[iState+1]; ++i) {
+      const CFuint iFace = stateFaces[i]/2;
+      if (_isFaceComputed[iFace]) {
+	const CFuint side = stateFaces[i]%2;
+	addFaceFromTable(iState, side, &_faceFlux[iFace*nbEqs], _faceUpdateCoeff[2*iFace+side]);
+      }
+    }
+  }
+  
+  // the cell flags can be packed bits
+  DataHandle<bool> cellFlag = socket_cellFlag.getDataHandle();
+  for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+    if (_isFaceComputed[iFace]) {
+      const CFuint faceID = trs->getLocalGeoID(iFace);
+      cellFlag[_faceTable.getStateID(faceID, 0)] = true;
+      cellFlag[_faceTable.getStateID(faceID, 1)] = true;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool FVMCC_ComputeRHS::computeFaceFromTable(const CFuint faceID, const CFuint iThread,
+					    CFreal *const flux, CFreal *const faceUpdateCoeff)
+{
+  cf_assert(!_faceTable.isBFace(faceID));
+  
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  State *const state0 = states[_faceTable.getStateID(faceID, 0)];
+  State *const state1 = states[_faceTable.getStateID(faceID, 1)];
+  if (!state0->isParUpdatable() && !state1->isParUpdatable()) return false;
+  
+  FVMCC_FluxSplitter::ThreadData& td = *_threadData[iThread];
+  td.faceID = faceID;
+  td.leftState = state0;
+  td.rightState = state1;
+  
+  DataHandle<CFreal> normals = socket_normals.getDataHandle();
+  const CFuint nbDim = td.unitNormal.size();
+  const CFuint startID = faceID*nbDim;
+  const CFreal invArea = 1./socket_faceAreas.getDataHandle()[faceID];
+  for (CFuint i = 0; i < nbDim; ++i) {
+    td.unitNormal[i] = normals[startID + i]*invArea;
+  }
+  
+  // first order: the reconstructed states are the cell states
+  td.updateVar->computePhysicalData(*state0, td.pdata[0]);
+  td.updateVar->computePhysicalData(*state1, td.pdata[1]);
+  
+  RealVector& threadFlux = _threadFlux[iThread];
+  threadFlux = 0.;
+  _threadedFluxSplitter->computeThreadedFlux(td, threadFlux);
+  
+  const CFuint nbEqs = threadFlux.size();
+  for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+    flux[iEq] = threadFlux[iEq];
+  }
+  faceUpdateCoeff[0] = td.leftUpdateCoeff;
+  faceUpdateCoeff[1] = td.rightUpdateCoeff;
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::addFaceFromTable(const CFuint stateID, const CFuint side,
+					const CFreal *const flux, const CFreal faceUpdateCoeff)
+{
+  // same contributions as in updateRHS() without axisymmetry
+  const CFreal coeff = getResFactor()*_rMid;
+  const CFuint nbEqs = _threadFlux[0].size();
+  DataHandle<CFreal> rhs = socket_rhs.getDataHandle();
+  if (side == 0) {
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+      rhs(stateID, iEq, nbEqs) -= (coeff*flux[iEq])*_invr[0];
+    }
+  }
+  else {
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+      rhs(stateID, iEq, nbEqs) += (coeff*flux[iEq])*_invr[1];
+    }
+  }
+  
+  socket_updateCoeff.getDataHandle()[stateID] += faceUpdateCoeff;
+}
+
+//////////
+
+void FVMCC_ComputeRHS::checkTableFaces()
+{
+  DataHandle<CFreal> rhs = socket_rhs.getDataHandle();
+  DataHandle<CFreal> updateCoeff = socket_updateCoeff.getDataHandle();
+  DataHandle<bool> cellFlag = socket_cellFlag.getDataHandle();
+  
+  vector<CFreal> initUpdateCoeff(updateCoeff.size());
+  for (CFuint i = 0; i < updateCoeff.size(); ++i) {
+    initUpdateCoeff[i] = updateCoeff[i];
+  }
+  
+  _useTableFaces = false;
+  processFaces(ALL_FACES);
+  _useTableFaces = true;
+  
+  vector<CFreal> serialRhs(rhs.size());
+  for (CFuint i = 0; i < rhs.size(); ++i) {
+    serialRhs[i] = rhs[i];
+  }
+  vector<CFreal> serialUpdateCoeff(updateCoeff.size());
+  for (CFuint i = 0; i < updateCoeff.size(); ++i) {
+    serialUpdateCoeff[i] = updateCoeff[i];
+    updateCoeff[i] = initUpdateCoeff[i];
+  }
+  
+  rhs = 0.0;
+  cellFlag = false;
+  processFaces(ALL_FACES);
+  
+  CFuint nbDiffs = 0;
+  for (CFuint i = 0; i < rhs.size(); ++i) {
+    if (rhs[i] != serialRhs[i]) {
+      if (nbDiffs == 0) {
+	CFLog(ERROR, "FVMCC_ComputeRHS::checkTableFaces() => rhs[" << i << "] = " 
+	      << rhs[i] << " instead of " << serialRhs[i] << "\n");
+      }
+      nbDiffs++;
+    }
+  }
+  for (CFuint i = 0; i < updateCoeff.size(); ++i) {
+    if (updateCoeff[i] != serialUpdateCoeff[i]) {
+      if (nbDiffs == 0) {
+	CFLog(ERROR, "FVMCC_ComputeRHS::checkTableFaces() => updateCoeff[" << i << "] = " 
+	      << updateCoeff[i] << " instead of " << serialUpdateCoeff[i] << "\n");
+      }
+      nbDiffs++;
+    }
+  }
+  
+  if (nbDiffs > 0) {
+    throw BadValueException 
+      (FromHere(), "FVMCC_ComputeRHS::checkTableFaces() => FaceTable and GeometricEntity face loops differ");
+  }
+  CFLog(VERBOSE, "FVMCC_ComputeRHS::checkTableFaces() => FaceTable and GeometricEntity face loops match\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::setupTableFaces()
+{
+  _useTableFaces = false;
+  _threadedFluxSplitter = dynamic_cast<FVMCC_FluxSplitter*>(&(*_fluxSplitter));
+  if (_nbThreadsOMP == 1 && !_useFaceTable) return;
+  
+  string reason = "";
+  if (!canThreadFaces()) {
+    reason = "the command " + getName() + " computes more than the explicit residual";
+  }
+  else if (dynamic_cast<ConstantPolyRec*>(&(*_polyRec)) == CFNULL) {
+    reason = "only the first order (Constant) reconstruction is supported";
+  }
+  else if (_threadedFluxSplitter.isNull() || !_threadedFluxSplitter->isThreadSafe()) {
+    reason = "the flux splitter " + _fluxSplitter->getName() + " is not thread safe";
+  }
+  else if (_nbThreadsOMP != 1 && !getMethodData().getUpdateVar()->isThreadSafe()) {
+    reason = "the update variables " + getMethodData().getUpdateVarStr() + " are not thread safe";
+  }
+  else if (_hasDiffusiveTerm || getMethodData().hasSourceTerm() || getMethodData().isAxisymmetric()) {
+    reason = "diffusive fluxes, source terms and axisymmetry are not supported";
+  }
+  else if (getMethodData().getUpdateVarStr() != getMethodData().getSolutionVarStr()) {
+    reason = "the update and solution variables must coincide";
+  }
+  else if (getMethodData().useAnalyticalConvJacob()) {
+    reason = "the analytical convective jacobian is not supported";
+  }
+  
+  if (reason != "") {
+    if (_nbThreadsOMP != 1) {
+      CFLog(WARN, "FVMCC_ComputeRHS::setup() => NbThreadsOMP ignored: " << reason << "\n");
+    }
+    else {
+      CFLog(INFO, "FVMCC_ComputeRHS::setup() => all faces built as GeometricEntity's: " << reason << "\n");
+    }
+    return;
+  }
+  
+  _useTableFaces = true;
+  _nbThreads = (_nbThreadsOMP == 1) ? 1 : getNbThreadsOMP(_nbThreadsOMP);
+  CFLog(INFO, "FVMCC_ComputeRHS::setup() => face loop over the FaceTable with " << _nbThreads << " thread(s)\n");
+  
+  SafePtr<PhysicalModel> physModel = PhysicalModelStack::getActive();
+  SafePtr<BaseTerm> convTerm = physModel->getImplementor()->getConvectiveTerm();
+  const string varSetName = physModel->getConvectiveName() + getMethodData().getUpdateVarStr();
+  const CFuint nbEqs = physModel->getNbEq();
+  const CFuint dim = physModel->getDim();
+  
+  _threadData.resize(_nbThreads);
+  _threadFlux.resize(_nbThreads);
+  for (CFuint i = 0; i < _nbThreads; ++i) {
+    _threadData[i] = new FVMCC_FluxSplitter::ThreadData();
+    FVMCC_FluxSplitter::ThreadData& td = *_threadData[i];
+    td.updateVar.reset(Factory<ConvectiveVarSet>::getInstance().getProvider(varSetName)->
+		       create(convTerm));
+    td.updateVar->setup();
+    convTerm->resizePhysicalData(td.pdata[0]);
+    convTerm->resizePhysicalData(td.pdata[1]);
+    td.unitNormal.resize(dim);
+    td.tempUnitNormal.resize(dim);
+    td.sumFlux.resize(nbEqs);
+    td.leftEv.resize(nbEqs);
+    td.rightEv.resize(nbEqs);
+    
+    _threadFlux[i].resize(nbEqs);
+  }
+  
+  // the faces around each state are listed again if the mesh changes
+  const CFuint nbTRSs = MeshDataStack::getActive()->getTrsList().size();
+  _faceFlux.resize(nbEqs);
+  _stateFacePtr.clear();
+  _stateFacePtr.resize(nbTRSs);
+  _stateFaces.clear();
+  _stateFaces.resize(nbTRSs);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::flagInnerFaces()
+{
+  CFLog(VERBOSE, "FVMCC_ComputeRHS::flagInnerFaces() START\n");
+  
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  DataHandle<State*> gstates = socket_gstates.getDataHandle();
+  DataHandle<Node*, GLOBAL> nodes = socket_nodes.getDataHandle();
+  
+  // the nodal states of the nodes belonging to a non updatable cell
+  // are extrapolated from ghost states of the partition
+  SafePtr<TopologicalRegionSet> cells = MeshDataStack::getActive()->getTrs("InnerCells");
+  const CFuint nbCells = cells->getLocalNbGeoEnts();
+  vector<bool> isGhostNode(nodes.size(), false);
+  for (CFuint iCell = 0; iCell < nbCells; ++iCell) {
+    if (!states[cells->getStateID(iCell,0)]->isParUpdatable()) {
+      const CFuint nbNodesInCell = cells->getNbNodesInGeo(iCell);
+      for (CFuint iNode = 0; iNode < nbNodesInCell; ++iNode) {
+	isGhostNode[cells->getNodeID(iCell,iNode)] = true;
+      }
+    }
+  }
+  
+  vector<SafePtr<TopologicalRegionSet> > trs = MeshDataStack::getActive()->getTrsList();
+  const CFuint nbTRSs = trs.size();
+  
+  Common::SafePtr<GeometricEntityPool<FaceCellTrsGeoBuilder> > geoBuilder = getMethodData().getFaceCellTrsGeoBuilder();
+  geoBuilder->getGeoBuilder()->setDataSockets(socket_states, socket_gstates, socket_nodes);
+  FaceCellTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
+  geoData.allCells = getMethodData().getBuildAllCells();
+  
+  // left and right states of all the faces (right ID is the ghost ID on the boundary)
+  vector<CFuint> faceStates;
+  vector<bool> isBFace;
+  vector<bool> isGhostFromGhost(gstates.size(), false);
+  _syncBFaces.clear();
+  
+  for (CFuint iTRS = 0; iTRS < nbTRSs; ++iTRS) {
+    SafePtr<TopologicalRegionSet> currTrs = trs[iTRS];
+    if (hasFluxesOnTrs(currTrs)) {
+      geoData.isBFace = currTrs->hasTag("writable");
+      geoData.faces = currTrs;
+      
+      const CFuint nbTrsFaces = currTrs->getLocalNbGeoEnts();
+      for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+	geoData.idx = iFace;
+	GeometricEntity *const face = geoBuilder->buildGE();
+	const State *const s0 = face->getState(0);
+	const State *const s1 = face->getState(1);
+	faceStates.push_back(s0->getLocalID());
+	faceStates.push_back(s1->getLocalID());
+	isBFace.push_back(s1->isGhost());
+	
+	// this ghost state is computed by the BC from a ghost state of the partition
+	if (s1->isGhost() && !s0->isParUpdatable()) {
+	  isGhostFromGhost[s1->getLocalID()] = true;
+	  _syncBFaces.push_back(pair<CFuint, CFuint>(iTRS, iFace));
+	}
+	geoBuilder->releaseGE();
+      }
+    }
+  }
+  
+  // a state is inner if its cell, its nodes and its reconstruction stencil
+  // don't involve any ghost state of the partition
+  vector<bool> isInnerState(states.size(), false);
+  for (CFuint iCell = 0; iCell < nbCells; ++iCell) {
+    const CFuint stateID = cells->getStateID(iCell,0);
+    bool isInner = states[stateID]->isParUpdatable();
+    
+    const CFuint nbNodesInCell = cells->getNbNodesInGeo(iCell);
+    for (CFuint iNode = 0; iNode < nbNodesInCell && isInner; ++iNode) {
+      isInner = !isGhostNode[cells->getNodeID(iCell,iNode)];
+    }
+    
+    if (isInner && socket_stencil.isConnected()) {
+      DataHandle<vector<State*> > stencil = socket_stencil.getDataHandle();
+      const vector<State*>& sten = stencil[stateID];
+      for (CFuint i = 0; i < sten.size() && isInner; ++i) {
+	isInner = (sten[i]->isGhost()) ? 
+	  !isGhostFromGhost[sten[i]->getLocalID()] : sten[i]->isParUpdatable();
+      }
+    }
+    isInnerState[stateID] = isInner;
+  }
+  
+  const CFuint nbFaces = isBFace.size();
+  _isInnerFace.resize(nbFaces);
+  CFuint nbInnerFaces = 0;
+  for (CFuint f = 0; f < nbFaces; ++f) {
+    // the BCs can use nodal states, which are extrapolated after the synchronization
+    _isInnerFace[f] = !isBFace[f] && isInnerState[faceStates[2*f]] && 
+      isInnerState[faceStates[2*f+1]];
+    if (_isInnerFace[f]) nbInnerFaces++;
+  }
+  
+  CFLog(VERBOSE, "FVMCC_ComputeRHS::flagInnerFaces() => " << nbInnerFaces 
+	<< " inner faces out of " << nbFaces << "\n");
+  CFLog(VERBOSE, "FVMCC_ComputeRHS::flagInnerFaces() END\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::updateAfterSync()
+{
+  // ghost states of the BCs computed from the (previously outdated)
+  // ghost states of the partition
+  if (_syncBFaces.size() > 0) {
+    vector<SafePtr<TopologicalRegionSet> > trs = MeshDataStack::getActive()->getTrsList();
+    SafePtr<CFMap<CFuint, FVMCC_BC*> > bcMap = getMethodData().getMapBC();
+    
+    Common::SafePtr<GeometricEntityPool<FaceTrsGeoBuilder> > geoBuilder = getMethodData().getFaceTrsGeoBuilder();
+    geoBuilder->getGeoBuilder()->setDataSockets(socket_states, socket_gstates, socket_nodes);
+    FaceTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
+    geoData.isBFace = true;
+    
+    for (CFuint i = 0; i < _syncBFaces.size(); ++i) {
+      const CFuint iTRS = _syncBFaces[i].first;
+      geoData.trs = trs[iTRS];
+      geoData.idx = _syncBFaces[i].second;
+      GeometricEntity *const face = geoBuilder->buildGE();
+      getMethodData().getCurrentFace() = face;
+      bcMap->find(iTRS)->setGhostState(face);
+      geoBuilder->releaseGE();
+    }
+  }
+  
+  // gradients and nodal states are recomputed with the received ghost states,
+  // the values in the inner cells don't change
+  _polyRec->computeGradients();
+  _nodalExtrapolator->extrapolateInAllNodes();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -439,6 +981,15 @@ void FVMCC_ComputeRHS::setup()
   CellTrsGeoBuilder::GeoData& cellGeoData = getMethodData().getCellTrsGeoBuilder()->getDataGE();
   cellGeoData.trs = cells;
   
+  // the inner faces are flagged again if the mesh changes
+  _isInnerFace.clear();
+  _syncBFaces.clear();
+  
+  // the face table is built again if the mesh changes
+  _faceTable.clear();
+  
+  setupTableFaces();
+  
   CFLog(VERBOSE, "FVMCC_ComputeRHS::setup() END\n");
 }
       
@@ -673,13 +1224,14 @@ vector<SafePtr<BaseDataSocketSink> > FVMCC_ComputeRHS::needsSockets()
   result.push_back(&socket_limiter);
   result.push_back(&socket_gstates);
   result.push_back(&socket_nodes);
+  result.push_back(&socket_stencil);
   
   return result;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-void FVMCC_ComputeRHS::initializeComputationRHS()
+void FVMCC_ComputeRHS::resetRHS()
 {
   // reset rhs to 0
   socket_rhs.getDataHandle() = 0.0;
@@ -688,6 +1240,13 @@ void FVMCC_ComputeRHS::initializeComputationRHS()
   for (CFuint i = 0; i < _eqFilters->size(); ++i) {
     (*_eqFilters)[i]->reset();
   }  
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::initializeComputationRHS()
+{
+  resetRHS();
   
   // _polyRec->updateWeights();
   _polyRec->computeGradients();
@@ -5,8 +5,10 @@
 
 #include "FiniteVolume/CellCenterFVMData.hh"
 #include "Framework/DataSocketSink.hh"
+#include "Framework/FaceTable.hh"
 #include "FiniteVolume/ComputeDiffusiveFlux.hh"
 #include "FiniteVolume/FVMCC_PolyRec.hh"
+#include "FiniteVolume/FVMCC_FluxSplitter.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -69,6 +71,13 @@ public:
    */
   virtual void execute();
 
+  /**
+   * Tells if execute() can start computing the fluxes in the interior of the
+   * partition while the synchronization of the states is still in progress.
+   * Subclasses overriding execute() or initializeComputationRHS() must 
+   * override this too.
+   */
+  virtual bool canOverlapSync() const {return true;}
  
   /**
    * Returns the DataSocket's that this command needs as sinks
@@ -78,12 +87,74 @@ public:
     
 protected:
   
+  /// subsets of faces processed by processFaces()
+  enum FaceSubset {ALL_FACES=0, INNER_FACES=1, OUTER_FACES=2};
+  
+  /// Compute the fluxes in the given subset of faces
+  /// @param subset  INNER_FACES are the faces without BC whose fluxes don't depend
+  ///                on any ghost state of the partition, OUTER_FACES all the others
+  void processFaces(const FaceSubset subset);
+  
+  /// Flag the faces whose fluxes don't depend on any ghost state of the partition
+  void flagInnerFaces();
+  
+  /// Tells if the fluxes of the inner faces can be computed before the
+  /// synchronization of the states, without gradients nor nodal states
+  bool canOverlapInnerFaces();
+  
+  /// Update the ghost states of the boundary conditions, the gradients and
+  /// the nodal states once the synchronization of the states is complete
+  void updateAfterSync();
+  
+  /// Tells if the fluxes have to be computed on the faces of the given TRS
+  bool hasFluxesOnTrs(Common::SafePtr<Framework::TopologicalRegionSet> trs);
+  
+  /// Tells if the per-face functions of this command (computePhysicalData(),
+  /// updateRHS(), computeRHSJacobian(), ...) allow the face loop over the
+  /// FaceTable, which replaces them by their first order explicit version.
+  /// Subclasses overriding them must override this too.
+  virtual bool canThreadFaces() const {return true;}
+  
+  /// Check if the face loop over the FaceTable can be used and allocate the
+  /// data of each thread
+  void setupTableFaces();
+  
+  /// Compute the fluxes in the given subset of faces of a TRS without boundary
+  /// condition, reading the connectivity from the FaceTable without building 
+  /// any GeometricEntity. With several threads, the fluxes of all the faces are
+  /// computed concurrently, then each thread sums them in the states it owns.
+  /// @param trs   TRS of the faces
+  /// @param iTRS  index of the TRS in the list of TRSs
+  void processFacesFromTable(Common::SafePtr<Framework::TopologicalRegionSet> trs,
+			     const CFuint iTRS, const FaceSubset subset);
+  
+  /// Compute the first order flux in one face and its contributions to the
+  /// update coefficients of the left and right states
+  /// @param faceID   local ID of the face
+  /// @param iThread  ID of the calling thread
+  /// @return false if no state of the face is updatable (nothing is computed)
+  bool computeFaceFromTable(const CFuint faceID, const CFuint iThread,
+			    CFreal *const flux, CFreal *const faceUpdateCoeff);
+  
+  /// Add the flux of a face computed by computeFaceFromTable() to the RHS
+  /// and to the update coefficient of one of its states
+  /// @param side  0 for the left state, 1 for the right state
+  void addFaceFromTable(const CFuint stateID, const CFuint side,
+			const CFreal *const flux, const CFreal faceUpdateCoeff);
+  
+  /// Compute the fluxes with both the GeometricEntity and the FaceTable face 
+  /// loops and check that they give exactly the same RHS and update coefficients
+  void checkTableFaces();
+  
   /// Restore the backed up left states
   virtual void restoreState(CFuint iCell) {}
   
   /// Initialize the computation of RHS
   virtual void initializeComputationRHS();
   
+  /// Reset the RHS, the cell flags and the equation filters
+  void resetRHS();
+  
   /// Compute the jacobian of the RHS
   virtual void computeRHSJacobian();
   
@@ -240,6 +311,9 @@ protected:
   /// storage of the nodes
   Framework::DataSocketSink < Framework::Node* , Framework::GLOBAL > socket_nodes;
   
+  /// storage of the stencil (only available with linear reconstruction)
+  Framework::DataSocketSink<std::vector<Framework::State*> > socket_stencil;
+  
   /// flux splitter
   Common::SafePtr<Framework::FluxSplitter<CellCenterFVMData> > _fluxSplitter;  
   /// diffusive flux computer
@@ -357,6 +431,58 @@ protected:
   /// flag telling if to use analytical transformation matrix
   bool _useAnalyticalMatrix;
   
+  /// flag telling if to process the faces from a precomputed FaceTable
+  bool _useFaceTable;
+  
+  /// precomputed face connectivity
+  Framework::FaceTable _faceTable;
+  
+  /// flags telling if each face is independent from the ghost states of the
+  /// partition (built the first time the states arrive unsynchronized)
+  std::vector<bool> _isInnerFace;
+  
+  /// TRS and face indices of the boundary faces whose ghost state is computed
+  /// from a ghost state of the partition
+  std::vector<std::pair<CFuint, CFuint> > _syncBFaces;
+  
+  /// number of threads computing the fluxes on the faces without
+  /// boundary condition (1 = serial face loop, 0 = all available)
+  CFuint _nbThreadsOMP;
+  
+  /// flag telling to compare the FaceTable face loop with the GeometricEntity one
+  bool _checkThreadsOMP;
+  
+  /// flag telling if the faces without BC are processed from the FaceTable
+  bool _useTableFaces;
+  
+  /// actual number of threads
+  CFuint _nbThreads;
+  
+  /// flux splitter, if it can be used by the FaceTable face loop
+  Common::SafePtr<FVMCC_FluxSplitter> _threadedFluxSplitter;
+  
+  /// flux splitter and reconstruction scratch data of each thread
+  std::vector<FVMCC_FluxSplitter::ThreadData*> _threadData;
+  
+  /// flux of each thread
+  std::vector<RealVector> _threadFlux;
+  
+  /// flux of each face of the current TRS
+  std::vector<CFreal> _faceFlux;
+  
+  /// contributions of each face of the current TRS to the update 
+  /// coefficients of its left and right states
+  std::vector<CFreal> _faceUpdateCoeff;
+  
+  /// flag telling if the flux of each face of the current TRS was computed
+  std::vector<CFuint> _isFaceComputed;
+  
+  /// for each TRS, faces around state s are _stateFaces[iTRS][_stateFacePtr[iTRS][s] ... _stateFacePtr[iTRS][s+1]-1]
+  std::vector<std::vector<CFuint> > _stateFacePtr;
+  
+  /// for each TRS, 2*iFace+side for the faces around each state, in increasing face order
+  std::vector<std::vector<CFuint> > _stateFaces;
+  
 }; // class FVMCC_ComputeRHS
 
 //////////////////////////////////////////////////////////////////////////////
@@ -7,6 +7,7 @@
 #include "FiniteVolume/FiniteVolume.hh"
 #include "FiniteVolume/FVMCC_ComputeRhsJacob.hh"
 #include "FiniteVolume/FVMCC_BC.hh"
+#include "FiniteVolume/ConstantPolyRec.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -43,9 +44,13 @@ FVMCC_ComputeRhsJacob::FVMCC_ComputeRhsJacob(const std::string& name) :
   _pertSource(),
   _sourceDiff(),
   _sourceDiffSum(),
-  _dummyJacob()
+  _dummyJacob(),
+  _useStatesDataCache(false)
 {
   addConfigOptionsTo(this);
+  
+  _cacheStatesData = false;
+  setParameter("CacheStatesData",&_cacheStatesData);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -58,6 +63,8 @@ FVMCC_ComputeRhsJacob::~FVMCC_ComputeRhsJacob()
 
 void FVMCC_ComputeRhsJacob::defineConfigOptions(Config::OptionList& options)
 {
+  options.addConfigOption< bool >
+    ("CacheStatesData", "Perturb only the physical data of the perturbed state of each face (only with constant reconstruction)");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -97,6 +104,14 @@ void FVMCC_ComputeRhsJacob::setup()
 
   _acc.reset(_lss->createBlockAccumulator(2, 2, nbEqs));
   _bAcc.reset(_lss->createBlockAccumulator(1, 1, nbEqs));
+  
+  // the blocks of a face always go to the same locations of the matrix
+  const CFuint nbFaces = MeshDataStack::getActive()->Statistics().getNbFaces();
+  _faceSlots.assign(4*nbFaces, -1);
+  
+  // with constant reconstruction the extrapolated values are the states themselves
+  _useStatesDataCache = _cacheStatesData &&
+    (dynamic_cast<ConstantPolyRec*>(&(*_polyRec)) != CFNULL);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -169,7 +184,7 @@ void FVMCC_ComputeRhsJacob::computeBothJacobTerms()
   }
     
   // add the values in the jacobian matrix
-  _lss->getMatrix()->addValues(*_acc);
+  _lss->getMatrix()->addValuesInSlots(*_acc, getFaceSlots());
   
   // _acc->print(); EXIT_AT(1);
   
@@ -227,7 +242,7 @@ void FVMCC_ComputeRhsJacob::computeJacobTerm(const CFuint idx)
   }
   
   // add the values in the jacobian matrix
-  _lss->getMatrix()->addValues(*_acc);
+  _lss->getMatrix()->addValuesInSlots(*_acc, getFaceSlots());
   
   // reset to zero the entries in the block accumulator
   _acc->reset();
@@ -303,7 +318,7 @@ void FVMCC_ComputeRhsJacob::computeBoundaryJacobianTerm()
     }
     
     // add the values in the jacobian matrix
-    _lss->getMatrix()->addValues(*_bAcc);
+    _lss->getMatrix()->addValuesInSlots(*_bAcc, getFaceSlots());
     // cout << "BAC" << endl;_bAcc->print();
 
     // reset to zero the entries in the block accumulator
@@ -322,9 +337,17 @@ void FVMCC_ComputeRhsJacob::computeConvDiffFluxes(CFuint iVar, CFuint iCell)
   // the solution in the quadrature points
   _polyRec->extrapolate(_currFace, iVar, iCell);
   
-  // compute the physical data for each left and right reconstructed
-  // state and in the left and right cell centers
-  computeStatesData();
+  if (_useStatesDataCache) {
+    // only the physical data of the perturbed state change
+    vector<RealVector>& pdata = _polyRec->getExtrapolatedPhysicaData();
+    pdata[1-iCell] = _polyRec->getBackupPhysicaData()[1-iCell];
+    _reconstrVar->computePhysicalData(*_polyRec->getExtrapolatedValues()[iCell], pdata[iCell]);
+  }
+  else {
+    // compute the physical data for each left and right reconstructed
+    // state and in the left and right cell centers
+    computeStatesData();
+  }
   
   // linearization will be done in the flux splitter if needed
   _fluxSplitter->computeFlux(_pertFlux);
@@ -434,6 +457,11 @@ void FVMCC_ComputeRhsJacob::computeRHSJacobian()
 {
   if (getMethodData().doComputeJacobian()) {
     _diffVar->setFreezeCoeff(_freezeDiffCoeff);
+    if (_useStatesDataCache) {
+      vector<RealVector>& pdata = _polyRec->getExtrapolatedPhysicaData();
+      _polyRec->getBackupPhysicaData()[0] = pdata[0];
+      _polyRec->getBackupPhysicaData()[1] = pdata[1];
+    }
     const bool isBFace = _currFace->getState(1)->isGhost();
     (!isBFace) ? computeJacobianTerm() : computeBoundaryJacobianTerm();
   }
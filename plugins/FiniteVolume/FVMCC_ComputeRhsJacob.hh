@@ -44,6 +44,12 @@ public:
    */
   static void defineConfigOptions(Config::OptionList& options);
 
+  /**
+   * The synchronization is completed before execute(), since
+   * initializeComputationRHS() resets the jacobian matrix
+   */
+  virtual bool canOverlapSync() const {return false;}
+
   /**
    * Set up private data and data of the aggregated classes
    * in this command before processing phase
@@ -86,6 +92,9 @@ protected:
   /// Compute the jacobian of the RHS
   virtual void computeRHSJacobian();
   
+  /// The jacobian is computed face by face
+  virtual bool canThreadFaces() const {return false;}
+  
   /// Finalize the computation of RHS
   virtual void finalizeComputationRHS();
   
@@ -128,6 +137,13 @@ protected:
   /// Compute convective and diffusive fluxes
   virtual void computeConvDiffFluxes(CFuint iVar, CFuint iCell);
   
+  /// @return the slots of the blocks of the current face in the jacobian matrix
+  CFint* getFaceSlots()
+  {
+    cf_assert(4*_currFace->getID() < _faceSlots.size());
+    return &_faceSlots[4*_currFace->getID()];
+  }
+  
 protected:
   
   /// pointer to the linear system solver
@@ -163,6 +179,15 @@ protected:
   /// dummy jacobian matrix
   RealMatrix _dummyJacob;
   
+  /// user option telling to reuse the unperturbed physical data of the face states
+  bool _cacheStatesData;
+  
+  /// flag telling if the unperturbed physical data are actually reused
+  bool _useStatesDataCache;
+  
+  /// slots of the (up to 2x2) blocks of each face in the jacobian matrix
+  std::vector<CFint> _faceSlots;
+  
 }; // class FVMCC_ComputeRhsJacob
 
 //////////////////////////////////////////////////////////////////////////////
@@ -64,6 +64,11 @@ public:
    */
   virtual void execute();
 
+  /**
+   * The fluxes are computed only once all the ghost states are synchronized
+   */
+  virtual bool canOverlapSync() const {return false;}
+
 protected:
 
   /**
@@ -0,0 +1,736 @@
+#include "Common/BadValueException.hh"
+#include "Common/PE.hh"
+#include "Framework/MethodCommandProvider.hh"
+#include "Framework/LSSMatrix.hh"
+#include "Framework/LinearSystemSolver.hh"
+#include "Framework/BlockAccumulator.hh"
+#include "Framework/MeshData.hh"
+#include "MathTools/GraphColoring.hh"
+
+#include "FiniteVolume/FiniteVolume.hh"
+#include "FiniteVolume/FVMCC_ComputeRhsJacobColored.hh"
+#include "FiniteVolume/FVMCC_BC.hh"
+
+#ifdef CF_HAVE_MPI
+#include "Common/MPI/MPIStructDef.hh"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::MathTools;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider<FVMCC_ComputeRhsJacobColored,
+		      CellCenterFVMData,
+		      FiniteVolumeModule>
+fvmcc_computeRhsJacobColored("NumJacobColored");
+
+//////////////////////////////////////////////////////////////////////////////
+
+FVMCC_ComputeRhsJacobColored::FVMCC_ComputeRhsJacobColored(const std::string& name) :
+  FVMCC_ComputeRhsJacob(name),
+  _faceTrs(),
+  _faceIdxInTrs(),
+  _faceStates(),
+  _faceIsBFace(),
+  _faceFlux(),
+  _faceUpFactor(),
+  _faceDiffActive(),
+  _adjPtr(),
+  _adj(),
+  _maxNbNeighbors(0),
+  _colorPtr(),
+  _colorStates(),
+  _posInColor(),
+  _colorFacePtr(),
+  _colorFaces(),
+  _colorFaceSide(),
+  _colorFaceSlot(),
+  _blockStart(),
+  _blocks(),
+  _origValues(),
+  _invEps(),
+  _pertDone(),
+  _cellSource(),
+  _hasCellSource(),
+  _statePhysData(),
+  _pertPhysData(),
+  _ghostBkp(),
+  _colAcc(CFNULL),
+  _useFaceByFaceJacob(false)
+{
+  addConfigOptionsTo(this);
+
+  // the physical data of each state are shared by all its faces by default
+  _cacheStatesData = true;
+
+  _checkJacobian = false;
+  setParameter("CheckJacobian",&_checkJacobian);
+
+  _checkTolerance = 1e-6;
+  setParameter("CheckTolerance",&_checkTolerance);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+FVMCC_ComputeRhsJacobColored::~FVMCC_ComputeRhsJacobColored()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< bool >
+    ("CheckJacobian", "Compare the first jacobian with the one of NumJacob and stop if they differ");
+  options.addConfigOption< CFreal >
+    ("CheckTolerance", "Maximum relative difference allowed by CheckJacobian");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::setup()
+{
+  FVMCC_ComputeRhsJacob::setup();
+
+  // the faces are perturbed after the whole residual has been computed, 
+  // when the frozen diffusive coefficients of each face are no longer available
+  _useFaceByFaceJacob = _freezeDiffCoeff;
+  if (_freezeDiffCoeff) {
+    CFLog(WARN, "FVMCC_ComputeRhsJacobColored::setup() => FreezeDiffCoeff: jacobian computed face by face as in NumJacob\n");
+  }
+
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  _ghostBkp.resize(nbEqs);
+
+  // the coloring is built again if the mesh changes
+  _colorPtr.clear();
+  _colAcc.reset();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::execute()
+{
+  CFTRACEBEGIN;
+
+  const bool computeJacob = getMethodData().doComputeJacobian() && !_freezeDiffCoeff;
+  if (computeJacob && _colorPtr.size() == 0) {
+    buildColoring();
+  }
+
+  if (computeJacob && _checkJacobian) {
+    checkColoredJacobian();
+    _checkJacobian = false;
+  }
+  else {
+    // residual and unperturbed face data
+    FVMCC_ComputeRHS::execute();
+    
+    if (computeJacob) {
+      computeColoredJacobian();
+    }
+  }
+
+  CFTRACEEND;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::checkColoredJacobian()
+{
+  DataHandle<CFreal> updateCoeff = socket_updateCoeff.getDataHandle();
+  SafePtr<LSSMatrix> jacobMatrix = _lss->getMatrix();
+  
+  vector<CFreal> initUpdateCoeff(updateCoeff.size());
+  for (CFuint i = 0; i < updateCoeff.size(); ++i) {
+    initUpdateCoeff[i] = updateCoeff[i];
+  }
+  
+  // reference jacobian, computed face by face as in NumJacob
+  _useFaceByFaceJacob = true;
+  FVMCC_ComputeRHS::execute();
+  _useFaceByFaceJacob = false;
+  
+  jacobMatrix->finalAssembly();
+  vector<CFreal> faceByFaceJacob;
+  getJacobianBlocks(faceByFaceJacob);
+  
+  jacobMatrix->resetToZeroEntries();
+  for (CFuint i = 0; i < updateCoeff.size(); ++i) {
+    updateCoeff[i] = initUpdateCoeff[i];
+  }
+  
+  FVMCC_ComputeRHS::execute();
+  computeColoredJacobian();
+  
+  jacobMatrix->finalAssembly();
+  vector<CFreal> coloredJacob;
+  getJacobianBlocks(coloredJacob);
+  
+  CFreal maxDiff[2] = {0., 0.};
+  for (CFuint i = 0; i < coloredJacob.size(); ++i) {
+    maxDiff[0] = max(maxDiff[0], std::abs(coloredJacob[i] - faceByFaceJacob[i]));
+    maxDiff[1] = max(maxDiff[1], std::abs(faceByFaceJacob[i]));
+  }
+  
+#ifdef CF_HAVE_MPI
+  const std::string nsp = getMethodData().getNamespace();
+  CFreal totalMaxDiff[2] = {0., 0.};
+  MPI_Datatype MPI_CFREAL = Common::MPIStructDef::getMPIType(&totalMaxDiff[0]);
+  MPI_Allreduce(maxDiff, totalMaxDiff, 2, MPI_CFREAL, MPI_MAX, PE::GetPE().GetCommunicator(nsp));
+  maxDiff[0] = totalMaxDiff[0];
+  maxDiff[1] = totalMaxDiff[1];
+#endif
+  
+  const CFreal relDiff = (maxDiff[1] > 0.) ? maxDiff[0]/maxDiff[1] : maxDiff[0];
+  CFLog(INFO, "FVMCC_ComputeRhsJacobColored::checkColoredJacobian() => max relative difference with NumJacob = " 
+	<< relDiff << "\n");
+  if (relDiff > _checkTolerance) {
+    throw BadValueException 
+      (FromHere(), "FVMCC_ComputeRhsJacobColored::checkColoredJacobian() => colored and face by face jacobians differ");
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::getJacobianBlocks(vector<CFreal>& blocks)
+{
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const CFuint nbEqs2 = nbEqs*nbEqs;
+  LSSIdxMapping& idxMapping = _lss->getLocalToGlobalMapping();
+  
+  vector<CFint> im(nbEqs);
+  vector<CFint> in(nbEqs);
+  blocks.clear();
+  for (CFuint p = 0; p < states.size(); ++p) {
+    if (!states[p]->isParUpdatable()) continue;
+    
+    for (CFuint i = 0; i < nbEqs; ++i) {
+      im[i] = idxMapping.getColID(p)*nbEqs + i;
+    }
+    
+    // diagonal block followed by the blocks of the neighbors
+    for (CFuint s = _adjPtr[p]; s <= _adjPtr[p+1]; ++s) {
+      const CFuint q = (s == _adjPtr[p]) ? p : _adj[s-1];
+      for (CFuint j = 0; j < nbEqs; ++j) {
+	in[j] = idxMapping.getColID(q)*nbEqs + j;
+      }
+      
+      const CFuint start = blocks.size();
+      blocks.resize(start + nbEqs2);
+      _lss->getMatrix()->getValues(nbEqs, &im[0], nbEqs, &in[0], &blocks[start]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::buildColoring()
+{
+  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobColored::buildColoring() START\n");
+
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  const CFuint nbStates = states.size();
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+
+  vector<SafePtr<TopologicalRegionSet> > trs = MeshDataStack::getActive()->getTrsList();
+  const CFuint nbTRSs = trs.size();
+
+  Common::SafePtr<GeometricEntityPool<FaceCellTrsGeoBuilder> > geoBuilder = getMethodData().getFaceCellTrsGeoBuilder();
+  geoBuilder->getGeoBuilder()->setDataSockets(socket_states, socket_gstates, socket_nodes);
+  FaceCellTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
+  geoData.allCells = getMethodData().getBuildAllCells();
+
+  // faces in the same order as in processFaces()
+  _faceTrs.clear();
+  _faceIdxInTrs.clear();
+  _faceStates.clear();
+  _faceIsBFace.clear();
+  for (CFuint iTRS = 0; iTRS < nbTRSs; ++iTRS) {
+    SafePtr<TopologicalRegionSet> currTrs = trs[iTRS];
+    if (hasFluxesOnTrs(currTrs)) {
+      geoData.isBFace = currTrs->hasTag("writable");
+      geoData.faces = currTrs;
+
+      const CFuint nbTrsFaces = currTrs->getLocalNbGeoEnts();
+      for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+	geoData.idx = iFace;
+	GeometricEntity *const face = geoBuilder->buildGE();
+	_faceTrs.push_back(iTRS);
+	_faceIdxInTrs.push_back(iFace);
+	_faceStates.push_back(face->getState(0)->getLocalID());
+	_faceStates.push_back(face->getState(1)->getLocalID());
+	_faceIsBFace.push_back(face->getState(1)->isGhost());
+	geoBuilder->releaseGE();
+      }
+    }
+  }
+
+  // only the faces with at least one updatable state contribute to the jacobian
+  const CFuint nbFaces = _faceIsBFace.size();
+  vector<bool> isActive(nbFaces);
+  for (CFuint f = 0; f < nbFaces; ++f) {
+    isActive[f] = states[_faceStates[2*f]]->isParUpdatable() ||
+      (!_faceIsBFace[f] && states[_faceStates[2*f+1]]->isParUpdatable());
+  }
+
+  // active faces of each state (CSR)
+  vector<CFuint> stateFacePtr(nbStates+1, 0);
+  for (CFuint f = 0; f < nbFaces; ++f) {
+    if (isActive[f]) {
+      stateFacePtr[_faceStates[2*f]+1]++;
+      if (!_faceIsBFace[f]) stateFacePtr[_faceStates[2*f+1]+1]++;
+    }
+  }
+  for (CFuint p = 0; p < nbStates; ++p) {
+    stateFacePtr[p+1] += stateFacePtr[p];
+  }
+  vector<CFuint> stateFaces(stateFacePtr[nbStates]);
+  vector<CFuint> pos(stateFacePtr.begin(), stateFacePtr.end()-1);
+  for (CFuint f = 0; f < nbFaces; ++f) {
+    if (isActive[f]) {
+      stateFaces[pos[_faceStates[2*f]]++] = f;
+      if (!_faceIsBFace[f]) stateFaces[pos[_faceStates[2*f+1]]++] = f;
+    }
+  }
+
+  // neighbors of each state, sorted to find the block of each face
+  _adjPtr.assign(nbStates+1, 0);
+  _adj.clear();
+  _maxNbNeighbors = 0;
+  for (CFuint p = 0; p < nbStates; ++p) {
+    const CFuint start = _adj.size();
+    for (CFuint i = stateFacePtr[p]; i < stateFacePtr[p+1]; ++i) {
+      const CFuint f = stateFaces[i];
+      if (!_faceIsBFace[f]) {
+	_adj.push_back((_faceStates[2*f] == p) ? _faceStates[2*f+1] : _faceStates[2*f]);
+      }
+    }
+    sort(_adj.begin() + start, _adj.end());
+    _adj.erase(unique(_adj.begin() + start, _adj.end()), _adj.end());
+    _adjPtr[p+1] = _adj.size();
+    _maxNbNeighbors = max(_maxNbNeighbors, _adjPtr[p+1] - _adjPtr[p]);
+  }
+
+  // two states sharing a face never get the same color
+  vector<CFuint> colors;
+  const CFuint nbColors = GraphColoring::colorByNodes
+    (nbStates, stateFacePtr, stateFaces, nbFaces, colors);
+  GraphColoring::groupByColor(colors, nbColors, _colorPtr, _colorStates);
+
+  _posInColor.resize(nbStates);
+  CFuint maxColorSize = 0;
+  CFuint maxColorBlocks = 0;
+  for (CFuint c = 0; c < nbColors; ++c) {
+    CFuint nbBlocks = 0;
+    for (CFuint k = _colorPtr[c]; k < _colorPtr[c+1]; ++k) {
+      const CFuint p = _colorStates[k];
+      _posInColor[p] = k - _colorPtr[c];
+      nbBlocks += 1 + _adjPtr[p+1] - _adjPtr[p];
+    }
+    maxColorSize = max(maxColorSize, _colorPtr[c+1] - _colorPtr[c]);
+    maxColorBlocks = max(maxColorBlocks, nbBlocks);
+  }
+
+  // faces of each color sorted by face index, so that the TRSs are contiguous
+  _colorFacePtr.assign(nbColors+1, 0);
+  for (CFuint f = 0; f < nbFaces; ++f) {
+    if (isActive[f]) {
+      _colorFacePtr[colors[_faceStates[2*f]]+1]++;
+      if (!_faceIsBFace[f]) _colorFacePtr[colors[_faceStates[2*f+1]]+1]++;
+    }
+  }
+  for (CFuint c = 0; c < nbColors; ++c) {
+    _colorFacePtr[c+1] += _colorFacePtr[c];
+  }
+
+  const CFuint nbColorFaces = _colorFacePtr[nbColors];
+  _colorFaces.resize(nbColorFaces);
+  _colorFaceSide.resize(nbColorFaces);
+  _colorFaceSlot.resize(nbColorFaces);
+  vector<CFuint> next(_colorFacePtr.begin(), _colorFacePtr.end()-1);
+  for (CFuint f = 0; f < nbFaces; ++f) {
+    if (isActive[f]) {
+      const CFuint nbSides = (!_faceIsBFace[f]) ? 2 : 1;
+      for (CFuint side = 0; side < nbSides; ++side) {
+	const CFuint p = _faceStates[2*f+side];
+	const CFuint i = next[colors[p]]++;
+	_colorFaces[i] = f;
+	_colorFaceSide[i] = side;
+	_colorFaceSlot[i] = 0;
+	if (!_faceIsBFace[f]) {
+	  const CFuint q = _faceStates[2*f+1-side];
+	  const CFuint* first = &_adj[0] + _adjPtr[p];
+	  const CFuint* last  = &_adj[0] + _adjPtr[p+1];
+	  cf_assert(binary_search(first, last, q));
+	  _colorFaceSlot[i] = 1 + (lower_bound(first, last, q) - first);
+	}
+      }
+    }
+  }
+
+  // storage for the unperturbed face data and for the columns of one color
+  _faceFlux.resize(nbFaces*nbEqs);
+  _faceUpFactor.resize(2*nbFaces);
+  _faceDiffActive.assign(nbFaces, true);
+  _blockStart.resize(maxColorSize);
+  _blocks.resize(maxColorBlocks*nbEqs*nbEqs);
+  _origValues.resize(maxColorSize);
+  _invEps.resize(maxColorSize);
+  _pertDone.resize(maxColorSize);
+  _cellSource.resize(nbStates*nbEqs);
+  _hasCellSource.assign(nbStates, false);
+
+  _statePhysData.clear();
+  _pertPhysData.clear();
+  if (_useStatesDataCache) {
+    const CFuint sizePData = _polyRec->getExtrapolatedPhysicaData()[0].size();
+    _statePhysData.resize(nbStates);
+    for (CFuint p = 0; p < nbStates; ++p) {
+      _statePhysData[p].resize(sizePData);
+    }
+    _pertPhysData.resize(maxColorSize);
+    for (CFuint k = 0; k < maxColorSize; ++k) {
+      _pertPhysData[k].resize(sizePData);
+    }
+  }
+
+  _colAcc.reset(_lss->createBlockAccumulator(1 + _maxNbNeighbors, 1, nbEqs));
+  _stateSlots.assign(nbStates*(1 + _maxNbNeighbors), -1);
+
+  CFLog(INFO, "FVMCC_ComputeRhsJacobColored::buildColoring() => " << nbColors
+	<< " colors for " << nbStates << " states\n");
+  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobColored::buildColoring() END\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::computePhysicalData()
+{
+  computeStatesData();
+
+  if (_useStatesDataCache && !_useFaceByFaceJacob && getMethodData().doComputeJacobian()) {
+    vector<RealVector>& pdata = _polyRec->getExtrapolatedPhysicaData();
+    for (CFuint i = 0; i < 2; ++i) {
+      const State *const state = _currFace->getState(i);
+      if (!state->isGhost()) {
+	_statePhysData[state->getLocalID()] = pdata[i];
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::computeRHSJacobian()
+{
+  if (_useFaceByFaceJacob) {
+    FVMCC_ComputeRhsJacob::computeRHSJacobian();
+    return;
+  }
+  
+  if (getMethodData().doComputeJacobian()) {
+    const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+    cf_assert(_faceIdx < _faceIsBFace.size());
+
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+      _faceFlux[_faceIdx*nbEqs + iEq] = _flux[iEq];
+    }
+
+    (!getMethodData().isAxisymmetric()) ? computeNoAxiUpFactors() : computeAxiUpFactors();
+    _faceUpFactor[2*_faceIdx]   = _upFactor[0];
+    _faceUpFactor[2*_faceIdx+1] = _upFactor[0]*_upFactor[1];
+    _faceDiffActive[_faceIdx] = _isDiffusionActive;
+
+    for (CFuint iCell = 0; iCell < 2; ++iCell) {
+      const State *const state = _currFace->getState(iCell);
+      if (state->isGhost() || !state->isParUpdatable()) continue;
+      const CFuint stateID = state->getLocalID();
+
+      // the analytical jacobian of the source terms only involves the diagonal block
+      if (computeSourceTermJacob(iCell,_stAnJacobIDs)) {
+	_bAcc->setRowColIndex(0, stateID);
+	for (CFuint i = 0; i < _stAnJacobIDs.size(); ++i) {
+	  RealMatrix& sourceJacob = _sourceJacobian[iCell][_stAnJacobIDs[i]];
+	  sourceJacob *= _upStFactor[iCell];
+	  _bAcc->addValuesM(0, 0, sourceJacob);
+	}
+	_lss->getMatrix()->addValues(*_bAcc);
+	_bAcc->reset();
+      }
+
+      // unperturbed source terms for the numerical jacobian
+      if (computeSourceTermJacob(iCell,_stNumJacobIDs)) {
+	_hasCellSource[stateID] = true;
+	for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+	  CFreal sum = 0.;
+	  for (CFuint i = 0; i < _stNumJacobIDs.size(); ++i) {
+	    sum += _source[iCell][_stNumJacobIDs[i]][iEq];
+	  }
+	  _cellSource[stateID*nbEqs + iEq] = sum;
+	}
+      }
+    }
+
+    _sourceJacobOnCell[LEFT] = _sourceJacobOnCell[RIGHT] = false;
+  }
+
+  // set off the perturbation flag
+  getMethodData().setIsPerturb(false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::computeColoredJacobian()
+{
+  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobColored::computeColoredJacobian() START\n");
+
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const CFuint nbEqs2 = nbEqs*nbEqs;
+  const bool hasNumSource = (_stNumJacobIDs.size() > 0);
+
+  vector<SafePtr<TopologicalRegionSet> > trs = MeshDataStack::getActive()->getTrsList();
+  SafePtr<CFMap<CFuint, FVMCC_BC*> > bcMap = getMethodData().getMapBC();
+
+  Common::SafePtr<GeometricEntityPool<FaceCellTrsGeoBuilder> > geoBuilder = getMethodData().getFaceCellTrsGeoBuilder();
+  geoBuilder->getGeoBuilder()->setDataSockets(socket_states, socket_gstates, socket_nodes);
+  FaceCellTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
+  geoData.allCells = getMethodData().getBuildAllCells();
+  vector<bool> zeroGrad(nbEqs, false);
+
+  vector<State*>& values = _polyRec->getExtrapolatedValues();
+  vector<RealVector>& pdata = _polyRec->getExtrapolatedPhysicaData();
+
+  // the diffusive coefficients are recomputed with the perturbed states
+  getMethodData().setIsPerturb(true);
+  _diffVar->setFreezeCoeff(false);
+
+  const CFuint nbColors = _colorPtr.size() - 1;
+  for (CFuint c = 0; c < nbColors; ++c) {
+    const CFuint sStart = _colorPtr[c];
+    const CFuint nbColorStates = _colorPtr[c+1] - sStart;
+
+    CFuint nbBlocks = 0;
+    for (CFuint k = 0; k < nbColorStates; ++k) {
+      const CFuint p = _colorStates[sStart + k];
+      _blockStart[k] = nbBlocks;
+      nbBlocks += 1 + _adjPtr[p+1] - _adjPtr[p];
+    }
+    std::fill(_blocks.begin(), _blocks.begin() + nbBlocks*nbEqs2, 0.);
+
+    for (CFuint iVar = 0; iVar < nbEqs; ++iVar) {
+      // set the perturbed variable
+      getMethodData().setIPerturbVar(iVar);
+
+      // perturb all the states of the color
+      for (CFuint k = 0; k < nbColorStates; ++k) {
+	CFreal& value = (*states[_colorStates[sStart + k]])[iVar];
+	_origValues[k] = value;
+	_numericalJacob->perturb(iVar, value);
+	_invEps[k] = 1./(value - _origValues[k]);
+	_pertDone[k] = false;
+      }
+
+      CFint currTRS = -1;
+      for (CFuint i = _colorFacePtr[c]; i < _colorFacePtr[c+1]; ++i) {
+	const CFuint f = _colorFaces[i];
+	const CFuint side = _colorFaceSide[i];
+	const CFuint p = _faceStates[2*f+side];
+	const CFuint k = _posInColor[p];
+	const bool isBFace = _faceIsBFace[f];
+
+	if ((CFint)_faceTrs[f] != currTRS) {
+	  currTRS = _faceTrs[f];
+	  SafePtr<TopologicalRegionSet> currTrs = trs[currTRS];
+	  if (currTrs->hasTag("writable")) {
+	    _currBC = bcMap->find(currTRS);
+	    _currBC->setPutGhostsOnFace();
+	    geoData.isBFace = true;
+	    _polyRec->setZeroGradient(_currBC->getZeroGradientsFlags());
+	  }
+	  else {
+	    geoData.isBFace = false;
+	    _polyRec->setZeroGradient(&zeroGrad);
+	  }
+	  geoData.faces = currTrs;
+	}
+
+	PhysicalModelStack::getActive()->resetEquationSubSysDescriptor();
+	geoData.idx = _faceIdxInTrs[f];
+	_currFace = geoBuilder->buildGE();
+	setFaceIntegratorData();
+
+	// compute the ghost state in the perturbed inner state
+	if (isBFace) {
+	  _ghostBkp = *_currFace->getState(1);
+	  _currBC->setGhostState(_currFace);
+	}
+
+	// extrapolate (and LIMIT, if the reconstruction is linear or more)
+	// the solution in the quadrature points
+	_polyRec->extrapolate(_currFace);
+
+	if (_useStatesDataCache) {
+	  if (!_pertDone[k]) {
+	    _reconstrVar->computePhysicalData(*values[side], _pertPhysData[k]);
+	  }
+	  pdata[side] = _pertPhysData[k];
+	  if (!isBFace) {
+	    pdata[1-side] = _statePhysData[_faceStates[2*f+1-side]];
+	  }
+	  else {
+	    _reconstrVar->computePhysicalData(*values[1], pdata[1]);
+	  }
+	}
+	else {
+	  computeStatesData();
+	}
+
+	_pertFlux = 0.;
+	(!isBFace) ? _fluxSplitter->computeFlux(_pertFlux) : _currBC->computeFlux(_pertFlux);
+
+	if (_hasDiffusiveTerm && _faceDiffActive[f]) {
+	  _dFlux = 0.;
+	  _diffusiveFlux->computeFlux(_dFlux);
+	  _pertFlux -= _dFlux;
+	}
+
+	// finite difference derivative of the flux
+	const CFreal *const flux0 = &_faceFlux[f*nbEqs];
+	for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+	  _fluxDiff[iEq] = (_pertFlux[iEq] - flux0[iEq])*_invEps[k];
+	}
+
+	// the flux is added to the rows of both states in the column of the perturbed one
+	const CFreal ownFactor = _faceUpFactor[2*f+side];
+	CFreal *const ownCol = &_blocks[_blockStart[k]*nbEqs2 + iVar*nbEqs];
+	for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+	  ownCol[iEq] += ownFactor*_fluxDiff[iEq];
+	}
+
+	if (!isBFace) {
+	  const CFreal otherFactor = _faceUpFactor[2*f+1-side];
+	  CFreal *const otherCol = &_blocks[(_blockStart[k] + _colorFaceSlot[i])*nbEqs2 + iVar*nbEqs];
+	  for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+	    otherCol[iEq] += otherFactor*_fluxDiff[iEq];
+	  }
+	}
+
+	// the source terms of each cell are perturbed only once
+	if (!_pertDone[k]) {
+	  if (hasNumSource && _hasCellSource[p] && states[p]->isParUpdatable()) {
+	    addSourceTermColumn(side, k, ownCol);
+	  }
+	  _pertDone[k] = true;
+	}
+
+	// restore the original ghost state
+	if (isBFace) {
+	  *_currFace->getState(1) = _ghostBkp;
+	}
+
+	geoBuilder->releaseGE();
+      }
+
+      // restore the unperturbed values
+      for (CFuint k = 0; k < nbColorStates; ++k) {
+	(*states[_colorStates[sStart + k]])[iVar] = _origValues[k];
+      }
+    }
+
+    flushColorBlocks(c);
+  }
+
+  // set off the perturbation flag
+  getMethodData().setIsPerturb(false);
+
+  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobColored::computeColoredJacobian() END\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::addSourceTermColumn(const CFuint side,
+						       const CFuint k,
+						       CFreal *const block)
+{
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  GeometricEntity *const cell = _currFace->getNeighborGeo(side);
+  const CFuint stateID = cell->getState(0)->getLocalID();
+
+  _sourceDiffSum = 0.;
+  for (CFuint i = 0; i < _stNumJacobIDs.size(); ++i) {
+    const CFuint ist = _stNumJacobIDs[i];
+    _pertSource[ist] = 0.;
+    (*_stComputers)[ist]->computeSource(cell, _pertSource[ist], _dummyJacob);
+    _sourceDiffSum += _pertSource[ist];
+  }
+
+  CFreal factor = -getResFactor()*_invEps[k];
+  if (getMethodData().isAxisymmetric()) {
+    factor /= std::abs(cell->getState(0)->getCoordinates()[YY]);
+  }
+
+  const CFreal *const source0 = &_cellSource[stateID*nbEqs];
+  for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+    block[iEq] += factor*(_sourceDiffSum[iEq] - source0[iEq]);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobColored::flushColorBlocks(const CFuint color)
+{
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const CFuint nbEqs2 = nbEqs*nbEqs;
+  const CFuint nbRows = 1 + _maxNbNeighbors;
+
+  for (CFuint k = 0; k < _colorPtr[color+1] - _colorPtr[color]; ++k) {
+    const CFuint p = _colorStates[_colorPtr[color] + k];
+    const CFuint nbNeighbors = _adjPtr[p+1] - _adjPtr[p];
+
+    // the rows of the non updatable states are ignored
+    _colAcc->setColIndex(0, p);
+    _colAcc->setRowIndex(0, (states[p]->isParUpdatable()) ? (CFint)p : -1);
+    for (CFuint s = 0; s < nbNeighbors; ++s) {
+      const CFuint q = _adj[_adjPtr[p] + s];
+      _colAcc->setRowIndex(1 + s, (states[q]->isParUpdatable()) ? (CFint)q : -1);
+    }
+    for (CFuint s = 1 + nbNeighbors; s < nbRows; ++s) {
+      _colAcc->setRowIndex(s, -1);
+    }
+
+    const CFreal *const column = &_blocks[_blockStart[k]*nbEqs2];
+    for (CFuint b = 0; b <= nbNeighbors; ++b) {
+      for (CFuint iVar = 0; iVar < nbEqs; ++iVar) {
+	_colAcc->setValues(b, 0, iVar, &column[b*nbEqs2 + iVar*nbEqs]);
+      }
+    }
+
+    _lss->getMatrix()->addValuesInSlots(*_colAcc, &_stateSlots[p*nbRows]);
+    _colAcc->reset();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // namespace FiniteVolume
+
+} // namespace Numerics
+
+} // namespace COOLFluiD
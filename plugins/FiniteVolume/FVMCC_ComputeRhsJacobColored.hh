@@ -0,0 +1,212 @@
+#ifndef COOLFluiD_Numerics_FiniteVolume_FVMCC_ComputeRhsJacobColored_hh
+#define COOLFluiD_Numerics_FiniteVolume_FVMCC_ComputeRhsJacobColored_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "FiniteVolume/FVMCC_ComputeRhsJacob.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class represents a command that computes the RHS and a finite
+ * difference jacobian obtained by perturbing at once all the states of the
+ * same color.
+ *
+ * The states are colored so that two states sharing a face never get the
+ * same color. After the unperturbed residual, for each color and each
+ * variable all the states of the color are perturbed together and only the
+ * faces touching them are processed again: every such face has exactly one
+ * perturbed state, whose jacobian column is accumulated from the flux
+ * difference and stored once in the linear system matrix.
+ * Each face is still evaluated 2*nbEqs times, but with constant reconstruction
+ * (CacheStatesData) the physical data of each perturbed state are computed 
+ * once per variable and shared by all its faces, instead of once per face.
+ * With FreezeDiffCoeff the jacobian is computed face by face as in NumJacob,
+ * since the faces are perturbed after the whole residual has been computed.
+ * CheckJacobian compares the first jacobian with the face by face one of NumJacob.
+ */
+class FVMCC_ComputeRhsJacobColored : public FVMCC_ComputeRhsJacob {
+public:
+
+  /**
+   * Constructor.
+   */
+  explicit FVMCC_ComputeRhsJacobColored(const std::string& name);
+
+  /**
+   * Destructor.
+   */
+  virtual ~FVMCC_ComputeRhsJacobColored();
+
+  /**
+   * Defines the Config Option's of this class
+   * @param options a OptionList where to add the Option's
+   */
+  static void defineConfigOptions(Config::OptionList& options);
+
+  /**
+   * Set up private data and data of the aggregated classes
+   * in this command before processing phase
+   */
+  virtual void setup();
+
+  /**
+   * Execute Processing actions
+   */
+  virtual void execute();
+
+protected:
+
+  /**
+   * Compute the physical data in the states, storing the ones of the
+   * unperturbed states if they are shared by all the faces
+   */
+  virtual void computePhysicalData();
+
+  /// Store the unperturbed data of the current face needed by the jacobian
+  virtual void computeRHSJacobian();
+
+  /// Compute the jacobian, one color at a time
+  void computeColoredJacobian();
+
+  /// Compute the residual and the jacobian both face by face and by colors
+  /// and throw if the two jacobians differ
+  void checkColoredJacobian();
+
+  /// Get the diagonal and neighbor blocks of the updatable rows of the jacobian
+  void getJacobianBlocks(std::vector<CFreal>& blocks);
+
+  /// Build the face list, the coloring of the states and the per color face lists
+  void buildColoring();
+
+  /// Add the numerical jacobian of the source terms in the cell of the
+  /// perturbed state of the current face
+  /// @param side  side of the current face holding the perturbed state
+  /// @param k     position of the perturbed state in the current color
+  /// @param block diagonal block of the jacobian column of the perturbed state
+  void addSourceTermColumn(const CFuint side, const CFuint k, CFreal *const block);
+
+  /// Store the jacobian columns of the states of the given color in the
+  /// linear system matrix
+  void flushColorBlocks(const CFuint color);
+
+private:
+
+  /// TRS of each face
+  std::vector<CFuint> _faceTrs;
+
+  /// index in its TRS of each face
+  std::vector<CFuint> _faceIdxInTrs;
+
+  /// left and right state IDs of each face (the right one is a ghost ID on the boundary)
+  std::vector<CFuint> _faceStates;
+
+  /// flags telling if each face is a boundary face
+  std::vector<bool> _faceIsBFace;
+
+  /// unperturbed flux of each face
+  std::vector<CFreal> _faceFlux;
+
+  /// update factors of the flux jacobian for the left and right rows of each face
+  std::vector<CFreal> _faceUpFactor;
+
+  /// flags telling if diffusion is active on each face
+  std::vector<bool> _faceDiffActive;
+
+  /// neighbors of state p are _adj[_adjPtr[p]] ... [_adjPtr[p+1]-1] (sorted)
+  std::vector<CFuint> _adjPtr;
+
+  /// neighbors of each state
+  std::vector<CFuint> _adj;
+
+  /// maximum number of neighbors of a state
+  CFuint _maxNbNeighbors;
+
+  /// states of color c are _colorStates[_colorPtr[c]] ... [_colorPtr[c+1]-1]
+  std::vector<CFuint> _colorPtr;
+
+  /// states sorted by color
+  std::vector<CFuint> _colorStates;
+
+  /// position of each state within its color
+  std::vector<CFuint> _posInColor;
+
+  /// faces of color c are _colorFaces[_colorFacePtr[c]] ... [_colorFacePtr[c+1]-1]
+  std::vector<CFuint> _colorFacePtr;
+
+  /// faces touching a state of the corresponding color
+  std::vector<CFuint> _colorFaces;
+
+  /// side of each face in _colorFaces holding the state of the color
+  std::vector<CFuint> _colorFaceSide;
+
+  /// block (in the column of the perturbed state) of the other state
+  /// of each face in _colorFaces (0 for the boundary faces)
+  std::vector<CFuint> _colorFaceSlot;
+
+  /// first block of the column of each state of the current color
+  std::vector<CFuint> _blockStart;
+
+  /// jacobian column blocks of the states of the current color
+  std::vector<CFreal> _blocks;
+
+  /// unperturbed values of the perturbed variable in the current color
+  std::vector<CFreal> _origValues;
+
+  /// inverse of the perturbation of each state in the current color
+  std::vector<CFreal> _invEps;
+
+  /// flags telling if the cell of each state in the current color has been visited
+  std::vector<bool> _pertDone;
+
+  /// unperturbed source terms with numerical jacobian in each cell
+  std::vector<CFreal> _cellSource;
+
+  /// flags telling if the numerical jacobian of the source terms is needed in each cell
+  std::vector<bool> _hasCellSource;
+
+  /// unperturbed physical data of each state
+  std::vector<RealVector> _statePhysData;
+
+  /// perturbed physical data of each state in the current color
+  std::vector<RealVector> _pertPhysData;
+
+  /// backup of the ghost state of the current boundary face
+  RealVector _ghostBkp;
+
+  /// accumulator for one jacobian column
+  std::auto_ptr<Framework::BlockAccumulator> _colAcc;
+
+  /// slots of the blocks of the jacobian column of each state in the matrix
+  std::vector<CFint> _stateSlots;
+
+  /// flag telling to compute the jacobian face by face as in NumJacob
+  bool _useFaceByFaceJacob;
+
+  /// user option telling to compare the first jacobian with the one of NumJacob
+  bool _checkJacobian;
+
+  /// maximum relative difference allowed when checking the jacobian
+  CFreal _checkTolerance;
+
+}; // class FVMCC_ComputeRhsJacobColored
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FiniteVolume_FVMCC_ComputeRhsJacobColored_hh
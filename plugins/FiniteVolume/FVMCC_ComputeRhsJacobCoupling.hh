@@ -43,6 +43,12 @@ public:
    */
   virtual void setup();
   
+  /**
+   * The synchronization is completed before execute(), since
+   * initializeComputationRHS() resets the jacobian matrices
+   */
+  virtual bool canOverlapSync() const {return false;}
+  
 protected:
 
   /// Initialize the computation of RHS
@@ -51,6 +57,9 @@ protected:
   /// Compute the jacobian of the RHS
   virtual void computeRHSJacobian();
   
+  /// The jacobian is computed face by face
+  virtual bool canThreadFaces() const {return false;}
+  
   /// Finalize the computation of RHS
   virtual void finalizeComputationRHS();
   
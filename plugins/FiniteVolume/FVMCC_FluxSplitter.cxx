@@ -123,6 +123,14 @@ void FVMCC_FluxSplitter::computeFlux(RealVector& result)
   }
 }
       
+//////////////////////////////////////////////////////////////////////////////
+      
+void FVMCC_FluxSplitter::computeThreadedFlux(ThreadData& td, RealVector& result)
+{
+  throw Common::NotImplementedException 
+    (FromHere(), "FVMCC_FluxSplitter::computeThreadedFlux() not implemented by " + getName());
+}
+      
 //////////////////////////////////////////////////////////////////////////////
  
 void FVMCC_FluxSplitter::configure ( Config::ConfigArgs& args )
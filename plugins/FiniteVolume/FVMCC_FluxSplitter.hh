@@ -65,6 +65,73 @@ public:
    */
   virtual void computeFlux(RealVector& result);
   
+  /**
+   * Scratch data of one thread computing first order fluxes with
+   * computeThreadedFlux(), filled by the caller for each face
+   */
+  class ThreadData {
+  public:
+    /// constructor
+    ThreadData() : faceID(0), leftState(CFNULL), rightState(CFNULL), updateVar(), 
+		   pdata(2), unitNormal(), tempUnitNormal(), sumFlux(), leftEv(), rightEv(),
+		   leftUpdateCoeff(0.), rightUpdateCoeff(0.) {}
+    
+    /// local ID of the current face
+    CFuint faceID;
+    
+    /// left state of the current face
+    Framework::State* leftState;
+    
+    /// right state of the current face
+    Framework::State* rightState;
+    
+    /// copy of the update variable set owned by the thread
+    Common::SelfRegistPtr<Framework::ConvectiveVarSet> updateVar;
+    
+    /// physical data of the left and right states
+    std::vector<RealVector> pdata;
+    
+    /// unit normal of the current face
+    RealVector unitNormal;
+    
+    /// temporary unit normal
+    RealVector tempUnitNormal;
+    
+    /// temporary sum of the left and right fluxes
+    RealVector sumFlux;
+    
+    /// eigenvalues of the left state
+    RealVector leftEv;
+    
+    /// eigenvalues of the right state
+    RealVector rightEv;
+    
+    /// contribution of the current face to the update coefficient of the left state
+    CFreal leftUpdateCoeff;
+    
+    /// contribution of the current face to the update coefficient of the right state
+    CFreal rightUpdateCoeff;
+  };
+  
+  /**
+   * Tells if computeThreadedFlux() is implemented, i.e. if the first order
+   * flux can be computed concurrently on different faces
+   */
+  virtual bool isThreadSafe() const {return false;}
+  
+  /**
+   * Prepare the data shared by all the faces before a threaded face loop
+   */
+  virtual void prepareThreadedFlux() {}
+  
+  /**
+   * Compute the first order flux in the face of the given thread data, using
+   * only the thread data as scratch storage. The contributions of the face to
+   * the update coefficients of its states, added by computeFlux(), are 
+   * returned in the thread data instead.
+   */
+  virtual void computeThreadedFlux(ThreadData& td, RealVector& result);
+  
 protected:
   
   /**
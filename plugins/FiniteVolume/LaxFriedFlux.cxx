@@ -42,7 +42,8 @@ LaxFriedFlux::LaxFriedFlux(const std::string& name) :
   _sumFlux(),
   _rightEv(),
   _leftEv(),
-  _tempUnitNormal()
+  _tempUnitNormal(),
+  _threadedDiffRedCoeff(1.0)
 {
   addConfigOptionsTo(this);
   _currentDiffRedCoeff = 1.0;
@@ -187,6 +188,60 @@ void LaxFriedFlux::compute(RealVector& result)
 
 //////////////////////////////////////////////////////////////////////////////
 
+void LaxFriedFlux::prepareThreadedFlux()
+{
+  // the dissipation control function depends on the iteration, not on the face
+  _threadedDiffRedCoeff = getReductionCoeff();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LaxFriedFlux::computeThreadedFlux(ThreadData& td, RealVector& result)
+{
+  // same operations as computeFlux() and compute() in the first order case, 
+  // where the reconstructed states are the cell states
+  SafePtr<ConvectiveVarSet> updateVarSet = td.updateVar.getPtr();
+  vector<RealVector>& pdata = td.pdata;
+  const RealVector& unitNormal = td.unitNormal;
+  
+  td.sumFlux = updateVarSet->getFlux()(pdata[1], unitNormal);
+  td.sumFlux += updateVarSet->getFlux()(pdata[0], unitNormal);
+  
+  updateVarSet->computeEigenValues(pdata[1], unitNormal, td.rightEv);
+  updateVarSet->computeEigenValues(pdata[0], unitNormal, td.leftEv);
+  
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  CFreal aR = 0.0;
+  CFreal aL = 0.0;
+  for (CFuint i = 0; i < nbEqs; ++i) {
+    aR = max(aR, std::abs(td.rightEv[i]));
+    aL = max(aL, std::abs(td.leftEv[i]));
+  }
+  const CFreal a = max(aR,aL);
+  
+  const State& leftState  = *td.leftState;
+  const State& rightState = *td.rightState;
+  const CFreal aDiff = a*_threadedDiffRedCoeff;
+  
+  result = 0.5*(td.sumFlux - aDiff*(rightState - leftState));
+  
+  // the update coefficients are summed by the caller
+  const CFreal area = socket_faceAreas.getDataHandle()[td.faceID];
+  const CFreal faceArea = area/getMethodData().getPolyReconstructor()->nbQPoints();
+  td.leftUpdateCoeff = max(td.leftEv.max(), 0.0)*faceArea;
+  td.rightUpdateCoeff = 0.;
+  
+  if (!rightState.isGhost()) {
+    td.tempUnitNormal = -1.0*unitNormal;
+    const CFreal maxEV = updateVarSet->getMaxEigenValue(pdata[1],td.tempUnitNormal);
+    td.rightUpdateCoeff = max(maxEV, 0.)*faceArea;
+  }
+  
+  result *= area;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 CFreal LaxFriedFlux::getReductionCoeff()
 {
   _currentDiffRedCoeff = std::min(_currentDiffRedCoeff, getDissipationControlCoeff());
@@ -10,6 +10,8 @@
 
 #ifdef CF_HAVE_CUDA
 #include "Common/CUDA/CudaEnv.hh"
+#endif
+#ifdef CF_HAVE_DEVICE_KERNELS
 #include "Framework/MathTypes.hh"
 #include "Framework/VarSetTransformerT.hh"
 #include "FiniteVolume/FluxData.hh"
@@ -35,7 +37,7 @@ namespace COOLFluiD {
 class LaxFriedFlux : public FVMCC_FluxSplitter {
 public:
   
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
   /// nested class defining local options
   template <typename P = NOTYPE>
   class DeviceConfigOptions {
@@ -77,6 +79,7 @@ public:
     typename MathTypes<CFreal, DT, VS::DIM>::VEC m_tempUnitNormal;
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the device
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
@@ -84,6 +87,7 @@ public:
     CFreal currentDiffRedCoeff = getReductionCoeff(); 
     CudaEnv::copyHost2Dev(&dco->currentDiffRedCoeff, &currentDiffRedCoeff, 1);
   }  
+#endif
   
   /// copy the local configuration options to the device
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -122,6 +126,22 @@ public:
    */
   virtual void compute(RealVector& result);
   
+  /**
+   * The first order flux can be computed concurrently on several faces.
+   * Subclasses overriding compute() must override this too.
+   */
+  virtual bool isThreadSafe() const {return true;}
+  
+  /**
+   * Compute the reduction coefficient shared by all the faces
+   */
+  virtual void prepareThreadedFlux();
+  
+  /**
+   * Compute the first order flux in the face of the given thread data
+   */
+  virtual void computeThreadedFlux(ThreadData& td, RealVector& result);
+  
 protected:
   
   /**
@@ -152,11 +172,14 @@ protected:
   /// diffusion reduction coefficient defined interactively
   CFreal _currentDiffRedCoeff;
   
+  /// reduction coefficient used by computeThreadedFlux()
+  CFreal _threadedDiffRedCoeff;
+  
 }; // end of class LaxFriedFlux
 
 //////////////////////////////////////////////////////////////////////////////
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
 /// nested class defining the flux
 template <DeviceType DT, typename VS>
 void LaxFriedFlux::DeviceFunc<DT, VS>::operator()(FluxData<VS>* data, VS* model) 
@@ -176,7 +199,7 @@ void LaxFriedFlux::DeviceFunc<DT, VS>::operator()(FluxData<VS>* data, VS* model)
   updateVS->computeEigenValues(&m_pdata[0], &m_tempUnitNormal[0], &m_tmp[0]);
   CFreal aR = 0.0;
   for (CFuint i = 0; i < VS::NBEQS; ++i) {
-    aR = max(aR, abs(m_tmp[i]));
+    aR = fmax(aR, abs(m_tmp[i]));
   }
   
   // left physical data, flux and eigenvalues
@@ -188,13 +211,13 @@ void LaxFriedFlux::DeviceFunc<DT, VS>::operator()(FluxData<VS>* data, VS* model)
     
   // compute update coefficient
   if (!data->isPerturb()) {    
-    const CFreal k = max(m_tmp.max(), 0.)*data->getFaceArea();
+    const CFreal k = fmax(m_tmp.max(), 0.)*data->getFaceArea();
     data->setUpdateCoeff(k);
   }
   
   CFreal aL = 0.0;
   for (CFuint i = 0; i < VS::NBEQS; ++i) {
-    aL = max(aL, abs(m_tmp[i]));
+    aL = fmax(aL, abs(m_tmp[i]));
   }
   
   const CFreal a = fmax(aR,aL);
@@ -6,10 +6,12 @@
 #include "FiniteVolume/FVMCC_PolyRec.hh"
 
 #ifdef CF_HAVE_CUDA
+#include "Common/CUDA/CudaEnv.hh"
+#endif
+#ifdef CF_HAVE_DEVICE_KERNELS
 #include "FiniteVolume/FluxData.hh"
 #include "FiniteVolume/KernelData.hh"
 #include "FiniteVolume/CellData.hh"
-#include "Common/CUDA/CudaEnv.hh"
 #include "Framework/SubSystemStatus.hh"
 #endif
 
@@ -32,7 +34,7 @@ namespace COOLFluiD {
 class LeastSquareP1PolyRec2D : public FVMCC_PolyRec {
 public:
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
   /// nested class defining local options
   template <typename P = NOTYPE>
   class DeviceConfigOptions {
@@ -100,6 +102,7 @@ public:
     DeviceConfigOptions<NOTYPE>* m_dco;
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the device
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
@@ -116,6 +119,7 @@ public:
     CudaEnv::copyHost2Dev(&dco->currIter, &iter, 1);
     CudaEnv::copyHost2Dev(&dco->currRes, &res, 1);
   }   
+#endif
   
   /// copy the local configuration options to the device
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -209,7 +213,7 @@ protected:
 
 //////////////////////////////////////////////////////////////////////////////
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
 
 template <typename PHYS>
 void LeastSquareP1PolyRec2D::DeviceFunc<PHYS>::computeGradients
@@ -2,9 +2,13 @@
 #include "Framework/MeshData.hh"
 #include "Framework/CellConn.hh"
 #include "Config/ConfigOptionPtr.hh"
+#ifdef CF_HAVE_CUDA
 #include "Framework/CudaDeviceManager.hh"
-#include "Common/CUDA/CFVec.hh"
 #include "Framework/CudaTimer.hh"
+#endif
+#include "Common/OMPHelper.hh"
+#include "Common/Stopwatch.hh"
+#include "Common/CUDA/CFVec.hh"
 #include "FiniteVolume/FluxData.hh"
 #include "FiniteVolume/KernelData.hh"
 #include "FiniteVolume/CellData.hh"
@@ -198,6 +202,8 @@ HOST_DEVICE void computeFaceCentroid(const CellData::Itr* cell, const CFuint fac
 
 //////////////////////////////////////////////////////////////////////////////
 
+#ifdef CF_HAVE_CUDA
+
 template <typename PHYS, typename POLYREC>
 __global__ void computeGradientsKernel(typename POLYREC::BASE::template DeviceConfigOptions<NOTYPE>* dcor,
 				       const CFuint nbCells,
@@ -401,6 +407,8 @@ __global__ void computeFluxKernel(typename SCHEME::BASE::template DeviceConfigOp
     }
   }
 }
+
+#endif
   
 //////////////////////////////////////////////////////////////////////////////
 
@@ -433,127 +441,108 @@ void computeFluxCPU(CFuint nbThreadsOMP,
 { 
   typedef typename SCHEME::MODEL PHYS;
   
-  FluxData<PHYS> fd;
-#ifndef CF_HAVE_OMP  
-  fd.initialize();
-  FluxData<PHYS>* currFd = &fd;
-  cf_assert(currFd != CFNULL);
-#endif
-  POLYREC polyRec(dcor);
-  SCHEME fluxScheme(dcof);
-  LIMITER limt(dcol);
-  PHYS pmodel(dcop);
-  
   CellData cells(nbCells, cellInfo, cellStencil, cellFaces, cellNodes, neighborTypes, cellConn);
   KernelData<CFreal> kd(nbCells, states, nodes, centerNodes, ghostStates, ghostNodes, updateCoeff, 
 			rhs, normals, uX, uY, uZ, isOutward);
   
-  CFreal midFaceCoord[PHYS::DIM*PHYS::DIM*2];
-  CudaEnv::CFVec<CFreal,PHYS::NBEQS> tmpLimiter;
-
+  // each cell only writes its own gradients, limiter, residual and update coefficient:
+  // the three loops can be split among threads without any synchronization except 
+  // for the implicit barriers at the end of each "omp for"
 #ifdef CF_HAVE_OMP
-  //const CFuint nThr = omp_get_num_procs();
-  // omp_set_num_threads(nbThreadsOMP);
-#pragma omp num_thread(nbThreadsOMP) parallel private(polyRec) private(fd)
-{
-  #pragma omp for
+  const int nbThreads = static_cast<int>(Common::getNbThreadsOMP(nbThreadsOMP));
+#pragma omp parallel num_threads(nbThreads)
 #endif 
-  // compute the cell-based gradients
-  for (CFuint cellID = 0; cellID < nbCells; ++cellID) {
-#ifdef CF_HAVE_OMP
+  {
+    // functors hold scratch data, so each thread needs its own instances
+    FluxData<PHYS> fd;
     fd.initialize();
     FluxData<PHYS>* currFd = &fd;
-    cf_assert(currFd != CFNULL);
-#endif 
-    CellData::Itr cell = cells.getItr(cellID);
-    polyRec.computeGradients(&states[cellID*PHYS::NBEQS], &centerNodes[cellID*PHYS::DIM], &kd, &cell);
-  }
+    POLYREC polyRec(dcor);
+    SCHEME fluxScheme(dcof);
+    LIMITER limt(dcol);
+    PHYS pmodel(dcop);
+    
+    CFreal midFaceCoord[PHYS::DIM*PHYS::DIM*2];
+    CudaEnv::CFVec<CFreal,PHYS::NBEQS> tmpLimiter;
+    
+    // compute the cell-based gradients
 #ifdef CF_HAVE_OMP
-}
-#endif
-
-#ifdef CF_HAVE_OMP  
-#pragma omp num_thread(nbThreadsOMP) parallel private(limt) private(kd)
-{
-  #pragma omp for
+#pragma omp for schedule(static)
 #endif 
-  // compute the cell based limiter 
-  for (CFuint cellID = 0; cellID < nbCells; ++cellID) {
-  // for (CellData::Itr cell = cells.begin(); cell <= cells.end(); ++cell) {
-    CellData::Itr cell = cells.getItr(cellID);
-    // compute all cell quadrature points at once (size of this array is overestimated)
-    const CFuint nbFacesInCell = cell.getNbFacesInCell();
-    for (CFuint f = 0; f < nbFacesInCell; ++f) { 
-      computeFaceCentroid<PHYS>(&cell, f, nodes, &midFaceCoord[f*PHYS::DIM]);
+    for (CFint iCell = 0; iCell < (CFint)nbCells; ++iCell) {
+      const CFuint cellID = iCell;
+      CellData::Itr cell = cells.getItr(cellID);
+      polyRec.computeGradients(&states[cellID*PHYS::NBEQS], &centerNodes[cellID*PHYS::DIM], &kd, &cell);
     }
     
-    //   const CFuint cellID = cell.getCellID();
-    if (dcor->currRes > dcor->limitRes && (dcor->limitIter > 0 && dcor->currIter < dcor->limitIter)) {	
-      // compute cell-based limiter
-      limt.limit(&kd, &cell, &midFaceCoord[0], &limiter[cellID*PHYS::NBEQS]);
-    }
-    else {
-      if (!dcor->freezeLimiter) {
-	// historical modification of the limiter
-	limt.limit(&kd, &cell, &midFaceCoord[0], &tmpLimiter[0]);
-	CFuint currID = cellID*PHYS::NBEQS;
-	for (CFuint iVar = 0; iVar < PHYS::NBEQS; ++iVar, ++currID) {
-	  limiter[currID] = min(tmpLimiter[iVar],limiter[currID]);
+    // compute the cell based limiter 
+#ifdef CF_HAVE_OMP
+#pragma omp for schedule(static)
+#endif 
+    for (CFint iCell = 0; iCell < (CFint)nbCells; ++iCell) {
+      const CFuint cellID = iCell;
+      CellData::Itr cell = cells.getItr(cellID);
+      // compute all cell quadrature points at once (size of this array is overestimated)
+      const CFuint nbFacesInCell = cell.getNbFacesInCell();
+      for (CFuint f = 0; f < nbFacesInCell; ++f) { 
+	computeFaceCentroid<PHYS>(&cell, f, nodes, &midFaceCoord[f*PHYS::DIM]);
+      }
+      
+      if (dcor->currRes > dcor->limitRes && (dcor->limitIter > 0 && dcor->currIter < dcor->limitIter)) {	
+	// compute cell-based limiter
+	limt.limit(&kd, &cell, &midFaceCoord[0], &limiter[cellID*PHYS::NBEQS]);
+      }
+      else {
+	if (!dcor->freezeLimiter) {
+	  // historical modification of the limiter
+	  limt.limit(&kd, &cell, &midFaceCoord[0], &tmpLimiter[0]);
+	  CFuint currID = cellID*PHYS::NBEQS;
+	  for (CFuint iVar = 0; iVar < PHYS::NBEQS; ++iVar, ++currID) {
+	    limiter[currID] = std::min(tmpLimiter[iVar],limiter[currID]);
+	  }
 	}
       }
     }
-  }
+    
+    // compute the fluxes
 #ifdef CF_HAVE_OMP
-}
-
-#pragma omp num_thread(nbThreadsOMP) parallel private(fd) private(kd) private(fluxScheme) private(pmodel)
-{
-  #pragma omp for
+#pragma omp for schedule(static)
 #endif 
-  // compute the fluxes
-  for (CFuint cellID = 0; cellID < nbCells; ++cellID) {
-  //  for (CellData::Itr cell = cells.begin(); cell <= cells.end(); ++cell) {
-#ifdef CF_HAVE_OMP
-    fd.initialize();
-    FluxData<PHYS>* currFd = &fd;
-    cf_assert(currFd != CFNULL);
-#endif
-    // reset the rhs and update coefficients to 0
-   // const CFuint cellID = cell.getCellID();
-    CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> res(&rhs[cellID*PHYS::NBEQS]);
-    res = 0.;
-    updateCoeff[cellID] = 0.;
-
-    CellData::Itr cell = cells.getItr(cellID);   
-    const CFuint nbFacesInCell = cell.getNbActiveFacesInCell();
-    for (CFuint f = 0; f < nbFacesInCell; ++f) { 
-      const CFint stype = cell.getNeighborType(f);
+    for (CFint iCell = 0; iCell < (CFint)nbCells; ++iCell) {
+      const CFuint cellID = iCell;
+      // reset the rhs and update coefficients to 0
+      CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> res(&rhs[cellID*PHYS::NBEQS]);
+      res = 0.;
+      updateCoeff[cellID] = 0.;
       
-      if (stype != 0) { // skip all partition faces
-	const CFuint stateID =  cell.getNeighborID(f);
-	setFluxData(f, stype, stateID, cellID, &kd, currFd, cellFaces);
-	
-	// compute face quadrature points (centroid)
-	CFreal* faceCenters = &midFaceCoord[f*PHYS::DIM];
-	computeFaceCentroid<PHYS>(&cell, f, nodes, faceCenters);
+      CellData::Itr cell = cells.getItr(cellID);   
+      const CFuint nbFacesInCell = cell.getNbActiveFacesInCell();
+      for (CFuint f = 0; f < nbFacesInCell; ++f) { 
+	const CFint stype = cell.getNeighborType(f);
 	
-	// extrapolate solution on quadrature points on both sides of the face
-	polyRec.extrapolateOnFace(currFd, faceCenters, uX, uY, uZ, limiter);
-	fluxScheme(currFd, &pmodel); // compute the convective flux across the face
-	
-	for (CFuint iEq = 0; iEq < PHYS::NBEQS; ++iEq) {
-	  const CFreal value = currFd->getResidual()[iEq];
-	  res[iEq] -= value;  // update the residual 
+	if (stype != 0) { // skip all partition faces
+	  const CFuint stateID =  cell.getNeighborID(f);
+	  setFluxData(f, stype, stateID, cellID, &kd, currFd, cellFaces);
+	  
+	  // compute face quadrature points (centroid)
+	  CFreal* faceCenters = &midFaceCoord[f*PHYS::DIM];
+	  computeFaceCentroid<PHYS>(&cell, f, nodes, faceCenters);
+	  
+	  // extrapolate solution on quadrature points on both sides of the face
+	  polyRec.extrapolateOnFace(currFd, faceCenters, uX, uY, uZ, limiter);
+	  fluxScheme(currFd, &pmodel); // compute the convective flux across the face
+	  
+	  for (CFuint iEq = 0; iEq < PHYS::NBEQS; ++iEq) {
+	    const CFreal value = currFd->getResidual()[iEq];
+	    res[iEq] -= value;  // update the residual 
+	  }
+	  
+	  // update the update coefficient
+	  updateCoeff[cellID] += currFd->getUpdateCoeff();
 	}
-	
-	// update the update coefficient
-	updateCoeff[cellID] += currFd->getUpdateCoeff();
       }
     }
   }
-#ifdef CF_HAVE_OMP
-} 
-#endif
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -731,6 +720,9 @@ void FVMCC_ComputeRHSCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>::exec
     ConfigOptionPtr<LIMITER> dcol(lm);
     ConfigOptionPtr<typename PHYSICS::PTERM> dcop(phys);
     
+    Stopwatch<WallTime> timer;
+    timer.start();
+    
     computeFluxCPU<FluxScheme, PolyRec, Limiter>
       (m_nbThreadsOMP,
        dcof.getPtr(),
@@ -740,9 +732,10 @@ void FVMCC_ComputeRHSCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>::exec
        nbCells,
        socket_states.getDataHandle().getGlobalArray()->ptr(), 
        socket_nodes.getDataHandle().getGlobalArray()->ptr(),
-       m_centerNodes.ptr(), 
-       m_ghostStates.ptr(),
-       m_ghostNodes.ptr(),
+       &m_centerNodes[0], 
+       // a partition without boundary faces has no ghost states
+       (m_ghostStates.size() > 0) ? &m_ghostStates[0] : CFNULL,
+       (m_ghostNodes.size() > 0) ? &m_ghostNodes[0] : CFNULL,
        socket_uX.getDataHandle().getLocalArray()->ptr(),
        socket_uY.getDataHandle().getLocalArray()->ptr(),
        socket_uZ.getDataHandle().getLocalArray()->ptr(),
@@ -751,12 +744,14 @@ void FVMCC_ComputeRHSCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>::exec
        rhs.getLocalArray()->ptr(),
        normals.getLocalArray()->ptr(),
        isOutward.getLocalArray()->ptr(),
-       m_cellInfo.ptr(),
-       m_cellStencil.ptr(),
-       m_cellFaces->getPtr()->ptr(),
-       m_cellNodes->getPtr()->ptr(),
-       m_neighborTypes.ptr(),
-       m_cellConn.ptr());
+       &m_cellInfo[0],
+       &m_cellStencil[0],
+       &(*m_cellFaces->getPtr())[0],
+       &(*m_cellNodes->getPtr())[0],
+       &m_neighborTypes[0],
+       &m_cellConn[0]);
+    
+    CFLog(VERBOSE, "FVMCC_ComputeRHSCell::execute() => computeFluxCPU took " << timer.read() << " s\n");
   }
   
 // for (int i = 0; i < updateCoeff.size(); ++i) {
@@ -0,0 +1,2 @@
+// CPU (OpenMP) build of the cell-based kernels, used when CUDA is not available
+#include "FiniteVolumeCUDA/FVMCC_ComputeRHSCellMHD.cu"
@@ -3,9 +3,13 @@
 #include "Framework/BlockAccumulatorBaseCUDA.hh"
 #include "Framework/CellConn.hh"
 #include "Config/ConfigOptionPtr.hh"
+#ifdef CF_HAVE_CUDA
 #include "Framework/CudaDeviceManager.hh"
-#include "Common/CUDA/CFVec.hh"
 #include "Framework/CudaTimer.hh"
+#endif
+#include "Common/OMPHelper.hh"
+#include "Common/Stopwatch.hh"
+#include "Common/CUDA/CFVec.hh"
 #include "FiniteVolume/CellData.hh"
 
 #include "FiniteVolumeCUDA/FiniteVolumeCUDA.hh"
@@ -215,6 +219,8 @@ HOST_DEVICE void computeFaceCentroid(const CellData::Itr* cell, const CFuint fac
 
 //////////////////////////////////////////////////////////////////////////////
 
+#ifdef CF_HAVE_CUDA
+
 template <typename PHYS, typename POLYREC>
 __global__ void computeGradientsKernel(typename POLYREC::BASE::template DeviceConfigOptions<NOTYPE>* dcor,
 				       const CFuint nbCells,
@@ -453,10 +459,13 @@ __global__ void computeFluxJacobianKernel(typename SCHEME::BASE::template Device
   }
 }
 
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
   
 template <typename SCHEME, typename POLYREC, typename LIMITER>
-void computeFluxJacobianCPU(typename SCHEME::BASE::template DeviceConfigOptions<NOTYPE>* dcof,
+void computeFluxJacobianCPU(CFuint nbThreadsOMP,
+			    typename SCHEME::BASE::template DeviceConfigOptions<NOTYPE>* dcof,
 			    typename POLYREC::BASE::template DeviceConfigOptions<NOTYPE>* dcor,
 			    typename LIMITER::BASE::template DeviceConfigOptions<NOTYPE>* dcol,
 			    typename NumericalJacobian::DeviceConfigOptions<typename SCHEME::MODEL>* dcon,
@@ -488,280 +497,183 @@ void computeFluxJacobianCPU(typename SCHEME::BASE::template DeviceConfigOptions<
   
   typedef typename SCHEME::MODEL PHYS;
   
-  CudaEnv::CudaTimer& timer = CudaEnv::CudaTimer::getInstance();
+  Common::Stopwatch<Common::WallTime> timer;
   timer.start();
   
-  FluxData<PHYS> fd; fd.initialize();
-  FluxData<PHYS>* currFd = &fd;
-  cf_assert(currFd != CFNULL);
-  SCHEME fluxScheme(dcof);
-  POLYREC polyRec(dcor);
-  LIMITER limt(dcol);
-  
   CellData cells(nbCells, cellInfo, cellStencil, cellFaces, cellNodes, neighborTypes, cellConn);
   KernelData<CFreal> kd(nbCells, states, nodes, centerNodes, ghostStates, ghostNodes, updateCoeff, 
 			rhs, normals, uX, uY, uZ, isOutward);
   
-  const CFuint MAX_NB_FACES = PHYS::DIM*2;
-  CFreal midFaceCoord[PHYS::DIM*MAX_NB_FACES];
-  CudaEnv::CFVec<CFreal,PHYS::NBEQS> fluxDiff;
-  CudaEnv::CFVec<CFreal,PHYS::NBEQS> resBkp;
-  CudaEnv::CFVec<CFreal,PHYS::NBEQS> tmpLimiter;
-  NumericalJacobian::DeviceFunc<PHYS> numJacob(dcon);
-  PHYS pmodel(dcop);
-  
-  // compute the cell-based gradients
-  for (CFuint cellID = 0; cellID < nbCells; ++cellID) {
-    CellData::Itr cell = cells.getItr(cellID);
-    polyRec.computeGradients(&states[cellID*PHYS::NBEQS], &centerNodes[cellID*PHYS::DIM], &kd, &cell);
-  }
-  
-  // printGradients<PHYS::NBEQS>(uX, uY, uZ, nbCells);
-  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::computeFluxJacobianCPU() => computing gradients took " << timer.elapsed() << " s\n");
-  timer.start();
-  
-  // compute the cell based limiter
-  for (CellData::Itr cell = cells.begin(); cell <= cells.end(); ++cell) {
-    // compute all cell quadrature points at once (size of this array is overestimated)
-    const CFuint nbFacesInCell = cell.getNbFacesInCell();
-    for (CFuint f = 0; f < nbFacesInCell; ++f) { 
-      computeFaceCentroid<PHYS>(&cell, f, nodes, &midFaceCoord[f*PHYS::DIM]);
+  // each cell only writes its own gradients, limiter, residual, update coefficient
+  // and column block of the jacobian: the loops can be split among threads without 
+  // any synchronization except for the implicit barriers at the end of each "omp for"
+#ifdef CF_HAVE_OMP
+  const int nbThreads = static_cast<int>(Common::getNbThreadsOMP(nbThreadsOMP));
+#pragma omp parallel num_threads(nbThreads)
+#endif
+  {
+    // functors hold scratch data, so each thread needs its own instances
+    FluxData<PHYS> fd; fd.initialize();
+    FluxData<PHYS>* currFd = &fd;
+    SCHEME fluxScheme(dcof);
+    POLYREC polyRec(dcor);
+    LIMITER limt(dcol);
+    PHYS pmodel(dcop);
+    
+    // the numerical jacobian backs up the perturbed value in its options
+    typename NumericalJacobian::DeviceConfigOptions<PHYS> dconLocal = *dcon;
+    NumericalJacobian::DeviceFunc<PHYS> numJacob(&dconLocal);
+    
+    const CFuint MAX_NB_FACES = PHYS::DIM*2;
+    CFreal midFaceCoord[PHYS::DIM*MAX_NB_FACES];
+    CudaEnv::CFVec<CFreal,PHYS::NBEQS> fluxDiff;
+    CudaEnv::CFVec<CFreal,PHYS::NBEQS> resBkp;
+    CudaEnv::CFVec<CFreal,PHYS::NBEQS> tmpLimiter;
+    
+    // compute the cell-based gradients
+#ifdef CF_HAVE_OMP
+#pragma omp for schedule(static)
+#endif
+    for (CFint iCell = 0; iCell < (CFint)nbCells; ++iCell) {
+      const CFuint cellID = iCell;
+      CellData::Itr cell = cells.getItr(cellID);
+      polyRec.computeGradients(&states[cellID*PHYS::NBEQS], &centerNodes[cellID*PHYS::DIM], &kd, &cell);
     }
     
-    const CFuint cellID = cell.getCellID();
-    if (dcor->currRes > dcor->limitRes && (dcor->limitIter > 0 && dcor->currIter < dcor->limitIter)) {	
-      // compute cell-based limiter
-      limt.limit(&kd, &cell, &midFaceCoord[0], &limiter[cellID*PHYS::NBEQS]);
+#ifdef CF_HAVE_OMP
+#pragma omp master
+#endif
+    {
+      // printGradients<PHYS::NBEQS>(uX, uY, uZ, nbCells);
+      CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::computeFluxJacobianCPU() => computing gradients took " << timer.read() << " s\n");
+      timer.restart();
     }
-    else {
-      if (!dcor->freezeLimiter) {
-	// historical modification of the limiter
-	limt.limit(&kd, &cell, &midFaceCoord[0], &tmpLimiter[0]);
-	CFuint currID = cellID*PHYS::NBEQS;
-	for (CFuint iVar = 0; iVar < PHYS::NBEQS; ++iVar, ++currID) {
-	  limiter[currID] = min(tmpLimiter[iVar],limiter[currID]);
+    
+    // compute the cell based limiter
+#ifdef CF_HAVE_OMP
+#pragma omp for schedule(static)
+#endif
+    for (CFint iCell = 0; iCell < (CFint)nbCells; ++iCell) {
+      const CFuint cellID = iCell;
+      CellData::Itr cell = cells.getItr(cellID);
+      // compute all cell quadrature points at once (size of this array is overestimated)
+      const CFuint nbFacesInCell = cell.getNbFacesInCell();
+      for (CFuint f = 0; f < nbFacesInCell; ++f) { 
+	computeFaceCentroid<PHYS>(&cell, f, nodes, &midFaceCoord[f*PHYS::DIM]);
+      }
+      
+      if (dcor->currRes > dcor->limitRes && (dcor->limitIter > 0 && dcor->currIter < dcor->limitIter)) {	
+	// compute cell-based limiter
+	limt.limit(&kd, &cell, &midFaceCoord[0], &limiter[cellID*PHYS::NBEQS]);
+      }
+      else {
+	if (!dcor->freezeLimiter) {
+	  // historical modification of the limiter
+	  limt.limit(&kd, &cell, &midFaceCoord[0], &tmpLimiter[0]);
+	  CFuint currID = cellID*PHYS::NBEQS;
+	  for (CFuint iVar = 0; iVar < PHYS::NBEQS; ++iVar, ++currID) {
+	    limiter[currID] = min(tmpLimiter[iVar],limiter[currID]);
+	  }
 	}
       }
     }
-  }
-  
-  // printLimiter<PHYS::NBEQS>(limiter, nbCells);
-  
-  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::computeFluxJacobianCPU() => computing limiter took " << timer.elapsed() << " s\n");
-  timer.start();
-  
-  // compute the fluxes and the jacobian
-  for (CellData::Itr cell = cells.begin(); cell <= cells.end(); ++cell) {
-    // reset the rhs and update coefficients to 0
-    const CFuint cellID = cell.getCellID();
-    CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> res(&rhs[cellID*PHYS::NBEQS]);
-    res = 0.;
-    updateCoeff[cellID] = 0.;
     
-    const CFuint nbFacesInCell = cell.getNbActiveFacesInCell();
-    const CFuint nbRows = nbFacesInCell + 1;
-    const CFuint bStartCellID = blockStart[cellID];
-        
-    // this block accumulator represents a column block (nbFaces+1 x 1)
-    BlockAccumulatorBaseCUDA acc(nbRows, 1, PHYS::NBEQS, &blockJacob[bStartCellID]);
-    acc.reset();
+#ifdef CF_HAVE_OMP
+#pragma omp master
+#endif
+    {
+      // printLimiter<PHYS::NBEQS>(limiter, nbCells);
+      CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::computeFluxJacobianCPU() => computing limiter took " << timer.read() << " s\n");
+      timer.restart();
+    }
     
-    for (CFuint f = 0; f < nbFacesInCell; ++f) { 
-      const CFint stype = cell.getNeighborType(f);
-      if (stype != 0) { // skip all partition faces
-	const CFuint stateID =  cell.getNeighborID(f);
-	setFluxData(f, stype, stateID, cellID, &kd, currFd, cellFaces);
-	
-	// compute face quadrature points (centroid)
-	CFreal* faceCenters = &midFaceCoord[f*PHYS::DIM];
-	computeFaceCentroid<PHYS>(&cell, f, nodes, faceCenters);
-	
-	// extrapolate solution on quadrature points on both sides of the face
-	polyRec.extrapolateOnFace(currFd, faceCenters, uX, uY, uZ, limiter);
-		
-	/*if (cellID == 0) {    
-	  FluxData<PHYS>* data = currFd; 
-	  PHYS* model = &pmodel;
-	  CudaEnv::CFVec<CFreal,PHYS::NBEQS> m_tmp;
-	  CudaEnv::CFVec<CFreal,PHYS::NBEQS> m_tmp2;
-	  CudaEnv::CFVec<CFreal,PHYS::NBEQS> m_sumFlux;
-	  CudaEnv::CFVec<CFreal,PHYS::DATASIZE> m_pdata;
-	  CudaEnv::CFVec<CFreal,PHYS::DIM> m_tempUnitNormal;
-	  CudaEnv::CFVecSlice<CFreal,PHYS::DIM> unitNormal(data->getUnitNormal());
-	  const CFreal coeff = (data->isOutward()) ? 1. : -1.;
-	  m_tempUnitNormal = coeff*unitNormal;
-	  CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> flux(data->getResidual());
-	  typename PHYS::UPDATE_VS* updateVS = model->getUpdateVS();
-	  
-	  updateVS->computePhysicalData(data->getRstate(1), data->getNode(1), &m_pdata[0]);
-	  updateVS->getFlux(&m_pdata[0], &m_tempUnitNormal[0], &m_tmp[0]);
-	  flux = 0.5*m_tmp;
-	  
-	  updateVS->computeEigenValues(&m_pdata[0], &m_tempUnitNormal[0], &m_tmp[0]);
-	  
-	  std::cout << std::endl << "stateIDs [" << cellID << "," << stateID << "]" << std::endl;
-	  // std::cout.precision(12); std::cout << "centerNodes[0]    = "; printArray<CFreal,PHYS::DIM>(&centerNodes[cellID*PHYS::DIM]);
-	  
-	  std::cout.precision(12);std::cout << "dataR   = "; printArray<CFreal,PHYS::DATASIZE>(&m_pdata[0]);
-	  // std::cout.precision(12);std::cout << "eigenR  = "; printArray<CFreal,PHYS::NBEQS>(&m_tmp[0]);
-	  std::cout.precision(12);std::cout << "normalR = "; printArray<CFreal,PHYS::DIM>(&m_tempUnitNormal[0]);
-	  
-	  CFreal aR = 0.0;
-	  for (CFuint i = 0; i < PHYS::NBEQS; ++i) {
-	    aR = max(aR, abs(m_tmp[i]));
-	  }
-	  
-	  // left physical data, flux and eigenvalues
-	  updateVS->computePhysicalData(data->getRstate(0), data->getNode(0), &m_pdata[0]);
-	  updateVS->getFlux(&m_pdata[0], &m_tempUnitNormal[0], &m_tmp[0]);
-	  flux += 0.5*m_tmp;
+    // compute the fluxes and the jacobian
+#ifdef CF_HAVE_OMP
+#pragma omp for schedule(static)
+#endif
+    for (CFint iCell = 0; iCell < (CFint)nbCells; ++iCell) {
+      const CFuint cellID = iCell;
+      CellData::Itr cell = cells.getItr(cellID);
+      
+      // reset the rhs and update coefficients to 0
+      CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> res(&rhs[cellID*PHYS::NBEQS]);
+      res = 0.;
+      updateCoeff[cellID] = 0.;
+      
+      const CFuint nbFacesInCell = cell.getNbActiveFacesInCell();
+      const CFuint nbRows = nbFacesInCell + 1;
+      const CFuint bStartCellID = blockStart[cellID];
+      
+      // this block accumulator represents a column block (nbFaces+1 x 1)
+      BlockAccumulatorBaseCUDA acc(nbRows, 1, PHYS::NBEQS, &blockJacob[bStartCellID]);
+      acc.reset();
+      
+      for (CFuint f = 0; f < nbFacesInCell; ++f) { 
+	const CFint stype = cell.getNeighborType(f);
+	if (stype != 0) { // skip all partition faces
+	  const CFuint stateID =  cell.getNeighborID(f);
+	  setFluxData(f, stype, stateID, cellID, &kd, currFd, cellFaces);
 	  
-	  updateVS->computeEigenValues(&m_pdata[0], &m_tempUnitNormal[0], &m_tmp[0]);
-	  std::cout.precision(12);std::cout << "dataL   = "; printArray<CFreal,PHYS::DATASIZE>(&m_pdata[0]);
-	  // std::cout.precision(12);std::cout << "eigenL  = "; printArray<CFreal,PHYS::NBEQS>(&m_tmp[0]);
-	  std::cout.precision(12);std::cout << "normalL = "; printArray<CFreal,PHYS::DIM>(&m_tempUnitNormal[0]);
+	  // compute face quadrature points (centroid)
+	  CFreal* faceCenters = &midFaceCoord[f*PHYS::DIM];
+	  computeFaceCentroid<PHYS>(&cell, f, nodes, faceCenters);
 	  
-	  // compute update coefficient
-	  if (!data->isPerturb()) {    
-	    const CFreal k = max(m_tmp.max(), 0.)*data->getFaceArea();
-	    std::cout << "lambda = " << max(m_tmp.max(), 0.) << ", area =" << data->getFaceArea() << std::endl;
-	    std::cout << "updateCoeff [" <<cellID << "] = " << k << std::endl;
-	    // data->setUpdateCoeff(k);
-	    //abort();
-	  }
+	  // extrapolate solution on quadrature points on both sides of the face
+	  polyRec.extrapolateOnFace(currFd, faceCenters, uX, uY, uZ, limiter);
+	  fluxScheme(currFd, &pmodel); // compute the convective flux across the face
 	  
-	  CFreal aL = 0.0;
-	  for (CFuint i = 0; i < PHYS::NBEQS; ++i) {
-	    aL = max(aL, abs(m_tmp[i]));
+	  for (CFuint iEq = 0; iEq < PHYS::NBEQS; ++iEq) {
+	    const CFreal value = currFd->getResidual()[iEq];
+	    res[iEq]   -= value;  // update the residual 
+	    resBkp[iEq] = value;  // backup the current face-based residual
 	  }
 	  
-	  const CFreal a = (aR > aL) ? aR : aL; // max(aR,aL);
-	  const CFreal aDiff = a*dcof->currentDiffRedCoeff;
-	  
-	  Framework::VarSetTransformerT<typename PHYS::UPDATE_VS, typename PHYS::SOLUTION_VS, NOTYPE>* up2Sol = 
-	    model->getUpdateToSolution();
-	  
-	  // transform to solution variables
-	  up2Sol->transform(data->getRstate(LEFT), &m_tmp[0]);
-	  up2Sol->transform(data->getRstate(RIGHT), &m_tmp2[0]);
-	  
-	  CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> stateL(&m_tmp[0]);
-	  CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> stateR(&m_tmp2[0]);
-	  
-	  m_sumFlux = 2.*flux;
-	  
-	  std::cout.precision(12);;std::cout << "UR       = ";printArray<CFreal,PHYS::NBEQS>(&stateR[0]);
-	  std::cout.precision(12);;std::cout << "UL       = ";printArray<CFreal,PHYS::NBEQS>(&stateL[0]);
-	  std::cout.precision(12);;std::cout << "_sumFlux = ";printArray<CFreal,PHYS::NBEQS>(&m_sumFlux[0]);
-	  std::cout.precision(12);;std::cout << "aDiff    = " << aDiff << std::endl;
-	  
-	  flux -= (0.5*aDiff)*(stateR - stateL);
+	  // update the update coefficient
+	  updateCoeff[cellID] += currFd->getUpdateCoeff();
 	  
-	  
-	  // // NOTE THE AREA HERE !!!!!!!!!!!!!!!!
-	  // flux *= data->getFaceArea();
-	  }*/
-
-	
-	////////
-	
-
-       
-	fluxScheme(currFd, &pmodel); // compute the convective flux across the face
-        
-
-	for (CFuint iEq = 0; iEq < PHYS::NBEQS; ++iEq) {
-	  const CFreal value = currFd->getResidual()[iEq];
-	  res[iEq]   -= value;  // update the residual 
-	  resBkp[iEq] = value;  // backup the current face-based residual
-	}
-	
-	// update the update coefficient
-	updateCoeff[cellID] += currFd->getUpdateCoeff();
-	
-	// only contribution from internal faces is computed here  
-	if (stype > 0) { 
-	  currFd->setIsPerturb(true);
-	  
-	  // flux jacobian computation
-	  for (CFuint iVar = 0; iVar < PHYS::NBEQS; ++iVar) {
-	    // here we perturb the current variable for the left cell state
-	    numJacob.perturb(iVar, &currFd->getState(LEFT)[iVar]);
+	  // only contribution from internal faces is computed here  
+	  if (stype > 0) { 
+	    currFd->setIsPerturb(true);
 	    
-	    // extrapolate solution on quadrature points on both sides of the face
-	    const CFreal rstateBkpL = currFd->getRstate(LEFT)[iVar];
-	    polyRec.extrapolateOnFace(iVar, currFd, faceCenters, uX, uY, uZ, limiter);
-	    fluxScheme(currFd, &pmodel); // compute the convective flux across the face
-	    
-	    // compute the numerical jacobian of the flux
-	    CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> resPert(currFd->getResidual());
-	    numJacob.computeDerivative(&resBkp, &resPert, &fluxDiff);
-	    
-	    
-	    
-	    ///
-	    /*if (cellID == 0 && stateID == 1 && iVar == 0) {
-	      cout << "\n left 0, right 1 \n";
-	      cout << iVar << " => resBkp   = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&resBkp[0]);
-	      cout << iVar << " => resPert  = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&resPert[0]);
-	      cout << iVar << " => fluxDiff = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&fluxDiff[0]);
+	    // flux jacobian computation
+	    for (CFuint iVar = 0; iVar < PHYS::NBEQS; ++iVar) {
+	      // here we perturb the current variable for the left cell state
+	      numJacob.perturb(iVar, &currFd->getState(LEFT)[iVar]);
+	      
+	      // extrapolate solution on quadrature points on both sides of the face
+	      const CFreal rstateBkpL = currFd->getRstate(LEFT)[iVar];
+	      polyRec.extrapolateOnFace(iVar, currFd, faceCenters, uX, uY, uZ, limiter);
+	      fluxScheme(currFd, &pmodel); // compute the convective flux across the face
+	      
+	      // compute the numerical jacobian of the flux
+	      CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> resPert(currFd->getResidual());
+	      numJacob.computeDerivative(&resBkp, &resPert, &fluxDiff);
+	      
+	      // flux is computed with the outward normal, so the sign is correct here
+	      // contribution to the row corresponding of the current cell
+	      // this subblock gets all contributions from all face cells
+	      acc.addValues(0, 0, iVar, &fluxDiff[0]);
+	      
+	      // contribution to row corresponding to the f+1 cell: 
+	      // this is the flux jacobian contribution for the neighbor cells
+	      // due to the currently perturbed cell state and is opposite in sign
+	      // because the outward normal for neighbors is inward for the current cell
+	      fluxDiff *= -1.0;
+	      acc.addValues(f+1, 0, iVar, &fluxDiff[0]);   
+	      
+	      // restore perturbed states
+	      currFd->getRstate(LEFT)[iVar] = rstateBkpL;
+	      numJacob.restore(&currFd->getState(LEFT)[iVar]);
 	    }
 	    
-	    if (stateID == 0 && cellID == 1 && iVar == 0) {
-	      cout << "\n left 1, right 0 \n";
-	      cout << iVar << " => resBkp   = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&resBkp[0]);
-	      cout << iVar << " => resPert  = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&resPert[0]);
-	      cout << iVar << " => fluxDiff = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&fluxDiff[0]);
-	      }*/
-	    ///
-	    
-	    
-	    
-	    // flux is computed with the outward normal, so the sign is correct here
-	    // contribution to the row corresponding of the current cell
-	    // this subblock gets all contributions from all face cells
-	    acc.addValues(0, 0, iVar, &fluxDiff[0]);
-	    
-	    // contribution to row corresponding to the f+1 cell: 
-	    // this is the flux jacobian contribution for the neighbor cells
-	    // due to the currently perturbed cell state and is opposite in sign
-	    // because the outward normal for neighbors is inward for the current cell
-	    fluxDiff *= -1.0;
-	    
-	    
-	    ///
-	    /* if (cellID == 0 && stateID == 1 && iVar == 0) {
-	      cout << "\n left 0, right 1 \n";
-	      cout << iVar << " => resBkp   = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&resBkp[0]);
-	      cout << iVar << " => resPert  = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&resPert[0]);
-	      cout << iVar << " => fluxDiff = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&fluxDiff[0]);
-	    }
-	    
-	    if (stateID == 0 && cellID == 1 && iVar == 0) {
-	      cout << "\n left 1, right 0 \n";
-	      cout << iVar << " => resBkp   = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&resBkp[0]);
-	      cout << iVar << " => resPert  = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&resPert[0]);
-	      cout << iVar << " => fluxDiff = "; std::cout.precision(12);printArray<CFreal,PHYS::NBEQS>(&fluxDiff[0]);
-	      }*/
-	    ///
-	    
-	    
-	    acc.addValues(f+1, 0, iVar, &fluxDiff[0]);   
-	    
-	    // restore perturbed states
-	    currFd->getRstate(LEFT)[iVar] = rstateBkpL;
-	    numJacob.restore(&currFd->getState(LEFT)[iVar]);
+	    currFd->setIsPerturb(false);
 	  }
-	  	  
-	  currFd->setIsPerturb(false);
 	}
-
       }
-    }
-    //if (abs(res[6]) <= 1e-3){res[6] = 0.0;} 
-  } 
+    } 
+  }
   
-  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::computeFluxJacobianCPU() took " << timer.elapsed() << " s\n");
+  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::computeFluxJacobianCPU() => computing fluxes and jacobian took " << timer.read() << " s\n");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -792,14 +704,17 @@ void FVMCC_ComputeRhsJacobCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>:
   SafePtr<typename PHYSICS::PTERM> phys = PhysicalModelStack::getActive()->getImplementor()->
     getConvectiveTerm().d_castTo<typename PHYSICS::PTERM>();
   
+#ifdef CF_HAVE_CUDA
   typedef typename SCHEME::template  DeviceFunc<GPU, PHYSICS> FluxScheme;  
+#else
+  typedef typename SCHEME::template  DeviceFunc<CPU, PHYSICS> FluxScheme;  
+#endif
   typedef typename POLYREC::template DeviceFunc<PHYSICS> PolyRec;  
   typedef typename LIMITER::template DeviceFunc<PHYSICS> Limiter;  
   
-  CudaEnv::CudaTimer& timer = CudaEnv::CudaTimer::getInstance();
-  
   if (this->m_onGPU) {
-    
+#ifdef CF_HAVE_CUDA
+    CudaEnv::CudaTimer& timer = CudaEnv::CudaTimer::getInstance();
     timer.start();
     // copy of data that change at every iteration
     this->socket_states.getDataHandle().getGlobalArray()->put(); 
@@ -940,6 +855,7 @@ void FVMCC_ComputeRhsJacobCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>:
     updateCoeff.getLocalArray()->get();
 
     CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::execute() => GPU-->CPU data transfer took " << timer.elapsed() << " s\n");
+#endif
   }
   else {
     ConfigOptionPtr<SCHEME>  dcof(lf);
@@ -949,7 +865,8 @@ void FVMCC_ComputeRhsJacobCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>:
     ConfigOptionPtr<typename PHYSICS::PTERM> dcop(phys);
 
     computeFluxJacobianCPU<FluxScheme, PolyRec, Limiter>
-      (dcof.getPtr(),
+      (this->m_nbThreadsOMP,
+       dcof.getPtr(),
        dcor.getPtr(),
        dcol.getPtr(),
        dcon.getPtr(),
@@ -957,11 +874,12 @@ void FVMCC_ComputeRhsJacobCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>:
        nbCells,
        this->socket_states.getDataHandle().getGlobalArray()->ptr(), 
        this->socket_nodes.getDataHandle().getGlobalArray()->ptr(),
-       this->m_centerNodes.ptr(), 
-       this->m_ghostStates.ptr(),
-       this->m_ghostNodes.ptr(),
-       m_blockJacobians.ptr(), 
-       m_blockStart.ptr(),
+       &this->m_centerNodes[0], 
+       // a partition without boundary faces has no ghost states
+       (this->m_ghostStates.size() > 0) ? &this->m_ghostStates[0] : CFNULL,
+       (this->m_ghostNodes.size() > 0) ? &this->m_ghostNodes[0] : CFNULL,
+       &m_blockJacobians[0], 
+       &m_blockStart[0],
        this->socket_uX.getDataHandle().getLocalArray()->ptr(),
        this->socket_uY.getDataHandle().getLocalArray()->ptr(),
        this->socket_uZ.getDataHandle().getLocalArray()->ptr(),
@@ -970,23 +888,25 @@ void FVMCC_ComputeRhsJacobCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>:
        rhs.getLocalArray()->ptr(),
        normals.getLocalArray()->ptr(),
        isOutward.getLocalArray()->ptr(),
-       this->m_cellInfo.ptr(),
-       this->m_cellStencil.ptr(),
-       this->m_cellFaces->getPtr()->ptr(),
-       this->m_cellNodes->getPtr()->ptr(),
-       this->m_neighborTypes.ptr(),
-       this->m_cellConn.ptr());
+       &this->m_cellInfo[0],
+       &this->m_cellStencil[0],
+       &(*this->m_cellFaces->getPtr())[0],
+       &(*this->m_cellNodes->getPtr())[0],
+       &this->m_neighborTypes[0],
+       &this->m_cellConn[0]);
     
     // update the system matrix
+    Stopwatch<WallTime> timer;
     timer.start();
     updateSystemMatrix(0);
-    CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::execute() => updateSystemMatrix took " << timer.elapsed() << " s\n");
+    CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::execute() => updateSystemMatrix took " << timer.read() << " s\n");
   }
   
+  Stopwatch<WallTime> timer;
   timer.start();
   // compute flux jacobians on boundaries
   executeBC();
-  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::execute() => executeBC() took " << timer.elapsed() << " s\n");
+  CFLog(VERBOSE, "FVMCC_ComputeRhsJacobCell::execute() => executeBC() took " << timer.read() << " s\n");
 
   finalizeComputationRHS();
   
@@ -58,6 +58,11 @@ public:
    * Execute Processing actions
    */
   virtual void execute();
+
+  /**
+   * The fluxes are computed only once all the ghost states are synchronized
+   */
+  virtual bool canOverlapSync() const {return false;}
       
 protected:
   
@@ -82,7 +87,7 @@ protected:
   Common::SafePtr<Framework::LinearSystemSolver> m_lss;
   
   /// storage of the block jacobian matrices
-  CudaEnv::CudaVector<CFuint, CudaEnv::MallocHostAlloc<CFuint> > m_blockStart;
+  Framework::LocalArray<CFuint>::MALLOC_TYPE m_blockStart;
   
   /// number of cells per set (=block of cells to compute on device at once)  
   std::vector<CFuint> m_nbCellsInKernel;
@@ -94,7 +99,7 @@ protected:
   std::vector<CFuint> m_blockStartKernelCellID;
   
   /// storage of the block jacobian matrices
-  CudaEnv::CudaVector<CFreal> m_blockJacobians;
+  Framework::LocalArray<CFreal>::TYPE m_blockJacobians;
   
   /// pointer to the linear system solver
   Common::SafePtr<Framework::NumericalJacobian> _numericalJacob;
@@ -70,6 +70,11 @@ public:
    * Execute Processing actions
    */
   virtual void execute();
+
+  /**
+   * The fluxes are computed only once all the ghost states are synchronized
+   */
+  virtual bool canOverlapSync() const {return false;}
       
   /**
    * Returns the DataSocket's that this command needs as sinks
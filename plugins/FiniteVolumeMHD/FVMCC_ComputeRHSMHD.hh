@@ -68,6 +68,12 @@ public:
    */
   void computeDivBNodalValues(RealVector& divB);
   
+  /**
+   * The synchronization is completed before execute(), since
+   * initializeComputationRHS() uses all the states
+   */
+  virtual bool canOverlapSync() const {return false;}
+  
   /**
    * Returns the DataSocket's that this command provides as sources
    * @return a vector of SafePtr with the DataSockets
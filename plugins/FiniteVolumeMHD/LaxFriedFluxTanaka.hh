@@ -29,7 +29,7 @@ template <typename UPDATEVAR>
 class LaxFriedFluxTanaka : public LaxFriedFlux {
 public:
   
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
   /// nested class defining a functor
   template <DeviceType DT, typename VS>
   class DeviceFunc {
@@ -58,7 +58,7 @@ public:
       updateVS->computeEigenValues(&m_pdata[0], &m_tempUnitNormal[0], &m_tmp[0]);
       CFreal aR = 0.0;
       for (CFuint i = 0; i < VS::NBEQS; ++i) {
-    	aR = max(aR, abs(m_tmp[i]));
+    	aR = fmax(aR, abs(m_tmp[i]));
       }
       
       // left physical data, flux and eigenvalues
@@ -70,13 +70,13 @@ public:
       
       // compute update coefficient
       if (!data->isPerturb()) {    
-    	const CFreal k = max(m_tmp.max(), 0.)*data->getFaceArea();
+    	const CFreal k = fmax(m_tmp.max(), 0.)*data->getFaceArea();
     	data->setUpdateCoeff(k);
       }
       
       CFreal aL = 0.0;
       for (CFuint i = 0; i < VS::NBEQS; ++i) {
-    	aL = max(aL, abs(m_tmp[i]));
+    	aL = fmax(aL, abs(m_tmp[i]));
       }
       
       const CFreal a = fmax(aR,aL);
@@ -131,6 +131,11 @@ public:
    */
   virtual void compute(RealVector& result);
   
+  /**
+   * The Tanaka correction is not computed by computeThreadedFlux()
+   */
+  virtual bool isThreadSafe() const {return false;}
+  
 private:
   
   /// acquaintance of the concrete variable set
@@ -9,6 +9,8 @@
 
 #ifdef CF_HAVE_CUDA
 #include "Common/CUDA/CudaEnv.hh"
+#endif
+#ifdef CF_HAVE_DEVICE_KERNELS
 #include "Framework/MathTypes.hh"
 #include "Framework/VarSetTransformerT.hh"
 #include "FiniteVolume/FluxData.hh"
@@ -36,7 +38,7 @@ class StegerWarmingMaxwellProjection2D : public FVMCC_FluxSplitter {
 public:
   
 //New code
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
   
   /// nested class defining local options
   template <typename P = NOTYPE>
@@ -84,10 +86,12 @@ public:
 
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
   }  
+#endif
   
   /// copy the local configuration options to the device
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -234,7 +238,7 @@ protected:
 
 
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
 
 template <class UPDATEVAR>
 template <DeviceType DT, typename VS>
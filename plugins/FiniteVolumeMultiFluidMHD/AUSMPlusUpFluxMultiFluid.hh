@@ -10,6 +10,8 @@
 
 #ifdef CF_HAVE_CUDA
 #include "Common/CUDA/CudaEnv.hh"
+#endif
+#ifdef CF_HAVE_DEVICE_KERNELS
 #include "Framework/MathTypes.hh"
 #include "Framework/VarSetTransformerT.hh"
 #include "FiniteVolume/FluxData.hh"
@@ -38,7 +40,7 @@ public:
 
 
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
   /// nested class defining local options
   template <typename P = NOTYPE>
   class DeviceConfigOptions {
@@ -132,6 +134,7 @@ public:
 
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the device
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
@@ -170,6 +173,7 @@ public:
 
     CFLog(VERBOSE, "AUSMPlusUpFluxMultiFluid::copyConfigOptionsToDevice END \n \n");
   }  
+#endif
   
 
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -285,7 +289,7 @@ private:
 
 //////////////////////////////////////////////////////////////////////////////
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
 /// functor that computes the flux
 template <class UPDATEVAR>
 template <DeviceType DT, typename VS>
@@ -964,7 +968,7 @@ HOST_DEVICE void AUSMPlusUpFluxMultiFluid<UPDATEVAR>::DeviceFunc<DT, VS>::operat
 }
 
 
-#endif //CF_HAVE_CUDA
+#endif //CF_HAVE_DEVICE_KERNELS
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -94,6 +94,8 @@
 
 #ifdef CF_HAVE_CUDA
 #include "Common/CUDA/CudaEnv.hh"
+#endif
+#ifdef CF_HAVE_DEVICE_KERNELS
 #include "Framework/MathTypes.hh"
 #include "Framework/VarSetTransformerT.hh"
 #include "FiniteVolume/FluxData.hh"
@@ -126,7 +128,7 @@ class DriftWaves2DHalfTwoFluid : public ComputeSourceTermFVMCC {
 
 public:
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
 
   /// nested class defining local options
   template <typename P = NOTYPE>
@@ -176,6 +178,7 @@ public:
 
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the device
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
@@ -194,6 +197,7 @@ public:
 
     CFLog(VERBOSE, "DriftWaves2DHalfTwoFluid::copyConfigOptionsToDevice END \n \n");
   }  
+#endif
   
   /// copy the local configuration options to the device
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -322,7 +326,7 @@ private:
 
 //////////////////////////////////////////////////////////////////////////////
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
 
 template <class UPDATEVAR>
 template <DeviceType DT, typename VS>
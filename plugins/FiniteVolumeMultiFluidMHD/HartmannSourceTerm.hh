@@ -10,6 +10,8 @@
 
 #ifdef CF_HAVE_CUDA
 #include "Common/CUDA/CudaEnv.hh"
+#endif
+#ifdef CF_HAVE_DEVICE_KERNELS
 #include "Framework/MathTypes.hh"
 #include "Framework/VarSetTransformerT.hh"
 #include "FiniteVolume/FluxData.hh"
@@ -43,7 +45,7 @@ class HartmannSourceTerm : public ComputeSourceTermFVMCC {
 public:
 
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
 
   /// nested class defining local options
   template <typename P = NOTYPE>
@@ -94,6 +96,7 @@ public:
 
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the device
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
@@ -112,6 +115,7 @@ public:
 
     CFLog(NOTICE, "HartmannSourceTerm::copyConfigOptionsToDevice END \n \n");
   }  
+#endif
   
   /// copy the local configuration options to the device
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -258,7 +262,7 @@ private:
 
 //////////////////////////////////////////////////////////////////////////////
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
 
 template <class UPDATEVAR>
 template <DeviceType DT, typename VS>
@@ -40,6 +40,11 @@ public:
    */
   virtual void setup();
   
+  /**
+   * The reduction coefficient of this class is not used by computeThreadedFlux()
+   */
+  virtual bool isThreadSafe() const {return false;}
+  
   /**
    * Defines the Config Option's of this class
    * @param options a OptionList where to add the Option's
@@ -57,7 +57,9 @@ ComputeRHS::ComputeRHS(const std::string& name) :
   _fsStrategy(CFNULL),
   _adStrategy(CFNULL),
   _hasDiffusiveTerm(false),
-  _hasArtDiffusiveTerm(false)
+  _hasArtDiffusiveTerm(false),
+  _cellsOrder(),
+  _isInnerCell()
 {
   addConfigOptionsTo(this);
 
@@ -167,6 +169,53 @@ void ComputeRHS::setup()
 
   // flag telling if a artificial diffusive term has to be computed
   _hasArtDiffusiveTerm = !(_adStrategy->isNull());
+
+  // the cells are ordered again if the mesh changes
+  _cellsOrder.clear();
+  _isInnerCell.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ComputeRHS::computeCellsOrder()
+{
+  DataHandle<State*,GLOBAL> states = socket_states.getDataHandle();
+  SafePtr<TopologicalRegionSet> cells = getCurrentTRS();
+  SafePtr<vector<ElementTypeData> > elementType =
+    MeshDataStack::getActive()->getElementTypeData();
+
+  const CFuint nbCells = cells->getLocalNbGeoEnts();
+  _isInnerCell.resize(nbCells);
+  for (CFuint iCell = 0; iCell < nbCells; ++iCell) {
+    bool isInner = true;
+    const CFuint nbStatesInCell = cells->getNbStatesInGeo(iCell);
+    for (CFuint iState = 0; iState < nbStatesInCell && isInner; ++iState) {
+      isInner = states[cells->getStateID(iCell,iState)]->isParUpdatable();
+    }
+    _isInnerCell[iCell] = isInner;
+  }
+
+  // cells of the same type stay contiguous
+  _cellsOrder.clear();
+  _cellsOrder.reserve(nbCells);
+  CFuint nbInnerCells = 0;
+  for (CFuint iType = 0; iType < elementType->size(); ++iType) {
+    const CFuint start = (*elementType)[iType].getStartIdx();
+    const CFuint end   = (*elementType)[iType].getEndIdx();
+    for (CFuint iCell = start; iCell < end; ++iCell) {
+      if (_isInnerCell[iCell]) {
+	_cellsOrder.push_back(iCell);
+	nbInnerCells++;
+      }
+    }
+    for (CFuint iCell = start; iCell < end; ++iCell) {
+      if (!_isInnerCell[iCell]) _cellsOrder.push_back(iCell);
+    }
+  }
+  cf_assert(_cellsOrder.size() == nbCells);
+
+  CFLog(VERBOSE, "ComputeRHS::computeCellsOrder() => " << nbInnerCells
+	<< " inner cells out of " << nbCells << "\n");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -210,11 +259,23 @@ void ComputeRHS::executeOnTrs()
   DistributionData& ddata = getMethodData().getDistributionData();
   cf_assert( _fsStrategy.isNotNull() ); // certify that the split strategy is not null
 
+  // if the states are still being synchronized, the cells involving
+  // only updatable states are processed first
+  const bool overlapSync = ss.isSyncPending();
+  if (overlapSync && _cellsOrder.size() == 0) {
+    computeCellsOrder();
+  }
+
   // LOOP on Geometric Entities (elements)
-  for (CFuint cellID = 0; cellID < nbGeos; ++cellID)
+  for (CFuint iCell = 0; iCell < nbGeos; ++iCell)
   {
+    const CFuint cellID = (overlapSync) ? _cellsOrder[iCell] : iCell;
 //     CFout << "+++  Cell [" << cellID << "]\n";
 
+    if (overlapSync && !_isInnerCell[cellID]) {
+      ss.endSync();
+    }
+
     // build the GeometricEntity
     geoData.idx = cellID;
     GeometricEntity& cell = *geoBuilder->buildGE();
@@ -281,6 +342,11 @@ void ComputeRHS::executeOnTrs()
     geoBuilder->releaseGE();
   }
 
+  // complete the synchronization if all the cells were inner
+  if (overlapSync) {
+    ss.endSync();
+  }
+
   // transform the residual from the solution variables
   // to the update variables if needed
   if (getMethodData().isResidualTransformationNeeded()) {
@@ -47,11 +47,20 @@ public:
   /// @return a vector of SafePtr with the DataSockets
   virtual std::vector<Common::SafePtr<Framework::BaseDataSocketSink> > needsSockets();
 
+  /// Tells if the cells not involving any ghost state of the partition can be
+  /// processed while the synchronization of the states is still in progress.
+  /// Subclasses overriding executeOnTrs() must override this too.
+  virtual bool canOverlapSync() const {return true;}
+
 protected: // methods
 
   /// Execute the command on the current TRS
   virtual void executeOnTrs();
 
+  /// Order the cells of each element type so that the ones whose states are all
+  /// updatable come first, followed by the ones involving ghost states of the partition
+  void computeCellsOrder();
+
   /// Cleans the rhs setting it to zero
   virtual void cleanRHS();
 
@@ -133,6 +142,12 @@ protected: // data
   /// while doing numerical perturbation of the jacobians
   bool _freezeDiffCoeff;
 
+  /// order in which the cells are processed while the states are synchronized
+  std::vector<CFuint> _cellsOrder;
+
+  /// flags telling if each cell involves only updatable states
+  std::vector<bool> _isInnerCell;
+
 }; // class ComputeRHS
 
 //////////////////////////////////////////////////////////////////////////////
@@ -84,6 +84,15 @@ void ComputeRhsJacob::executeOnTrs()
   SafePtr<Framework::ConvergenceMethodData>  cvmthdata = cvmth->getConvergenceMethodData();
   distdata.subiter =  cvmthdata->getConvergenceStatus().subiter;
   SafePtr<DiffusiveVarSet> diffVar = fsmdata.getDiffusiveVar();
+  
+  // if the states are still being synchronized, the cells involving
+  // only updatable states are processed first
+  DataHandle<State*,GLOBAL> ss = socket_states.getDataHandle();
+  const bool overlapSync = ss.isSyncPending();
+  if (overlapSync && _cellsOrder.size() == 0) {
+    computeCellsOrder();
+  }
+  
   CFuint nbcell=0;
   // loop over element/cell types
   for (CFuint iType = 0; iType < nbElemTypes; ++iType)
@@ -105,12 +114,17 @@ void ComputeRhsJacob::executeOnTrs()
     {
       CFLogDebugMed( "Computing iCell = " << iCell << "/" << nbCellsPerType << "\n");
 
+      const CFuint cellID = (overlapSync) ? _cellsOrder[iCell+nbcell] : iCell+nbcell;
+      if (overlapSync && !_isInnerCell[cellID]) {
+	ss.endSync();
+      }
+      
       // build the GeometricEntity
-      geoData.idx = iCell+nbcell;
+      geoData.idx = cellID;
       GeometricEntity& cell = *geoBuilder->buildGE();
       vector<State*> *const states = cell.getStates();
 
-      cf_assert(cell.getID() == iCell);
+      cf_assert(cell.getID() == cellID);
 
       distdata.cell   = &cell;
       distdata.cellID = cell.getID();
@@ -189,6 +203,11 @@ void ComputeRhsJacob::executeOnTrs()
     } // end loop over cells in Type
     nbcell+=nbCellsPerType;
   } // end loop over CellTypes
+  
+  // complete the synchronization if all the cells were inner
+  if (overlapSync) {
+    ss.endSync();
+  }
 
   // for safety reset the transport properties freezing to false
   diffVar->setFreezeCoeff(false);
@@ -36,6 +36,9 @@ public:
   /// in this command before processing phase
   virtual void setup();
 
+  /// The cells are processed only once all the states are synchronized
+  virtual bool canOverlapSync() const {return false;}
+
 protected: // functions
 
   /// Execute the command on the current TRS
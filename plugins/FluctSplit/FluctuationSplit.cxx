@@ -10,6 +10,7 @@
 #include "FluctSplit/FluctSplit.hh"
 #include "FluctSplit/ArtificialDiffusionStrategy.hh"
 #include "FluctSplit/FluctuationSplitData.hh"
+#include "FluctSplit/ComputeRHS.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -409,6 +410,17 @@ void FluctuationSplit::prepareComputationImpl()
 
 //////////////////////////////////////////////////////////////////////////////
 
+bool FluctuationSplit::canOverlapSync() const
+{
+  // the BCs are applied after the residual computation, which completes
+  // the synchronization of the states
+  if (_computeSpaceRHS.isNull()) return false;
+  ComputeRHS *const rhs = dynamic_cast<ComputeRHS*>(_computeSpaceRHS.getPtr());
+  return (rhs != CFNULL) && rhs->canOverlapSync();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void FluctuationSplit::setMethodImpl()
 {
   CFAUTOTRACE;
@@ -44,6 +44,9 @@ public:
     interRhs = 0.0;
   }
 
+  /// The cells are processed only once all the states are synchronized
+  virtual bool canOverlapSync() const {return false;}
+
 protected: // functions
 
   /// Execute the command on the current TRS
@@ -77,9 +77,18 @@ ConvRHSFluxReconstruction::ConvRHSFluxReconstruction(const std::string& name) :
   m_cellFluxProjVects(),
   m_flxPntCoords(),
   m_waveSpeedUpd(),
-  m_faceLocalDir()
+  m_faceLocalDir(),
+  m_solPolyValsAtFlxPnts(),
+  m_solPolyDerivAtSolPnts(),
+  m_tpKernels(),
+  m_useTPKernels(false),
+  m_elemBatch(),
+  m_batchStateIDs()
   {
     addConfigOptionsTo(this);
+    
+    m_elemBatchSize = 1;
+    setParameter("ElemBatchSize",&m_elemBatchSize);
   }
   
   
@@ -87,6 +96,7 @@ ConvRHSFluxReconstruction::ConvRHSFluxReconstruction(const std::string& name) :
 
 void ConvRHSFluxReconstruction::defineConfigOptions(Config::OptionList& options)
 {
+  options.addConfigOption< CFuint >("ElemBatchSize","Number of cells whose residual updates are computed together (1 means cell by cell).");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -296,6 +306,13 @@ void ConvRHSFluxReconstruction::execute()
     
     // get the face - flx pnt connectivity per orient
     m_faceFlxPntConn = frLocalData[m_iElemType]->getFaceFlxPntConn();
+    
+    // compute the residual updates on batches of cells
+    if (m_elemBatchSize > 1)
+    {
+      computeResUpdatesInBatches(startIdx, endIdx);
+      continue;
+    }
 
     // loop over cells
     for (CFuint elemIdx = startIdx; elemIdx < endIdx; ++elemIdx)
@@ -410,10 +427,36 @@ void ConvRHSFluxReconstruction::setFaceData(CFuint faceID)
     
   // get number of flux points in 1D
   const CFuint nbrFlxPnt1D = (frLocalData[0]->getFlxPntsLocalCoord1D())->size();
-
-  // get solution polynomial values at nodes
-  vector< vector< CFreal > > solPolyValsAtNodes
-       = frLocalData[0]->getSolPolyValsAtNode(*m_flxPntsLocalCoords);
+  
+  // extrapolate the states to the flux points of the face
+  if (m_useTPKernels)
+  {
+    m_tpKernels.extrapolateToFlxPnts(*(m_states[LEFT]), (*m_faceFlxPntConnPerOrient)[m_orient][LEFT],
+                                     m_cellStatesFlxPnt[LEFT]);
+    m_tpKernels.extrapolateToFlxPnts(*(m_states[RIGHT]), (*m_faceFlxPntConnPerOrient)[m_orient][RIGHT],
+                                     m_cellStatesFlxPnt[RIGHT]);
+  }
+  else
+  {
+    for (CFuint iFlxPnt = 0; iFlxPnt < nbrFlxPnt1D; ++iFlxPnt)
+    {
+      // local flux point indices in the left and right cell
+      const CFuint flxPntIdxL = (*m_faceFlxPntConnPerOrient)[m_orient][LEFT][iFlxPnt];
+      const CFuint flxPntIdxR = (*m_faceFlxPntConnPerOrient)[m_orient][RIGHT][iFlxPnt];
+      
+      RealVector& stateL = *(m_cellStatesFlxPnt[LEFT][iFlxPnt]->getData());
+      RealVector& stateR = *(m_cellStatesFlxPnt[RIGHT][iFlxPnt]->getData());
+      stateL = 0.0;
+      stateR = 0.0;
+      
+      // Loop over solution points to extrapolate the state to the flux points
+      for (CFuint iSol = 0; iSol < nbrSolPnt; ++iSol)
+      {
+        stateL += m_solPolyValsAtFlxPnts[flxPntIdxL][iSol]*(*((*(m_states[LEFT]))[iSol]->getData()));
+        stateR += m_solPolyValsAtFlxPnts[flxPntIdxR][iSol]*(*((*(m_states[RIGHT]))[iSol]->getData()));
+      }
+    }
+  }
   
   // compute flux point coordinates
   vector<RealVector> flxCoords1D;
@@ -445,29 +488,6 @@ void ConvRHSFluxReconstruction::setFaceData(CFuint faceID)
     // set unit normal vector
     m_unitNormalFlxPnts[iFlxPnt] = faceJacobVecs[iFlxPnt]/m_faceJacobVecAbsSizeFlxPnts[iFlxPnt];
 
-    // local flux point indices in the left and right cell
-    CFuint flxPntIdxL = (*m_faceFlxPntConnPerOrient)[m_orient][LEFT][iFlxPnt];
-    CFuint flxPntIdxR = (*m_faceFlxPntConnPerOrient)[m_orient][RIGHT][iFlxPnt];
-
-    // Loop over solution points to extrapolate the state to the flux points and calculate the discontinuous flux
-    State* tempVectorL = new State(solPolyValsAtNodes[flxPntIdxL][0]*(*((*(m_states[LEFT]))[0]->getData())));
-    State* tempVectorR = new State(solPolyValsAtNodes[flxPntIdxR][0]*(*((*(m_states[RIGHT]))[0]->getData())));
-
-    m_cellStatesFlxPnt[LEFT][iFlxPnt] = tempVectorL;
-    m_cellStatesFlxPnt[RIGHT][iFlxPnt] = tempVectorR;
-
-    for (CFuint iSol = 1; iSol < nbrSolPnt; ++iSol)
-    {
-      if(m_face->getID() == 624)
-      {
-	CFLog(DEBUG_MIN, "Left State " << *((*(m_states[LEFT]))[iSol]->getData()) << "\n");
-	CFLog(DEBUG_MIN, "Right State = " << *((*(m_states[RIGHT]))[iSol]->getData()) << "\n");
-      }
-      *(m_cellStatesFlxPnt[LEFT][iFlxPnt]) = (State) (*(m_cellStatesFlxPnt[LEFT][iFlxPnt]->getData()) + 
-							  solPolyValsAtNodes[flxPntIdxL][iSol]*(*((*(m_states[LEFT]))[iSol]->getData())));
-      *(m_cellStatesFlxPnt[RIGHT][iFlxPnt]) = (State) (*(m_cellStatesFlxPnt[RIGHT][iFlxPnt]->getData()) +
-							   solPolyValsAtNodes[flxPntIdxR][iSol]*(*((*(m_states[RIGHT]))[iSol]->getData())));
-    }
     if(m_face->getID() == 624)
     {
       CFLog(DEBUG_MIN, "cellID = " << m_cells[LEFT]->getID() << " or " << m_cells[RIGHT]->getID() << "\n");
@@ -496,7 +516,7 @@ void ConvRHSFluxReconstruction::setFaceData(CFuint faceID)
 
 //////////////////////////////////////////////////////////////////////////////
 
-void ConvRHSFluxReconstruction::computeResUpdates(CFuint elemIdx, vector< RealVector >& residuals)
+void ConvRHSFluxReconstruction::computeContFlx()
 {
   // get the local FR data
   vector< FluxReconstructionElementData* >& frLocalData = getMethodData().getFRLocalData();
@@ -504,16 +524,6 @@ void ConvRHSFluxReconstruction::computeResUpdates(CFuint elemIdx, vector< RealVe
   // get number of solution points
   const CFuint nbrSolPnt = frLocalData[m_iElemType]->getNbrOfSolPnts();
   
-  // get number of flux points in 1D
-  CFuint nbrFlxPnt1D = (frLocalData[m_iElemType]->getFlxPntsLocalCoord1D())->size();
-    
-  // get number of faces
-  CFuint nbrFaces = frLocalData[m_iElemType]->getNbrCellFaces();
-  
-  // get solution derivative polynomial values at solution points
-  vector< vector< vector< CFreal > > > solDerivPolyValsAtNodes
-         = frLocalData[m_iElemType]-> getSolPolyDerivsAtNode(*m_solPntsLocalCoords);
-  
   // create a list of the dimensions in which the deriv will be calculated
   for (CFuint iDim = 0; iDim < m_dim; ++iDim)
   {
@@ -547,31 +557,53 @@ void ConvRHSFluxReconstruction::computeResUpdates(CFuint elemIdx, vector< RealVe
       m_contFlx[iSolPnt][iDim] = m_updateVarSet->getFlux()(m_pData,m_cellFluxProjVects[iDim][iSolPnt]);
     }
   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ConvRHSFluxReconstruction::computeResUpdates(CFuint elemIdx, vector< RealVector >& residuals)
+{
+  // get number of solution points
+  const CFuint nbrSolPnt = residuals.size();
+  
+  // compute the discontinuous flux in the solution points
+  computeContFlx();
          
-  // Loop over solution pnts to calculate the divergence of the discontinuous flux
-  for (CFuint iSolPnt = 0; iSolPnt < nbrSolPnt; ++iSolPnt)
+  // compute the divergence of the discontinuous flux
+  if (m_useTPKernels)
+  {
+    m_tpKernels.computeResUpdates(m_contFlx, residuals);
+  }
+  else
   {
-    // reset the divergence of FC
-    residuals[iSolPnt] = 0.0;
-    // Loop over solution pnt to count factor of all sol pnt polys
-    for (CFuint jSolPnt = 0; jSolPnt < nbrSolPnt; ++jSolPnt)
+    // Loop over solution pnts to calculate the divergence of the discontinuous flux
+    for (CFuint iSolPnt = 0; iSolPnt < nbrSolPnt; ++iSolPnt)
     {
-      // Loop over deriv directions and sum them to compute divergence
-      for (CFuint iDir = 0; iDir < m_dim; ++iDir)
+      // reset the divergence of FC
+      residuals[iSolPnt] = 0.0;
+      // Loop over solution pnt to count factor of all sol pnt polys
+      for (CFuint jSolPnt = 0; jSolPnt < nbrSolPnt; ++jSolPnt)
       {
-        // Loop over conservative fluxes 
-        for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+        // Loop over deriv directions and sum them to compute divergence
+        for (CFuint iDir = 0; iDir < m_dim; ++iDir)
         {
-          // Store divFD in the vector that will be divFC
-          residuals[iSolPnt][iEq] -= solDerivPolyValsAtNodes[iSolPnt][iDir][jSolPnt]*(m_contFlx[jSolPnt][iDir][iEq]);
-       
-	  if (fabs(residuals[iSolPnt][iEq]) < MathTools::MathConsts::CFrealEps())
+          const CFreal deriv = m_solPolyDerivAtSolPnts[iSolPnt][iDir][jSolPnt];
+          
+          // Loop over conservative fluxes 
+          for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
           {
-            residuals[iSolPnt][iEq] = 0;
-	  }
-	}
+            // Store divFD in the vector that will be divFC
+            residuals[iSolPnt][iEq] -= deriv*(m_contFlx[jSolPnt][iDir][iEq]);
+          }
+        }
       }
     }
+  }
+  
+  filterResUpdates(residuals);
+  
+  for (CFuint iSolPnt = 0; iSolPnt < nbrSolPnt; ++iSolPnt)
+  {
     if(m_cell->getID() == 0)
     {
       CFLog(VERBOSE, "state: " << *((*m_cellStates)[iSolPnt]->getData()) << "\n");
@@ -583,6 +615,96 @@ void ConvRHSFluxReconstruction::computeResUpdates(CFuint elemIdx, vector< RealVe
 
 //////////////////////////////////////////////////////////////////////////////
 
+void ConvRHSFluxReconstruction::filterResUpdates(vector< RealVector >& residuals)
+{
+  // filter out the round-off errors
+  for (CFuint iSolPnt = 0; iSolPnt < residuals.size(); ++iSolPnt)
+  {
+    for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+    {
+      if (fabs(residuals[iSolPnt][iEq]) < MathTools::MathConsts::CFrealEps())
+      {
+        residuals[iSolPnt][iEq] = 0;
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ConvRHSFluxReconstruction::computeResUpdatesInBatches(const CFuint startIdx, const CFuint endIdx)
+{
+  // get the geodata of the cell builder (the TRS is already set)
+  StdTrsGeoBuilder::GeoData& geoData = m_cellBuilder->getDataGE();
+  
+  // get the datahandle of the rhs
+  DataHandle< CFreal > rhs = socket_rhs.getDataHandle();
+
+  // get residual factor
+  const CFreal resFactor = getMethodData().getResFactor();
+  
+  // get number of solution points
+  const CFuint nbrSolPnt = m_solPntsLocalCoords->size();
+  
+  for (CFuint batchStartIdx = startIdx; batchStartIdx < endIdx; batchStartIdx += m_elemBatchSize)
+  {
+    const CFuint batchEndIdx = std::min(batchStartIdx + m_elemBatchSize, endIdx);
+    m_elemBatch.reset();
+    
+    // gather the discontinuous fluxes of the parallel updatable cells of the batch
+    for (CFuint elemIdx = batchStartIdx; elemIdx < batchEndIdx; ++elemIdx)
+    {
+      // build the GeometricEntity
+      geoData.idx = elemIdx;
+      m_cell = m_cellBuilder->buildGE();
+
+      // get the states in this cell
+      m_cellStates = m_cell->getStates();
+      
+      if ((*m_cellStates)[0]->isParUpdatable())
+      {
+        computeContFlx();
+        
+        const CFuint iElem = m_elemBatch.addElement(m_contFlx);
+        for (CFuint iSol = 0; iSol < nbrSolPnt; ++iSol)
+        {
+          m_batchStateIDs[iElem*nbrSolPnt + iSol] = (*m_cellStates)[iSol]->getLocalID();
+        }
+      }
+      
+      // divide by the Jacobian to transform the update coefficients back to the
+      // physical domain: as in the cell by cell loop, this is done for all the
+      // cells and it does not touch the RHS, so it needs not wait for the batch
+      divideByJacobDet();
+      
+      //release the GeometricEntity
+      m_cellBuilder->releaseGE();
+    }
+    
+    // compute the residual updates (-divFD) of the whole batch
+    m_elemBatch.computeResUpdates();
+    
+    // scatter them to the RHS
+    const CFuint nbrElems = m_elemBatch.getNbrElems();
+    for (CFuint iElem = 0; iElem < nbrElems; ++iElem)
+    {
+      m_elemBatch.getResUpdates(iElem, m_divContFlx);
+      filterResUpdates(m_divContFlx);
+      
+      for (CFuint iSol = 0; iSol < nbrSolPnt; ++iSol)
+      {
+        const CFuint resID = m_nbrEqs*m_batchStateIDs[iElem*nbrSolPnt + iSol];
+        for (CFuint iVar = 0; iVar < m_nbrEqs; ++iVar)
+        {
+          rhs[resID+iVar] += resFactor*m_divContFlx[iSol][iVar];
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void ConvRHSFluxReconstruction::updateRHS()
 {
   // get the datahandle of the rhs
@@ -794,10 +916,6 @@ void ConvRHSFluxReconstruction::addPartitionFacesCorrection()
       
       // get number of flux points in 1D
       const CFuint nbrFlxPnt1D = (frLocalData[0]->getFlxPntsLocalCoord1D())->size();
-
-      // get solution polynomial values at nodes
-      vector< vector< CFreal > > solPolyValsAtNodes
-           = frLocalData[0]->getSolPolyValsAtNode(*m_flxPntsLocalCoords);
 	   
       // compute flux point coordinates
       vector<RealVector> flxCoords1D;
@@ -829,14 +947,11 @@ void ConvRHSFluxReconstruction::addPartitionFacesCorrection()
         m_unitNormalFlxPnts[iFlxPnt] = faceJacobVecs[iFlxPnt]/m_faceJacobVecAbsSizeFlxPnts[iFlxPnt];
 
         // Loop over solution points to extrapolate the state to the flux points and calculate the discontinuous flux
-        State* tempVector = new State(solPolyValsAtNodes[iFlxPnt][0]*(*((*(m_states[0]))[0]->getData())));
-
-        m_cellStatesFlxPnt[0][iFlxPnt] = tempVector;
-
-        for (CFuint iSol = 1; iSol < nbrSolPnt; ++iSol)
+        RealVector& flxPntState = *(m_cellStatesFlxPnt[0][iFlxPnt]->getData());
+        flxPntState = 0.0;
+        for (CFuint iSol = 0; iSol < nbrSolPnt; ++iSol)
         {
-          *(m_cellStatesFlxPnt[0][iFlxPnt]) = (State) (*(m_cellStatesFlxPnt[0][iFlxPnt]->getData()) + 
-							  solPolyValsAtNodes[iFlxPnt][iSol]*(*((*(m_states[LEFT]))[iSol]->getData())));
+          flxPntState += m_solPolyValsAtFlxPnts[iFlxPnt][iSol]*(*((*(m_states[0]))[iSol]->getData()));
         }
       }
       
@@ -925,8 +1040,6 @@ void ConvRHSFluxReconstruction::setup()
   m_cellStatesFlxPnt.resize(2);
   m_cellFlx.resize(2);
   m_faceJacobVecAbsSizeFlxPnts.resize(nbrFlxPnts);
-  m_cellStatesFlxPnt[LEFT].resize(nbrFlxPnts);
-  m_cellStatesFlxPnt[RIGHT].resize(nbrFlxPnts);
   m_cellFlx[LEFT].resize(nbrFlxPnts);
   m_cellFlx[RIGHT].resize(nbrFlxPnts);
   m_faceJacobVecSizeFlxPnts.resize(nbrFlxPnts);
@@ -946,6 +1059,8 @@ void ConvRHSFluxReconstruction::setup()
     m_cellFlx[LEFT][iFlx].resize(m_nbrEqs);
     m_cellFlx[RIGHT][iFlx].resize(m_nbrEqs);
     m_flxPntRiemannFlux[iFlx].resize(m_nbrEqs);
+    m_cellStatesFlxPnt[LEFT].push_back(new State());
+    m_cellStatesFlxPnt[RIGHT].push_back(new State());
   }
   
   for (CFuint iSolPnt = 0; iSolPnt < nbrSolPnts; ++iSolPnt)
@@ -971,6 +1086,26 @@ void ConvRHSFluxReconstruction::setup()
   // compute the divergence of the correction function
   m_corrFctComputer->computeDivCorrectionFunction(frLocalData[0],m_corrFctDiv);
   
+  // compute the solution polynomial values and derivatives once, as they do not depend on the cell
+  m_solPolyValsAtFlxPnts = frLocalData[0]->getSolPolyValsAtNode(*(frLocalData[0]->getFlxPntsLocalCoords()));
+  m_solPolyDerivAtSolPnts = frLocalData[0]->getSolPolyDerivsAtNode(*(frLocalData[0]->getSolPntsLocalCoords()));
+  
+  // use the sum-factorised kernels for quadrilaterals
+  m_useTPKernels = TensorProductKernels::isTensorProduct(frLocalData[0]->getShape());
+  if (m_useTPKernels)
+  {
+    m_tpKernels.setup(frLocalData[0], m_nbrEqs);
+  }
+  
+  // set up the buffers of the batches of cells
+  if (m_elemBatchSize > 1)
+  {
+    m_elemBatch.setup(m_solPolyDerivAtSolPnts, m_nbrEqs, m_elemBatchSize);
+    m_batchStateIDs.resize(m_elemBatchSize*nbrSolPnts);
+  }
+  
+  CFLog(VERBOSE, "ConvRHSFluxReconstruction::setup() => sum-factorised kernels: " << m_useTPKernels
+        << ", cell batch size: " << m_elemBatchSize << "\n");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -978,6 +1113,16 @@ void ConvRHSFluxReconstruction::setup()
 void ConvRHSFluxReconstruction::unsetup()
 {
   CFAUTOTRACE;
+  
+  for (CFuint iSide = 0; iSide < m_cellStatesFlxPnt.size(); ++iSide)
+  {
+    for (CFuint iFlx = 0; iFlx < m_cellStatesFlxPnt[iSide].size(); ++iFlx)
+    {
+      deletePtr(m_cellStatesFlxPnt[iSide][iFlx]);
+    }
+    m_cellStatesFlxPnt[iSide].clear();
+  }
+  
   FluxReconstructionSolverCom::unsetup();
 }
 
@@ -15,6 +15,8 @@
 #include "FluxReconstructionMethod/RiemannFlux.hh"
 #include "FluxReconstructionMethod/BaseCorrectionFunction.hh"
 #include "FluxReconstructionMethod/ReconstructStatesFluxReconstruction.hh"
+#include "FluxReconstructionMethod/TensorProductKernels.hh"
+#include "FluxReconstructionMethod/ElementBatch.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -71,9 +73,19 @@ protected: //functions
   /// compute the interface flux correction FI-FD
   void computeInterfaceFlxCorrection(CFuint faceID);
   
+  /// compute the discontinuous flux in the solution points of the current cell
+  void computeContFlx();
+  
   /// compute the residual updates (-divFC)
   void computeResUpdates(CFuint elemIdx, std::vector< RealVector >& residuals);
   
+  /// set the residual updates below machine precision to zero
+  void filterResUpdates(std::vector< RealVector >& residuals);
+  
+  /// compute the residual updates (-divFD) of the cells [startIdx, endIdx[ in batches
+  /// of m_elemBatchSize cells, add them to the RHS and divide by the Jacobian
+  void computeResUpdatesInBatches(const CFuint startIdx, const CFuint endIdx);
+  
   /// add the residual updates to the RHS
   void updateRHS();
   
@@ -233,6 +245,27 @@ protected: //data
   /// flux projection vectors in solution points for disc flux
   std::vector< std::vector< RealVector > > m_cellFluxProjVects;
   
+  /// solution polynomial values in the flux points
+  std::vector< std::vector< CFreal > > m_solPolyValsAtFlxPnts;
+  
+  /// solution polynomial derivatives in the solution points
+  std::vector< std::vector< std::vector< CFreal > > > m_solPolyDerivAtSolPnts;
+  
+  /// sum-factorised kernels for tensor product cells
+  TensorProductKernels m_tpKernels;
+  
+  /// flag telling if the sum-factorised kernels are used
+  bool m_useTPKernels;
+  
+  /// number of cells in a batch
+  CFuint m_elemBatchSize;
+  
+  /// fluxes and residual updates of a batch of cells
+  ElementBatch m_elemBatch;
+  
+  /// local IDs of the states of the cells in the batch
+  std::vector< CFuint > m_batchStateIDs;
+  
   private:
 
   /// Physical data temporary vector
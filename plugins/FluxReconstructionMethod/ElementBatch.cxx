@@ -0,0 +1,163 @@
+#include "Common/CFLog.hh"
+
+#include "FluxReconstructionMethod/ElementBatch.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::MathTools;
+
+namespace COOLFluiD {
+  namespace FluxReconstructionMethod {
+
+//////////////////////////////////////////////////////////////////////////////
+
+ElementBatch::ElementBatch() :
+  m_dim(0),
+  m_nbrEqs(0),
+  m_nbrSolPnts(0),
+  m_maxNbrElems(0),
+  m_nbrElems(0),
+  m_derivMat(),
+  m_flx(),
+  m_res()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ElementBatch::~ElementBatch()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ElementBatch::setup(const vector< vector< vector< CFreal > > >& solPolyDerivs,
+                         const CFuint nbrEqs, const CFuint maxNbrElems)
+{
+  CFAUTOTRACE;
+
+  cf_assert(solPolyDerivs.size() > 0);
+  cf_assert(maxNbrElems > 0);
+
+  m_nbrSolPnts = solPolyDerivs.size();
+  m_dim = solPolyDerivs[0].size();
+  m_nbrEqs = nbrEqs;
+  m_maxNbrElems = maxNbrElems;
+  m_nbrElems = 0;
+
+  // store the derivation matrix contiguously
+  const CFuint nbrCols = m_dim*m_nbrSolPnts;
+  m_derivMat.resize(m_nbrSolPnts*nbrCols);
+  for (CFuint iSol = 0; iSol < m_nbrSolPnts; ++iSol)
+  {
+    for (CFuint iDir = 0; iDir < m_dim; ++iDir)
+    {
+      for (CFuint jSol = 0; jSol < m_nbrSolPnts; ++jSol)
+      {
+        m_derivMat[iSol*nbrCols + iDir*m_nbrSolPnts + jSol] = solPolyDerivs[iSol][iDir][jSol];
+      }
+    }
+  }
+
+  const CFuint rowSize = m_nbrEqs*m_maxNbrElems;
+  m_flx.assign(nbrCols*rowSize, 0.);
+  m_res.assign(m_nbrSolPnts*rowSize, 0.);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint ElementBatch::addElement(const vector< vector< RealVector > >& flx)
+{
+  cf_assert(m_nbrElems < m_maxNbrElems);
+  cf_assert(flx.size() == m_nbrSolPnts);
+
+  const CFuint iElem = m_nbrElems;
+  const CFuint rowSize = m_nbrEqs*m_maxNbrElems;
+  for (CFuint iDir = 0; iDir < m_dim; ++iDir)
+  {
+    for (CFuint jSol = 0; jSol < m_nbrSolPnts; ++jSol)
+    {
+      const RealVector& flxSol = flx[jSol][iDir];
+      CFreal* row = &m_flx[(iDir*m_nbrSolPnts + jSol)*rowSize + iElem];
+      for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+      {
+        row[iEq*m_maxNbrElems] = flxSol[iEq];
+      }
+    }
+  }
+
+  ++m_nbrElems;
+  return iElem;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ElementBatch::computeResUpdates()
+{
+  const CFuint nbrCols = m_dim*m_nbrSolPnts;
+  const CFuint rowSize = m_nbrEqs*m_maxNbrElems;
+  const CFuint nbrElems = m_nbrElems;
+
+  for (CFuint iSol = 0; iSol < m_nbrSolPnts; ++iSol)
+  {
+    CFreal* res = &m_res[iSol*rowSize];
+    const CFreal* deriv = &m_derivMat[iSol*nbrCols];
+
+    for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+    {
+      CFreal* resEq = res + iEq*m_maxNbrElems;
+      for (CFuint iElem = 0; iElem < nbrElems; ++iElem)
+      {
+        resEq[iElem] = 0.;
+      }
+    }
+
+    for (CFuint iCol = 0; iCol < nbrCols; ++iCol)
+    {
+      // the derivation matrix of a tensor product cell is mostly zero
+      const CFreal coef = -deriv[iCol];
+      if (coef == 0.)
+      {
+        continue;
+      }
+
+      const CFreal* flx = &m_flx[iCol*rowSize];
+      for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+      {
+        CFreal* resEq = res + iEq*m_maxNbrElems;
+        const CFreal* flxEq = flx + iEq*m_maxNbrElems;
+        for (CFuint iElem = 0; iElem < nbrElems; ++iElem)
+        {
+          resEq[iElem] += coef*flxEq[iElem];
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ElementBatch::getResUpdates(const CFuint iElem, vector< RealVector >& residuals) const
+{
+  cf_assert(iElem < m_nbrElems);
+  cf_assert(residuals.size() == m_nbrSolPnts);
+
+  const CFuint rowSize = m_nbrEqs*m_maxNbrElems;
+  for (CFuint iSol = 0; iSol < m_nbrSolPnts; ++iSol)
+  {
+    const CFreal* res = &m_res[iSol*rowSize + iElem];
+    for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+    {
+      residuals[iSol][iEq] = res[iEq*m_maxNbrElems];
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  }  // namespace FluxReconstructionMethod
+}  // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,108 @@
+#ifndef COOLFluiD_FluxReconstructionMethod_ElementBatch_hh
+#define COOLFluiD_FluxReconstructionMethod_ElementBatch_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Common/COOLFluiD.hh"
+
+#include "MathTools/RealVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+  namespace FluxReconstructionMethod {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class gathers the discontinuous fluxes of a batch of cells of the same
+/// type in a structure-of-arrays buffer, in which the cells are the fastest
+/// index, and computes their residual updates -div(F) with a single dense
+/// matrix-matrix product:
+///   R(nbrSolPnts, nbrEqs*nbrElems) = -D(nbrSolPnts, dim*nbrSolPnts) F(dim*nbrSolPnts, nbrEqs*nbrElems)
+/// The innermost loop runs over contiguous cells and can be vectorised.
+class ElementBatch {
+
+public: // functions
+
+  /// Constructor
+  ElementBatch();
+
+  /// Destructor
+  ~ElementBatch();
+
+  /// Set up the derivation matrix and the buffers
+  /// @param solPolyDerivs solution polynomial derivatives in the solution points,
+  ///                      solPolyDerivs[iSol][iDir][jSol]
+  /// @param nbrEqs        number of equations
+  /// @param maxNbrElems   maximum number of cells in a batch
+  void setup(const std::vector< std::vector< std::vector< CFreal > > >& solPolyDerivs,
+             const CFuint nbrEqs, const CFuint maxNbrElems);
+
+  /// @return the maximum number of cells in a batch
+  CFuint getMaxNbrElems() const
+  {
+    return m_maxNbrElems;
+  }
+
+  /// @return the number of cells in the current batch
+  CFuint getNbrElems() const
+  {
+    return m_nbrElems;
+  }
+
+  /// Empty the batch
+  void reset()
+  {
+    m_nbrElems = 0;
+  }
+
+  /// Add a cell to the batch
+  /// @param flx discontinuous flux projected on each mapped coordinate direction,
+  ///            in each solution point of the cell
+  /// @return the index of the cell in the batch
+  CFuint addElement(const std::vector< std::vector< RealVector > >& flx);
+
+  /// Compute the residual updates of all the cells in the batch
+  void computeResUpdates();
+
+  /// Get the residual updates of a cell of the batch
+  /// @param iElem     index of the cell in the batch
+  /// @param residuals residual updates in each solution point
+  void getResUpdates(const CFuint iElem, std::vector< RealVector >& residuals) const;
+
+private: // data
+
+  /// dimensionality
+  CFuint m_dim;
+
+  /// number of equations
+  CFuint m_nbrEqs;
+
+  /// number of solution points in a cell
+  CFuint m_nbrSolPnts;
+
+  /// maximum number of cells in a batch
+  CFuint m_maxNbrElems;
+
+  /// number of cells in the current batch
+  CFuint m_nbrElems;
+
+  /// derivation matrix (row major), m_derivMat[iSol*dim*nbrSolPnts + iDir*nbrSolPnts + jSol]
+  std::vector< CFreal > m_derivMat;
+
+  /// fluxes of the batch, m_flx[(iDir*nbrSolPnts + jSol)*nbrEqs*maxNbrElems + iEq*maxNbrElems + iElem]
+  std::vector< CFreal > m_flx;
+
+  /// residual updates of the batch, m_res[iSol*nbrEqs*maxNbrElems + iEq*maxNbrElems + iElem]
+  std::vector< CFreal > m_res;
+
+}; // class ElementBatch
+
+//////////////////////////////////////////////////////////////////////////////
+
+  }  // namespace FluxReconstructionMethod
+}  // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_FluxReconstructionMethod_ElementBatch_hh
@@ -0,0 +1,297 @@
+#include "Common/CFLog.hh"
+
+#include "FluxReconstructionMethod/FluxReconstructionElementData.hh"
+#include "FluxReconstructionMethod/TensorProductKernels.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::MathTools;
+
+namespace COOLFluiD {
+  namespace FluxReconstructionMethod {
+
+//////////////////////////////////////////////////////////////////////////////
+
+TensorProductKernels::TensorProductKernels() :
+  m_nbrEqs(0),
+  m_nbrSolPnts1D(0),
+  m_solPntsLocalCoord1D(),
+  m_deriv1D(),
+  m_extrap1D(),
+  m_faceSolIdx(),
+  m_flxPntDir(),
+  m_flxPntSide(),
+  m_flxPntFaceSolIdxs(),
+  m_flxPntWeights(),
+  m_faceStates()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+TensorProductKernels::~TensorProductKernels()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TensorProductKernels::setup(FluxReconstructionElementData* frElemData, const CFuint nbrEqs)
+{
+  CFAUTOTRACE;
+
+  cf_assert(isTensorProduct(frElemData->getShape()));
+
+  m_nbrEqs = nbrEqs;
+  m_solPntsLocalCoord1D = *frElemData->getSolPntsLocalCoord1D();
+
+  // number of solution points in 1D and in the cell
+  const CFuint nbrSolPnts1D = m_solPntsLocalCoord1D.size();
+  m_nbrSolPnts1D = nbrSolPnts1D;
+  const CFuint nbrSolPnts = nbrSolPnts1D*nbrSolPnts1D;
+  cf_assert(frElemData->getNbrOfSolPnts() == nbrSolPnts);
+
+  // 1D extrapolation coefficients to ksi = -1 and ksi = 1
+  vector< CFreal > polyVals(nbrSolPnts1D);
+  m_extrap1D.resize(2*nbrSolPnts1D);
+  for (CFuint iSide = 0; iSide < 2; ++iSide)
+  {
+    computeLagrangePolys1D(2.*iSide-1., polyVals);
+    for (CFuint iSol = 0; iSol < nbrSolPnts1D; ++iSol)
+    {
+      m_extrap1D[iSide*nbrSolPnts1D+iSol] = polyVals[iSol];
+    }
+  }
+
+  // 1D derivation coefficients in the solution points
+  m_deriv1D.assign(nbrSolPnts1D*nbrSolPnts1D, 0.);
+  for (CFuint iSol = 0; iSol < nbrSolPnts1D; ++iSol)
+  {
+    const CFreal ksiSol = m_solPntsLocalCoord1D[iSol];
+    for (CFuint iPoly = 0; iPoly < nbrSolPnts1D; ++iPoly)
+    {
+      const CFreal ksiPoly = m_solPntsLocalCoord1D[iPoly];
+      for (CFuint iTerm = 0; iTerm < nbrSolPnts1D; ++iTerm)
+      {
+        if (iTerm != iPoly)
+        {
+          CFreal term = 1./(ksiPoly-m_solPntsLocalCoord1D[iTerm]);
+          for (CFuint iFac = 0; iFac < nbrSolPnts1D; ++iFac)
+          {
+            if (iFac != iPoly && iFac != iTerm)
+            {
+              const CFreal ksiFac = m_solPntsLocalCoord1D[iFac];
+              term *= (ksiSol-ksiFac)/(ksiPoly-ksiFac);
+            }
+          }
+          m_deriv1D[iSol*nbrSolPnts1D+iPoly] += term;
+        }
+      }
+    }
+  }
+
+  // solution point of each (tangential index, normal index) pair: the
+  // solution point (ksi_i,eta_j) is i*N+j
+  m_faceSolIdx.assign(2, vector< CFuint >(nbrSolPnts));
+  for (CFuint i = 0; i < nbrSolPnts1D; ++i)
+  {
+    for (CFuint j = 0; j < nbrSolPnts1D; ++j)
+    {
+      m_faceSolIdx[KSI][j*nbrSolPnts1D+i] = i*nbrSolPnts1D+j;
+      m_faceSolIdx[ETA][i*nbrSolPnts1D+j] = i*nbrSolPnts1D+j;
+    }
+  }
+
+  // normal direction, side and interpolation weights along the face of each face flux point
+  const vector< RealVector >& flxPntsLocalCoords = *frElemData->getFlxPntsLocalCoords();
+  const vector< vector< CFuint > >& faceFlxPntConn = *frElemData->getFaceFlxPntConn();
+  const CFuint nbrFlxPnts = flxPntsLocalCoords.size();
+  m_flxPntDir.assign(nbrFlxPnts, 2);
+  m_flxPntSide.assign(nbrFlxPnts, 0);
+  m_flxPntFaceSolIdxs.assign(nbrFlxPnts, vector< CFuint >());
+  m_flxPntWeights.assign(nbrFlxPnts, vector< CFreal >());
+  vector< CFreal > tangPolyVals(nbrSolPnts1D);
+  for (CFuint iFace = 0; iFace < faceFlxPntConn.size(); ++iFace)
+  {
+    const vector< CFuint >& faceFlxPnts = faceFlxPntConn[iFace];
+    cf_assert(faceFlxPnts.size() > 0);
+
+    // the normal direction is the one along which all flux points are in -1 or 1
+    CFuint normalDir = 2;
+    for (CFuint iDir = 0; iDir < 2 && normalDir == 2; ++iDir)
+    {
+      const CFreal ksi = flxPntsLocalCoords[faceFlxPnts[0]][iDir];
+      bool isNormal = (std::abs(ksi) == 1.);
+      for (CFuint iFlx = 1; iFlx < faceFlxPnts.size(); ++iFlx)
+      {
+        isNormal = isNormal && (flxPntsLocalCoords[faceFlxPnts[iFlx]][iDir] == ksi);
+      }
+      if (isNormal)
+      {
+        normalDir = iDir;
+      }
+    }
+    cf_assert(normalDir < 2);
+
+    for (CFuint iFlx = 0; iFlx < faceFlxPnts.size(); ++iFlx)
+    {
+      const CFuint flxIdx = faceFlxPnts[iFlx];
+      const RealVector& flxCoords = flxPntsLocalCoords[flxIdx];
+      m_flxPntDir[flxIdx] = normalDir;
+      m_flxPntSide[flxIdx] = (flxCoords[normalDir] > 0.) ? 1 : 0;
+      computeLagrangePolys1D(flxCoords[1-normalDir], tangPolyVals);
+
+      // the weights vanishing exactly (flux points aligned with the solution
+      // points) are skipped
+      for (CFuint iFaceSol = 0; iFaceSol < nbrSolPnts1D; ++iFaceSol)
+      {
+        if (tangPolyVals[iFaceSol] != 0.)
+        {
+          m_flxPntFaceSolIdxs[flxIdx].push_back(iFaceSol);
+          m_flxPntWeights[flxIdx].push_back(tangPolyVals[iFaceSol]);
+        }
+      }
+    }
+  }
+
+  m_faceStates.resize(nbrSolPnts1D*m_nbrEqs);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TensorProductKernels::computeLagrangePolys1D(const CFreal ksi, vector< CFreal >& vals) const
+{
+  const CFuint nbrSolPnts1D = m_solPntsLocalCoord1D.size();
+  cf_assert(vals.size() == nbrSolPnts1D);
+  for (CFuint iPoly = 0; iPoly < nbrSolPnts1D; ++iPoly)
+  {
+    const CFreal ksiPoly = m_solPntsLocalCoord1D[iPoly];
+    vals[iPoly] = 1.;
+    for (CFuint iFac = 0; iFac < nbrSolPnts1D; ++iFac)
+    {
+      if (iFac != iPoly)
+      {
+        const CFreal ksiFac = m_solPntsLocalCoord1D[iFac];
+        vals[iPoly] *= (ksi-ksiFac)/(ksiPoly-ksiFac);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <CFuint N>
+void TensorProductKernels::computeResUpdates2D(const vector< vector< RealVector > >& flx,
+                                               vector< RealVector >& residuals) const
+{
+  const CFuint n = (N > 0) ? N : m_nbrSolPnts1D;
+  const CFreal *const deriv = &m_deriv1D[0];
+
+  // -div(F) in (ksi_i,eta_j) = -sum_a (l_a'(ksi_i) F_ksi(a,j) + l_a'(eta_j) F_eta(i,a))
+  for (CFuint i = 0; i < n; ++i)
+  {
+    for (CFuint j = 0; j < n; ++j)
+    {
+      RealVector& res = residuals[i*n+j];
+      res = 0.;
+      for (CFuint a = 0; a < n; ++a)
+      {
+        const CFreal derivKsi = deriv[i*n+a];
+        const CFreal derivEta = deriv[j*n+a];
+        const RealVector& flxKsi = flx[a*n+j][KSI];
+        const RealVector& flxEta = flx[i*n+a][ETA];
+        for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+        {
+          res[iEq] -= derivKsi*flxKsi[iEq] + derivEta*flxEta[iEq];
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TensorProductKernels::computeResUpdates(const vector< vector< RealVector > >& flx,
+                                             vector< RealVector >& residuals) const
+{
+  cf_assert(flx.size() == residuals.size());
+
+  switch (m_nbrSolPnts1D)
+  {
+    case 1: computeResUpdates2D<1>(flx, residuals); break;
+    case 2: computeResUpdates2D<2>(flx, residuals); break;
+    case 3: computeResUpdates2D<3>(flx, residuals); break;
+    case 4: computeResUpdates2D<4>(flx, residuals); break;
+    case 5: computeResUpdates2D<5>(flx, residuals); break;
+    case 6: computeResUpdates2D<6>(flx, residuals); break;
+    default: computeResUpdates2D<0>(flx, residuals);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TensorProductKernels::extrapolateToFlxPnts(const vector< State* >& states,
+                                                const vector< CFuint >& flxPntIdxs,
+                                                vector< State* >& flxStates)
+{
+  cf_assert(flxStates.size() >= flxPntIdxs.size());
+
+  const CFuint nbrSolPnts1D = m_nbrSolPnts1D;
+  CFuint faceDir = 2;
+  CFuint faceSide = 2;
+  for (CFuint iFlx = 0; iFlx < flxPntIdxs.size(); ++iFlx)
+  {
+    const CFuint flxIdx = flxPntIdxs[iFlx];
+    const CFuint dir = m_flxPntDir[flxIdx];
+    const CFuint side = m_flxPntSide[flxIdx];
+    cf_assert(dir < 2);
+
+    // extrapolate along the normal direction once for all the flux points of the face
+    if (dir != faceDir || side != faceSide)
+    {
+      const CFreal *const extrap = &m_extrap1D[side*nbrSolPnts1D];
+      const CFuint *const solIdxs = &m_faceSolIdx[dir][0];
+      for (CFuint iFaceSol = 0; iFaceSol < nbrSolPnts1D; ++iFaceSol)
+      {
+        CFreal *const faceState = &m_faceStates[iFaceSol*m_nbrEqs];
+        for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+        {
+          faceState[iEq] = 0.;
+        }
+        for (CFuint a = 0; a < nbrSolPnts1D; ++a)
+        {
+          const CFreal coef = extrap[a];
+          const State& state = *states[solIdxs[iFaceSol*nbrSolPnts1D+a]];
+          for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+          {
+            faceState[iEq] += coef*state[iEq];
+          }
+        }
+      }
+      faceDir = dir;
+      faceSide = side;
+    }
+
+    // interpolate along the face
+    State& flxState = *flxStates[iFlx];
+    flxState = 0.;
+    const vector< CFuint >& faceSolIdxs = m_flxPntFaceSolIdxs[flxIdx];
+    const vector< CFreal >& weights = m_flxPntWeights[flxIdx];
+    for (CFuint iFaceSol = 0; iFaceSol < faceSolIdxs.size(); ++iFaceSol)
+    {
+      const CFreal weight = weights[iFaceSol];
+      const CFreal *const faceState = &m_faceStates[faceSolIdxs[iFaceSol]*m_nbrEqs];
+      for (CFuint iEq = 0; iEq < m_nbrEqs; ++iEq)
+      {
+        flxState[iEq] += weight*faceState[iEq];
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  }  // namespace FluxReconstructionMethod
+}  // namespace COOLFluiD
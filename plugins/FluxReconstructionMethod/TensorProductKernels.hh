@@ -0,0 +1,122 @@
+#ifndef COOLFluiD_FluxReconstructionMethod_TensorProductKernels_hh
+#define COOLFluiD_FluxReconstructionMethod_TensorProductKernels_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Common/COOLFluiD.hh"
+
+#include "Framework/CFGeoShape.hh"
+#include "Framework/State.hh"
+
+#include "MathTools/RealVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+  namespace FluxReconstructionMethod {
+
+    class FluxReconstructionElementData;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class implements the sum-factorised kernels of a quadrangle: the
+/// solution derivatives and the extrapolations to the flux points are
+/// applied one direction at a time with the 1D Lagrange operators, instead
+/// of with the full 2D ones. This costs O(N^3) per cell instead of O(N^4),
+/// N being the number of solution points in 1D. The kernels are
+/// instantiated for P0 to P5.
+/// @pre the solution points are numbered with KSI as the slowest direction,
+///      as in QuadFluxReconstructionElementData
+class TensorProductKernels {
+
+public: // functions
+
+  /// Constructor
+  TensorProductKernels();
+
+  /// Destructor
+  ~TensorProductKernels();
+
+  /// @return true if the given cell shape is supported
+  static bool isTensorProduct(const CFGeoShape::Type shape)
+  {
+    return shape == CFGeoShape::QUAD;
+  }
+
+  /// Set up the 1D operators and the index tables of the given cell type
+  void setup(FluxReconstructionElementData* frElemData, const CFuint nbrEqs);
+
+  /// Compute the residual updates -div(F) in the solution points
+  /// @param flx       discontinuous flux projected on each mapped coordinate
+  ///                  direction, in each solution point
+  /// @param residuals residual updates in each solution point
+  void computeResUpdates(const std::vector< std::vector< RealVector > >& flx,
+                         std::vector< RealVector >& residuals) const;
+
+  /// Extrapolate the states of a cell to some of its face flux points
+  /// @param states     states in the solution points
+  /// @param flxPntIdxs local indices of the flux points
+  /// @param flxStates  extrapolated states (one for each flux point)
+  void extrapolateToFlxPnts(const std::vector< Framework::State* >& states,
+                            const std::vector< CFuint >& flxPntIdxs,
+                            std::vector< Framework::State* >& flxStates);
+
+private: // functions
+
+  /// Compute -div(F) in a quadrangle with N solution points in 1D
+  /// (N = 0 for a number known at run time only)
+  template <CFuint N>
+  void computeResUpdates2D(const std::vector< std::vector< RealVector > >& flx,
+                           std::vector< RealVector >& residuals) const;
+
+  /// Compute the 1D Lagrange polynomials of the solution points in the given coordinate
+  void computeLagrangePolys1D(const CFreal ksi, std::vector< CFreal >& vals) const;
+
+private: // data
+
+  /// number of equations
+  CFuint m_nbrEqs;
+
+  /// number of solution points in 1D
+  CFuint m_nbrSolPnts1D;
+
+  /// solution point coordinates in 1D
+  std::vector< CFreal > m_solPntsLocalCoord1D;
+
+  /// derivatives of the 1D Lagrange polynomials in the solution points,
+  /// m_deriv1D[i*N+a] = l_a'(ksi_i)
+  std::vector< CFreal > m_deriv1D;
+
+  /// values of the 1D Lagrange polynomials in ksi = -1 and ksi = 1,
+  /// m_extrap1D[side*N+a] = l_a(2*side-1)
+  std::vector< CFreal > m_extrap1D;
+
+  /// solution point of each (tangential index, normal index) pair for each
+  /// normal direction, m_faceSolIdx[dir][t*N+a]
+  std::vector< std::vector< CFuint > > m_faceSolIdx;
+
+  /// normal direction of each flux point
+  std::vector< CFuint > m_flxPntDir;
+
+  /// side (0 for -1, 1 for +1) of each flux point along its normal direction
+  std::vector< CFuint > m_flxPntSide;
+
+  /// face solution points with a nonzero weight in each flux point
+  std::vector< std::vector< CFuint > > m_flxPntFaceSolIdxs;
+
+  /// weights of these face solution points in each flux point
+  std::vector< std::vector< CFreal > > m_flxPntWeights;
+
+  /// states extrapolated in the face solution points of the current face
+  std::vector< CFreal > m_faceStates;
+
+}; // class TensorProductKernels
+
+//////////////////////////////////////////////////////////////////////////////
+
+  }  // namespace FluxReconstructionMethod
+}  // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_FluxReconstructionMethod_TensorProductKernels_hh
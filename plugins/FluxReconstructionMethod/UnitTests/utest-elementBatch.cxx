@@ -0,0 +1,154 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test FluxReconstruction element batch"
+
+#include <boost/test/unit_test.hpp>
+
+#include "FluxReconstructionMethod/ElementBatch.hh"
+#include "FluxReconstructionMethod/QuadFluxReconstructionElementData.hh"
+#include "FluxReconstructionMethod/TriagFluxReconstructionElementData.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::FluxReconstructionMethod;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct ElementBatch_Fixture
+{
+  /// common setup for each test case
+  ElementBatch_Fixture() : nbrEqs(4), maxNbrElems(8)
+  {
+  }
+  /// common tear-down for each test case
+  ~ElementBatch_Fixture()
+  {
+  }
+
+  /// deterministic pseudo-random value in [-1,1]
+  CFreal random(CFuint& seed)
+  {
+    seed = seed*1103515245u + 12345u;
+    return 2.*((seed/65536u) % 32768u)/32767. - 1.;
+  }
+
+  /// compute the residual updates of batches of the given sizes and compare
+  /// them with the ones computed cell by cell, as in ConvRHSFluxReconstruction
+  void checkBatches(FluxReconstructionElementData& frElemData,
+                    const vector< CFuint >& batchSizes, CFuint& seed)
+  {
+    const vector< vector< vector< CFreal > > > deriv =
+      frElemData.getSolPolyDerivsAtNode(*frElemData.getSolPntsLocalCoords());
+    const CFuint nbrSolPnts = frElemData.getNbrOfSolPnts();
+    const CFuint dim = deriv[0].size();
+
+    ElementBatch batch;
+    batch.setup(deriv, nbrEqs, maxNbrElems);
+    BOOST_CHECK_EQUAL( batch.getMaxNbrElems(), maxNbrElems );
+
+    vector< vector< vector< RealVector > > > flx
+      (maxNbrElems, vector< vector< RealVector > >(nbrSolPnts, vector< RealVector >(dim, RealVector(nbrEqs))));
+    vector< RealVector > residuals(nbrSolPnts, RealVector(nbrEqs));
+
+    for (CFuint iBatch = 0; iBatch < batchSizes.size(); ++iBatch)
+    {
+      const CFuint nbrElems = batchSizes[iBatch];
+      batch.reset();
+      for (CFuint iElem = 0; iElem < nbrElems; ++iElem)
+      {
+        for (CFuint iSol = 0; iSol < nbrSolPnts; ++iSol)
+        {
+          for (CFuint iDir = 0; iDir < dim; ++iDir)
+          {
+            for (CFuint iEq = 0; iEq < nbrEqs; ++iEq)
+            {
+              flx[iElem][iSol][iDir][iEq] = random(seed);
+            }
+          }
+        }
+        BOOST_CHECK_EQUAL( batch.addElement(flx[iElem]), iElem );
+      }
+      BOOST_CHECK_EQUAL( batch.getNbrElems(), nbrElems );
+
+      batch.computeResUpdates();
+
+      for (CFuint iElem = 0; iElem < nbrElems; ++iElem)
+      {
+        batch.getResUpdates(iElem, residuals);
+        for (CFuint iSol = 0; iSol < nbrSolPnts; ++iSol)
+        {
+          for (CFuint iEq = 0; iEq < nbrEqs; ++iEq)
+          {
+            CFreal res = 0.;
+            for (CFuint jSol = 0; jSol < nbrSolPnts; ++jSol)
+            {
+              for (CFuint iDir = 0; iDir < dim; ++iDir)
+              {
+                res -= deriv[iSol][iDir][jSol]*flx[iElem][jSol][iDir][iEq];
+              }
+            }
+            BOOST_CHECK_SMALL( residuals[iSol][iEq] - res, 1e-11 );
+          }
+        }
+      }
+    }
+  }
+
+  /// number of equations
+  const CFuint nbrEqs;
+
+  /// maximum number of cells in a batch
+  const CFuint maxNbrElems;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ElementBatch_TestSuite, ElementBatch_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_quad )
+{
+  // full, partial and single cell batches, as at the end of a cell range
+  vector< CFuint > batchSizes;
+  batchSizes.push_back(maxNbrElems);
+  batchSizes.push_back(3);
+  batchSizes.push_back(1);
+
+  CFuint seed = 17;
+  for (CFuint iOrder = 0; iOrder <= 5; ++iOrder)
+  {
+    QuadFluxReconstructionElementData frElemData(static_cast<CFPolyOrder::Type>(iOrder));
+    checkBatches(frElemData, batchSizes, seed);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_triag )
+{
+  vector< CFuint > batchSizes;
+  batchSizes.push_back(5);
+  batchSizes.push_back(maxNbrElems);
+
+  CFuint seed = 31;
+  for (CFuint iOrder = 0; iOrder <= 3; ++iOrder)
+  {
+    TriagFluxReconstructionElementData frElemData(static_cast<CFPolyOrder::Type>(iOrder));
+    checkBatches(frElemData, batchSizes, seed);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,182 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test FluxReconstruction tensor product kernels"
+
+#include <boost/test/unit_test.hpp>
+
+#include "FluxReconstructionMethod/QuadFluxReconstructionElementData.hh"
+#include "FluxReconstructionMethod/TensorProductKernels.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::FluxReconstructionMethod;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct TensorProductKernels_Fixture
+{
+  /// common setup for each test case
+  TensorProductKernels_Fixture() : nbrEqs(4)
+  {
+  }
+  /// common tear-down for each test case
+  ~TensorProductKernels_Fixture()
+  {
+  }
+
+  /// deterministic pseudo-random value in [-1,1]
+  CFreal random(CFuint& seed)
+  {
+    seed = seed*1103515245u + 12345u;
+    return 2.*((seed/65536u) % 32768u)/32767. - 1.;
+  }
+
+  /// number of equations
+  const CFuint nbrEqs;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( TensorProductKernels_TestSuite, TensorProductKernels_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_computeResUpdates )
+{
+  CFuint seed = 13;
+  for (CFuint iOrder = 0; iOrder <= 5; ++iOrder)
+  {
+    QuadFluxReconstructionElementData frElemData(static_cast<CFPolyOrder::Type>(iOrder));
+    BOOST_CHECK( TensorProductKernels::isTensorProduct(frElemData.getShape()) );
+    TensorProductKernels kernels;
+    kernels.setup(&frElemData, nbrEqs);
+
+    // dense derivation operator, as in ConvRHSFluxReconstruction
+    const vector< vector< vector< CFreal > > > deriv =
+      frElemData.getSolPolyDerivsAtNode(*frElemData.getSolPntsLocalCoords());
+    const CFuint nbrSolPnts = frElemData.getNbrOfSolPnts();
+    BOOST_CHECK_EQUAL( nbrSolPnts, (iOrder+1)*(iOrder+1) );
+
+    vector< vector< RealVector > > flx(nbrSolPnts, vector< RealVector >(2, RealVector(nbrEqs)));
+    for (CFuint iSol = 0; iSol < nbrSolPnts; ++iSol)
+    {
+      for (CFuint iDir = 0; iDir < 2; ++iDir)
+      {
+        for (CFuint iEq = 0; iEq < nbrEqs; ++iEq)
+        {
+          flx[iSol][iDir][iEq] = random(seed);
+        }
+      }
+    }
+
+    vector< RealVector > residuals(nbrSolPnts, RealVector(nbrEqs));
+    kernels.computeResUpdates(flx, residuals);
+
+    for (CFuint iSol = 0; iSol < nbrSolPnts; ++iSol)
+    {
+      for (CFuint iEq = 0; iEq < nbrEqs; ++iEq)
+      {
+        CFreal res = 0.;
+        for (CFuint jSol = 0; jSol < nbrSolPnts; ++jSol)
+        {
+          for (CFuint iDir = 0; iDir < 2; ++iDir)
+          {
+            res -= deriv[iSol][iDir][jSol]*flx[jSol][iDir][iEq];
+          }
+        }
+        BOOST_CHECK_SMALL( residuals[iSol][iEq] - res, 1e-11 );
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_extrapolateToFlxPnts )
+{
+  CFuint seed = 29;
+  for (CFuint iOrder = 0; iOrder <= 5; ++iOrder)
+  {
+    QuadFluxReconstructionElementData frElemData(static_cast<CFPolyOrder::Type>(iOrder));
+    TensorProductKernels kernels;
+    kernels.setup(&frElemData, nbrEqs);
+
+    // dense extrapolation operator, as in ConvRHSFluxReconstruction
+    const vector< vector< CFreal > > polyVals =
+      frElemData.getSolPolyValsAtNode(*frElemData.getFlxPntsLocalCoords());
+    const CFuint nbrSolPnts = frElemData.getNbrOfSolPnts();
+
+    vector< State* > states(nbrSolPnts);
+    for (CFuint iSol = 0; iSol < nbrSolPnts; ++iSol)
+    {
+      states[iSol] = new State(RealVector(nbrEqs));
+      for (CFuint iEq = 0; iEq < nbrEqs; ++iEq)
+      {
+        (*states[iSol])[iEq] = random(seed);
+      }
+    }
+
+    // the flux points of each face, then of all the faces in a single call,
+    // in the given and in the reversed order (as for the right cell of a face)
+    const vector< vector< CFuint > >& faceFlxPntConn = *frElemData.getFaceFlxPntConn();
+    BOOST_CHECK_EQUAL( faceFlxPntConn.size(), 4u );
+    vector< vector< CFuint > > flxPntIdxsList(faceFlxPntConn.begin(), faceFlxPntConn.end());
+    vector< CFuint > allFlxPntIdxs;
+    for (CFuint iFace = 0; iFace < faceFlxPntConn.size(); ++iFace)
+    {
+      BOOST_CHECK_EQUAL( faceFlxPntConn[iFace].size(), iOrder+1 );
+      allFlxPntIdxs.insert(allFlxPntIdxs.end(), faceFlxPntConn[iFace].begin(), faceFlxPntConn[iFace].end());
+      flxPntIdxsList.push_back(vector< CFuint >(faceFlxPntConn[iFace].rbegin(), faceFlxPntConn[iFace].rend()));
+    }
+    flxPntIdxsList.push_back(allFlxPntIdxs);
+
+    vector< State* > flxStates(allFlxPntIdxs.size());
+    for (CFuint iFlx = 0; iFlx < flxStates.size(); ++iFlx)
+    {
+      flxStates[iFlx] = new State(RealVector(nbrEqs));
+    }
+
+    for (CFuint iList = 0; iList < flxPntIdxsList.size(); ++iList)
+    {
+      const vector< CFuint >& flxPntIdxs = flxPntIdxsList[iList];
+      kernels.extrapolateToFlxPnts(states, flxPntIdxs, flxStates);
+
+      for (CFuint iFlx = 0; iFlx < flxPntIdxs.size(); ++iFlx)
+      {
+        const CFuint flxIdx = flxPntIdxs[iFlx];
+        for (CFuint iEq = 0; iEq < nbrEqs; ++iEq)
+        {
+          CFreal state = 0.;
+          for (CFuint iSol = 0; iSol < nbrSolPnts; ++iSol)
+          {
+            state += polyVals[flxIdx][iSol]*(*states[iSol])[iEq];
+          }
+          BOOST_CHECK_SMALL( (*flxStates[iFlx])[iEq] - state, 1e-12 );
+        }
+      }
+    }
+
+    for (CFuint iSol = 0; iSol < nbrSolPnts; ++iSol)
+    {
+      delete states[iSol];
+    }
+    for (CFuint iFlx = 0; iFlx < flxStates.size(); ++iFlx)
+    {
+      delete flxStates[iFlx];
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -158,7 +158,11 @@ void FwdEuler::takeStepImpl()
 
   // do a prepare step, usually backing up the solution to pastStates
   CFLog(VERBOSE, "ForwardEuler::takeStep(): calling Prepare step\n");
-  if (m_prepare->isNotNull()) { m_prepare->execute(); }
+  if (m_prepare->isNotNull()) {
+    // in unsteady runs the ghost states are backed up too
+    if (subSysStatus->getDT() > 0.) { completeStatesSync(); }
+    m_prepare->execute();
+  }
 
   getConvergenceMethodData()->getConvergenceStatus().res     = subSysStatus->getResidual();
   getConvergenceMethodData()->getConvergenceStatus().iter    = 0;
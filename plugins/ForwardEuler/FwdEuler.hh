@@ -60,6 +60,11 @@ protected: // abstract interface implementations
   /// @see ConvergenceMethod::takeStep()
   virtual void takeStepImpl();
 
+  /// The prepare commands are the only ones using the ghost states before the
+  /// SpaceMethod, and takeStepImpl() completes the synchronization for them
+  /// @see ConvergenceMethod::canOverlapSync()
+  virtual bool canOverlapSync() const {return true;}
+
   /// Sets up the data for the method commands to be applied.
   /// @see Method::unsetMethod()
   virtual void unsetMethodImpl();
@@ -0,0 +1,519 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "Common/CFLog.hh"
+#include "Common/NotImplementedException.hh"
+#include "Framework/BlockAccumulator.hh"
+
+#include "Krylov/BCSRMatrix.hh"
+#include "Krylov/BlockKernels.hh"
+#include "Krylov/KrylovVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Computes y = A x with the kernels of the block size of A
+struct BCSRMult {
+  const BCSRMatrix& a;
+  const CFreal* x;
+  CFreal* y;
+
+  BCSRMult(const BCSRMatrix& ia, const CFreal* ix, CFreal* iy) : a(ia), x(ix), y(iy) {}
+
+  template <CFuint N>
+  void run()
+  {
+    const CFuint nb = a.getBlockSize();
+    const CFuint nb2 = nb*nb;
+    const CFuint nbRows = a.getNbBlockRows();
+    const CFuint* rowPtr = &a.getRowPtr()[0];
+    const CFuint* cols = &a.getCols()[0];
+    const CFreal* blocks = &a.getBlocks()[0];
+
+    for (CFuint iRow = 0; iRow < nbRows; ++iRow) {
+      CFreal* yi = y + iRow*nb;
+      for (CFuint ib = 0; ib < nb; ++ib) {
+	yi[ib] = 0.;
+      }
+      for (CFuint k = rowPtr[iRow]; k < rowPtr[iRow+1]; ++k) {
+	BlockKernels<N>::multAdd(nb, blocks + k*nb2, x + cols[k]*nb, yi);
+      }
+    }
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BCSRMatrix::BCSRMatrix() :
+  Framework::LSSMatrix(),
+  m_nb(0),
+  m_nbRows(0),
+  m_nbCols(0),
+  m_isFrozen(false),
+  m_buildCols(),
+  m_buildValues(),
+  m_rowPtr(),
+  m_cols(),
+  m_diagPtr(),
+  m_values(),
+  m_name()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BCSRMatrix::~BCSRMatrix()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::createSeqAIJ(const CFint m,
+			      const CFint n,
+			      const CFint nz,
+			      const CFint* nnz,
+			      const char* name)
+{
+  createSeqBAIJ(1, m, n, nz, nnz, name);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::createSeqBAIJ(const CFuint blockSize,
+			       const CFint m,
+			       const CFint n,
+			       const CFint nz,
+			       const CFint* nnz,
+			       const char* name)
+{
+  cf_assert(blockSize > 0);
+  cf_assert(m % blockSize == 0);
+  cf_assert(n % blockSize == 0);
+
+  m_nb = blockSize;
+  m_nbRows = m/blockSize;
+  m_nbCols = n/blockSize;
+  m_name = (name != CFNULL) ? name : "";
+  m_isFrozen = false;
+
+  vector<CFuint>().swap(m_rowPtr);
+  vector<CFuint>().swap(m_cols);
+  vector<CFuint>().swap(m_diagPtr);
+  vector<CFreal>().swap(m_values);
+
+  m_buildCols.assign(m_nbRows, vector<CFuint>());
+  m_buildValues.assign(m_nbRows, vector<CFreal>());
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    const CFint rowNnz = (nnz != CFNULL) ? nnz[iRow] : nz;
+    if (rowNnz > 0) {
+      m_buildCols[iRow].reserve(rowNnz);
+      m_buildValues[iRow].reserve(rowNnz*m_nb*m_nb);
+    }
+  }
+
+  CFLog(VERBOSE, "BCSRMatrix::createSeqBAIJ() => " << m_name << ": " << m_nbRows
+	<< " x " << m_nbCols << " blocks of size " << m_nb << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+#ifdef CF_HAVE_MPI
+
+void BCSRMatrix::createParAIJ(MPI_Comm comm,
+			      const CFint m,
+			      const CFint n,
+			      const CFint M,
+			      const CFint N,
+			      const CFint dnz,
+			      const CFint* dnnz,
+			      const CFint onz,
+			      const CFint* onnz,
+			      const char* name)
+{
+  throw Common::NotImplementedException
+    (FromHere(), "BCSRMatrix::createParAIJ() => use createSeqAIJ() with the ghost columns");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::createParBAIJ(MPI_Comm comm,
+			       const CFuint blockSize,
+			       const CFint m,
+			       const CFint n,
+			       const CFint M,
+			       const CFint N,
+			       const CFint dnz,
+			       const CFint* dnnz,
+			       const CFint onz,
+			       const CFint* onnz,
+			       const char* name)
+{
+  throw Common::NotImplementedException
+    (FromHere(), "BCSRMatrix::createParBAIJ() => use createSeqBAIJ() with the ghost columns");
+}
+
+#endif // CF_HAVE_MPI
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal* BCSRMatrix::getBlock(const CFuint row, const CFuint col, const bool create)
+{
+  cf_assert(row < m_nbRows);
+  cf_assert(col < m_nbCols);
+  const CFuint nb2 = m_nb*m_nb;
+
+  if (m_isFrozen) {
+    const CFuint* first = &m_cols[0] + m_rowPtr[row];
+    const CFuint* last  = &m_cols[0] + m_rowPtr[row+1];
+    const CFuint* pos = std::lower_bound(first, last, col);
+    // new non zero locations are ignored once the structure is frozen
+    if (pos == last || *pos != col) return CFNULL;
+    return &m_values[(pos - &m_cols[0])*nb2];
+  }
+
+  vector<CFuint>& cols = m_buildCols[row];
+  vector<CFreal>& values = m_buildValues[row];
+  vector<CFuint>::iterator pos = std::lower_bound(cols.begin(), cols.end(), col);
+  const CFuint idx = pos - cols.begin();
+  if (pos == cols.end() || *pos != col) {
+    if (!create) return CFNULL;
+    cols.insert(pos, col);
+    values.insert(values.begin() + idx*nb2, nb2, 0.);
+  }
+  return &values[idx*nb2];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::freezeNonZeroStructure()
+{
+  if (m_isFrozen) return;
+
+  const CFuint nb2 = m_nb*m_nb;
+
+  // every block row needs its diagonal block for the preconditioners
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    getBlock(iRow, iRow, true);
+  }
+
+  m_rowPtr.resize(m_nbRows+1);
+  m_rowPtr[0] = 0;
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    m_rowPtr[iRow+1] = m_rowPtr[iRow] + m_buildCols[iRow].size();
+  }
+
+  const CFuint nbBlocks = m_rowPtr[m_nbRows];
+  m_cols.resize(nbBlocks);
+  m_diagPtr.resize(m_nbRows);
+  m_values.resize(nbBlocks*nb2);
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    std::copy(m_buildCols[iRow].begin(), m_buildCols[iRow].end(), m_cols.begin() + m_rowPtr[iRow]);
+    std::copy(m_buildValues[iRow].begin(), m_buildValues[iRow].end(),
+	      m_values.begin() + m_rowPtr[iRow]*nb2);
+    m_diagPtr[iRow] = m_rowPtr[iRow] +
+      (std::lower_bound(m_buildCols[iRow].begin(), m_buildCols[iRow].end(), iRow) -
+       m_buildCols[iRow].begin());
+  }
+
+  vector<vector<CFuint> >().swap(m_buildCols);
+  vector<vector<CFreal> >().swap(m_buildValues);
+  m_isFrozen = true;
+
+  CFLog(VERBOSE, "BCSRMatrix::freezeNonZeroStructure() => " << m_name << ": "
+	<< nbBlocks << " non zero blocks\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::setOrAddValue(const CFint im, const CFint in, const CFreal value, const bool add)
+{
+  if (im < 0 || in < 0) return;
+
+  CFreal* block = getBlock(im/m_nb, in/m_nb, true);
+  if (block != CFNULL) {
+    CFreal& entry = block[(im % m_nb)*m_nb + (in % m_nb)];
+    entry = (add) ? entry + value : value;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::setValue(const CFint im, const CFint in, const CFreal value)
+{
+  setOrAddValue(im, in, value, false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::addValue(const CFint im, const CFint in, const CFreal value)
+{
+  setOrAddValue(im, in, value, true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::setValues(const CFuint m,
+			   const CFint* im,
+			   const CFuint n,
+			   const CFint* in,
+			   const CFreal* values)
+{
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      setOrAddValue(im[i], in[j], values[i*n + j], false);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::addValues(const CFuint m,
+			   const CFint* im,
+			   const CFuint n,
+			   const CFint* in,
+			   const CFreal* values)
+{
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      setOrAddValue(im[i], in[j], values[i*n + j], true);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::getValue(const CFint im, const CFint in, CFreal& value)
+{
+  value = 0.;
+  if (im < 0 || in < 0) return;
+
+  const CFreal* block = getBlock(im/m_nb, in/m_nb, false);
+  if (block != CFNULL) {
+    value = block[(im % m_nb)*m_nb + (in % m_nb)];
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::getValues(const CFuint m,
+			   const CFint* im,
+			   const CFuint n,
+			   const CFint* in,
+			   CFreal* values)
+{
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      getValue(im[i], in[j], values[i*n + j]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::setOrAddValues(const BlockAccumulator& acc, const bool add)
+{
+  const CFuint m  = acc.getM();
+  const CFuint n  = acc.getN();
+  const CFuint nb = acc.getNB();
+  const vector<CFint>& im = acc.getIM();
+  const vector<CFint>& in = acc.getIN();
+  cf_assert(nb == m_nb);
+
+  for (CFuint i = 0; i < m; ++i) {
+    // negative indices (rows of ghost states) are ignored
+    if (im[i] < 0) continue;
+    for (CFuint j = 0; j < n; ++j) {
+      if (in[j] < 0) continue;
+      CFreal* block = getBlock(im[i], in[j], true);
+      if (block == CFNULL) continue;
+
+      if (add) {
+	for (CFuint ib = 0; ib < nb; ++ib) {
+	  for (CFuint jb = 0; jb < nb; ++jb) {
+	    block[ib*nb + jb] += acc.getValue(i,j,ib,jb);
+	  }
+	}
+      }
+      else {
+	for (CFuint ib = 0; ib < nb; ++ib) {
+	  for (CFuint jb = 0; jb < nb; ++jb) {
+	    block[ib*nb + jb] = acc.getValue(i,j,ib,jb);
+	  }
+	}
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::setValues(const BlockAccumulator& acc)
+{
+  setOrAddValues(acc, false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::addValues(const BlockAccumulator& acc)
+{
+  setOrAddValues(acc, true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::setRow(const CFuint row, CFreal diagval, CFreal offdiagval)
+{
+  const CFuint iRow = row/m_nb;
+  const CFuint ib = row % m_nb;
+  cf_assert(iRow < m_nbRows);
+
+  if (m_isFrozen) {
+    for (CFuint k = m_rowPtr[iRow]; k < m_rowPtr[iRow+1]; ++k) {
+      CFreal* subRow = &m_values[k*m_nb*m_nb + ib*m_nb];
+      for (CFuint jb = 0; jb < m_nb; ++jb) {
+	subRow[jb] = offdiagval;
+      }
+    }
+  }
+  else {
+    vector<CFreal>& values = m_buildValues[iRow];
+    for (CFuint k = 0; k < m_buildCols[iRow].size(); ++k) {
+      CFreal* subRow = &values[k*m_nb*m_nb + ib*m_nb];
+      for (CFuint jb = 0; jb < m_nb; ++jb) {
+	subRow[jb] = offdiagval;
+      }
+    }
+  }
+
+  setOrAddValue(row, row, diagval, false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::setOrAddDiagonal(LSSVector& diag, const bool add)
+{
+  const CFreal* d = dynamic_cast<KrylovVector&>(diag).getArray();
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    CFreal* block = getBlock(iRow, iRow, true);
+    if (block == CFNULL) continue;
+    for (CFuint ib = 0; ib < m_nb; ++ib) {
+      CFreal& entry = block[ib*m_nb + ib];
+      const CFreal value = d[iRow*m_nb + ib];
+      entry = (add) ? entry + value : value;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::setDiagonal(LSSVector& diag)
+{
+  setOrAddDiagonal(diag, false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::addToDiagonal(LSSVector& diag)
+{
+  setOrAddDiagonal(diag, true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::resetToZeroEntries()
+{
+  if (m_isFrozen) {
+    m_values.assign(m_values.size(), 0.);
+  }
+  else {
+    for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+      m_buildValues[iRow].assign(m_buildValues[iRow].size(), 0.);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::mult(const CFreal* x, CFreal* y) const
+{
+  cf_assert(m_isFrozen);
+  BCSRMult f(*this, x, y);
+  dispatchBlockSize(m_nb, f);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::printToScreen() const
+{
+  std::cout << m_name << " (" << m_nbRows << " x " << m_nbCols
+	    << " blocks of size " << m_nb << ")\n";
+
+  const CFuint nb2 = m_nb*m_nb;
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    const CFuint nbBlocks = (m_isFrozen) ?
+      m_rowPtr[iRow+1] - m_rowPtr[iRow] : m_buildCols[iRow].size();
+    for (CFuint k = 0; k < nbBlocks; ++k) {
+      const CFuint col = (m_isFrozen) ? m_cols[m_rowPtr[iRow] + k] : m_buildCols[iRow][k];
+      const CFreal* block = (m_isFrozen) ?
+	&m_values[(m_rowPtr[iRow] + k)*nb2] : &m_buildValues[iRow][k*nb2];
+      std::cout << "(" << iRow << "," << col << ")\n";
+      for (CFuint ib = 0; ib < m_nb; ++ib) {
+	for (CFuint jb = 0; jb < m_nb; ++jb) {
+	  std::cout << block[ib*m_nb + jb] << " ";
+	}
+	std::cout << "\n";
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BCSRMatrix::printToFile(const char* fileName) const
+{
+  std::ofstream f(fileName);
+  f.precision(16);
+
+  const CFuint nb2 = m_nb*m_nb;
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    const CFuint nbBlocks = (m_isFrozen) ?
+      m_rowPtr[iRow+1] - m_rowPtr[iRow] : m_buildCols[iRow].size();
+    for (CFuint k = 0; k < nbBlocks; ++k) {
+      const CFuint col = (m_isFrozen) ? m_cols[m_rowPtr[iRow] + k] : m_buildCols[iRow][k];
+      const CFreal* block = (m_isFrozen) ?
+	&m_values[(m_rowPtr[iRow] + k)*nb2] : &m_buildValues[iRow][k*nb2];
+      for (CFuint ib = 0; ib < m_nb; ++ib) {
+	for (CFuint jb = 0; jb < m_nb; ++jb) {
+	  f << iRow*m_nb + ib << " " << col*m_nb + jb << " " << block[ib*m_nb + jb] << "\n";
+	}
+      }
+    }
+  }
+  f.close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,264 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_BCSRMatrix_hh
+#define COOLFluiD_Krylov_BCSRMatrix_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Framework/LSSMatrix.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework { class BlockAccumulator; }
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a sparse matrix in block compressed row (BCSR)
+/// format, whose nb x nb blocks are stored row by row and contiguously.
+///
+/// The block rows are the states updatable by this processor, the block
+/// columns are the same states followed by the ghost states, so that the
+/// matrix-vector product only needs the ghost entries of the vector to be
+/// up to date (@see GhostSync).
+/// Until freezeNonZeroStructure() is called, the blocks are inserted in
+/// per-row sorted lists. The structure is then compressed in flat arrays
+/// and, like with a frozen PETSc matrix, values set in new locations are
+/// ignored. Negative row or column indices are ignored as well.
+class BCSRMatrix : public Framework::LSSMatrix {
+public:
+
+  /// Default constructor without arguments.
+  BCSRMatrix();
+
+  /// Destructor.
+  ~BCSRMatrix();
+
+  /// Create a sparse matrix with 1x1 blocks
+  /// @see createSeqBAIJ()
+  void createSeqAIJ(const CFint m,
+                    const CFint n,
+                    const CFint nz,
+                    const CFint* nnz,
+                    const char* name = CFNULL);
+
+  /// Create a block sparse matrix
+  /// @param blockSize  size of the blocks
+  /// @param m    number of rows (updatable states times blockSize)
+  /// @param n    number of columns (all the local states, ghosts
+  ///             included, times blockSize)
+  /// @param nz   estimated number of non zero blocks per block row
+  /// @param nnz  estimated number of non zero blocks of each block row (or CFNULL)
+  void createSeqBAIJ(const CFuint blockSize,
+                     const CFint m,
+                     const CFint n,
+                     const CFint nz,
+                     const CFint* nnz,
+                     const char* name = CFNULL);
+
+#ifdef CF_HAVE_MPI
+
+  /// Not supported: the parallel layout is given by the ghost columns
+  /// @see createSeqBAIJ()
+  void createParAIJ(MPI_Comm comm,
+                    const CFint m,
+                    const CFint n,
+                    const CFint M,
+                    const CFint N,
+                    const CFint dnz,
+                    const CFint* dnnz,
+                    const CFint onz,
+                    const CFint* onnz,
+                    const char* name = CFNULL);
+
+  /// Not supported: the parallel layout is given by the ghost columns
+  /// @see createSeqBAIJ()
+  void createParBAIJ(MPI_Comm comm,
+                     const CFuint blockSize,
+                     const CFint m,
+                     const CFint n,
+                     const CFint M,
+                     const CFint N,
+                     const CFint dnz,
+                     const CFint* dnnz,
+                     const CFint onz,
+                     const CFint* onnz,
+                     const char* name = CFNULL);
+
+#endif // CF_HAVE_MPI
+
+  /// Start to assemble the matrix (the values are always in place)
+  void beginAssembly(LSSMatrixAssemblyType assemblyType) {}
+
+  /// Finish to assemble the matrix (the values are always in place)
+  void endAssembly(LSSMatrixAssemblyType assemblyType) {}
+
+  /// Print this matrix
+  void printToScreen() const;
+
+  /// Print this matrix to a file, one "row column value" line per entry
+  void printToFile(const char* fileName) const;
+
+  /// Set one value
+  void setValue(const CFint im,
+                const CFint in,
+                const CFreal value);
+
+  /// Set a list of values, given row by row
+  void setValues(const CFuint m,
+                 const CFint* im,
+                 const CFuint n,
+                 const CFint* in,
+                 const CFreal* values);
+
+  /// Add one value
+  void addValue(const CFint im,
+                const CFint in,
+                const CFreal value);
+
+  /// Add a list of values, given row by row
+  void addValues(const CFuint m,
+                 const CFint* im,
+                 const CFuint n,
+                 const CFint* in,
+                 const CFreal* values);
+
+  /// Get one value (0 outside the non zero structure)
+  void getValue(const CFint im,
+                const CFint in,
+                CFreal& value);
+
+  /// Get a list of values, row by row
+  void getValues(const CFuint m,
+                 const CFint* im,
+                 const CFuint n,
+                 const CFint* in,
+                 CFreal* values);
+
+  /// Set a row, diagonal and off-diagonals
+  void setRow(const CFuint row, CFreal diagval, CFreal offdiagval);
+
+  /// Set the diagonal
+  void setDiagonal(Framework::LSSVector& diag);
+
+  /// Add to the diagonal
+  void addToDiagonal(Framework::LSSVector& diag);
+
+  /// Reset to 0 all the non-zero elements of the matrix
+  void resetToZeroEntries();
+
+  /// Set the blocks of the accumulator
+  void setValues(const Framework::BlockAccumulator& acc);
+
+  /// Add the blocks of the accumulator
+  void addValues(const Framework::BlockAccumulator& acc);
+
+  /// Compress the non zero structure, adding the missing diagonal blocks
+  void freezeNonZeroStructure();
+
+  /// Tells if the non zero structure has been frozen
+  bool isFrozen() const {return m_isFrozen;}
+
+  /// Get the size of the blocks
+  CFuint getBlockSize() const {return m_nb;}
+
+  /// Get the number of block rows
+  CFuint getNbBlockRows() const {return m_nbRows;}
+
+  /// Get the number of block columns
+  CFuint getNbBlockCols() const {return m_nbCols;}
+
+  /// Get the start of each block row in the column and block arrays
+  /// @pre isFrozen()
+  const std::vector<CFuint>& getRowPtr() const {return m_rowPtr;}
+
+  /// Get the block column of each block
+  /// @pre isFrozen()
+  const std::vector<CFuint>& getCols() const {return m_cols;}
+
+  /// Get the position of the diagonal block of each block row
+  /// @pre isFrozen()
+  const std::vector<CFuint>& getDiagPtr() const {return m_diagPtr;}
+
+  /// Get the values of all the blocks
+  /// @pre isFrozen()
+  const std::vector<CFreal>& getBlocks() const {return m_values;}
+
+  /// Compute y = A x
+  /// @param x  array with the entries of all the block columns, ghosts included
+  /// @param y  array with the entries of all the block rows
+  /// @pre isFrozen()
+  void mult(const CFreal* x, CFreal* y) const;
+
+private: // functions
+
+  /// Get the block in the given block row and column
+  /// @param create  if true, the block is created if it is not in the
+  ///                structure yet and the structure is not frozen
+  /// @return the nb*nb values of the block or CFNULL
+  CFreal* getBlock(const CFuint row, const CFuint col, const bool create);
+
+  /// Set or add a single value
+  void setOrAddValue(const CFint im, const CFint in, const CFreal value, const bool add);
+
+  /// Set or add the blocks of an accumulator
+  void setOrAddValues(const Framework::BlockAccumulator& acc, const bool add);
+
+  /// Set or add the diagonal
+  void setOrAddDiagonal(Framework::LSSVector& diag, const bool add);
+
+private: // data
+
+  /// size of the blocks
+  CFuint m_nb;
+
+  /// number of block rows
+  CFuint m_nbRows;
+
+  /// number of block columns
+  CFuint m_nbCols;
+
+  /// flag telling if the non zero structure has been compressed
+  bool m_isFrozen;
+
+  /// sorted block columns of each block row, before freezing
+  std::vector<std::vector<CFuint> > m_buildCols;
+
+  /// blocks of each block row, before freezing
+  std::vector<std::vector<CFreal> > m_buildValues;
+
+  /// start of each block row in m_cols
+  std::vector<CFuint> m_rowPtr;
+
+  /// sorted block columns of each block row
+  std::vector<CFuint> m_cols;
+
+  /// position of the diagonal block of each block row
+  std::vector<CFuint> m_diagPtr;
+
+  /// values of the blocks, in the order of m_cols
+  std::vector<CFreal> m_values;
+
+  /// name of the matrix
+  std::string m_name;
+
+}; // end of class BCSRMatrix
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_BCSRMatrix_hh
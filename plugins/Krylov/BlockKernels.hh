@@ -0,0 +1,213 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_BlockKernels_hh
+#define COOLFluiD_Krylov_BlockKernels_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "Common/COOLFluiD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class provides the dense kernels acting on the nb x nb blocks of a
+/// BCSRMatrix, which are stored row by row.
+/// N is the block size when it is known at compile time, in which case all
+/// the loops have a constant trip count and can be unrolled and vectorized by
+/// the compiler, or 0 when the block size nb is only known at run time.
+/// @see dispatchBlockSize()
+template <CFuint N>
+class BlockKernels {
+public:
+
+  /// Get the actual block size
+  static CFuint size(const CFuint nb) {return (N > 0) ? N : nb;}
+
+  /// y = A x
+  /// The block A can be stored in single precision (T = float), in which
+  /// case the products are still accumulated in double precision
+  template <typename T>
+  static void mult(const CFuint nb, const T* a, const CFreal* x, CFreal* y)
+  {
+    const CFuint n = size(nb);
+    for (CFuint i = 0; i < n; ++i, a += n) {
+      CFreal sum = 0.;
+      for (CFuint j = 0; j < n; ++j) {
+	sum += a[j]*x[j];
+      }
+      y[i] = sum;
+    }
+  }
+
+  /// y += A x
+  static void multAdd(const CFuint nb, const CFreal* a, const CFreal* x, CFreal* y)
+  {
+    const CFuint n = size(nb);
+    for (CFuint i = 0; i < n; ++i, a += n) {
+      CFreal sum = 0.;
+      for (CFuint j = 0; j < n; ++j) {
+	sum += a[j]*x[j];
+      }
+      y[i] += sum;
+    }
+  }
+
+  /// y -= A x, A being stored in double or single precision (T)
+  template <typename T>
+  static void multSub(const CFuint nb, const T* a, const CFreal* x, CFreal* y)
+  {
+    const CFuint n = size(nb);
+    for (CFuint i = 0; i < n; ++i, a += n) {
+      CFreal sum = 0.;
+      for (CFuint j = 0; j < n; ++j) {
+	sum += a[j]*x[j];
+      }
+      y[i] -= sum;
+    }
+  }
+
+  /// C = A B
+  static void matMult(const CFuint nb, const CFreal* a, const CFreal* b, CFreal* c)
+  {
+    const CFuint n = size(nb);
+    for (CFuint i = 0; i < n; ++i) {
+      CFreal* ci = c + i*n;
+      for (CFuint j = 0; j < n; ++j) {
+	ci[j] = 0.;
+      }
+      for (CFuint k = 0; k < n; ++k) {
+	const CFreal aik = a[i*n + k];
+	const CFreal* bk = b + k*n;
+	for (CFuint j = 0; j < n; ++j) {
+	  ci[j] += aik*bk[j];
+	}
+      }
+    }
+  }
+
+  /// C -= A B
+  static void matMultSub(const CFuint nb, const CFreal* a, const CFreal* b, CFreal* c)
+  {
+    const CFuint n = size(nb);
+    for (CFuint i = 0; i < n; ++i) {
+      CFreal* ci = c + i*n;
+      for (CFuint k = 0; k < n; ++k) {
+	const CFreal aik = a[i*n + k];
+	const CFreal* bk = b + k*n;
+	for (CFuint j = 0; j < n; ++j) {
+	  ci[j] -= aik*bk[j];
+	}
+      }
+    }
+  }
+
+  /// Invert A in place by Gauss-Jordan elimination with partial pivoting
+  /// @param work  storage for nb*nb values
+  /// @return false if A is singular, in which case A is left undefined
+  static bool invert(const CFuint nb, CFreal* a, CFreal* work)
+  {
+    const CFuint n = size(nb);
+    const CFuint n2 = n*n;
+    for (CFuint i = 0; i < n2; ++i) {
+      work[i] = a[i];
+      a[i] = 0.;
+    }
+    for (CFuint i = 0; i < n; ++i) {
+      a[i*n + i] = 1.;
+    }
+
+    for (CFuint k = 0; k < n; ++k) {
+      // pivot = largest entry in column k, at or below the diagonal
+      CFuint p = k;
+      CFreal pmax = std::abs(work[k*n + k]);
+      for (CFuint i = k+1; i < n; ++i) {
+	const CFreal v = std::abs(work[i*n + k]);
+	if (v > pmax) {pmax = v; p = i;}
+      }
+      if (!(pmax > 0.)) return false;
+
+      if (p != k) {
+	for (CFuint j = 0; j < n; ++j) {
+	  std::swap(work[k*n + j], work[p*n + j]);
+	  std::swap(a[k*n + j], a[p*n + j]);
+	}
+      }
+
+      const CFreal invPivot = 1./work[k*n + k];
+      for (CFuint j = 0; j < n; ++j) {
+	work[k*n + j] *= invPivot;
+	a[k*n + j] *= invPivot;
+      }
+
+      for (CFuint i = 0; i < n; ++i) {
+	if (i == k) continue;
+	const CFreal f = work[i*n + k];
+	if (f == 0.) continue;
+	for (CFuint j = 0; j < n; ++j) {
+	  work[i*n + j] -= f*work[k*n + j];
+	  a[i*n + j] -= f*a[k*n + j];
+	}
+      }
+    }
+    return true;
+  }
+
+}; // end of class BlockKernels
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Largest block size for which the kernels are instantiated with a fixed size:
+/// bigger blocks use the run time size
+const CFuint MAX_FIXED_BLOCK_SIZE = 20;
+
+/// Call f.run<N>() with N = nb if nb <= MAX_FIXED_BLOCK_SIZE, f.run<0>() otherwise.
+/// FUNCTOR must provide a "template <CFuint N> void run()" member function.
+template <class FUNCTOR>
+void dispatchBlockSize(const CFuint nb, FUNCTOR& f)
+{
+  switch (nb) {
+  case 1:  f.template run<1>();  break;
+  case 2:  f.template run<2>();  break;
+  case 3:  f.template run<3>();  break;
+  case 4:  f.template run<4>();  break;
+  case 5:  f.template run<5>();  break;
+  case 6:  f.template run<6>();  break;
+  case 7:  f.template run<7>();  break;
+  case 8:  f.template run<8>();  break;
+  case 9:  f.template run<9>();  break;
+  case 10: f.template run<10>(); break;
+  case 11: f.template run<11>(); break;
+  case 12: f.template run<12>(); break;
+  case 13: f.template run<13>(); break;
+  case 14: f.template run<14>(); break;
+  case 15: f.template run<15>(); break;
+  case 16: f.template run<16>(); break;
+  case 17: f.template run<17>(); break;
+  case 18: f.template run<18>(); break;
+  case 19: f.template run<19>(); break;
+  case 20: f.template run<20>(); break;
+  default: f.template run<0>();  break;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_BlockKernels_hh
@@ -0,0 +1,408 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/CFLog.hh"
+#include "Common/BadValueException.hh"
+
+#include "Krylov/BCSRMatrix.hh"
+#include "Krylov/BlockKernels.hh"
+#include "Krylov/BlockPreconditioner.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Inverts the diagonal blocks with the kernels of the block size
+struct InvertDiagonalBlocks {
+  const CFuint nb;
+  const vector<CFuint>& diagPtr;
+  vector<CFreal>& blocks;
+  CFuint nbSingular;
+
+  InvertDiagonalBlocks(const CFuint inb, const vector<CFuint>& idiagPtr, vector<CFreal>& iblocks) :
+    nb(inb), diagPtr(idiagPtr), blocks(iblocks), nbSingular(0) {}
+
+  template <CFuint N>
+  void run()
+  {
+    const CFuint nb2 = nb*nb;
+    vector<CFreal> work(nb2);
+    for (CFuint i = 0; i < diagPtr.size(); ++i) {
+      CFreal* block = &blocks[diagPtr[i]*nb2];
+      if (!BlockKernels<N>::invert(nb, block, &work[0])) {
+	for (CFuint k = 0; k < nb2; ++k) {
+	  block[k] = (k % (nb+1) == 0) ? 1. : 0.;
+	}
+	++nbSingular;
+      }
+    }
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Applies the block Jacobi preconditioner with the kernels of the block size,
+/// the inverse blocks being stored with type T (CFreal or float)
+template <typename T>
+struct BlockJacobiApply {
+  const CFuint nb;
+  const vector<T>& invDiagBlocks;
+  const CFreal* r;
+  CFreal* z;
+
+  BlockJacobiApply(const CFuint inb, const vector<T>& iinvDiag, const CFreal* ir, CFreal* iz) :
+    nb(inb), invDiagBlocks(iinvDiag), r(ir), z(iz) {}
+
+  template <CFuint N>
+  void run()
+  {
+    const CFuint nb2 = nb*nb;
+    const CFuint nbRows = invDiagBlocks.size()/nb2;
+    if (nbRows == 0) return;
+    const T* invDiag = &invDiagBlocks[0];
+    for (CFuint i = 0; i < nbRows; ++i) {
+      BlockKernels<N>::mult(nb, invDiag + i*nb2, r + i*nb, z + i*nb);
+    }
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Computes the block ILU(0) factorization with the kernels of the block size
+struct BlockILU0Factorize {
+  BlockILU0Preconditioner& pc;
+  CFuint nbSingular;
+
+  BlockILU0Factorize(BlockILU0Preconditioner& ipc) : pc(ipc), nbSingular(0) {}
+
+  template <CFuint N>
+  void run()
+  {
+    const CFuint nb = pc.getBlockSize();
+    const CFuint nb2 = nb*nb;
+    const CFuint nbRows = pc.getNbBlockRows();
+    const vector<CFuint>& rowPtr = pc.getRowPtr();
+    const vector<CFuint>& cols = pc.getCols();
+    const vector<CFuint>& diagPtr = pc.getDiagPtr();
+    CFreal* lu = &pc.getFactors()[0];
+
+    // position in the current row of each block column, -1 if not present
+    vector<CFint> colPos(nbRows, -1);
+    vector<CFreal> tmp(nb2);
+    vector<CFreal> work(nb2);
+
+    for (CFuint i = 0; i < nbRows; ++i) {
+      for (CFuint k = rowPtr[i]; k < rowPtr[i+1]; ++k) {
+	colPos[cols[k]] = k;
+      }
+
+      // eliminate the blocks of the strictly lower part, using the rows
+      // already factorized, whose diagonal block holds the inverse of U_kk
+      for (CFuint ik = rowPtr[i]; ik < diagPtr[i]; ++ik) {
+	const CFuint k = cols[ik];
+	CFreal* lik = lu + ik*nb2;
+	std::copy(lik, lik + nb2, tmp.begin());
+	BlockKernels<N>::matMult(nb, &tmp[0], lu + diagPtr[k]*nb2, lik);
+
+	for (CFuint kj = diagPtr[k]+1; kj < rowPtr[k+1]; ++kj) {
+	  const CFint ij = colPos[cols[kj]];
+	  if (ij >= 0) {
+	    BlockKernels<N>::matMultSub(nb, lik, lu + kj*nb2, lu + ij*nb2);
+	  }
+	}
+      }
+
+      CFreal* uii = lu + diagPtr[i]*nb2;
+      if (!BlockKernels<N>::invert(nb, uii, &work[0])) {
+	for (CFuint k = 0; k < nb2; ++k) {
+	  uii[k] = (k % (nb+1) == 0) ? 1. : 0.;
+	}
+	++nbSingular;
+      }
+
+      for (CFuint k = rowPtr[i]; k < rowPtr[i+1]; ++k) {
+	colPos[cols[k]] = -1;
+      }
+    }
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Applies the block ILU(0) factorization with the kernels of the block size,
+/// the factors being stored with type T (CFreal or float)
+template <typename T>
+struct BlockILU0Apply {
+  const BlockILU0Preconditioner& pc;
+  const vector<T>& factors;
+  const CFreal* r;
+  CFreal* z;
+
+  BlockILU0Apply(const BlockILU0Preconditioner& ipc, const vector<T>& ifactors,
+		 const CFreal* ir, CFreal* iz) :
+    pc(ipc), factors(ifactors), r(ir), z(iz) {}
+
+  template <CFuint N>
+  void run()
+  {
+    const CFuint nb = pc.getBlockSize();
+    const CFuint nb2 = nb*nb;
+    const CFuint nbRows = pc.getNbBlockRows();
+    if (nbRows == 0) return;
+    const CFuint* rowPtr = &pc.getRowPtr()[0];
+    const CFuint* cols = &pc.getCols()[0];
+    const CFuint* diagPtr = &pc.getDiagPtr()[0];
+    const T* lu = &factors[0];
+
+    // forward substitution: L y = r
+    for (CFuint i = 0; i < nbRows; ++i) {
+      CFreal* zi = z + i*nb;
+      for (CFuint ib = 0; ib < nb; ++ib) {
+	zi[ib] = r[i*nb + ib];
+      }
+      for (CFuint k = rowPtr[i]; k < diagPtr[i]; ++k) {
+	BlockKernels<N>::multSub(nb, lu + k*nb2, z + cols[k]*nb, zi);
+      }
+    }
+
+    // backward substitution: U z = y
+    vector<CFreal> tmp(nb);
+    for (CFuint i = nbRows; i > 0; --i) {
+      const CFuint row = i-1;
+      CFreal* zi = z + row*nb;
+      for (CFuint ib = 0; ib < nb; ++ib) {
+	tmp[ib] = zi[ib];
+      }
+      for (CFuint k = diagPtr[row]+1; k < rowPtr[row+1]; ++k) {
+	BlockKernels<N>::multSub(nb, lu + k*nb2, z + cols[k]*nb, &tmp[0]);
+      }
+      BlockKernels<N>::mult(nb, lu + diagPtr[row]*nb2, &tmp[0], zi);
+    }
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockPreconditioner* BlockPreconditioner::create(const std::string& type,
+						 const bool singlePrecision)
+{
+  if (type == "BILU0")   return new BlockILU0Preconditioner(singlePrecision);
+  if (type == "BJacobi") return new BlockJacobiPreconditioner(singlePrecision);
+  if (type == "None")    return new NullPreconditioner();
+
+  throw Common::BadValueException
+    (FromHere(), "BlockPreconditioner::create() => unknown preconditioner type: " + type);
+  return CFNULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockPreconditioner::BlockPreconditioner()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockPreconditioner::~BlockPreconditioner()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockPreconditioner::invertDiagonalBlocks(const CFuint nb,
+					       const vector<CFuint>& diagPtr,
+					       vector<CFreal>& blocks)
+{
+  InvertDiagonalBlocks f(nb, diagPtr, blocks);
+  dispatchBlockSize(nb, f);
+
+  if (f.nbSingular > 0) {
+    CFLog(WARN, "BlockPreconditioner => " << f.nbSingular
+	  << " singular diagonal blocks replaced by the identity\n");
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+NullPreconditioner::NullPreconditioner() :
+  BlockPreconditioner(),
+  m_size(0)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void NullPreconditioner::setup(const BCSRMatrix& mat)
+{
+  m_size = mat.getNbBlockRows()*mat.getBlockSize();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void NullPreconditioner::apply(const CFreal* r, CFreal* z) const
+{
+  std::copy(r, r + m_size, z);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockJacobiPreconditioner::BlockJacobiPreconditioner(const bool singlePrecision) :
+  BlockPreconditioner(),
+  m_nb(0),
+  m_singlePrecision(singlePrecision),
+  m_invDiag(),
+  m_invDiagSP()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockJacobiPreconditioner::setup(const BCSRMatrix& mat)
+{
+  cf_assert(mat.isFrozen());
+
+  m_nb = mat.getBlockSize();
+  const CFuint nb2 = m_nb*m_nb;
+  const CFuint nbRows = mat.getNbBlockRows();
+  const vector<CFuint>& matDiagPtr = mat.getDiagPtr();
+  const vector<CFreal>& matBlocks = mat.getBlocks();
+
+  m_invDiag.resize(nbRows*nb2);
+  vector<CFuint> diagPtr(nbRows);
+  for (CFuint i = 0; i < nbRows; ++i) {
+    std::copy(&matBlocks[matDiagPtr[i]*nb2], &matBlocks[matDiagPtr[i]*nb2] + nb2,
+	      &m_invDiag[i*nb2]);
+    diagPtr[i] = i;
+  }
+
+  invertDiagonalBlocks(m_nb, diagPtr, m_invDiag);
+
+  // only the single precision copy is kept
+  if (m_singlePrecision) {
+    m_invDiagSP.assign(m_invDiag.begin(), m_invDiag.end());
+    vector<CFreal>().swap(m_invDiag);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockJacobiPreconditioner::apply(const CFreal* r, CFreal* z) const
+{
+  if (m_singlePrecision) {
+    BlockJacobiApply<float> f(m_nb, m_invDiagSP, r, z);
+    dispatchBlockSize(m_nb, f);
+  }
+  else {
+    BlockJacobiApply<CFreal> f(m_nb, m_invDiag, r, z);
+    dispatchBlockSize(m_nb, f);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockILU0Preconditioner::BlockILU0Preconditioner(const bool singlePrecision) :
+  BlockPreconditioner(),
+  m_nb(0),
+  m_singlePrecision(singlePrecision),
+  m_rowPtr(),
+  m_cols(),
+  m_diagPtr(),
+  m_lu(),
+  m_luSP()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockILU0Preconditioner::setup(const BCSRMatrix& mat)
+{
+  cf_assert(mat.isFrozen());
+
+  m_nb = mat.getBlockSize();
+  const CFuint nb2 = m_nb*m_nb;
+  const CFuint nbRows = mat.getNbBlockRows();
+  const vector<CFuint>& matRowPtr = mat.getRowPtr();
+  const vector<CFuint>& matCols = mat.getCols();
+  const vector<CFreal>& matBlocks = mat.getBlocks();
+
+  // the structure only changes if the matrix is recreated: keep it otherwise
+  const bool newStructure = (m_diagPtr.size() != nbRows || m_rowPtr.empty());
+  if (newStructure) {
+    m_rowPtr.resize(nbRows+1);
+    m_diagPtr.resize(nbRows);
+    m_cols.clear();
+    m_rowPtr[0] = 0;
+    for (CFuint i = 0; i < nbRows; ++i) {
+      for (CFuint k = matRowPtr[i]; k < matRowPtr[i+1]; ++k) {
+	const CFuint col = matCols[k];
+	// the blocks coupling with the ghost states are dropped
+	if (col < nbRows) {
+	  if (col == i) m_diagPtr[i] = m_cols.size();
+	  m_cols.push_back(col);
+	}
+      }
+      m_rowPtr[i+1] = m_cols.size();
+    }
+  }
+  // the double precision factors are released after each factorization
+  // if only the single precision ones are kept
+  m_lu.resize(m_cols.size()*nb2);
+
+  CFuint ilu = 0;
+  for (CFuint i = 0; i < nbRows; ++i) {
+    for (CFuint k = matRowPtr[i]; k < matRowPtr[i+1]; ++k) {
+      if (matCols[k] < nbRows) {
+	std::copy(&matBlocks[k*nb2], &matBlocks[k*nb2] + nb2, &m_lu[ilu*nb2]);
+	++ilu;
+      }
+    }
+  }
+  cf_assert(ilu == m_cols.size());
+
+  BlockILU0Factorize f(*this);
+  dispatchBlockSize(m_nb, f);
+
+  if (f.nbSingular > 0) {
+    CFLog(WARN, "BlockILU0Preconditioner::setup() => " << f.nbSingular
+	  << " singular pivot blocks replaced by the identity\n");
+  }
+
+  if (m_singlePrecision) {
+    m_luSP.assign(m_lu.begin(), m_lu.end());
+    vector<CFreal>().swap(m_lu);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockILU0Preconditioner::apply(const CFreal* r, CFreal* z) const
+{
+  if (m_singlePrecision) {
+    BlockILU0Apply<float> f(*this, m_luSP, r, z);
+    dispatchBlockSize(m_nb, f);
+  }
+  else {
+    BlockILU0Apply<CFreal> f(*this, m_lu, r, z);
+    dispatchBlockSize(m_nb, f);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_BlockPreconditioner_hh
+#define COOLFluiD_Krylov_BlockPreconditioner_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include "Common/NonCopyable.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+    class BCSRMatrix;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a preconditioner of the Krylov solver built from
+/// a BCSRMatrix. It only uses the blocks coupling the states updatable by
+/// this processor, which, in parallel, gives a block Jacobi preconditioner
+/// over the processors with the chosen local preconditioner.
+class BlockPreconditioner : public Common::NonCopyable<BlockPreconditioner> {
+public:
+
+  /// Create a preconditioner
+  /// @param type  "BILU0" (block ILU(0)), "BJacobi" (inverse of the
+  ///              diagonal blocks) or "None"
+  /// @param singlePrecision  store the factors in single precision
+  /// @post the preconditioner has to be deleted outside
+  static BlockPreconditioner* create(const std::string& type,
+				     const bool singlePrecision = false);
+
+  /// Constructor
+  BlockPreconditioner();
+
+  /// Destructor
+  virtual ~BlockPreconditioner();
+
+  /// Compute the preconditioner from the given matrix
+  /// @pre mat.isFrozen()
+  virtual void setup(const BCSRMatrix& mat) = 0;
+
+  /// Compute z = M^-1 r on the entries of the updatable states
+  virtual void apply(const CFreal* r, CFreal* z) const = 0;
+
+protected:
+
+  /// Invert in place the diagonal blocks at the given positions of blocks,
+  /// replacing the singular ones with the identity
+  static void invertDiagonalBlocks(const CFuint nb,
+				   const std::vector<CFuint>& diagPtr,
+				   std::vector<CFreal>& blocks);
+
+}; // end of class BlockPreconditioner
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents the identity preconditioner
+class NullPreconditioner : public BlockPreconditioner {
+public:
+
+  /// Constructor
+  NullPreconditioner();
+
+  /// Store the size of the system
+  void setup(const BCSRMatrix& mat);
+
+  /// Compute z = r
+  void apply(const CFreal* r, CFreal* z) const;
+
+private:
+
+  /// number of entries of the updatable states
+  CFuint m_size;
+
+}; // end of class NullPreconditioner
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents the point block Jacobi preconditioner, which
+/// multiplies each block of the vector by the inverse of the corresponding
+/// diagonal block of the matrix.
+/// The inverse blocks are computed in double precision and can be stored
+/// in single precision, halving the memory read by apply().
+class BlockJacobiPreconditioner : public BlockPreconditioner {
+public:
+
+  /// Constructor
+  /// @param singlePrecision  store the inverse blocks in single precision
+  explicit BlockJacobiPreconditioner(const bool singlePrecision = false);
+
+  /// Invert the diagonal blocks
+  void setup(const BCSRMatrix& mat);
+
+  /// Compute z = D^-1 r
+  void apply(const CFreal* r, CFreal* z) const;
+
+  /// Get the size of the blocks
+  CFuint getBlockSize() const {return m_nb;}
+
+private:
+
+  /// size of the blocks
+  CFuint m_nb;
+
+  /// flag telling to store the inverse blocks in single precision
+  bool m_singlePrecision;
+
+  /// inverse of the diagonal blocks
+  std::vector<CFreal> m_invDiag;
+
+  /// inverse of the diagonal blocks in single precision
+  std::vector<float> m_invDiagSP;
+
+}; // end of class BlockJacobiPreconditioner
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents the block incomplete LU factorization without fill
+/// (ILU(0)) of the blocks of the matrix coupling the updatable states.
+/// The factors are stored in the BCSR structure of those blocks: strictly
+/// lower blocks of L (with identity diagonal), strictly upper blocks of U
+/// and the inverse of the diagonal blocks of U.
+/// The factorization is computed in double precision, while the factors
+/// can be stored in single precision for the substitutions.
+class BlockILU0Preconditioner : public BlockPreconditioner {
+public:
+
+  /// Constructor
+  /// @param singlePrecision  store the factors in single precision
+  explicit BlockILU0Preconditioner(const bool singlePrecision = false);
+
+  /// Compute the factorization
+  void setup(const BCSRMatrix& mat);
+
+  /// Compute z = (LU)^-1 r by forward and backward substitution
+  void apply(const CFreal* r, CFreal* z) const;
+
+  /// Get the size of the blocks
+  CFuint getBlockSize() const {return m_nb;}
+
+  /// Get the number of block rows
+  CFuint getNbBlockRows() const {return m_diagPtr.size();}
+
+  /// Get the start of each block row
+  const std::vector<CFuint>& getRowPtr() const {return m_rowPtr;}
+
+  /// Get the block column of each block
+  const std::vector<CFuint>& getCols() const {return m_cols;}
+
+  /// Get the position of the diagonal block of each block row
+  const std::vector<CFuint>& getDiagPtr() const {return m_diagPtr;}
+
+  /// Get the factors during the factorization
+  std::vector<CFreal>& getFactors() {return m_lu;}
+
+private:
+
+  /// size of the blocks
+  CFuint m_nb;
+
+  /// flag telling to store the factors in single precision
+  bool m_singlePrecision;
+
+  /// start of each block row in m_cols
+  std::vector<CFuint> m_rowPtr;
+
+  /// block column of each block
+  std::vector<CFuint> m_cols;
+
+  /// position of the diagonal block of each block row
+  std::vector<CFuint> m_diagPtr;
+
+  /// factors
+  std::vector<CFreal> m_lu;
+
+  /// factors in single precision
+  std::vector<float> m_luSP;
+
+}; // end of class BlockILU0Preconditioner
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_BlockPreconditioner_hh
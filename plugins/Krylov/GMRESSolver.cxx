@@ -0,0 +1,259 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cmath>
+
+#include "Common/CFLog.hh"
+
+#include "Krylov/BCSRMatrix.hh"
+#include "Krylov/BlockPreconditioner.hh"
+#include "Krylov/GhostSync.hh"
+#include "Krylov/GMRESSolver.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+GMRESSolver::GMRESSolver() :
+  m_nbKrylov(30),
+  m_maxIter(1000),
+  m_rTol(1e-5),
+  m_aTol(1e-30),
+  m_flexible(false),
+  m_size(0),
+  m_res0(0.),
+  m_res(0.),
+  m_v(),
+  m_z(),
+  m_ext(),
+  m_w(),
+  m_h(),
+  m_cs(),
+  m_sn(),
+  m_g()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+GMRESSolver::~GMRESSolver()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GMRESSolver::setParameters(const CFuint nbKrylov,
+				const CFuint maxIter,
+				const CFreal rTol,
+				const CFreal aTol,
+				const bool flexible)
+{
+  cf_assert(nbKrylov > 0);
+  m_nbKrylov = nbKrylov;
+  m_maxIter = maxIter;
+  m_rTol = rTol;
+  m_aTol = aTol;
+  m_flexible = flexible;
+  clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GMRESSolver::clear()
+{
+  m_size = 0;
+  vector<CFreal>().swap(m_v);
+  vector<CFreal>().swap(m_z);
+  vector<CFreal>().swap(m_ext);
+  vector<CFreal>().swap(m_w);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal GMRESSolver::norm(GhostSync& sync, const CFreal* x) const
+{
+  CFreal sum = 0.;
+  for (CFuint i = 0; i < m_size; ++i) {
+    sum += x[i]*x[i];
+  }
+  return std::sqrt(sync.sum(sum));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GMRESSolver::mult(const BCSRMatrix& mat, GhostSync& sync, const CFreal* x, CFreal* y)
+{
+  std::copy(x, x + m_size, m_ext.begin());
+  sync.synchronize(&m_ext[0]);
+  mat.mult(&m_ext[0], y);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal GMRESSolver::computeResidual(const BCSRMatrix& mat, GhostSync& sync,
+				    const CFreal* b, const CFreal* x, CFreal* r)
+{
+  mult(mat, sync, x, r);
+  for (CFuint i = 0; i < m_size; ++i) {
+    r[i] = b[i] - r[i];
+  }
+  return norm(sync, r);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint GMRESSolver::solve(const BCSRMatrix& mat,
+			  const BlockPreconditioner& pc,
+			  GhostSync& sync,
+			  const CFreal* b,
+			  CFreal* x)
+{
+  const CFuint m = m_nbKrylov;
+  const CFuint n = mat.getNbBlockRows()*mat.getBlockSize();
+  if (n != m_size) {
+    m_size = n;
+    m_v.resize((m+1)*n);
+    m_z.resize((m_flexible) ? m*n : n);
+    m_w.resize(n);
+    m_ext.resize(mat.getNbBlockCols()*mat.getBlockSize());
+  }
+  m_h.resize((m+1)*m);
+  m_cs.resize(m);
+  m_sn.resize(m);
+  m_g.resize(m+1);
+
+  CFreal* v = &m_v[0];
+  CFreal* w = &m_w[0];
+
+  CFreal beta = computeResidual(mat, sync, b, x, v);
+  m_res0 = m_res = beta;
+  const CFreal tol = std::max(m_rTol*beta, m_aTol);
+
+  CFuint iter = 0;
+  bool converged = (beta <= tol);
+  while (!converged && iter < m_maxIter) {
+    for (CFuint i = 0; i < n; ++i) {
+      v[i] /= beta;
+    }
+    m_g.assign(m+1, 0.);
+    m_g[0] = beta;
+
+    CFuint k = 0;
+    for (; k < m && !converged && iter < m_maxIter; ++k, ++iter) {
+      CFreal* vk = v + k*n;
+      CFreal* zk = (m_flexible) ? &m_z[k*n] : &m_z[0];
+      pc.apply(vk, zk);
+      mult(mat, sync, zk, w);
+
+      // classical Gram-Schmidt: all the projections with one reduction
+      CFreal* hk = &m_h[k*(m+1)];
+      for (CFuint j = 0; j <= k; ++j) {
+	const CFreal* vj = v + j*n;
+	CFreal dot = 0.;
+	for (CFuint i = 0; i < n; ++i) {
+	  dot += vj[i]*w[i];
+	}
+	hk[j] = dot;
+      }
+      sync.sum(hk, k+1);
+      for (CFuint j = 0; j <= k; ++j) {
+	const CFreal* vj = v + j*n;
+	const CFreal hjk = hk[j];
+	for (CFuint i = 0; i < n; ++i) {
+	  w[i] -= hjk*vj[i];
+	}
+      }
+      hk[k+1] = norm(sync, w);
+
+      CFreal* vk1 = v + (k+1)*n;
+      if (hk[k+1] > 0.) {
+	const CFreal invNorm = 1./hk[k+1];
+	for (CFuint i = 0; i < n; ++i) {
+	  vk1[i] = w[i]*invNorm;
+	}
+      }
+
+      // apply the previous rotations to the new column and compute a new one
+      for (CFuint j = 0; j < k; ++j) {
+	const CFreal tmp = m_cs[j]*hk[j] + m_sn[j]*hk[j+1];
+	hk[j+1] = -m_sn[j]*hk[j] + m_cs[j]*hk[j+1];
+	hk[j] = tmp;
+      }
+      const CFreal r = std::sqrt(hk[k]*hk[k] + hk[k+1]*hk[k+1]);
+      m_cs[k] = (r > 0.) ? hk[k]/r : 1.;
+      m_sn[k] = (r > 0.) ? hk[k+1]/r : 0.;
+      hk[k] = r;
+      hk[k+1] = 0.;
+      m_g[k+1] = -m_sn[k]*m_g[k];
+      m_g[k] *= m_cs[k];
+
+      m_res = std::abs(m_g[k+1]);
+      CFLog(DEBUG_MIN, "GMRESSolver::solve() => iter " << iter+1 << ", residual " << m_res << "\n");
+      converged = (m_res <= tol);
+    }
+
+    // solve the upper triangular system H y = g, y overwriting g
+    for (CFuint jj = k; jj > 0; --jj) {
+      const CFuint j = jj-1;
+      CFreal sum = m_g[j];
+      for (CFuint l = j+1; l < k; ++l) {
+	sum -= m_h[l*(m+1) + j]*m_g[l];
+      }
+      m_g[j] = (m_h[j*(m+1) + j] != 0.) ? sum/m_h[j*(m+1) + j] : 0.;
+    }
+
+    // update the solution
+    if (m_flexible) {
+      for (CFuint j = 0; j < k; ++j) {
+	const CFreal* zj = &m_z[j*n];
+	const CFreal yj = m_g[j];
+	for (CFuint i = 0; i < n; ++i) {
+	  x[i] += yj*zj[i];
+	}
+      }
+    }
+    else {
+      std::fill(w, w + n, 0.);
+      for (CFuint j = 0; j < k; ++j) {
+	const CFreal* vj = v + j*n;
+	const CFreal yj = m_g[j];
+	for (CFuint i = 0; i < n; ++i) {
+	  w[i] += yj*vj[i];
+	}
+      }
+      pc.apply(w, &m_z[0]);
+      for (CFuint i = 0; i < n; ++i) {
+	x[i] += m_z[i];
+      }
+    }
+
+    // restart from the true residual
+    if (!converged && iter < m_maxIter) {
+      beta = computeResidual(mat, sync, b, x, v);
+      m_res = beta;
+      converged = (beta <= tol);
+    }
+  }
+
+  return iter;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
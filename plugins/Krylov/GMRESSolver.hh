@@ -0,0 +1,146 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_GMRESSolver_hh
+#define COOLFluiD_Krylov_GMRESSolver_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/NonCopyable.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+    class BCSRMatrix;
+    class BlockPreconditioner;
+    class GhostSync;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class implements the restarted GMRES method with right
+/// preconditioning and its flexible variant (FGMRES), which stores the
+/// preconditioned Krylov vectors and allows the preconditioner to change
+/// from one iteration to the next.
+/// The Krylov basis is orthogonalized with the classical Gram-Schmidt
+/// method, so that each iteration needs a single global reduction for the
+/// projections.
+/// Convergence is reached when the norm of the residual is below
+/// max(rTol*|r0|, aTol).
+class GMRESSolver : public Common::NonCopyable<GMRESSolver> {
+public:
+
+  /// Constructor
+  GMRESSolver();
+
+  /// Destructor
+  ~GMRESSolver();
+
+  /// Set the parameters of the method
+  /// @param nbKrylov  number of Krylov vectors before a restart
+  /// @param flexible  use FGMRES instead of GMRES
+  void setParameters(const CFuint nbKrylov,
+		     const CFuint maxIter,
+		     const CFreal rTol,
+		     const CFreal aTol,
+		     const bool flexible);
+
+  /// Solve A x = b
+  /// @param b  right hand side (entries of the updatable states)
+  /// @param x  initial guess and solution (entries of the updatable states)
+  /// @return the number of iterations
+  CFuint solve(const BCSRMatrix& mat,
+	       const BlockPreconditioner& pc,
+	       GhostSync& sync,
+	       const CFreal* b,
+	       CFreal* x);
+
+  /// Get the norm of the initial residual of the last solve
+  CFreal getInitialResidual() const {return m_res0;}
+
+  /// Get the norm of the final residual of the last solve
+  CFreal getFinalResidual() const {return m_res;}
+
+  /// Free the work arrays
+  void clear();
+
+private: // functions
+
+  /// Compute r = b - A x and return its norm
+  CFreal computeResidual(const BCSRMatrix& mat, GhostSync& sync,
+			 const CFreal* b, const CFreal* x, CFreal* r);
+
+  /// Compute y = A x
+  void mult(const BCSRMatrix& mat, GhostSync& sync, const CFreal* x, CFreal* y);
+
+  /// Compute the global norm of a vector of size m_size
+  CFreal norm(GhostSync& sync, const CFreal* x) const;
+
+private: // data
+
+  /// number of Krylov vectors before a restart
+  CFuint m_nbKrylov;
+
+  /// maximum number of iterations
+  CFuint m_maxIter;
+
+  /// relative tolerance
+  CFreal m_rTol;
+
+  /// absolute tolerance
+  CFreal m_aTol;
+
+  /// flag telling if FGMRES is used
+  bool m_flexible;
+
+  /// number of entries of the updatable states
+  CFuint m_size;
+
+  /// norm of the initial residual
+  CFreal m_res0;
+
+  /// norm of the final residual
+  CFreal m_res;
+
+  /// Krylov basis, m_nbKrylov+1 vectors of size m_size
+  std::vector<CFreal> m_v;
+
+  /// preconditioned Krylov basis (FGMRES), m_nbKrylov vectors of size m_size
+  std::vector<CFreal> m_z;
+
+  /// vector with the ghost entries, input of the matrix-vector product
+  std::vector<CFreal> m_ext;
+
+  /// work vector of size m_size
+  std::vector<CFreal> m_w;
+
+  /// Hessenberg matrix, column by column
+  std::vector<CFreal> m_h;
+
+  /// cosines of the Givens rotations
+  std::vector<CFreal> m_cs;
+
+  /// sines of the Givens rotations
+  std::vector<CFreal> m_sn;
+
+  /// rotated right hand side of the least squares problem
+  std::vector<CFreal> m_g;
+
+}; // end of class GMRESSolver
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_GMRESSolver_hh
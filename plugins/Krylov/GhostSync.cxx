@@ -0,0 +1,200 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/CFLog.hh"
+
+#ifdef CF_HAVE_MPI
+#include "Common/MPI/MPIStructDef.hh"
+#endif
+
+#include "Krylov/GhostSync.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// tag of the messages exchanged by GhostSync
+static const int KRYLOV_GHOST_TAG = 2903;
+
+//////////////////////////////////////////////////////////////////////////////
+
+GhostSync::GhostSync() :
+  m_nsp(),
+  m_isParallel(false),
+  m_packList(),
+  m_unpackList(),
+  m_sendBuffer(),
+  m_receiveBuffer()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+GhostSync::~GhostSync()
+{
+  clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GhostSync::setupSerial(const std::string& nsp)
+{
+  clear();
+  m_nsp = nsp;
+  m_isParallel = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GhostSync::setup(const std::string& nsp,
+		      const vector<vector<CFuint> >& sendList,
+		      const vector<vector<CFuint> >& receiveList,
+		      const valarray<CFuint>& localToLSS,
+		      const CFuint blockSize)
+{
+  clear();
+  m_nsp = nsp;
+  m_isParallel = PE::GetPE().IsParallel();
+  if (!m_isParallel) return;
+
+#ifdef CF_HAVE_MPI
+  const CFuint nbRanks = PE::GetPE().GetProcessorCount(nsp);
+  const CFuint myRank  = PE::GetPE().GetRank(nsp);
+  cf_assert(sendList.size() == nbRanks);
+  cf_assert(receiveList.size() == nbRanks);
+
+  MPI_Comm comm = PE::GetPE().GetCommunicator(nsp);
+  MPI_Datatype MPI_CFREAL = MPIStructDef::getMPIType(static_cast<CFreal*>(CFNULL));
+
+  CFuint nbSend = 0;
+  CFuint nbReceive = 0;
+  for (CFuint iRank = 0; iRank < nbRanks; ++iRank) {
+    nbSend += sendList[iRank].size()*blockSize;
+    nbReceive += receiveList[iRank].size()*blockSize;
+  }
+  m_packList.reserve(nbSend);
+  m_unpackList.reserve(nbReceive);
+  m_sendBuffer.resize(nbSend);
+  m_receiveBuffer.resize(nbReceive);
+
+  // the send and receive lists of two ranks list the same states in the
+  // same order: the buffers can be set up once with persistent requests
+  for (CFuint iRank = 0; iRank < nbRanks; ++iRank) {
+    if (iRank == myRank) continue;
+
+    const CFuint receiveStart = m_unpackList.size();
+    for (CFuint i = 0; i < receiveList[iRank].size(); ++i) {
+      const CFuint start = localToLSS[receiveList[iRank][i]]*blockSize;
+      for (CFuint k = 0; k < blockSize; ++k) {
+	m_unpackList.push_back(start + k);
+      }
+    }
+    if (m_unpackList.size() > receiveStart) {
+      MPI_Request request;
+      CheckMPIStatus(MPI_Recv_init(&m_receiveBuffer[receiveStart],
+				   m_unpackList.size() - receiveStart, MPI_CFREAL,
+				   iRank, KRYLOV_GHOST_TAG, comm, &request));
+      m_requests.push_back(request);
+    }
+
+    const CFuint sendStart = m_packList.size();
+    for (CFuint i = 0; i < sendList[iRank].size(); ++i) {
+      const CFuint start = localToLSS[sendList[iRank][i]]*blockSize;
+      for (CFuint k = 0; k < blockSize; ++k) {
+	m_packList.push_back(start + k);
+      }
+    }
+    if (m_packList.size() > sendStart) {
+      MPI_Request request;
+      CheckMPIStatus(MPI_Send_init(&m_sendBuffer[sendStart],
+				   m_packList.size() - sendStart, MPI_CFREAL,
+				   iRank, KRYLOV_GHOST_TAG, comm, &request));
+      m_requests.push_back(request);
+    }
+  }
+
+  CFLog(VERBOSE, "GhostSync::setup() => " << m_packList.size() << " values sent, "
+	<< m_unpackList.size() << " values received per synchronization\n");
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GhostSync::clear()
+{
+#ifdef CF_HAVE_MPI
+  for (CFuint i = 0; i < m_requests.size(); ++i) {
+    MPI_Request_free(&m_requests[i]);
+  }
+  m_requests.clear();
+#endif
+
+  vector<CFuint>().swap(m_packList);
+  vector<CFuint>().swap(m_unpackList);
+  vector<CFreal>().swap(m_sendBuffer);
+  vector<CFreal>().swap(m_receiveBuffer);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GhostSync::synchronize(CFreal* x)
+{
+#ifdef CF_HAVE_MPI
+  if (m_requests.empty()) return;
+
+  const CFuint nbPack = m_packList.size();
+  for (CFuint i = 0; i < nbPack; ++i) {
+    m_sendBuffer[i] = x[m_packList[i]];
+  }
+
+  CheckMPIStatus(MPI_Startall(m_requests.size(), &m_requests[0]));
+  CheckMPIStatus(MPI_Waitall(m_requests.size(), &m_requests[0], MPI_STATUSES_IGNORE));
+
+  const CFuint nbUnpack = m_unpackList.size();
+  for (CFuint i = 0; i < nbUnpack; ++i) {
+    x[m_unpackList[i]] = m_receiveBuffer[i];
+  }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal GhostSync::sum(const CFreal value) const
+{
+  CFreal result = value;
+  sum(&result, 1);
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GhostSync::sum(CFreal* values, const CFuint size) const
+{
+#ifdef CF_HAVE_MPI
+  if (!m_isParallel) return;
+
+  MPI_Datatype MPI_CFREAL = MPIStructDef::getMPIType(values);
+  CheckMPIStatus(MPI_Allreduce(MPI_IN_PLACE, values, size, MPI_CFREAL, MPI_SUM,
+			       PE::GetPE().GetCommunicator(m_nsp)));
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,107 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_GhostSync_hh
+#define COOLFluiD_Krylov_GhostSync_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <valarray>
+#include <vector>
+
+#include "Common/NonCopyable.hh"
+#include "Common/PE.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class performs the parallel operations needed by the Krylov solver
+/// on the arrays of the linear system: the update of the ghost entries and
+/// the global reductions.
+/// The arrays store, block after block, the updatable states of this
+/// processor first and its ghost states after. The exchange pattern is
+/// derived from the ghost send and receive lists of the states DataHandle,
+/// so that no other parallel index mapping is needed.
+/// In a serial run all the operations are local.
+class GhostSync : public Common::NonCopyable<GhostSync> {
+public:
+
+  /// Constructor
+  GhostSync();
+
+  /// Destructor
+  ~GhostSync();
+
+  /// Set up the exchange pattern
+  /// @param nsp           namespace whose communicator is used
+  /// @param sendList      local IDs of the states to send to each rank
+  /// @param receiveList   local IDs of the ghost states to receive from each rank
+  /// @param localToLSS    position of each local state in the arrays
+  /// @param blockSize     number of entries per state
+  void setup(const std::string& nsp,
+	     const std::vector<std::vector<CFuint> >& sendList,
+	     const std::vector<std::vector<CFuint> >& receiveList,
+	     const std::valarray<CFuint>& localToLSS,
+	     const CFuint blockSize);
+
+  /// Set up a serial (no exchange) pattern
+  void setupSerial(const std::string& nsp);
+
+  /// Free the exchange pattern
+  void clear();
+
+  /// Update the ghost entries of the given array with the values of the
+  /// processors owning them
+  void synchronize(CFreal* x);
+
+  /// Global sum of a value over all the processors
+  CFreal sum(const CFreal value) const;
+
+  /// Global sum of an array of values over all the processors (in place)
+  void sum(CFreal* values, const CFuint size) const;
+
+private: // data
+
+  /// name of the namespace
+  std::string m_nsp;
+
+  /// flag telling if the run is parallel
+  bool m_isParallel;
+
+  /// positions in the arrays of the entries to pack, rank after rank
+  std::vector<CFuint> m_packList;
+
+  /// positions in the arrays of the entries to unpack, rank after rank
+  std::vector<CFuint> m_unpackList;
+
+  /// send buffer
+  std::vector<CFreal> m_sendBuffer;
+
+  /// receive buffer
+  std::vector<CFreal> m_receiveBuffer;
+
+#ifdef CF_HAVE_MPI
+  /// persistent send and receive requests
+  std::vector<MPI_Request> m_requests;
+#endif
+
+}; // end of class GhostSync
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_GhostSync_hh
@@ -0,0 +1,54 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_hh
+#define COOLFluiD_Krylov_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Environment/ModuleRegister.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  /// The classes that implement a built-in Krylov linear system solver
+  /// for block sparse matrices, without external dependencies
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class defines the Module Krylov
+class KrylovModule : public Environment::ModuleRegister<KrylovModule> {
+public:
+
+  /// Static function that returns the module name.
+  /// Must be implemented for the ModuleRegister template
+  /// @return name of the module
+  static std::string getModuleName()
+  {
+    return "Krylov";
+  }
+
+  /// Static function that returns the description of the module.
+  /// Must be implemented for the ModuleRegister template
+  /// @return descripton of the module
+  static std::string getModuleDescription()
+  {
+    return "This module implements a built-in block sparse Krylov linear system solver.";
+  }
+
+}; // end KrylovModule
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_hh
@@ -0,0 +1,195 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/PE.hh"
+#include "Common/Stopwatch.hh"
+#include "Common/StringOps.hh"
+#include "Environment/ObjectProvider.hh"
+#include "Framework/BlockAccumulator.hh"
+
+#include "Krylov/Krylov.hh"
+#include "Krylov/KrylovLSS.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+Environment::ObjectProvider<KrylovLSS,
+               LinearSystemSolver,
+               KrylovModule,
+               1>
+krylovLSSMethodProvider("KRYLOV");
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSS::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< std::string >
+    ( "SetupCom", "Setup Command to run. This command seldomly needs overriding." );
+  options.addConfigOption< std::string >
+    ( "UnSetupCom", "UnSetup Command to run. This command seldomly needs overriding." );
+  options.addConfigOption< std::string >
+    ( "SysSolver", "Command that solves the linear system." );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovLSS::KrylovLSS(const std::string& name)
+  : LinearSystemSolver(name)
+{
+  addConfigOptionsTo(this);
+
+  m_data.reset(new KrylovLSSData(getMaskArray(),
+				 getNbSysEquations(),
+				 this));
+  
+  cf_assert(m_data.getPtr() != CFNULL);
+  
+  m_setupStr = "StdSetup";
+  setParameter("SetupCom",&m_setupStr);
+  
+  m_unSetupStr = "StdUnSetup";
+  setParameter("UnSetupCom",&m_unSetupStr);
+
+  m_solveSysStr = "StdSolveSys";
+  setParameter("SysSolver",&m_solveSysStr);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovLSS::~KrylovLSS()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Common::SafePtr<MethodData> KrylovLSS::getMethodData () const
+{
+  return m_data.getPtr();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSS::configure ( Config::ConfigArgs& args )
+{
+  LinearSystemSolver::configure(args);
+  configureNested ( m_data.getPtr(), args );
+  
+  configureCommand<KrylovLSSData,KrylovLSSComProvider>( args, m_setup,m_setupStr,m_data);
+
+  configureCommand<KrylovLSSData,KrylovLSSComProvider>( args, m_unSetup,m_unSetupStr,m_data);
+  
+  configureCommand<KrylovLSSData,KrylovLSSComProvider>( args, m_solveSys,m_solveSysStr,m_data);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSS::solveSysImpl()
+{
+  if(m_data->isSaveSystemToFile()) {
+    CFLog(NOTICE, "Printing system to files... " << CFendl);
+    std::string prefix = "system-";
+    std::string suffix =  "-" + getName() + ".dat";
+    printToFile(prefix,suffix);
+    CFLog(NOTICE, "Done !!!\n");
+  }
+
+  Common::Stopwatch<Common::WallTime> stopTimer;
+  stopTimer.start();
+  
+  CFLog(DEBUG_MAX, "Solving LSS: " << getName() << CFendl);
+  m_solveSys->execute();
+  
+  stopTimer.stop ();
+  
+  CFLog(VERBOSE, "KrylovLSS::solveSys() WallTime: " << stopTimer << "s\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockAccumulator* KrylovLSS::
+createBlockAccumulator(const CFuint nbRows,
+                       const CFuint nbCols,
+                       const CFuint subBlockSize,
+		       CFreal* ptr) const
+{
+  return new BlockAccumulator
+    (nbRows,nbCols,subBlockSize, m_lssData->getLocalToGlobalMapping(), ptr);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSS::printToFile(const std::string prefix, const std::string suffix)
+{
+  cf_assert(isSetup());
+  cf_assert(isConfigured());
+
+  BCSRMatrix& mat = m_data->getMatrix();
+  KrylovVector& rhs = m_data->getRhsVector();
+  KrylovVector& sol = m_data->getSolVector();
+  
+  // each processor prints its own rows
+  const std::string nsp = m_data->getNamespace();
+  const std::string rank = (Common::PE::GetPE().IsParallel()) ?
+    "-P" + Common::StringOps::to_str(Common::PE::GetPE().GetRank(nsp)) : "";
+  
+  std::string matStr = prefix + "mat" + suffix + rank;
+  std::string rhsStr = prefix + "rhs" + suffix + rank;
+  std::string solStr = prefix + "sol" + suffix + rank;
+  
+  mat.printToFile(matStr.c_str());
+  rhs.printToFile(rhsStr.c_str());
+  sol.printToFile(solStr.c_str());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSS::setMethodImpl()
+{
+  LinearSystemSolver::setMethodImpl();
+  
+  m_setup->setup();
+  m_setup->execute();
+  
+  m_solveSys->setup();
+  m_unSetup->setup();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSS::unsetMethodImpl()
+{
+  m_unSetup->execute();
+  unsetupCommandsAndStrategies();
+  
+  LinearSystemSolver::unsetMethodImpl();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::vector<Common::SafePtr<NumericalStrategy> > KrylovLSS::getStrategyList() const
+{
+  vector<Common::SafePtr<NumericalStrategy> > result;
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
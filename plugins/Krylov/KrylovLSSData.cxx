@@ -0,0 +1,121 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/BadValueException.hh"
+#include "Framework/MethodCommandProvider.hh"
+
+#include "Krylov/Krylov.hh"
+#include "Krylov/KrylovLSSData.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider<NullMethodCommand<KrylovLSSData>, KrylovLSSData, KrylovModule>
+nullKrylovLSSComProvider("Null");
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSData::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< std::string >("KSPType","Krylov solver type (GMRES or FGMRES).");
+  options.addConfigOption< std::string >("PCType","Preconditioner type (BILU0, BJacobi or None).");
+  options.addConfigOption< bool >("SinglePrecisionPC","Store the preconditioner factors in single precision.");
+  options.addConfigOption< CFuint >("NbKrylovSpaces","Number of Krylov spaces.");
+  options.addConfigOption< CFreal >("RelativeTolerance","Relative tolerance for control of iterative solver convergence.");
+  options.addConfigOption< CFreal >("AbsoluteTolerance","Absolute tolerance for control of iterative solver convergence.");
+  options.addConfigOption< CFuint >("KSPShowRate", "Rate telling how often KSP convergence is shown");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovLSSData::KrylovLSSData(SafePtr<std::valarray<bool> > maskArray,
+			     CFuint& nbSysEquations,
+			     Common::SafePtr<Framework::Method> owner) :
+  LSSData(maskArray, nbSysEquations, owner),
+  m_xVec(),
+  m_bVec(),
+  m_aMat(),
+  m_ghostSync(),
+  m_ksp(),
+  m_pc()
+{
+  addConfigOptionsTo(this);
+
+  m_kspTypeStr = "GMRES";
+  setParameter("KSPType",&m_kspTypeStr);
+
+  m_pcTypeStr = "BILU0";
+  setParameter("PCType",&m_pcTypeStr);
+
+  m_singlePrecisionPC = false;
+  setParameter("SinglePrecisionPC",&m_singlePrecisionPC);
+
+  m_nbKsp = 30;
+  setParameter("NbKrylovSpaces",&m_nbKsp);
+
+  m_rTol = 1e-5;
+  setParameter("RelativeTolerance",&m_rTol);
+
+  m_aTol = 1e-30;
+  setParameter("AbsoluteTolerance",&m_aTol);
+
+  m_kspShowRate = 1;
+  setParameter("KSPShowRate",&m_kspShowRate);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovLSSData::~KrylovLSSData()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSData::configure ( Config::ConfigArgs& args )
+{
+  LSSData::configure(args);
+
+  if (m_kspTypeStr != "GMRES" && m_kspTypeStr != "FGMRES") {
+    throw Common::BadValueException
+      (FromHere(), "KrylovLSSData::configure() => unknown KSPType: " + m_kspTypeStr);
+  }
+
+  if (m_nbKsp == 0) {
+    throw Common::BadValueException
+      (FromHere(), "KrylovLSSData::configure() => NbKrylovSpaces must be > 0");
+  }
+
+  if (m_kspShowRate == 0) {
+    m_kspShowRate = 1;
+  }
+
+  CFLog(VERBOSE, "Krylov PCType = " << m_pcTypeStr << "\n");
+  CFLog(VERBOSE, "Krylov SinglePrecisionPC = " << m_singlePrecisionPC << "\n");
+  CFLog(VERBOSE, "Krylov KSPType = " << m_kspTypeStr << "\n");
+  CFLog(VERBOSE, "Krylov Nb KSP spaces = " << m_nbKsp << "\n");
+  CFLog(VERBOSE, "Krylov MaxIter = " << getMaxIterations() << "\n");
+  CFLog(VERBOSE, "Krylov Relative Tolerance = " << m_rTol << "\n");
+  CFLog(VERBOSE, "Krylov Absolute Tolerance = " << m_aTol << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
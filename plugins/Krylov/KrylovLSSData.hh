@@ -0,0 +1,164 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_KrylovLSSData_hh
+#define COOLFluiD_Krylov_KrylovLSSData_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+
+#include "Framework/LSSData.hh"
+#include "Framework/MethodCommand.hh"
+
+#include "Krylov/BCSRMatrix.hh"
+#include "Krylov/BlockPreconditioner.hh"
+#include "Krylov/GhostSync.hh"
+#include "Krylov/GMRESSolver.hh"
+#include "Krylov/KrylovVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a data object that is accessed by the different
+/// KrylovLSSCom's that compose the KrylovLSS.
+class KrylovLSSData : public Framework::LSSData {
+public:
+
+  /// Defines the Config Option's of this class
+  /// @param options a OptionList where to add the Option's
+  static void defineConfigOptions(Config::OptionList& options);
+
+  /// Constructor
+  KrylovLSSData(Common::SafePtr<std::valarray<bool> > maskArray,
+		CFuint& nbSysEquations,
+		Common::SafePtr<Framework::Method> owner);
+
+  /// Destructor
+  virtual ~KrylovLSSData();
+
+  /// Configure the data from the supplied arguments.
+  /// @param args configuration arguments
+  virtual void configure ( Config::ConfigArgs& args );
+
+  /// Gets the Class name
+  static std::string getClassName()
+  {
+    return "KrylovLSS";
+  }
+
+  /// Gets the solution vector
+  KrylovVector& getSolVector() {return m_xVec;}
+
+  /// Gets the rhs vector
+  KrylovVector& getRhsVector() {return m_bVec;}
+
+  /// Gets the matrix
+  BCSRMatrix& getMatrix() {return m_aMat;}
+
+  /// Gets the parallel operations on the vectors
+  GhostSync& getGhostSync() {return m_ghostSync;}
+
+  /// Gets the Krylov solver
+  GMRESSolver& getKSP() {return m_ksp;}
+
+  /// Gets the preconditioner
+  /// @pre setPreconditioner() has been called
+  BlockPreconditioner& getPreconditioner()
+  {
+    cf_assert(m_pc.get() != CFNULL);
+    return *m_pc;
+  }
+
+  /// Sets the preconditioner
+  void setPreconditioner(BlockPreconditioner* pc) {m_pc.reset(pc);}
+
+  /// Gets the name of the Krylov method
+  const std::string& getKSPType() const {return m_kspTypeStr;}
+
+  /// Gets the name of the preconditioner
+  const std::string& getPCType() const {return m_pcTypeStr;}
+
+  /// Tell if the preconditioner factors are stored in single precision
+  bool useSinglePrecisionPC() const {return m_singlePrecisionPC;}
+
+  /// Gets the number of Krylov vectors before a restart
+  CFuint getNbKrylovSpaces() const {return m_nbKsp;}
+
+  /// Gets the relative tolerance
+  CFreal getRelativeTol() const {return m_rTol;}
+
+  /// Gets the absolute tolerance
+  CFreal getAbsoluteTol() const {return m_aTol;}
+
+  /// Gets the rate at which the convergence of the solver is shown
+  CFuint getKSPConvergenceShowRate() const {return m_kspShowRate;}
+
+private: // data
+
+  /// solution vector
+  KrylovVector m_xVec;
+
+  /// rhs vector
+  KrylovVector m_bVec;
+
+  /// matrix
+  BCSRMatrix m_aMat;
+
+  /// parallel operations on the vectors
+  GhostSync m_ghostSync;
+
+  /// Krylov solver
+  GMRESSolver m_ksp;
+
+  /// preconditioner
+  std::auto_ptr<BlockPreconditioner> m_pc;
+
+  /// Krylov method ("GMRES" or "FGMRES")
+  std::string m_kspTypeStr;
+
+  /// preconditioner ("BILU0", "BJacobi" or "None")
+  std::string m_pcTypeStr;
+
+  /// flag telling to store the preconditioner factors in single precision
+  bool m_singlePrecisionPC;
+
+  /// number of Krylov vectors before a restart
+  CFuint m_nbKsp;
+
+  /// relative tolerance of the iterative solver
+  CFreal m_rTol;
+
+  /// absolute tolerance of the iterative solver
+  CFreal m_aTol;
+
+  /// rate at which the convergence of the solver is shown
+  CFuint m_kspShowRate;
+
+}; // end of class KrylovLSSData
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Definition of a command for Krylov
+typedef Framework::MethodCommand<KrylovLSSData> KrylovLSSCom;
+
+/// Definition of a command provider for Krylov
+typedef Framework::MethodCommand<KrylovLSSData>::PROVIDER KrylovLSSComProvider;
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_KrylovLSSData_hh
@@ -0,0 +1,116 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <fstream>
+#include <iostream>
+
+#include "Krylov/KrylovVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovVector::KrylovVector() :
+  Framework::LSSVector(),
+  m_vec(),
+  m_localSize(0),
+  m_globalSize(0),
+  m_name()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovVector::~KrylovVector()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovVector::create(MPI_Comm comm,
+			  const CFint m,
+			  const CFint M,
+			  const char* name)
+{
+  cf_assert(m >= 0 && M >= m);
+  m_localSize = m;
+  m_globalSize = M;
+  m_name = (name != CFNULL) ? name : "";
+  m_vec.assign(m, 0.);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovVector::initialize(MPI_Comm comm,
+			      const CFreal value)
+{
+  setValue(value);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovVector::destroy()
+{
+  std::vector<CFreal>().swap(m_vec);
+  m_localSize = 0;
+  m_globalSize = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovVector::printToScreen() const
+{
+  std::cout << m_name << " (" << m_localSize << " local entries)\n";
+  for (CFuint i = 0; i < m_localSize; ++i) {
+    std::cout << m_vec[i] << "\n";
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovVector::printToFile(const char* fileName) const
+{
+  std::ofstream f(fileName);
+  f.precision(16);
+  for (CFuint i = 0; i < m_localSize; ++i) {
+    f << m_vec[i] << "\n";
+  }
+  f.close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovVector::copy(CFreal *const other, const CFuint size) const
+{
+  cf_assert(size <= m_localSize);
+  for (CFuint i = 0; i < size; ++i) {
+    other[i] = m_vec[i];
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovVector::copy(CFreal *const other,
+			CFint *const localIDs,
+			const CFuint size) const
+{
+  cf_assert(size <= m_localSize);
+  for (CFuint i = 0; i < size; ++i) {
+    other[localIDs[i]] = m_vec[i];
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
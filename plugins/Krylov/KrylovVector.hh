@@ -0,0 +1,169 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_KrylovVector_hh
+#define COOLFluiD_Krylov_KrylovVector_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Framework/LSSVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a vector of the Krylov linear system solver,
+/// storing the entries owned by this processor.
+class KrylovVector : public Framework::LSSVector {
+public:
+
+  /// Default constructor without arguments.
+  KrylovVector();
+
+  /// Destructor.
+  ~KrylovVector();
+
+  /// Create a vector
+  /// @param m  number of entries owned by this processor
+  /// @param M  global number of entries
+  void create(MPI_Comm comm,
+              const CFint m,
+              const CFint M,
+              const char* name);
+
+  /// Initialize a vector
+  void initialize(MPI_Comm comm,
+                  const CFreal value);
+
+  /// Start to assemble the vector
+  void beginAssembly() {}
+
+  /// Finish to assemble the vector
+  void endAssembly() {}
+
+  /// Print this vector
+  void printToScreen() const;
+
+  /// Print this vector to a file
+  void printToFile(const char* fileName) const;
+
+  /// Destroy this vector
+  void destroy();
+
+  /// Set a value at the specified position in the vector
+  void setValue(const CFint idx, const CFreal value)
+  {
+    if (idx >= 0) {
+      cf_assert(idx < (CFint)m_vec.size());
+      m_vec[idx] = value;
+    }
+  }
+
+  /// Set all the entries equal to the given value
+  void setValue(const CFreal value)
+  {
+    m_vec.assign(m_vec.size(), value);
+  }
+
+  /// Set a list of values
+  void setValues(const CFuint nbValues,
+                 const CFint* idx,
+                 const CFreal* values)
+  {
+    for (CFuint i = 0; i < nbValues; ++i) {
+      setValue(idx[i], values[i]);
+    }
+  }
+
+  /// Add a value in the vector at the given location
+  void addValue(const CFint idx, const CFreal value)
+  {
+    if (idx >= 0) {
+      cf_assert(idx < (CFint)m_vec.size());
+      m_vec[idx] += value;
+    }
+  }
+
+  /// Add a list of values at the given locations
+  void addValues(const CFuint nbValues,
+                 const CFint* idx,
+                 const CFreal* values)
+  {
+    for (CFuint i = 0; i < nbValues; ++i) {
+      addValue(idx[i], values[i]);
+    }
+  }
+
+  /// Get one value
+  void getValue(const CFint idx, CFreal value)
+  {
+    cf_assert(idx >= 0 && idx < (CFint)m_vec.size());
+    value = m_vec[idx];
+  }
+
+  /// Get a list of values
+  void getValues(const CFuint m,
+                 const CFint* im,
+                 CFreal* values)
+  {
+    for (CFuint i = 0; i < m; ++i) {
+      cf_assert(im[i] >= 0 && im[i] < (CFint)m_vec.size());
+      values[i] = m_vec[im[i]];
+    }
+  }
+
+  /// Gets the number of entries owned by this processor
+  CFuint getLocalSize() const {return m_localSize;}
+
+  /// Gets the global size of the Vector
+  CFuint getGlobalSize() const {return m_globalSize;}
+
+  /// Copy the raw data of this Vector to a given array
+  void copy(CFreal *const other, const CFuint size) const;
+
+  /// Copy the raw data of this Vector to the given positions of an array
+  /// @param localIDs  position in other of each entry of this Vector
+  void copy(CFreal *const other,
+            CFint *const localIDs,
+            const CFuint size) const;
+
+  /// Gets the raw array
+  CFreal* getArray() {return &m_vec[0];}
+
+  /// Gets the raw array
+  const CFreal* getArray() const {return &m_vec[0];}
+
+private: // data
+
+  /// entries owned by this processor
+  std::vector<CFreal> m_vec;
+
+  /// number of owned entries
+  CFuint m_localSize;
+
+  /// global number of entries
+  CFuint m_globalSize;
+
+  /// name of the vector
+  std::string m_name;
+
+}; // end of class KrylovVector
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_KrylovVector_hh
@@ -0,0 +1,227 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/PE.hh"
+
+#include "Framework/GlobalJacobianSparsity.hh"
+#include "Framework/MeshData.hh"
+#include "Framework/MethodCommandProvider.hh"
+#include "Framework/SpaceMethod.hh"
+#include "Framework/State.hh"
+
+#include "Krylov/Krylov.hh"
+#include "Krylov/StdSetup.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider<StdSetup, KrylovLSSData, KrylovModule>
+stdSetupKrylovProvider("StdSetup");
+
+//////////////////////////////////////////////////////////////////////////////
+
+StdSetup::StdSetup(const std::string& name) :
+  KrylovLSSCom(name),
+  socket_states("states"),
+  socket_nodes("nodes"),
+  socket_bStatesNeighbors("bStatesNeighbors"),
+  m_localToLSS()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+StdSetup::~StdSetup()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::vector<Common::SafePtr<BaseDataSocketSink> > StdSetup::needsSockets()
+{
+  std::vector<Common::SafePtr<BaseDataSocketSink> > result;
+
+  result.push_back(&socket_states);
+  result.push_back(&socket_nodes);
+  result.push_back(&socket_bStatesNeighbors);
+
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSetup::execute()
+{
+  CFAUTOTRACE;
+
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  DataHandle<Node*, GLOBAL> nodes = socket_nodes.getDataHandle();
+  const bool useNodeBased = getMethodData().useNodeBased();
+
+  // set the index mapping (local IDs to LSS IDs) and the ghost exchange
+  const CFuint nbUpdatableStates = setIdxMapping();
+
+  CFuint totalNbStates = nbUpdatableStates;
+  if (PE::GetPE().IsParallel()) {
+    totalNbStates = (!useNodeBased) ? states.getGlobalSize() : nodes.getGlobalSize();
+  }
+
+  // set the vectors
+  setVectors(nbUpdatableStates, totalNbStates);
+
+  // set the matrix
+  setMatrix(nbUpdatableStates);
+
+  // set the Krylov method and the preconditioner
+  setKSP();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint StdSetup::setIdxMapping()
+{
+  CFAUTOTRACE;
+
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  DataHandle<Node*, GLOBAL> nodes = socket_nodes.getDataHandle();
+  const bool useNodeBased = getMethodData().useNodeBased();
+  const CFuint nbStates = (!useNodeBased) ? states.size() : nodes.size();
+  const CFuint nbEqs = getMethodData().getNbSysEquations();
+  const std::string nsp = getMethodData().getNamespace();
+
+  std::valarray<bool> isGhost(nbStates);
+  CFuint nbUpdatableStates = 0;
+  for (CFuint i = 0; i < nbStates; ++i) {
+    isGhost[i] = (!useNodeBased) ? !states[i]->isParUpdatable() : !nodes[i]->isParUpdatable();
+    if (!isGhost[i]) {
+      ++nbUpdatableStates;
+    }
+  }
+
+  // updatable states first, ghost states after, both in local order
+  m_localToLSS.resize(nbStates);
+  CFuint iu = 0;
+  CFuint ig = nbUpdatableStates;
+  for (CFuint i = 0; i < nbStates; ++i) {
+    m_localToLSS[i] = (!isGhost[i]) ? iu++ : ig++;
+  }
+  cf_assert(iu == nbUpdatableStates);
+  cf_assert(ig == nbStates);
+
+  getMethodData().getLocalToGlobalMapping().createMapping(m_localToLSS, isGhost);
+  getMethodData().getLocalToLocallyUpdatableMapping().createMapping(m_localToLSS, isGhost);
+
+  GhostSync& sync = getMethodData().getGhostSync();
+  if (PE::GetPE().IsParallel()) {
+    if (!useNodeBased) {
+      sync.setup(nsp, states.getGhostSendList(), states.getGhostReceiveList(),
+		 m_localToLSS, nbEqs);
+    }
+    else {
+      sync.setup(nsp, nodes.getGhostSendList(), nodes.getGhostReceiveList(),
+		 m_localToLSS, nbEqs);
+    }
+  }
+  else {
+    sync.setupSerial(nsp);
+  }
+
+  CFLog(VERBOSE, "Krylov::StdSetup::setIdxMapping() => updatable states ["
+	<< nbUpdatableStates << "], ghost states [" << nbStates - nbUpdatableStates << "]\n");
+
+  return nbUpdatableStates;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSetup::setVectors(const CFuint localSize,
+			  const CFuint globalSize)
+{
+  CFAUTOTRACE;
+
+  const CFuint nbEqs = getMethodData().getNbSysEquations();
+  const std::string nsp = getMethodData().getNamespace();
+  MPI_Comm comm = PE::GetPE().GetCommunicator(nsp);
+
+  KrylovVector& rhs = getMethodData().getRhsVector();
+  rhs.create(comm, localSize*nbEqs, globalSize*nbEqs, "rhs");
+  rhs.initialize(comm, 0.);
+
+  KrylovVector& sol = getMethodData().getSolVector();
+  sol.create(comm, localSize*nbEqs, globalSize*nbEqs, "sol");
+  sol.initialize(comm, 0.);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSetup::setMatrix(const CFuint localSize)
+{
+  CFAUTOTRACE;
+
+  const bool useNodeBased = getMethodData().useNodeBased();
+  const CFuint nbStates = m_localToLSS.size();
+  const CFuint nbEqs = getMethodData().getNbSysEquations();
+
+  std::valarray<CFint> allNonZero(nbStates);
+  allNonZero = 0;
+  std::valarray<CFint> outDiagNonZero(nbStates);
+  outDiagNonZero = 0;
+
+  SelfRegistPtr<GlobalJacobianSparsity> sparsity =
+    getMethodData().getCollaborator<SpaceMethod>()->createJacobianSparsity();
+
+  sparsity->setDataSockets(socket_states, socket_nodes, socket_bStatesNeighbors);
+  (!useNodeBased) ? sparsity->computeNNz(allNonZero, outDiagNonZero) :
+    sparsity->computeNNzNodeBased(allNonZero, outDiagNonZero);
+
+  // the block rows are only the updatable states, ordered by LSS ID,
+  // while their ghost neighbors are stored as regular (local) columns
+  std::vector<CFint> nnz(localSize, 0);
+  for (CFuint i = 0; i < nbStates; ++i) {
+    if (m_localToLSS[i] < localSize) {
+      nnz[m_localToLSS[i]] = allNonZero[i] + outDiagNonZero[i];
+    }
+  }
+
+  BCSRMatrix& mat = getMethodData().getMatrix();
+  mat.createSeqBAIJ(nbEqs, localSize*nbEqs, nbStates*nbEqs, 0,
+		    (localSize > 0) ? &nnz[0] : CFNULL, "Jacobian");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSetup::setKSP()
+{
+  CFAUTOTRACE;
+
+  KrylovLSSData& data = getMethodData();
+  data.getKSP().setParameters(data.getNbKrylovSpaces(),
+			      data.getMaxIterations(),
+			      data.getRelativeTol(),
+			      data.getAbsoluteTol(),
+			      data.getKSPType() == "FGMRES");
+  data.setPreconditioner(BlockPreconditioner::create(data.getPCType(),
+						     data.useSinglePrecisionPC()));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
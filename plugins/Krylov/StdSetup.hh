@@ -0,0 +1,84 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_StdSetup_hh
+#define COOLFluiD_Krylov_StdSetup_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Framework/DataSocketSink.hh"
+
+#include "Krylov/KrylovLSSData.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents the command that sets up the Krylov linear system
+/// solver: index mapping, parallel exchange pattern, matrix, vectors,
+/// preconditioner and Krylov method.
+/// The LSS IDs number the updatable states of each processor first and its
+/// ghost states after, in their local order.
+class StdSetup : public KrylovLSSCom {
+public:
+
+  /// Constructor.
+  explicit StdSetup(const std::string& name);
+
+  /// Destructor.
+  ~StdSetup();
+
+  /// Execute Processing actions
+  void execute();
+
+  /// Returns the DataSocket's that this command needs as sinks
+  /// @return a vector of SafePtr with the DataSockets
+  std::vector<Common::SafePtr<Framework::BaseDataSocketSink> > needsSockets();
+
+private: // functions
+
+  /// Set up the index mapping and the parallel exchange pattern
+  /// @return the number of updatable states
+  CFuint setIdxMapping();
+
+  /// Set up the vectors
+  void setVectors(const CFuint localSize, const CFuint globalSize);
+
+  /// Set up the matrix
+  void setMatrix(const CFuint localSize);
+
+  /// Set up the Krylov method and the preconditioner
+  void setKSP();
+
+private: // data
+
+  /// socket for the states
+  Framework::DataSocketSink<Framework::State*, Framework::GLOBAL> socket_states;
+
+  /// socket for the nodes
+  Framework::DataSocketSink<Framework::Node*, Framework::GLOBAL> socket_nodes;
+
+  /// socket for the neighbor states of the boundary states
+  Framework::DataSocketSink<std::valarray<Framework::State*> > socket_bStatesNeighbors;
+
+  /// LSS ID of each local state
+  std::valarray<CFuint> m_localToLSS;
+
+}; // class StdSetup
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_StdSetup_hh
@@ -0,0 +1,187 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/CFLog.hh"
+#include "Common/Stopwatch.hh"
+#include "Common/StringOps.hh"
+
+#include "Framework/LSSIdxMapping.hh"
+#include "Framework/MethodCommandProvider.hh"
+#include "Framework/PhysicalModel.hh"
+#include "Framework/State.hh"
+#include "Framework/SubSystemStatus.hh"
+
+#include "Krylov/Krylov.hh"
+#include "Krylov/StdSolveSys.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider<StdSolveSys, KrylovLSSData, KrylovModule>
+stdSolveSysKrylovProvider("StdSolveSys");
+
+//////////////////////////////////////////////////////////////////////////////
+
+StdSolveSys::StdSolveSys(const std::string& name) :
+  KrylovLSSCom(name),
+  socket_states("states"),
+  socket_nodes("nodes"),
+  socket_rhs("rhs"),
+  m_nbSolves(0),
+  _upLocalIDs(),
+  _upStatesGlobalIDs()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+StdSolveSys::~StdSolveSys()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSolveSys::execute()
+{
+  CFAUTOTRACE;
+
+  Stopwatch<WallTime> stopTimer;
+  stopTimer.start();
+
+  DataHandle<CFreal> rhs = socket_rhs.getDataHandle();
+  cf_assert(_upLocalIDs.size() == _upStatesGlobalIDs.size());
+  const CFuint vecSize = _upLocalIDs.size();
+
+  BCSRMatrix& mat = getMethodData().getMatrix();
+  KrylovVector& rhsVec = getMethodData().getRhsVector();
+  KrylovVector& solVec = getMethodData().getSolVector();
+  BlockPreconditioner& pc = getMethodData().getPreconditioner();
+  GMRESSolver& ksp = getMethodData().getKSP();
+
+  // assemble the matrix
+  mat.finalAssembly();
+
+  // the non zero structure is collected during the first assembly
+  // and compressed to flat storage once for all
+  if (!mat.isFrozen()) {
+    mat.freezeNonZeroStructure();
+  }
+
+  for (CFuint i = 0; i < vecSize; ++i) {
+    rhsVec.setValue(_upStatesGlobalIDs[i], rhs[_upLocalIDs[i]]);
+  }
+
+  const CFuint nbIter = SubSystemStatusStack::getActive()->getNbIter();
+  if (getMethodData().getSaveRate() > 0) {
+    if (getMethodData().isSaveSystemToFile() || (nbIter%getMethodData().getSaveRate() == 0)) {
+      const string mFile = "mat-iter" + StringOps::to_str(nbIter) + ".dat";
+      mat.printToFile(mFile.c_str());
+
+      const string vFile = "rhs-iter" + StringOps::to_str(nbIter) + ".dat";
+      rhsVec.printToFile(vFile.c_str());
+    }
+  }
+
+  // recompute the preconditioner every PreconditionerRate solves,
+  // unless the matrix has not changed since the last solve
+  const CFuint pcRate = std::max<CFuint>(1, getMethodData().getPreconditionerRate());
+  const bool keepPC = getMethodData().reusePreconditioner();
+  if (m_nbSolves == 0 || (!keepPC && m_nbSolves%pcRate == 0)) {
+    pc.setup(mat);
+  }
+  ++m_nbSolves;
+
+  solVec.setValue(0.);
+  const CFuint iter = ksp.solve(mat, pc, getMethodData().getGhostSync(),
+				rhsVec.getArray(), solVec.getArray());
+
+  // Ask to stop the simulation if convergence is achieved at iteration 0 (i.e. LSS was not solved)
+  if (iter == 0) {
+    SubSystemStatusStack::getActive()->setStopSimulation(true);
+  }
+
+  if (nbIter%getMethodData().getKSPConvergenceShowRate() == 0) {
+    CFLog(INFO, "KSP convergence reached at iteration: " << iter
+	  << " (residual " << ksp.getInitialResidual() << " -> "
+	  << ksp.getFinalResidual() << ")\n");
+  }
+
+  solVec.copy(&rhs[0], &_upLocalIDs[0], vecSize);
+  CFLog(VERBOSE, "Krylov::StdSolveSys::execute() took " << stopTimer << "s\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSolveSys::setup()
+{
+  CFAUTOTRACE;
+
+  KrylovLSSCom::setup();
+
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  DataHandle<Node*, GLOBAL> nodes = socket_nodes.getDataHandle();
+  const bool useNodeBased = getMethodData().useNodeBased();
+  const CFuint nbStates = (!useNodeBased) ? states.size() : nodes.size();
+  const CFuint nbEqs = getMethodData().getNbSysEquations();
+
+  const LSSIdxMapping& idxMapping = getMethodData().getLocalToGlobalMapping();
+  const CFuint totalNbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const std::valarray<bool>& maskArray = *getMethodData().getMaskArray();
+
+  _upLocalIDs.clear();
+  _upStatesGlobalIDs.clear();
+  _upLocalIDs.reserve(nbStates*nbEqs);
+  _upStatesGlobalIDs.reserve(nbStates*nbEqs);
+
+  // only the updatable states have an entry in the KrylovVector's
+  for (CFuint i = 0; i < nbStates; ++i) {
+    const CFuint localID = i*totalNbEqs;
+    if ((!useNodeBased && states[i]->isParUpdatable()) ||
+	(useNodeBased && nodes[i]->isParUpdatable())) {
+      const CFuint sID = (!useNodeBased) ? states[i]->getLocalID() : nodes[i]->getLocalID();
+      CFint lssID = static_cast<CFint>(idxMapping.getColID(sID))*nbEqs;
+
+      for (CFuint iEq = 0; iEq < totalNbEqs; ++iEq) {
+	if (maskArray[iEq]) {
+	  _upStatesGlobalIDs.push_back(lssID++);
+	  _upLocalIDs.push_back(static_cast<CFint>(localID + iEq));
+	}
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::vector<Common::SafePtr<BaseDataSocketSink> > StdSolveSys::needsSockets()
+{
+  std::vector<Common::SafePtr<BaseDataSocketSink> > result;
+
+  result.push_back(&socket_states);
+  result.push_back(&socket_nodes);
+  result.push_back(&socket_rhs);
+
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
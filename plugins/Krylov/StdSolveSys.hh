@@ -0,0 +1,76 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Krylov_StdSolveSys_hh
+#define COOLFluiD_Krylov_StdSolveSys_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Framework/DataSocketSink.hh"
+
+#include "Krylov/KrylovLSSData.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents the command that solves the linear system with
+/// the built-in Krylov solver and copies the solution back into the rhs.
+class StdSolveSys : public KrylovLSSCom {
+public:
+
+  /// Constructor.
+  explicit StdSolveSys(const std::string& name);
+
+  /// Destructor.
+  ~StdSolveSys();
+
+  /// Execute Processing actions
+  void execute();
+
+  /// Set up private data and data of the aggregated classes
+  /// in this command before processing phase
+  void setup();
+
+  /// Returns the DataSocket's that this command needs as sinks
+  /// @return a vector of SafePtr with the DataSockets
+  std::vector<Common::SafePtr<Framework::BaseDataSocketSink> > needsSockets();
+
+private: // data
+
+  /// socket for the states
+  Framework::DataSocketSink<Framework::State*, Framework::GLOBAL> socket_states;
+
+  /// socket for the nodes
+  Framework::DataSocketSink<Framework::Node*, Framework::GLOBAL> socket_nodes;
+
+  /// socket for the rhs
+  Framework::DataSocketSink<CFreal> socket_rhs;
+
+  /// number of linear systems solved so far
+  CFuint m_nbSolves;
+
+  /// positions in the rhs of the entries of the updatable states
+  std::vector<CFint> _upLocalIDs;
+
+  /// positions in the KrylovVector of the entries of the updatable states
+  std::vector<CFint> _upStatesGlobalIDs;
+
+}; // class StdSolveSys
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Krylov_StdSolveSys_hh
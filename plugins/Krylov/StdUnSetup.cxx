@@ -0,0 +1,48 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Framework/MethodCommandProvider.hh"
+
+#include "Krylov/Krylov.hh"
+#include "Krylov/StdUnSetup.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Krylov {
+
+//////////////////////////////////////////////////////////////////////////////
+
+Framework::MethodCommandProvider<StdUnSetup, KrylovLSSData, KrylovModule>
+stdUnSetupKrylovProvider("StdUnSetup");
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdUnSetup::execute()
+{
+  CFAUTOTRACE;
+
+  // destroy system vectors
+  getMethodData().getSolVector().destroy();
+  getMethodData().getRhsVector().destroy();
+
+  // release the work arrays, the exchange pattern and the preconditioner
+  getMethodData().getKSP().clear();
+  getMethodData().getGhostSync().clear();
+  getMethodData().setPreconditioner(CFNULL);
+
+  // termination and release of memory
+  getMethodData().unsetup();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Krylov
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,236 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test Krylov linear system solver"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+#include "Krylov/BCSRMatrix.hh"
+#include "Krylov/BlockPreconditioner.hh"
+#include "Krylov/GMRESSolver.hh"
+#include "Krylov/GhostSync.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Krylov;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct Krylov_Fixture
+{
+  /// common setup for each test case
+  Krylov_Fixture()
+  {
+  }
+  /// common tear-down for each test case
+  ~Krylov_Fixture()
+  {
+  }
+
+  /// deterministic pseudo-random value in [-1,1]
+  CFreal random(CFuint& seed)
+  {
+    seed = seed*1103515245u + 12345u;
+    return 2.*((seed/65536u) % 32768u)/32767. - 1.;
+  }
+
+  /// fill a block tridiagonal matrix of nbRows block rows (plus nbGhosts
+  /// ghost block columns coupled to the last row) and its dense copy,
+  /// with diagonally dominant diagonal blocks
+  void buildTridiagonal(const CFuint nb, const CFuint nbRows, const CFuint nbGhosts,
+			BCSRMatrix& mat, vector<CFreal>& dense)
+  {
+    const CFuint nbCols = nbRows + nbGhosts;
+    const CFuint n = nbCols*nb;
+    mat.createSeqBAIJ(nb, nbRows*nb, n, 3, CFNULL);
+    dense.assign(nbRows*nb*n, 0.);
+
+    CFuint seed = 7;
+    vector<CFint> im(nb);
+    vector<CFint> in(nb);
+    vector<CFreal> block(nb*nb);
+    for (CFuint iRow = 0; iRow < nbRows; ++iRow) {
+      vector<CFuint> cols;
+      if (iRow > 0) cols.push_back(iRow-1);
+      cols.push_back(iRow);
+      if (iRow+1 < nbRows) cols.push_back(iRow+1);
+      if (iRow+1 == nbRows) {
+	for (CFuint g = 0; g < nbGhosts; ++g) cols.push_back(nbRows+g);
+      }
+
+      for (CFuint c = 0; c < cols.size(); ++c) {
+	const CFuint iCol = cols[c];
+	for (CFuint i = 0; i < nb; ++i) {
+	  im[i] = iRow*nb + i;
+	  in[i] = iCol*nb + i;
+	  for (CFuint j = 0; j < nb; ++j) {
+	    block[i*nb + j] = random(seed);
+	    if (iCol == iRow && i == j) block[i*nb + j] += 4.*nb;
+	  }
+	}
+	mat.addValues(nb, &im[0], nb, &in[0], &block[0]);
+	for (CFuint i = 0; i < nb; ++i) {
+	  for (CFuint j = 0; j < nb; ++j) {
+	    dense[im[i]*n + in[j]] += block[i*nb + j];
+	  }
+	}
+      }
+    }
+    mat.freezeNonZeroStructure();
+  }
+
+  /// compute y = A x with the dense copy of the matrix
+  void denseMult(const vector<CFreal>& dense, const vector<CFreal>& x, vector<CFreal>& y)
+  {
+    const CFuint n = x.size();
+    const CFuint m = dense.size()/n;
+    y.assign(m, 0.);
+    for (CFuint i = 0; i < m; ++i) {
+      for (CFuint j = 0; j < n; ++j) {
+	y[i] += dense[i*n + j]*x[j];
+      }
+    }
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( Krylov_TestSuite, Krylov_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_BCSRMult )
+{
+  // block sizes with a specialised kernel and with the generic one
+  const CFuint blockSizes[3] = {1, 4, 16};
+  for (CFuint s = 0; s < 3; ++s) {
+    const CFuint nb = blockSizes[s];
+    const CFuint nbRows = 6;
+    const CFuint nbGhosts = 2;
+    BCSRMatrix mat;
+    vector<CFreal> dense;
+    buildTridiagonal(nb, nbRows, nbGhosts, mat, dense);
+
+    BOOST_CHECK( mat.isFrozen() );
+    BOOST_CHECK_EQUAL( mat.getNbBlockRows(), nbRows );
+    BOOST_CHECK_EQUAL( mat.getNbBlockCols(), nbRows + nbGhosts );
+    BOOST_CHECK_EQUAL( mat.getRowPtr()[nbRows], 3*nbRows - 2 + nbGhosts );
+
+    CFuint seed = 11;
+    vector<CFreal> x((nbRows + nbGhosts)*nb);
+    for (CFuint i = 0; i < x.size(); ++i) {
+      x[i] = random(seed);
+    }
+
+    vector<CFreal> y(nbRows*nb);
+    mat.mult(&x[0], &y[0]);
+    vector<CFreal> yDense;
+    denseMult(dense, x, yDense);
+    for (CFuint i = 0; i < y.size(); ++i) {
+      BOOST_CHECK_CLOSE( y[i], yDense[i], 1e-10 );
+    }
+
+    // values set outside the frozen structure are ignored
+    mat.setValue(0, (nbRows-1)*nb, 1.);
+    CFreal value = -1.;
+    mat.getValue(0, (nbRows-1)*nb, value);
+    BOOST_CHECK_EQUAL( value, 0. );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_BlockILU0 )
+{
+  // ILU(0) of a block tridiagonal matrix has no fill, so it is the exact
+  // LU factorization and apply() solves the system
+  const CFuint nb = 4;
+  const CFuint nbRows = 8;
+  BCSRMatrix mat;
+  vector<CFreal> dense;
+  buildTridiagonal(nb, nbRows, 0, mat, dense);
+
+  CFuint seed = 3;
+  vector<CFreal> r(nbRows*nb);
+  for (CFuint i = 0; i < r.size(); ++i) {
+    r[i] = random(seed);
+  }
+
+  BlockILU0Preconditioner pc;
+  pc.setup(mat);
+  vector<CFreal> z(r.size());
+  pc.apply(&r[0], &z[0]);
+
+  vector<CFreal> az;
+  denseMult(dense, z, az);
+  for (CFuint i = 0; i < r.size(); ++i) {
+    BOOST_CHECK_SMALL( az[i] - r[i], 1e-12 );
+  }
+
+  // the single precision factors give the same solution to float accuracy
+  BlockILU0Preconditioner pcSP(true);
+  pcSP.setup(mat);
+  vector<CFreal> zSP(r.size());
+  pcSP.apply(&r[0], &zSP[0]);
+  for (CFuint i = 0; i < r.size(); ++i) {
+    BOOST_CHECK_SMALL( zSP[i] - z[i], 1e-5 );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_GMRESConvergence )
+{
+  const CFuint nb = 3;
+  const CFuint nbRows = 40;
+  BCSRMatrix mat;
+  vector<CFreal> dense;
+  buildTridiagonal(nb, nbRows, 0, mat, dense);
+
+  CFuint seed = 5;
+  vector<CFreal> xExact(nbRows*nb);
+  for (CFuint i = 0; i < xExact.size(); ++i) {
+    xExact[i] = random(seed);
+  }
+  vector<CFreal> b;
+  denseMult(dense, xExact, b);
+
+  GhostSync sync;
+  sync.setupSerial("Default");
+
+  const char* pcTypes[3] = {"None", "BJacobi", "BILU0"};
+  CFuint nbIter[3];
+  for (CFuint p = 0; p < 3; ++p) {
+    for (CFuint flexible = 0; flexible < 2; ++flexible) {
+      BlockPreconditioner* pc = BlockPreconditioner::create(pcTypes[p]);
+      pc->setup(mat);
+
+      GMRESSolver gmres;
+      gmres.setParameters(10, 200, 1e-10, 0., flexible == 1);
+      vector<CFreal> x(b.size(), 0.);
+      nbIter[p] = gmres.solve(mat, *pc, sync, &b[0], &x[0]);
+      delete pc;
+
+      BOOST_CHECK( nbIter[p] < 200 );
+      BOOST_CHECK( gmres.getFinalResidual() <= 1e-10*gmres.getInitialResidual() );
+      for (CFuint i = 0; i < x.size(); ++i) {
+	BOOST_CHECK_SMALL( x[i] - xExact[i], 1e-8 );
+      }
+    }
+  }
+
+  // the exact factorization converges in a single iteration
+  BOOST_CHECK_EQUAL( nbIter[2], 1u );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -126,6 +126,17 @@ public:
 
    void bufferCommitParticle(CFuint faceID);
 
+   /// buffer for sending a particle that was tracked by another solver
+   /// (e.g. by another thread) up to the partition face faceID
+   void bufferCommitParticle(Particle<UserData> particle, CFuint faceID);
+
+   /// copy the face types from another solver, which avoids building them
+   /// again (with communication) for each thread
+   inline void setFaceTypes(const LagrangianSolver<UserData, PARTICLE_TRACKING>& other)
+   {
+     m_wallTypes = other.m_wallTypes;
+   }
+
 private:
 
   void (ParticleTracking::*getNormalsPtr) (CFuint, RealVector, RealVector);
@@ -180,6 +191,19 @@ void LagrangianSolver<UserData, PARTICLE_TRACKING>::bufferCommitParticle(CFuint
 
 //////////////////////////////////////////////////////////////////////////////
 
+template<typename UserData, class PARTICLE_TRACKING>
+void LagrangianSolver<UserData, PARTICLE_TRACKING>::bufferCommitParticle
+(Particle<UserData> particle, CFuint faceID)
+{
+  cf_assert(m_wallTypes(faceID,0) == ParticleTracking::COMP_DOMAIN_FACE );
+  
+  const CFuint processRank = m_wallTypes(faceID,2);
+  particle.commonData.cellID = m_wallTypes(faceID,3);
+  m_sendBuffer->push_back(particle, processRank );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 template<typename UserData, class PARTICLE_TRACKING>
 bool LagrangianSolver<UserData,PARTICLE_TRACKING>::sincronizeParticles(std::vector< Particle<UserData> >&particleBuffer,
 								       bool isLastPhoton)
@@ -37,7 +37,8 @@ ParticleTracking::ParticleTracking(const std::string& name) :
   //Common::OwnedObject(),
   //ConfigObject(name),
   //Common::NonCopyable<ParticleTracking>(),
-  SocketBundleSetter()
+  SocketBundleSetter(),
+  m_cartNormal(2)
 {
 }
 
@@ -49,7 +50,7 @@ ParticleTracking::~ParticleTracking()
 void ParticleTracking::getAxiNormals(CFuint faceID, RealVector& CartPosition, RealVector& faceNormal ){
 
   faceNormal.resize( 3 );
-  static RealVector cartNormal(2);
+  RealVector& cartNormal = m_cartNormal;
 
   //Create the Cylindrical normal vector
 
@@ -81,6 +81,10 @@ protected: //data
   CFuint m_exitCellID, m_entryCellID;
 
   CFuint m_cellIdx, m_faceIdx;
+
+  /// 2D normal used by getAxiNormals(): each tracker has its own scratch 
+  /// data, so that different trackers can be used by different threads
+  RealVector m_cartNormal;
   
   CommonData m_particleCommonData;
 
@@ -11,7 +11,9 @@ namespace LagrangianSolver {
 
 
 ParticleTracking2D::ParticleTracking2D(const std::string& name) :
-    ParticleTracking(name)
+    ParticleTracking(name),
+    m_initialPoint(2),
+    m_buffer(2)
 {
 }
 
@@ -21,7 +23,7 @@ ParticleTracking2D::~ParticleTracking2D()
 }
 
 void ParticleTracking2D::getCommonData(CommonData &data){
-    static RealVector initialPoint(3);
+    RealVector& initialPoint = m_initialPoint;
     getExitPoint(initialPoint);
 
     data.currentPoint[0]=initialPoint[0];
@@ -36,7 +38,7 @@ void ParticleTracking2D::getCommonData(CommonData &data){
 
 void ParticleTracking2D::newParticle(CommonData &particle)
 {
-    static RealVector buffer(2);
+    RealVector& buffer = m_buffer;
     ParticleTracking::newParticle(particle);
 
    // std::cout<<"%*******************\n %NEW PARTICLE \n %************************************\n";
@@ -71,7 +73,7 @@ CFreal ParticleTracking2D::getStepDistance()
 }
 
 void ParticleTracking2D::newDirection(RealVector &direction){
-  static RealVector initialPoint(2);
+  RealVector& initialPoint = m_initialPoint;
   cf_assert(direction.size() <= 3);
   getExitPoint(initialPoint);
 
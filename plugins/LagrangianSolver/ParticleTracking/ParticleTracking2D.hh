@@ -35,6 +35,8 @@ private:
   CFreal m_particle_t,m_particle_t_old, m_face_s,m_tt,m_ss, m_innerProd;
   RealVector faceOutNormal;
   RealVector particleTangent;
+  RealVector m_initialPoint;
+  RealVector m_buffer;
 
 };
 
@@ -19,7 +19,8 @@ ParticleTracking3D::ParticleTracking3D(const std::string& name):
     ParticleTracking(name),
     m_exitPoint(3),
     m_entryPoint(3),
-    m_direction(3)
+    m_direction(3),
+    m_buffer(3)
 {
 
 }
@@ -29,7 +30,7 @@ ParticleTracking3D::~ParticleTracking3D(){
 }
 
 void ParticleTracking3D::getCommonData(CommonData &data){
-  static RealVector initialPoint(3);
+  RealVector& initialPoint = m_buffer;
   getExitPoint(initialPoint);
 
   data.currentPoint[0]=initialPoint[0];
@@ -307,7 +308,7 @@ void ParticleTracking3D::newParticle(CommonData &particle){
 
 //  std::cout<<"%*******************\n%NEW PARTICLE\n%************************************\n";
 
-  static RealVector buffer(3);
+  RealVector& buffer = m_buffer;
   ParticleTracking::newParticle(particle);
 
   m_entryCellID = m_particleCommonData.cellID;
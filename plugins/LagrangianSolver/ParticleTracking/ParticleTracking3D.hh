@@ -45,7 +45,7 @@ public:
 private:
     std::vector<CFreal> m_centroids;
     CFuint m_maxNbFaces;
-    RealVector m_exitPoint, m_entryPoint, m_direction;
+    RealVector m_exitPoint, m_entryPoint, m_direction, m_buffer;
     CFreal m_stepDist;
 };
 
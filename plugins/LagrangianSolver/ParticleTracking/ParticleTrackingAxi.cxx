@@ -15,7 +15,11 @@ ParticleTrackingAxi::ParticleTrackingAxi(const std::string& name) :
     //m_tCantidates(),
     //m_fCandidates(),
     faceOutNormal(2),
-    rayTangent(2)
+    rayTangent(2),
+    m_initialPoint(3),
+    m_buffer(3),
+    m_tCandidates(),
+    m_fCandidates()
 {
     //m_tCantidates.reserve(5);
     //m_fCandidates.reserve(5);
@@ -27,7 +31,7 @@ ParticleTrackingAxi::~ParticleTrackingAxi()
 }
 
 void ParticleTrackingAxi::getCommonData(CommonData &data){
-    static RealVector initialPoint(3);
+    RealVector& initialPoint = m_initialPoint;
     getExitPoint(initialPoint);
 
     data.currentPoint[0]=initialPoint[0];
@@ -44,7 +48,7 @@ void ParticleTrackingAxi::getCommonData(CommonData &data){
 
 void ParticleTrackingAxi::newParticle(CommonData &particle)
 {
-    static RealVector buffer(3);
+    RealVector& buffer = m_buffer;
     ParticleTracking::newParticle(particle);
 
     m_particle_t_old=1e-8;
@@ -63,6 +67,8 @@ void ParticleTrackingAxi::newParticle(CommonData &particle)
 
 void ParticleTrackingAxi::setupAlgorithm(){
   m_maxNbFaces = Framework::MeshDataStack::getActive()->Statistics().getMaxNbFacesInCell();
+  m_tCandidates.resize(m_maxNbFaces*2);
+  m_fCandidates.resize(m_maxNbFaces*2);
 }
 
 //Maybe use the cell->getNeighborGeos() for caching.
@@ -84,7 +90,7 @@ CFreal ParticleTrackingAxi::getStepDistance()
 }
 
 void ParticleTrackingAxi::newDirection(RealVector &direction){
-  static RealVector initialPoint(3);
+  RealVector& initialPoint = m_initialPoint;
   cf_assert(direction.size() == 3);
   getExitPoint(initialPoint);
 
@@ -135,8 +141,8 @@ void ParticleTrackingAxi::trackingStep(){
 
   static DataHandle<CFint> faceIsOutwards= m_sockets.isOutward.getDataHandle();
 
-  static vector<CFreal> t_candidates(m_maxNbFaces*2);
-  static vector<CFuint> f_candidates(m_maxNbFaces*2);
+  vector<CFreal>& t_candidates = m_tCandidates;
+  vector<CFuint>& f_candidates = m_fCandidates;
 
   CellTrsGeoBuilder::GeoData& cellData = m_cellBuilder.getDataGE();
   //this->m_cellIdx = this->m_CellIDmap.find(this->m_entryCellID);
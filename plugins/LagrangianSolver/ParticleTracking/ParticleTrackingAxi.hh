@@ -48,6 +48,10 @@ private:
     //std::vector<CFreal> m_fCandidates;
     RealVector faceOutNormal;
     RealVector rayTangent;
+    RealVector m_initialPoint;
+    RealVector m_buffer;
+    std::vector<CFreal> m_tCandidates;
+    std::vector<CFuint> m_fCandidates;
 
 };
 
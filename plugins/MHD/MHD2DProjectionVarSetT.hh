@@ -228,7 +228,7 @@ public: // classes
     CFreal cf2 = 0.5*(astar2 + sqrt(astar2*astar2 - 4.0*gamma*p*Bn*Bn*invRho*invRho));
     
     const CFreal cf = sqrt(abs(cf2));
-    const CFreal maxEigenValue = max(refSpeed,(Vn + cf)); //(refSpeed > (Vn + cf)) ? refSpeed : Vn +cf; // max(refSpeed,(Vn + cf));
+    const CFreal maxEigenValue = (refSpeed > (Vn + cf)) ? refSpeed : Vn + cf; // max(refSpeed,(Vn + cf));
     return maxEigenValue;
   }
   
@@ -252,7 +252,7 @@ public: // classes
     const CFreal cf2 = 0.5*(astar2 + astarb);
     const CFreal cf = sqrt(cf2);
     // const CFreal cf = sqrt(abs(cf2));
-    const CFreal maxEigenValue = max(refSpeed,(Vn + cf));
+    const CFreal maxEigenValue = (refSpeed > (Vn + cf)) ? refSpeed : Vn + cf; // max(refSpeed,(Vn + cf));
     return maxEigenValue;
   }
   
@@ -34,7 +34,7 @@ public:
    */
   enum PotentialBType {NONE=0, DIPOLE=1, PFSS=2};
   
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
   /// nested class defining local options
   template <typename P = NOTYPE>
   class DeviceConfigOptions {
@@ -75,6 +75,7 @@ public:
     CFreal mZ;
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the Framework::DEVICE
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
@@ -85,6 +86,7 @@ public:
     CudaEnv::copyHost2Dev(&dco->mY, &_mY, 1);
     CudaEnv::copyHost2Dev(&dco->mZ, &_mZ, 1);
   }  
+#endif
   
   /// copy the local configuration options to the Framework::DEVICE
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
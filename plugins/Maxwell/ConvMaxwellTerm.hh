@@ -31,7 +31,7 @@ class ConvMaxwellTerm : public Framework::BaseTerm {
 public:
   
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
     
    //Nested class defining local options
    template <typename P = NOTYPE >   //Need to ask about this
@@ -93,6 +93,7 @@ public:
     }
 
        //Copy the local configuration to the DEVICE
+#ifdef CF_HAVE_CUDA
     void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco)
     {
           CudaEnv::copyHost2Dev(&dco->divBCleaningConst, &_divBCleaningConst, 1);
@@ -105,6 +106,7 @@ public:
           CudaEnv::copyHost2Dev(&dco->solarGravity, &_solarGravity, 1);
   
     }
+#endif
 
 
 
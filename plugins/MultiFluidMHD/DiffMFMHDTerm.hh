@@ -30,7 +30,7 @@ class DiffMFMHDTerm : public Framework::BaseTerm {
   
 public:
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
     
    //Nested class defining local options
    template <typename P = NOTYPE >  
@@ -53,7 +53,9 @@ public:
     void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco){}
 
        //Copy the local configuration to the DEVICE
+#ifdef CF_HAVE_CUDA
     void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco){}
+#endif
 
 #endif
 
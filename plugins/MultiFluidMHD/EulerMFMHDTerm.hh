@@ -37,7 +37,7 @@ public:
 
 
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
     
    //Nested class defining local options
    template <typename P = NOTYPE >   //Need to ask about this
@@ -153,6 +153,7 @@ public:
     }
 
        //Copy the local configuration to the DEVICE
+#ifdef CF_HAVE_CUDA
     void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco)
     { 
           CFLog(VERBOSE, "EulerMFMHDTerm::DeviceConfigOptions::copyConfigOptionsToDevice()  START \n \n");
@@ -220,6 +221,7 @@ public:
           CFLog(VERBOSE, "EulerMFMHDTerm::DeviceConfigOptions::copyConfigOptionsToDevice()  END \n \n");
 
     }
+#endif
 
 
 
@@ -3,6 +3,7 @@
 #include "Common/CFLog.hh"
 #include "Environment/ObjectProvider.hh"
 #include "Common/StringOps.hh"
+#include "Common/HashBytes.hh"
 #include <fstream>
 
 //////////////////////////////////////////////////////////////////////////////
@@ -39,6 +40,8 @@ void MutationLibrarypp::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< std::string >
     ("StateModelName","Name of the state model (e.g. \"Equil\", \"ChemNonEq1T\", \"ChemNonEq1TTv\").");
   options.addConfigOption< bool >("ShiftH0","Shift the formation enthalpy to have H(T=0K)=0."); 
+  options.addConfigOption< CFuint >
+    ("StateCacheSize","Number of thermodynamic states whose computed quantities are kept for reuse (0 to disable).");
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -56,7 +59,13 @@ MutationLibrarypp::MutationLibrarypp(const std::string& name)
     m_molarmassp(),
     m_df(),
     m_rhoivBkp(),
-    m_rhoiv()
+    m_rhoiv(),
+    m_stateCache(),
+    m_curEntry(CFNULL),
+    m_mixtureSynced(true),
+    m_nbTemps(1),
+    m_nbCacheHits(0),
+    m_nbCacheMisses(0)
 {
   addConfigOptionsTo(this);
   
@@ -68,6 +77,9 @@ MutationLibrarypp::MutationLibrarypp(const std::string& name)
   
   m_shiftHO = true;
   setParameter("ShiftH0",&m_shiftHO);
+  
+  m_stateCacheSize = 4096;
+  setParameter("StateCacheSize",&m_stateCacheSize);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -156,6 +168,14 @@ void MutationLibrarypp::setup()
     CFLog(VERBOSE, "MutationLibrarypp::setup() => " << yH0.sum() << " == " << m_H0 << "\n");
   }
   
+  // the state cache is filled by setState()
+  m_nbTemps = m_gasMixture->nEnergyEqns();
+  m_stateCache.clear();
+  m_stateCache.resize(m_stateCacheSize);
+  m_curEntry = CFNULL;
+  m_mixtureSynced = true;
+  m_nbCacheHits = m_nbCacheMisses = 0;
+  
   CFLog(VERBOSE, "MutationLibrarypp::setup() => end\n"); 
 }
       
@@ -165,6 +185,14 @@ void MutationLibrarypp::unsetup()
 {
   CFLog(VERBOSE, "MutationLibrarypp::unsetup() => start\n"); 
   
+  if (m_nbCacheHits + m_nbCacheMisses > 0) {
+    CFLog(VERBOSE, "MutationLibrarypp::unsetup() => state cache hits [" << m_nbCacheHits 
+	  << "], misses [" << m_nbCacheMisses << "]\n");
+  }
+  std::vector<StateCacheEntry>().swap(m_stateCache);
+  m_curEntry = CFNULL;
+  m_mixtureSynced = true;
+  
   if(isSetup()) {
     Framework::PhysicalChemicalLibrary::unsetup();
   }
@@ -174,10 +202,58 @@ void MutationLibrarypp::unsetup()
       
 //////////////////////////////////////////////////////////////////////////////
 
+void MutationLibrarypp::setState(CFdouble* rhoi, CFdouble* T)
+{
+  RealVector rhoiv(_NS, &rhoi[0]);
+  CFLog(DEBUG_MAX, "MutationLibrarypp::setState() => rhoiv = " << rhoiv << ", T = " << *T << "\n"); 
+  
+  if (m_stateCache.empty()) {
+    m_gasMixture->setState(rhoi, T, 1);
+    return;
+  }
+  
+  // the entry is chosen by the hash of the partial densities and temperatures
+  const CFuint nbSpecies = _NS;
+  boost::uint64_t hash = HASH_BYTES_SEED;
+  hashBytes(rhoi, nbSpecies*sizeof(CFdouble), hash);
+  hashBytes(T, m_nbTemps*sizeof(CFdouble), hash);
+  StateCacheEntry& entry = m_stateCache[hash % m_stateCache.size()];
+  
+  bool found = !entry.key.empty();
+  for (CFuint i = 0; i < nbSpecies && found; ++i) {
+    found = (entry.key[i] == rhoi[i]);
+  }
+  for (CFuint i = 0; i < m_nbTemps && found; ++i) {
+    found = (entry.key[nbSpecies+i] == T[i]);
+  }
+  
+  m_curEntry = &entry;
+  if (found) {
+    // the gas mixture is set only if a quantity which is not cached is needed
+    m_mixtureSynced = false;
+    ++m_nbCacheHits;
+  }
+  else {
+    entry.key.resize(nbSpecies + m_nbTemps);
+    std::copy(rhoi, rhoi + nbSpecies, entry.key.begin());
+    std::copy(T, T + m_nbTemps, entry.key.begin() + nbSpecies);
+    entry.hsOverRT.resize(nbSpecies);
+    entry.flags = 0;
+    m_gasMixture->setState(rhoi, T, 1);
+    m_mixtureSynced = true;
+    ++m_nbCacheMisses;
+  }
+}
+  
+//////////////////////////////////////////////////////////////////////////////
+
 CFdouble MutationLibrarypp::lambdaNEQ(CFdouble& temperature,
 				      CFdouble& pressure)
 {
+  if (isCached(LAMBDA)) {return m_curEntry->lambda;}
+  syncMixtureState();
   CFreal k = m_gasMixture->frozenThermalConductivity();
+  if (m_curEntry != CFNULL) {cacheValue(LAMBDA, m_curEntry->lambda, k);}
   // RESET_TO_ZERO(k);
   CFLog(DEBUG_MAX, "Mutation::lambdaNEQ() => k = " << k << "\n");
   return k;
@@ -203,7 +279,7 @@ CFdouble MutationLibrarypp::sigma(CFdouble& temp, //electrical conductivity
   if (temp < 100.) {temp = 100.;}
   // this needs to be modified for NEQ case unless one assumes to have called 
   // setState() before  
-  m_gasMixture->setState(&pressure, &temp, 1);
+  setStatePT(pressure, temp);
   return m_gasMixture->sigma();
 }
       
@@ -215,6 +291,7 @@ void MutationLibrarypp::gammaAndSoundSpeed(CFdouble& temp,
 					   CFdouble& gamma,
 					   CFdouble& soundSpeed)
 {
+  syncMixtureState();
   gamma = m_gasMixture->mixtureEquilibriumGamma();
   soundSpeed = m_gasMixture->equilibriumSoundSpeed();
   
@@ -232,7 +309,14 @@ void MutationLibrarypp::frozenGammaAndSoundSpeed(CFdouble& temp,
 						 CFdouble& soundSpeed,
 						 RealVector* tVec)
 {
-  gamma = m_gasMixture->mixtureFrozenGamma();
+  if (isCached(GAMMA)) {
+    gamma = m_curEntry->gamma;
+  }
+  else {
+    syncMixtureState();
+    gamma = m_gasMixture->mixtureFrozenGamma();
+    if (m_curEntry != CFNULL) {cacheValue(GAMMA, m_curEntry->gamma, gamma);}
+  }
   // soundSpeed = m_gasMixture->frozenSoundSpeed();
   soundSpeed = std::sqrt(gamma*pressure/rho); 
   
@@ -245,7 +329,7 @@ void MutationLibrarypp::frozenGammaAndSoundSpeed(CFdouble& temp,
       
 CFdouble MutationLibrarypp::soundSpeed(CFdouble& temp, CFdouble& pressure)
 {
-  m_gasMixture->setState(&pressure, &temp, 1);
+  setStatePT(pressure, temp);
   return m_gasMixture->equilibriumSoundSpeed();
 }
 
@@ -257,7 +341,7 @@ void MutationLibrarypp::setComposition(CFdouble& temp,
 {
   if (temp < 100.) {temp = 100.;}
 
-  m_gasMixture->setState(&pressure, &temp, 1);
+  setStatePT(pressure, temp);
   const double* xm = m_gasMixture->X();
   
   if (x != CFNULL) {
@@ -280,8 +364,19 @@ void MutationLibrarypp::setDensityEnthalpyEnergy(CFdouble& temp,
   CFLog(DEBUG_MAX, "Mutation::setDensityEnthalpyEnergy() => P = " 
 	<< pressure << ", T = " << temp << "\n");
   
-  dhe[0] = m_gasMixture->density();
-  dhe[1] = m_gasMixture->mixtureHMass() - m_H0;
+  if (!isCached(DENSITY) || !isCached(ENTHALPY)) {
+    syncMixtureState();
+    dhe[0] = m_gasMixture->density();
+    dhe[1] = m_gasMixture->mixtureHMass() - m_H0;
+    if (m_curEntry != CFNULL) {
+      cacheValue(DENSITY, m_curEntry->rho, dhe[0]);
+      cacheValue(ENTHALPY, m_curEntry->h, dhe[1]);
+    }
+  }
+  else {
+    dhe[0] = m_curEntry->rho;
+    dhe[1] = m_curEntry->h;
+  }
   dhe[2] = dhe[1]-pressure/dhe[0];
   
   CFLog(DEBUG_MAX, "Mutation::setDensityEnthalpyEnergy() => " << dhe << ", " <<  m_y << "\n");
@@ -304,8 +399,12 @@ CFdouble MutationLibrarypp::density(CFdouble& temp,
 				    CFdouble& pressure,
 				    CFreal* tVec)
 {
-  if (m_smType == LTE) {m_gasMixture->setState(&pressure, &temp, 1);}
-  return m_gasMixture->density();
+  if (m_smType == LTE) {setStatePT(pressure, temp);}
+  if (isCached(DENSITY)) {return m_curEntry->rho;}
+  syncMixtureState();
+  const CFreal rho = m_gasMixture->density();
+  if (m_curEntry != CFNULL) {cacheValue(DENSITY, m_curEntry->rho, rho);}
+  return rho;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -318,7 +417,10 @@ CFdouble MutationLibrarypp::pressure(CFdouble& rho,
 	<< ", y = " << m_y << "\n");
   
   // const CFreal p = m_gasMixture->pressure(temp, rho, &m_y[0]);
+  if (isCached(PRESSURE)) {return m_curEntry->p;}
+  syncMixtureState();
   const CFreal p = m_gasMixture->P();
+  if (m_curEntry != CFNULL) {cacheValue(PRESSURE, m_curEntry->p, p);}
   if (p <= 0.) {
     CFLog(DEBUG_MAX, "Mutation::pressure() => p = " << p << " with rho = " << rho 
 	  << ", T = " << temp << ", y = " << m_y << "\n");
@@ -343,7 +445,7 @@ CFdouble MutationLibrarypp::energy(CFdouble& temp,
 				   CFdouble& pressure)
   
 {
-  m_gasMixture->setState(&pressure, &temp, 1);
+  setStatePT(pressure, temp);
   return m_gasMixture->mixtureEnergyMass()- m_H0;
 }
       
@@ -352,7 +454,7 @@ CFdouble MutationLibrarypp::energy(CFdouble& temp,
 CFdouble MutationLibrarypp::enthalpy(CFdouble& temp,
 				     CFdouble& pressure)
 {
-  m_gasMixture->setState(&pressure, &temp, 1);
+  setStatePT(pressure, temp);
   return m_gasMixture->mixtureHMass() - m_H0;
 }
       
@@ -484,6 +586,7 @@ void MutationLibrarypp::getMassProductionTerm(CFdouble& temperature,
   
   // we assume setState() already called before
   if (!_freezeChemistry) {
+    syncMixtureState();
     m_gasMixture->netProductionRates(&omega[0]);
   } 
   else {
@@ -509,6 +612,7 @@ void MutationLibrarypp::getSource(CFdouble& temperature,
   
 {
   // we assume setState() already called before
+  syncMixtureState();
   m_gasMixture->netProductionRates(&omega[0]);
 }
       
@@ -522,6 +626,7 @@ void MutationLibrarypp::getRhoUdiff(CFdouble& temperature,
 				   bool fast)
 {  
   // Set driving forces as gradients of molar fractions
+  syncMixtureState();
   CFreal MMass = m_gasMixture->mixtureMw();
   CFreal normMMassGradient = 0.0;
   for (CFint is = 0; is < _NS; ++is) {
@@ -597,7 +702,23 @@ void MutationLibrarypp::getSpeciesTotEnthalpies(CFdouble& temp,
   // recheck this with 2-temperature
   CFreal* hv = (hsVib != CFNULL) ? &(*hsVib)[0] : CFNULL;
   CFreal* he = (hsEl  != CFNULL) ?  &(*hsEl)[0] : CFNULL;
-  m_gasMixture->speciesHOverRT(&hsTot[0], CFNULL, CFNULL, hv, he); 
+  // only the total enthalpies are cached
+  const bool useCache = (m_curEntry != CFNULL && hv == CFNULL && he == CFNULL);
+  if (useCache && isCached(SPECIES_H)) {
+    for (CFint i = 0; i < _NS; ++i) {
+      hsTot[i] = m_curEntry->hsOverRT[i];
+    }
+  }
+  else {
+    syncMixtureState();
+    m_gasMixture->speciesHOverRT(&hsTot[0], CFNULL, CFNULL, hv, he); 
+    if (useCache) {
+      for (CFint i = 0; i < _NS; ++i) {
+	m_curEntry->hsOverRT[i] = hsTot[i];
+      }
+      m_curEntry->flags |= SPECIES_H;
+    }
+  }
   
   const CFreal RT = _Rgas*temp;
   for (CFuint i = 0; i < _NS; ++i) {
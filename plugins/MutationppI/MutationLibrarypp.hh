@@ -75,14 +75,11 @@ public:
   void getMolarMasses(RealVector& mm);
   
   /// Set the thermodynamic state (temperature and pressure)
+  /// If the same state has been set recently, the quantities already 
+  /// computed for it are taken from the state cache
   /// @param species partial densities
   /// @param mixture temperature
-  void setState(CFdouble* rhoi, CFdouble* T) 
-  {
-    RealVector rhoiv(_NS, &rhoi[0]);
-    CFLog(DEBUG_MAX, "MutationLibrarypp::setState() => rhoiv = " << rhoiv << ", T = " << *T << "\n"); 
-    m_gasMixture->setState(rhoi, T, 1);
-  }   
+  void setState(CFdouble* rhoi, CFdouble* T);
   
   /**
    * Compute and get the electron pressure
@@ -190,7 +187,10 @@ public:
    */
   CFdouble eta(CFdouble& temp, CFdouble& pressure, CFreal* tVec)
   {
+    if (isCached(MU)) {return m_curEntry->mu;}
+    syncMixtureState();
     CFreal mu = m_gasMixture->viscosity();
+    if (m_curEntry != CFNULL) {cacheValue(MU, m_curEntry->mu, mu);}
     // RESET_TO_ZERO(mu);
     CFLog(DEBUG_MAX, "Mutation::eta() => mu = " << mu << "\n");
     return mu;
@@ -203,6 +203,7 @@ public:
    */
     CFdouble lambdaEQ(CFdouble& temp, CFdouble& pressure)
     {
+      syncMixtureState();
       return m_gasMixture->equilibriumThermalConductivity();
     }
   
@@ -553,6 +554,60 @@ private: // helper function
   /// enumerator for the state model type 
   enum StateModelType {LTE=0, CNEQ=1, TCNEQ=2};
   
+  /// flags of the quantities stored in a state cache entry
+  enum CachedQuantity {PRESSURE=1, DENSITY=2, ENTHALPY=4, GAMMA=8, 
+		       MU=16, LAMBDA=32, SPECIES_H=64};
+  
+  /// This struct holds the quantities computed for one thermodynamic state,
+  /// identified by its partial densities and temperatures
+  struct StateCacheEntry {
+    /// partial densities followed by the temperatures
+    std::vector<CFreal> key;
+    /// flags of the quantities already computed
+    CFuint flags;
+    CFreal p;
+    CFreal rho;
+    CFreal h;
+    CFreal gamma;
+    CFreal mu;
+    CFreal lambda;
+    /// species enthalpies over RT
+    std::vector<CFreal> hsOverRT;
+  };
+  
+  /// Set the thermodynamic state given the pressure and the temperature,
+  /// which is not stored in the state cache
+  void setStatePT(CFdouble& pressure, CFdouble& temp)
+  {
+    m_curEntry = CFNULL;
+    m_mixtureSynced = true;
+    m_gasMixture->setState(&pressure, &temp, 1);
+  }
+  
+  /// Set the current state in the gas mixture if this has been skipped
+  /// when the state was found in the cache
+  void syncMixtureState()
+  {
+    if (!m_mixtureSynced) {
+      cf_assert(m_curEntry != CFNULL);
+      m_gasMixture->setState(&m_curEntry->key[0], &m_curEntry->key[_NS], 1);
+      m_mixtureSynced = true;
+    }
+  }
+  
+  /// Tell if the given quantity has been computed for the current state
+  bool isCached(const CachedQuantity q) const
+  {
+    return (m_curEntry != CFNULL && (m_curEntry->flags & q));
+  }
+  
+  /// Store the given quantity for the current state
+  void cacheValue(const CachedQuantity q, CFreal& entryValue, const CFreal value)
+  {
+    entryValue = value;
+    m_curEntry->flags |= q;
+  }
+  
 protected:
     
   /// gas mixture pointer
@@ -603,6 +658,27 @@ protected:
   /// shift the formation enthalpy to have H(T=0K)=0
   bool m_shiftHO;
   
+  /// number of entries of the state cache (0 disables it)
+  CFuint m_stateCacheSize;
+  
+  /// state cache, each state being stored in the entry given by its hash
+  std::vector<StateCacheEntry> m_stateCache;
+  
+  /// cache entry of the current state (CFNULL if the state is not cached)
+  StateCacheEntry* m_curEntry;
+  
+  /// flag telling if the gas mixture is set to the current state
+  bool m_mixtureSynced;
+  
+  /// number of temperatures defining the thermodynamic state
+  CFuint m_nbTemps;
+  
+  /// number of states found in the cache
+  CFuint m_nbCacheHits;
+  
+  /// number of states not found in the cache
+  CFuint m_nbCacheMisses;
+  
 }; // end of class MutationLibrarypp
       
 //////////////////////////////////////////////////////////////////////////////
@@ -125,6 +125,12 @@ public: // methods
   virtual void computePhysicalData(const Framework::State& state,
 			   RealVector& data);
   
+  /**
+   * The physical data only depend on the state and on the constants of the
+   * perfect gas model
+   */
+  virtual bool isThreadSafe() const {return true;}
+  
   /**
    * Set a State starting from the given PhysicalData
    * @see EulerPhysicalModel
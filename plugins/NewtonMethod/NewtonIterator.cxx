@@ -55,7 +55,10 @@ void NewtonIterator::defineConfigOptions(Config::OptionList& options)
 //////////////////////////////////////////////////////////////////////////////
 
 NewtonIterator::NewtonIterator(const std::string& name)
-  : ConvergenceMethod(name)
+  : ConvergenceMethod(name),
+    m_nbStepsWithJacob(0),
+    m_forceJacob(true),
+    m_lastResidual(0.)
 {
   addConfigOptionsTo(this);
 
@@ -139,6 +142,9 @@ void NewtonIterator::setMethodImpl()
   m_data->setLinearSystemSolver(getLinearSystemSolver());
   setupCommandsAndStrategies();
   m_setup->execute();
+
+  // a new matrix has to be assembled after each setup
+  m_forceJacob = true;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -215,7 +221,8 @@ void NewtonIterator::takeStepImpl()
    
     CFLog(VERBOSE, "NewtonIterator::takeStep(): m_data->freezeJacobian() " << m_data->freezeJacobian() << "\n");
     // this will make the solvers compute the jacobian only during the first iteration at each time step
-    (m_data->freezeJacobian() && k > 1) ? m_data->setDoComputeJacobFlag(false) : m_data->setDoComputeJacobFlag(true);
+    // or, if the jacobian is lagged, once every JacobianLagSteps steps
+    m_data->setDoComputeJacobFlag(computeJacobianInStep(k));
     
     // this is needed for cases like jacobian free
     getMethodData()->getCollaborator<SpaceMethod>()->setComputeJacobianFlag( m_data->getDoComputeJacobFlag() );
@@ -269,6 +276,7 @@ void NewtonIterator::takeStepImpl()
 
     getMethodData()->getCollaborator<SpaceMethod>()->postProcessSolution();
     getConvergenceMethodData()->getConvergenceStatus().res = subSysStatus->getResidual();
+    updateJacobianLag(subSysStatus->getResidual());
 
     // Display info over each step of the Newton iterator
     if (m_data->isPrintHistory())
@@ -286,6 +294,50 @@ void NewtonIterator::takeStepImpl()
   CFLog(VERBOSE, "NewtonIterator::takeStepImpl() END\n");
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+bool NewtonIterator::computeJacobianInStep(const CFuint k)
+{
+  if (m_data->freezeJacobian() && k > 1) {
+    return false;
+  }
+  
+  const CFuint lagSteps = m_data->getJacobianLagSteps();
+  if (lagSteps <= 1) {
+    return true;
+  }
+  
+  const bool computeJacob = m_forceJacob || (m_nbStepsWithJacob >= lagSteps);
+  if (computeJacob) {
+    m_nbStepsWithJacob = 0;
+    m_forceJacob = false;
+  }
+  ++m_nbStepsWithJacob;
+  
+  // the preconditioner of an unchanged matrix doesn't need to be recomputed
+  for (CFuint i = 0; i < getLinearSystemSolver().size(); ++i) {
+    getLinearSystemSolver()[i]->setReusePreconditioner(!computeJacob);
+  }
+  
+  CFLog(VERBOSE, "NewtonIterator::computeJacobianInStep() => computeJacob [" << computeJacob 
+	<< "], steps with this jacobian [" << m_nbStepsWithJacob << "]\n");
+  return computeJacob;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void NewtonIterator::updateJacobianLag(const CFreal residual)
+{
+  // a lagged jacobian which doesn't reduce the residual enough is recomputed
+  if (m_data->getJacobianLagSteps() > 1 && m_nbStepsWithJacob > 1 &&
+      (m_lastResidual - residual) < m_data->getJacobianLagMinDrop()) {
+    CFLog(VERBOSE, "NewtonIterator::updateJacobianLag() => residual drop [" 
+	  << m_lastResidual - residual << "] too small, recomputing the jacobian\n");
+    m_forceJacob = true;
+  }
+  m_lastResidual = residual;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
     } // namespace NewtonMethod
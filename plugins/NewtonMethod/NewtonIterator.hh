@@ -77,6 +77,13 @@ protected: // abstract interface implementations
   /// Perform the prepare phase before any iteration
   virtual void prepare ();
 
+  /// Tell if the jacobian has to be computed in the current Newton step
+  /// @param k  index of the Newton step in the current time step
+  bool computeJacobianInStep(const CFuint k);
+
+  /// Update the jacobian lagging status with the residual reached in the last step
+  void updateJacobianLag(const CFreal residual);
+
 protected: // member data
 
 ///The data to share between NewtonMethodMethod commands
@@ -125,6 +132,15 @@ protected: // member data
   ///The string for configuration of m_aleUpdate command
   std::string m_aleUpdateStr;
 
+  /// number of Newton steps performed with the current jacobian
+  CFuint m_nbStepsWithJacob;
+
+  /// flag forcing to compute the jacobian in the next Newton step
+  bool m_forceJacob;
+
+  /// residual reached in the last Newton step
+  CFreal m_lastResidual;
+
 }; // class NewtonIterator
 
 //////////////////////////////////////////////////////////////////////////////
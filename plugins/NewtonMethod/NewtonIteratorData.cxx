@@ -35,6 +35,8 @@ void NewtonIteratorData::defineConfigOptions(Config::OptionList& options)
    options.addConfigOption< bool >          ("SaveSystemToFile","Save files of matrix rhs solution vectors at each Newton step");
    options.addConfigOption< bool >          ("PrintHistory","Print convergence history for each Newton Iterator step");
    options.addConfigOption< vector<CFuint> >("MaxSteps","Maximum steps to perform in the newton loop.");
+   options.addConfigOption< CFuint >        ("JacobianLagSteps","Number of Newton steps sharing the same jacobian and preconditioner (1 recomputes them at every step).");
+   options.addConfigOption< CFreal >        ("JacobianLagMinDrop","Minimum residual drop (orders of magnitude) of a step with a lagged jacobian, below which the jacobian is recomputed.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -57,6 +59,12 @@ NewtonIteratorData::NewtonIteratorData(Common::SafePtr<Framework::Method> owner)
 
   m_saveSystemToFile = false;
   setParameter("SaveSystemToFile",&m_saveSystemToFile);
+
+  m_jacobLagSteps = 1;
+  setParameter("JacobianLagSteps",&m_jacobLagSteps);
+
+  m_jacobLagMinDrop = 0.;
+  setParameter("JacobianLagMinDrop",&m_jacobLagMinDrop);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -78,6 +86,10 @@ void NewtonIteratorData::configure ( Config::ConfigArgs& args )
     m_maxSteps[0] = 1;
   }
   cf_assert(m_maxSteps.size() > 0);
+
+  if (m_jacobLagSteps == 0) {
+    m_jacobLagSteps = 1;
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
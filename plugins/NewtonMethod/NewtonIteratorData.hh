@@ -92,6 +92,19 @@ public: // functions
     m_achieved = achieved;
   }
 
+  /// Gets the number of Newton steps sharing the same jacobian and preconditioner
+  CFuint getJacobianLagSteps() const
+  {
+    return m_jacobLagSteps;
+  }
+
+  /// Gets the minimum residual drop (in orders of magnitude) of a step with
+  /// a lagged jacobian, below which the jacobian is recomputed
+  CFreal getJacobianLagMinDrop() const
+  {
+    return m_jacobLagMinDrop;
+  }
+
   /// Sets the LinearSystemSolver for this SpaceMethod to use
   /// @pre the pointer to LinearSystemSolver is not constant to
   ///      allow dynamic_casting
@@ -127,6 +140,12 @@ private: // data
   /// flag to indicate saving files of system matrix, rhs and solution vectors at each iteration
   bool m_saveSystemToFile;
 
+  /// number of Newton steps sharing the same jacobian and preconditioner
+  CFuint m_jacobLagSteps;
+
+  /// minimum residual drop of a step with a lagged jacobian
+  CFreal m_jacobLagMinDrop;
+
 }; // end of class NewtonIteratorData
 
 //////////////////////////////////////////////////////////////////////////////
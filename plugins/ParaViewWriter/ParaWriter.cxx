@@ -6,6 +6,9 @@
 
 #include "ParaWriter.hh"
 #include "Environment/ObjectProvider.hh"
+#include "Environment/DirPaths.hh"
+#include "Common/PE.hh"
+#include "Framework/PathAppender.hh"
 #include "ParaViewWriter/ParaViewWriter.hh"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -115,6 +118,32 @@ void ParaWriter::openImpl()
   CFAUTOTRACE;
   computeFullOutputName();
   m_data->setFilename(m_fullOutputName);
+
+  // in parallel, each process writes its own piece and the root process
+  // writes a .pvtu file referencing all the pieces
+  if (Common::PE::GetPE().IsParallel() && m_appendRank)
+  {
+    using namespace boost::filesystem;
+
+    path fpath = Environment::DirPaths::getInstance().getResultsDir() / m_filename;
+    const path pvtuPath = change_extension
+      (PathAppender::getInstance().appendAllInfo(fpath, m_appendIter, m_appendTime, false), ".pvtu");
+
+    // the rank is appended before the iteration and time suffixes
+    const std::string base = basename(fpath);
+    const std::string suffix = basename(pvtuPath).substr(base.size());
+
+    const CFuint nbProcs = Common::PE::GetPE().GetProcessorCount("Default");
+    std::vector<std::string> pieces(nbProcs);
+    for (CFuint iProc = 0; iProc < nbProcs; ++iProc)
+    {
+      std::ostringstream piece;
+      piece << base << "-P" << iProc << suffix << getFormatExtension();
+      pieces[iProc] = piece.str();
+    }
+
+    m_data->setParallelFilenames(pvtuPath, pieces);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -48,6 +48,8 @@ void ParaWriterData::defineConfigOptions(Config::OptionList& options)
 ParaWriterData::ParaWriterData(Common::SafePtr<Framework::Method> owner)
   : OutputFormatterData(owner),
     m_filepath(),
+    m_pvtuFilepath(),
+    m_pieceFilenames(),
     m_updateVarStr(),
     m_updateVarSet(),
     m_stdTrsGeoBuilder()
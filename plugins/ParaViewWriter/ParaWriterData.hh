@@ -90,6 +90,36 @@ public:
     return m_filepath;
   }
 
+  /**
+   * Sets the filenames of a parallel output
+   * @param pvtuFilepath path to the parallel (.pvtu) file written by the root process
+   * @param pieceFilenames names of the pieces written by each process, relative
+   *                       to the directory of the .pvtu file
+   */
+  void setParallelFilenames(const boost::filesystem::path& pvtuFilepath,
+                            const std::vector<std::string>& pieceFilenames)
+  {
+    m_pvtuFilepath = pvtuFilepath;
+    m_pieceFilenames = pieceFilenames;
+  }
+
+  /**
+   * Gets the path to the parallel (.pvtu) file
+   */
+  const boost::filesystem::path& getPVTUFilename() const
+  {
+    return m_pvtuFilepath;
+  }
+
+  /**
+   * Gets the names of the pieces of a parallel output
+   * (empty if the output is not split in pieces)
+   */
+  const std::vector<std::string>& getPieceFilenames() const
+  {
+    return m_pieceFilenames;
+  }
+
   /**
    * Tells if to print extra values
    */
@@ -156,6 +186,12 @@ private:
   /// Filename to write solution to.
   boost::filesystem::path m_filepath;
 
+  /// Parallel (.pvtu) file referencing the pieces of all the processes
+  boost::filesystem::path m_pvtuFilepath;
+
+  /// Names of the pieces written by all the processes
+  std::vector<std::string> m_pieceFilenames;
+
   /// Name of the update variable set
   std::string m_updateVarStr;
 
@@ -0,0 +1,286 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test ParaViewWriter VTK DataArray writer"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <sstream>
+
+#ifdef CF_HAVE_CONFIG_H
+  #include "coolfluid_config.h"
+#endif
+
+#ifdef CF_HAVE_ZLIB
+  #include <zlib.h>
+#endif
+
+#include "ParaViewWriter/VTKDataArrayWriter.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::IO::ParaViewWriter;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct VTKDataArrayWriter_Fixture
+{
+  /// common setup for each test case
+  VTKDataArrayWriter_Fixture()
+  {
+    // more than one zlib block of 32768 bytes, the last one being partial
+    floats.resize(10000);
+    for (CFuint i = 0; i < floats.size(); ++i) {
+      floats[i] = 0.5*i - 1000.;
+    }
+    ints.resize(8);
+    for (CFuint i = 0; i < ints.size(); ++i) {
+      ints[i] = 3*i;
+    }
+  }
+  /// common tear-down for each test case
+  ~VTKDataArrayWriter_Fixture()
+  {
+  }
+
+  /// write the test arrays in a VTK file and return its content
+  string writeFile(const bool binary, const bool base64, const bool compress)
+  {
+    ostringstream xml;
+    VTKDataArrayWriter writer(xml, binary, base64, compress);
+    writer.writeFloat32("floats", 2, floats);
+    writer.writeInteger("ints", "Int32", ints);
+    writer.writeAppendedData();
+    BOOST_CHECK_EQUAL( writer.getArrayInfos().size(), (size_t)2 );
+    return xml.str();
+  }
+
+  /// @return the value of the given attribute in the n-th DataArray element
+  string getAttribute(const string& xml, const CFuint n, const string& attribute)
+  {
+    size_t pos = 0;
+    for (CFuint i = 0; i <= n; ++i) {
+      pos = xml.find("<DataArray", pos);
+      BOOST_REQUIRE( pos != string::npos );
+      ++pos;
+    }
+    const string key = " " + attribute + "=\"";
+    const size_t start = xml.find(key, pos);
+    BOOST_REQUIRE( start != string::npos );
+    const size_t end = xml.find("\"", start + key.size());
+    return xml.substr(start + key.size(), end - start - key.size());
+  }
+
+  /// @return the content of the AppendedData element, after the '_'
+  string getAppendedData(const string& xml)
+  {
+    const size_t start = xml.find("   _");
+    const size_t end = xml.rfind("\n  </AppendedData>");
+    BOOST_REQUIRE( start != string::npos && end != string::npos );
+    return xml.substr(start + 4, end - start - 4);
+  }
+
+  /// decode some base64 characters
+  string decodeBase64(const string& chars)
+  {
+    static const string table =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    BOOST_REQUIRE( chars.size()%4 == 0 );
+    string bytes;
+    for (size_t i = 0; i < chars.size(); i += 4) {
+      boost::uint32_t quad = 0;
+      CFuint nbPads = 0;
+      for (size_t j = 0; j < 4; ++j) {
+        quad <<= 6;
+        if (chars[i+j] == '=') {
+          ++nbPads;
+        }
+        else {
+          const size_t value = table.find(chars[i+j]);
+          BOOST_REQUIRE( value != string::npos );
+          quad |= value;
+        }
+      }
+      bytes.push_back(static_cast<char>((quad >> 16) & 0xFF));
+      if (nbPads < 2) bytes.push_back(static_cast<char>((quad >> 8) & 0xFF));
+      if (nbPads < 1) bytes.push_back(static_cast<char>(quad & 0xFF));
+    }
+    return bytes;
+  }
+
+  /// @return the 64 bit header value at the given position
+  boost::uint64_t readHeader(const string& bytes, const size_t pos)
+  {
+    BOOST_REQUIRE( pos + sizeof(boost::uint64_t) <= bytes.size() );
+    boost::uint64_t value = 0;
+    std::memcpy(&value, bytes.data() + pos, sizeof(boost::uint64_t));
+    return value;
+  }
+
+  /// @return the bytes expected in the binary blocks of the test arrays
+  string getFloatBytes()
+  {
+    vector<float> buffer(floats.begin(), floats.end());
+    return string(reinterpret_cast<const char*>(&buffer[0]), buffer.size()*sizeof(float));
+  }
+  string getIntBytes()
+  {
+    vector<boost::int32_t> buffer(ints.begin(), ints.end());
+    return string(reinterpret_cast<const char*>(&buffer[0]), buffer.size()*sizeof(boost::int32_t));
+  }
+
+  /// values of the Float32 array
+  vector<CFreal> floats;
+
+  /// values of the Int32 array
+  vector<CFuint> ints;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( VTKDataArrayWriter_TestSuite, VTKDataArrayWriter_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_ascii )
+{
+  ostringstream xml;
+  VTKDataArrayWriter writer(xml, false, true, true);
+  BOOST_CHECK( writer.getFileAttributes().find("header_type") == string::npos );
+  BOOST_CHECK( writer.getFileAttributes().find("compressor") == string::npos );
+
+  const string file = writeFile(false, true, true);
+  BOOST_CHECK_EQUAL( getAttribute(file, 0, "format"), "ascii" );
+  BOOST_CHECK_EQUAL( getAttribute(file, 0, "NumberOfComponents"), "2" );
+  BOOST_CHECK( file.find("AppendedData") == string::npos );
+  BOOST_CHECK( file.find("\n          0 3 6 9 12 15 18 21 \n") != string::npos );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_raw )
+{
+  ostringstream xml;
+  VTKDataArrayWriter writer(xml, true, false, false);
+  BOOST_CHECK( writer.getFileAttributes().find("header_type=\"UInt64\"") != string::npos );
+
+  const string file = writeFile(true, false, false);
+  BOOST_CHECK( file.find("<AppendedData encoding=\"raw\">") != string::npos );
+  const string data = getAppendedData(file);
+
+  // each block is its 64 bit size followed by the values
+  const string floatBytes = getFloatBytes();
+  const string intBytes = getIntBytes();
+  BOOST_CHECK_EQUAL( getAttribute(file, 0, "offset"), "0" );
+  BOOST_CHECK_EQUAL( readHeader(data, 0), floatBytes.size() );
+  BOOST_CHECK( data.compare(8, floatBytes.size(), floatBytes) == 0 );
+
+  const size_t intOffset = 8 + floatBytes.size();
+  ostringstream offset;
+  offset << intOffset;
+  BOOST_CHECK_EQUAL( getAttribute(file, 1, "offset"), offset.str() );
+  BOOST_CHECK_EQUAL( readHeader(data, intOffset), intBytes.size() );
+  BOOST_CHECK( data.compare(intOffset + 8, intBytes.size(), intBytes) == 0 );
+  BOOST_CHECK_EQUAL( data.size(), intOffset + 8 + intBytes.size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_base64 )
+{
+  const string file = writeFile(true, true, false);
+  BOOST_CHECK( file.find("<AppendedData encoding=\"base64\">") != string::npos );
+  const string data = getAppendedData(file);
+
+  // header and values are encoded together, the offsets count the encoded characters
+  const string floatBytes = getFloatBytes();
+  const string intBytes = getIntBytes();
+  const size_t intOffset = 4*((8 + floatBytes.size() + 2)/3);
+  ostringstream offset;
+  offset << intOffset;
+  BOOST_CHECK_EQUAL( getAttribute(file, 0, "offset"), "0" );
+  BOOST_CHECK_EQUAL( getAttribute(file, 1, "offset"), offset.str() );
+
+  const string floatBlock = decodeBase64(data.substr(0, intOffset));
+  BOOST_CHECK_EQUAL( readHeader(floatBlock, 0), floatBytes.size() );
+  BOOST_CHECK( floatBlock.substr(8) == floatBytes );
+
+  // 8 + 32 bytes: the last group is padded
+  const string intBlock = decodeBase64(data.substr(intOffset));
+  BOOST_CHECK_EQUAL( data[data.size()-1], '=' );
+  BOOST_CHECK_EQUAL( readHeader(intBlock, 0), intBytes.size() );
+  BOOST_CHECK( intBlock.substr(8) == intBytes );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef CF_HAVE_ZLIB
+
+BOOST_AUTO_TEST_CASE( test_compressed )
+{
+  for (CFuint iEnc = 0; iEnc < 2; ++iEnc) {
+    const bool base64 = (iEnc == 1);
+    ostringstream xml;
+    VTKDataArrayWriter writer(xml, true, base64, true);
+    BOOST_CHECK( writer.getFileAttributes().find("compressor=\"vtkZLibDataCompressor\"") != string::npos );
+
+    const string file = writeFile(true, base64, true);
+    const string data = getAppendedData(file);
+    const string floatBytes = getFloatBytes();
+
+    // header: number of blocks, block size, size of the last block, compressed sizes
+    const size_t nbBlocks = (floatBytes.size() + 32767)/32768;
+    BOOST_REQUIRE_EQUAL( nbBlocks, (size_t)2 );
+    const size_t headerSize = 8*(3 + nbBlocks);
+    const size_t headerChars = base64 ? 4*((headerSize + 2)/3) : headerSize;
+    const string header = base64 ? decodeBase64(data.substr(0, headerChars)) : data.substr(0, headerSize);
+    BOOST_CHECK_EQUAL( readHeader(header, 0), nbBlocks );
+    BOOST_CHECK_EQUAL( readHeader(header, 8), (boost::uint64_t)32768 );
+    BOOST_CHECK_EQUAL( readHeader(header, 16), floatBytes.size()%32768 );
+
+    size_t compressedSize = 0;
+    for (size_t iBlock = 0; iBlock < nbBlocks; ++iBlock) {
+      compressedSize += readHeader(header, 24 + 8*iBlock);
+    }
+
+    // the compressed blocks are encoded separately from the header
+    const size_t blocksChars = base64 ? 4*((compressedSize + 2)/3) : compressedSize;
+    const string blocks = base64 ? decodeBase64(data.substr(headerChars, blocksChars)) :
+      data.substr(headerChars, blocksChars);
+    BOOST_REQUIRE_EQUAL( blocks.size(), compressedSize );
+
+    ostringstream offset;
+    offset << headerChars + blocksChars;
+    BOOST_CHECK_EQUAL( getAttribute(file, 1, "offset"), offset.str() );
+
+    string values;
+    size_t start = 0;
+    for (size_t iBlock = 0; iBlock < nbBlocks; ++iBlock) {
+      const size_t size = readHeader(header, 24 + 8*iBlock);
+      vector<Bytef> block(32768);
+      uLongf blockSize = block.size();
+      BOOST_REQUIRE_EQUAL( uncompress(&block[0], &blockSize,
+                                      reinterpret_cast<const Bytef*>(blocks.data() + start), size), Z_OK );
+      values.append(reinterpret_cast<const char*>(&block[0]), blockSize);
+      start += size;
+    }
+    BOOST_CHECK( values == floatBytes );
+  }
+}
+
+#endif // CF_HAVE_ZLIB
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,281 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <iomanip>
+
+#ifdef CF_HAVE_CONFIG_H
+  #include "coolfluid_config.h"
+#endif
+
+#ifdef CF_HAVE_ZLIB
+  #include <zlib.h>
+#endif
+
+#include "Common/CFLog.hh"
+#include "Common/FilesystemException.hh"
+
+#include "ParaViewWriter/VTKDataArrayWriter.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace IO {
+
+    namespace ParaViewWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// size of the uncompressed blocks (default of vtkZLibDataCompressor)
+static const size_t VTK_BLOCK_SIZE = 32768;
+
+/// @return true if the machine is little endian
+static bool isLittleEndianMachine()
+{
+  short int word = 0x0001;
+  char *byte = (char *) &word;
+  return byte[0];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+VTKDataArrayWriter::VTKDataArrayWriter(std::ostream& xml, const bool binary,
+                                       const bool base64, const bool compress) :
+  m_xml(xml),
+  m_binary(binary),
+  m_base64(binary && base64),
+  m_compress(binary && compress),
+  m_appended(),
+  m_arrayInfos()
+{
+#ifndef CF_HAVE_ZLIB
+  if (m_compress) {
+    CFLog(WARN, "VTKDataArrayWriter: COOLFluiD was built without zlib, the data will not be compressed\n");
+    m_compress = false;
+  }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+VTKDataArrayWriter::~VTKDataArrayWriter()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::string VTKDataArrayWriter::getFileAttributes() const
+{
+  std::string attributes = m_binary ? "version=\"1.0\"" : "version=\"0.1\"";
+  attributes += isLittleEndianMachine() ? " byte_order=\"LittleEndian\"" : " byte_order=\"BigEndian\"";
+  if (m_binary) {
+    attributes += " header_type=\"UInt64\"";
+  }
+  if (m_compress) {
+    attributes += " compressor=\"vtkZLibDataCompressor\"";
+  }
+  return attributes;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKDataArrayWriter::openDataArray(const std::string& name, const std::string& type,
+                                       const CFuint nbComponents)
+{
+  ArrayInfo info;
+  info.name = name;
+  info.type = type;
+  info.nbComponents = nbComponents;
+  m_arrayInfos.push_back(info);
+
+  m_xml << "        <DataArray type=\"" << type << "\"";
+  if (!name.empty()) {
+    m_xml << " Name=\"" << name << "\"";
+  }
+  if (nbComponents > 1) {
+    m_xml << " NumberOfComponents=\"" << nbComponents << "\"";
+  }
+
+  if (m_binary) {
+    // the offset is counted from the first byte after the '_' in the AppendedData element
+    m_xml << " format=\"appended\" offset=\"" << m_appended.size() << "\"/>\n";
+  }
+  else {
+    m_xml << " format=\"ascii\">\n";
+    m_xml << "          ";
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKDataArrayWriter::writeFloat32(const std::string& name, const CFuint nbComponents,
+                                      const std::vector<CFreal>& values)
+{
+  openDataArray(name, "Float32", nbComponents);
+
+  if (m_binary) {
+    vector<float> buffer(values.begin(), values.end());
+    appendBinary(reinterpret_cast<const char*>(buffer.empty() ? CFNULL : &buffer[0]),
+                 buffer.size()*sizeof(float));
+  }
+  else {
+    for (size_t i = 0; i < values.size(); ++i) {
+      m_xml << scientific << setprecision(12) << values[i] << " ";
+    }
+    m_xml << "\n        </DataArray>\n";
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKDataArrayWriter::writeInteger(const std::string& name, const std::string& type,
+                                      const std::vector<CFuint>& values)
+{
+  cf_assert(type == "Int32" || type == "UInt8");
+  openDataArray(name, type, 1);
+
+  if (m_binary) {
+    if (type == "Int32") {
+      vector<boost::int32_t> buffer(values.begin(), values.end());
+      appendBinary(reinterpret_cast<const char*>(buffer.empty() ? CFNULL : &buffer[0]),
+                   buffer.size()*sizeof(boost::int32_t));
+    }
+    else {
+      vector<boost::uint8_t> buffer(values.begin(), values.end());
+      appendBinary(reinterpret_cast<const char*>(buffer.empty() ? CFNULL : &buffer[0]),
+                   buffer.size()*sizeof(boost::uint8_t));
+    }
+  }
+  else {
+    for (size_t i = 0; i < values.size(); ++i) {
+      m_xml << values[i] << " ";
+    }
+    m_xml << "\n        </DataArray>\n";
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKDataArrayWriter::appendBinary(const char* data, const size_t nbBytes)
+{
+  if (!m_compress) {
+    // header: number of bytes of the data
+    vector<char> block(sizeof(boost::uint64_t) + nbBytes);
+    const boost::uint64_t header = nbBytes;
+    std::copy(reinterpret_cast<const char*>(&header),
+              reinterpret_cast<const char*>(&header) + sizeof(boost::uint64_t), block.begin());
+    std::copy(data, data + nbBytes, block.begin() + sizeof(boost::uint64_t));
+
+    // header and data are encoded together
+    if (m_base64) {
+      appendBase64(&block[0], block.size());
+    }
+    else {
+      m_appended.insert(m_appended.end(), block.begin(), block.end());
+    }
+    return;
+  }
+
+#ifdef CF_HAVE_ZLIB
+  // header: number of blocks, size of the blocks, size of the last block
+  // (0 if it is full) and compressed size of each block
+  const size_t nbBlocks = (nbBytes + VTK_BLOCK_SIZE - 1)/VTK_BLOCK_SIZE;
+  vector<boost::uint64_t> header(3 + nbBlocks);
+  header[0] = nbBlocks;
+  header[1] = VTK_BLOCK_SIZE;
+  header[2] = nbBytes%VTK_BLOCK_SIZE;
+
+  vector<char> compressed;
+  vector<Bytef> block(compressBound(VTK_BLOCK_SIZE));
+  for (size_t iBlock = 0; iBlock < nbBlocks; ++iBlock) {
+    const size_t start = iBlock*VTK_BLOCK_SIZE;
+    const size_t size = std::min(VTK_BLOCK_SIZE, nbBytes - start);
+    uLongf compressedSize = block.size();
+    const int err = compress2(&block[0], &compressedSize,
+                              reinterpret_cast<const Bytef*>(data + start), size,
+                              Z_DEFAULT_COMPRESSION);
+    if (err != Z_OK) {
+      throw Common::FilesystemException(FromHere(), "VTKDataArrayWriter: zlib compression failed");
+    }
+    header[3 + iBlock] = compressedSize;
+    compressed.insert(compressed.end(), reinterpret_cast<char*>(&block[0]),
+                      reinterpret_cast<char*>(&block[0]) + compressedSize);
+  }
+
+  // header and compressed blocks are encoded separately
+  const char* headerBytes = reinterpret_cast<const char*>(&header[0]);
+  const size_t headerSize = header.size()*sizeof(boost::uint64_t);
+  if (m_base64) {
+    appendBase64(headerBytes, headerSize);
+    appendBase64(compressed.empty() ? CFNULL : &compressed[0], compressed.size());
+  }
+  else {
+    m_appended.insert(m_appended.end(), headerBytes, headerBytes + headerSize);
+    m_appended.insert(m_appended.end(), compressed.begin(), compressed.end());
+  }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKDataArrayWriter::appendBase64(const char* data, const size_t nbBytes)
+{
+  static const char table[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  m_appended.reserve(m_appended.size() + 4*((nbBytes + 2)/3));
+  size_t i = 0;
+  for (; i + 2 < nbBytes; i += 3) {
+    const boost::uint32_t triple = (bytes[i] << 16) | (bytes[i+1] << 8) | bytes[i+2];
+    m_appended.push_back(table[(triple >> 18) & 0x3F]);
+    m_appended.push_back(table[(triple >> 12) & 0x3F]);
+    m_appended.push_back(table[(triple >> 6) & 0x3F]);
+    m_appended.push_back(table[triple & 0x3F]);
+  }
+
+  // pad the last group
+  const size_t rest = nbBytes - i;
+  if (rest > 0) {
+    const boost::uint32_t triple = (bytes[i] << 16) | ((rest == 2) ? (bytes[i+1] << 8) : 0);
+    m_appended.push_back(table[(triple >> 18) & 0x3F]);
+    m_appended.push_back(table[(triple >> 12) & 0x3F]);
+    m_appended.push_back((rest == 2) ? table[(triple >> 6) & 0x3F] : '=');
+    m_appended.push_back('=');
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKDataArrayWriter::writeAppendedData()
+{
+  if (!m_binary) return;
+
+  m_xml << "  <AppendedData encoding=\"" << (m_base64 ? "base64" : "raw") << "\">\n";
+  m_xml << "   _";
+  if (!m_appended.empty()) {
+    m_xml.write(&m_appended[0], m_appended.size());
+  }
+  m_xml << "\n  </AppendedData>\n";
+
+  // release the memory
+  vector<char>().swap(m_appended);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace ParaViewWriter
+
+  } // namespace IO
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,145 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_IO_ParaViewWriter_VTKDataArrayWriter_hh
+#define COOLFluiD_IO_ParaViewWriter_VTKDataArrayWriter_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "Common/COOLFluiD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace IO {
+
+    namespace ParaViewWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class writes the DataArray elements of a VTK XML file.
+ * In ASCII format the values are written inline. In binary format the
+ * DataArray elements only hold an offset, and the values are buffered and
+ * written at the end of the file in the AppendedData element, either as raw
+ * bytes or base64 encoded, and optionally compressed with zlib.
+ * The binary blocks use 64 bit headers (header_type="UInt64").
+ */
+class VTKDataArrayWriter {
+public:
+
+  /// Description of a written DataArray, used for the parallel (.pvtu) index
+  struct ArrayInfo {
+    std::string name;
+    std::string type;
+    CFuint nbComponents;
+  };
+
+  /**
+   * Constructor
+   * @param xml       stream of the XML part of the file
+   * @param binary    if true, write the values in the AppendedData element
+   * @param base64    if true, encode the appended values in base64
+   * @param compress  if true, compress the appended values with zlib
+   */
+  VTKDataArrayWriter(std::ostream& xml, const bool binary,
+                     const bool base64, const bool compress);
+
+  /**
+   * Destructor
+   */
+  ~VTKDataArrayWriter();
+
+  /**
+   * @return the attributes of the VTKFile element (version, byte order,
+   *         header type and compressor)
+   */
+  std::string getFileAttributes() const;
+
+  /**
+   * Write a Float32 DataArray
+   * @param name          name of the array (can be empty)
+   * @param nbComponents  number of components of each tuple
+   * @param values        values of the tuples, one after the other
+   */
+  void writeFloat32(const std::string& name, const CFuint nbComponents,
+                    const std::vector<CFreal>& values);
+
+  /**
+   * Write an integer DataArray
+   * @param name    name of the array
+   * @param type    VTK type of the array ("Int32" or "UInt8")
+   * @param values  values of the array
+   */
+  void writeInteger(const std::string& name, const std::string& type,
+                    const std::vector<CFuint>& values);
+
+  /**
+   * Write the AppendedData element (binary format only), which must come
+   * just before the end of the VTKFile element
+   */
+  void writeAppendedData();
+
+  /**
+   * @return the descriptions of the arrays written so far
+   */
+  const std::vector<ArrayInfo>& getArrayInfos() const
+  {
+    return m_arrayInfos;
+  }
+
+private: // functions
+
+  /// Write the opening tag of a DataArray
+  void openDataArray(const std::string& name, const std::string& type,
+                     const CFuint nbComponents);
+
+  /// Append a block of binary data to the AppendedData buffer
+  void appendBinary(const char* data, const size_t nbBytes);
+
+  /// Encode some bytes in base64 at the end of the AppendedData buffer
+  void appendBase64(const char* data, const size_t nbBytes);
+
+private: // data
+
+  /// stream of the XML part of the file
+  std::ostream& m_xml;
+
+  /// flag telling if the values are appended in binary format
+  bool m_binary;
+
+  /// flag telling if the appended values are base64 encoded
+  bool m_base64;
+
+  /// flag telling if the appended values are compressed
+  bool m_compress;
+
+  /// buffer of the AppendedData element
+  std::vector<char> m_appended;
+
+  /// descriptions of the written arrays
+  std::vector<ArrayInfo> m_arrayInfos;
+
+}; // class VTKDataArrayWriter
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace ParaViewWriter
+
+  } // namespace IO
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_IO_ParaViewWriter_VTKDataArrayWriter_hh
@@ -19,6 +19,7 @@
 #include "Framework/MethodCommandProvider.hh"
 #include "Framework/NamespaceSwitcher.hh"
 #include "Framework/DataHandleOutput.hh"
+#include "Common/PE.hh"
 
 #include "ParaViewWriter/ParaViewWriter.hh"
 #include "ParaViewWriter/WriteSolution.hh"
@@ -48,7 +49,9 @@ writeSolutionProvider("WriteSolution");
 
 void WriteSolution::defineConfigOptions(Config::OptionList& options)
 {
-   options.addConfigOption< std::string>("FileFormat","Format to write ParaView file.");
+   options.addConfigOption< std::string>("FileFormat","Format to write ParaView file (ASCII or BINARY).");
+   options.addConfigOption< std::string>("BinaryEncoding","Encoding of the appended data in BINARY format (raw or base64).");
+   options.addConfigOption< bool>("Compress","Compress the appended data with zlib in BINARY format.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -61,6 +64,12 @@ WriteSolution::WriteSolution(const std::string& name) : ParaWriterCom(name),
 
   m_fileFormatStr = "ASCII";
   setParameter("FileFormat",&m_fileFormatStr);
+
+  m_binaryEncodingStr = "raw";
+  setParameter("BinaryEncoding",&m_binaryEncodingStr);
+
+  m_compress = false;
+  setParameter("Compress",&m_compress);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -80,6 +89,13 @@ void WriteSolution::execute()
     writeToBinaryFile();
   }
 
+  // the root process writes the index of the pieces written by all the processes
+  if (!getMethodData().onlySurface() &&
+      !getMethodData().getPieceFilenames().empty() &&
+      PE::GetPE().GetRank("Default") == 0)
+  {
+    writePVTUFile();
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -93,9 +109,62 @@ const std::string WriteSolution::getWriterName() const
 
 void WriteSolution::writeToBinaryFile()
 {
- CFAUTOTRACE;
+  CFAUTOTRACE;
+
+  Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+  ofstream& fout = fhandle->open(getMethodData().getFilename(), ios_base::out | ios_base::binary);
 
-  throw Common::NotImplementedException (FromHere(),"Writing to binary files is not yet implemented in ParaViewWriter...");
+  writeToFileStream(fout);
+
+  fhandle->close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void WriteSolution::writePVTUFile()
+{
+  CFAUTOTRACE;
+
+  const boost::filesystem::path& pvtuFile = getMethodData().getPVTUFilename();
+  CFLog(INFO, "Writing parallel index to: " << pvtuFile.string() << "\n");
+
+  Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+  ofstream& fout = fhandle->open(pvtuFile);
+
+  fout << "<VTKFile type=\"PUnstructuredGrid\" " << m_fileAttributes << ">\n";
+  fout << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+
+  // the point data arrays are the same in all the pieces
+  fout << "    <PPointData>\n";
+  for (CFuint iArray = 0; iArray < m_pointDataArrays.size(); ++iArray)
+  {
+    const VTKDataArrayWriter::ArrayInfo& info = m_pointDataArrays[iArray];
+    fout << "      <PDataArray type=\"" << info.type << "\" Name=\"" << info.name << "\"";
+    if (info.nbComponents > 1)
+    {
+      fout << " NumberOfComponents=\"" << info.nbComponents << "\"";
+    }
+    fout << "/>\n";
+  }
+  fout << "    </PPointData>\n";
+
+  fout << "    <PPoints>\n";
+  fout << "      <PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n";
+  fout << "    </PPoints>\n";
+
+  // the pieces are in the same directory as the index
+  const std::vector<std::string>& pieces = getMethodData().getPieceFilenames();
+  for (CFuint iPiece = 0; iPiece < pieces.size(); ++iPiece)
+  {
+    fout << "    <Piece Source=\"" << pieces[iPiece] << "\"/>\n";
+  }
+
+  fout << "  </PUnstructuredGrid>\n";
+  fout << "</VTKFile>\n";
+
+  fhandle->close();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -201,16 +270,13 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
   const vector<std::string>& varNames = updateVarSet->getVarNames();
   cf_assert(varNames.size() == nbEqs);
 
+  // the DataArray's are written inline (ASCII) or in the appended data section (BINARY)
+  VTKDataArrayWriter arrayWriter(fout, m_fileFormatStr == "BINARY",
+                                 m_binaryEncodingStr == "base64", m_compress);
+  m_fileAttributes = arrayWriter.getFileAttributes();
+
   // open VTKFile element
-  fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=";
-  if (isLittleEndian())
-  {
-    fout << "\"LittleEndian\">\n";
-  }
-  else
-  {
-    fout << "\"BigEndian\">\n";
-  }
+  fout << "<VTKFile type=\"UnstructuredGrid\" " << m_fileAttributes << ">\n";
 
   // open UnstructuredGrid element
   fout << "  <UnstructuredGrid>\n";
@@ -222,18 +288,16 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
 //   fout << "      <PointData>\n";
   fout << "   <PointData Scalars=\"" << varNames[0] << "\">\n";
 
-  // some helper states
-  RealVector dimState(nbEqs);
-  RealVector extraValues; // size will be set in the VarSet
-  State tempState;
-
-  // write the (velocity or momentum) vectors
-  if ((nbVecComponents > 0) && (!getMethodData().writeVectorAsComponents()))
+  // compute the dimensional states (and the extra values) in the nodes once for all the variables
+  const bool printExtraValues = getMethodData().printExtraValues();
+  const vector<std::string>& extraVarNames = updateVarSet->getExtraVarNames();
+  const CFuint nbrExtraVars = printExtraValues ? extraVarNames.size() : 0;
+  vector<RealVector> dimStates(nbrNodes, RealVector(nbEqs));
+  vector<RealVector> nodalExtraValues(printExtraValues ? nbrNodes : 0);
   {
-    cf_assert(nbVecComponents >= 2);
-    // open DataArray element
-    fout << "        <DataArray Name=\"" << varNames[vectorComponentIdxs[1]] << "\" NumberOfComponents=\"3\" type=\"Float32\" format=\"ascii\">\n";
-    fout << "          ";
+    // some helper states
+    RealVector extraValues; // size will be set in the VarSet
+    State tempState;
 
     // loop over nodes
     for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
@@ -255,61 +319,44 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
       tempState.setSpaceCoordinates(nodes[iNode]);
 
       // dimensionalize the state
-      updateVarSet->setDimensionalValues(tempState, dimState);
-
-      // write the current variable to the file
-      for (CFuint iVecComp = 0; iVecComp < nbVecComponents; ++iVecComp)
+      if (printExtraValues)
       {
-        fout << scientific << setprecision(12) << dimState[vectorComponentIdxs[iVecComp]] << " ";
+        updateVarSet->setDimensionalValuesPlusExtraValues(tempState, dimStates[iNode], extraValues);
+        nodalExtraValues[iNode].resize(extraValues.size());
+        nodalExtraValues[iNode] = extraValues;
       }
-      for (CFuint iVecComp = nbVecComponents; iVecComp < 3; ++iVecComp)
+      else
       {
-        fout << scientific << setprecision(1) << 0.0 << " ";
+        updateVarSet->setDimensionalValues(tempState, dimStates[iNode]);
       }
-
     }
-    fout << "\n";
+  }
 
-    // close DataArray element
-    fout << "        </DataArray>\n";
+  vector<CFreal> values;
+
+  // write the (velocity or momentum) vectors
+  if ((nbVecComponents > 0) && (!getMethodData().writeVectorAsComponents()))
+  {
+    cf_assert(nbVecComponents >= 2);
+    values.assign(3*nbrNodes, 0.0);
+    for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
+    {
+      for (CFuint iVecComp = 0; iVecComp < nbVecComponents; ++iVecComp)
+      {
+        values[3*iNode + iVecComp] = dimStates[iNode][vectorComponentIdxs[iVecComp]];
+      }
+    }
+    arrayWriter.writeFloat32(varNames[vectorComponentIdxs[1]], 3, values);
   } else if (nbVecComponents > 0) {
 
     for (CFuint iVecComp = 0; iVecComp < nbVecComponents; ++iVecComp)
     {
-
-      fout << "        <DataArray Name=\"" << varNames[vectorComponentIdxs[iVecComp]] << "\" type=\"Float32\" format=\"ascii\">\n";
-      fout << "          ";
-
-      // loop over nodes
+      values.resize(nbrNodes);
       for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
       {
-        // get state in this node
-        const RealVector& nodalState = *nodalStates.getState(iNode);
-
-        // copy to temporary state variable
-        for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
-        {
-          tempState[iEq] = nodalState[iEq];
-        }
-
-        // set temporary state ID
-        const CFuint stateID = nodalStates.getStateLocalID(iNode);
-        tempState.setLocalID(stateID);
-
-        // set the node in the temporary state
-        tempState.setSpaceCoordinates(nodes[iNode]);
-
-        // dimensionalize the state
-        updateVarSet->setDimensionalValues(tempState, dimState);
-
-        // write the current variable to the file
-        fout << scientific << setprecision(12) << dimState[vectorComponentIdxs[iVecComp]] << " ";
-
+        values[iNode] = dimStates[iNode][vectorComponentIdxs[iVecComp]];
       }
-      fout << "\n";
-
-      // close DataArray element
-      fout << "        </DataArray>\n";
+      arrayWriter.writeFloat32(varNames[vectorComponentIdxs[iVecComp]], 1, values);
     }
   }
 
@@ -319,91 +366,25 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
     // index of this scalar'
     const CFuint iVar = scalarVarIdxs[iScalar];
 
-    // open DataArray element
-    fout << "        <DataArray Name=\"" << varNames[iVar] << "\" type=\"Float32\" format=\"ascii\">\n";
-    fout << "          ";
-
-    // loop over nodes
+    values.resize(nbrNodes);
     for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
     {
-      // get state in this node
-      const RealVector& nodalState = *nodalStates.getState(iNode);
-
-      // copy to temporary state variable
-      for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
-      {
-        tempState[iEq] = nodalState[iEq];
-      }
-
-      // set temporary state ID
-      const CFuint stateID = nodalStates.getStateLocalID(iNode);
-      tempState.setLocalID(stateID);
-
-      // set the node in the temporary state
-      tempState.setSpaceCoordinates(nodes[iNode]);
-
-      // dimensionalize the state
-      updateVarSet->setDimensionalValues(tempState, dimState);
-
-      // write the current variable to the file
-      fout << scientific << setprecision(12) << dimState[iVar] << " ";
+      values[iNode] = dimStates[iNode][iVar];
     }
-    fout << "\n";
-
-    // close DataArray element
-    fout << "        </DataArray>\n";
+    arrayWriter.writeFloat32(varNames[iVar], 1, values);
   }
 
   // if extra variables are to be outputted
-  if (getMethodData().printExtraValues())
+  for (CFuint iVar = 0 ;  iVar < nbrExtraVars; ++iVar)
   {
-    // variable for extra values
-    RealVector extraValues; // size will be set in the VarSet
-
-    // extra variable names
-    const vector<std::string>& extraVarNames = updateVarSet->getExtraVarNames();
-    const CFuint nbrExtraVars = extraVarNames.size();
-
-    // loop over the extra variables
-    for (CFuint iVar = 0 ;  iVar < nbrExtraVars; ++iVar)
+    values.resize(nbrNodes);
+    for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
     {
-      // open DataArray element
-      fout << "        <DataArray Name=\"" << extraVarNames[iVar] << "\" type=\"Float32\" format=\"ascii\">\n";
-      fout << "          ";
-
-      // loop over nodes
-      for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
-      {
-        // get state in this node
-        const RealVector& nodalState = *nodalStates.getState(iNode);
-
-        // copy to temporary state variable
-        for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
-        {
-          tempState[iEq] = nodalState[iEq];
-        }
-
-        // set temporary state ID
-        const CFuint stateID = nodalStates.getStateLocalID(iNode);
-        tempState.setLocalID(stateID);
-
-        // set the node in the temporary state
-        tempState.setSpaceCoordinates(nodes[iNode]);
-
-        // dimensionalize the state
-        updateVarSet->setDimensionalValuesPlusExtraValues(tempState, dimState, extraValues);
-
-        // write the current variable to the file
-        fout << scientific << setprecision(12) << extraValues[iVar] << " ";
-      }
-      fout << "\n";
-
-      // close DataArray element
-      fout << "        </DataArray>\n";
+      values[iNode] = nodalExtraValues[iNode][iVar];
     }
+    arrayWriter.writeFloat32(extraVarNames[iVar], 1, values);
   }
 
-
   // print datahandles with state based data
   {
     SafePtr<DataHandleOutput> datahandle_output = getMethodData().getDataHOutput();
@@ -413,24 +394,20 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
 
     for (CFuint iVar = 0; iVar < dh_varnames.size(); ++iVar)
     {
-      // open DataArray element
-      fout << "        <DataArray Name=\"" << dh_varnames[iVar] << "\" type=\"Float32\" format=\"ascii\">\n";
-      fout << "          ";
-
       DataHandleOutput::DataHandleInfo var_info = datahandle_output->getStateData(iVar);
       CFuint var_var = var_info.first;
       CFuint var_nbvars = var_info.second;
       DataHandle<CFreal> var = var_info.third;
 
+      values.resize(nbrNodes);
       for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
-        fout << scientific << setprecision(12) << var(nodalStates.getStateLocalID(iNode), var_var, var_nbvars) << " ";
-
-      fout << "\n";
-
-      // close DataArray element
-      fout << "        </DataArray>\n";
+      {
+        values[iNode] = var(nodalStates.getStateLocalID(iNode), var_var, var_nbvars);
+      }
+      arrayWriter.writeFloat32(dh_varnames[iVar], 1, values);
     }
   }
+  m_pointDataArrays = arrayWriter.getArrayInfos();
 
   // close PointData element
   fout << "      </PointData>\n";
@@ -438,26 +415,16 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
   // open Points element
   fout << "      <Points>\n";
 
-  // open DataArray element
-  fout << "        <DataArray NumberOfComponents=\"" << 3 << "\" type=\"Float32\" format=\"ascii\">\n";
-  fout << "          ";
-
   // loop over nodes to write coordinates
+  values.assign(3*nbrNodes, 0.0);
   for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
   {
     for (CFuint iCoor = 0; iCoor < dim; ++iCoor)
     {
-      fout << scientific << setprecision(12) << (*nodes[iNode])[iCoor]*refL << " ";
-    }
-    for (CFuint iCoor = dim; iCoor < 3; ++iCoor)
-    {
-      fout << scientific << setprecision(1) << 0.0 << " ";
+      values[3*iNode + iCoor] = (*nodes[iNode])[iCoor]*refL;
     }
   }
-  fout << "\n";
-
-  // close DataArray element
-  fout << "        </DataArray>\n";
+  arrayWriter.writeFloat32("", 3, values);
 
   // close Points element
   fout << "      </Points>\n";
@@ -465,47 +432,28 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
   // open Cells element
   fout << "      <Cells>\n";
 
-  // open DataArray element (for cell-node connectivity)
-  fout << "        <DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">\n";
-  fout << "          ";
-
   // loop over element types to write cell-node connectivity
+  // and offsets in cell-node connectivity (offset of the end of the connectivity for each cell)
+  vector<CFuint> intValues;
+  vector<CFuint> offsets(nbrCells);
+  CFuint cellEndOffSet = 0;
   for (CFuint iCell = 0; iCell < nbrCells; ++iCell)
   {
     const CFuint nbrNodes = cellNodes->nbCols(iCell);
     // node ordering for one cell is the same for VTK as in COOLFluiD
     for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
     {
-      fout << (*cellNodes)(iCell,iNode) << " ";
+      intValues.push_back((*cellNodes)(iCell,iNode));
     }
+    cellEndOffSet += nbrNodes;
+    offsets[iCell] = cellEndOffSet;
   }
-  fout << "\n";
-
-  // close DataArray element (for cell-node connectivity)
-  fout << "        </DataArray>\n";
-
-  // open DataArray element (for offsets in cell-node connectivity)
-  fout << "        <DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">\n";
-  fout << "          ";
-
-  // loop over element types to write offsets in cell-node connectivity (offset of the end of the connectivity for each cell)
-  CFuint cellEndOffSet = 0;
-  for (CFuint iCell = 0; iCell < nbrCells; ++iCell)
-  {
-    cellEndOffSet += cellNodes->nbCols(iCell);
-    fout << cellEndOffSet << " ";
-  }
-  fout << "\n";
-
-  // close DataArray element (for offsets in cell-node connectivity)
-  fout << "        </DataArray>\n";
-
-  // open DataArray element (for cell types)
-  fout << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">\n";
-  fout << "          ";
+  arrayWriter.writeInteger("connectivity", "Int32", intValues);
+  arrayWriter.writeInteger("offsets", "Int32", offsets);
 
   // loop over element types to write cell types
   /// @warning (element indexes (elemIdx) should increase monotonically here in order for this to be correct!!!)
+  intValues.clear();
   const CFuint nbrElemTypes = elemType->size();
   for (CFuint iElemType = 0; iElemType < nbrElemTypes; ++iElemType)
   {
@@ -519,13 +467,10 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
     // loop over cells
     for (CFuint elemIdx = startIdx; elemIdx < endIdx; ++elemIdx)
     {
-      fout << vtkCellType << " ";
+      intValues.push_back(vtkCellType);
     }
   }
-  fout << "\n";
-
-  // close DataArray element (for cell types)
-  fout << "        </DataArray>\n";
+  arrayWriter.writeInteger("types", "UInt8", intValues);
 
   // close Cells element
   fout << "      </Cells>\n";
@@ -536,6 +481,9 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
   // close UnstructuredGrid element
   fout << "  </UnstructuredGrid>\n";
 
+  // write the binary data
+  arrayWriter.writeAppendedData();
+
   // close VTKFile element
   fout << "</VTKFile>\n";
 
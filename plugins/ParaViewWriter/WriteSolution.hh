@@ -13,6 +13,7 @@
 #include "Framework/FileWriter.hh"
 #include "Framework/DataSocketSink.hh"
 #include "Framework/ProxyDofIterator.hh"
+#include "ParaViewWriter/VTKDataArrayWriter.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -87,6 +88,12 @@ protected:
    */
   void writeToBinaryFile();
 
+  /**
+   * Write the parallel (.pvtu) file referencing the pieces of all the processes
+   * @throw Common::FilesystemException
+   */
+  void writePVTUFile();
+
   /**
    * Write the to the given file stream the MeshData.
    * @throw Common::FilesystemException
@@ -103,17 +110,6 @@ protected:
    */
   const std::string getWriterName() const;
 
-
-  /**
-   * function to check the endianness
-   */
-  bool isLittleEndian()
-  {
-    short int word = 0x0001;
-    char *byte = (char *) &word;
-    return byte[0];
-  }
-
 protected:
 
   /// socket for Node's
@@ -128,6 +124,18 @@ private:
   /// File format to write in (ASCII or Binary)
   std::string m_fileFormatStr;
 
+  /// Encoding of the appended data in BINARY format (raw or base64)
+  std::string m_binaryEncodingStr;
+
+  /// Flag telling if the appended data is compressed with zlib in BINARY format
+  bool m_compress;
+
+  /// attributes of the VTKFile element of the last written file
+  std::string m_fileAttributes;
+
+  /// point data arrays of the last written file
+  std::vector<VTKDataArrayWriter::ArrayInfo> m_pointDataArrays;
+
 }; // class WriteSolution
 
 //////////////////////////////////////////////////////////////////////////////
@@ -33,7 +33,8 @@ class BlockJacobiPcJFContext {
 public: // functions
 
   /// Constructor
-  BlockJacobiPcJFContext() : diagMatrices(CFNULL), upLocalIDsAll(CFNULL) {}
+  BlockJacobiPcJFContext() : diagMatrices(CFNULL), upLocalIDsAll(CFNULL), 
+			     useSinglePrecision(false), diagMatricesSP() {}
   
   /// handle of diagonal inverted matrices
   Common::SafePtr<Framework::DataSocketSink<CFreal> > diagMatrices;
@@ -44,6 +45,12 @@ public: // functions
   /// pointer to JFContext - we will use bkpStates from this object during the LU-SGS preconditioning
   JFContext* pJFC;
   
+  /// flag telling to apply the inverted matrices stored in single precision
+  bool useSinglePrecision;
+  
+  /// diagonal inverted matrices in single precision
+  std::vector<float> diagMatricesSP;
+  
 }; // end of class BlockJacobiPcJFContext
 
 //////////////////////////////////////////////////////////////////////////////
@@ -44,8 +44,13 @@ BlockJacobiPreconditioner::BlockJacobiPreconditioner(const std::string& name) :
   socket_diagMatrices("diagMatrices"),
   socket_upLocalIDsAll("upLocalIDsAll"),
   _pcc(),
-  _inverter(CFNULL)
+  _inverter(CFNULL),
+  _singlePrecision()
 {
+  addConfigOptionsTo(this);
+  
+  _singlePrecision = false;
+  setParameter("SinglePrecision", &_singlePrecision);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -56,12 +61,20 @@ BlockJacobiPreconditioner::~BlockJacobiPreconditioner()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void BlockJacobiPreconditioner::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< bool >("SinglePrecision","Apply the inverted diagonal matrices stored in single precision.");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void BlockJacobiPreconditioner::setPreconditioner()
 {
   // getting the JFContext pointer into BlockJacobiPcJFContext pcc
   _pcc.pJFC = getMethodData().getJFContext();
   _pcc.diagMatrices = &socket_diagMatrices;
   _pcc.upLocalIDsAll = &socket_upLocalIDsAll;
+  _pcc.useSinglePrecision = _singlePrecision;
 
   _inverter.reset(MatrixInverter::create(getMethodData().getNbSysEquations(), false));
 
@@ -94,6 +107,14 @@ void BlockJacobiPreconditioner::computeBeforeSolving()
       matIter[m] = invMat[m];
     }
   }
+  
+  // the single precision copy halves the memory read at each application
+  if (_singlePrecision) {
+    _pcc.diagMatricesSP.resize(nbUpdatableStates*nbEqs2);
+    for (CFuint i = 0; i < nbUpdatableStates*nbEqs2; ++i) {
+      _pcc.diagMatricesSP[i] = static_cast<float>(diagMatrices[i]);
+    }
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -139,18 +160,36 @@ PetscErrorCode BlockJacobiPcApply(PC pc, Vec X, Vec Y)
   DataHandle<State*, GLOBAL> states = pcContext->pJFC->states->getDataHandle();
   const CFint nbUpdatableStates = diagMatInv.size()/nbEqs2;
 
-  RealVector tmpX(nbEqs, &x[0]);
-  RealVector tmpY(nbEqs, &y[0]);
-  RealMatrix invMatIter(nbEqs, nbEqs, &diagMatInv[0]);
-
-  for(CFint i = 0; i < nbUpdatableStates; ++i)
-  {
-    const CFuint startIdx = i*nbEqs;
-    tmpX.wrap(nbEqs,&x[startIdx]);
-    tmpY.wrap(nbEqs,&y[startIdx]);
-    invMatIter.wrap(nbEqs, nbEqs, &diagMatInv[i*nbEqs2]);
+  if (pcContext->useSinglePrecision) {
+    // the products are accumulated in double precision
+    cf_assert(pcContext->diagMatricesSP.size() == diagMatInv.size());
+    for(CFint i = 0; i < nbUpdatableStates; ++i) {
+      const float* invMat = &pcContext->diagMatricesSP[i*nbEqs2];
+      const CFreal* xi = &x[i*nbEqs];
+      CFreal* yi = &y[i*nbEqs];
+      for (CFuint m = 0; m < nbEqs; ++m, invMat += nbEqs) {
+	CFreal sum = 0.;
+	for (CFuint n = 0; n < nbEqs; ++n) {
+	  sum += invMat[n]*xi[n];
+	}
+	yi[m] = sum;
+      }
+    }
+  }
+  else {
+    RealVector tmpX(nbEqs, &x[0]);
+    RealVector tmpY(nbEqs, &y[0]);
+    RealMatrix invMatIter(nbEqs, nbEqs, &diagMatInv[0]);
     
-    tmpY = invMatIter*tmpX;
+    for(CFint i = 0; i < nbUpdatableStates; ++i)
+    {
+      const CFuint startIdx = i*nbEqs;
+      tmpX.wrap(nbEqs,&x[startIdx]);
+      tmpY.wrap(nbEqs,&y[startIdx]);
+      invMatIter.wrap(nbEqs, nbEqs, &diagMatInv[i*nbEqs2]);
+      
+      tmpY = invMatIter*tmpX;
+    }
   }
 
   // restoring of arrays X - vector to be preconditioned and Y - preconditioned vector
@@ -153,6 +153,7 @@ void NewParSetup::setMatrix(const CFuint localSize,
   // create a parallel sparse matrix in block compressed row format
   mat.setGPU(getMethodData().useGPU());
   mat.setAIJ(getMethodData().useAIJ());
+  mat.setDirectAssembly(getMethodData().useDirectAssembly());
   mat.createParBAIJ(PE::GetPE().GetCommunicator(nsp),
                     nbEqs,
                     localSize*nbEqs,
@@ -111,15 +111,23 @@ void ParJFSolveSys::execute()
   // assemble the rhs vector
   rhsVec.assembly();
 
+  // the preconditioner is reused as long as its matrix is not recomputed
+  const bool keepPC = getMethodData().reusePreconditioner();
+  CFLog(VERBOSE, "ParJFSolveSys::execute() => keepPC [" << keepPC <<"]\n");
+  
   if(jfc->differentPreconditionerMatrix) {
     if(!getMethodData().useBlockPreconditionerMatrix()) {
       //cout << "\n\n\n Setting up J-F different preconditioner matrix ParBAIJ with Petsc preconditioner \n\n\n";
       precondMat.finalAssembly();
       
+#if PETSC_VERSION_MINOR==7
+      CF_CHKERRCONTINUE(KSPSetReusePreconditioner(ksp, (keepPC) ? PETSC_TRUE : PETSC_FALSE));
+#endif
 #if PETSC_VERSION_MINOR==6 || PETSC_VERSION_MINOR==7 
       CF_CHKERRCONTINUE(KSPSetOperators(ksp, mat.getMat(), precondMat.getMat()));
 #else
-      CF_CHKERRCONTINUE(KSPSetOperators(ksp, mat.getMat(), precondMat.getMat(), DIFFERENT_NONZERO_PATTERN));
+      CF_CHKERRCONTINUE(KSPSetOperators(ksp, mat.getMat(), precondMat.getMat(), 
+					(!keepPC) ? DIFFERENT_NONZERO_PATTERN : SAME_PRECONDITIONER));
 #endif	   
     }
     else {
@@ -130,7 +138,9 @@ void ParJFSolveSys::execute()
 #else
       CF_CHKERRCONTINUE(KSPSetOperators(ksp, mat.getMat(), mat.getMat(), DIFFERENT_NONZERO_PATTERN));
 #endif
-      getMethodData().getShellPreconditioner()->computeBeforeSolving();
+      if (!keepPC) {
+	getMethodData().getShellPreconditioner()->computeBeforeSolving();
+      }
     }
   }
   else {
@@ -140,7 +150,9 @@ void ParJFSolveSys::execute()
 #else
     CF_CHKERRCONTINUE(KSPSetOperators(ksp, mat.getMat(), mat.getMat(), DIFFERENT_NONZERO_PATTERN));
 #endif
-    getMethodData().getShellPreconditioner()->computeBeforeSolving();
+    if (!keepPC) {
+      getMethodData().getShellPreconditioner()->computeBeforeSolving();
+    }
   }
   
   CF_CHKERRCONTINUE(KSPSetUp(ksp));
@@ -173,7 +185,10 @@ void ParJFSolveSys::execute()
 
   CFLog(INFO, "KSP convergence reached at iteration: " << iter << "\n");
 
-  getMethodData().getShellPreconditioner()->computeAfterSolving();
+  // the preconditioner data are kept if they could be reused in the next solve
+  if (!getMethodData().keepPreconditioner()) {
+    getMethodData().getShellPreconditioner()->computeAfterSolving();
+  }
 
   solVec.copy(&rhs[0], &_upLocalIDs[0], vecSize);
 }
@@ -171,6 +171,19 @@ void PetscLSS::printToFile(const std::string prefix, const std::string suffix)
 
 //////////////////////////////////////////////////////////////////////////////
 
+void PetscLSS::setReusePreconditioner(const bool reuse)
+{
+  // the shell preconditioner data kept since the last solve have to be
+  // reset before the matrix is assembled again
+  if (!reuse && m_data->keepPreconditioner()) {
+    m_data->getShellPreconditioner()->computeAfterSolving();
+  }
+  
+  LinearSystemSolver::setReusePreconditioner(reuse);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void PetscLSS::setMethodImpl()
 {
 
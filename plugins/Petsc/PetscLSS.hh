@@ -56,6 +56,10 @@ public:
 
   /// Prints the Linear System to a file.
   void printToFile(const std::string prefix, const std::string suffix);
+  
+  /// Tell if the system matrix is unchanged since the last solve
+  /// (the data of the shell preconditioner are reset before a new assembly)
+  virtual void setReusePreconditioner(const bool reuse);
 
   /// Create a block accumulator with chosen internal storage
   /// @return a newly created block accumulator
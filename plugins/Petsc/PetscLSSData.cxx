@@ -44,6 +44,8 @@ void PetscLSSData::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< string >("ShellPreconditioner","Shell preconditioner.");
   options.addConfigOption< bool >("DifferentPreconditionerMatrix", "Enable/Disable usage of different matrix for preconditioner");
   options.addConfigOption< bool >("UseAIJ", "Tell if AIJ structure must be used insted of BAIJ (default)");
+  options.addConfigOption< bool >
+    ("UseDirectAssembly", "Add the blocks directly into the BAIJ storage once the non zero structure is frozen, bypassing MatSetValuesBlocked().");
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -102,6 +104,9 @@ PetscLSSData::PetscLSSData(SafePtr<std::valarray<bool> > maskArray,
   _useAIJ = false;
   setParameter("UseAIJ", &_useAIJ);
   
+  _useDirectAssembly = false;
+  setParameter("UseDirectAssembly", &_useDirectAssembly);
+  
   PetscOptions::setAllOptions();
 }
 
@@ -252,6 +252,11 @@ public:
    */
   bool useAIJ() {return _useAIJ;}
   
+  /**
+   * Tell if the blocks must be added directly into the BAIJ storage
+   */
+  bool useDirectAssembly() {return _useDirectAssembly;}
+  
 private:
 
   /// Shell preconditioner
@@ -322,6 +327,9 @@ private:
 
   /// Use the AIJ structure instead of BAIJ
   bool _useAIJ;
+  
+  /// Add the blocks directly into the BAIJ storage once the non zero structure is frozen
+  bool _useDirectAssembly;
     
 }; // end of class PetscLSSData
 
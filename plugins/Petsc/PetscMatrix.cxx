@@ -6,6 +6,8 @@
 
 #include "Petsc/PetscHeaders.hh" // must come before any header
 
+#include <algorithm>
+
 #include "Common/PE.hh"
 #include "Framework/BlockAccumulator.hh"
 #include "Petsc/PetscMatrix.hh"
@@ -22,7 +24,15 @@ PetscMatrix::PetscMatrix() :
   Framework::LSSMatrix(),
   m_mat(),
   _isMatShell(false),
-  _isAIJ(false)
+  _isAIJ(false),
+  m_directAssembly(false),
+  m_hasSlots(false),
+  m_slotsModified(false),
+  m_slotRowStart(0),
+  m_slotRowPtr(),
+  m_slotCols(),
+  m_slotValues(),
+  m_slotMats()
 {
 }
       
@@ -223,6 +233,11 @@ void PetscMatrix::createParJFMat(MPI_Comm comm,
 void PetscMatrix::setValues(const Framework::BlockAccumulator& acc)
 {
   CFLog(DEBUG_MIN, "PetscMatrix::setValues()\n");
+  if (m_hasSlots) {
+    setValuesInSlots(acc, INSERT_VALUES);
+    return;
+  }
+  
   CF_CHKERRCONTINUE( MatSetValuesBlocked(m_mat,acc.getM(),&acc.getIM()[0],acc.getN(),&acc.getIN()[0],
     const_cast<Framework::BlockAccumulator&>(acc).getPtr(), INSERT_VALUES) );
 }
@@ -232,12 +247,233 @@ void PetscMatrix::setValues(const Framework::BlockAccumulator& acc)
 void PetscMatrix::addValues(const Framework::BlockAccumulator& acc)
 {
   CFLog(DEBUG_MIN, "PetscMatrix::addValues()\n");
+  if (m_hasSlots) {
+    setValuesInSlots(acc, ADD_VALUES);
+    return;
+  }
+  
   CF_CHKERRCONTINUE( MatSetValuesBlocked(m_mat,acc.getM(),&acc.getIM()[0],acc.getN(),&acc.getIN()[0],
 					 const_cast<Framework::BlockAccumulator&>(acc).getPtr(), ADD_VALUES) );
 }
       
 //////////////////////////////////////////////////////////////////////////////
 
+void PetscMatrix::buildSlots()
+{
+  CFLog(VERBOSE, "PetscMatrix::buildSlots() => START\n");
+  
+  PetscBool isSeq = PETSC_FALSE;
+  PetscBool isPar = PETSC_FALSE;
+  if (!_isAIJ && !_isMatShell && !m_useGPU) {
+    CF_CHKERRCONTINUE(PetscObjectTypeCompare((PetscObject)m_mat, MATSEQBAIJ, &isSeq));
+    CF_CHKERRCONTINUE(PetscObjectTypeCompare((PetscObject)m_mat, MATMPIBAIJ, &isPar));
+  }
+  
+  if (!isSeq && !isPar) {
+    CFLog(WARN, "PetscMatrix::buildSlots() => direct assembly needs a (Seq|MPI)BAIJ matrix: disabled\n");
+    m_directAssembly = false;
+    return;
+  }
+  
+  PetscInt bs = 0;
+  PetscInt rowStart = 0;
+  PetscInt rowEnd = 0;
+  PetscInt colStart = 0;
+  PetscInt colEnd = 0;
+  CF_CHKERRCONTINUE(MatGetBlockSize(m_mat, &bs));
+  CF_CHKERRCONTINUE(MatGetOwnershipRange(m_mat, &rowStart, &rowEnd));
+  CF_CHKERRCONTINUE(MatGetOwnershipRangeColumn(m_mat, &colStart, &colEnd));
+  m_slotRowStart = rowStart/bs;
+  const CFint nbLocalRows = (rowEnd - rowStart)/bs;
+  const CFint bs2 = bs*bs;
+  
+  // in parallel, the local rows are split into a diagonal part, whose columns 
+  // are numbered from colStart, and an off-diagonal part, whose columns are 
+  // compressed and mapped to global block columns by garray
+  const PetscInt* garray = CFNULL;
+  m_slotMats.clear();
+  if (isSeq) {
+    m_slotMats.push_back(m_mat);
+  }
+  else {
+    Mat diagMat;
+    Mat offDiagMat;
+    CF_CHKERRCONTINUE(MatMPIBAIJGetSeqBAIJ(m_mat, &diagMat, &offDiagMat, &garray));
+    m_slotMats.push_back(diagMat);
+    m_slotMats.push_back(offDiagMat);
+  }
+  
+  // global block column and values of all the blocks in each local row
+  std::vector<std::vector<std::pair<CFint, PetscScalar*> > > rowSlots(nbLocalRows);
+  for (CFuint iMat = 0; iMat < m_slotMats.size(); ++iMat) {
+    PetscInt nbRows = 0;
+    const PetscInt* ia = CFNULL;
+    const PetscInt* ja = CFNULL;
+    PetscBool done = PETSC_FALSE;
+    CF_CHKERRCONTINUE(MatGetRowIJ(m_slotMats[iMat], 0, PETSC_FALSE, PETSC_TRUE, &nbRows, &ia, &ja, &done));
+    if (!done || nbRows != nbLocalRows) {
+      CFLog(WARN, "PetscMatrix::buildSlots() => block structure not available: direct assembly disabled\n");
+      m_directAssembly = false;
+      m_slotMats.clear();
+      return;
+    }
+    
+    // the value array is not reallocated as long as the non zero structure is frozen
+    PetscScalar* values = CFNULL;
+    CF_CHKERRCONTINUE(MatSeqBAIJGetArray(m_slotMats[iMat], &values));
+    for (CFint iRow = 0; iRow < nbLocalRows; ++iRow) {
+      for (PetscInt k = ia[iRow]; k < ia[iRow+1]; ++k) {
+	const CFint col = (iMat == 0) ? colStart/bs + ja[k] : garray[ja[k]];
+	rowSlots[iRow].push_back(std::make_pair(col, values + k*bs2));
+      }
+    }
+    CF_CHKERRCONTINUE(MatSeqBAIJRestoreArray(m_slotMats[iMat], &values));
+    CF_CHKERRCONTINUE(MatRestoreRowIJ(m_slotMats[iMat], 0, PETSC_FALSE, PETSC_TRUE, &nbRows, &ia, &ja, &done));
+  }
+  
+  m_slotRowPtr.resize(nbLocalRows+1);
+  m_slotRowPtr[0] = 0;
+  for (CFint iRow = 0; iRow < nbLocalRows; ++iRow) {
+    m_slotRowPtr[iRow+1] = m_slotRowPtr[iRow] + rowSlots[iRow].size();
+  }
+  
+  m_slotCols.resize(m_slotRowPtr[nbLocalRows]);
+  m_slotValues.resize(m_slotRowPtr[nbLocalRows]);
+  for (CFint iRow = 0; iRow < nbLocalRows; ++iRow) {
+    std::sort(rowSlots[iRow].begin(), rowSlots[iRow].end());
+    for (CFuint k = 0; k < rowSlots[iRow].size(); ++k) {
+      m_slotCols[m_slotRowPtr[iRow] + k]   = rowSlots[iRow][k].first;
+      m_slotValues[m_slotRowPtr[iRow] + k] = rowSlots[iRow][k].second;
+    }
+  }
+  
+  m_hasSlots = (m_slotCols.size() > 0);
+  m_slotsModified = false;
+  
+  CFLog(VERBOSE, "PetscMatrix::buildSlots() => " << m_slotCols.size() 
+	<< " blocks in " << nbLocalRows << " rows\n");
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
+void PetscMatrix::addValuesInSlots(const Framework::BlockAccumulator& acc, 
+				   CFint* slots)
+{
+  CFLog(DEBUG_MIN, "PetscMatrix::addValuesInSlots()\n");
+  if (!m_hasSlots) {
+    addValues(acc);
+    return;
+  }
+  
+  const CFuint m = acc.getM();
+  const CFuint n = acc.getN();
+  const std::vector<CFint>& im = acc.getIM();
+  const std::vector<CFint>& in = acc.getIN();
+  
+  // the slots of the entity are looked up at the first call only
+  if (slots[0] == -1) {
+    for (CFuint i = 0; i < m; ++i) {
+      for (CFuint j = 0; j < n; ++j) {
+	slots[i*n + j] = findSlot(im[i], in[j]);
+      }
+    }
+  }
+  
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      const CFint slot = slots[i*n + j];
+      if (slot >= 0) {
+	cf_assert(slot < (CFint)m_slotValues.size());
+	addToSlot(acc, i, j, slot);
+      }
+    }
+  }
+  
+  m_slotsModified = true;
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
+CFint PetscMatrix::findSlot(const CFint row, const CFint col) const
+{
+  // negative indices (rows of ghost states) are ignored, like in PETSc
+  const CFint localRow = row - m_slotRowStart;
+  const CFint nbLocalRows = m_slotRowPtr.size() - 1;
+  if (row < 0 || col < 0 || localRow < 0 || localRow >= nbLocalRows) return -2;
+  
+  const CFint* cols  = &m_slotCols[0];
+  const CFint* first = cols + m_slotRowPtr[localRow];
+  const CFint* last  = cols + m_slotRowPtr[localRow+1];
+  const CFint* slot  = std::lower_bound(first, last, col);
+  
+  // new non zero locations are ignored, as with the frozen structure
+  return (slot == last || *slot != col) ? -2 : (CFint)(slot - cols);
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
+void PetscMatrix::setValuesInSlots(const Framework::BlockAccumulator& acc, 
+				   InsertMode mode)
+{
+  const CFuint m  = acc.getM();
+  const CFuint n  = acc.getN();
+  const CFuint nb = acc.getNB();
+  const std::vector<CFint>& im = acc.getIM();
+  const std::vector<CFint>& in = acc.getIN();
+  
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      const CFint slot = findSlot(im[i], in[j]);
+      if (slot < 0) continue;
+      
+      if (mode == ADD_VALUES) {
+	addToSlot(acc, i, j, slot);
+      }
+      else {
+	// each block is stored column by column
+	PetscScalar* block = m_slotValues[slot];
+	for (CFuint jb = 0; jb < nb; ++jb) {
+	  for (CFuint ib = 0; ib < nb; ++ib) {
+	    block[jb*nb + ib] = acc.getValue(i,j,ib,jb);
+	  }
+	}
+      }
+    }
+  }
+  
+  m_slotsModified = true;
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
+void PetscMatrix::addToSlot(const Framework::BlockAccumulator& acc, 
+			    const CFuint i, const CFuint j, const CFint slot)
+{
+  // each block is stored column by column
+  PetscScalar* block = m_slotValues[slot];
+  const CFuint nb = acc.getNB();
+  for (CFuint jb = 0; jb < nb; ++jb) {
+    for (CFuint ib = 0; ib < nb; ++ib) {
+      block[jb*nb + ib] += acc.getValue(i,j,ib,jb);
+    }
+  }
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
+void PetscMatrix::increaseSlotsState()
+{
+  CF_CHKERRCONTINUE(PetscObjectStateIncrease((PetscObject)m_mat));
+  for (CFuint iMat = 0; iMat < m_slotMats.size(); ++iMat) {
+    if (m_slotMats[iMat] != m_mat) {
+      CF_CHKERRCONTINUE(PetscObjectStateIncrease((PetscObject)m_slotMats[iMat]));
+    }
+  }
+  m_slotsModified = false;
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
 void PetscMatrix::printToScreen() const
 {
   CF_CHKERRCONTINUE(MatAssemblyBegin(m_mat,MAT_FINAL_ASSEMBLY));
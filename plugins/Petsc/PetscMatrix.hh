@@ -11,6 +11,8 @@
 
 #include "Petsc/PetscHeaders.hh" // must come before any header
 
+#include <vector>
+
 #include "MathTools/RealVector.hh"
 #include "Framework/LSSMatrix.hh"
 
@@ -188,6 +190,10 @@ public: // functions
     MatAssemblyType matAssType = (assemblyType == FLUSH_ASSEMBLY) ?
       MAT_FLUSH_ASSEMBLY : MAT_FINAL_ASSEMBLY;
     CF_CHKERRCONTINUE(MatAssemblyEnd(m_mat, matAssType));
+    
+    if (m_slotsModified && matAssType == MAT_FINAL_ASSEMBLY) {
+      increaseSlotsState();
+    }
   }
 
   /**
@@ -325,6 +331,13 @@ public: // functions
    */
   void addValues(const Framework::BlockAccumulator& acc);
 
+  /**
+   * Add a list of values, looking up the slots of the blocks only at the
+   * first call for the given entity
+   * @param slots acc.getM()*acc.getN() slots of the entity, initialized to -1
+   */
+  void addValuesInSlots(const Framework::BlockAccumulator& acc, CFint* slots);
+
   /**
    * Freeze the matrix structure concerning the non zero
    * locations
@@ -333,6 +346,10 @@ public: // functions
   {
     MatSetOption(m_mat, MAT_NEW_NONZERO_LOCATIONS, PETSC_FALSE);
    // MatSetOption(m_mat, MAT_NEW_NONZERO_LOCATIONS_ERR, PETSC_FALSE);
+    
+    if (m_directAssembly && !m_hasSlots) {
+      buildSlots();
+    }
   }
 
   /**
@@ -361,6 +378,46 @@ public: // functions
    */
   void setAIJ(bool isAIJ);
   
+  /**
+   * Set the flag telling to add the blocks directly into the BAIJ storage
+   * once the non zero structure has been frozen
+   * @param directAssembly flag
+   */
+  void setDirectAssembly(bool directAssembly) {m_directAssembly = directAssembly;}
+  
+private: // helper functions
+  
+  /**
+   * Build, from the frozen non zero structure of a (Seq|MPI)BAIJ matrix, 
+   * the global block column IDs and the pointer to the values of each 
+   * block stored in the local rows
+   */
+  void buildSlots();
+  
+  /**
+   * Find the slot of the block at the given global block row and column
+   * @return the slot ID or -2 if the block is not stored in this process
+   */
+  CFint findSlot(const CFint row, const CFint col) const;
+  
+  /**
+   * Insert or add the blocks of the accumulator directly in their slots
+   * @param mode INSERT_VALUES or ADD_VALUES
+   */
+  void setValuesInSlots(const Framework::BlockAccumulator& acc, InsertMode mode);
+  
+  /**
+   * Add the given block to the values of the given slot
+   */
+  void addToSlot(const Framework::BlockAccumulator& acc, 
+		 const CFuint i, const CFuint j, const CFint slot);
+  
+  /**
+   * Notify PETSc (and the preconditioners) that the values of the matrix 
+   * have been modified without MatSetValues()
+   */
+  void increaseSlotsState();
+  
 private: // data
 
   /// matrix
@@ -372,6 +429,31 @@ private: // data
   /// flag to tell if the matrix is a AIJ
   bool _isAIJ;
   
+  /// flag telling to add the blocks directly into the BAIJ storage
+  bool m_directAssembly;
+  
+  /// flag telling if the slots have been built
+  bool m_hasSlots;
+  
+  /// flag telling if some values have been modified through the slots
+  /// since the last final assembly
+  bool m_slotsModified;
+  
+  /// first global block row owned by this process
+  CFint m_slotRowStart;
+  
+  /// start of the slots of each local block row in m_slotCols and m_slotValues
+  std::vector<CFint> m_slotRowPtr;
+  
+  /// global block column ID of each slot, sorted in each row
+  std::vector<CFint> m_slotCols;
+  
+  /// pointer to the (column-major) values of each slot
+  std::vector<PetscScalar*> m_slotValues;
+  
+  /// diagonal and off-diagonal local matrices owning the slots
+  std::vector<Mat> m_slotMats;
+  
 }; // end of class PetscMatrix
 
 //////////////////////////////////////////////////////////////////////////////
@@ -112,9 +112,11 @@ stopTimer.start();
     }
   }
  
-  // reuse te preconditioner
+  // reuse te preconditioner (always if the matrix has not been recomputed)
+  const bool keepPC = getMethodData().reusePreconditioner();
+  CFLog(VERBOSE, "StdParSolveSys::execute() => keepPC [" << keepPC <<"]\n");
 #if PETSC_VERSION_MINOR==7
-  PetscBool reusePC = ((nbIter-1)%getMethodData().getPreconditionerRate() == 0) ?
+  PetscBool reusePC = (!keepPC && (nbIter-1)%getMethodData().getPreconditionerRate() == 0) ?
      PETSC_FALSE : PETSC_TRUE;
   CFLog(VERBOSE, "StdParSolveSys::execute() => reusePC [" << reusePC <<"]\n");
   CHKERRCONTINUE(KSPSetReusePreconditioner(ksp,reusePC));
@@ -126,7 +128,7 @@ stopTimer.start();
   CFuint ierr = KSPSetOperators(ksp, mat.getMat(), mat.getMat());
 #else
   CFuint ierr = KSPSetOperators
-    (ksp, mat.getMat(), mat.getMat(),DIFFERENT_NONZERO_PATTERN);
+    (ksp, mat.getMat(), mat.getMat(), (!keepPC) ? DIFFERENT_NONZERO_PATTERN : SAME_PRECONDITIONER);
 #endif
   
   //This is to allow viewing the matrix structure in X windows
@@ -112,6 +112,7 @@ void StdSeqSetup::setMatrix(const CFuint localSize,
   // format
   mat.setGPU(getMethodData().useGPU());
   mat.setAIJ(getMethodData().useAIJ());
+  mat.setDirectAssembly(getMethodData().useDirectAssembly());
   mat.createSeqBAIJ(blockSize,
 		    nbRows,
 		    nbCols,
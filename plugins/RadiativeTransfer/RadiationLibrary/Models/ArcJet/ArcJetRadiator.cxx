@@ -129,10 +129,10 @@ inline void ArcJetRadiator::getSpectralIdxs(CFreal lambda, CFuint *idx)
 /// emission coeff   = m_radCoeff(local state ID, spectral point idx*3+1)
 /// absorption coeff = m_radCoeff(local state ID, spectral point idx*3+2)
 ///
-CFreal ArcJetRadiator::getEmission(CFreal lambda, RealVector &s_o)
+CFreal ArcJetRadiator::getEmission(CFreal lambda, RealVector &s_o, CFuint iTracer)
 {
   CFuint spectralIdx;
-  CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx();
+  CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx(iTracer);
 
   getSpectralIdxs(lambda, &spectralIdx);
 
@@ -141,10 +141,10 @@ CFreal ArcJetRadiator::getEmission(CFreal lambda, RealVector &s_o)
 }
 
 //////////////////////////////////////////////////////////////////////////////
-CFreal ArcJetRadiator::getAbsorption(CFreal lambda, RealVector &s_o)
+CFreal ArcJetRadiator::getAbsorption(CFreal lambda, RealVector &s_o, CFuint iTracer)
 {
   CFuint spectralIdx;
-  CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx();
+  CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx(iTracer);
 
   getSpectralIdxs(lambda, &spectralIdx);
   
@@ -226,22 +226,22 @@ void ArcJetRadiator::computeEmissionCPD()
 
 //////////////////////////////////////////////////////////////////////////////
 
-CFreal ArcJetRadiator::getSpectraLoopPower()
+CFreal ArcJetRadiator::getSpectraLoopPower(CFuint iTracer)
 {
-  return m_spectralLoopPowers[ m_radPhysicsHandlerPtr->getCurrentCellTrsIdx() ];
+  return m_spectralLoopPowers[ m_radPhysicsHandlerPtr->getCurrentCellTrsIdx(iTracer) ];
 }
 
 
 /////////////////////////////////////////////////////////////////////////////
 
-void ArcJetRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o)
+void ArcJetRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o, CFuint iTracer)
 {
   //cout<<"get emission"<<endl;
   static CFuint dim = Framework::PhysicalModelStack::getActive()->getDim();
   static CFuint dim2 = m_radPhysicsHandlerPtr->isAxi() ? 3 : dim;
 
   CFuint nbCpdPoints = m_nbBins;
-  CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx();
+  CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx(iTracer);
   
   //cout<<"cpd, stateIdx "<<stateIdx<<" :";
   //vector<CFreal>::iterator it;
@@ -250,7 +250,7 @@ void ArcJetRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o)
   //}
   //cout<<endl;
   
-  CFreal rand = m_rand.uniformRand();
+  CFreal rand = getRand(iTracer).uniformRand();
   CFreal* it_start = &m_cpdEms[ stateIdx*nbCpdPoints ];
   CFreal* it_end = &m_cpdEms[ (stateIdx+1)*nbCpdPoints-1 ];
   CFreal* it_upp = std::upper_bound(it_start, it_end, rand);
@@ -262,7 +262,7 @@ void ArcJetRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o)
 
   //cout<<x0<<' '<<x1<<' '<<y0<<' '<<y1<<' '<<rand<<' '<<lambda<<endl;
 
-  m_rand.sphereDirections(dim2, s_o);
+  getRand(iTracer).sphereDirections(dim2, s_o);
 }
 
 void ArcJetRadiator::readOpacities()
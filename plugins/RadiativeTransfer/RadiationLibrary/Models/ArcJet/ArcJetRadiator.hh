@@ -156,15 +156,15 @@ public: // Radiator interface
 
   void setupSpectra(CFreal wavMin, CFreal wavMax);
 
-  CFreal getEmission(CFreal lambda, RealVector &s_o);
+  CFreal getEmission(CFreal lambda, RealVector &s_o, CFuint iTracer);
 
-  CFreal getAbsorption(CFreal lambda, RealVector &s_o);
+  CFreal getAbsorption(CFreal lambda, RealVector &s_o, CFuint iTracer);
 
-  CFreal getSpectraLoopPower();
+  CFreal getSpectraLoopPower(CFuint iTracer);
 
   void computeEmissionCPD();
 
-  void getRandomEmission(CFreal &lambda, RealVector &s_o);
+  void getRandomEmission(CFreal &lambda, RealVector &s_o, CFuint iTracer);
   
   inline void getSpectralIdxs(CFreal lambda, CFuint *idx);
 
@@ -43,8 +43,7 @@ void GreyRadiator::defineConfigOptions(Config::OptionList& options)
 GreyRadiator::GreyRadiator(const std::string& name):
   Radiator(name),
   m_socketNormals(CFNULL),
-  m_dim2(0),
-  m_normal()
+  m_dim2(0)
 {
   addConfigOptionsTo(this);
   
@@ -97,9 +96,9 @@ inline CFreal GreyRadiator::computeStefanBoltzmann(const CFreal T){
 
 //////////////////////////////////////////////////////////////////////////////
 
-inline CFreal GreyRadiator::getCurrentCellTemperature()
+inline CFreal GreyRadiator::getCurrentCellTemperature(CFuint iTracer)
 {
-  CFuint stateID = m_radPhysicsHandlerPtr->getCurrentCellStateID();
+  CFuint stateID = m_radPhysicsHandlerPtr->getCurrentCellStateID(iTracer);
   static Framework::DataHandle<Framework::State*, Framework::GLOBAL> m_states
     = m_radPhysicsHandlerPtr->getDataSockets()->states.getDataHandle();
   
@@ -109,9 +108,9 @@ inline CFreal GreyRadiator::getCurrentCellTemperature()
 
 //////////////////////////////////////////////////////////////////////////////
 
-inline CFreal GreyRadiator::getCurrentWallTemperature()
+inline CFreal GreyRadiator::getCurrentWallTemperature(CFuint iTracer)
 {
-  const CFuint wallGeoIdx = m_radPhysicsHandlerPtr->getCurrentWallTrsIdx();
+  const CFuint wallGeoIdx = m_radPhysicsHandlerPtr->getCurrentWallTrsIdx(iTracer);
   Common::SafePtr<Framework::State> state = m_radPhysicsPtr->getWallState( wallGeoIdx );
   
   //    CFuint wallGeoID = m_radPhysicsHandlerPtr->getCurrentWallGeoID();
@@ -126,15 +125,15 @@ inline CFreal GreyRadiator::getCurrentWallTemperature()
   
 //////////////////////////////////////////////////////////////////////////////
   
-CFreal GreyRadiator::getAbsorption( CFreal lambda, RealVector &s_o ){
+CFreal GreyRadiator::getAbsorption( CFreal lambda, RealVector &s_o, CFuint iTracer ){
   return m_absCoeff;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-CFreal GreyRadiator::getEmission( CFreal lambda, RealVector &s_o )
+CFreal GreyRadiator::getEmission( CFreal lambda, RealVector &s_o, CFuint iTracer )
 {
-  const CFreal T = getCurrentElemTemperature();
+  const CFreal T = getCurrentElemTemperature(iTracer);
   return m_emsCoeff * computePlank(lambda*m_angstrom, T);
 }
 
@@ -166,12 +165,12 @@ void GreyRadiator::setupSpectra(CFreal wavMin, CFreal wavMax)
 
 //////////////////////////////////////////////////////////////////////////////
 
-CFreal GreyRadiator::getSpectraLoopPower()
+CFreal GreyRadiator::getSpectraLoopPower(CFuint iTracer)
 {
-  CFreal T = getCurrentElemTemperature();
+  CFreal T = getCurrentElemTemperature(iTracer);
   CFreal a1 = computeComulativePlankFraction(m_minWav, T);
   CFreal a2 = computeComulativePlankFraction(m_maxWav, T);
-  CFreal a3 = (a2-a1)*computeStefanBoltzmann(T) * m_emsCoeff * getSpaceIntegrator();
+  CFreal a3 = (a2-a1)*computeStefanBoltzmann(T) * m_emsCoeff * getSpaceIntegrator(iTracer);
   
   //   if(m_TRStypeID == WALL ){
   //      std::cout<<"Temperatute: "<<T<<" Area: "<<getSpaceIntegrator()<<" emsCoeff "<<m_emsCoeff<<std::endl;
@@ -185,16 +184,16 @@ CFreal GreyRadiator::getSpectraLoopPower()
 
 //////////////////////////////////////////////////////////////////////////////
 
-void GreyRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o)
+void GreyRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o, CFuint iTracer)
 {
-    CFreal T = getCurrentElemTemperature();
+    CFreal T = getCurrentElemTemperature(iTracer);
 
     static CFuint dim = Framework::PhysicalModelStack::getActive()->getDim();
     static CFuint dim2 = m_radPhysicsHandlerPtr->isAxi() ? 3 : dim;
     //m_TRStypeID=MEDIUM;
     //emission direction: diffuse
     //std::cout<<"dim1: "<<dim2<<" dim2_: "<<s_o.size()<<std::endl;
-    getRandomDirections(dim2, s_o);
+    getRandomDirections(dim2, s_o, iTracer);
 
     if(!m_allIsGrey){
       //emission wavelength: bissection method
@@ -206,7 +205,7 @@ void GreyRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o)
       CFreal maxComulativePlank =computeComulativePlankFraction(b,T);
 
       CFreal c = (m_minWav+m_maxWav)/2.;
-      CFreal target = m_rand.uniformRand();
+      CFreal target = getRand(iTracer).uniformRand();
       CFreal m_tol=1e-10;
       CFreal f_c;
       do{
@@ -227,16 +226,16 @@ void GreyRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o)
 
 //////////////////////////////////////////////////////////////////////////////
 
-void GreyRadiator::getHemiDirections(CFuint dim, RealVector &s_o)
+void GreyRadiator::getHemiDirections(CFuint dim, RealVector &s_o, CFuint iTracer)
 {
   cf_assert(dim == s_o.size() );
-  const CFuint wallGeoID = m_radPhysicsHandlerPtr->getCurrentWallGeoID();
-  m_normal.resize(dim);
-  m_normal = 0.;
+  const CFuint wallGeoID = m_radPhysicsHandlerPtr->getCurrentWallGeoID(iTracer);
+  // local array: this can be called by several threads at once
+  RealVector normal(0., dim);
   for (CFuint i=0; i<m_dim2; ++i){
-    m_normal[i] = -m_socketNormals[wallGeoID*m_dim2+i];
+    normal[i] = -m_socketNormals[wallGeoID*m_dim2+i];
   }
-  m_rand.hemiDirections(dim, m_normal, s_o);
+  getRand(iTracer).hemiDirections(dim, normal, s_o);
 }
   
 //////////////////////////////////////////////////////////////////////////////
@@ -27,39 +27,40 @@ public:
 
   void setupSpectra(CFreal wavMin, CFreal wavMax);
 
-  CFreal getEmission( CFreal lambda, RealVector &s_o );
+  CFreal getEmission( CFreal lambda, RealVector &s_o, CFuint iTracer );
 
-  CFreal getAbsorption( CFreal lambda, RealVector &s_o );
+  CFreal getAbsorption( CFreal lambda, RealVector &s_o, CFuint iTracer );
 
-  CFreal getSpectraLoopPower();
+  CFreal getSpectraLoopPower(CFuint iTracer);
 
   void computeEmissionCPD(){;}
 
-  void getRandomEmission(CFreal &lambda, RealVector &s_o );
+  void getRandomEmission(CFreal &lambda, RealVector &s_o, CFuint iTracer );
   
 protected:
   
-  virtual CFreal getCurrentElemTemperature() {return getCurrentCellTemperature();}
+  virtual CFreal getCurrentElemTemperature(CFuint iTracer) 
+  {return getCurrentCellTemperature(iTracer);}
   
-  virtual CFreal getSpaceIntegrator(){
-    return getCurrentCellVolume() * 4.; //4 is from the solid angle integration
+  virtual CFreal getSpaceIntegrator(CFuint iTracer){
+    return getCurrentCellVolume(iTracer) * 4.; //4 is from the solid angle integration
   }
   
-  virtual void getRandomDirections(CFuint dim, RealVector &s_o ){
-    getSphericalDirections(dim, s_o);
+  virtual void getRandomDirections(CFuint dim, RealVector &s_o, CFuint iTracer ){
+    getSphericalDirections(dim, s_o, iTracer);
   }
   
-  void getHemiDirections(CFuint dim, RealVector &s_o);
+  void getHemiDirections(CFuint dim, RealVector &s_o, CFuint iTracer);
   
-  void getSphericalDirections(CFuint dim, RealVector &s_o){
-    m_rand.sphereDirections(dim, s_o);
+  void getSphericalDirections(CFuint dim, RealVector &s_o, CFuint iTracer){
+    getRand(iTracer).sphereDirections(dim, s_o);
   }
 
   CFreal computeComulativePlankFraction(CFreal lambda, CFreal T);
   inline CFreal computePlank(const CFreal lambda, const CFreal T);
   inline CFreal computeStefanBoltzmann(const CFreal T);
-  CFreal getCurrentCellTemperature();
-  CFreal getCurrentWallTemperature();
+  CFreal getCurrentCellTemperature(CFuint iTracer);
+  CFreal getCurrentWallTemperature(CFuint iTracer);
 
   CFreal getCellVolume();
   CFreal getFaceArea();
@@ -95,9 +96,6 @@ protected:
   
   /// problem dimension
   CFuint m_dim2;
-  
-  /// array storing temporary normal 
-  RealVector m_normal;
 };
   
 
@@ -115,16 +113,16 @@ public:
   static std::string getClassName() { return "GreyWallRadiator"; }
 
 protected:
-  virtual inline CFreal getCurrentElemTemperature(){
-    return getCurrentWallTemperature();
+  virtual inline CFreal getCurrentElemTemperature(CFuint iTracer){
+    return getCurrentWallTemperature(iTracer);
   }
 
-  virtual inline CFreal getSpaceIntegrator(){
-    return getCurrentWallArea();
+  virtual inline CFreal getSpaceIntegrator(CFuint iTracer){
+    return getCurrentWallArea(iTracer);
   }
 
-  virtual inline void getRandomDirections(CFuint dim, RealVector &s_o ){
-    getHemiDirections(dim, s_o);
+  virtual inline void getRandomDirections(CFuint dim, RealVector &s_o, CFuint iTracer ){
+    getHemiDirections(dim, s_o, iTracer);
   }
 };
 
@@ -32,15 +32,15 @@ public:
 
   void setupSpectra(CFreal wavMin, CFreal wavMax){;}
 
-  CFreal getEmission( CFreal lambda, RealVector &s_o ){ return 0.; }
+  CFreal getEmission( CFreal lambda, RealVector &s_o, CFuint iTracer ){ return 0.; }
 
-  CFreal getAbsorption( CFreal lambda, RealVector &s_o ){ return 0.; }
+  CFreal getAbsorption( CFreal lambda, RealVector &s_o, CFuint iTracer ){ return 0.; }
   
-  CFreal getSpectraLoopPower(){return 0.;}
+  CFreal getSpectraLoopPower(CFuint iTracer){return 0.;}
 
   void computeEmissionCPD(){;}
   
-  void getRandomEmission(CFreal &lambda, RealVector &s_o ){
+  void getRandomEmission(CFreal &lambda, RealVector &s_o, CFuint iTracer ){
     CFLog(INFO,"Called Emission form NullRadiator");
   }
 };
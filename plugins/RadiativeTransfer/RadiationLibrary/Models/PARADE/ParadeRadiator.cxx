@@ -1,4 +1,5 @@
 #include <fstream>
+#include <sstream>
 
 #include "RadiativeTransfer/RadiationLibrary/Models/PARADE/ParadeRadiator.hh"
 #include "RadiativeTransfer/RadiationLibrary/RadiationPhysicsHandler.hh"
@@ -16,6 +17,8 @@
 #include "Common/BadValueException.hh"
 #include "Common/Stopwatch.hh"
 #include "Common/PEFunctions.hh"
+#include "Common/MemoryMappedFile.hh"
+#include "Common/HashBytes.hh"
 #include "Framework/MeshData.hh"
 #include "Framework/PhysicalChemicalLibrary.hh"
 #include "Framework/PhysicalModel.hh"
@@ -65,6 +68,8 @@ void ParadeRadiator::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< bool >("Banding","Activation of banding.");
   options.addConfigOption< bool >("WriteRadFileASCII", "Write the radiative coefficients to ASCII file (for debugging).");
   options.addConfigOption< bool >("SaveMemory", "Flag asking to parallelize as much as possible in order to save memory.");
+  options.addConfigOption< string >
+    ("SpectralCacheDir", "Directory where the binned/banded spectral data are cached and reused when the PARADE inputs do not change (disabled if empty).");
 }
   
 //////////////////////////////////////////////////////////////////////////////
@@ -129,6 +134,9 @@ ParadeRadiator::ParadeRadiator(const std::string& name) :
 
   m_saveMemory = false;
   setParameter("SaveMemory",&m_saveMemory);
+  
+  m_spectralCacheDir = "";
+  setParameter("SpectralCacheDir",&m_spectralCacheDir);
 }
   
 //////////////////////////////////////////////////////////////////////////////
@@ -155,7 +163,17 @@ void ParadeRadiator::setup()
   
   m_rank   = PE::GetPE().GetRank(m_namespace);
   m_nbProc = PE::GetPE().GetProcessorCount(m_namespace);
-  
+
+  if (m_spectralCacheDir != "") {
+    if (!m_binning && !m_banding) {
+      CFLog(WARN, "ParadeRadiator::setup() => SpectralCacheDir is ignored: only the binned/banded spectra are cached\n");
+    }
+    else if (!fullGridInProcess() && m_nbProc > 1) {
+      CFLog(WARN, "ParadeRadiator::setup() => SpectralCacheDir: the grid is partitioned, so each process "
+	    << "writes and maps its own cache file, nothing is shared between processes\n");
+    }
+  }
+
   m_inFileHandle  = Environment::SingleBehaviorFactory<Environment::FileHandlerInput>::getInstance().create();
   m_outFileHandle = Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
     
@@ -282,6 +300,17 @@ void ParadeRadiator::setupSpectra(CFreal wavMin, CFreal wavMax)
 	<<m_wavMin<<", wavMax: "<<m_wavMax<<"), dWav: "<<m_dWav<<
         " nbPoints: "<<m_nbPoints<<"\n");
   
+  // only the binned/banded data can be cached, the full spectra are not stored
+  const bool useCache = (m_spectralCacheDir != "") && (m_binning || m_banding);
+  boost::uint64_t cacheKey = 0;
+  if (useCache) {
+    cacheKey = computeSpectralCacheKey();
+    if (readSpectralCache(cacheKey)) {
+      CFLog(INFO,"ParadeRadiator::computeProperties() => END\n");
+      return;
+    }
+  }
+  
   if (!m_reuseProperties) {
     stp.start();
     // update the wavelength range inside parade.con
@@ -317,6 +346,10 @@ void ParadeRadiator::setupSpectra(CFreal wavMin, CFreal wavMax)
     computeBinningBanding();
   }
   
+  if (useCache) {
+    writeSpectralCache(cacheKey);
+  }
+  
   PE::GetPE().setBarrier(m_namespace);
   
   CFLog(INFO,"ParadeRadiator::computeProperties() => END\n");
@@ -673,6 +706,186 @@ void ParadeRadiator::writeLocalRadCoeffASCII(const CFuint nbCells)
   CFLog(VERBOSE, "ParadeRadiator::writeLocalRadCoeffASCII() => END\n");
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+/// version of the spectral cache format, to be increased every time the 
+/// format or the binning/banding algorithms change
+static const boost::uint32_t SPECTRAL_CACHE_VERSION = 1;
+
+/// header of the spectral cache file, followed by the alpha_avbin and B_bin arrays
+struct SpectralCacheHeader {
+  char magic[8];
+  boost::uint32_t version;
+  boost::uint32_t sizeOfReal;
+  boost::uint64_t key;
+  boost::uint64_t nbAlpha;
+  boost::uint64_t nbB;
+};
+
+static const char SPECTRAL_CACHE_MAGIC[8] = "CFPSPEC";
+  
+//////////////////////////////////////////////////////////////////////////////
+
+boost::uint64_t ParadeRadiator::computeSpectralCacheKey()
+{
+  boost::uint64_t key = HASH_BYTES_SEED;
+  hashBytes(&SPECTRAL_CACHE_VERSION, sizeof(boost::uint32_t), key);
+  
+  // PARADE configuration, except for the wavelength range which is rewritten 
+  // for each spectral loop by updateWavRange()
+  boost::filesystem::path confFile = Environment::DirPaths::getInstance().getWorkingDir() / "parade.con";
+  ifstream fin(confFile.string().c_str());
+  string line;
+  while (getline(fin,line)) {
+    if (line.find("wavlo") == string::npos && line.find("wavhi") == string::npos && 
+	line.find("npoints") == string::npos) {
+      hashBytes(line.c_str(), line.size(), key);
+    }
+  }
+  hashBytes(m_libPath.c_str(), m_libPath.size(), key);
+  hashBytes(&m_wavMin, sizeof(CFreal), key);
+  hashBytes(&m_wavMax, sizeof(CFreal), key);
+  hashBytes(&m_nbPoints, sizeof(CFuint), key);
+  
+  // flow field as written by writeLocalData()
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const CFuint dim = PhysicalModelStack::getActive()->getDim();
+  hashBytes(&m_TminFix, sizeof(CFreal), key);
+  hashBytes(&m_ndminFix, sizeof(CFreal), key);
+  hashBytes(&m_isLTE, sizeof(bool), key);
+  const CFuint nbCells = m_pstates->getSize();
+  hashBytes(&nbCells, sizeof(CFuint), key);
+  for (CFuint i = 0; i < nbCells; ++i) {
+    hashBytes(m_pstates->getState(i), nbEqs*sizeof(CFreal), key);
+    hashBytes(m_pstates->getNode(i), dim*sizeof(CFreal), key);
+    const CFreal volume = getCellVolume(m_pstates->getStateLocalID(i));
+    hashBytes(&volume, sizeof(CFreal), key);
+  }
+  
+  // binning/banding settings
+  hashBytes(&m_binning, sizeof(bool), key);
+  hashBytes(&m_banding, sizeof(bool), key);
+  hashBytes(&m_nbBins, sizeof(m_nbBins), key);
+  hashBytes(&m_nbBands, sizeof(m_nbBands), key);
+  hashBytes(m_bandsDistr.c_str(), m_bandsDistr.size(), key);
+  return key;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+boost::filesystem::path ParadeRadiator::getSpectralCacheFile(const boost::uint64_t key) const
+{
+  boost::filesystem::path cacheDir(m_spectralCacheDir);
+  if (!cacheDir.has_root_directory()) {
+    cacheDir = Environment::DirPaths::getInstance().getWorkingDir() / cacheDir;
+  }
+  
+  // if every process stores the full grid, all of them share the same file
+  std::ostringstream fileName;
+  fileName << "ParadeSpectra-" << m_radPhysicsPtr->getTRSname();
+  if (!fullGridInProcess()) {
+    fileName << "-P" << m_rank;
+  }
+  fileName << "-" << std::hex << key << ".bin";
+  return cacheDir / boost::filesystem::path(fileName.str());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool ParadeRadiator::readSpectralCache(const boost::uint64_t key)
+{
+  SafePtr<SocketBundle> sockets = m_radPhysicsHandlerPtr->getDataSockets();
+  DataHandle<CFreal> alpha_avbin = sockets->alpha_avbin;
+  DataHandle<CFreal> B_bin = sockets->B_bin;
+  
+  const boost::filesystem::path file = getSpectralCacheFile(key);
+  CFuint found = 0;
+  if (boost::filesystem::exists(file)) {
+    // the file is mapped read-only and copied into the alpha_avbin and B_bin 
+    // sockets, which stay private to each process: a shared file only saves 
+    // the disk reads, not the memory holding the spectra
+    MemoryMappedFile cache;
+    cache.open(file.string());
+    
+    SpectralCacheHeader header;
+    const size_t dataSize = (alpha_avbin.size() + B_bin.size())*sizeof(CFreal);
+    if (cache.size() == sizeof(SpectralCacheHeader) + dataSize) {
+      std::copy(cache.data(), cache.data() + sizeof(SpectralCacheHeader), 
+		reinterpret_cast<char*>(&header));
+      if (std::equal(SPECTRAL_CACHE_MAGIC, SPECTRAL_CACHE_MAGIC + 8, header.magic) && 
+	  header.version == SPECTRAL_CACHE_VERSION && 
+	  header.sizeOfReal == sizeof(CFreal) && header.key == key &&
+	  header.nbAlpha == alpha_avbin.size() && header.nbB == B_bin.size()) {
+	const char* ptr = cache.data() + sizeof(SpectralCacheHeader);
+	std::copy(ptr, ptr + alpha_avbin.size()*sizeof(CFreal), 
+		  reinterpret_cast<char*>(&alpha_avbin[0]));
+	ptr += alpha_avbin.size()*sizeof(CFreal);
+	std::copy(ptr, ptr + B_bin.size()*sizeof(CFreal), 
+		  reinterpret_cast<char*>(&B_bin[0]));
+	found = 1;
+      }
+    }
+    
+    if (found == 0) {
+      CFLog(WARN, "ParadeRadiator::readSpectralCache() => " << file 
+	    << " is invalid and will be overwritten\n");
+    }
+  }
+  
+  // the cache is used only if all processes have found it, since 
+  // the binning/banding algorithms involve collective communication
+  CFuint foundAll = 0;
+  MPIError::getInstance().check
+    ("MPI_Allreduce", "ParadeRadiator::readSpectralCache()",
+     MPI_Allreduce(&found, &foundAll, 1, MPIStructDef::getMPIType(&found), 
+		   MPI_MIN, PE::GetPE().GetCommunicator(m_namespace)));
+  
+  if (foundAll == 1) {
+    CFLog(INFO, "ParadeRadiator::readSpectralCache() => binned/banded data read from " << file << "\n");
+  }
+  return (foundAll == 1);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParadeRadiator::writeSpectralCache(const boost::uint64_t key)
+{
+  if (fullGridInProcess() && m_rank > 0) return;
+  
+  SafePtr<SocketBundle> sockets = m_radPhysicsHandlerPtr->getDataSockets();
+  DataHandle<CFreal> alpha_avbin = sockets->alpha_avbin;
+  DataHandle<CFreal> B_bin = sockets->B_bin;
+  
+  const boost::filesystem::path file = getSpectralCacheFile(key);
+  boost::filesystem::create_directories(file.parent_path());
+  
+  SpectralCacheHeader header;
+  std::copy(SPECTRAL_CACHE_MAGIC, SPECTRAL_CACHE_MAGIC + 8, header.magic);
+  header.version = SPECTRAL_CACHE_VERSION;
+  header.sizeOfReal = sizeof(CFreal);
+  header.key = key;
+  header.nbAlpha = alpha_avbin.size();
+  header.nbB = B_bin.size();
+  
+  // the file is written under a temporary name and then renamed, so that 
+  // no process can map a partially written file
+  const boost::filesystem::path tmpFile(file.string() + ".tmp");
+  ofstream fout(tmpFile.string().c_str(), ios::out | ios::binary);
+  fout.write(reinterpret_cast<const char*>(&header), sizeof(SpectralCacheHeader));
+  fout.write(reinterpret_cast<const char*>(&alpha_avbin[0]), alpha_avbin.size()*sizeof(CFreal));
+  fout.write(reinterpret_cast<const char*>(&B_bin[0]), B_bin.size()*sizeof(CFreal));
+  fout.close();
+  
+  if (!fout) {
+    CFLog(WARN, "ParadeRadiator::writeSpectralCache() => could not write " << tmpFile << "\n");
+    boost::filesystem::remove(tmpFile);
+    return;
+  }
+  boost::filesystem::rename(tmpFile, file);
+  
+  CFLog(INFO, "ParadeRadiator::writeSpectralCache() => binned/banded data written to " << file << "\n");
+}
+
 //////////////////////////////////////////////////////////////////////////////
   
 void ParadeRadiator::getSpectralIdxs(CFreal lambda, CFuint& idx1, CFuint& idx2)
@@ -692,11 +905,11 @@ void ParadeRadiator::getSpectralIdxs(CFreal lambda, CFuint& idx1, CFuint& idx2)
   
 //////////////////////////////////////////////////////////////////////////////
   
-CFreal ParadeRadiator::getEmission(CFreal lambda, RealVector &s_o)
+CFreal ParadeRadiator::getEmission(CFreal lambda, RealVector &s_o, CFuint iTracer)
 {
   CFuint spectralIdx1 = 0;
   CFuint spectralIdx2 = 0;
-  const CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx();
+  const CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx(iTracer);
   getSpectralIdxs(lambda, spectralIdx1, spectralIdx2);
   
   const CFuint nbCols = m_nbPoints*3;
@@ -719,11 +932,11 @@ CFreal ParadeRadiator::getEmission(CFreal lambda, RealVector &s_o)
 
 //////////////////////////////////////////////////////////////////////////////
 
-CFreal ParadeRadiator::getAbsorption(CFreal lambda, RealVector &s_o)
+CFreal ParadeRadiator::getAbsorption(CFreal lambda, RealVector &s_o, CFuint iTracer)
 {
   CFuint spectralIdx1 = 0; 
   CFuint spectralIdx2 = 0;
-  const CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx();
+  const CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx(iTracer);
   getSpectralIdxs(lambda, spectralIdx1, spectralIdx2);
   
   const CFuint nbCols = m_nbPoints*3;
@@ -869,21 +1082,21 @@ void ParadeRadiator::computeEmissionCPD()
 
 //////////////////////////////////////////////////////////////////////////////
 
-CFreal ParadeRadiator::getSpectraLoopPower()
+CFreal ParadeRadiator::getSpectraLoopPower(CFuint iTracer)
 {
-  return m_spectralLoopPowers[ m_radPhysicsHandlerPtr->getCurrentCellTrsIdx() ];
+  return m_spectralLoopPowers[ m_radPhysicsHandlerPtr->getCurrentCellTrsIdx(iTracer) ];
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-void ParadeRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o)
+void ParadeRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o, CFuint iTracer)
 {
   //cout<<"get emission"<<endl;
   static CFuint dim = Framework::PhysicalModelStack::getActive()->getDim();
   static CFuint dim2 = m_radPhysicsHandlerPtr->isAxi() ? 3 : dim;
   
   CFuint nbCpdPoints = m_nbPoints;
-  CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx();
+  CFuint stateIdx = m_radPhysicsHandlerPtr->getCurrentCellTrsIdx(iTracer);
   
   //cout<<"cpd, stateIdx "<<stateIdx<<" :";
   //vector<CFreal>::iterator it;
@@ -892,7 +1105,7 @@ void ParadeRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o)
   //}
   //cout<<endl;
   
-  CFreal rand = m_rand.uniformRand();
+  CFreal rand = getRand(iTracer).uniformRand();
   CFreal* it_start = &m_cpdEms[ stateIdx*nbCpdPoints ];
   CFreal* it_end = &m_cpdEms[ (stateIdx+1)*nbCpdPoints-1 ];
   CFreal* it_upp = std::upper_bound(it_start, it_end, rand);
@@ -911,7 +1124,7 @@ void ParadeRadiator::getRandomEmission(CFreal &lambda, RealVector &s_o)
 
   //cout<<x0<<' '<<x1<<' '<<y0<<' '<<y1<<' '<<rand<<' '<<lambda<<endl;
 
-  m_rand.sphereDirections(dim2, s_o);
+  getRand(iTracer).sphereDirections(dim2, s_o);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -8,6 +8,7 @@
 #include "MathTools/RealVector.hh"
 #include "Common/OSystem.hh"
 #include "boost/filesystem.hpp"
+#include "boost/cstdint.hpp"
 #include "Framework/ProxyDofIterator.hh"
 #include "Framework/DofDataHandleIterator.hh"
 #include "Common/StringOps.hh"
@@ -98,15 +99,15 @@ public:
   
   virtual void setupSpectra(CFreal wavMin, CFreal wavMax);
   
-  CFreal getEmission(CFreal lambda, RealVector &s_o);
+  CFreal getEmission(CFreal lambda, RealVector &s_o, CFuint iTracer);
   
-  CFreal getAbsorption(CFreal lambda, RealVector &s_o);
+  CFreal getAbsorption(CFreal lambda, RealVector &s_o, CFuint iTracer);
   
-  CFreal getSpectraLoopPower();
+  CFreal getSpectraLoopPower(CFuint iTracer);
   
   void computeEmissionCPD();
   
-  void getRandomEmission(CFreal &lambda, RealVector &s_o);
+  void getRandomEmission(CFreal &lambda, RealVector &s_o, CFuint iTracer);
   
   void getSpectralIdxs(CFreal lambda, CFuint& idx1, CFuint& idx2);
   
@@ -126,6 +127,21 @@ protected:
   /// write the local mesh radiative coefficients to a ASCII file
   void writeLocalRadCoeffASCII(const CFuint nbCells);
   
+  /// compute the key identifying the binned/banded data of the current 
+  /// spectral loop from all the PARADE inputs
+  boost::uint64_t computeSpectralCacheKey();
+  
+  /// @return the spectral cache file corresponding to the given key
+  boost::filesystem::path getSpectralCacheFile(const boost::uint64_t key) const;
+  
+  /// read the binned/banded data from the spectral cache, if all the 
+  /// processes in the namespace find a valid cache file
+  /// @return true if the data have been read on all the processes
+  bool readSpectralCache(const boost::uint64_t key);
+  
+  /// write the binned/banded data to the spectral cache
+  void writeSpectralCache(const boost::uint64_t key);
+  
   /// run PARADE
   void runLibrary() const
   {
@@ -299,6 +315,9 @@ protected:
   /// flag telling to parallelize as much as possible to save memory
   bool m_saveMemory;
   
+  /// directory where the binned/banded data are cached (none if empty)
+  std::string m_spectralCacheDir;
+  
   /// flag array to indicate molecular species
   std::vector<bool> m_molecularSpecies;
   
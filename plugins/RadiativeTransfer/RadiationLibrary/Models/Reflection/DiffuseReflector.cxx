@@ -25,11 +25,11 @@ CFreal DiffuseReflector::getReflectionProbability(CFreal lambda, RealVector &s_o
  return 0.025330295910584444; //(1./(4.*pi^2)
 }
 
-void DiffuseReflector::getRandomDirection(CFreal &lambda, RealVector &s_o, RealVector &s_i, RealVector &normal)
+void DiffuseReflector::getRandomDirection(CFreal &lambda, RealVector &s_o, RealVector &s_i, RealVector &normal, CFuint iTracer)
 {
   cf_assert(s_o.size() == s_i.size());
   //diffuse: just an emmission
-  m_rand.hemiDirections(s_i.size(), normal, s_o );
+  getRand(iTracer).hemiDirections(s_i.size(), normal, s_o );
 }
 
 
@@ -25,7 +25,7 @@ public:
 
   void computeReflectionCPD(){}
 
-  void getRandomDirection(CFreal &lambda, RealVector &s_o, RealVector &s_i, RealVector &normal );
+  void getRandomDirection(CFreal &lambda, RealVector &s_o, RealVector &s_i, RealVector &normal, CFuint iTracer );
 
 };
 
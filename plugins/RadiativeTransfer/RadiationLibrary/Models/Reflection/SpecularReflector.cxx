@@ -26,7 +26,7 @@ CFreal SpecularReflector::getReflectionProbability(CFreal lambda, RealVector &s_
   return (s_i==s_o) ? 1. : 0.;
 }
 
-void SpecularReflector::getRandomDirection(CFreal &lambda, RealVector &s_o, RealVector &s_i, RealVector &normal)
+void SpecularReflector::getRandomDirection(CFreal &lambda, RealVector &s_o, RealVector &s_i, RealVector &normal, CFuint iTracer)
 {
   cf_assert(s_o.size() == s_i.size());
   cf_assert(s_o.size() == normal.size());
@@ -44,11 +44,7 @@ RadiationPhysicsHandler::RadiationPhysicsHandler(const std::string& name) :
   m_boundaryTRSnames(),
   m_mediumTRSnames(),
   m_nbTemps(1),
-  m_cellStateID(0),
-  m_cellStateOwnerIdx(0),
-  m_ghostStateID(0),
-  m_ghostStateOwnerIdx(0),
-  m_ghostStateWallGeoID(0),
+  m_current(1),
   m_isAxi(false)
 {
   addConfigOptionsTo(this);
@@ -137,22 +133,45 @@ void RadiationPhysicsHandler::setupWavStride(CFuint loop)
   
 //////////////////////////////////////////////////////////////////////////////
 
-Common::SharedPtr< RadiationPhysics > RadiationPhysicsHandler::getCellDistPtr
-(CFuint stateID)
+void RadiationPhysicsHandler::setNbTracers(CFuint nbTracers)
+{
+  cf_assert(nbTracers > 0);
+  m_current.resize(nbTracers);
+  for(CFuint i=0; i<m_radiationPhysics.size();++i) {
+    m_radiationPhysics[i]->getRadiatorPtr()->setNbTracers(nbTracers);
+    m_radiationPhysics[i]->getReflectorPtr()->setNbTracers(nbTracers);
+  }
+}
+  
+//////////////////////////////////////////////////////////////////////////////
+
+void RadiationPhysicsHandler::seedRandom(CFuint seedNumber, CFuint streamID, CFuint iTracer)
+{
+  for(CFuint i=0; i<m_radiationPhysics.size();++i) {
+    m_radiationPhysics[i]->getRadiatorPtr()->seedRandom(seedNumber, streamID++, iTracer);
+    m_radiationPhysics[i]->getReflectorPtr()->seedRandom(seedNumber, streamID++, iTracer);
+  }
+}
+  
+//////////////////////////////////////////////////////////////////////////////
+
+Common::SafePtr< RadiationPhysics > RadiationPhysicsHandler::getCellDistPtr
+(CFuint stateID, CFuint iTracer)
 {
   //CFLog(INFO,"Cell; stateID: "<<stateID<<"\n");
   cf_assert(stateID<m_statesOwner.size() );
   cf_assert(m_statesOwner[stateID][0] != -1 );
-  m_cellStateID = stateID;
-  m_cellStateOwnerIdx = m_statesOwner[stateID][1];
+  CurrentEntities& current = getCurrent(iTracer);
+  current.cellStateID = stateID;
+  current.cellStateOwnerIdx = m_statesOwner[stateID][1];
 
-  return m_radiationPhysics[ m_statesOwner[stateID][0] ];
+  return m_radiationPhysics[ m_statesOwner[stateID][0] ].getPtr();
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-Common::SharedPtr< RadiationPhysics > RadiationPhysicsHandler::getWallDistPtr
-(CFuint GhostStateID)
+Common::SafePtr< RadiationPhysics > RadiationPhysicsHandler::getWallDistPtr
+(CFuint GhostStateID, CFuint iTracer)
 {
   using namespace COOLFluiD::Common;
   
@@ -162,11 +181,12 @@ Common::SharedPtr< RadiationPhysics > RadiationPhysicsHandler::getWallDistPtr
   
   cf_assert(GhostStateID<m_ghostStatesOwner.size() );
   cf_assert(m_ghostStatesOwner[GhostStateID][0] != -1 );
-  m_ghostStateID = GhostStateID;
-  m_ghostStateOwnerIdx  = m_ghostStatesOwner[GhostStateID][1];
-  m_ghostStateWallGeoID = m_ghostStatesOwner[GhostStateID][2];
+  CurrentEntities& current = getCurrent(iTracer);
+  current.ghostStateID = GhostStateID;
+  current.ghostStateOwnerIdx  = m_ghostStatesOwner[GhostStateID][1];
+  current.ghostStateWallGeoID = m_ghostStatesOwner[GhostStateID][2];
   
-  return m_radiationPhysics[ m_ghostStatesOwner[GhostStateID][0] ];
+  return m_radiationPhysics[ m_ghostStatesOwner[GhostStateID][0] ].getPtr();
 }
 
 //////////////////////////////////////////////////////////////////////////////
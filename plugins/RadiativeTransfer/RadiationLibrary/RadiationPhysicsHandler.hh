@@ -50,14 +50,29 @@ public:
   /// @return flag telling whether @see RadiationPhysics is present
   bool hasRadiationPhysics() const {return (m_radiationPhysics.size()>0);}
   
-  /// @return @see RadiationPhysics corresponding to the given cell state ID
-  Common::SharedPtr< RadiationPhysics > getCellDistPtr(CFuint stateID);
+  /// @return @see RadiationPhysics corresponding to the given cell state ID,
+  ///         which becomes the current cell of the given tracer
+  Common::SafePtr< RadiationPhysics > getCellDistPtr(CFuint stateID, CFuint iTracer = 0);
 
-  /// @return @see RadiationPhysics corresponding to the given ghost state ID
-  Common::SharedPtr< RadiationPhysics > getWallDistPtr(CFuint GhostStateID);
+  /// @return @see RadiationPhysics corresponding to the given ghost state ID,
+  ///         which becomes the current wall face of the given tracer
+  Common::SafePtr< RadiationPhysics > getWallDistPtr(CFuint GhostStateID, CFuint iTracer = 0);
 
   /// get the number of loops
   CFuint getNumberLoops() const {return m_nbLoops;}
+  
+  /// @return the number of random number generators (one per radiator and reflector)
+  CFuint getNbRandomStreams() const {return 2*m_radiationPhysics.size();}
+  
+  /// set the number of tracers that can use this object concurrently: each
+  /// tracer has its own current cell/wall and its own random number generators,
+  /// selected by the tracer index passed to the accessors
+  void setNbTracers(CFuint nbTracers);
+  
+  /// seed the random number generators of all the radiators and reflectors
+  /// used by the given tracer with consecutive independent streams, starting 
+  /// from streamID
+  void seedRandom(CFuint seedNumber, CFuint streamID, CFuint iTracer = 0);
 
   /// set up the data sockets
   void setupDataSockets(Framework::SocketBundle sockets){m_sockets = sockets;}
@@ -108,19 +123,24 @@ public:
   }
   
   /// @return the current cell state ID
-  CFuint getCurrentCellStateID() const {return m_cellStateID;}
+  CFuint getCurrentCellStateID(CFuint iTracer = 0) const 
+  {return getCurrent(iTracer).cellStateID;}
   
   /// @return the current cell ID into its corresponding  TRS
-  CFuint getCurrentCellTrsIdx() const {return m_cellStateOwnerIdx;}
+  CFuint getCurrentCellTrsIdx(CFuint iTracer = 0) const 
+  {return getCurrent(iTracer).cellStateOwnerIdx;}
   
   /// @return the current cell wall ghost state ID
-  CFuint getCurrentWallGhostStateID() const {return m_ghostStateID;}
+  CFuint getCurrentWallGhostStateID(CFuint iTracer = 0) const 
+  {return getCurrent(iTracer).ghostStateID;}
   
   /// @return the current wall face ID into its corresponding TRS
-  CFuint getCurrentWallTrsIdx() const {return m_ghostStateOwnerIdx;}
+  CFuint getCurrentWallTrsIdx(CFuint iTracer = 0) const 
+  {return getCurrent(iTracer).ghostStateOwnerIdx;}
   
   /// @return the current wall face ID (local ID in the current processor)
-  CFuint getCurrentWallGeoID() const {return m_ghostStateWallGeoID;}
+  CFuint getCurrentWallGeoID(CFuint iTracer = 0) const 
+  {return getCurrent(iTracer).ghostStateWallGeoID;}
   
   /// @return the variable ID corresponding to the temperature
   CFuint getTempID() const {return m_TempID;}
@@ -135,6 +155,35 @@ public:
   /// @return the number of ghost states
   CFuint getNbGhostStates() const {return m_ghostStatesOwner.size();} 
   
+private:
+  
+  /// cell and wall face currently processed by one tracer
+  struct CurrentEntities {
+    CurrentEntities() : cellStateID(0), cellStateOwnerIdx(0), ghostStateID(0),
+			ghostStateOwnerIdx(0), ghostStateWallGeoID(0) {}
+    CFuint cellStateID;
+    CFuint cellStateOwnerIdx;
+    CFuint ghostStateID;
+    CFuint ghostStateOwnerIdx;
+    CFuint ghostStateWallGeoID;
+    /// padding to keep the entries of different tracers in different cache lines
+    char padding[64];
+  };
+  
+  /// @return the current entities of the given tracer
+  CurrentEntities& getCurrent(CFuint iTracer) 
+  {
+    cf_assert(iTracer < m_current.size());
+    return m_current[iTracer];
+  }
+  
+  /// @return the current entities of the given tracer
+  const CurrentEntities& getCurrent(CFuint iTracer) const 
+  {
+    cf_assert(iTracer < m_current.size());
+    return m_current[iTracer];
+  }
+  
 private:
   Framework::SocketBundle m_sockets;
   std::vector<Common::SharedPtr< RadiationPhysics > > m_radiationPhysics;
@@ -146,12 +195,9 @@ private:
   std::vector<std::string> m_mediumTRSnames;
   
   CFuint m_nbTemps;
-  CFuint m_cellStateID;
-  CFuint m_cellStateOwnerIdx;
   
-  CFuint m_ghostStateID;
-  CFuint m_ghostStateOwnerIdx;
-  CFuint m_ghostStateWallGeoID;
+  /// current cell and wall face of each tracer
+  std::vector<CurrentEntities> m_current;
   
   bool m_isAxi;
   
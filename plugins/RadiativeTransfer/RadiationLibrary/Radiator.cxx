@@ -22,6 +22,7 @@ Radiator::Radiator(const std::string& name):
   Common::OwnedObject(),
   ConfigObject(name),
   m_angstrom(1e-10),
+  m_rands(1),
   m_states(CFNULL),
   m_volumes(CFNULL),
   m_faceAreas(CFNULL),
@@ -50,19 +51,19 @@ void Radiator::setup()
 
 //////////////////////////////////////////////////////////////////////////////
 
-CFreal Radiator::getCurrentCellVolume() const
+CFreal Radiator::getCurrentCellVolume(CFuint iTracer) const
 {
   const CFuint stateID = 
-    m_radPhysicsHandlerPtr->getCurrentCellStateID();
+    m_radPhysicsHandlerPtr->getCurrentCellStateID(iTracer);
   return getCellVolume( stateID );
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-CFreal Radiator::getCurrentWallArea() const 
+CFreal Radiator::getCurrentWallArea(CFuint iTracer) const 
 {
   const CFuint wallGeoID = 
-      m_radPhysicsHandlerPtr->getCurrentWallGeoID();
+      m_radPhysicsHandlerPtr->getCurrentWallGeoID(iTracer);
   //CFuint wallTrsIdx = m_radPhysicsHandlerPtr->getCurrentWallTrsIdx();
   return getWallArea(wallGeoID);
 }
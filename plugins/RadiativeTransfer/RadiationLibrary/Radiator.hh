@@ -56,15 +56,28 @@ public:
   
   virtual void setupSpectra(CFreal wavMin, CFreal wavMax) = 0;
 
-  virtual CFreal getEmission( CFreal lambda, RealVector &s_o ) = 0;
+  /// the methods below work on the current cell/wall of the given tracer
+  /// (@see RadiationPhysicsHandler) and draw from its random number generator
+  virtual CFreal getEmission( CFreal lambda, RealVector &s_o, CFuint iTracer ) = 0;
 
-  virtual CFreal getAbsorption( CFreal lambda, RealVector &s_o ) = 0;
+  virtual CFreal getAbsorption( CFreal lambda, RealVector &s_o, CFuint iTracer ) = 0;
 
-  virtual CFreal getSpectraLoopPower() = 0;
+  virtual CFreal getSpectraLoopPower(CFuint iTracer) = 0;
 
   virtual void computeEmissionCPD() = 0;
 
-  virtual void getRandomEmission(CFreal &lambda, RealVector &s_o ) = 0;
+  virtual void getRandomEmission(CFreal &lambda, RealVector &s_o, CFuint iTracer ) = 0;
+
+  /// set the number of tracers that can draw random numbers concurrently
+  void setNbTracers(CFuint nbTracers) {m_rands.resize(nbTracers);}
+  
+  /// seed the random number generator of the given tracer with the given
+  /// independent stream
+  void seedRandom(CFuint seedNumber, CFuint streamID, CFuint iTracer = 0) 
+  {
+    cf_assert(iTracer < m_rands.size());
+    m_rands[iTracer].seed(seedNumber, streamID);
+  }
 
   void setRadPhysicsPtr(RadiationPhysics *radPhysicsPtr) {
     m_radPhysicsPtr = radPhysicsPtr;
@@ -74,11 +87,11 @@ public:
     m_radPhysicsHandlerPtr = radPhysicsHandlerPtr;
   }
   
-  /// get the volume of the current cell
-  CFreal getCurrentCellVolume() const;
+  /// get the volume of the current cell of the given tracer
+  CFreal getCurrentCellVolume(CFuint iTracer = 0) const;
   
-  /// get the area of the current wall face
-  CFreal getCurrentWallArea() const;
+  /// get the area of the current wall face of the given tracer
+  CFreal getCurrentWallArea(CFuint iTracer = 0) const;
   
   /// get the cell volume
   CFreal getCellVolume(CFuint stateID) const;
@@ -91,7 +104,17 @@ protected:
   const CFreal m_angstrom; 
   RadiationPhysics *m_radPhysicsPtr;
   RadiationPhysicsHandler *m_radPhysicsHandlerPtr;
-  RandomNumberGenerator m_rand;
+  /// @return the random number generator of the given tracer
+  RandomNumberGenerator& getRand(CFuint iTracer) 
+  {
+    cf_assert(iTracer < m_rands.size());
+    return m_rands[iTracer];
+  }
+  
+protected:
+  
+  /// random number generator of each tracer
+  std::vector<RandomNumberGenerator> m_rands;
   
   /// array of state vectors
   Framework::DataHandle<Framework::State*, Framework::GLOBAL> m_states;
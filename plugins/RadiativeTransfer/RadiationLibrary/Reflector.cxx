@@ -7,7 +7,8 @@ namespace RadiativeTransfer {
 /// Constructor without arguments
 Reflector::Reflector(const std::string& name):
            Common::OwnedObject(),
-           ConfigObject(name)
+           ConfigObject(name),
+           m_rands(1)
 {
   addConfigOptionsTo(this);
 }
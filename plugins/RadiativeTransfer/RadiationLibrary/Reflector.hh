@@ -44,7 +44,19 @@ public:
 
   virtual void computeReflectionCPD() = 0;
 
-  virtual void getRandomDirection(CFreal &lambda, RealVector &s_o, RealVector &s_i, RealVector &normal ) = 0;
+  /// draw the reflected direction with the random number generator of the given tracer
+  virtual void getRandomDirection(CFreal &lambda, RealVector &s_o, RealVector &s_i, RealVector &normal, CFuint iTracer ) = 0;
+
+  /// set the number of tracers that can draw random numbers concurrently
+  void setNbTracers(CFuint nbTracers) {m_rands.resize(nbTracers);}
+  
+  /// seed the random number generator of the given tracer with the given
+  /// independent stream
+  void seedRandom(CFuint seedNumber, CFuint streamID, CFuint iTracer = 0) 
+  {
+    cf_assert(iTracer < m_rands.size());
+    m_rands[iTracer].seed(seedNumber, streamID);
+  }
 
   void setRadPhysicsPtr(RadiationPhysics *radPhysicsPtr) {
     m_radPhysicsPtr = radPhysicsPtr;
@@ -57,7 +69,16 @@ public:
 protected:
   RadiationPhysics *m_radPhysicsPtr;
   RadiationPhysicsHandler *m_radPhysicsHandlerPtr;
-  RandomNumberGenerator m_rand;
+  
+  /// @return the random number generator of the given tracer
+  RandomNumberGenerator& getRand(CFuint iTracer) 
+  {
+    cf_assert(iTracer < m_rands.size());
+    return m_rands[iTracer];
+  }
+  
+  /// random number generator of each tracer
+  std::vector<RandomNumberGenerator> m_rands;
 
 };
 
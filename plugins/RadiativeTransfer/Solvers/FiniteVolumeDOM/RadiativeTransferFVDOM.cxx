@@ -1,9 +1,12 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
 #include "Common/PE.hh"
 #include "Common/BadValueException.hh"
 #include "Common/CFPrintContainer.hh"
+#include "Common/OMPHelper.hh"
+#include "Common/HashBytes.hh"
 
 #include "MathTools/MathConsts.hh"
 
@@ -95,6 +98,7 @@ RadiativeTransferFVDOM::RadiativeTransferFVDOM(const std::string& name) :
   m_wallTrsNames(),
   m_dirs(),
   m_advanceOrder(),
+  m_stagePtr(),
   m_qrAv(),
   m_divqAv(),
   m_nbBins(1),
@@ -188,6 +192,12 @@ RadiativeTransferFVDOM::RadiativeTransferFVDOM(const std::string& name) :
   // AL: to be removed once a cleaner solution is found 
   m_radNamespace = "Default";
   setParameter("RadNamespace", &m_radNamespace);
+  
+  m_nbThreadsOMP = 1;
+  setParameter("NbThreadsOMP", &m_nbThreadsOMP);
+  
+  m_advanceOrderFile = "";
+  setParameter("AdvanceOrderFile", &m_advanceOrderFile);
 }
     
 //////////////////////////////////////////////////////////////////////////////
@@ -241,6 +251,11 @@ void RadiativeTransferFVDOM::defineConfigOptions(Config::OptionList& options)
   // AL: to be removed once a cleaner solution is found 
   options.addConfigOption< string >
     ("RadNamespace","Namespace grouping all ranks involved in parallel communication");
+  
+  options.addConfigOption< CFuint >
+    ("NbThreadsOMP","Number of OMP threads sweeping the cells of each stage (0 = all available).");
+  options.addConfigOption< string >
+    ("AdvanceOrderFile","Name of the file where the advance order is cached for the next runs (none if empty).");
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -566,6 +581,7 @@ void RadiativeTransferFVDOM::setup()
   // 1D array (logically 2D) to store advanceOrder
   m_advanceOrder.resize(nbCells*(endDir-startDir));
   cf_assert(m_advanceOrder.size() > 0);
+  m_stagePtr.resize(endDir-startDir);
   
   m_normal.resize(DIM, 0.); 
   
@@ -637,12 +653,13 @@ void RadiativeTransferFVDOM::setup()
   
   stp.start();
   
-  if (!m_emptyRun) {
+  if (!m_emptyRun && !readAdvanceOrder()) {
     // only get advance order for the considered directions
     CFuint countd = 0;
     for (CFuint d = startDir; d < endDir; ++d, ++countd){
       getAdvanceOrder(d, &m_advanceOrder[countd*nbCells]);
     }
+    writeAdvanceOrder();
   }
     
   CFLog(INFO, "RadiativeTransferFVDOM::setup() => getAdvanceOrder() took " << stp.read() << "s\n");
@@ -1432,65 +1449,73 @@ void RadiativeTransferFVDOM::getAdvanceOrder(const CFuint d,
   // precompute the dot products for all faces and directions (a part from the sign)
   computeDotProdInFace(d, m_dotProdInFace);
   
-  CFuint mLast = 0;
-  CFuint m = 0;
-
-  CFuint stage = 1;
-  // Initializing the sdone and cdone for each direction
-  m_sdone.assign(nbCells, false);
+  SafePtr<ConnectivityTable<CFuint> > cellFaces = MeshDataStack::getActive()->getConnectivity("cellFaces");
+  DataHandle<CFint> isOutward = socket_isOutward.getDataHandle();
   
+  // count the upwind neighbors of each cell: a cell is advanced in the 
+  // stage following the one where its last upwind neighbor is advanced
+  vector<CFuint> nbUpwindCells(nbCells, 0);
+  for (CFuint iCell = 0; iCell < nbCells; iCell++) {
+    const CFuint nbFaces = cellFaces->nbCols(iCell);
+    for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+      const CFuint faceID = (*cellFaces)(iCell, iFace);
+      const CFreal factor = ((CFuint)(isOutward[faceID]) != iCell) ? -1. : 1.;
+      if (!m_mapGeoToTrs->isBGeo(faceID) && m_dotProdInFace[faceID]*factor < 0.) {
+	nbUpwindCells[iCell]++;
+      }
+    }
+  }
+  
+  // the first stage includes all the cells with no upwind neighbor
   m_cdoneIdx.clear();
-  cf_assert(m_cdoneIdx.size() == 0);
-  cf_assert(m_cdoneIdx.capacity() == nbCells);
+  for (CFuint iCell = 0; iCell < nbCells; iCell++) {
+    if (nbUpwindCells[iCell] == 0) {m_cdoneIdx.push_back(iCell);}
+  }
   
-  SafePtr<ConnectivityTable<CFuint> > cellFaces = MeshDataStack::getActive()->getConnectivity("cellFaces");
-  DataHandle<CFint> isOutward = socket_isOutward.getDataHandle();
-    
-  while (m < nbCells) { //The loop over the cells begins
-    mLast = m;	  //Checking to see if it counts all the cells
-    for (CFuint iCell = 0; iCell < nbCells; iCell++) {
-      CFLog(DEBUG_MAX, "RadiativeTransferFVDOM::getAdvanceOrder() => iCell = " << iCell <<"\n");
-      if (m_sdone[iCell] == false) {
-	const CFuint nbFaces = cellFaces->nbCols(iCell);
-	for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
-	  const CFuint faceID = (*cellFaces)(iCell, iFace);
-	  const bool isBFace  = m_mapGeoToTrs->isBGeo(faceID);
-	  const bool neighborIsSdone = (!isBFace) ? m_sdone[getNeighborCellID(faceID, iCell)] : true;
-	  
-	  // When dot product is < 0 and neighbor is undone, skip the cell and continue the loop
-	  const CFreal factor = ((CFuint)(isOutward[faceID]) != iCell) ? -1. : 1.;
-	  const CFreal dotMult = m_dotProdInFace[faceID]*factor;
-	  if (dotMult < 0. && neighborIsSdone == false) {goto cell_loop;}
-	}// end loop over the FACES
-	
-	CFLog(DEBUG_MAX, "advanceOrder[" << d << "][" << m <<"] = " << iCell << "\n");
-	
-	advanceOrder[m] = iCell;
-	CellID[iCell] = stage;
-	m_cdoneIdx.push_back(iCell);
-	m += 1;
-      }// end if(Cell is not done)
-      
-    cell_loop:
-      const bool dummy = true;
-    }// end of the loop over the CELLS
-    
-    const string msg = "advanceOrder[" + StringOps::to_str(d) + "] = ";
-    CFLog(DEBUG_MAX, msg << "\n");
-    for (CFuint a = 0; a < nbCells; ++a) {
-      CFLog(DEBUG_MAX, advanceOrder[a] << " ");
+  vector<CFuint>& stagePtr = m_stagePtr[d - m_startEndDir.first];
+  stagePtr.clear();
+  stagePtr.push_back(0);
+  
+  vector<CFuint> nextIdx;
+  nextIdx.reserve(nbCells);
+  
+  CFuint m = 0;
+  CFuint stage = 1;
+  while (m < nbCells) {
+    if (m_cdoneIdx.size() == 0) {
+      diagnoseProblem(d, m, m);
+      throw BadValueException
+	(FromHere(), "RadiativeTransferFVDOM::getAdvanceOrder() => cyclic dependency between cells");
     }
-    CFLog(DEBUG_MAX, "\n");
-
-    if (m == mLast) {diagnoseProblem(d, m, mLast);}
     
-    advanceOrder[m - 1] *= -1;
+    // the cells of a stage are advanced in increasing ID order
+    std::sort(m_cdoneIdx.begin(), m_cdoneIdx.end());
     
-    CFLog(DEBUG_MAX, "At stage[" << stage << "] => m_cdoneIdx.size() = " << m_cdoneIdx.size() << "\n");
+    nextIdx.clear();
     for (CFuint id = 0; id < m_cdoneIdx.size(); ++id) {
-      m_sdone[m_cdoneIdx[id]] = true;
+      const CFuint iCell = m_cdoneIdx[id];
+      CFLog(DEBUG_MAX, "advanceOrder[" << d << "][" << m <<"] = " << iCell << "\n");
+      advanceOrder[m++] = iCell;
+      CellID[iCell] = stage;
+      
+      // the downwind neighbors with no other upwind neighbor left go to the next stage
+      const CFuint nbFaces = cellFaces->nbCols(iCell);
+      for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+	const CFuint faceID = (*cellFaces)(iCell, iFace);
+	const CFreal factor = ((CFuint)(isOutward[faceID]) != iCell) ? -1. : 1.;
+	if (!m_mapGeoToTrs->isBGeo(faceID) && m_dotProdInFace[faceID]*factor > 0.) {
+	  const CFuint neighborCellID = getNeighborCellID(faceID, iCell);
+	  cf_assert(nbUpwindCells[neighborCellID] > 0);
+	  if (--nbUpwindCells[neighborCellID] == 0) {
+	    nextIdx.push_back(neighborCellID);
+	  }
+	}
+      }
     }
-    m_cdoneIdx.clear();
+    
+    advanceOrder[m - 1] *= -1;
+    stagePtr.push_back(m);
+    m_cdoneIdx.swap(nextIdx);
     
     CFLog(VERBOSE, "RadiativeTransferFVDOM::getAdvanceOrder() => m  "<< m << " \n");
     CFLog(VERBOSE, "RadiativeTransferFVDOM::getAdvanceOrder() => End of the "<< stage << " stage\n");
@@ -1512,6 +1537,114 @@ void RadiativeTransferFVDOM::getAdvanceOrder(const CFuint d,
       
 //////////////////////////////////////////////////////////////////////////////
 
+boost::uint64_t RadiativeTransferFVDOM::computeAdvanceOrderKey()
+{
+  DataHandle<CFreal> normals = socket_normals.getDataHandle();
+  DataHandle<CFint> isOutward = socket_isOutward.getDataHandle();
+  SafePtr<ConnectivityTable<CFuint> > cellFaces = MeshDataStack::getActive()->getConnectivity("cellFaces");
+  
+  boost::uint64_t key = HASH_BYTES_SEED;
+  hashBytes(&m_startEndDir.first, sizeof(CFuint), key);
+  hashBytes(&m_startEndDir.second, sizeof(CFuint), key);
+  hashBytes(&m_dirs[0], m_dirs.size()*sizeof(CFreal), key);
+  hashBytes(&normals[0], normals.size()*sizeof(CFreal), key);
+  hashBytes(&isOutward[0], isOutward.size()*sizeof(CFint), key);
+  
+  const CFuint nbCells = cellFaces->nbRows();
+  for (CFuint iCell = 0; iCell < nbCells; ++iCell) {
+    const CFuint nbFaces = cellFaces->nbCols(iCell);
+    hashBytes(&nbFaces, sizeof(CFuint), key);
+    for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+      const CFuint faceID = (*cellFaces)(iCell, iFace);
+      hashBytes(&faceID, sizeof(CFuint), key);
+    }
+  }
+  return key;
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
+bool RadiativeTransferFVDOM::readAdvanceOrder()
+{
+  if (m_advanceOrderFile == "") return false;
+  
+  boost::filesystem::path file = m_dirName / boost::filesystem::path(m_advanceOrderFile);
+  file = PathAppender::getInstance().appendParallel( file );
+  if (!boost::filesystem::exists(file)) return false;
+  
+  DataHandle<CFreal> CellID = socket_CellID.getDataHandle();
+  const CFuint nbCells = CellID.size();
+  
+  ifstream fin(file.string().c_str(), ios::binary);
+  boost::uint64_t key = 0;
+  CFuint nbCellsInFile = 0;
+  CFuint nbDirsInFile = 0;
+  fin.read(reinterpret_cast<char*>(&key), sizeof(boost::uint64_t));
+  fin.read(reinterpret_cast<char*>(&nbCellsInFile), sizeof(CFuint));
+  fin.read(reinterpret_cast<char*>(&nbDirsInFile), sizeof(CFuint));
+  if (!fin || key != computeAdvanceOrderKey() || 
+      nbCellsInFile != nbCells || nbDirsInFile != m_stagePtr.size()) {
+    CFLog(INFO, "RadiativeTransferFVDOM::readAdvanceOrder() => " << file 
+	  << " does not match the current mesh and directions\n");
+    return false;
+  }
+  
+  for (CFuint iDir = 0; iDir < m_stagePtr.size(); ++iDir) {
+    CFuint nbPtrs = 0;
+    fin.read(reinterpret_cast<char*>(&nbPtrs), sizeof(CFuint));
+    if (!fin || nbPtrs < 2 || nbPtrs > nbCells+1) return false;
+    m_stagePtr[iDir].resize(nbPtrs);
+    fin.read(reinterpret_cast<char*>(&m_stagePtr[iDir][0]), nbPtrs*sizeof(CFuint));
+  }
+  fin.read(reinterpret_cast<char*>(&m_advanceOrder[0]), m_advanceOrder.size()*sizeof(CFint));
+  if (!fin) return false;
+  
+  // stage of each cell in the last direction (as computed by getAdvanceOrder())
+  const vector<CFuint>& stagePtr = m_stagePtr.back();
+  const CFuint startCell = (m_stagePtr.size()-1)*nbCells;
+  for (CFuint iStage = 0; iStage+1 < stagePtr.size(); ++iStage) {
+    for (CFuint m = stagePtr[iStage]; m < stagePtr[iStage+1]; ++m) {
+      CellID[std::abs(m_advanceOrder[startCell+m])] = iStage+1;
+    }
+  }
+  
+  CFLog(INFO, "RadiativeTransferFVDOM::readAdvanceOrder() => advance order read from " << file << "\n");
+  return true;
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
+void RadiativeTransferFVDOM::writeAdvanceOrder()
+{
+  if (m_advanceOrderFile == "") return;
+  
+  boost::filesystem::path file = m_dirName / boost::filesystem::path(m_advanceOrderFile);
+  file = PathAppender::getInstance().appendParallel( file );
+  
+  SelfRegistPtr<Environment::FileHandlerOutput> fhandle = 
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+  ofstream& fout = fhandle->open(file, ios::out | ios::binary);
+  
+  const boost::uint64_t key = computeAdvanceOrderKey();
+  const CFuint nbCells = socket_CellID.getDataHandle().size();
+  const CFuint nbDirs = m_stagePtr.size();
+  fout.write(reinterpret_cast<const char*>(&key), sizeof(boost::uint64_t));
+  fout.write(reinterpret_cast<const char*>(&nbCells), sizeof(CFuint));
+  fout.write(reinterpret_cast<const char*>(&nbDirs), sizeof(CFuint));
+  for (CFuint iDir = 0; iDir < nbDirs; ++iDir) {
+    const CFuint nbPtrs = m_stagePtr[iDir].size();
+    fout.write(reinterpret_cast<const char*>(&nbPtrs), sizeof(CFuint));
+    fout.write(reinterpret_cast<const char*>(&m_stagePtr[iDir][0]), nbPtrs*sizeof(CFuint));
+  }
+  fout.write(reinterpret_cast<const char*>(&m_advanceOrder[0]), m_advanceOrder.size()*sizeof(CFint));
+  
+  fhandle->close();
+  
+  CFLog(INFO, "RadiativeTransferFVDOM::writeAdvanceOrder() => advance order written to " << file << "\n");
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
 void RadiativeTransferFVDOM::readOpacities()
 {
   CFLog(VERBOSE, "RadiativeTransferFVDOM::readOpacities() => start\n");
@@ -1850,86 +1983,96 @@ void RadiativeTransferFVDOM::computeQExponential(const CFuint ib,
   
 
   const CFuint startCell = (d-dStart)*nbCells;
-  for (CFuint m = 0; m < nbCells; m++) {
-    CFreal inDirDotnANeg = 0.;
-    CFreal Ic            = 0.;
-    CFreal dirDotnANeg   = 0.;
-    CFreal Lc            = 0.;
-    CFreal halfExp       = 0.;
-    CFreal POP_dirDotNA  = 0.;
+  const vector<CFuint>& stagePtr = m_stagePtr[d-dStart];
+  const int nbThreads = static_cast<int>(getNbThreadsOMP(m_nbThreadsOMP));
+  
+  // the cells of a stage only depend on the cells of the previous stages:
+  // they can be swept in parallel
+  for (CFuint iStage = 0; iStage+1 < stagePtr.size(); ++iStage) {
+    const CFint stageStart = stagePtr[iStage];
+    const CFint stageEnd   = stagePtr[iStage+1];
+#pragma omp parallel for schedule(static) num_threads(nbThreads) if(stageEnd - stageStart > 64)
+    for (CFint m = stageStart; m < stageEnd; m++) {
+      CFreal inDirDotnANeg = 0.;
+      CFreal Ic            = 0.;
+      CFreal dirDotnANeg   = 0.;
+      CFreal Lc            = 0.;
+      CFreal halfExp       = 0.;
+      CFreal POP_dirDotNA  = 0.;
       
-    // allocate the cell entity
-    cf_assert(startCell+m < m_advanceOrder.size());
-    const CFuint iCell = std::abs(m_advanceOrder[startCell+m]);
+      // allocate the cell entity
+      cf_assert(startCell+m < m_advanceOrder.size());
+      const CFuint iCell = std::abs(m_advanceOrder[startCell+m]);
     
-    // new algorithm (more parallelizable): opacities are computed cell by cell
-    // for a given bin
-    if (!m_oldAlgo) {getFieldOpacities(ib, iCell);} 
+      // new algorithm (more parallelizable): opacities are computed cell by cell
+      // for a given bin
+      if (!m_oldAlgo) {getFieldOpacities(ib, iCell);} 
     
-    const CFuint nbFaces = cellFaces->nbCols(iCell);
-    //    cf_assert(nbFaces == nbFacesInCell[iCell]);
-    for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
-      const CFuint faceID = (*cellFaces)(iCell, iFace);
-      const CFreal factor = ((CFuint)(isOutward[faceID]) != iCell) ? -1. : 1.;
-      const CFreal dirDotNA = m_dotProdInFace[faceID]*factor;
+      const CFuint nbFaces = cellFaces->nbCols(iCell);
+      //    cf_assert(nbFaces == nbFacesInCell[iCell]);
+      for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+        const CFuint faceID = (*cellFaces)(iCell, iFace);
+        const CFreal factor = ((CFuint)(isOutward[faceID]) != iCell) ? -1. : 1.;
+        const CFreal dirDotNA = m_dotProdInFace[faceID]*factor;
       
-      if(dirDotNA < 0.) {
-	dirDotnANeg += dirDotNA;
+        if(dirDotNA < 0.) {
+	  dirDotnANeg += dirDotNA;
 	
-	/*const CFint fcellID = faceCell[faceID*2]; 
-	  const CFint neighborCellID = (fcellID == iCell) ? faceCell[faceID*2+1] : fcellID;
-	  const CFreal source = (neighborCellID >=0) ? m_In[neighborCellID] : m_fieldSource[iCell];
-	  inDirDotnANeg += source*dirDotNA;*/
+	  /*const CFint fcellID = faceCell[faceID*2]; 
+	    const CFint neighborCellID = (fcellID == iCell) ? faceCell[faceID*2+1] : fcellID;
+	    const CFreal source = (neighborCellID >=0) ? m_In[neighborCellID] : m_fieldSource[iCell];
+	    inDirDotnANeg += source*dirDotNA;*/
 	
-	const bool isBFace = m_mapGeoToTrs->isBGeo(faceID);
-	if (!isBFace){
-	  const CFuint neighborCellID = getNeighborCellID(faceID, iCell);
-	  inDirDotnANeg += m_In[neighborCellID]*dirDotNA;
-	}
-	else {
-	  const CFreal boundarySource = m_fieldSource[iCell];
-	  inDirDotnANeg += boundarySource*dirDotNA;
-	}
-      }
-      else if (dirDotNA > 0.) {
-	POP_dirDotNA += dirDotNA;
-      }
-    } 
+	  const bool isBFace = m_mapGeoToTrs->isBGeo(faceID);
+	  if (!isBFace){
+	    const CFuint neighborCellID = getNeighborCellID(faceID, iCell);
+	    inDirDotnANeg += m_In[neighborCellID]*dirDotNA;
+	  }
+	  else {
+	    const CFreal boundarySource = m_fieldSource[iCell];
+	    inDirDotnANeg += boundarySource*dirDotNA;
+	  }
+        }
+        else if (dirDotNA > 0.) {
+	  POP_dirDotNA += dirDotNA;
+        }
+      } 
     
-    Lc          = volumes[iCell]/(- dirDotnANeg); 
-    halfExp     = std::exp(-0.5*Lc*m_fieldAbsor[iCell]);
-    const CFreal InCell = (inDirDotnANeg/dirDotnANeg)*halfExp*halfExp + (1. - halfExp*halfExp)*m_fieldSource[iCell];
-    Ic          = (inDirDotnANeg/dirDotnANeg)*halfExp + (1. - halfExp)*m_fieldSource[iCell];
+      Lc          = volumes[iCell]/(- dirDotnANeg); 
+      halfExp     = std::exp(-0.5*Lc*m_fieldAbsor[iCell]);
+      const CFreal InCell = (inDirDotnANeg/dirDotnANeg)*halfExp*halfExp + (1. - halfExp*halfExp)*m_fieldSource[iCell];
+      Ic          = (inDirDotnANeg/dirDotnANeg)*halfExp + (1. - halfExp)*m_fieldSource[iCell];
     
-    CFreal inDirDotnA = inDirDotnANeg;
-    inDirDotnA += InCell*POP_dirDotNA;
-    m_In[iCell] = InCell;
-    const CFreal IcWeight = Ic*m_weight[d];
-    const CFuint d3 = d*3;
+      CFreal inDirDotnA = inDirDotnANeg;
+      inDirDotnA += InCell*POP_dirDotNA;
+      m_In[iCell] = InCell;
+      const CFreal IcWeight = Ic*m_weight[d];
+      const CFuint d3 = d*3;
     
-    qx[iCell]   += m_dirs[d3]*IcWeight;
-    qy[iCell]   += m_dirs[d3+1]*IcWeight;
-    qz[iCell]   += m_dirs[d3+2]*IcWeight;
-    divQ[iCell] += inDirDotnA*m_weight[d];
-    // m_II[iCell] += Ic*m_weight[d]; // useless
+      qx[iCell]   += m_dirs[d3]*IcWeight;
+      qy[iCell]   += m_dirs[d3+1]*IcWeight;
+      qz[iCell]   += m_dirs[d3+2]*IcWeight;
+      divQ[iCell] += inDirDotnA*m_weight[d];
+      // m_II[iCell] += Ic*m_weight[d]; // useless
     
-    /*if (iCell==100 && d == 0) {
-      printf ("IcWeight    : %6.6f \n", IcWeight);
-      printf ("inDirDotnA  : %6.6f \n",inDirDotnA);
-      printf ("InCell      : %6.6f \n", InCell);
-      printf ("cellIDin    : %d  \n", iCell*m_nbDirs+d);
-      const CFreal qxIcell = qx[iCell];
-      printf ("qx[iCell]   : %6.6f  \n", qxIcell);
-      const CFreal divqIcell = divQ[iCell];
-      printf ("divq[iCell] : %6.6f  \n", divqIcell);
-      const CFreal In0 = m_In[iCell];
-      printf ("In[iCell]   : %6.6f  \n", In0);
-      printf ("d3          : %d  \n", d3);
-      printf ("mdirs[d3]   : %6.6f  \n", m_dirs[d3]);
-      printf ("mdirs[d3+1] : %6.6f  \n", m_dirs[d3+1]);
-        printf ("mdirs[d3+2] : %6.6f  \n", m_dirs[d3+2]);
-	exit(1);
-	}*/
+      /*if (iCell==100 && d == 0) {
+        printf ("IcWeight    : %6.6f \n", IcWeight);
+        printf ("inDirDotnA  : %6.6f \n",inDirDotnA);
+        printf ("InCell      : %6.6f \n", InCell);
+        printf ("cellIDin    : %d  \n", iCell*m_nbDirs+d);
+        const CFreal qxIcell = qx[iCell];
+        printf ("qx[iCell]   : %6.6f  \n", qxIcell);
+        const CFreal divqIcell = divQ[iCell];
+        printf ("divq[iCell] : %6.6f  \n", divqIcell);
+        const CFreal In0 = m_In[iCell];
+        printf ("In[iCell]   : %6.6f  \n", In0);
+        printf ("d3          : %d  \n", d3);
+        printf ("mdirs[d3]   : %6.6f  \n", m_dirs[d3]);
+        printf ("mdirs[d3+1] : %6.6f  \n", m_dirs[d3+1]);
+          printf ("mdirs[d3+2] : %6.6f  \n", m_dirs[d3+2]);
+	  exit(1);
+	  }*/
+    }
   }
   
   CFLog(VERBOSE, 
@@ -1961,60 +2104,70 @@ void RadiativeTransferFVDOM::computeQNoExponential(const CFuint ib,
   DataHandle<CFreal> qz = socket_qz.getDataHandle();
   
   const CFuint startCell = (d-dStart)*nbCells;
-  for (CFuint m = 0; m < nbCells; m++) {
-    CFreal inDirDotnANeg = 0.;
-    CFreal Ic            = 0.;
-    CFreal dirDotnAPos   = 0.;
+  const vector<CFuint>& stagePtr = m_stagePtr[d-dStart];
+  const int nbThreads = static_cast<int>(getNbThreadsOMP(m_nbThreadsOMP));
+  
+  // the cells of a stage only depend on the cells of the previous stages:
+  // they can be swept in parallel
+  for (CFuint iStage = 0; iStage+1 < stagePtr.size(); ++iStage) {
+    const CFint stageStart = stagePtr[iStage];
+    const CFint stageEnd   = stagePtr[iStage+1];
+#pragma omp parallel for schedule(static) num_threads(nbThreads) if(stageEnd - stageStart > 64)
+    for (CFint m = stageStart; m < stageEnd; m++) {
+      CFreal inDirDotnANeg = 0.;
+      CFreal Ic            = 0.;
+      CFreal dirDotnAPos   = 0.;
     
-    // allocate the cell entity
-    cf_assert(startCell+m < m_advanceOrder.size());
-    const CFuint iCell = std::abs(m_advanceOrder[startCell+m]);
+      // allocate the cell entity
+      cf_assert(startCell+m < m_advanceOrder.size());
+      const CFuint iCell = std::abs(m_advanceOrder[startCell+m]);
     
-    // new algorithm (more parallelizable): opacities are computed cell by cell
-    // for a given bin
-    if (!m_oldAlgo) {getFieldOpacities(ib, iCell);} 
+      // new algorithm (more parallelizable): opacities are computed cell by cell
+      // for a given bin
+      if (!m_oldAlgo) {getFieldOpacities(ib, iCell);} 
     
-    const CFuint nbFaces = cellFaces->nbCols(iCell);
-    for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
-      const CFuint faceID = (*cellFaces)(iCell, iFace);
-      const CFreal factor = ((CFuint)(isOutward[faceID]) != iCell) ? -1. : 1.;
-      const CFreal dirDotNA = m_dotProdInFace[faceID]*factor;
+      const CFuint nbFaces = cellFaces->nbCols(iCell);
+      for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+        const CFuint faceID = (*cellFaces)(iCell, iFace);
+        const CFreal factor = ((CFuint)(isOutward[faceID]) != iCell) ? -1. : 1.;
+        const CFreal dirDotNA = m_dotProdInFace[faceID]*factor;
       
-      if (dirDotNA >= 0.){
-	dirDotnAPos += dirDotNA;
-      }
-      else {
-	const bool isBFace = m_mapGeoToTrs->isBGeo(faceID);
-	if (!isBFace){
-	  const CFuint neighborCellID = getNeighborCellID(faceID, iCell);
-	  inDirDotnANeg += m_In[neighborCellID]*dirDotNA;
-	}
-	else {
-	  const CFreal boundarySource = m_fieldSource[iCell];
-	  inDirDotnANeg += boundarySource*dirDotNA;
-	}
-      }
-    } 
-    m_In[iCell] = (m_fieldAbSrcV[iCell] - inDirDotnANeg)/(m_fieldAbV[iCell] + dirDotnAPos);
-    Ic = m_In[iCell];
+        if (dirDotNA >= 0.){
+	  dirDotnAPos += dirDotNA;
+        }
+        else {
+	  const bool isBFace = m_mapGeoToTrs->isBGeo(faceID);
+	  if (!isBFace){
+	    const CFuint neighborCellID = getNeighborCellID(faceID, iCell);
+	    inDirDotnANeg += m_In[neighborCellID]*dirDotNA;
+	  }
+	  else {
+	    const CFreal boundarySource = m_fieldSource[iCell];
+	    inDirDotnANeg += boundarySource*dirDotNA;
+	  }
+        }
+      } 
+      m_In[iCell] = (m_fieldAbSrcV[iCell] - inDirDotnANeg)/(m_fieldAbV[iCell] + dirDotnAPos);
+      Ic = m_In[iCell];
     
-    qx[iCell] += Ic*m_dirs[d*3]*m_weight[d];
-    qy[iCell] += Ic*m_dirs[d*3+1]*m_weight[d];
-    qz[iCell] += Ic*m_dirs[d*3+2]*m_weight[d];
+      qx[iCell] += Ic*m_dirs[d*3]*m_weight[d];
+      qy[iCell] += Ic*m_dirs[d*3+1]*m_weight[d];
+      qz[iCell] += Ic*m_dirs[d*3+2]*m_weight[d];
     
-    CFreal inDirDotnA = inDirDotnANeg;
-    for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
-      const CFuint faceID = (*cellFaces)(iCell, iFace);
-      const CFreal factor = ((CFuint)(isOutward[faceID]) != iCell) ? -1. : 1.;
-      const CFreal dirDotNA = m_dotProdInFace[faceID]*factor;
-      if (dirDotNA > 0.) {
-	inDirDotnA += m_In[iCell]*dirDotNA;
+      CFreal inDirDotnA = inDirDotnANeg;
+      for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+        const CFuint faceID = (*cellFaces)(iCell, iFace);
+        const CFreal factor = ((CFuint)(isOutward[faceID]) != iCell) ? -1. : 1.;
+        const CFreal dirDotNA = m_dotProdInFace[faceID]*factor;
+        if (dirDotNA > 0.) {
+	  inDirDotnA += m_In[iCell]*dirDotNA;
+        }
       }
-    }
     
-    divQ[iCell] += inDirDotnA*m_weight[d];
-    m_II[iCell] += Ic*m_weight[d];
-  }  
+      divQ[iCell] += inDirDotnA*m_weight[d];
+      m_II[iCell] += Ic*m_weight[d];
+    }
+  }
   
   CFLog(VERBOSE, "RadiativeTransferFVDOM::computeQ() in (bin, dir) = ("
 	<< ib << ", " << d << ") => end\n");
@@ -3,6 +3,8 @@
 
 ///////////////////////////////////////////////////////////////////////////
 
+#include <boost/cstdint.hpp>
+
 #include "Framework/DataProcessingData.hh"
 #include "Framework/DataSocketSink.hh"
 #include "Framework/DataSocketSource.hh"
@@ -109,6 +111,24 @@ public:
    */  
   void getAdvanceOrder(const CFuint d, CFint *const advanceOrder); 
   
+  /**
+   * Read the advance order of all the considered directions from the 
+   * "AdvanceOrderFile", if this was written for the same mesh and directions
+   * @return true if the advance order has been read
+   */  
+  bool readAdvanceOrder();
+  
+  /**
+   * Write the advance order of all the considered directions to the "AdvanceOrderFile"
+   */  
+  void writeAdvanceOrder();
+  
+  /**
+   * Compute a key identifying the mesh (face normals and connectivity)
+   * and the directions for which the advance order is computed
+   */  
+  boost::uint64_t computeAdvanceOrderKey();
+  
   /**
    * Compute the advance order depending on the option selected 
    */  
@@ -391,6 +411,10 @@ protected: //data
   /// then cells (3,4,8) can be done; finally cells (6,7) can be done to complete the sweep in direction 1.
   Framework::LocalArray<CFint>::TYPE m_advanceOrder;
   
+  /// start of each stage (and end of the last one) in the advance order
+  /// of each considered direction
+  std::vector<std::vector<CFuint> > m_stagePtr;
+  
   /// Radial average of q vector for a Sphere
   RealVector m_qrAv;
   
@@ -506,6 +530,12 @@ protected: //data
   /// name of the radiation namespace
   std::string m_radNamespace;
   
+  /// number of OpenMP threads sweeping the cells of a stage
+  CFuint m_nbThreadsOMP;
+  
+  /// name of the file where the advance order is cached
+  std::string m_advanceOrderFile;
+  
 }; // end of class RadiativeTransferFVDOM
       
 //////////////////////////////////////////////////////////////////////////////
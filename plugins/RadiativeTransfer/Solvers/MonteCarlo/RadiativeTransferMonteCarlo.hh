@@ -42,6 +42,7 @@
 #include "FiniteVolume/CellCenterFVM.hh"
 #include "MathTools/MathFunctions.hh"
 #include "Common/MPI/MPIStructDef.hh"
+#include "Common/OMPHelper.hh"
 #include "Framework/SocketBundleSetter.hh"
 #include "LagrangianSolver/ParallelVector/ParallelVector.hh"
 
@@ -119,6 +120,61 @@ public:
 
 private:
   
+  /// Data of one photon tracer: each thread traces its photons with its own
+  /// Lagrangian solver, random numbers, temporary arrays and tallies.
+  /// The current cell and the random numbers of the radiation physics are 
+  /// kept per thread by the RadiationPhysicsHandler.
+  struct TracerData {
+    
+    TracerData() : id(0), lagrangianSolver(CFNULL) {}
+    
+    /// index of the tracer (the chunk it traces), which selects its current 
+    /// cell/wall and random number generators in the radiation library
+    CFuint id;
+    
+    /// Lagrangian solver tracking the photons
+    LagrangianSolver::LagrangianSolver<PhotonData, PARTICLE_TRACKING>* lagrangianSolver;
+    
+    /// random number generator
+    RandomNumberGenerator rand;
+    
+    /// temporary array for direction
+    RealVector direction;
+    
+    /// temporary array for entry direction
+    RealVector entryDirection;
+    
+    /// temporary array for exit direction
+    RealVector exitDirection;
+    
+    /// temporary array for position
+    RealVector position;
+    
+    /// temporary array for normal
+    RealVector normal;
+    
+    /// temporary array for face normal in 3D
+    RealVector faceNormal3;
+    
+    /// temporary array for cartesian position in 3D
+    RealVector cartPosition3;
+    
+    /// temporary array for parametric coordinate in 3D
+    RealVector sOut3;
+    
+    /// radiative power absorbed by each cell
+    std::vector<CFreal> stateInRadPowers;
+    
+    /// radiative power absorbed by each wall ghost state
+    std::vector<CFreal> ghostStateInRadPowers;
+    
+    /// photons leaving the partition
+    std::vector<Photon> sendPhotons;
+    
+    /// partition face crossed by each photon in sendPhotons
+    std::vector<CFuint> sendFaceIDs;
+  };
+  
   /**
    * MonteCarlo
    */
@@ -127,7 +183,7 @@ private:
   /**
    * ray tracing
    */
-  CFuint rayTracing(Photon& photon);
+  CFuint rayTracing(Photon& photon, TracerData& tracer);
   
   /**
    * build vector of radiative heat source along a single radius in the middle of the cilinder
@@ -147,7 +203,30 @@ private:
   /// Compute cell rays
   void computePhotons();
   
-  bool getCellPhotonData(Photon& ray);
+  /// Trace one chunk of the photons emitted and received in the current cycle
+  /// @param iChunk  index of the chunk, which is also the index of the tracer
+  void tracePhotons(const CFuint iChunk, std::vector<Photon>& photonStack);
+  
+  /// Allocate the data of each tracer
+  void setupTracers(Framework::SocketBundle& sockets);
+  
+  /// Delete the data of each tracer
+  void clearTracers();
+  
+  /// Add the tallies of all the tracers to the absorbed powers, in the
+  /// order of the tracers
+  void reduceTallies();
+  
+  /// Pick the cell emitting the next photon
+  /// @return false if all the cell photons have been emitted
+  bool nextCellPhoton(CFuint& stateID);
+  
+  /// Pick the wall face emitting the next photon
+  /// @return false if all the wall photons have been emitted
+  bool nextFacePhoton(CFuint& gStateID);
+  
+  /// Emit a photon from the given cell
+  void getCellPhotonData(const CFuint stateID, Photon& ray, TracerData& tracer);
 
 private: 
 
@@ -192,29 +271,17 @@ private:
   /// pointer to the RadiationPhysicsHandler
   Common::SharedPtr<RadiationPhysicsHandler> m_radiation;
   
-  /// temporary array for direction
-  RealVector m_direction;
-  
-  /// temporary array for entry direction
-  RealVector m_entryDirection;
-  
-  /// temporary array for exit direction
-  RealVector m_exitDirection;
-  
-  /// temporary array for position
-  RealVector m_position;
-
-  /// temporary array for normal
-  RealVector m_normal;
+  /// data of each photon tracer (one per thread)
+  std::vector<TracerData*> m_tracers;
   
-  /// temporary array for face normal in 3D
-  RealVector m_faceNormal3;
+  /// cells emitting the photons of the current cycle
+  std::vector<CFuint> m_cellEmitters;
   
-  /// temporary array for cartesian position in 3D
-  RealVector m_cartPosition3;
+  /// wall ghost states emitting the photons of the current cycle
+  std::vector<CFuint> m_wallEmitters;
   
-  /// temporary array for parametric coordinate in 3D
-  RealVector m_sOut3;
+  /// number of threads tracing the photons
+  CFuint m_nbThreadsOMP;
   
   /// number of dimension
   CFuint m_dim;
@@ -253,8 +320,6 @@ private:
   /// True if it is an axisymmetric simulation
   bool m_isAxi;
   
-  RandomNumberGenerator m_rand;
-
   CFuint m_sendBufferSize;
 
   RealVector m_ghostStateInRadPowers;
@@ -283,7 +348,11 @@ private:
 
   CFreal m_relaxationFactor;
 
-  bool getFacePhotonData(Photon &ray);
+  /// seed of the random number generators
+  CFuint m_seed;
+
+  /// Emit a photon from the wall face of the given ghost state
+  void getFacePhotonData(const CFuint gStateID, Photon &ray, TracerData& tracer);
 }; // end of class RadiativeTransferMonteCarlo
 
 //////////////////////////////////////////////////////////////////////////////
@@ -302,6 +371,10 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::defineConfigOptions
   options.addConfigOption< CFuint >("sendBufferSize","Size of the buffer for communication");
   options.addConfigOption< CFuint >("nbRaysCycle","Number of rays to emit before communication step");
   options.addConfigOption< CFreal >("relaxationFactor","Relaxation Factor");
+  options.addConfigOption< CFuint >
+    ("Seed","Seed of the random number generators (0 = based on the time). A given seed makes the run reproducible for a given number of processors and threads.");
+  options.addConfigOption< CFuint >
+    ("NbThreadsOMP","Number of OMP threads tracing the photons in each processor (0 = all available).");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -324,14 +397,9 @@ RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::RadiativeTransferMonteCarlo
   socket_isOutward("isOutward"),
   socket_faceCenters("faceCenters"),
   m_radiation(new RadiationPhysicsHandler("RadiationPhysicsHandler")),
-  m_direction(),
-  m_entryDirection(),
-  m_exitDirection(),
-  m_position(),
-  m_normal(),
-  m_faceNormal3(),
-  m_cartPosition3(),
-  m_sOut3()
+  m_tracers(),
+  m_cellEmitters(),
+  m_wallEmitters()
 {
   using namespace std;
   using namespace COOLFluiD::Framework;
@@ -359,6 +427,12 @@ RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::RadiativeTransferMonteCarlo
 
   m_relaxationFactor = 1.;
   setParameter("relaxationFactor", &m_relaxationFactor);
+  
+  m_seed = 0;
+  setParameter("Seed", &m_seed);
+  
+  m_nbThreadsOMP = 1;
+  setParameter("NbThreadsOMP", &m_nbThreadsOMP);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -366,6 +440,7 @@ RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::RadiativeTransferMonteCarlo
 template<class PARTICLE_TRACKING>
 RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::~RadiativeTransferMonteCarlo()
 {
+  clearTracers();
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -456,15 +531,6 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::setup()
   sockets.faceCenters = socket_faceCenters;
   sockets.faceAreas   = socket_faceAreas;
 
-  m_direction.resize(m_dim2);
-  m_entryDirection.resize(m_dim2);
-  m_exitDirection.resize(m_dim2);
-  m_position.resize(m_dim2);
-  m_normal.resize(m_dim2);
-  m_faceNormal3.resize(3);
-  m_cartPosition3.resize(3);
-  m_sOut3.resize(3);
-  
   m_stateRadPower.setDataSockets(sockets);
   m_stateInRadPowers.setDataSockets(sockets);
   
@@ -525,6 +591,84 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::setup()
     nbFaces += WallFaces->getLocalNbGeoEnts();
   }
   socket_qradFluxWall.getDataHandle().resize(nbFaces);
+  
+  setupTracers(sockets);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+template<class PARTICLE_TRACKING>
+void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::setupTracers
+(Framework::SocketBundle& sockets)
+{
+  using namespace COOLFluiD::Common;
+  
+  clearTracers();
+  
+  const CFuint nbThreads = getNbThreadsOMP(m_nbThreadsOMP);
+  m_radiation->setNbTracers(nbThreads);
+  
+  m_tracers.resize(nbThreads);
+  for (CFuint i = 0; i < nbThreads; ++i) {
+    m_tracers[i] = new TracerData();
+    TracerData& tracer = *m_tracers[i];
+    tracer.id = i;
+    
+    // the first tracer uses the solver that communicates the photons
+    if (i == 0) {
+      tracer.lagrangianSolver = &m_lagrangianSolver;
+    }
+    else {
+      tracer.lagrangianSolver = 
+	new LagrangianSolver::LagrangianSolver<PhotonData, PARTICLE_TRACKING>(getName());
+      tracer.lagrangianSolver->setDataSockets(sockets);
+      tracer.lagrangianSolver->setFaceTypes(m_lagrangianSolver);
+    }
+    
+    tracer.direction.resize(m_dim2);
+    tracer.entryDirection.resize(m_dim2);
+    tracer.exitDirection.resize(m_dim2);
+    tracer.position.resize(m_dim2);
+    tracer.normal.resize(m_dim2);
+    tracer.faceNormal3.resize(3);
+    tracer.cartPosition3.resize(3);
+    tracer.sOut3.resize(3);
+    
+    tracer.stateInRadPowers.resize(m_stateInRadPowers.size(), 0.);
+    tracer.ghostStateInRadPowers.resize(m_ghostStateInRadPowers.size(), 0.);
+  }
+  
+  CFLog(INFO, "RadiativeTransferMonteCarlo::setup() => " << nbThreads << " thread(s) tracing the photons\n");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+template<class PARTICLE_TRACKING>
+void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::clearTracers()
+{
+  for (CFuint i = 0; i < m_tracers.size(); ++i) {
+    if (i > 0) {
+      deletePtr(m_tracers[i]->lagrangianSolver);
+    }
+    deletePtr(m_tracers[i]);
+  }
+  m_tracers.clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+template<class PARTICLE_TRACKING>
+void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::reduceTallies()
+{
+  for (CFuint t = 0; t < m_tracers.size(); ++t) {
+    const TracerData& tracer = *m_tracers[t];
+    for (CFuint i = 0; i < tracer.stateInRadPowers.size(); ++i) {
+      m_stateInRadPowers[i] += tracer.stateInRadPowers[i];
+    }
+    for (CFuint i = 0; i < tracer.ghostStateInRadPowers.size(); ++i) {
+      m_ghostStateInRadPowers[i] += tracer.ghostStateInRadPowers[i];
+    }
+  }
 }
    
 /////////////////////////////////////////////////////////////////////////////
@@ -586,7 +730,7 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getTotalEnergy()
     if ( !m_radiation->isStateNull(state) ){
       //cout<<"is not ghost!"<<endl;
       m_stateRadPower[state]= m_radiation->getCellDistPtr(state)
-	->getRadiatorPtr()->getSpectraLoopPower();
+	->getRadiatorPtr()->getSpectraLoopPower(0);
       stateRadPower += m_stateRadPower[state];
       //cout<<"state radPower: "<<m_stateRadPower[state]<<endl;
       //cout<<"THE OTER: m_axi Volume: "<<m_axiVolumes[i]<<endl;
@@ -603,7 +747,7 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getTotalEnergy()
   for(CFuint gstate=0; gstate<nbGhostStates; ++gstate){
     if ( !m_radiation->isGhostStateNull(gstate) ){
       m_ghostStateRadPower[gstate]= m_radiation->getWallDistPtr(gstate)
-	->getRadiatorPtr()->getSpectraLoopPower();
+	->getRadiatorPtr()->getSpectraLoopPower(0);
       //cout<<"gstate radPower: "<<m_ghostStateRadPower[gstate]<<endl;
       
       gStateRadPower += m_ghostStateRadPower[gstate];
@@ -635,68 +779,12 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getTotalEnergy()
 /////////////////////////////////////////////////////////////////////////////
 
 template<class PARTICLE_TRACKING>
-bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getCellPhotonData(Photon &ray)
+bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::nextCellPhoton(CFuint& stateID)
 {
-  using namespace std;
-  using namespace COOLFluiD::Framework;
-  using namespace COOLFluiD::MathTools;
-  using namespace COOLFluiD::Common;
-  using namespace COOLFluiD::Numerics::FiniteVolume;
-  using namespace COOLFluiD::LagrangianSolver;
-  
-  //static CellTrsGeoBuilder::GeoData& cellData = m_cellBuilder.getDataGE();
   const CFuint nbStates = m_nbPhotonsState.size();
-  
   for(;m_istate_cell_fix<nbStates; ++m_istate_cell_fix) {
-    for(;m_iphoton_cell_fix<m_nbPhotonsState[ m_istate_cell_fix ];) {
-      //        cout<<"m_nbPhotonsState[state]: "<<m_nbPhotonsState[state]<<' '<<";state: "<<state<<endl;
-      //        cout<<"photon: "<<photon<<endl;
-      
-      //cellData.idx =  state;
-      
-      //cellData.idx = 50;
-      //GeometricEntity *const cell = m_cellBuilder.buildGE();
-      //if( cell->getState(0)->isParUpdatable() ){
-      // Calculate the wavelength
-      //cout<<"wavelength= "<<ray.userData.wavelength<<endl;
-      
-      //Get directions
-      m_radiation->getCellDistPtr( m_istate_cell_fix )->
-	getRadiatorPtr()->getRandomEmission(ray.userData.wavelength, m_direction );
-      
-      //cout<<"ray directions: ";
-      for(CFuint ii=0; ii<m_dim2; ++ii){
-	ray.commonData.direction[ii]=m_direction[ii];
-      }
-      //cout<<endl;
-      
-      //Get the beam max optical path Ks
-      ray.userData.KS = - std::log( m_rand.uniformRand() );
-      // ray.actualKS = 0;
-      //  cout<<"getCellcenter"<<endl;
-      //Get cell center
-      static Framework::DataHandle<Framework::State*, Framework::GLOBAL> states
-	= socket_states.getDataHandle();
-      
-      Node& baricenter = (*states[ m_istate_cell_fix ]).getCoordinates();
-      
-      for(CFuint i=0;i<m_dim;++i){
-	//  cout<<baricenter[i]<<' ';
-	ray.commonData.currentPoint[i]=baricenter[i];
-      }
-      for(CFuint i=m_dim;i<m_dim2;++i){
-	//  cout<<baricenter[i]<<' ';
-	ray.commonData.currentPoint[i] = 0.;
-      }
-      
-      //Get the remaining information
-      //const CFuint cellID = cell->getID();
-      CFuint cellID = m_radiation->getCurrentCellStateID();
-      ray.commonData.cellID = cellID;
-      
-      ray.userData.energyFraction= m_stateRadPower[ m_istate_cell_fix ]/CFreal(m_nbPhotonsState[ m_istate_cell_fix ]);
-      
-      //m_cellBuilder.releaseGE();
+    if (m_iphoton_cell_fix<m_nbPhotonsState[ m_istate_cell_fix ]) {
+      stateID = m_istate_cell_fix;
       ++m_iphoton_cell_fix;
       return true;
     }
@@ -708,103 +796,12 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getCellPhotonData(Photon &r
 /////////////////////////////////////////////////////////////////////////////
 
 template<class PARTICLE_TRACKING>
-bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getFacePhotonData(Photon &ray)
+bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::nextFacePhoton(CFuint& gStateID)
 {
-  using namespace std;
-  using namespace COOLFluiD::Framework;
-  using namespace COOLFluiD::MathTools;
-  using namespace COOLFluiD::Common;
-  using namespace COOLFluiD::Numerics::FiniteVolume;
-  using namespace COOLFluiD::LagrangianSolver;
-  
-  //static CellTrsGeoBuilder::GeoData& cellData = m_cellBuilder.getDataGE();
-  //m_ photon=0, gState=0;
   const CFuint nbGstates = m_nbPhotonsGhostState.size();
-
-  for( ; m_igState_face_fix < nbGstates ; ++ m_igState_face_fix)
-  {
-    for( ; m_iphoton_face_fix < m_nbPhotonsGhostState[ m_igState_face_fix  ]; )
-    {
-      //Get directions
-      m_radiation->getWallDistPtr( m_igState_face_fix )->
-	getRadiatorPtr()->getRandomEmission(ray.userData.wavelength, m_direction );
-      
-      const CFuint faceGeoID = m_radiation->getCurrentWallGeoID();
-      const CFuint cellID = m_lagrangianSolver.getWallStateId( faceGeoID );
-      
-      static Framework::DataHandle<Framework::State*, Framework::GLOBAL> states
-	= socket_states.getDataHandle();
-      
-      Node& cellCenter = (*states[cellID]).getCoordinates();
-      
-      //cout<<"direction = [";
-      for(CFuint ii=0; ii<m_dim; ++ii){
-	//    cout<< -directions[ii] << ' ';
-        ray.commonData.direction[ii]= m_direction[ii];
-      }
-      //cout<<" ]; "<<endl;
-      
-      //Get the beam max optical path Ks
-      ray.userData.KS = - std::log( m_rand.uniformRand() );
-      // ray.actualKS = 0;
-
-      //Get the face center
-      DataHandle<CFreal> faceCenters = socket_faceCenters.getDataHandle();
-
-      //cout<<"baricenter= [ ";
-
-      //cout<<" ]; "<<endl;
-
-      m_cartPosition3[0] = ray.commonData.currentPoint[0];
-      m_cartPosition3[1] = ray.commonData.currentPoint[1];
-      m_cartPosition3[2] = ray.commonData.currentPoint[2];
-      
-      m_lagrangianSolver.getNormals(faceGeoID, m_cartPosition3, m_faceNormal3);
-      
-      // small correction to make sure the initial point is inside the cell
-      // move the initial point 1% closer to the cell center
-      CFreal tCenter = 0.;
-      for(CFuint i=0;i<m_dim;++i){
-	tCenter += m_faceNormal3[i] * (faceCenters[i] - cellCenter[i]);
-      }
-      
-      for(CFuint i=0;i<m_dim;++i){
-        //cout<<faceCenters[m_dim * faceGeoID + i]<<' ';
-	ray.commonData.currentPoint[i]=faceCenters[m_dim * faceGeoID + i] + 
-	  .01 * m_faceNormal3[i]*tCenter;
-      }
-      
-      //cout<<"normal= [" << m_faceNormal3 <<" ]; "<<endl;
-      
-      if (m_isAxi) {
-	//rotate the position and vector to a random theta
-	const CFreal theta = m_rand.uniformRand(-3.141516, 3.141516);
-	const CFreal x = ray.commonData.currentPoint[0];
-	const CFreal y = ray.commonData.currentPoint[1];
-	
-	ray.commonData.currentPoint[0] = x;
-	ray.commonData.currentPoint[1] = y*std::cos(theta);
-	ray.commonData.currentPoint[2] = y*std::sin(theta);
-	
-	m_cartPosition3[0] = ray.commonData.currentPoint[0];
-	m_cartPosition3[1] = ray.commonData.currentPoint[1];
-	m_cartPosition3[2] = ray.commonData.currentPoint[2];
-	
-	m_lagrangianSolver.getNormals(faceGeoID, m_cartPosition3, m_faceNormal3);
-	
-	m_rand.hemiDirections(3, m_faceNormal3, m_sOut3);
-	
-	ray.commonData.direction[0] = m_sOut3[0];
-	ray.commonData.direction[1] = m_sOut3[1];
-	ray.commonData.direction[2] = m_sOut3[2];
-      }
-      
-      //Get the remaining information
-      ray.commonData.cellID = cellID;
-      
-      ray.userData.energyFraction= m_ghostStateRadPower[m_igState_face_fix]/
-	CFreal(m_nbPhotonsGhostState[m_igState_face_fix]);
-      
+  for( ; m_igState_face_fix < nbGstates ; ++ m_igState_face_fix) {
+    if (m_iphoton_face_fix < m_nbPhotonsGhostState[ m_igState_face_fix ]) {
+      gStateID = m_igState_face_fix;
       ++m_iphoton_face_fix;
       return true;
     }
@@ -812,6 +809,125 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getFacePhotonData(Photon &r
   }
   return false;
 }
+  
+/////////////////////////////////////////////////////////////////////////////
+
+template<class PARTICLE_TRACKING>
+void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getCellPhotonData
+(const CFuint stateID, Photon &ray, TracerData& tracer)
+{
+  using namespace std;
+  using namespace COOLFluiD::Framework;
+  
+  //Get directions
+  m_radiation->getCellDistPtr( stateID, tracer.id )->
+    getRadiatorPtr()->getRandomEmission(ray.userData.wavelength, tracer.direction, tracer.id );
+  
+  for(CFuint ii=0; ii<m_dim2; ++ii){
+    ray.commonData.direction[ii]=tracer.direction[ii];
+  }
+  
+  //Get the beam max optical path Ks
+  ray.userData.KS = - std::log( tracer.rand.uniformRand() );
+  
+  //Get cell center
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  Node& baricenter = (*states[ stateID ]).getCoordinates();
+  
+  for(CFuint i=0;i<m_dim;++i){
+    ray.commonData.currentPoint[i]=baricenter[i];
+  }
+  for(CFuint i=m_dim;i<m_dim2;++i){
+    ray.commonData.currentPoint[i] = 0.;
+  }
+  
+  //Get the remaining information
+  ray.commonData.cellID = m_radiation->getCurrentCellStateID(tracer.id);
+  
+  ray.userData.energyFraction= m_stateRadPower[ stateID ]/CFreal(m_nbPhotonsState[ stateID ]);
+}
+  
+/////////////////////////////////////////////////////////////////////////////
+
+template<class PARTICLE_TRACKING>
+void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getFacePhotonData
+(const CFuint gStateID, Photon &ray, TracerData& tracer)
+{
+  using namespace std;
+  using namespace COOLFluiD::Framework;
+  
+  LagrangianSolver::LagrangianSolver<PhotonData, PARTICLE_TRACKING>& lagrangianSolver = 
+    *tracer.lagrangianSolver;
+  
+  //Get directions
+  m_radiation->getWallDistPtr( gStateID, tracer.id )->
+    getRadiatorPtr()->getRandomEmission(ray.userData.wavelength, tracer.direction, tracer.id );
+  
+  const CFuint faceGeoID = m_radiation->getCurrentWallGeoID(tracer.id);
+  const CFuint cellID = lagrangianSolver.getWallStateId( faceGeoID );
+  
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  Node& cellCenter = (*states[cellID]).getCoordinates();
+  
+  for(CFuint ii=0; ii<m_dim; ++ii){
+    ray.commonData.direction[ii]= tracer.direction[ii];
+  }
+  
+  //Get the beam max optical path Ks
+  ray.userData.KS = - std::log( tracer.rand.uniformRand() );
+  
+  //Get the face center
+  DataHandle<CFreal> faceCenters = socket_faceCenters.getDataHandle();
+  
+  // the normal is evaluated at the face center
+  tracer.cartPosition3 = 0.;
+  for(CFuint i=0;i<m_dim;++i){
+    tracer.cartPosition3[i] = faceCenters[m_dim * faceGeoID + i];
+  }
+  
+  lagrangianSolver.getNormals(faceGeoID, tracer.cartPosition3, tracer.faceNormal3);
+  
+  // small correction to make sure the initial point is inside the cell
+  // move the initial point 1% closer to the cell center
+  CFreal tCenter = 0.;
+  for(CFuint i=0;i<m_dim;++i){
+    tCenter += tracer.faceNormal3[i] * (faceCenters[i] - cellCenter[i]);
+  }
+  
+  for(CFuint i=0;i<m_dim;++i){
+    ray.commonData.currentPoint[i]=faceCenters[m_dim * faceGeoID + i] + 
+      .01 * tracer.faceNormal3[i]*tCenter;
+  }
+  
+  if (m_isAxi) {
+    //rotate the position and vector to a random theta
+    const CFreal theta = tracer.rand.uniformRand(-3.141516, 3.141516);
+    const CFreal x = ray.commonData.currentPoint[0];
+    const CFreal y = ray.commonData.currentPoint[1];
+    
+    ray.commonData.currentPoint[0] = x;
+    ray.commonData.currentPoint[1] = y*std::cos(theta);
+    ray.commonData.currentPoint[2] = y*std::sin(theta);
+    
+    tracer.cartPosition3[0] = ray.commonData.currentPoint[0];
+    tracer.cartPosition3[1] = ray.commonData.currentPoint[1];
+    tracer.cartPosition3[2] = ray.commonData.currentPoint[2];
+    
+    lagrangianSolver.getNormals(faceGeoID, tracer.cartPosition3, tracer.faceNormal3);
+    
+    tracer.rand.hemiDirections(3, tracer.faceNormal3, tracer.sOut3);
+    
+    ray.commonData.direction[0] = tracer.sOut3[0];
+    ray.commonData.direction[1] = tracer.sOut3[1];
+    ray.commonData.direction[2] = tracer.sOut3[2];
+  }
+  
+  //Get the remaining information
+  ray.commonData.cellID = cellID;
+  
+  ray.userData.energyFraction= m_ghostStateRadPower[gStateID]/
+    CFreal(m_nbPhotonsGhostState[gStateID]);
+}
 
 /////////////////////////////////////////////////////////////////////////////
 
@@ -827,8 +943,6 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
     
   CFLog(DEBUG_MAX, "RadiativeTransferMonteCarlo::computeCellRays()\n");
   
-  m_rand.seed(time(NULL)*(m_myProcessRank+1));
-
 
   // CFuint totalnbPhotons =  (m_nbRaysElem )* m_radiation->getNbStates();
 
@@ -848,59 +962,61 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
   CFuint recvSize = 0;
   bool done = false;
 
-  Photon photon;
   CFuint totalnbPhotons = toGenerateWallPhotons + toGenerateCellPhotons;
   boost::progress_display* progressBar = NULL;
   if (m_myProcessRank == 0) progressBar = new boost::progress_display(totalnbPhotons);
 
-  //CFuint toGeneratePhotons = totalnbPhotons;
-
-  // Stopwatch<WallTime> s;
-  //s.restart();
-
+  const CFint nbChunks = static_cast<CFint>(m_tracers.size());
   vector< Photon > photonStack;
   photonStack.reserve(m_sendBufferSize);
   while( !done ){
     recvSize = photonStack.size();
-    //generate and raytrace the inner photons
     
-
     CFuint nbCellPhotons =
         std::min(std::max(CFint(m_nbRaysCycle) - CFint(recvSize),(CFint)0), CFint(toGenerateCellPhotons) );
 
     CFuint nbWallPhotons =
         std::min(std::max(CFint(m_nbRaysCycle) - CFint(recvSize) - CFint(nbCellPhotons),(CFint)0), CFint(toGenerateWallPhotons ));
-
+    
+    // the emitters are picked in the same order for any number of threads
+    m_cellEmitters.clear();
     for(CFuint i=0; i < nbCellPhotons ; ++i ){
-       
-      if(getCellPhotonData( photon )){
-        //CFLog(INFO,"PHOTON: " << photon.cellID<<' '<<photon.userData.KS<<'\n' );
-        //printPhoton(photon);
-        rayTracing(photon);
+      CFuint stateID = 0;
+      if (nextCellPhoton(stateID)) {
+	m_cellEmitters.push_back(stateID);
       }
       --toGenerateCellPhotons;
-      if (m_myProcessRank == 0)  ++*(progressBar);
     }
-
+    
+    m_wallEmitters.clear();
     for(CFuint i=0; i < nbWallPhotons ; ++i ){
-      if(getFacePhotonData( photon )){
-	//printPhoton(photon);
-        rayTracing(photon);
+      CFuint gStateID = 0;
+      if (nextFacePhoton(gStateID)) {
+	m_wallEmitters.push_back(gStateID);
       }
       -- toGenerateWallPhotons;
-      if (m_myProcessRank == 0)  ++*(progressBar);
     }
-
-//    CFLog(INFO, "raytrace the outer photons \n");
-    for(CFuint i = 0; i< photonStack.size(); ++i ){
-      //photon=photonStack[i];
-      //CFLog(INFO,"PHOTON: " << photon.cellID<<' '<<photon.userData.KS<<'\n' );
-      //printPhoton(photonStack[i]);
-      rayTracing( photonStack[i] );
+    
+    // each tracer takes a contiguous chunk of the new and of the received 
+    // photons: the split only depends on the number of threads, so that a 
+    // run is reproducible for a given seed and number of threads
+#pragma omp parallel for schedule(static,1) num_threads(m_tracers.size())
+    for (CFint iChunk = 0; iChunk < nbChunks; ++iChunk) {
+      tracePhotons(iChunk, photonStack);
     }
-
+    if (m_myProcessRank == 0) *progressBar += nbCellPhotons + nbWallPhotons;
+    
+    // the photons leaving the partition are sent in the order of the tracers
+    for (CFuint t = 0; t < m_tracers.size(); ++t) {
+      TracerData& tracer = *m_tracers[t];
+      for (CFuint i = 0; i < tracer.sendPhotons.size(); ++i) {
+	m_lagrangianSolver.bufferCommitParticle(tracer.sendPhotons[i], tracer.sendFaceIDs[i]);
+      }
+      tracer.sendPhotons.clear();
+      tracer.sendFaceIDs.clear();
+    }
+    
     //sincronize
-    //      CFLog(INFO, "sincronizing\n");
     bool isLastPhoton = (toGenerateCellPhotons + toGenerateWallPhotons == 0);
     done = m_lagrangianSolver.sincronizeParticles(photonStack, isLastPhoton);
 
@@ -908,8 +1024,38 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
     CFLog(VERBOSE,"Number of photons left: "<< toGenerateCellPhotons <<"\n");
   }
   delete progressBar;
+}
+
+/////////////////////////////////////////////////////////////////////////////
 
-  //CFLog(INFO,"Raytracing took "<<s.readTimeHMS().str()<<'\n');
+template<class PARTICLE_TRACKING>
+void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::tracePhotons
+(const CFuint iChunk, std::vector<Photon>& photonStack)
+{
+  using namespace COOLFluiD::Common;
+  
+  TracerData& tracer = *m_tracers[iChunk];
+  const CFuint nbChunks = m_tracers.size();
+  Photon photon;
+  CFuint start = 0;
+  CFuint end = 0;
+  
+  getChunkOMP(m_cellEmitters.size(), nbChunks, iChunk, start, end);
+  for (CFuint i = start; i < end; ++i) {
+    getCellPhotonData(m_cellEmitters[i], photon, tracer);
+    rayTracing(photon, tracer);
+  }
+  
+  getChunkOMP(m_wallEmitters.size(), nbChunks, iChunk, start, end);
+  for (CFuint i = start; i < end; ++i) {
+    getFacePhotonData(m_wallEmitters[i], photon, tracer);
+    rayTracing(photon, tracer);
+  }
+  
+  getChunkOMP(photonStack.size(), nbChunks, iChunk, start, end);
+  for (CFuint i = start; i < end; ++i) {
+    rayTracing(photonStack[i], tracer);
+  }
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -957,18 +1103,37 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::MonteCarlo()
   m_iphoton_cell_fix=0, m_istate_cell_fix=0;
   m_iphoton_face_fix=0, m_igState_face_fix=0;
   
+  // seed all the generators once per execution, each one with its own 
+  // stream, so that ranks, threads, radiators and reflectors draw 
+  // independent samples
+  const CFuint seedNumber = (m_seed > 0) ? m_seed : CFuint(time(NULL));
+  const CFuint nbThreadStreams = 1 + m_radiation->getNbRandomStreams();
+  const CFuint nbStreams = m_tracers.size()*nbThreadStreams;
+  for (CFuint t = 0; t < m_tracers.size(); ++t) {
+    TracerData& tracer = *m_tracers[t];
+    const CFuint streamID = m_myProcessRank*nbStreams + t*nbThreadStreams;
+    tracer.rand.seed(seedNumber, streamID);
+    m_radiation->seedRandom(seedNumber, streamID + 1, t);
+    
+    tracer.stateInRadPowers.assign(tracer.stateInRadPowers.size(), 0.);
+    tracer.ghostStateInRadPowers.assign(tracer.ghostStateInRadPowers.size(), 0.);
+  }
+  
   for(CFuint i=0; i< nbLoops; ++i){
     m_radiation->setupWavStride(i);
     getTotalEnergy();
     
     computePhotons();
   }
+  
+  reduceTallies();
 }
   
 /////////////////////////////////////////////////////////////////////////////
 
 template<class PARTICLE_TRACKING>
-CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
+CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing
+(Photon& beam, TracerData& tracer)
 {
   using namespace std;
   using namespace COOLFluiD::Framework;
@@ -985,12 +1150,14 @@ CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
   
   CFLog(DEBUG_MED, "RadiativeTransferMonteCarlo::rayTracing() => START\n");
   
-  m_lagrangianSolver.newParticle(beam);
+  COOLFluiD::LagrangianSolver::LagrangianSolver<PhotonData, PARTICLE_TRACKING>& lagrangianSolver = 
+    *tracer.lagrangianSolver;
+  lagrangianSolver.newParticle(beam);
   
   CFLog(DEBUG_MED, "RadiativeTransferMonteCarlo::rayTracing() => particle ID: "<<beam.commonData.cellID<< "\n");
   
-  PhotonData &beamData = m_lagrangianSolver.getUserDataPtr();
-  exitCellID=m_lagrangianSolver.getExitCellID();
+  PhotonData &beamData = lagrangianSolver.getUserDataPtr();
+  exitCellID=lagrangianSolver.getExitCellID();
   
   //bool foundEntity = false;
   //cout<<"Start K= "<<previousK<<endl;
@@ -1005,18 +1172,18 @@ CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
     
     currentCellID = exitCellID;
 
-    m_lagrangianSolver.trackingStep();
-    exitFaceID=m_lagrangianSolver.getExitFaceID();
-    exitCellID=m_lagrangianSolver.getExitCellID();
+    lagrangianSolver.trackingStep();
+    exitFaceID=lagrangianSolver.getExitFaceID();
+    exitCellID=lagrangianSolver.getExitCellID();
 
     if(exitFaceID>=0){
 
-      const CFreal stepDistance=m_lagrangianSolver.getStepDistance();
+      const CFreal stepDistance=lagrangianSolver.getStepDistance();
       RealVector null;
       
       //CFLog(INFO, "Absorption IN!\n");
-      const CFreal cellK= m_radiation->getCellDistPtr(currentCellID)
-          ->getRadiatorPtr()->getAbsorption(beamData.wavelength, null);
+      const CFreal cellK= m_radiation->getCellDistPtr(currentCellID, tracer.id)
+          ->getRadiatorPtr()->getAbsorption(beamData.wavelength, null, tracer.id);
 
       //CFLog(INFO, "Absorption OUT!\n");
 
@@ -1036,54 +1203,54 @@ CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
         //        cout<<"sizeBuffer: "<< m_gInRadPowers.size()<<endl;
         //add directly to the in Rad Heat Power vector
         //cout<<"energy added : "<<energyFraction<<endl;
-        cf_assert(gEndId < m_stateInRadPowers.size());
-        m_stateInRadPowers[gEndId]+=energyFraction;
+        cf_assert(gEndId < tracer.stateInRadPowers.size());
+        tracer.stateInRadPowers[gEndId]+=energyFraction;
         //cout<<"new energy: "<<m_gInRadPowers[gEndId]<<endl;
         //foundEntity = true;
         return currentCellID;
       }
 
-      const CFuint faceType = m_lagrangianSolver.getFaceType(exitFaceID);
+      const CFuint faceType = lagrangianSolver.getFaceType(exitFaceID);
       
       if ( faceType == ParticleTracking::WALL_FACE){
         //CFLog(INFO,"HERE WALL !!\n");
         CommonData beam2;
-        m_lagrangianSolver.getCommonData(beam2);
+        lagrangianSolver.getCommonData(beam2);
         for(CFuint i=0; i < m_dim2; ++i){
-          m_entryDirection[i]= beam2.direction[i];
+          tracer.entryDirection[i]= beam2.direction[i];
         }
 	
-        m_lagrangianSolver.getExitPoint(m_position);
+        lagrangianSolver.getExitPoint(tracer.position);
 	
-        //CFuint stateID = m_lagrangianSolver.getWallGhotsStateId(exitFaceID);
-        const CFuint ghostStateID = m_lagrangianSolver.getWallGhotsStateId(exitFaceID);
+        //CFuint stateID = lagrangianSolver.getWallGhotsStateId(exitFaceID);
+        const CFuint ghostStateID = lagrangianSolver.getWallGhotsStateId(exitFaceID);
 	
-        const CFreal wallK = m_radiation->getWallDistPtr(ghostStateID)
-            ->getRadiatorPtr()->getAbsorption( beamData.wavelength, m_entryDirection );
+        const CFreal wallK = m_radiation->getWallDistPtr(ghostStateID, tracer.id)
+            ->getRadiatorPtr()->getAbsorption( beamData.wavelength, tracer.entryDirection, tracer.id );
 	
-        m_lagrangianSolver.getNormals(exitFaceID, m_position, m_normal);
+        lagrangianSolver.getNormals(exitFaceID, tracer.position, tracer.normal);
 	
-        const CFreal reflectionProbability =  m_rand.uniformRand();
+        const CFreal reflectionProbability =  tracer.rand.uniformRand();
 	CFLog(DEBUG_MIN, "reflectionProbability[" << reflectionProbability << "] <= wallK[" 
 	      << wallK << "]\n");
 	
         if (reflectionProbability <= wallK){ // the photon is absorbed by the wall
           //cout<<"ABSORBED!"<<endl;
           //entity = WALL_FACE;
-          const CFuint ghostStateID = m_lagrangianSolver.getWallGhotsStateId(exitFaceID);
-	  m_ghostStateInRadPowers[ghostStateID] += beamData.energyFraction;
+          const CFuint ghostStateID = lagrangianSolver.getWallGhotsStateId(exitFaceID);
+	  tracer.ghostStateInRadPowers[ghostStateID] += beamData.energyFraction;
 	  CFLog(DEBUG_MIN, "Rad power in ghostStateID[" << ghostStateID << "] = " << 
-		m_ghostStateInRadPowers[ghostStateID] << "\n");
+		tracer.ghostStateInRadPowers[ghostStateID] << "\n");
 	  //foundEntity = true;
           return exitFaceID;
         }
         else {
-	  m_radiation->getWallDistPtr(ghostStateID)->getReflectorPtr()->getRandomDirection
-	    (beamData.wavelength, m_exitDirection, m_entryDirection, m_normal);
-          m_lagrangianSolver.newDirection( m_exitDirection );
+	  m_radiation->getWallDistPtr(ghostStateID, tracer.id)->getReflectorPtr()->getRandomDirection
+	    (beamData.wavelength, tracer.exitDirection, tracer.entryDirection, tracer.normal, tracer.id);
+          lagrangianSolver.newDirection( tracer.exitDirection );
 	  
-          CFLog(DEBUG_MED, "Particle reflected with Entry Direction[" << m_entryDirection 
-		<< "], Normal[ " << m_normal << "], Exit direction [" << m_exitDirection << "]\n");
+          CFLog(DEBUG_MED, "Particle reflected with Entry Direction[" << tracer.entryDirection 
+		<< "], Normal[ " << tracer.normal << "], Exit direction [" << tracer.exitDirection << "]\n");
         }
       }
 
@@ -1096,18 +1263,23 @@ CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
 
       if(faceType == ParticleTracking::COMP_DOMAIN_FACE){
       //CFLog(INFO,"HERE DOMAIN FACE!!\n");
-          m_lagrangianSolver.bufferCommitParticle(exitFaceID);
+        // sent after the threaded loop, by the first tracer
+        tracer.sendPhotons.push_back(Photon());
+        lagrangianSolver.getParticle(tracer.sendPhotons.back());
+        tracer.sendFaceIDs.push_back(exitFaceID);
         return 0;
       }
 
       nbCrossedCells++;
     }
   else{
+#pragma omp critical
     CFLog(VERBOSE, "RadiativeTransferMonteCarlo::rayTracing() => enter negligible\n");
     //entity = NEGLIGIBLE;
     return 0;
   }
   }
+#pragma omp critical
   CFLog(INFO, "RadiativeTransferMonteCarlo::rayTracing() => Max number of steps reached! \n");
   return 0;
 }
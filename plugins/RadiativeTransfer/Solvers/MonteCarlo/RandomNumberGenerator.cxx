@@ -16,5 +16,15 @@ namespace RadiativeTransfer {
   void RandomNumberGenerator::seed(CFuint seedNumber){
     m_generator.seed(seedNumber);
   }
+
+  void RandomNumberGenerator::seed(CFuint seedNumber, CFuint streamID){
+    // splitmix64 finalizer: consecutive stream IDs give unrelated seeds
+    boost::uint64_t z = (static_cast<boost::uint64_t>(seedNumber) << 32) +
+      static_cast<boost::uint64_t>(streamID) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= (z >> 31);
+    m_generator.seed(static_cast<boost::uint32_t>(z ^ (z >> 32)));
+  }
 }
 }
@@ -31,6 +31,10 @@ public:
 
   void seed(CFuint seedNumber);
 
+  /// seed the generator for one of several independent streams: generators
+  /// with the same seedNumber and different streamIDs give unrelated sequences
+  void seed(CFuint seedNumber, CFuint streamID);
+
 private:
 
   typeGenerator m_generator;
@@ -14,6 +14,8 @@
 #include "Common/ProcessInfo.hh"
 #include "Common/OSystem.hh"
 #include "Common/PE.hh"
+#include "Environment/CFEnvVars.hh"
+#include "Environment/CFEnv.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -158,8 +160,9 @@ void StdMeshReader::buildMeshData()
       DataHandle<Node*, GLOBAL> nodes =
         meshDataVector[meshDataID]->getDataStorage()->getGlobalData<Node*>(parNodeVecName);
 
-      states.buildMap ();
-      nodes.buildMap ();
+      const bool packedSync = Environment::CFEnv::getInstance().getVars()->PackedSync;
+      states.buildMap (packedSync);
+      nodes.buildMap (packedSync);
     }
 
   meshCreator[0]->unsetMethod();
@@ -30,6 +30,7 @@
 #include "Framework/PhysicalModel.hh"
 #include "Framework/ConvectiveVarSet.hh"
 #include "Framework/MethodCommandProvider.hh"
+#include "Framework/AsyncFileWriter.hh"
 #include "Framework/NamespaceSwitcher.hh"
 #include "Framework/DataHandleOutput.hh"
 #include "Framework/SubSystemStatus.hh"
@@ -93,6 +94,8 @@ void WriteSolution::execute()
     ///@todo change this to use the tecplot library
     ///this is slow and NOT portable but at least, it takes less space
     writeToFile("tmp");
+    // preplot reads the file, which may still be written in the background
+    AsyncFileWriter::getInstance().flush();
     std::string transformFile = "$TECHOME/bin/preplot tmp " + getMethodData().getFilename().string();
     CFLog(INFO, transformFile << "\n");
 
@@ -27,6 +27,7 @@
 #include "Framework/MapGeoEnt.hh"
 #include "Framework/MeshData.hh"
 #include "Framework/MethodCommandProvider.hh"
+#include "Framework/AsyncFileWriter.hh"
 // #include "Framework/SubSystemStatus.hh"
 #include "Framework/NamespaceSwitcher.hh"
 #include "Framework/PhysicalModel.hh"
@@ -92,6 +93,8 @@ void WriteSolutionHighOrder::execute()
     ///@todo change this to use the tecplot library
     ///this is slow and NOT portable but at least, it takes less space
     writeToFile("tmp");
+    // preplot reads the file, which may still be written in the background
+    AsyncFileWriter::getInstance().flush();
     std::string transformFile = "$TECHOME/bin/preplot tmp " + getMethodData().getFilename().string();
     CFLog(INFO, transformFile << "\n");
     
@@ -0,0 +1,57 @@
+#ifndef COOLFluiD_Physics_ThermoTable_hh
+#define COOLFluiD_Physics_ThermoTable_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Environment/ModuleRegister.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Physics {
+
+    /// The classes that implement a tabulated physico-chemical library.
+    namespace ThermoTable {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class defines the Module ThermoTable
+ */
+class ThermoTableModule : public Environment::ModuleRegister<ThermoTableModule> {
+public:
+
+  /**
+   * Static function that returns the module name.
+   * Must be implemented for the ModuleRegister template
+   * @return name of the module
+   */
+  static std::string getModuleName()
+  {
+    return "ThermoTable";
+  }
+
+  /**
+   * Static function that returns the description of the module.
+   * Must be implemented for the ModuleRegister template
+   * @return descripton of the module
+   */
+  static std::string getModuleDescription()
+  {
+    return "This module implements a physico-chemical library interpolating tabulated LTE properties.";
+  }
+
+}; // end ThermoTableModule
+
+//////////////////////////////////////////////////////////////////////////////
+
+    }  // namespace ThermoTable
+
+  }  // namespace Physics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Physics_ThermoTable_hh
@@ -0,0 +1,757 @@
+#include <fstream>
+
+#include "ThermoTableI/ThermoTableLibrary.hh"
+#include "ThermoTableI/ThermoTable.hh"
+#include "Common/CFLog.hh"
+#include "Common/PE.hh"
+#include "Common/HashBytes.hh"
+#include "Common/BadValueException.hh"
+#include "Common/NotImplementedException.hh"
+#include "Environment/ObjectProvider.hh"
+#include "Environment/DirPaths.hh"
+#include "Environment/Factory.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::MathTools;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Physics {
+
+    namespace ThermoTable {
+
+//////////////////////////////////////////////////////////////////////////////
+
+Environment::ObjectProvider<ThermoTableLibrary,
+			    PhysicalPropertyLibrary,
+			    ThermoTableModule,
+			    1>
+thermoTableLibraryProvider("ThermoTable");
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// version of the table format, to be increased every time the format or
+/// the tabulated quantities change
+static const boost::uint32_t THERMO_TABLE_VERSION = 1;
+
+/// header of the table file, followed by the species molar masses and by
+/// the values in the grid nodes
+struct ThermoTableHeader {
+  char magic[8];
+  boost::uint32_t version;
+  boost::uint32_t sizeOfReal;
+  boost::uint64_t key;
+  boost::uint64_t nbP;
+  boost::uint64_t nbT;
+  boost::uint64_t nbSpecies;
+  boost::uint64_t stride;
+  boost::uint64_t hasElectrons;
+  CFreal pMin;
+  CFreal pMax;
+  CFreal TMin;
+  CFreal TMax;
+  CFreal Rgas;
+};
+
+static const char THERMO_TABLE_MAGIC[8] = "CFTHERM";
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< std::string >
+    ("SourceLibrary","Name of the library computing the tabulated quantities (e.g. \"Mutationpp\").");
+  options.addConfigOption< std::string >("TableFile","Name of the table file.");
+  options.addConfigOption< bool >
+    ("RebuildTable","Build the table again even if the file matches the configuration.");
+  options.addConfigOption< std::string >
+    ("Namespace","Namespace of the processes sharing the table (the first one builds it).");
+  options.addConfigOption< CFreal >("Pmin","Minimum pressure in the table.");
+  options.addConfigOption< CFreal >("Pmax","Maximum pressure in the table.");
+  options.addConfigOption< CFuint >("NbP","Number of pressures (logarithmically spaced) in the table.");
+  options.addConfigOption< CFreal >("Tmin","Minimum temperature in the table.");
+  options.addConfigOption< CFreal >("Tmax","Maximum temperature in the table.");
+  options.addConfigOption< CFuint >("NbT","Number of temperatures (uniformly spaced) in the table.");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ThermoTableLibrary::ThermoTableLibrary(const std::string& name)
+  : Framework::PhysicalChemicalLibrary(name),
+    m_source(),
+    m_table(),
+    m_sourceKey(0),
+    m_molarMasses(CFNULL),
+    m_values(CFNULL),
+    m_stride(0),
+    m_logPmin(0.),
+    m_invDlogP(0.),
+    m_invDT(0.),
+    m_lastT(-1.),
+    m_lastP(-1.),
+    m_nbClamped(0),
+    m_y(),
+    m_x()
+{
+  addConfigOptionsTo(this);
+
+  m_sourceName = "Mutationpp";
+  setParameter("SourceLibrary",&m_sourceName);
+
+  m_tableFile = "thermo.table";
+  setParameter("TableFile",&m_tableFile);
+
+  m_rebuild = false;
+  setParameter("RebuildTable",&m_rebuild);
+
+  m_namespace = "Default";
+  setParameter("Namespace",&m_namespace);
+
+  m_pMin = 1.;
+  setParameter("Pmin",&m_pMin);
+
+  m_pMax = 1e6;
+  setParameter("Pmax",&m_pMax);
+
+  m_nbP = 200;
+  setParameter("NbP",&m_nbP);
+
+  m_TMin = 300.;
+  setParameter("Tmin",&m_TMin);
+
+  m_TMax = 20000.;
+  setParameter("Tmax",&m_TMax);
+
+  m_nbT = 400;
+  setParameter("NbT",&m_nbT);
+
+  for (CFuint i = 0; i < 4; ++i) {
+    m_node[i] = CFNULL;
+    m_w[i] = 0.;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ThermoTableLibrary::~ThermoTableLibrary()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::configure ( Config::ConfigArgs& args )
+{
+  Framework::PhysicalChemicalLibrary::configure(args);
+
+  if (m_nbP < 2 || m_nbT < 2) {
+    throw BadValueException(FromHere(), "ThermoTableLibrary::configure() => NbP and NbT must be > 1");
+  }
+  if (!(m_pMin > 0.) || !(m_pMax > m_pMin) || !(m_TMax > m_TMin)) {
+    throw BadValueException(FromHere(), "ThermoTableLibrary::configure() => invalid table range");
+  }
+
+  // the source library is configured by every process, but it is set up
+  // only by the one building the table
+  m_source = Environment::Factory<PhysicalPropertyLibrary>::getInstance().
+    getProvider(m_sourceName)->create(m_sourceName);
+  cf_assert(m_source.isNotNull());
+  configureNested ( m_source.getPtr(), args );
+
+  // the options of the source library identify the tabulated mixture
+  m_sourceKey = HASH_BYTES_SEED;
+  hashBytes(&THERMO_TABLE_VERSION, sizeof(boost::uint32_t), m_sourceKey);
+  hashBytes(m_sourceName.c_str(), m_sourceName.size(), m_sourceKey);
+  const std::string prefix = m_source->getNestName() + ".";
+  for (Config::ConfigArgs::const_iterator it = args.begin(); it != args.end(); ++it) {
+    if (it->first.compare(0, prefix.size(), prefix) == 0) {
+      hashBytes(it->first.c_str(), it->first.size(), m_sourceKey);
+      hashBytes(it->second.c_str(), it->second.size(), m_sourceKey);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setup()
+{
+  CFLog(VERBOSE, "ThermoTableLibrary::setup() => start\n");
+
+  Framework::PhysicalChemicalLibrary::setup();
+
+  if (PE::GetPE().GetRank(m_namespace) == 0) {
+    if (m_rebuild || !isTableValid()) {
+      buildTable();
+    }
+  }
+  PE::GetPE().setBarrier(m_namespace);
+
+  mapTable();
+
+  CFLog(VERBOSE, "ThermoTableLibrary::setup() => end\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::unsetup()
+{
+  if (m_nbClamped > 0) {
+    CFLog(WARN, "ThermoTableLibrary::unsetup() => " << m_nbClamped
+	  << " queries outside the table have been clamped to its boundary\n");
+  }
+
+  m_table.close();
+  m_molarMasses = CFNULL;
+  m_values = CFNULL;
+
+  Framework::PhysicalChemicalLibrary::unsetup();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+boost::filesystem::path ThermoTableLibrary::getTableFile() const
+{
+  boost::filesystem::path file(m_tableFile);
+  if (!file.has_root_directory()) {
+    file = Environment::DirPaths::getInstance().getWorkingDir() / file;
+  }
+  return file;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool ThermoTableLibrary::isTableValid() const
+{
+  const boost::filesystem::path file = getTableFile();
+  if (!boost::filesystem::exists(file)) return false;
+
+  MemoryMappedFile table;
+  table.open(file.string());
+
+  bool valid = false;
+  ThermoTableHeader header;
+  if (table.size() >= sizeof(ThermoTableHeader)) {
+    std::copy(table.data(), table.data() + sizeof(ThermoTableHeader),
+	      reinterpret_cast<char*>(&header));
+    const size_t dataSize = (header.nbSpecies + header.nbP*header.nbT*header.stride)*sizeof(CFreal);
+    valid = std::equal(THERMO_TABLE_MAGIC, THERMO_TABLE_MAGIC + 8, header.magic) &&
+      header.version == THERMO_TABLE_VERSION &&
+      header.sizeOfReal == sizeof(CFreal) && header.key == m_sourceKey &&
+      header.nbP == m_nbP && header.nbT == m_nbT &&
+      header.pMin == m_pMin && header.pMax == m_pMax &&
+      header.TMin == m_TMin && header.TMax == m_TMax &&
+      header.stride == NB_PROPERTIES + 2*header.nbSpecies &&
+      table.size() == sizeof(ThermoTableHeader) + dataSize;
+  }
+  table.close();
+
+  if (!valid) {
+    CFLog(WARN, "ThermoTableLibrary::isTableValid() => " << file
+	  << " does not match the configuration and will be overwritten\n");
+  }
+  return valid;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::buildTable()
+{
+  const boost::filesystem::path file = getTableFile();
+  CFLog(INFO, "ThermoTableLibrary::buildTable() => building " << file << " with "
+	<< m_sourceName << " on " << m_nbP << "x" << m_nbT << " (p,T) nodes\n");
+
+  m_source->setup();
+  SelfRegistPtr<PhysicalChemicalLibrary> source = m_source.d_castTo<PhysicalChemicalLibrary>();
+  cf_assert(source.isNotNull());
+
+  const CFuint nbSpecies = source->getNbSpecies();
+  const CFuint stride = NB_PROPERTIES + 2*nbSpecies;
+  RealVector mm(nbSpecies);
+  source->getMolarMasses(mm);
+
+  RealVector x(nbSpecies);
+  RealVector y(nbSpecies);
+  RealVector dhe(3);
+  std::vector<CFreal> values(m_nbP*m_nbT*stride);
+  const CFreal logPmin = std::log(m_pMin);
+  const CFreal dlogP = (std::log(m_pMax) - logPmin)/(m_nbP - 1);
+  const CFreal dT = (m_TMax - m_TMin)/(m_nbT - 1);
+  CFuint nbMissing = 0;
+
+  for (CFuint iT = 0; iT < m_nbT; ++iT) {
+    for (CFuint iP = 0; iP < m_nbP; ++iP) {
+      CFreal temp = m_TMin + iT*dT;
+      CFreal pressure = std::exp(logPmin + iP*dlogP);
+      CFreal* node = &values[(iT*m_nbP + iP)*stride];
+
+      source->setComposition(temp, pressure, &x);
+      source->getSpeciesMassFractions(y);
+      source->setDensityEnthalpyEnergy(temp, pressure, dhe);
+      CFreal rho = dhe[0];
+      node[RHO] = rho;
+      node[H]   = dhe[1];
+      node[E]   = dhe[2];
+      source->gammaAndSoundSpeed(temp, pressure, rho, node[GAMMA], node[SOUND_SPEED]);
+
+      // quantities which are not provided by every library are set to 0
+      try {
+	CFreal soundSpeed = 0.;
+	source->frozenGammaAndSoundSpeed(temp, pressure, rho, node[FROZEN_GAMMA], soundSpeed, CFNULL);
+      }
+      catch (NotImplementedException&) {
+	node[FROZEN_GAMMA] = 0.; ++nbMissing;
+      }
+      try {
+	node[LAMBDA] = source->lambdaEQ(temp, pressure);
+	node[ETA]    = source->eta(temp, pressure, CFNULL);
+      }
+      catch (NotImplementedException&) {
+	node[LAMBDA] = node[ETA] = 0.; ++nbMissing;
+      }
+      try {
+	node[SIGMA] = source->sigma(temp, pressure, CFNULL);
+      }
+      catch (NotImplementedException&) {
+	node[SIGMA] = 0.; ++nbMissing;
+      }
+
+      for (CFuint i = 0; i < nbSpecies; ++i) {
+	node[NB_PROPERTIES + i] = x[i];
+	node[NB_PROPERTIES + nbSpecies + i] = y[i];
+      }
+    }
+  }
+
+  if (nbMissing > 0) {
+    CFLog(WARN, "ThermoTableLibrary::buildTable() => " << m_sourceName
+	  << " does not provide some of the tabulated quantities, which are set to 0\n");
+  }
+
+  ThermoTableHeader header;
+  std::copy(THERMO_TABLE_MAGIC, THERMO_TABLE_MAGIC + 8, header.magic);
+  header.version = THERMO_TABLE_VERSION;
+  header.sizeOfReal = sizeof(CFreal);
+  header.key = m_sourceKey;
+  header.nbP = m_nbP;
+  header.nbT = m_nbT;
+  header.nbSpecies = nbSpecies;
+  header.stride = stride;
+  header.hasElectrons = source->presenceElectron();
+  header.pMin = m_pMin;
+  header.pMax = m_pMax;
+  header.TMin = m_TMin;
+  header.TMax = m_TMax;
+  header.Rgas = source->getRgas();
+
+  m_source->unsetup();
+
+  // the file is written under a temporary name and then renamed, so that
+  // no process can map a partially written file
+  const boost::filesystem::path tmpFile(file.string() + ".tmp");
+  ofstream fout(tmpFile.string().c_str(), ios::out | ios::binary);
+  fout.write(reinterpret_cast<const char*>(&header), sizeof(ThermoTableHeader));
+  fout.write(reinterpret_cast<const char*>(&mm[0]), nbSpecies*sizeof(CFreal));
+  fout.write(reinterpret_cast<const char*>(&values[0]), values.size()*sizeof(CFreal));
+  fout.close();
+
+  if (!fout) {
+    boost::filesystem::remove(tmpFile);
+    throw BadValueException(FromHere(), "ThermoTableLibrary::buildTable() => could not write "
+			    + tmpFile.string());
+  }
+  boost::filesystem::rename(tmpFile, file);
+
+  CFLog(INFO, "ThermoTableLibrary::buildTable() => table written to " << file << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::mapTable()
+{
+  if (!isTableValid()) {
+    throw BadValueException(FromHere(), "ThermoTableLibrary::mapTable() => invalid table "
+			    + getTableFile().string());
+  }
+
+  // the file is mapped read-only: the processes running on the same node
+  // share the same pages
+  m_table.open(getTableFile().string());
+
+  ThermoTableHeader header;
+  std::copy(m_table.data(), m_table.data() + sizeof(ThermoTableHeader),
+	    reinterpret_cast<char*>(&header));
+
+  _NS = header.nbSpecies;
+  _nbTvib = 0;
+  _hasElectrons = (header.hasElectrons != 0);
+  _Rgas = header.Rgas;
+  m_stride = header.stride;
+
+  m_molarMasses = reinterpret_cast<const CFreal*>(m_table.data() + sizeof(ThermoTableHeader));
+  m_values = m_molarMasses + _NS;
+
+  m_logPmin = std::log(m_pMin);
+  m_invDlogP = (m_nbP - 1)/(std::log(m_pMax) - m_logPmin);
+  m_invDT = (m_nbT - 1)/(m_TMax - m_TMin);
+  m_lastT = m_lastP = -1.;
+
+  m_y.resize(_NS);
+  m_x.resize(_NS);
+  m_y = 0.;
+  m_x = 0.;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::computeWeights(const CFreal temp, const CFreal pressure)
+{
+  cf_assert(m_values != CFNULL);
+
+  m_lastT = temp;
+  m_lastP = pressure;
+
+  // positions in the grid, clamped to the table range
+  CFreal sT = (temp - m_TMin)*m_invDT;
+  CFreal sP = (pressure > 0.) ? (std::log(pressure) - m_logPmin)*m_invDlogP : -1.;
+  const CFreal sTmax = m_nbT - 1;
+  const CFreal sPmax = m_nbP - 1;
+  if (!(sT >= 0.) || sT > sTmax || !(sP >= 0.) || sP > sPmax) {
+    sT = std::max(0., std::min(sT, sTmax));
+    sP = std::max(0., std::min(sP, sPmax));
+    ++m_nbClamped;
+  }
+
+  const CFuint iT = std::min(static_cast<CFuint>(sT), m_nbT - 2);
+  const CFuint iP = std::min(static_cast<CFuint>(sP), m_nbP - 2);
+  const CFreal wT = sT - iT;
+  const CFreal wP = sP - iP;
+
+  m_node[0] = m_values + (iT*m_nbP + iP)*m_stride;
+  m_node[1] = m_node[0] + m_stride;
+  m_node[2] = m_node[0] + m_nbP*m_stride;
+  m_node[3] = m_node[2] + m_stride;
+
+  m_w[0] = (1. - wT)*(1. - wP);
+  m_w[1] = (1. - wT)*wP;
+  m_w[2] = wT*(1. - wP);
+  m_w[3] = wT*wP;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getMolarMasses(RealVector& mm)
+{
+  cf_assert(mm.size() == static_cast<CFuint>(_NS));
+  for (CFint i = 0; i < _NS; ++i) {
+    mm[i] = m_molarMasses[i];
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFdouble ThermoTableLibrary::getMMass() const
+{
+  CFdouble sum = 0.;
+  for (CFint i = 0; i < _NS; ++i) {
+    sum += m_y[i]/m_molarMasses[i];
+  }
+  return 1./sum;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setRiGas(RealVector& Ri)
+{
+  cf_assert(Ri.size() == static_cast<CFuint>(_NS));
+  for (CFint i = 0; i < _NS; ++i) {
+    Ri[i] = _Rgas/m_molarMasses[i];
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::gammaAndSoundSpeed(CFdouble& temp,
+					    CFdouble& pressure,
+					    CFdouble& rho,
+					    CFdouble& gamma,
+					    CFdouble& soundSpeed)
+{
+  setPoint(temp, pressure);
+  gamma = interpolate(GAMMA);
+  soundSpeed = interpolate(SOUND_SPEED);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::frozenGammaAndSoundSpeed(CFdouble& temp,
+						  CFdouble& pressure,
+						  CFdouble& rho,
+						  CFdouble& gamma,
+						  CFdouble& soundSpeed,
+						  RealVector* tVec)
+{
+  setPoint(temp, pressure);
+  gamma = interpolate(FROZEN_GAMMA);
+  soundSpeed = std::sqrt(gamma*pressure/rho);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setComposition(CFdouble& temp,
+					CFdouble& pressure,
+					RealVector* x)
+{
+  setPoint(temp, pressure);
+  for (CFint i = 0; i < _NS; ++i) {
+    m_x[i] = interpolate(NB_PROPERTIES + i);
+    m_y[i] = interpolate(NB_PROPERTIES + _NS + i);
+  }
+
+  if (x != CFNULL) {
+    cf_assert(x->size() == static_cast<CFuint>(_NS));
+    *x = m_x;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::resetComposition(const RealVector& x)
+{
+  m_x = x;
+  getSpeciesMassFractions(m_x, m_y);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setDensityEnthalpyEnergy(CFdouble& temp,
+						  CFdouble& pressure,
+						  RealVector& dhe)
+{
+  setPoint(temp, pressure);
+  dhe[0] = interpolate(RHO);
+  dhe[1] = interpolate(H);
+  dhe[2] = interpolate(E);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setDensityEnthalpyEnergy(CFdouble& temp,
+						  RealVector& tVec,
+						  CFdouble& pressure,
+						  RealVector& dhe,
+						  bool storeExtraData)
+{
+  setDensityEnthalpyEnergy(temp, pressure, dhe);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFdouble ThermoTableLibrary::density(CFdouble& temp,
+				     CFdouble& pressure,
+				     CFreal* tVec)
+{
+  setPoint(temp, pressure);
+  return interpolate(RHO);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setSpeciesFractions(const RealVector& ys)
+{
+  m_y = ys;
+  getSpeciesMolarFractions(m_y, m_x);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getSpeciesMolarFractions(const RealVector& ys, RealVector& xs)
+{
+  CFdouble sum = 0.;
+  for (CFint i = 0; i < _NS; ++i) {
+    sum += ys[i]/m_molarMasses[i];
+  }
+  for (CFint i = 0; i < _NS; ++i) {
+    xs[i] = ys[i]/(m_molarMasses[i]*sum);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getSpeciesMassFractions(const RealVector& xs, RealVector& ys)
+{
+  CFdouble mmass = 0.;
+  for (CFint i = 0; i < _NS; ++i) {
+    mmass += xs[i]*m_molarMasses[i];
+  }
+  for (CFint i = 0; i < _NS; ++i) {
+    ys[i] = xs[i]*m_molarMasses[i]/mmass;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getSpeciesMassFractions(RealVector& ys)
+{
+  ys = m_y;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFdouble ThermoTableLibrary::electronPressure(CFreal rhoE, CFreal tempE)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::electronPressure()");
+  return 0.;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFdouble ThermoTableLibrary::getCvTr() const
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::getCvTr()");
+  return 0.;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setMoleculesIDs(std::vector<CFuint>& v)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::setMoleculesIDs()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setState(CFdouble* rhoi, CFdouble* T)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::setState()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFdouble ThermoTableLibrary::pressure(CFdouble& rho, CFdouble& temp, CFreal* tVec)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::pressure()");
+  return 0.;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::transportCoeffNEQ(CFreal& temp, CFdouble& pressure, CFreal* tVec,
+					   RealVector& normConcGradients, CFreal& eta,
+					   CFreal& lambdaTrRo, RealVector& lambdaInt,
+					   RealVector& rhoUdiff)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::transportCoeffNEQ()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFdouble ThermoTableLibrary::lambdaNEQ(CFdouble& temp, CFdouble& pressure)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::lambdaNEQ()");
+  return 0.;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::lambdaVibNEQ(CFreal& temp, RealVector& tVec, CFdouble& pressure,
+				      CFreal& lambdaTrRo, RealVector& lambdaInt)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::lambdaVibNEQ()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setElemFractions(const RealVector& yn)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::setElemFractions()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setElementXFromSpeciesY(const RealVector& ys)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::setElementXFromSpeciesY()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setSpeciesMolarFractions(const RealVector& xs)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::setSpeciesMolarFractions()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::setElectronFraction(RealVector& ys)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::setElectronFraction()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getMassProductionTerm(CFdouble& temp, RealVector& tVec, CFdouble& pressure,
+					       CFdouble& rho, const RealVector& ys, bool flagJac,
+					       RealVector& omega, RealMatrix& jacobian)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::getMassProductionTerm()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getSourceTermVT(CFdouble& temp, RealVector& tVec, CFdouble& pressure,
+					 CFdouble& rho, RealVector& omegav, CFdouble& omegaRad)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::getSourceTermVT()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getSource(CFdouble& temp, RealVector& tVec, CFdouble& pressure,
+				   CFdouble& rho, const RealVector& ys, bool flagJac,
+				   RealVector& omega, RealVector& omegav, CFdouble& omegaRad,
+				   RealMatrix& jacobian)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::getSource()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getSourceEE(CFdouble& temp, RealVector& tVec, CFdouble& pressure,
+				     CFdouble& rho, const RealVector& ys, bool flagJac,
+				     CFdouble& omegaEE)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::getSourceEE()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getRhoUdiff(CFdouble& temp, CFdouble& pressure,
+				     RealVector& normConcGradients, CFreal* tVec,
+				     RealVector& rhoUdiff, bool fast)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::getRhoUdiff()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ThermoTableLibrary::getSpeciesTotEnthalpies(CFdouble& temp, RealVector& tVec,
+						 CFdouble& pressure, RealVector& hsTot,
+						 RealVector* hsVib, RealVector* hsEl)
+{
+  throw NotImplementedException(FromHere(), "ThermoTableLibrary::getSpeciesTotEnthalpies()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace ThermoTable
+
+  } // namespace Physics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
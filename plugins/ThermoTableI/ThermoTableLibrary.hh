@@ -0,0 +1,354 @@
+#ifndef COOLFluiD_Physics_ThermoTable_ThermoTableLibrary_hh
+#define COOLFluiD_Physics_ThermoTable_ThermoTableLibrary_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Framework/PhysicalChemicalLibrary.hh"
+#include "Common/MemoryMappedFile.hh"
+#include "Common/SelfRegistPtr.hh"
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem/path.hpp>
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Physics {
+
+    namespace ThermoTable {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class represents a physico-chemical library for LTE mixtures which
+ * interpolates the properties tabulated on a (log(p),T) grid.
+ *
+ * The table is computed once by another PhysicalChemicalLibrary (e.g.
+ * Mutationpp) and stored in a binary file, which is then mapped read-only
+ * in memory, so that all the processes on the same node share it.
+ * All the properties of a grid node are contiguous, so that a query reads
+ * the 4 nodes surrounding (p,T) and interpolates them bilinearly.
+ */
+class ThermoTableLibrary : public Framework::PhysicalChemicalLibrary {
+public:
+
+  /**
+   * Defines the Config Option's of this class
+   * @param options a OptionList where to add the Option's
+   */
+  static void defineConfigOptions(Config::OptionList& options);
+
+  /**
+   * Constructor without arguments
+   */
+  ThermoTableLibrary(const std::string& name);
+
+  /**
+   * Default destructor
+   */
+  virtual ~ThermoTableLibrary();
+
+  /**
+   * Configures this configurable object.
+   */
+  void configure ( Config::ConfigArgs& args );
+
+  /**
+   * Setups the data of the library, building the table if needed
+   */
+  void setup();
+
+  /**
+   * Unsetups the data of the library
+   */
+  void unsetup();
+
+  /**
+   * Get the molar masses
+   */
+  void getMolarMasses(RealVector& mm);
+
+  /**
+   * Get the molar mass of the mixture
+   * @pre the composition has been set
+   */
+  CFdouble getMMass() const;
+
+  /**
+   * Set the constant of gases in J/(Kg*K)
+   */
+  void setRiGas(RealVector& Ri);
+
+  /**
+   * Calculates the thermal conductivity by conduction, given temperature
+   * and pressure
+   */
+  CFdouble lambdaEQ(CFdouble& temp, CFdouble& pressure)
+  {
+    setPoint(temp, pressure);
+    return interpolate(LAMBDA);
+  }
+
+  /**
+   * Calculates the dynamic viscosity, given temperature and pressure
+   */
+  CFdouble eta(CFdouble& temp, CFdouble& pressure, CFreal* tVec)
+  {
+    setPoint(temp, pressure);
+    return interpolate(ETA);
+  }
+
+  /**
+   * Calculates the electrical conductivity given temperature and pressure
+   */
+  CFdouble sigma(CFdouble& temp, CFdouble& pressure, CFreal* tVec)
+  {
+    setPoint(temp, pressure);
+    return interpolate(SIGMA);
+  }
+
+  /**
+   * Calculates the specific heat ratio and the speed of sound in
+   * thermal equilibrium.
+   */
+  void gammaAndSoundSpeed(CFdouble& temp,
+			  CFdouble& pressure,
+			  CFdouble& rho,
+			  CFdouble& gamma,
+			  CFdouble& soundSpeed);
+
+  /**
+   * Calculates the frozen specific heat ratio and the speed of sound
+   */
+  void frozenGammaAndSoundSpeed(CFdouble& temp,
+				CFdouble& pressure,
+				CFdouble& rho,
+				CFdouble& gamma,
+				CFdouble& soundSpeed,
+				RealVector* tVec);
+
+  /**
+   * Sets the equilibrium composition given temperature and pressure.
+   * @param x molar fractions (one component for each species)
+   */
+  void setComposition(CFdouble& temp,
+		      CFdouble& pressure,
+		      RealVector* x);
+
+  /**
+   * Reset the composition
+   */
+  void resetComposition(const RealVector& x);
+
+  /**
+   * Calculates the density, the enthalpy and the internal energy
+   * given temperature and pressure.
+   */
+  void setDensityEnthalpyEnergy(CFdouble& temp,
+				CFdouble& pressure,
+				RealVector& dhe);
+
+  /**
+   * Calculates the density, the enthalpy and the internal energy
+   * given temperature and pressure (the vibrational temperatures are ignored).
+   */
+  void setDensityEnthalpyEnergy(CFdouble& temp,
+				RealVector& tVec,
+				CFdouble& pressure,
+				RealVector& dhe,
+				bool storeExtraData);
+
+  /**
+   * Calculates the density given temperature and pressure.
+   */
+  CFdouble density(CFdouble& temp,
+		   CFdouble& pressure,
+		   CFreal* tVec);
+
+  /**
+   * Sets the species mass fractions
+   */
+  void setSpeciesFractions(const RealVector& ys);
+
+  /**
+   * Gets the species molar fractions from the mass fractions
+   */
+  void getSpeciesMolarFractions(const RealVector& ys, RealVector& xs);
+
+  /**
+   * Gets the species mass fractions from the molar fractions
+   */
+  void getSpeciesMassFractions(const RealVector& xs, RealVector& ys);
+
+  /**
+   * Gets the species mass fractions of the current composition
+   */
+  void getSpeciesMassFractions(RealVector& ys);
+
+  /// @name Functions which are not available in LTE tables
+  /// @{
+  CFdouble electronPressure(CFreal rhoE, CFreal tempE);
+  CFdouble getCvTr() const;
+  void setMoleculesIDs(std::vector<CFuint>& v);
+  void setState(CFdouble* rhoi, CFdouble* T);
+  CFdouble pressure(CFdouble& rho, CFdouble& temp, CFreal* tVec);
+  void transportCoeffNEQ(CFreal& temp, CFdouble& pressure, CFreal* tVec,
+			 RealVector& normConcGradients, CFreal& eta,
+			 CFreal& lambdaTrRo, RealVector& lambdaInt, RealVector& rhoUdiff);
+  CFdouble lambdaNEQ(CFdouble& temp, CFdouble& pressure);
+  void lambdaVibNEQ(CFreal& temp, RealVector& tVec, CFdouble& pressure,
+		    CFreal& lambdaTrRo, RealVector& lambdaInt);
+  void setElemFractions(const RealVector& yn);
+  void setElementXFromSpeciesY(const RealVector& ys);
+  void setSpeciesMolarFractions(const RealVector& xs);
+  void setElectronFraction(RealVector& ys);
+  void getMassProductionTerm(CFdouble& temp, RealVector& tVec, CFdouble& pressure,
+			     CFdouble& rho, const RealVector& ys, bool flagJac,
+			     RealVector& omega, RealMatrix& jacobian);
+  void getSourceTermVT(CFdouble& temp, RealVector& tVec, CFdouble& pressure,
+		       CFdouble& rho, RealVector& omegav, CFdouble& omegaRad);
+  void getSource(CFdouble& temp, RealVector& tVec, CFdouble& pressure,
+		 CFdouble& rho, const RealVector& ys, bool flagJac,
+		 RealVector& omega, RealVector& omegav, CFdouble& omegaRad,
+		 RealMatrix& jacobian);
+  void getSourceEE(CFdouble& temp, RealVector& tVec, CFdouble& pressure,
+		   CFdouble& rho, const RealVector& ys, bool flagJac, CFdouble& omegaEE);
+  void getRhoUdiff(CFdouble& temp, CFdouble& pressure, RealVector& normConcGradients,
+		   CFreal* tVec, RealVector& rhoUdiff, bool fast);
+  void getSpeciesTotEnthalpies(CFdouble& temp, RealVector& tVec, CFdouble& pressure,
+			       RealVector& hsTot, RealVector* hsVib, RealVector* hsEl);
+  /// @}
+
+private: // helper functions
+
+  /// IDs of the tabulated quantities in each grid node, followed by the
+  /// molar and the mass fractions of the species
+  enum TableEntry {RHO=0, H=1, E=2, GAMMA=3, SOUND_SPEED=4, FROZEN_GAMMA=5,
+		   LAMBDA=6, ETA=7, SIGMA=8, NB_PROPERTIES=9};
+
+  /// Set the point where the next quantities are interpolated, computing the
+  /// interpolation weights only if it differs from the last one
+  void setPoint(const CFreal temp, const CFreal pressure)
+  {
+    if (temp != m_lastT || pressure != m_lastP) {
+      computeWeights(temp, pressure);
+    }
+  }
+
+  /// Compute the position in the grid and the bilinear weights of (T,p)
+  void computeWeights(const CFreal temp, const CFreal pressure);
+
+  /// Interpolate the given quantity in the current point
+  CFreal interpolate(const CFuint iValue) const
+  {
+    return m_w[0]*m_node[0][iValue] + m_w[1]*m_node[1][iValue] +
+      m_w[2]*m_node[2][iValue] + m_w[3]*m_node[3][iValue];
+  }
+
+  /// Get the path of the table file
+  boost::filesystem::path getTableFile() const;
+
+  /// Tell if the table file exists and matches the configured grid
+  bool isTableValid() const;
+
+  /// Compute the table with the source library and write it to file
+  void buildTable();
+
+  /// Map the table file in memory and set the pointers to its data
+  void mapTable();
+
+private: // data
+
+  /// source library computing the tabulated quantities
+  Common::SelfRegistPtr<Framework::PhysicalPropertyLibrary> m_source;
+
+  /// table file mapped in memory
+  Common::MemoryMappedFile m_table;
+
+  /// hash of the options of the source library
+  boost::uint64_t m_sourceKey;
+
+
+  /// species molar masses stored in the table
+  const CFreal* m_molarMasses;
+
+  /// tabulated values, node by node
+  const CFreal* m_values;
+
+  /// number of values per grid node
+  CFuint m_stride;
+
+  /// log of the minimum pressure
+  CFreal m_logPmin;
+
+  /// inverse of the log(p) spacing
+  CFreal m_invDlogP;
+
+  /// inverse of the T spacing
+  CFreal m_invDT;
+
+  /// last temperature where the weights have been computed
+  CFreal m_lastT;
+
+  /// last pressure where the weights have been computed
+  CFreal m_lastP;
+
+  /// the 4 nodes surrounding the current point
+  const CFreal* m_node[4];
+
+  /// bilinear weights of the 4 nodes surrounding the current point
+  CFreal m_w[4];
+
+  /// number of queries outside the table, which are clamped to its boundary
+  CFuint m_nbClamped;
+
+  /// mass fractions
+  RealVector m_y;
+
+  /// molar fractions
+  RealVector m_x;
+
+  /// name of the source library
+  std::string m_sourceName;
+
+  /// name of the table file
+  std::string m_tableFile;
+
+  /// namespace of the processes sharing the table
+  std::string m_namespace;
+
+  /// flag forcing to build the table again
+  bool m_rebuild;
+
+  /// minimum pressure in the table
+  CFreal m_pMin;
+
+  /// maximum pressure in the table
+  CFreal m_pMax;
+
+  /// number of pressures (logarithmically spaced)
+  CFuint m_nbP;
+
+  /// minimum temperature in the table
+  CFreal m_TMin;
+
+  /// maximum temperature in the table
+  CFreal m_TMax;
+
+  /// number of temperatures (uniformly spaced)
+  CFuint m_nbT;
+
+}; // end of class ThermoTableLibrary
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace ThermoTable
+
+  } // namespace Physics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Physics_ThermoTable_ThermoTableLibrary_hh
@@ -0,0 +1,293 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test ThermoTable library"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <cmath>
+
+#include "Common/PE.hh"
+#include "Environment/ObjectProvider.hh"
+#include "ThermoTableI/ThermoTable.hh"
+#include "ThermoTableI/ThermoTableLibrary.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Physics::ThermoTable;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Source library whose quantities are bilinear in (T,log(p)), so that they
+/// are interpolated exactly by the table
+class AnalyticLibrary : public ThermoTableLibrary {
+public:
+
+  /// number of times the library has been set up, i.e. the table has been built
+  static CFuint nbSetups;
+
+  /// value of the quantity iValue in (T,p)
+  static CFreal value(const CFuint iValue, const CFreal temp, const CFreal pressure)
+  {
+    const CFreal logP = std::log(pressure);
+    return 1. + 0.1*iValue + 1e-3*(iValue+1)*temp + 0.5*logP + 1e-5*temp*logP;
+  }
+
+  AnalyticLibrary(const std::string& name) : ThermoTableLibrary(name), m_massFractions(2) {}
+
+  void configure ( Config::ConfigArgs& args ) {PhysicalChemicalLibrary::configure(args);}
+
+  void setup()
+  {
+    PhysicalChemicalLibrary::setup();
+    _NS = 2;
+    _Rgas = 8.314;
+    _hasElectrons = false;
+    ++nbSetups;
+  }
+
+  void unsetup() {PhysicalChemicalLibrary::unsetup();}
+
+  void getMolarMasses(RealVector& mm) {mm[0] = 0.028; mm[1] = 0.032;}
+
+  void setComposition(CFdouble& temp, CFdouble& pressure, RealVector* x)
+  {
+    (*x)[0] = value(10, temp, pressure);
+    (*x)[1] = value(11, temp, pressure);
+    m_massFractions[0] = value(12, temp, pressure);
+    m_massFractions[1] = value(13, temp, pressure);
+  }
+
+  void getSpeciesMassFractions(RealVector& ys) {ys = m_massFractions;}
+
+  void setDensityEnthalpyEnergy(CFdouble& temp, CFdouble& pressure, RealVector& dhe)
+  {
+    dhe[0] = value(0, temp, pressure);
+    dhe[1] = value(1, temp, pressure);
+    dhe[2] = value(2, temp, pressure);
+  }
+
+  void gammaAndSoundSpeed(CFdouble& temp, CFdouble& pressure, CFdouble& rho,
+			  CFdouble& gamma, CFdouble& soundSpeed)
+  {
+    gamma = value(3, temp, pressure);
+    soundSpeed = value(4, temp, pressure);
+  }
+
+  void frozenGammaAndSoundSpeed(CFdouble& temp, CFdouble& pressure, CFdouble& rho,
+				CFdouble& gamma, CFdouble& soundSpeed, RealVector* tVec)
+  {
+    gamma = value(5, temp, pressure);
+    soundSpeed = 0.;
+  }
+
+  CFdouble lambdaEQ(CFdouble& temp, CFdouble& pressure) {return value(6, temp, pressure);}
+
+  CFdouble eta(CFdouble& temp, CFdouble& pressure, CFreal* tVec) {return value(7, temp, pressure);}
+
+  CFdouble sigma(CFdouble& temp, CFdouble& pressure, CFreal* tVec) {return value(8, temp, pressure);}
+
+private:
+
+  /// mass fractions of the last composition
+  RealVector m_massFractions;
+};
+
+CFuint AnalyticLibrary::nbSetups = 0;
+
+Environment::ObjectProvider<AnalyticLibrary,
+			    PhysicalPropertyLibrary,
+			    ThermoTableModule,
+			    1>
+analyticLibraryProvider("ThermoTableAnalytic");
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// the table is built and shared through the processes of the "Default" namespace
+struct PE_Fixture
+{
+  PE_Fixture()
+  {
+    Common::PE::InitPE(&framework::master_test_suite().argc, &framework::master_test_suite().argv);
+  }
+  ~PE_Fixture()
+  {
+    Common::PE::DonePE();
+  }
+};
+
+BOOST_GLOBAL_FIXTURE( PE_Fixture );
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct ThermoTable_Fixture
+{
+  /// common setup for each test case
+  ThermoTable_Fixture() : tableFile("utest-thermoTable.table")
+  {
+    boost::filesystem::remove(tableFile);
+  }
+  /// common tear-down for each test case
+  ~ThermoTable_Fixture()
+  {
+    boost::filesystem::remove(tableFile);
+  }
+
+  /// configure and set up a table of the analytic library
+  void setupTable(ThermoTableLibrary& lib, const std::string& pMax = "1e5",
+		  const std::string& rebuild = "false")
+  {
+    Config::ConfigArgs args;
+    args["ThermoTable.SourceLibrary"] = "ThermoTableAnalytic";
+    args["ThermoTable.TableFile"] = tableFile;
+    args["ThermoTable.RebuildTable"] = rebuild;
+    args["ThermoTable.Pmin"] = "100";
+    args["ThermoTable.Pmax"] = pMax;
+    args["ThermoTable.NbP"] = "31";
+    args["ThermoTable.Tmin"] = "300";
+    args["ThermoTable.Tmax"] = "10000";
+    args["ThermoTable.NbT"] = "41";
+    lib.configure(args);
+    lib.setup();
+  }
+
+  /// deterministic pseudo-random value in [0,1]
+  CFreal random(CFuint& seed)
+  {
+    seed = seed*1103515245u + 12345u;
+    return ((seed/65536u) % 32768u)/32767.;
+  }
+
+  /// name of the table file
+  std::string tableFile;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ThermoTable_TestSuite, ThermoTable_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_bilinearLookup )
+{
+  ThermoTableLibrary lib("ThermoTable");
+  setupTable(lib);
+  BOOST_CHECK_EQUAL( lib.getNbSpecies(), 2 );
+
+  RealVector mm(2);
+  lib.getMolarMasses(mm);
+  BOOST_CHECK_EQUAL( mm[0], 0.028 );
+  BOOST_CHECK_EQUAL( mm[1], 0.032 );
+
+  RealVector dhe(3);
+  RealVector x(2);
+  RealVector y(2);
+  CFuint seed = 17;
+  for (CFuint i = 0; i < 200; ++i) {
+    // the grid nodes are included among the queried points
+    CFreal temp = (i < 10) ? 300. + i*242.5 : 300. + 9700.*random(seed);
+    CFreal pressure = (i < 10) ? 100.*std::pow(1000., i/30.) : 100.*std::pow(1000., random(seed));
+
+    lib.setDensityEnthalpyEnergy(temp, pressure, dhe);
+    for (CFuint k = 0; k < 3; ++k) {
+      BOOST_CHECK_CLOSE( dhe[k], AnalyticLibrary::value(k, temp, pressure), 1e-10 );
+    }
+
+    CFreal rho = dhe[0];
+    CFreal gamma = 0.;
+    CFreal soundSpeed = 0.;
+    lib.gammaAndSoundSpeed(temp, pressure, rho, gamma, soundSpeed);
+    BOOST_CHECK_CLOSE( gamma, AnalyticLibrary::value(3, temp, pressure), 1e-10 );
+    BOOST_CHECK_CLOSE( soundSpeed, AnalyticLibrary::value(4, temp, pressure), 1e-10 );
+    lib.frozenGammaAndSoundSpeed(temp, pressure, rho, gamma, soundSpeed, CFNULL);
+    BOOST_CHECK_CLOSE( gamma, AnalyticLibrary::value(5, temp, pressure), 1e-10 );
+
+    BOOST_CHECK_CLOSE( lib.lambdaEQ(temp, pressure), AnalyticLibrary::value(6, temp, pressure), 1e-10 );
+    BOOST_CHECK_CLOSE( lib.eta(temp, pressure, CFNULL), AnalyticLibrary::value(7, temp, pressure), 1e-10 );
+    BOOST_CHECK_CLOSE( lib.sigma(temp, pressure, CFNULL), AnalyticLibrary::value(8, temp, pressure), 1e-10 );
+
+    lib.setComposition(temp, pressure, &x);
+    lib.getSpeciesMassFractions(y);
+    for (CFuint k = 0; k < 2; ++k) {
+      BOOST_CHECK_CLOSE( x[k], AnalyticLibrary::value(10+k, temp, pressure), 1e-10 );
+      BOOST_CHECK_CLOSE( y[k], AnalyticLibrary::value(12+k, temp, pressure), 1e-10 );
+    }
+  }
+
+  lib.unsetup();
+}
+
+BOOST_AUTO_TEST_CASE( test_clamping )
+{
+  ThermoTableLibrary lib("ThermoTable");
+  setupTable(lib);
+
+  // the queries outside the table get the values on its boundary
+  CFreal temp = 20000.;
+  CFreal pressure = 1000.;
+  BOOST_CHECK_CLOSE( lib.lambdaEQ(temp, pressure), AnalyticLibrary::value(6, 10000., pressure), 1e-10 );
+  temp = 100.;
+  BOOST_CHECK_CLOSE( lib.lambdaEQ(temp, pressure), AnalyticLibrary::value(6, 300., pressure), 1e-10 );
+  temp = 5000.;
+  pressure = 1e7;
+  BOOST_CHECK_CLOSE( lib.lambdaEQ(temp, pressure), AnalyticLibrary::value(6, temp, 1e5), 1e-10 );
+  pressure = 0.;
+  BOOST_CHECK_CLOSE( lib.lambdaEQ(temp, pressure), AnalyticLibrary::value(6, temp, 100.), 1e-10 );
+
+  lib.unsetup();
+}
+
+BOOST_AUTO_TEST_CASE( test_tableReuse )
+{
+  const CFuint nbSetups = AnalyticLibrary::nbSetups;
+  {
+    ThermoTableLibrary lib("ThermoTable");
+    setupTable(lib);
+    lib.unsetup();
+  }
+  BOOST_CHECK_EQUAL( AnalyticLibrary::nbSetups, nbSetups + 1 );
+
+  // the same configuration maps the existing table
+  {
+    ThermoTableLibrary lib("ThermoTable");
+    setupTable(lib);
+    CFreal temp = 5000.;
+    CFreal pressure = 1000.;
+    BOOST_CHECK_CLOSE( lib.lambdaEQ(temp, pressure), AnalyticLibrary::value(6, temp, pressure), 1e-10 );
+    lib.unsetup();
+  }
+  BOOST_CHECK_EQUAL( AnalyticLibrary::nbSetups, nbSetups + 1 );
+
+  // a different range or RebuildTable build the table again
+  {
+    ThermoTableLibrary lib("ThermoTable");
+    setupTable(lib, "1e6");
+    CFreal temp = 5000.;
+    CFreal pressure = 5e5;
+    BOOST_CHECK_CLOSE( lib.lambdaEQ(temp, pressure), AnalyticLibrary::value(6, temp, pressure), 1e-10 );
+    lib.unsetup();
+  }
+  BOOST_CHECK_EQUAL( AnalyticLibrary::nbSetups, nbSetups + 2 );
+  {
+    ThermoTableLibrary lib("ThermoTable");
+    setupTable(lib, "1e6", "true");
+    lib.unsetup();
+  }
+  BOOST_CHECK_EQUAL( AnalyticLibrary::nbSetups, nbSetups + 3 );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,12 @@ namespace COOLFluiD {
 #else
 #define HOST_DEVICE __host__ __device__
 #endif 
+
+/// Macro enabling the algorithmic kernels (DeviceFunc, DeviceConfigOptions) shared 
+/// by the CUDA and the multithreaded CPU implementations of the cell-based solvers
+#if defined(CF_HAVE_CUDA) || defined(CF_HAVE_CPU_KERNELS)
+#define CF_HAVE_DEVICE_KERNELS
+#endif
   
 //////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,49 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Common_HashBytes_hh
+#define COOLFluiD_Common_HashBytes_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// 64 bit FNV-1a hash, used to build the keys of the files cached on disk.
+/// A key starts from HASH_BYTES_SEED and is updated by hashBytes() with each
+/// piece of data it depends on.
+
+/// initial value of a FNV-1a hash
+const boost::uint64_t HASH_BYTES_SEED = 14695981039346656037ULL;
+
+/// Update a FNV-1a hash with the given bytes
+inline void hashBytes(const void* data, const std::size_t size, boost::uint64_t& key)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    key ^= bytes[i];
+    key *= 1099511628211ULL;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Common_HashBytes_hh
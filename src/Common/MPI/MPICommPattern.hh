@@ -41,6 +41,7 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <cstring>
 
 #include "Common/COOLFluiD.hh"
 #include "Common/PE.hh"
@@ -231,6 +232,9 @@ private:
   /// Check to see if InitMPI was called
   bool _InitMPIOK;
 
+  /// Is a synchronisation started by BeginSync() still waiting for EndSync()
+  bool _SyncPending;
+
   /// Is the CGlobalMap is valid
   bool _CGlobalValid;
 
@@ -258,6 +262,23 @@ private:
   std::vector<MPI_Request> _ReceiveRequests;
   std::vector<MPI_Request> _SendRequests;
 
+  /// Synchronise through packed contiguous buffers and persistent requests
+  /// instead of derived datatypes
+  bool _PackedSync;
+
+  /// Local indexes of the elements to pack (send) and unpack (receive),
+  /// grouped by neighbour rank
+  std::vector<IndexType> _PackList;
+  std::vector<IndexType> _UnpackList;
+
+  /// Contiguous buffers for the packed elements
+  std::vector<char> _SendBuffer;
+  std::vector<char> _ReceiveBuffer;
+
+  /// Persistent requests (one per neighbour rank)
+  std::vector<MPI_Request> _PersistentSendRequests;
+  std::vector<MPI_Request> _PersistentReceiveRequests;
+
   /// Data of the CGLobal map
   std::vector<IndexType> _CGlobal;
 
@@ -287,6 +308,13 @@ private:
   void Sync_BuildTypeHelper (const std::vector<std::vector<IndexType> > & V,
                                    std::vector<MPI_Datatype> & MPIType ) const;
 
+  /// Build the pack/unpack lists, the buffers and the persistent requests
+  /// used by the packed synchronisation
+  void Sync_BuildPackedBuffers ();
+
+  /// Free the persistent requests
+  void Sync_FreePersistentRequests ();
+
   /// Find functions (for internal use)
   /// These take advantage of a index map if one is present
   IndexType FindLocal (IndexType GlobalIndex) const;
@@ -371,15 +399,30 @@ public: // funcions
   void BeginSync ();
 
   /// Wait for the end of the synchronisation
+  /// Does nothing if no synchronisation is pending, so that the
+  /// exchange can be completed by the first code that needs the ghosts.
   /// Collective.
   void EndSync ();
 
+  /// Check if BeginSync() was called without the matching EndSync()
+  /// (i.e. the ghost values may still be in flight)
+  bool IsSyncPending () const {return _SyncPending;}
+
   /// Build internal data structures
   /// (to be called after adding ghost points but before  )
   /// (doing a sync                                       )
   /// Collective.
   /// InitMPI needs to be called before this.
-  void BuildGhostMap ();
+  /// @param packedSync  if true, the synchronisation packs the elements in
+  ///                    contiguous buffers exchanged with persistent requests
+  ///                    (precomputed here) instead of using derived datatypes
+  void BuildGhostMap (bool packedSync = false);
+
+  /// Move each element i (data and global index) to position NewIDs[i]
+  /// (to be called after adding all the points but before BuildGhostMap)
+  /// Non-collective: the global indices, hence the communication
+  /// pattern, are not affected.
+  void Renumber (const std::vector<IndexType>& NewIDs);
 
   /// Create the indexes
   /// (to speed up index operations)
@@ -1049,9 +1092,54 @@ void MPICommPattern<DATA>::BuildCGlobal ()
     }
 
     template <typename DATA>
-    void MPICommPattern<DATA>::BuildGhostMap ()
+    void MPICommPattern<DATA>::Renumber (const std::vector<IndexType>& NewIDs)
+    {
+      const IndexType Size = _LocalSize + _GhostSize;
+      cf_assert (NewIDs.size() == Size);
+      cf_assert (!_CGlobalValid);
+      // the ghost map refers to the local IDs: it must not be built yet
+      for (CFuint i = 0; i < _GhostReceiveList.size(); ++i) {
+        cf_assert (_GhostReceiveList[i].empty());
+      }
+
+      // the points are allocated in order from the free list:
+      // slots [0, Size) must all be in use
+      cf_assert (_NextFree == _NO_MORE_FREE || _NextFree >= Size);
+
+      if (Size == 0) return;
+
+      char *const Data = reinterpret_cast<char*>(m_data->ptr());
+      std::vector<char> DataBackup (Data, Data + Size*_ElementSize);
+      std::vector<IndexType> IndexBackup (Size);
+      for (IndexType i = 0; i < Size; ++i) {
+        IndexBackup[i] = _MetaData(i).GlobalIndex;
+      }
+
+      for (IndexType i = 0; i < Size; ++i) {
+        const IndexType NewID = NewIDs[i];
+        cf_assert (NewID < Size);
+        memcpy (Data + NewID*_ElementSize, &DataBackup[i*_ElementSize], _ElementSize);
+
+        const IndexType Global = IndexBackup[i];
+        _MetaData(NewID).GlobalIndex = Global;
+        if (IsFlagSet (Global, _FLAG_GHOST)) {
+          _GhostMap[NormalIndex(Global)] = NewID;
+        }
+        else {
+          _IndexMap[NormalIndex(Global)] = NewID;
+        }
+      }
+
+      CFLog (VERBOSE, "MPICommPattern<DATA>::Renumber() => " << Size << " elements\n");
+    }
+
+    template <typename DATA>
+    void MPICommPattern<DATA>::BuildGhostMap (bool packedSync)
     {
       cf_assert (_InitMPIOK);
+      
+      // the old requests could still be active
+      EndSync ();
 
       cf_assert (_GhostSendList.size()==
            static_cast<CFuint>(_CommSize));
@@ -1118,6 +1206,12 @@ void MPICommPattern<DATA>::BuildCGlobal ()
       // Build receive datatype
       Sync_BuildReceiveTypes ();
 
+      _PackedSync = packedSync;
+      Sync_FreePersistentRequests ();
+      if (_PackedSync) {
+	Sync_BuildPackedBuffers ();
+      }
+
 #ifdef CF_ENABLE_PARALLEL_DEBUG
       WriteCommPattern ();
 #endif
@@ -1182,6 +1276,70 @@ void MPICommPattern<DATA>::BuildCGlobal ()
       Sync_BuildTypeHelper (_GhostSendList, _SendTypes);
     }
 
+//////////////////////////////////////////////////////////////////////////////
+
+    template <typename DATA>
+    void MPICommPattern<DATA>::Sync_BuildPackedBuffers ()
+    {
+      cf_assert (_PersistentSendRequests.empty());
+      cf_assert (_PersistentReceiveRequests.empty());
+      
+      _PackList.clear();
+      _UnpackList.clear();
+      for (int i=0; i<_CommSize; i++) {
+	_PackList.insert(_PackList.end(), _GhostSendList[i].begin(), _GhostSendList[i].end());
+	_UnpackList.insert(_UnpackList.end(), _GhostReceiveList[i].begin(), _GhostReceiveList[i].end());
+      }
+      
+      _SendBuffer.resize(_PackList.size()*_ElementSize);
+      _ReceiveBuffer.resize(_UnpackList.size()*_ElementSize);
+      
+      // the buffers don't move anymore: the requests can be set up once
+      size_t SendOffset = 0;
+      size_t ReceiveOffset = 0;
+      for (int i=0; i<_CommSize; i++) {
+	if (i==_CommRank)
+	  continue;
+	
+	if (!_GhostReceiveList[i].empty()) {
+	  const size_t Bytes = _GhostReceiveList[i].size()*_ElementSize;
+	  MPI_Request Request;
+	  Common::CheckMPIStatus(MPI_Recv_init (&_ReceiveBuffer[ReceiveOffset], Bytes, MPI_BYTE, i,
+						_MPI_TAG_SYNC, _Communicator, &Request));
+	  _PersistentReceiveRequests.push_back(Request);
+	  ReceiveOffset += Bytes;
+	}
+	
+	if (!_GhostSendList[i].empty()) {
+	  const size_t Bytes = _GhostSendList[i].size()*_ElementSize;
+	  MPI_Request Request;
+	  Common::CheckMPIStatus(MPI_Send_init (&_SendBuffer[SendOffset], Bytes, MPI_BYTE, i,
+						_MPI_TAG_SYNC, _Communicator, &Request));
+	  _PersistentSendRequests.push_back(Request);
+	  SendOffset += Bytes;
+	}
+      }
+      
+      CFLog(VERBOSE, "MPICommPattern<DATA>::Sync_BuildPackedBuffers() => "
+	    << _PersistentSendRequests.size() << " neighbours, "
+	    << _SendBuffer.size() << " bytes sent per sync\n");
+    }
+
+//////////////////////////////////////////////////////////////////////////////
+
+    template <typename DATA>
+    void MPICommPattern<DATA>::Sync_FreePersistentRequests ()
+    {
+      for (CFuint i=0; i<_PersistentSendRequests.size(); i++) {
+	MPI_Request_free (&_PersistentSendRequests[i]);
+      }
+      for (CFuint i=0; i<_PersistentReceiveRequests.size(); i++) {
+	MPI_Request_free (&_PersistentReceiveRequests[i]);
+      }
+      _PersistentSendRequests.clear();
+      _PersistentReceiveRequests.clear();
+    }
+
 //////////////////////////////////////////////////////////////////////////////
 
     /*==============================================================
@@ -1397,6 +1555,34 @@ typename MPICommPattern<DATA>::IndexType MPICommPattern<DATA>::AllocNext ()
     void MPICommPattern<DATA>::BeginSync ()
     {
       cf_assert (_InitMPIOK);
+      
+      // a previous exchange left open has to be completed before reposting
+      // the requests on the same buffers
+      if (_SyncPending) EndSync();
+      
+      if (_PackedSync) {
+	if (!_PersistentReceiveRequests.empty()) {
+	  Common::CheckMPIStatus(MPI_Startall (_PersistentReceiveRequests.size(),
+					       &_PersistentReceiveRequests[0]));
+	}
+	
+	// the element data are copied in the send buffer, neighbour after neighbour
+	const char *const Data = reinterpret_cast<const char*>(m_data->ptr());
+	char *const Buffer = (_SendBuffer.empty()) ? CFNULL : &_SendBuffer[0];
+	const size_t ElementSize = _ElementSize;
+	const CFuint PackSize = _PackList.size();
+	for (CFuint j=0; j<PackSize; j++) {
+	  std::memcpy (Buffer + j*ElementSize, Data + _PackList[j]*ElementSize, ElementSize);
+	}
+	
+	if (!_PersistentSendRequests.empty()) {
+	  Common::CheckMPIStatus(MPI_Startall (_PersistentSendRequests.size(),
+					       &_PersistentSendRequests[0]));
+	}
+	
+	_SyncPending = true;
+	return;
+      }
 
       //
       // TODO: dit kan beter
@@ -1426,6 +1612,8 @@ typename MPICommPattern<DATA>::IndexType MPICommPattern<DATA>::AllocNext ()
 					_Communicator, &_SendRequests[i]));
     }
   }
+      
+      _SyncPending = true;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -1436,6 +1624,32 @@ typename MPICommPattern<DATA>::IndexType MPICommPattern<DATA>::AllocNext ()
     void MPICommPattern<DATA>::EndSync ()
     {
       cf_assert (_InitMPIOK);
+      
+      if (!_SyncPending) return;
+      
+      if (_PackedSync) {
+	if (!_PersistentReceiveRequests.empty()) {
+	  Common::CheckMPIStatus(MPI_Waitall (_PersistentReceiveRequests.size(),
+					      &_PersistentReceiveRequests[0], MPI_STATUSES_IGNORE));
+	}
+	
+	// the received elements are copied back to the ghost points
+	char *const Data = reinterpret_cast<char*>(m_data->ptr());
+	const char *const Buffer = (_ReceiveBuffer.empty()) ? CFNULL : &_ReceiveBuffer[0];
+	const size_t ElementSize = _ElementSize;
+	const CFuint UnpackSize = _UnpackList.size();
+	for (CFuint j=0; j<UnpackSize; j++) {
+	  std::memcpy (Data + _UnpackList[j]*ElementSize, Buffer + j*ElementSize, ElementSize);
+	}
+	
+	if (!_PersistentSendRequests.empty()) {
+	  Common::CheckMPIStatus(MPI_Waitall (_PersistentSendRequests.size(),
+					      &_PersistentSendRequests[0], MPI_STATUSES_IGNORE));
+	}
+	
+	_SyncPending = false;
+	return;
+      }
 
       // In feite is volgende niet nodig aangezien receives niet kunnen
       // klaar zijn alvorens de sends klaar zijn
@@ -1443,6 +1657,8 @@ typename MPICommPattern<DATA>::IndexType MPICommPattern<DATA>::AllocNext ()
       // Misschien 1 grote array gebruiken om 1 MPI_Waitall te kunnen doen
       Common::CheckMPIStatus(MPI_Waitall (_CommSize, &_SendRequests[0], MPI_STATUSES_IGNORE));
       Common::CheckMPIStatus(MPI_Waitall (_CommSize, &_ReceiveRequests[0], MPI_STATUSES_IGNORE));
+      
+      _SyncPending = false;
     }
 
 
@@ -1579,6 +1795,8 @@ typename MPICommPattern<DATA>::IndexType MPICommPattern<DATA>::AllocNext ()
 #endif
       //    MPI_Waitall (_CommSize, _ReceiveRequests, MPI_STATUSES_IGNORE);
       //    MPI_Waitall (_CommSize, _ReceiveRequests, MPI_STATUSES_IGNORE);
+      
+      Sync_FreePersistentRequests ();
 
       for (int i = 0; i <_CommSize; i++) {
        	if (_SendTypes[i]!=MPI_DATATYPE_NULL) {
@@ -1658,7 +1876,8 @@ MPICommPattern<DATA>::MPICommPattern (const std::string nspaceName,
 				      DATA* data, const T & Init, CFuint Size, CFuint ESize)
   : _ElementSize(ESize), _LocalSize(0), _GhostSize(0),
     _NextFree(_NO_MORE_FREE), m_data(data), _MetaData(DataType(), 0),
-    _IsIndexed(false), _InitMPIOK(false), _CGlobalValid(false)
+    _IsIndexed(false), _InitMPIOK(false), _SyncPending(false), _CGlobalValid(false),
+    _PackedSync(false)
 {
   if (ESize > 0) {
     InitMPI (nspaceName);
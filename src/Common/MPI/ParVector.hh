@@ -109,8 +109,15 @@ public: // functions
   /// end the synchronization
   void EndSync() { m_pattern->EndSync();}
   
+  /// check if a synchronization was started and not yet ended
+  bool IsSyncPending() const {return m_pattern->IsSyncPending();}
+  
   /// Build Sync table
-  void BuildGhostMap () { m_pattern->BuildGhostMap();}
+  /// @param packedSync  synchronise through packed buffers and persistent requests
+  void BuildGhostMap (bool packedSync = false) { m_pattern->BuildGhostMap(packedSync);}
+
+  /// Move each element i to position newIDs[i] (before BuildGhostMap)
+  void Renumber (const std::vector<IndexType>& newIDs) { m_pattern->Renumber(newIDs);}
   
   /// Returns the list of ghost nodes (by processor rank) to be sent to
   /// another processor
@@ -0,0 +1,120 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <fstream>
+
+#include "Common/MemoryMappedFile.hh"
+#include "Common/FilesystemException.hh"
+
+#ifdef CF_HAVE_ALLOC_MMAP
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MemoryMappedFile::MemoryMappedFile() :
+  m_data(CFNULL),
+  m_size(0),
+  m_buffer()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+  close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void MemoryMappedFile::open(const std::string& fileName)
+{
+  close();
+
+#ifdef CF_HAVE_ALLOC_MMAP
+  const int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw FilesystemException (FromHere(), "Could not open file: " + fileName);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    ::close(fd);
+    throw FilesystemException (FromHere(), "Could not stat file: " + fileName);
+  }
+  m_size = st.st_size;
+
+  if (m_size > 0) {
+    void* ptr = mmap(0, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+      ::close(fd);
+      m_size = 0;
+      throw FilesystemException (FromHere(), "Could not map file: " + fileName);
+    }
+    m_data = static_cast<const char*>(ptr);
+  }
+  else {
+    // an empty file cannot be mapped
+    m_buffer.resize(1);
+    m_data = &m_buffer[0];
+  }
+
+  // the mapping stays valid after the file descriptor is closed
+  ::close(fd);
+#else
+  std::ifstream fin(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    throw FilesystemException (FromHere(), "Could not open file: " + fileName);
+  }
+  fin.seekg(0, std::ios::end);
+  m_size = fin.tellg();
+  fin.seekg(0, std::ios::beg);
+  m_buffer.resize(m_size + 1);
+  fin.read(&m_buffer[0], m_size);
+  if (!fin) {
+    m_size = 0;
+    std::vector<char>().swap(m_buffer);
+    throw FilesystemException (FromHere(), "Could not read file: " + fileName);
+  }
+  m_data = &m_buffer[0];
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void MemoryMappedFile::close()
+{
+  if (m_data == CFNULL) return;
+
+#ifdef CF_HAVE_ALLOC_MMAP
+  if (m_buffer.empty()) {
+    munmap(const_cast<char*>(m_data), m_size);
+  }
+#endif
+
+  std::vector<char>().swap(m_buffer);
+  m_data = CFNULL;
+  m_size = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,76 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Common_MemoryMappedFile_hh
+#define COOLFluiD_Common_MemoryMappedFile_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/NonCopyable.hh"
+#include "Common/COOLFluiD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class gives a read-only view on the whole content of a file.
+/// Where mmap is available, the file is mapped in memory, so that the pages
+/// are loaded on demand and shared by all the processes on the same node
+/// which map the same file, as long as they read them through data() rather
+/// than copying them. Otherwise, the file is read into a buffer.
+class Common_API MemoryMappedFile : public Common::NonCopyable<MemoryMappedFile> {
+public:
+
+  /// Constructor
+  MemoryMappedFile();
+
+  /// Destructor (closes the file if still open)
+  ~MemoryMappedFile();
+
+  /// Open and map the given file
+  /// @throw FilesystemException if the file cannot be opened or mapped
+  void open(const std::string& fileName);
+
+  /// Unmap and close the file
+  void close();
+
+  /// Tells if a file is currently mapped
+  bool isOpen() const {return m_data != CFNULL;}
+
+  /// Get the pointer to the first byte of the file
+  const char* data() const {return m_data;}
+
+  /// Get the size of the file in bytes
+  size_t size() const {return m_size;}
+
+private: // data
+
+  /// pointer to the content of the file
+  const char* m_data;
+
+  /// size of the file in bytes
+  size_t m_size;
+
+  /// buffer holding the file when mmap is not available
+  std::vector<char> m_buffer;
+
+}; // end of class MemoryMappedFile
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Common_MemoryMappedFile_hh
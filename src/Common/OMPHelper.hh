@@ -0,0 +1,80 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Common_OMPHelper_hh
+#define COOLFluiD_Common_OMPHelper_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#ifdef CF_HAVE_OMP
+#include <omp.h>
+#endif
+
+#include "Common/COOLFluiD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Thin wrappers around the OpenMP runtime, so that shared-memory code paths
+/// compile (and run on one thread) when COOLFluiD is built without
+/// CF_ENABLE_OMP.
+
+/// @return the number of threads that a parallel region will use
+inline CFuint getMaxThreadsOMP()
+{
+#ifdef CF_HAVE_OMP
+  return static_cast<CFuint>(omp_get_max_threads());
+#else
+  return 1;
+#endif
+}
+
+/// @return the ID of the calling thread inside a parallel region
+inline CFuint getThreadIDOMP()
+{
+#ifdef CF_HAVE_OMP
+  return static_cast<CFuint>(omp_get_thread_num());
+#else
+  return 0;
+#endif
+}
+
+/// Compute the number of threads to use, given the user setting
+/// @param nbThreads  requested number of threads (0 means "all available")
+inline CFuint getNbThreadsOMP(const CFuint nbThreads)
+{
+#ifdef CF_HAVE_OMP
+  return (nbThreads > 0) ? nbThreads : getMaxThreadsOMP();
+#else
+  return 1;
+#endif
+}
+
+/// Split the range [0, size) into nbParts contiguous chunks of (almost) equal
+/// size and return the bounds of the chunk iPart
+inline void getChunkOMP(const CFuint size, const CFuint nbParts, const CFuint iPart,
+			CFuint& start, CFuint& end)
+{
+  const CFuint chunk = size/nbParts;
+  const CFuint rest  = size%nbParts;
+  start = iPart*chunk + ((iPart < rest) ? iPart : rest);
+  end   = start + chunk + ((iPart < rest) ? 1 : 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Common_OMPHelper_hh
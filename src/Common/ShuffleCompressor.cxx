@@ -0,0 +1,100 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/ShuffleCompressor.hh"
+#include "Common/FilesystemException.hh"
+
+#ifdef CF_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool ShuffleCompressor::isAvailable()
+{
+#ifdef CF_HAVE_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ShuffleCompressor::compress(const char* data, const size_t nbValues,
+                                 const size_t valueSize, const int level,
+                                 std::vector<char>& out)
+{
+#ifdef CF_HAVE_ZLIB
+  const size_t nbBytes = nbValues*valueSize;
+  if (nbBytes == 0) return;
+
+  // byte i of value j goes to position i*nbValues + j
+  std::vector<char> shuffled(nbBytes);
+  for (size_t j = 0; j < nbValues; ++j) {
+    const char* value = data + j*valueSize;
+    for (size_t i = 0; i < valueSize; ++i) {
+      shuffled[i*nbValues + j] = value[i];
+    }
+  }
+
+  const size_t start = out.size();
+  uLongf compressedSize = compressBound(nbBytes);
+  out.resize(start + compressedSize);
+  const int err = compress2(reinterpret_cast<Bytef*>(&out[start]), &compressedSize,
+                            reinterpret_cast<const Bytef*>(&shuffled[0]), nbBytes, level);
+  if (err != Z_OK) {
+    out.resize(start);
+    throw FilesystemException (FromHere(), "ShuffleCompressor: zlib compression failed");
+  }
+  out.resize(start + compressedSize);
+#else
+  throw FilesystemException (FromHere(), "ShuffleCompressor: COOLFluiD was built without zlib");
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ShuffleCompressor::decompress(const char* data, const size_t dataSize,
+                                   const size_t nbValues, const size_t valueSize,
+                                   char* out)
+{
+#ifdef CF_HAVE_ZLIB
+  const size_t nbBytes = nbValues*valueSize;
+  if (nbBytes == 0) return;
+
+  std::vector<char> shuffled(nbBytes);
+  uLongf uncompressedSize = nbBytes;
+  const int err = uncompress(reinterpret_cast<Bytef*>(&shuffled[0]), &uncompressedSize,
+                             reinterpret_cast<const Bytef*>(data), dataSize);
+  if (err != Z_OK || uncompressedSize != nbBytes) {
+    throw FilesystemException (FromHere(), "ShuffleCompressor: corrupted compressed data");
+  }
+
+  for (size_t j = 0; j < nbValues; ++j) {
+    char* value = out + j*valueSize;
+    for (size_t i = 0; i < valueSize; ++i) {
+      value[i] = shuffled[i*nbValues + j];
+    }
+  }
+#else
+  throw FilesystemException (FromHere(), "ShuffleCompressor: COOLFluiD was built without zlib");
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
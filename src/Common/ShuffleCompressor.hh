@@ -0,0 +1,68 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Common_ShuffleCompressor_hh
+#define COOLFluiD_Common_ShuffleCompressor_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/NonInstantiable.hh"
+#include "Common/COOLFluiD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class compresses arrays of fixed size values without loss.
+/// The bytes of the values are first shuffled, so that the bytes with the
+/// same significance are stored next to each other (as the shuffle filter
+/// of HDF5), which makes floating point data much more compressible, and
+/// the result is then compressed with zlib.
+class Common_API ShuffleCompressor : public Common::NonInstantiable<ShuffleCompressor> {
+public:
+
+  /// Tells if the compression is available (COOLFluiD was built with zlib)
+  static bool isAvailable();
+
+  /// Compress an array of values
+  /// @param data       pointer to the first value
+  /// @param nbValues   number of values
+  /// @param valueSize  size of each value in bytes
+  /// @param level      zlib compression level (1 to 9)
+  /// @param out        buffer to which the compressed bytes are appended
+  /// @throw FilesystemException if the compression fails
+  static void compress(const char* data, const size_t nbValues,
+                       const size_t valueSize, const int level,
+                       std::vector<char>& out);
+
+  /// Decompress an array of values
+  /// @param data       pointer to the first compressed byte
+  /// @param dataSize   number of compressed bytes
+  /// @param nbValues   number of values
+  /// @param valueSize  size of each value in bytes
+  /// @param out        pointer where to write the nbValues*valueSize bytes
+  /// @throw FilesystemException if the data are corrupted
+  static void decompress(const char* data, const size_t dataSize,
+                         const size_t nbValues, const size_t valueSize,
+                         char* out);
+
+}; // end of class ShuffleCompressor
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Common_ShuffleCompressor_hh
@@ -69,6 +69,7 @@ void CFEnv::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< bool >    ("ErrorOnUnusedConfig","Signal error when some user provided config parameters are not used");
   options.addConfigOption< std::string >("MainLoggerFileName", "Name of main log file");
   options.addConfigOption< CFuint >("NbWriters", "Number of writing processes in parallel I/O");
+  options.addConfigOption< bool >  ("PackedSync", "Synchronize the parallel data through packed buffers and persistent MPI requests");
 }
     
 //////////////////////////////////////////////////////////////////////////////
@@ -99,6 +100,7 @@ CFEnv::CFEnv() : Config::ConfigObject("CFEnv"),
   setParameter("MainLoggerFileName",    &(m_env_vars->MainLoggerFileName));
   setParameter("ExceptionLogLevel",     &(m_env_vars->ExceptionLogLevel));
   setParameter("NbWriters",     &(m_env_vars->NbWriters));
+  setParameter("PackedSync",    &(m_env_vars->PackedSync));
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -55,6 +55,8 @@ class Environment_API CFEnvVars : public Common::NonCopyable<CFEnvVars>
     std::pair<int,char**> InitArgs;
     /// number of writing processes in parallel I/O
     CFuint NbWriters;
+    /// synchronize the parallel data through packed buffers and persistent requests
+    bool PackedSync;
     
 }; // end class CFEnvVars
 
@@ -0,0 +1,188 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <fstream>
+
+#include <boost/bind.hpp>
+
+#include "Common/CFLog.hh"
+#include "Common/FilesystemException.hh"
+#include "Framework/AsyncFileWriter.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncFileWriter::AsyncFileWriter() :
+  m_active(false),
+  m_maxBufferSize(0),
+  m_bufferSize(0),
+  m_writing(false),
+  m_stop(false),
+  m_jobs(),
+  m_failedFiles(),
+  m_mutex(),
+  m_jobPosted(),
+  m_jobDone(),
+  m_thread(CFNULL)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+  if (m_thread != CFNULL) {
+    {
+      boost::mutex::scoped_lock lock(m_mutex);
+      m_stop = true;
+    }
+    m_jobPosted.notify_all();
+
+    // the pending jobs are written before the thread exits
+    m_thread->join();
+    delete m_thread;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncFileWriter& AsyncFileWriter::getInstance()
+{
+  static AsyncFileWriter writer;
+  return writer;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AsyncFileWriter::setActive(const bool active, const size_t maxBufferSize)
+{
+  // the files posted so far must not be reordered with the following ones
+  if (!active) {
+    flush();
+  }
+
+  m_active = active;
+  m_maxBufferSize = maxBufferSize;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AsyncFileWriter::post(const boost::filesystem::path& filepath, std::string& content)
+{
+  if (!m_active) {
+    if (!writeFile(filepath, content)) {
+      throw FilesystemException(FromHere(), "AsyncFileWriter: could not write " + filepath.string());
+    }
+    content.clear();
+    return;
+  }
+
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  if (m_thread == CFNULL) {
+    m_thread = new boost::thread(boost::bind(&AsyncFileWriter::run, this));
+  }
+
+  // backpressure: wait until the new file fits in the buffer
+  // (a file larger than the buffer is accepted once the buffer is empty)
+  while (m_bufferSize > 0 && m_bufferSize + content.size() > m_maxBufferSize) {
+    m_jobDone.wait(lock);
+  }
+
+  m_jobs.push_back(Job());
+  m_jobs.back().filepath = filepath;
+  m_jobs.back().content.swap(content);
+  m_bufferSize += m_jobs.back().content.size();
+
+  m_jobPosted.notify_one();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AsyncFileWriter::flush()
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  while (!m_jobs.empty() || m_writing) {
+    m_jobDone.wait(lock);
+  }
+
+  if (!m_failedFiles.empty()) {
+    const string failedFiles = m_failedFiles;
+    m_failedFiles.clear();
+    throw FilesystemException(FromHere(), "AsyncFileWriter: could not write" + failedFiles);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AsyncFileWriter::run()
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  for (;;) {
+    while (m_jobs.empty() && !m_stop) {
+      m_jobPosted.wait(lock);
+    }
+
+    if (m_jobs.empty()) {
+      // stop requested and nothing left to write
+      return;
+    }
+
+    Job job;
+    job.filepath = m_jobs.front().filepath;
+    job.content.swap(m_jobs.front().content);
+    m_jobs.pop_front();
+    m_writing = true;
+
+    // the file is written without holding the lock
+    lock.unlock();
+    const bool written = writeFile(job.filepath, job.content);
+    lock.lock();
+
+    if (!written) {
+      m_failedFiles += " " + job.filepath.string();
+    }
+    m_bufferSize -= job.content.size();
+    m_writing = false;
+
+    m_jobDone.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool AsyncFileWriter::writeFile(const boost::filesystem::path& filepath,
+                                const std::string& content)
+{
+  ofstream fout(filepath.string().c_str(), ios_base::out | ios_base::binary);
+  if (!fout) {
+    return false;
+  }
+
+  fout.write(content.data(), content.size());
+  fout.close();
+  return !fout.fail();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
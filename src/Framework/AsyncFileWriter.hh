@@ -0,0 +1,129 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Framework_AsyncFileWriter_hh
+#define COOLFluiD_Framework_AsyncFileWriter_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/thread.hpp>
+
+#include "Common/NonCopyable.hh"
+#include "Framework/Framework.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a singleton object which writes files to disk
+/// from a background thread, so that the solution output overlaps with the
+/// following iterations. The writers produce the whole content of a file in
+/// memory and post it here. The amount of data waiting to be written is
+/// bounded: posting blocks until enough data has been drained.
+/// This class is a Singleton pattern implementation.
+class Framework_API AsyncFileWriter : public Common::NonCopyable<AsyncFileWriter> {
+
+public: // methods
+
+  /// @return the instance of this singleton
+  static AsyncFileWriter& getInstance();
+
+  /// Activates or deactivates the asynchronous writing
+  /// @param active         if false, the files are written immediately
+  /// @param maxBufferSize  maximum number of bytes waiting to be written
+  void setActive(const bool active, const size_t maxBufferSize);
+
+  /// @return true if the files are written asynchronously
+  bool isActive() const
+  {
+    return m_active;
+  }
+
+  /// Posts a file to be written in the background. The content is taken
+  /// from the given string, which is left empty.
+  /// @param filepath path of the file
+  /// @param content  content of the file
+  void post(const boost::filesystem::path& filepath, std::string& content);
+
+  /// Waits until all the posted files have been written
+  /// @throw Common::FilesystemException if some file could not be written
+  void flush();
+
+private: // methods
+
+  /// Default constructor
+  AsyncFileWriter();
+
+  /// Destructor, waits for the pending files
+  ~AsyncFileWriter();
+
+  /// Loop of the background thread
+  void run();
+
+  /// Write the given file
+  /// @return false if the file could not be written
+  static bool writeFile(const boost::filesystem::path& filepath, const std::string& content);
+
+private: // data
+
+  /// a file waiting to be written
+  struct Job {
+    boost::filesystem::path filepath;
+    std::string content;
+  };
+
+  /// flag telling if the files are written asynchronously
+  bool m_active;
+
+  /// maximum number of bytes waiting to be written
+  size_t m_maxBufferSize;
+
+  /// number of bytes waiting to be written, including the file being written
+  size_t m_bufferSize;
+
+  /// flag telling if a file is being written
+  bool m_writing;
+
+  /// flag telling the background thread to stop
+  bool m_stop;
+
+  /// files waiting to be written
+  std::deque<Job> m_jobs;
+
+  /// files that could not be written since the last flush
+  std::string m_failedFiles;
+
+  /// mutex protecting the data shared with the background thread
+  boost::mutex m_mutex;
+
+  /// signals a new job or the stop request to the background thread
+  boost::condition_variable m_jobPosted;
+
+  /// signals the completion of a job to the posting thread
+  boost::condition_variable m_jobDone;
+
+  /// background thread (created at the first post)
+  boost::thread* m_thread;
+
+}; // end of class AsyncFileWriter
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Framework_AsyncFileWriter_hh
@@ -0,0 +1,337 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <limits>
+
+#include "Common/BadValueException.hh"
+#include "MathTools/RCM.h"
+#include "MathTools/SpaceFillingCurve.hh"
+#include "Framework/CFmeshRenumberer.hh"
+#include "Framework/MeshData.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::MathTools;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CFmeshRenumberer::renumber(CFmeshReaderSource& data, const std::string& method)
+{
+  CFAUTOTRACE;
+
+  if (data.storePastStates() || data.storePastNodes() ||
+      data.storeInterStates() || data.storeInterNodes() ||
+      data.getNbExtraVars() > 0 || data.getNbExtraNodalVars() > 0 ||
+      data.getNbExtraStateVars() > 0) {
+    CFLog(WARN, "CFmeshRenumberer::renumber() => past/intermediate data or extra "
+	  << "variables are stored with the mesh: renumbering skipped\n");
+    return;
+  }
+
+  ConnectivityTable<CFuint>& elemNode  = *data.getElementNodeTable();
+  ConnectivityTable<CFuint>& elemState = *data.getElementStateTable();
+  DataHandle<Node*, GLOBAL> nodes   = data.getNodesHandle();
+  DataHandle<State*, GLOBAL> states = data.getStatesHandle();
+  const CFuint nbElems  = elemNode.nbRows();
+  const CFuint nbNodes  = nodes.size();
+  const CFuint nbStates = states.size();
+  cf_assert(elemState.nbRows() == nbElems);
+
+  // order of the elements: elemOrder[new ID] = old ID
+  vector<CFuint> elemOrder;
+  if (method == "RCM") {
+    computeGraphOrder(elemNode, nbNodes, elemOrder);
+  }
+  else if (method == "Hilbert" || method == "Morton") {
+    computeCurveOrder(elemNode, nodes, (method == "Hilbert"), elemOrder);
+  }
+  else {
+    throw BadValueException(FromHere(), "CFmeshRenumberer::renumber() => unknown method " + method);
+  }
+
+  // the elements of each type must remain contiguous
+  SafePtr<vector<ElementTypeData> > elementType = data.getElementTypeData();
+  if (elementType->size() > 1) {
+    vector<CFuint> typeOrder;
+    typeOrder.reserve(nbElems);
+    for (CFuint iType = 0; iType < elementType->size(); ++iType) {
+      const CFuint start = (*elementType)[iType].getStartIdx();
+      const CFuint end   = (*elementType)[iType].getEndIdx();
+      for (CFuint i = 0; i < nbElems; ++i) {
+	if (elemOrder[i] >= start && elemOrder[i] < end) {
+	  typeOrder.push_back(elemOrder[i]);
+	}
+      }
+    }
+    cf_assert(typeOrder.size() == nbElems);
+    elemOrder.swap(typeOrder);
+  }
+
+  vector<CFuint> newStateIDs;
+  vector<CFuint> newNodeIDs;
+  numberByFirstTouch(elemState, elemOrder, nbStates, newStateIDs);
+  numberByFirstTouch(elemNode,  elemOrder, nbNodes,  newNodeIDs);
+
+  permuteTable(elemState, elemOrder, newStateIDs);
+  permuteTable(elemNode,  elemOrder, newNodeIDs);
+
+  vector<CFuint> newElemIDs(nbElems);
+  for (CFuint i = 0; i < nbElems; ++i) {
+    newElemIDs[elemOrder[i]] = i;
+  }
+
+  SafePtr<vector<CFuint> > globalElementIDs = MeshDataStack::getActive()->getGlobalElementIDs();
+  if (globalElementIDs->size() == nbElems) {
+    const vector<CFuint> oldGlobalIDs(*globalElementIDs);
+    for (CFuint i = 0; i < nbElems; ++i) {
+      (*globalElementIDs)[i] = oldGlobalIDs[elemOrder[i]];
+    }
+  }
+
+  SafePtr<vector<vector<CFuint> > > groupElements = data.getGroupElementLists();
+  for (CFuint iGroup = 0; iGroup < groupElements->size(); ++iGroup) {
+    vector<CFuint>& elems = (*groupElements)[iGroup];
+    for (CFuint i = 0; i < elems.size(); ++i) {
+      elems[i] = newElemIDs[elems[i]];
+    }
+  }
+
+  renumberGeoConn(data, newStateIDs, newNodeIDs);
+
+  renumberDofs(states, newStateIDs);
+  renumberDofs(nodes, newNodeIDs);
+
+  CFLog(INFO, "CFmeshRenumberer::renumber() => " << method << " applied to "
+	<< nbElems << " elements, " << nbStates << " states, " << nbNodes << " nodes\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CFmeshRenumberer::computeGraphOrder(const ConnectivityTable<CFuint>& elemNode,
+					 const CFuint nbNodes,
+					 vector<CFuint>& elemOrder)
+{
+  const CFuint nbElems = elemNode.nbRows();
+
+  // node-to-element incidence
+  vector<CFuint> nodePtr(nbNodes+1, 0);
+  for (CFuint e = 0; e < nbElems; ++e) {
+    for (CFuint j = 0; j < elemNode.nbCols(e); ++j) {
+      nodePtr[elemNode(e,j)+1]++;
+    }
+  }
+  for (CFuint n = 0; n < nbNodes; ++n) {
+    nodePtr[n+1] += nodePtr[n];
+  }
+  vector<CFuint> nodeElems(nodePtr[nbNodes]);
+  vector<CFuint> fill(nodePtr.begin(), nodePtr.end()-1);
+  for (CFuint e = 0; e < nbElems; ++e) {
+    for (CFuint j = 0; j < elemNode.nbCols(e); ++j) {
+      const CFuint n = elemNode(e,j);
+      nodeElems[fill[n]++] = e;
+    }
+  }
+
+  // element-to-element graph through the shared nodes
+  vector<CFuint> ptr(nbElems+1, 0);
+  vector<CFuint> adj;
+  adj.reserve(nodePtr[nbNodes]*4);
+  const CFuint noElem = numeric_limits<CFuint>::max();
+  vector<CFuint> lastSeen(nbElems, noElem);
+  for (CFuint e = 0; e < nbElems; ++e) {
+    lastSeen[e] = e;
+    for (CFuint j = 0; j < elemNode.nbCols(e); ++j) {
+      const CFuint n = elemNode(e,j);
+      for (CFuint k = nodePtr[n]; k < nodePtr[n+1]; ++k) {
+	const CFuint other = nodeElems[k];
+	if (lastSeen[other] != e) {
+	  lastSeen[other] = e;
+	  adj.push_back(other);
+	}
+      }
+    }
+    ptr[e+1] = adj.size();
+  }
+
+  RCM::renumberGraph(ptr, adj, elemOrder);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CFmeshRenumberer::computeCurveOrder(const ConnectivityTable<CFuint>& elemNode,
+					 DataHandle<Node*, GLOBAL>& nodes,
+					 const bool useHilbert,
+					 vector<CFuint>& elemOrder)
+{
+  const CFuint nbElems = elemNode.nbRows();
+  const CFuint dim = (nodes.size() > 0) ? nodes[0]->size() : 1;
+
+  vector<CFreal> centroids(nbElems*dim, 0.);
+  for (CFuint e = 0; e < nbElems; ++e) {
+    const CFuint nbNodesInElem = elemNode.nbCols(e);
+    for (CFuint j = 0; j < nbNodesInElem; ++j) {
+      const Node& node = *nodes[elemNode(e,j)];
+      for (CFuint d = 0; d < dim; ++d) {
+	centroids[e*dim+d] += node[d];
+      }
+    }
+    for (CFuint d = 0; d < dim; ++d) {
+      centroids[e*dim+d] /= static_cast<CFreal>(nbNodesInElem);
+    }
+  }
+
+  SpaceFillingCurve::sortPoints(centroids, dim, useHilbert, elemOrder);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CFmeshRenumberer::numberByFirstTouch(const ConnectivityTable<CFuint>& table,
+					  const vector<CFuint>& rowOrder,
+					  const CFuint nbEntries,
+					  vector<CFuint>& newIDs)
+{
+  const CFuint noID = numeric_limits<CFuint>::max();
+  newIDs.assign(nbEntries, noID);
+
+  CFuint count = 0;
+  for (CFuint i = 0; i < rowOrder.size(); ++i) {
+    const CFuint row = rowOrder[i];
+    for (CFuint j = 0; j < table.nbCols(row); ++j) {
+      const CFuint id = table(row,j);
+      cf_assert(id < nbEntries);
+      if (newIDs[id] == noID) {
+	newIDs[id] = count++;
+      }
+    }
+  }
+
+  // entries not referenced by any element keep their relative order at the end
+  for (CFuint id = 0; id < nbEntries; ++id) {
+    if (newIDs[id] == noID) {
+      newIDs[id] = count++;
+    }
+  }
+  cf_assert(count == nbEntries);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CFmeshRenumberer::permuteTable(ConnectivityTable<CFuint>& table,
+				    const vector<CFuint>& rowOrder,
+				    const vector<CFuint>& newIDs)
+{
+  const ConnectivityTable<CFuint> oldTable(table);
+  const CFuint nbRows = oldTable.nbRows();
+
+  valarray<CFuint> pattern(nbRows);
+  for (CFuint i = 0; i < nbRows; ++i) {
+    pattern[i] = oldTable.nbCols(rowOrder[i]);
+  }
+  table.resize(pattern);
+
+  for (CFuint i = 0; i < nbRows; ++i) {
+    const CFuint oldRow = rowOrder[i];
+    for (CFuint j = 0; j < pattern[i]; ++j) {
+      table(i,j) = newIDs[oldTable(oldRow,j)];
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CFmeshRenumberer::renumberGeoConn(CFmeshReaderSource& data,
+				       const vector<CFuint>& newStateIDs,
+				       const vector<CFuint>& newNodeIDs)
+{
+  vector<TRGeoConn>& geoConn = *data.getGeoConn();
+  SafePtr<vector<vector<vector<CFuint> > > > trsGlobalIDs =
+    MeshDataStack::getActive()->getGlobalTRSGeoIDs();
+  const bool hasGlobalIDs = (trsGlobalIDs->size() == geoConn.size());
+
+  vector<pair<CFuint, CFuint> > geoKeys;
+  for (CFuint iTRS = 0; iTRS < geoConn.size(); ++iTRS) {
+    TRGeoConn& trGeoConn = geoConn[iTRS];
+    for (CFuint iTR = 0; iTR < trGeoConn.size(); ++iTR) {
+      GeoConn& geos = trGeoConn[iTR];
+      const CFuint nbGeos = geos.size();
+      geoKeys.resize(nbGeos);
+
+      for (CFuint iGeo = 0; iGeo < nbGeos; ++iGeo) {
+	GeoConnElementPart& nodeIDs  = geos[iGeo].first;
+	GeoConnElementPart& stateIDs = geos[iGeo].second;
+	CFuint key = numeric_limits<CFuint>::max();
+	for (CFuint i = 0; i < stateIDs.size(); ++i) {
+	  stateIDs[i] = newStateIDs[stateIDs[i]];
+	  key = min(key, stateIDs[i]);
+	}
+	for (CFuint i = 0; i < nodeIDs.size(); ++i) {
+	  nodeIDs[i] = newNodeIDs[nodeIDs[i]];
+	}
+	if (stateIDs.size() == 0) {
+	  for (CFuint i = 0; i < nodeIDs.size(); ++i) {
+	    key = min(key, nodeIDs[i]);
+	  }
+	}
+	geoKeys[iGeo] = make_pair(key, iGeo);
+      }
+
+      // sort the geometric entities of the TR by the first state they touch
+      sort(geoKeys.begin(), geoKeys.end());
+      const GeoConn oldGeos(geos);
+      for (CFuint iGeo = 0; iGeo < nbGeos; ++iGeo) {
+	geos[iGeo] = oldGeos[geoKeys[iGeo].second];
+      }
+
+      if (hasGlobalIDs && iTR < (*trsGlobalIDs)[iTRS].size() &&
+	  (*trsGlobalIDs)[iTRS][iTR].size() == nbGeos) {
+	vector<CFuint>& globalIDs = (*trsGlobalIDs)[iTRS][iTR];
+	const vector<CFuint> oldGlobalIDs(globalIDs);
+	for (CFuint iGeo = 0; iGeo < nbGeos; ++iGeo) {
+	  globalIDs[iGeo] = oldGlobalIDs[geoKeys[iGeo].second];
+	}
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename DOF>
+void CFmeshRenumberer::renumberDofs(DataHandle<DOF*, GLOBAL>& dofs,
+				    const vector<CFuint>& newIDs)
+{
+  // this moves the pointers and, in parallel, the values in the
+  // global storage together with their global IDs
+  dofs.renumber(newIDs);
+
+  for (CFuint i = 0; i < dofs.size(); ++i) {
+    DOF *const dof = dofs[i];
+    dof->setLocalID(i);
+#ifndef CF_GLOBAL_EQUAL_LOCAL
+    // the dofs viewing the global storage must follow their values
+    if (!dof->isMemoryOwner()) {
+      dof->wrap(dof->size(), dofs.getGlobalData(i));
+    }
+#endif
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
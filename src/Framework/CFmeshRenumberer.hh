@@ -0,0 +1,92 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Framework_CFmeshRenumberer_hh
+#define COOLFluiD_Framework_CFmeshRenumberer_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Framework/CFmeshReaderSource.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class renumbers, locally to each processor, the mesh data read from
+/// a CFmesh file before the MeshData (TRSs, cells, faces) is built from it.
+///
+/// The elements are ordered with the Reverse Cuthill-McKee algorithm on their
+/// node-sharing graph ("RCM") or along a space-filling curve through their
+/// centroids ("Hilbert", "Morton"), keeping the elements of each type
+/// contiguous. States and nodes are then numbered by first touch in the new
+/// element order, and the geometric entities of each TR are sorted by their
+/// smallest new state ID. Since the faces are created by looping over the
+/// cells, this improves the locality of the cell and face loops and reduces
+/// the bandwidth of the system matrix.
+///
+/// The global IDs, hence the parallel communication pattern and the output
+/// files, are not affected.
+class Framework_API CFmeshRenumberer {
+public:
+
+  /// Renumber the given mesh data
+  /// @param data    mesh data local to this processor
+  /// @param method  "RCM", "Hilbert" or "Morton"
+  /// @pre the parallel data handles have not been synchronized yet (no buildMap())
+  static void renumber(CFmeshReaderSource& data, const std::string& method);
+
+private:
+
+  /// Order the elements with RCM applied to the graph of the elements sharing a node
+  static void computeGraphOrder(const Common::ConnectivityTable<CFuint>& elemNode,
+				const CFuint nbNodes,
+				std::vector<CFuint>& elemOrder);
+
+  /// Order the elements along a space-filling curve through their centroids
+  static void computeCurveOrder(const Common::ConnectivityTable<CFuint>& elemNode,
+				DataHandle<Node*, GLOBAL>& nodes,
+				const bool useHilbert,
+				std::vector<CFuint>& elemOrder);
+
+  /// Number the entries referenced by the rows of table by first touch,
+  /// visiting the rows in the given order
+  /// @param newIDs  on output, new ID of each entry
+  static void numberByFirstTouch(const Common::ConnectivityTable<CFuint>& table,
+				 const std::vector<CFuint>& rowOrder,
+				 const CFuint nbEntries,
+				 std::vector<CFuint>& newIDs);
+
+  /// Reorder the rows of the table and renumber its entries
+  static void permuteTable(Common::ConnectivityTable<CFuint>& table,
+			   const std::vector<CFuint>& rowOrder,
+			   const std::vector<CFuint>& newIDs);
+
+  /// Renumber the states and the nodes in the geometric entities of the TRSs
+  /// and sort the geometric entities of each TR by their first state
+  static void renumberGeoConn(CFmeshReaderSource& data,
+			      const std::vector<CFuint>& newStateIDs,
+			      const std::vector<CFuint>& newNodeIDs);
+
+  /// Move the dofs (states or nodes) to their new local ID
+  template <typename DOF>
+  static void renumberDofs(DataHandle<DOF*, GLOBAL>& dofs,
+			   const std::vector<CFuint>& newIDs);
+
+}; // end of class CFmeshRenumberer
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Framework_CFmeshRenumberer_hh
@@ -224,6 +224,12 @@ public:
   /// Derived classes should implement the checks dependent on the concrete physics
   virtual bool isValid (const RealVector& state)  {return true;}
   
+  /// Tells if several copies of this variable set sharing the same PhysicalModel
+  /// can compute physical data, fluxes and eigenvalues concurrently. 
+  /// Variable sets relying on a physical property library or on data shared 
+  /// through the convective term (e.g. thermodynamic tables) must return false.
+  virtual bool isThreadSafe() const {return false;}
+  
   /// Set the IDs corresponding to the velocity components in a State
   virtual void setStateVelocityIDs (std::vector<CFuint>& velIDs) = 0;
   
@@ -48,6 +48,7 @@ void ConvergenceMethod::defineConfigOptions(Config::OptionList& options)
    options.addConfigOption< CFuint >   ("ShowRate","Rate to show convergence message to stdout.");
    options.addConfigOption< bool >     ("ConvergenceFileOnlyP0","Indictate if only the processor 0 should write to file.");
    options.addConfigOption< std::string > ("StopCondition","The stop condition to control the iteration procedure.");
+   options.addConfigOption< bool >     ("OverlapSync","Overlap the synchronization of the states with the computation of the residual in the interior of each partition (only for the ConvergenceMethods supporting it, e.g. FwdEuler).");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -105,6 +106,9 @@ ConvergenceMethod::ConvergenceMethod(const std::string& name)
 
   m_onlyP0 = true;
   setParameter("ConvergenceFileOnlyP0",&m_onlyP0);
+  
+  m_overlapSync = false;
+  setParameter("OverlapSync",&m_overlapSync);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -326,7 +330,11 @@ void ConvergenceMethod::syncGlobalDataComputeResidual(const bool computeResidual
     getConvergenceMethodData()->updateResidual();
   }
 
-  if (isParallel)
+  // with overlapping, the exchange is completed either by a SpaceMethod able
+  // to compute the residual in the interior of the partition meanwhile, or by
+  // the first Method needing the ghost states (see Method::completeStatesSync()),
+  // this ConvergenceMethod included (see canOverlapSync())
+  if (isParallel && !(m_overlapSync && canOverlapSync()))
   {
     statedata.endSync();
     syncTimer.stop();
@@ -116,6 +116,13 @@ protected: // interface implementation functions
   /// This is the abstract function that the concrete methods must implement.
   virtual void takeStepImpl() = 0;
 
+  /// Tells if takeStepImpl() can go on while the synchronization of the states
+  /// started by syncGlobalDataComputeResidual() is in progress. In that case
+  /// takeStepImpl() is responsible for completing the synchronization before
+  /// its commands (prepare, intermediate, ...) use any non updatable state.
+  /// By default the synchronization is completed at once, even with OverlapSync.
+  virtual bool canOverlapSync() const {return false;}
+
 protected: // helper functions
 
   /// function which indicates if we have to update the convergence file
@@ -133,6 +140,8 @@ protected: // helper functions
   void syncAllAndComputeResidual(const bool computeResidual);
 
   /// Syncronize the states and compute the residual
+  /// If OverlapSync is active and canOverlapSync(), the synchronization of the states
+  /// is only started here and completed by the first Method that needs the ghost states
   void syncGlobalDataComputeResidual(const bool computeResidual);
 
   /// Prepare the convergence file
@@ -189,6 +198,10 @@ private: // member data
   /// flag to indicate if spatial residual must be computed separately (for implicit methods)
   bool m_outputSpaceResidual;
   
+  /// flag to indicate if the synchronization of the states can overlap with
+  /// the following computation (the exchange is left open after the update)
+  bool m_overlapSync;
+  
 }; // end ConvergenceMethod
 
 //////////////////////////////////////////////////////////////////////////////
@@ -70,6 +70,9 @@ public:
   
   /// This does nothing on a local datahandle
   void endSync () {}
+  
+  /// A local datahandle is never waiting for a synchronization
+  bool isSyncPending () const {return false;}
 
   /// This does nothing on a local datahandle
   void DumpContents () {}
@@ -110,7 +113,10 @@ public:
   void reserve (unsigned int S)  {   BaseClass::_ptr->reserve (S);  }
 
   /// buildMap does nothing on a pure local vector
-  void buildMap () {}
+  void buildMap (const bool packedSync = false) {}
+
+  /// Move each entry i to position newIDs[i]
+  void renumber (const std::vector<CFuint>& newIDs) { BaseClass::permuteLocal(newIDs); }
 
 }; // end class DataHandle
 
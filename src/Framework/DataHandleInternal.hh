@@ -9,6 +9,8 @@
 
 //////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
 #include "Common/SafePtr.hh"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -136,6 +138,24 @@ public: // functions
   /// get a pointer to the global array
   Common::SafePtr<StorageType> getLocalArray() const {return _ptr;}
   
+protected: // functions
+
+  /// Move each entry i of the local array to position newIDs[i]
+  void permuteLocal(const std::vector<CFuint>& newIDs) const
+  {
+    cf_assert(_ptr != CFNULL);
+    cf_assert(newIDs.size() == _ptr->size());
+    const CFuint size = _ptr->size();
+    std::vector<ElemType> backup(size);
+    for (CFuint i = 0; i < size; ++i) {
+      backup[i] = (*_ptr)[i];
+    }
+    for (CFuint i = 0; i < size; ++i) {
+      cf_assert(newIDs[i] < size);
+      (*_ptr)[newIDs[i]] = backup[i];
+    }
+  }
+  
 protected: // data
 
   /// the pointer to be handled.
@@ -132,15 +132,28 @@ public:
   }
 
   /// Build Sync table
-  void buildMap ()
+  /// @param packedSync  synchronise through packed buffers and persistent
+  ///                    MPI requests instead of derived datatypes
+  void buildMap (const bool packedSync = false)
   {
     Common::Stopwatch<Common::WallTime> timer;
     timer.start ();
-    _globalPtr->BuildGhostMap ();
+    _globalPtr->BuildGhostMap (packedSync);
     timer.stop();
     CFLog(VERBOSE, "DataHandle<MPI>::buildMap() " << timer.read() << "s\n");
   }
 
+  /// Move each entry i, together with its slot in the parallel storage,
+  /// to position newIDs[i]
+  /// @pre buildMap() has not been called yet
+  /// @post the entries pointing into the parallel storage must be
+  ///       redirected to their new slot by the caller
+  void renumber (const std::vector<CFuint>& newIDs)
+  {
+    BaseClass::permuteLocal(newIDs);
+    _globalPtr->Renumber (newIDs);
+  }
+
   /// This function returns the global (cross-processes) size of
   /// the underlying parallel array
   /// @return the global size of the parallel array
@@ -170,6 +183,13 @@ public:
     _globalPtr->EndSync ();
   }
   
+  /// check if a synchronization was started and not yet ended
+  bool isSyncPending () const
+  {
+    cf_assert(_globalPtr != NULL);
+    return _globalPtr->IsSyncPending ();
+  }
+  
   /// allocate memory dynamically before insertion 
   void reserve (const CFuint Size, 
 		const CFuint elementSize, 
@@ -101,6 +101,8 @@ void DataProcessingMethod::processData()
 
   pushNamespace();
   
+  completeStatesSync();
+  
   if (SubSystemStatusStack::getActive()->getNbIter() < m_stopIter 
       && SubSystemStatusStack::getActive()->getNbIter() >= m_startIter ) {
     processDataImpl();
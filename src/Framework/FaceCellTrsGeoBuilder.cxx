@@ -57,18 +57,24 @@ GeometricEntity* FaceCellTrsGeoBuilder::buildGE()
   cf_assert(m_fcdata.faces.isNotNull());
   const TopologicalRegionSet& faces = *m_fcdata.faces;
   
-  // local ID (in all the mesh) of the geometric entity to get
-  const CFuint geoType = faces.getGeoType(faceidx);
-  GeometricEntity *const currFace = _poolData[geoType][_countGeo[geoType]++];
-  
-  // set the local ID
-  currFace->setID(faces.getLocalGeoID(faceidx));
-  
-  // set nodes in current face
-  const CFuint nbGeoNodes = faces.getNbNodesInGeo(faceidx);
-  for (CFuint in = 0; in < nbGeoNodes; ++in) {
-    const CFuint nodeID = faces.getNodeID(faceidx, in);
-    currFace->setNode(in, nodes[nodeID]);
+  GeometricEntity* currFace = CFNULL;
+  if (m_faceTable.isNull()) {
+    // local ID (in all the mesh) of the geometric entity to get
+    const CFuint geoType = faces.getGeoType(faceidx);
+    currFace = _poolData[geoType][_countGeo[geoType]++];
+    
+    // set the local ID
+    currFace->setID(faces.getLocalGeoID(faceidx));
+    
+    // set nodes in current face
+    const CFuint nbGeoNodes = faces.getNbNodesInGeo(faceidx);
+    for (CFuint in = 0; in < nbGeoNodes; ++in) {
+      const CFuint nodeID = faces.getNodeID(faceidx, in);
+      currFace->setNode(in, nodes[nodeID]);
+    }
+  }
+  else {
+    currFace = buildFaceFromTable(faces.getLocalGeoID(faceidx), states, gstates, nodes);
   }
   
   // set cells on both sides of  the face
@@ -114,6 +120,13 @@ GeometricEntity* FaceCellTrsGeoBuilder::buildGE()
 	for (CFuint iFace = 0; iFace < nbFacesInCell; ++iFace)
 	{      
 	  const CFuint faceID = (*_cellFaces)(stateID, iFace);
+	  if (m_faceTable.isNotNull()) {
+	    GeometricEntity *const face = buildFaceFromTable(faceID, states, gstates, nodes);
+	    cell->setNeighborGeo(iFace, face);
+	    _builtGeos.push_back(face);
+	    continue;
+	  }
+	  
 	  const TopologicalRegionSet& faceTrs = *_mapGeoToTrs->getTrs(faceID);
 	  const CFuint faceIdx = _mapGeoToTrs->getIdxInTrs(faceID);
 	  const bool isBFace = _mapGeoToTrs->isBGeo(faceID);
@@ -154,6 +167,33 @@ GeometricEntity* FaceCellTrsGeoBuilder::buildGE()
   return currFace;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+GeometricEntity* FaceCellTrsGeoBuilder::buildFaceFromTable
+(const CFuint faceID,
+ DataHandle<State*, GLOBAL>& states,
+ DataHandle<State*>& gstates,
+ DataHandle<Node*, GLOBAL>& nodes)
+{
+  const FaceTable& table = *m_faceTable;
+  
+  const CFuint faceType = table.getGeoType(faceID);
+  GeometricEntity *const face = _poolData[faceType][_countGeo[faceType]++];
+  face->setID(faceID);
+  
+  face->setState(0, states[table.getStateID(faceID, 0)]);
+  const CFuint sID1 = table.getStateID(faceID, 1);
+  face->setState(1, (!table.isBFace(faceID)) ? states[sID1] : gstates[sID1]);
+  
+  const CFuint nbFaceNodes = table.getNbNodes(faceID);
+  const CFuint *const nodeIDs = table.getNodeIDs(faceID);
+  for (CFuint in = 0; in < nbFaceNodes; ++in) {
+    face->setNode(in, nodes[nodeIDs[in]]);
+  }
+  
+  return face;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
   } // namespace Framework
@@ -10,6 +10,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "Framework/CellTrsGeoBuilder.hh"
+#include "Framework/FaceTable.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -73,6 +74,13 @@ public:
     socket_cellFlag = cellFlagSocket;
   }
   
+  /// Sets the precomputed FaceTable to use for building the faces
+  /// (CFNULL to get the connectivity from the TRSs)
+  void setFaceTable(Common::SafePtr<Framework::FaceTable> faceTable)
+  {
+    m_faceTable = faceTable;
+  }
+  
   /// Get the data of the GeometricEntity builder.
   /// This allows the client code to set the data and then
   /// let the builder work on its own updated data.
@@ -87,12 +95,23 @@ public:
   
 private:
   
+  /// Build a face with the given local ID, taking the connectivity from the FaceTable
+  Framework::GeometricEntity* buildFaceFromTable
+  (const CFuint faceID,
+   DataHandle<Framework::State*, Framework::GLOBAL>& states,
+   DataHandle<Framework::State*>& gstates,
+   DataHandle<Framework::Node*, Framework::GLOBAL>& nodes);
+  
+  
   /// socket for cell flags
   Framework::DataSocketSink<bool> socket_cellFlag;
   
   /// data of this builder
   FaceCellTrsGeoBuilder::GeoData  m_fcdata;
   
+  /// precomputed face connectivity (optional)
+  Common::SafePtr<Framework::FaceTable> m_faceTable;
+  
 }; // end of class FaceCellTrsGeoBuilder
 
 //////////////////////////////////////////////////////////////////////////////
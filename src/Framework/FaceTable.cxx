@@ -0,0 +1,116 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <map>
+
+#include "Framework/FaceTable.hh"
+#include "Framework/MeshData.hh"
+#include "Framework/MapGeoToTrsAndIdx.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+FaceTable::FaceTable() :
+  m_geoType(),
+  m_trsIdx(),
+  m_isBFace(),
+  m_stateIDs(),
+  m_nodePtr(),
+  m_nodeIDs()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+FaceTable::~FaceTable()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceTable::build()
+{
+  CFAUTOTRACE;
+
+  clear();
+
+  SafePtr<MapGeoToTrsAndIdx> mapGeoToTrs =
+    MeshDataStack::getActive()->getMapGeoToTrs("MapFacesToTrs");
+
+  // index of each TRS in the list of TRSs of the MeshData
+  vector<SafePtr<TopologicalRegionSet> > trsList = MeshDataStack::getActive()->getTrsList();
+  std::map<const TopologicalRegionSet*, CFuint> trsIdx;
+  for (CFuint iTRS = 0; iTRS < trsList.size(); ++iTRS) {
+    trsIdx[&*trsList[iTRS]] = iTRS;
+  }
+
+  const CFuint nbFaces = mapGeoToTrs->size();
+  m_geoType.resize(nbFaces);
+  m_trsIdx.resize(nbFaces);
+  m_isBFace.resize(nbFaces);
+  m_stateIDs.resize(2*nbFaces);
+  m_nodePtr.resize(nbFaces+1);
+  m_nodePtr[0] = 0;
+
+  for (CFuint faceID = 0; faceID < nbFaces; ++faceID) {
+    SafePtr<TopologicalRegionSet> faces = mapGeoToTrs->getTrs(faceID);
+    cf_assert(faces.isNotNull());
+    m_nodePtr[faceID+1] = m_nodePtr[faceID] +
+      faces->getNbNodesInGeo(mapGeoToTrs->getIdxInTrs(faceID));
+  }
+  m_nodeIDs.resize(m_nodePtr[nbFaces]);
+
+  for (CFuint faceID = 0; faceID < nbFaces; ++faceID) {
+    SafePtr<TopologicalRegionSet> faces = mapGeoToTrs->getTrs(faceID);
+    const CFuint faceIdx = mapGeoToTrs->getIdxInTrs(faceID);
+    cf_assert(faces->getLocalGeoID(faceIdx) == faceID);
+    cf_assert(trsIdx.count(&*faces) > 0);
+
+    m_geoType[faceID] = faces->getGeoType(faceIdx);
+    m_trsIdx[faceID] = trsIdx[&*faces];
+    m_isBFace[faceID] = mapGeoToTrs->isBGeo(faceID);
+    m_stateIDs[2*faceID]   = faces->getStateID(faceIdx, 0);
+    m_stateIDs[2*faceID+1] = faces->getStateID(faceIdx, 1);
+
+    const CFuint nbNodes = getNbNodes(faceID);
+    CFuint *const nodeIDs = &m_nodeIDs[m_nodePtr[faceID]];
+    for (CFuint iNode = 0; iNode < nbNodes; ++iNode) {
+      nodeIDs[iNode] = faces->getNodeID(faceIdx, iNode);
+    }
+  }
+
+  CFLog(VERBOSE, "FaceTable::build() => " << nbFaces << " faces\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceTable::clear()
+{
+  vector<CFuint>().swap(m_geoType);
+  vector<CFuint>().swap(m_trsIdx);
+  vector<bool>().swap(m_isBFace);
+  vector<CFuint>().swap(m_stateIDs);
+  vector<CFuint>().swap(m_nodePtr);
+  vector<CFuint>().swap(m_nodeIDs);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,125 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Framework_FaceTable_hh
+#define COOLFluiD_Framework_FaceTable_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/NonCopyable.hh"
+#include "Framework/Framework.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class stores in flat arrays, indexed by the local face ID, the
+/// connectivity of the faces of a cell-centered mesh: geometric type, TRS
+/// index, left and right state IDs and node IDs.
+/// It is built once from the face TRSs of the active MeshData and allows to
+/// build a face (and its neighbor cells) without looking up the TRS and
+/// the index in the TRS of each face.
+/// The geometric data (normals, areas) are not duplicated here: they are
+/// already stored per face ID in the corresponding DataSocket's.
+/// @see MapGeoToTrsAndIdx
+class Framework_API FaceTable : public Common::NonCopyable<FaceTable> {
+public:
+
+  /// Constructor
+  FaceTable();
+
+  /// Destructor
+  ~FaceTable();
+
+  /// Build the table from the active MeshData
+  void build();
+
+  /// Deallocate the table
+  void clear();
+
+  /// Get the number of faces
+  CFuint getNbFaces() const {return m_geoType.size();}
+
+  /// Get the geometric type of the face
+  CFuint getGeoType(const CFuint faceID) const
+  {
+    cf_assert(faceID < m_geoType.size());
+    return m_geoType[faceID];
+  }
+
+  /// Get the index of the TRS of the face in the list of TRSs of the MeshData
+  CFuint getTrsIdx(const CFuint faceID) const
+  {
+    cf_assert(faceID < m_trsIdx.size());
+    return m_trsIdx[faceID];
+  }
+
+  /// Tells if the face is on the boundary, in which case the right state
+  /// is a ghost state
+  bool isBFace(const CFuint faceID) const
+  {
+    cf_assert(faceID < m_isBFace.size());
+    return m_isBFace[faceID];
+  }
+
+  /// Get the ID of the left (iState = 0) or right (iState = 1) state
+  CFuint getStateID(const CFuint faceID, const CFuint iState) const
+  {
+    cf_assert(2*faceID + iState < m_stateIDs.size());
+    return m_stateIDs[2*faceID + iState];
+  }
+
+  /// Get the number of nodes in the face
+  CFuint getNbNodes(const CFuint faceID) const
+  {
+    cf_assert(faceID + 1 < m_nodePtr.size());
+    return m_nodePtr[faceID+1] - m_nodePtr[faceID];
+  }
+
+  /// Get the pointer to the node IDs of the face
+  const CFuint* getNodeIDs(const CFuint faceID) const
+  {
+    cf_assert(faceID + 1 < m_nodePtr.size());
+    return &m_nodeIDs[m_nodePtr[faceID]];
+  }
+
+private: // data
+
+  /// geometric type of each face
+  std::vector<CFuint> m_geoType;
+
+  /// TRS index of each face
+  std::vector<CFuint> m_trsIdx;
+
+  /// flag telling if each face is a boundary face
+  std::vector<bool> m_isBFace;
+
+  /// left and right state IDs of each face
+  std::vector<CFuint> m_stateIDs;
+
+  /// start of the node IDs of each face in m_nodeIDs
+  std::vector<CFuint> m_nodePtr;
+
+  /// node IDs of all the faces
+  std::vector<CFuint> m_nodeIDs;
+
+}; // end of class FaceTable
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Framework_FaceTable_hh
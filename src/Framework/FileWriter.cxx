@@ -4,7 +4,10 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <sstream>
+
 #include "Framework/FileWriter.hh"
+#include "Framework/AsyncFileWriter.hh"
 #include "Common/CFLog.hh"
 #include "Environment/FileHandlerOutput.hh"
 #include "Environment/SingleBehaviorFactory.hh"
@@ -38,6 +41,18 @@ void FileWriter::writeToFile(const boost::filesystem::path& filepath)
 {
   CFAUTOTRACE;
 
+  if (AsyncFileWriter::getInstance().isActive()) {
+    // the file is produced in memory and written to disk in the background
+    stringbuf buffer;
+    ofstream file;
+    file.std::ios::rdbuf(&buffer);
+    writeToFileStream(file);
+
+    string content = buffer.str();
+    AsyncFileWriter::getInstance().post(filepath, content);
+    return;
+  }
+
   Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle = Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
   ofstream& file = fhandle->open(filepath);
 
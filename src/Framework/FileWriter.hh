@@ -39,6 +39,7 @@ public:
   virtual ~FileWriter();
   
   /// Opens and starts to write to the given file.
+  /// If the AsyncFileWriter is active, the file is written in the background.
   /// @throw Common::FilesystemException
   virtual void writeToFile(const boost::filesystem::path& filepath);
   
@@ -121,6 +121,22 @@ public: // functions
   /// Flag telling to use node-based sparsity an assembly (instead of state-based)
   bool useNodeBased() const {return m_useNodeBased;}
   
+  /// Flag telling to reuse the current preconditioner in the next solve
+  /// (the matrix has not been recomputed since it was built)
+  bool reusePreconditioner() const {return m_reusePreconditioner;}
+  
+  /// Flag telling to keep the preconditioner data after each solve,
+  /// because they could be reused in the next one
+  bool keepPreconditioner() const {return m_keepPreconditioner;}
+  
+  /// Set the flag telling to reuse the current preconditioner in the next solve
+  /// @post the preconditioner data are kept after each solve from now on
+  void setReusePreconditioner(const bool reuse)
+  {
+    m_reusePreconditioner = reuse;
+    m_keepPreconditioner = true;
+  }
+  
  private: // data
   
   /// mapping local to global indices numbering
@@ -162,6 +178,12 @@ public: // functions
   /// use node-based sparsity and assembly (instead of state-based)
   bool m_useNodeBased;
   
+  /// reuse the current preconditioner in the next solve
+  bool m_reusePreconditioner;
+  
+  /// keep the preconditioner data after each solve
+  bool m_keepPreconditioner;
+  
 }; // end of class LSSData
 
 //////////////////////////////////////////////////////////////////////////////
@@ -161,6 +161,17 @@ public:
   /// Add a list of values
   virtual void addValues(const BlockAccumulator& acc) = 0;
 
+  /// Add a list of values whose row/column indices are the same at every call
+  /// for a given entity (e.g. a face): the position of each block in the matrix
+  /// storage can then be looked up only once and kept by the caller
+  /// @param slots  acc.getM()*acc.getN() slots of the entity, all initialized
+  ///               to -1 by the caller and filled by the matrices which can
+  ///               use them (by default they are not used)
+  virtual void addValuesInSlots(const BlockAccumulator& acc, CFint* slots)
+  {
+    addValues(acc);
+  }
+
   /// Freeze the matrix structure concerning the non zero
   /// locations
   virtual void freezeNonZeroStructure() = 0;
@@ -154,6 +154,14 @@ Framework::LSSIdxMapping& LinearSystemSolver::getLocalToLocallyUpdatableMapping(
   return m_lssData->getLocalToLocallyUpdatableMapping();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+void LinearSystemSolver::setReusePreconditioner(const bool reuse)
+{
+  cf_assert(m_lssData.isNotNull());
+  m_lssData->setReusePreconditioner(reuse);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
   } // namespace Framework
@@ -91,6 +91,10 @@ public: // methods
   /// Gets the size of the system of equations to solve
   CFuint getNbSysEqs() const {   return m_nbSysEquations;  }
 
+  /// Tell the solver if the system matrix is unchanged since the last solve,
+  /// so that the current preconditioner can be reused
+  virtual void setReusePreconditioner(const bool reuse);
+  
   /// Get the Preconditioner system matrix
   virtual Common::SafePtr<LSSMatrix> getPreconditionerMatrix() const
   {
@@ -37,6 +37,9 @@ public: // functions
   /// Resize the mapper
   void resize(const CFuint totalNbGeos);
 
+  /// Get the number of mapped GeometricEntity's
+  CFuint size() const {return m_trs.size();}
+
   /// Get the a pointer to the TopologicalRegionSet where
   /// the GeometricEntity having geoID is
   Common::SafePtr<TopologicalRegionSet> getTrs(CFuint geoID) const
@@ -13,6 +13,7 @@
 #include "Framework/NamespaceSwitcher.hh"
 #include "Framework/MethodData.hh"
 #include "Framework/SubSystemStatus.hh"
+#include "Framework/MeshData.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -584,6 +585,20 @@ void Method::popNamespace()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void Method::completeStatesSync()
+{
+  CFAUTOTRACE;
+  
+  DataHandle<State*, GLOBAL> states = 
+    MeshDataStack::getActive()->getStateDataSocketSink().getDataHandle();
+  if (states.isSyncPending()) {
+    CFLog(VERBOSE, "Method::completeStatesSync() in [" << getName() << "]\n");
+    states.endSync();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 QualifiedName Method::QName() const
 {
   return QualifiedName (getNamespace(), getName());
@@ -171,6 +171,12 @@ protected: // helper functions
   /// Switch back from the Namespace of this Method
   void popNamespace();
 
+  /// Complete the synchronization of the states of the active MeshData,
+  /// if a ConvergenceMethod started it without waiting for its end
+  /// (see the option ConvergenceMethod::OverlapSync)
+  /// @pre the Namespace of this Method has been pushed
+  void completeStatesSync();
+
   /// Configures the Command Groups in this Method
   void configureCommandGroups ( Config::ConfigArgs& args );
 
@@ -35,7 +35,7 @@ class Framework_API NumericalJacobian : public Config::ConfigObject,
 					public Common::NonCopyable<NumericalJacobian> {
 public:
 
-#ifdef CF_HAVE_CUDA
+#ifdef CF_HAVE_DEVICE_KERNELS
   /// nested class defining local options
   template <typename PHYS>
   class DeviceConfigOptions {
@@ -99,6 +99,7 @@ public:
     CFreal m_eps;
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the device
   template <typename PHYS>
   void copyConfigOptionsToDevice(DeviceConfigOptions<PHYS>* dco) 
@@ -108,6 +109,7 @@ public:
     CudaEnv::copyHost2Dev(dco->refValues, &_refValues[0], PHYS::NBEQS);
     CudaEnv::copyHost2Dev(&dco->tol, &_tol, 1);
   }   
+#endif
   
   /// copy the local configuration options to the device
   template <typename PHYS>
@@ -34,6 +34,8 @@
 #include "Framework/Namespace.hh"
 #include "Framework/Framework.hh"
 #include "Framework/SimulationStatus.hh"
+#include "Environment/CFEnvVars.hh"
+#include "Environment/CFEnv.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -356,8 +358,9 @@ void OnlyMeshSubSystem::buildMeshData()
 	//  nodes.DumpContents ();
 	// #endif
 	
-	states.buildMap ();
-	nodes.buildMap ();
+	const bool packedSync = Environment::CFEnv::getInstance().getVars()->PackedSync;
+	states.buildMap (packedSync);
+	nodes.buildMap (packedSync);
 	
 	// #ifndef NDEBUG
 	//  states.DumpInfo ();
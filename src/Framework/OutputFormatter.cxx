@@ -168,6 +168,8 @@ void OutputFormatter::write()
 
   pushNamespace();
 
+  // the ghost states must be up to date before being written
+  completeStatesSync();
   writeImpl();
 
   popNamespace();
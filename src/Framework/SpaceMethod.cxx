@@ -152,6 +152,7 @@ void SpaceMethod::prepareComputation()
 
   pushNamespace();
 
+  if (!canOverlapSync()) {completeStatesSync();}
   prepareComputationImpl();
 
   popNamespace();
@@ -168,6 +169,7 @@ void SpaceMethod::computeSpaceResidual(CFreal factor)
 
   pushNamespace();
 
+  if (!canOverlapSync()) {completeStatesSync();}
   computeSpaceResidualImpl(factor);
 
   popNamespace();
@@ -184,6 +186,7 @@ void SpaceMethod::computeTimeResidual(CFreal factor)
 
   pushNamespace();
 
+  completeStatesSync();
   computeTimeResidualImpl(factor);
 
   popNamespace();
@@ -200,6 +203,7 @@ void SpaceMethod::applyBC()
 
   pushNamespace();
 
+  if (!canOverlapSync()) {completeStatesSync();}
   applyBCImpl();
 
   popNamespace();
@@ -216,6 +220,7 @@ void SpaceMethod::postProcessSolution()
 
   pushNamespace();
 
+  if (!canOverlapSync()) {completeStatesSync();}
   postProcessSolutionImpl();
 
   popNamespace();
@@ -264,6 +269,7 @@ void SpaceMethod::computeSpaceRhsForStatesSet(CFreal factor)
 
   pushNamespace();
 
+  completeStatesSync();
   computeSpaceRhsForStatesSetImpl(factor);
 
   popNamespace();
@@ -280,6 +286,7 @@ void SpaceMethod::computeTimeRhsForStatesSet(CFreal factor)
 
   pushNamespace();
 
+  completeStatesSync();
   computeTimeRhsForStatesSetImpl(factor);
 
   popNamespace();
@@ -296,6 +303,7 @@ void SpaceMethod::extrapolateStatesToNodes()
 
   pushNamespace();
 
+  completeStatesSync();
   extrapolateStatesToNodesImpl();
 
   popNamespace();
@@ -229,6 +229,14 @@ protected: // abstract interface implementations
   /// This is the abstract function that the concrete methods must implement.
   virtual void applyBCImpl() = 0;
 
+  /// Tells if this method can be entered while a synchronization of the
+  /// states is still in progress. In that case prepareComputationImpl(),
+  /// computeSpaceResidualImpl(), applyBCImpl() and postProcessSolutionImpl()
+  /// are responsible for completing the synchronization themselves before
+  /// using any non updatable state.
+  /// By default the synchronization is completed before calling them.
+  virtual bool canOverlapSync() const {return false;}
+
   /// Postprocess the solution.
   /// For instance for the application of a limiter or a filter..
   /// This is the abstract function that the concrete methods must implement.
@@ -32,6 +32,7 @@
 #include "Framework/SpaceMethod.hh"
 #include "Framework/DataProcessingMethod.hh"
 #include "Framework/OutputFormatter.hh"
+#include "Framework/AsyncFileWriter.hh"
 #include "Framework/LinearSystemSolver.hh"
 #include "Framework/SubSystemStatus.hh"
 #include "Framework/StopConditionController.hh"
@@ -42,6 +43,8 @@
 #include "Framework/Namespace.hh"
 #include "Framework/Framework.hh"
 #include "Framework/SimulationStatus.hh"
+#include "Environment/CFEnvVars.hh"
+#include "Environment/CFEnv.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -91,6 +94,8 @@ void StandardSubSystem::defineConfigOptions(Config::OptionList& options)
    options.addConfigOption< CFuint >("InitialIter","Initial Iteration Number.");
    options.addConfigOption< CFreal >("InitialTime","Initial Physical Time of the SubSystem.");
    options.addConfigOption< int, Config::DynamicOption<> >("StopSimulation","Flag to force an immediate stop of the simulation.");
+   options.addConfigOption< bool >("AsyncOutput","Write the output files to disk in the background, overlapped with the following iterations.");
+   options.addConfigOption< CFuint >("AsyncOutputBufferSize","Maximum size (in MB) of the output waiting to be written in the background.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -155,6 +160,12 @@ StandardSubSystem::StandardSubSystem(const std::string& name)
 
   m_forcedStop = 0;
   setParameter("StopSimulation",&m_forcedStop);
+
+  m_asyncOutput = false;
+  setParameter("AsyncOutput",&m_asyncOutput);
+
+  m_asyncOutputBufferSize = 1024;
+  setParameter("AsyncOutputBufferSize",&m_asyncOutputBufferSize);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -452,8 +463,9 @@ void StandardSubSystem::setGlobalMeshData()
 	  //  nodes.DumpContents ();
 	  //  #endif
 	  
-	  states.buildMap ();
-	  nodes.buildMap ();
+	  const bool packedSync = Environment::CFEnv::getInstance().getVars()->PackedSync;
+	  states.buildMap (packedSync);
+	  nodes.buildMap (packedSync);
 	  
 	  // #ifndef NDEBUG
 	  //  states.DumpInfo ();
@@ -476,6 +488,9 @@ void StandardSubSystem::setup()
   //setCommands() needs Trs's => must be exactly here
   setCommands();
   
+  AsyncFileWriter::getInstance().setActive
+    (m_asyncOutput, static_cast<size_t>(m_asyncOutputBufferSize)*1024*1024);
+  
   CFLog(NOTICE,"-------------------------------------------------------------\n");
   CFLogInfo("Setting up DataPreProcessing's\n");
   m_dataPreProcessing.apply
@@ -796,6 +811,9 @@ void StandardSubSystem::unsetup()
   bool force = true;
   writeSolution(force);
   
+  // wait for the output still being written in the background
+  AsyncFileWriter::getInstance().flush();
+  
   CFLog(VERBOSE, "StandardSubSystem::unsetup() => OutputFormatter\n");
   // unset all the methods
   m_outputFormat.apply
@@ -207,6 +207,12 @@ protected: // functions
   ///flag to force stopping the run()
   int m_forcedStop;
 
+  /// flag telling if the output files are written to disk in the background
+  bool m_asyncOutput;
+
+  /// maximum size (in MB) of the output waiting to be written in the background
+  CFuint m_asyncOutputBufferSize;
+
 }; // class StandardSubSystem
 
 //////////////////////////////////////////////////////////////////////////////
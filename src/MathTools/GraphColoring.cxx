@@ -0,0 +1,133 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <limits>
+
+#include "Common/CFLog.hh"
+#include "MathTools/GraphColoring.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace MathTools {
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint GraphColoring::colorByNodes(const ConnectivityTable<CFuint>& entityNodes,
+				   const CFuint nbNodes,
+				   vector<CFuint>& colors)
+{
+  const CFuint nbEntities = entityNodes.nbRows();
+  vector<CFuint> ptr(nbEntities+1, 0);
+  for (CFuint i = 0; i < nbEntities; ++i) {
+    ptr[i+1] = ptr[i] + entityNodes.nbCols(i);
+  }
+
+  vector<CFuint> nodes(ptr[nbEntities]);
+  for (CFuint i = 0; i < nbEntities; ++i) {
+    const CFuint nbCols = entityNodes.nbCols(i);
+    for (CFuint j = 0; j < nbCols; ++j) {
+      nodes[ptr[i]+j] = entityNodes(i,j);
+    }
+  }
+
+  return colorByNodes(nbEntities, ptr, nodes, nbNodes, colors);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint GraphColoring::colorByNodes(const CFuint nbEntities,
+				   const vector<CFuint>& ptr,
+				   const vector<CFuint>& nodes,
+				   const CFuint nbNodes,
+				   vector<CFuint>& colors)
+{
+  cf_assert(ptr.size() == nbEntities+1);
+
+  // node-to-entity incidence, needed to find the entities sharing a node
+  vector<CFuint> nodePtr(nbNodes+1, 0);
+  for (CFuint i = 0; i < ptr[nbEntities]; ++i) {
+    if (nodes[i] < nbNodes) nodePtr[nodes[i]+1]++;
+  }
+  for (CFuint n = 0; n < nbNodes; ++n) {
+    nodePtr[n+1] += nodePtr[n];
+  }
+
+  vector<CFuint> nodeEntities(nodePtr[nbNodes]);
+  vector<CFuint> fill(nodePtr.begin(), nodePtr.end()-1);
+  for (CFuint e = 0; e < nbEntities; ++e) {
+    for (CFuint i = ptr[e]; i < ptr[e+1]; ++i) {
+      if (nodes[i] < nbNodes) nodeEntities[fill[nodes[i]]++] = e;
+    }
+  }
+
+  const CFuint noColor = numeric_limits<CFuint>::max();
+  colors.assign(nbEntities, noColor);
+
+  // forbidden[c] == e means that color c is already used by a neighbor of e
+  vector<CFuint> forbidden;
+  CFuint nbColors = 0;
+  for (CFuint e = 0; e < nbEntities; ++e) {
+    for (CFuint i = ptr[e]; i < ptr[e+1]; ++i) {
+      const CFuint node = nodes[i];
+      if (node >= nbNodes) continue;
+      for (CFuint k = nodePtr[node]; k < nodePtr[node+1]; ++k) {
+	const CFuint c = colors[nodeEntities[k]];
+	if (c != noColor) forbidden[c] = e;
+      }
+    }
+
+    CFuint c = 0;
+    while (c < nbColors && forbidden[c] == e) ++c;
+    if (c == nbColors) {
+      forbidden.push_back(noColor);
+      ++nbColors;
+    }
+    colors[e] = c;
+  }
+
+  CFLog(VERBOSE, "GraphColoring::colorByNodes() => " << nbEntities
+	<< " entities, " << nbColors << " colors\n");
+
+  return nbColors;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GraphColoring::groupByColor(const vector<CFuint>& colors,
+				 const CFuint nbColors,
+				 vector<CFuint>& colorPtr,
+				 vector<CFuint>& colorEntities)
+{
+  colorPtr.assign(nbColors+1, 0);
+  for (CFuint e = 0; e < colors.size(); ++e) {
+    cf_assert(colors[e] < nbColors);
+    colorPtr[colors[e]+1]++;
+  }
+  for (CFuint c = 0; c < nbColors; ++c) {
+    colorPtr[c+1] += colorPtr[c];
+  }
+
+  colorEntities.resize(colors.size());
+  vector<CFuint> fill(colorPtr.begin(), colorPtr.end()-1);
+  for (CFuint e = 0; e < colors.size(); ++e) {
+    colorEntities[fill[colors[e]]++] = e;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace MathTools
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
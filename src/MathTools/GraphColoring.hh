@@ -0,0 +1,89 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_MathTools_GraphColoring_hh
+#define COOLFluiD_MathTools_GraphColoring_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/ConnectivityTable.hh"
+#include "MathTools/MathTools.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace MathTools {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class provides greedy colorings of entities (faces, cells, matrix
+ * columns) that are connected through shared "nodes" (states, cells, matrix
+ * rows). Two entities sharing at least one node never get the same color,
+ * so that all the entities of one color can be processed concurrently
+ * without write conflicts on the shared nodes.
+ *
+ * The algorithm visits the entities in their natural order and is therefore
+ * deterministic: the same input always yields the same coloring.
+ *
+ */
+class MathTools_API GraphColoring
+{
+public:
+
+  /**
+   * Color entities connected through shared nodes
+   * @param entityNodes  row i lists the nodes touched by entity i; node IDs
+   *                     >= nbNodes are ignored (e.g. ghost states)
+   * @param nbNodes      total number of nodes
+   * @param colors       on output, color assigned to each entity
+   * @return the number of colors
+   */
+  static CFuint colorByNodes(const Common::ConnectivityTable<CFuint>& entityNodes,
+			     const CFuint nbNodes,
+			     std::vector<CFuint>& colors);
+
+  /**
+   * Color entities connected through shared nodes, given a CSR storage
+   * @param nbEntities   number of entities
+   * @param ptr          entity i touches nodes[ptr[i]] ... nodes[ptr[i+1]-1]
+   * @param nodes        node IDs (IDs >= nbNodes are ignored)
+   * @param nbNodes      total number of nodes
+   * @param colors       on output, color assigned to each entity
+   * @return the number of colors
+   */
+  static CFuint colorByNodes(const CFuint nbEntities,
+			     const std::vector<CFuint>& ptr,
+			     const std::vector<CFuint>& nodes,
+			     const CFuint nbNodes,
+			     std::vector<CFuint>& colors);
+
+  /**
+   * Group the entities by color, preserving their original relative order
+   * @param colors       color of each entity
+   * @param nbColors     number of colors
+   * @param colorPtr     entities of color c are colorEntities[colorPtr[c]] ... [colorPtr[c+1]-1]
+   * @param colorEntities entity IDs sorted by color
+   */
+  static void groupByColor(const std::vector<CFuint>& colors,
+			   const CFuint nbColors,
+			   std::vector<CFuint>& colorPtr,
+			   std::vector<CFuint>& colorEntities);
+
+}; // end of class GraphColoring
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace MathTools
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_MathTools_GraphColoring_hh
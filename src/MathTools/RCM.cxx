@@ -9,6 +9,7 @@
 #include <fstream>
 #include <string>
 #include <cstdlib>
+#include <algorithm>
 
 #include "Common/ConnectivityTable.hh"
 #include "Common/SwapEmpty.hh"
@@ -491,4 +492,55 @@ void RCM::transformCellNode2NodeNodeMedianDual (const ConnectivityTable<CFuint>&
 
 /////////////////////////////////////////////////////////////////////////////
 
+void RCM::renumberGraph (const std::vector<CFuint>& ptr,
+			 const std::vector<CFuint>& adj,
+			 std::vector<CFuint>& order)
+{
+  cf_assert(ptr.size() > 0);
+  const CFuint nbVertices = ptr.size() - 1;
+  
+  // the roots of the connected components are taken by increasing degree
+  std::vector<std::pair<CFuint, CFuint> > byDegree(nbVertices);
+  for (CFuint v = 0; v < nbVertices; ++v) {
+    byDegree[v] = std::make_pair(ptr[v+1] - ptr[v], v);
+  }
+  std::sort(byDegree.begin(), byDegree.end());
+  
+  order.clear();
+  order.reserve(nbVertices);
+  std::vector<bool> visited(nbVertices, false);
+  std::vector<std::pair<CFuint, CFuint> > neighbors;
+  
+  for (CFuint k = 0; k < nbVertices; ++k) {
+    const CFuint root = byDegree[k].second;
+    if (visited[root]) continue;
+    
+    // breadth-first traversal of the component, visiting the 
+    // neighbors of each vertex by increasing degree (Cuthill-McKee)
+    visited[root] = true;
+    CFuint head = order.size();
+    order.push_back(root);
+    while (head < order.size()) {
+      const CFuint v = order[head++];
+      neighbors.clear();
+      for (CFuint i = ptr[v]; i < ptr[v+1]; ++i) {
+	const CFuint u = adj[i];
+	if (u < nbVertices && !visited[u]) {
+	  visited[u] = true;
+	  neighbors.push_back(std::make_pair(ptr[u+1] - ptr[u], u));
+	}
+      }
+      std::sort(neighbors.begin(), neighbors.end());
+      for (CFuint i = 0; i < neighbors.size(); ++i) {
+	order.push_back(neighbors[i].second);
+      }
+    }
+  }
+  
+  cf_assert(order.size() == nbVertices);
+  std::reverse(order.begin(), order.end());
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
 } // namespace COOLFluiD
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "Common/ConnectivityTable.hh"
 #include "MathTools/MathTools.hh"
@@ -29,6 +30,13 @@ class MathTools_API RCM
 			std::valarray<CFuint>& new_id,
 			const bool useMedianDual);
   
+  /// Applies the Reverse Cuthill-McKee algorithm to a graph in CSR format
+  /// (vertex v is connected to adj[ptr[v]] ... adj[ptr[v+1]-1])
+  /// @param order on output, order[i] is the old ID of the vertex numbered i
+  static void renumberGraph (const std::vector<CFuint>& ptr,
+			     const std::vector<CFuint>& adj,
+			     std::vector<CFuint>& order);
+  
   /// reads the a cell to node connectivity from the file
   static int read_input (const std::string& filename, 
 			 Common::ConnectivityTable<CFuint>& cellnode);
@@ -0,0 +1,146 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <limits>
+
+#include "Common/CFLog.hh"
+#include "MathTools/SpaceFillingCurve.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace MathTools {
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint SpaceFillingCurve::mortonKey(const CFuint* coord,
+				    const CFuint dim,
+				    const CFuint nbBits)
+{
+  cf_assert(dim*nbBits <= 8*sizeof(CFuint));
+  CFuint key = 0;
+  for (CFint b = nbBits-1; b >= 0; --b) {
+    for (CFuint d = 0; d < dim; ++d) {
+      key = (key << 1) | ((coord[d] >> b) & 1);
+    }
+  }
+  return key;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint SpaceFillingCurve::hilbertKey(const CFuint* coord,
+				     const CFuint dim,
+				     const CFuint nbBits)
+{
+  cf_assert(dim <= 3);
+  cf_assert(nbBits > 0);
+  if (dim == 1) return coord[0];
+
+  CFuint x[3];
+  for (CFuint d = 0; d < dim; ++d) {
+    x[d] = coord[d];
+  }
+
+  // inverse undo
+  const CFuint m = static_cast<CFuint>(1) << (nbBits-1);
+  for (CFuint q = m; q > 1; q >>= 1) {
+    const CFuint p = q - 1;
+    for (CFuint d = 0; d < dim; ++d) {
+      if (x[d] & q) {
+	x[0] ^= p;
+      }
+      else {
+	const CFuint t = (x[0] ^ x[d]) & p;
+	x[0] ^= t;
+	x[d] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (CFuint d = 1; d < dim; ++d) {
+    x[d] ^= x[d-1];
+  }
+  CFuint t = 0;
+  for (CFuint q = m; q > 1; q >>= 1) {
+    if (x[dim-1] & q) t ^= q - 1;
+  }
+  for (CFuint d = 0; d < dim; ++d) {
+    x[d] ^= t;
+  }
+
+  // the transposed coordinates interleaved give the Hilbert index
+  return mortonKey(x, dim, nbBits);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void SpaceFillingCurve::sortPoints(const vector<CFreal>& coords,
+				   const CFuint dim,
+				   const bool useHilbert,
+				   vector<CFuint>& order)
+{
+  cf_assert(dim > 0 && dim <= 3);
+  cf_assert(coords.size()%dim == 0);
+  const CFuint nbPoints = coords.size()/dim;
+
+  // bounding box of the points
+  CFreal xmin[3];
+  CFreal xmax[3];
+  for (CFuint d = 0; d < dim; ++d) {
+    xmin[d] =  numeric_limits<CFreal>::max();
+    xmax[d] = -numeric_limits<CFreal>::max();
+  }
+  for (CFuint i = 0; i < nbPoints; ++i) {
+    for (CFuint d = 0; d < dim; ++d) {
+      xmin[d] = min(xmin[d], coords[i*dim+d]);
+      xmax[d] = max(xmax[d], coords[i*dim+d]);
+    }
+  }
+
+  const CFuint nbBits = getNbBits(dim);
+  const CFreal maxCoord = static_cast<CFreal>((static_cast<CFuint>(1) << nbBits) - 1);
+  CFreal scale[3];
+  for (CFuint d = 0; d < dim; ++d) {
+    const CFreal length = xmax[d] - xmin[d];
+    scale[d] = (length > 0.) ? maxCoord/length : 0.;
+  }
+
+  // pairs (key, ID) sorted by key, the ID breaking the ties
+  vector<pair<CFuint, CFuint> > keys(nbPoints);
+  CFuint ic[3];
+  for (CFuint i = 0; i < nbPoints; ++i) {
+    for (CFuint d = 0; d < dim; ++d) {
+      ic[d] = static_cast<CFuint>((coords[i*dim+d] - xmin[d])*scale[d]);
+    }
+    const CFuint key = (useHilbert) ? hilbertKey(ic, dim, nbBits) : mortonKey(ic, dim, nbBits);
+    keys[i] = make_pair(key, i);
+  }
+  sort(keys.begin(), keys.end());
+
+  order.resize(nbPoints);
+  for (CFuint i = 0; i < nbPoints; ++i) {
+    order[i] = keys[i].second;
+  }
+
+  CFLog(VERBOSE, "SpaceFillingCurve::sortPoints() => " << nbPoints << " points sorted along the "
+	<< ((useHilbert) ? "Hilbert" : "Morton") << " curve\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace MathTools
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
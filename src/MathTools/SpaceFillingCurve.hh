@@ -0,0 +1,81 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_MathTools_SpaceFillingCurve_hh
+#define COOLFluiD_MathTools_SpaceFillingCurve_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+#include "MathTools/MathTools.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace MathTools {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class orders points along a Morton (Z-order) or a Hilbert
+ * space-filling curve. Points that are close along the curve are close in
+ * space, so that numbering mesh entities in curve order improves the
+ * locality of the memory accesses in loops over neighbors.
+ *
+ * The coordinates are scaled to the bounding box of the points and
+ * quantized on getNbBits(dim) bits per direction, so that a key fits in a
+ * CFuint. Points with the same key keep their original relative order.
+ */
+class MathTools_API SpaceFillingCurve
+{
+public:
+
+  /// @return the number of bits per direction used to quantize the coordinates
+  static CFuint getNbBits(const CFuint dim) {return 30/dim;}
+
+  /**
+   * Compute the Morton key of a point by interleaving the bits of its
+   * quantized coordinates
+   * @param coord   integer coordinates, each one smaller than 2^nbBits
+   * @param dim     number of coordinates
+   * @param nbBits  number of bits per coordinate
+   */
+  static CFuint mortonKey(const CFuint* coord, const CFuint dim, const CFuint nbBits);
+
+  /**
+   * Compute the Hilbert key of a point (Skilling's transpose algorithm)
+   * @param coord   integer coordinates, each one smaller than 2^nbBits
+   * @param dim     number of coordinates
+   * @param nbBits  number of bits per coordinate
+   */
+  static CFuint hilbertKey(const CFuint* coord, const CFuint dim, const CFuint nbBits);
+
+  /**
+   * Sort points along the curve
+   * @param coords      coordinates of the points, dim values per point
+   * @param dim         space dimension
+   * @param useHilbert  use the Hilbert curve, otherwise the Morton curve
+   * @param order       on output, order[i] is the ID of the i-th point along the curve
+   */
+  static void sortPoints(const std::vector<CFreal>& coords,
+			 const CFuint dim,
+			 const bool useHilbert,
+			 std::vector<CFuint>& order);
+
+}; // end of class SpaceFillingCurve
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace MathTools
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_MathTools_SpaceFillingCurve_hh
@@ -0,0 +1,122 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test memory mapped file"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "Common/FilesystemException.hh"
+#include "Common/MemoryMappedFile.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct MemoryMappedFile_Fixture
+{
+  /// common setup for each test case
+  MemoryMappedFile_Fixture() : fileName("utest-memoryMappedFile.bin")
+  {
+  }
+  /// common tear-down for each test case
+  ~MemoryMappedFile_Fixture()
+  {
+    std::remove(fileName.c_str());
+  }
+
+  /// write the given bytes into the test file
+  void writeFile(const vector<char>& bytes)
+  {
+    ofstream fout(fileName.c_str(), ios::out | ios::binary);
+    if (!bytes.empty()) fout.write(&bytes[0], bytes.size());
+  }
+
+  /// name of the test file
+  string fileName;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( MemoryMappedFile_TestSuite, MemoryMappedFile_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_content )
+{
+  // binary content, including zeros, as in the PARADE spectral cache
+  vector<char> bytes(100000);
+  for (CFuint i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<char>(i % 251);
+  }
+  writeFile(bytes);
+
+  MemoryMappedFile file;
+  BOOST_CHECK( !file.isOpen() );
+  file.open(fileName);
+  BOOST_CHECK( file.isOpen() );
+  BOOST_REQUIRE_EQUAL( file.size(), bytes.size() );
+  BOOST_CHECK( std::equal(bytes.begin(), bytes.end(), file.data()) );
+
+  file.close();
+  BOOST_CHECK( !file.isOpen() );
+  BOOST_CHECK_EQUAL( file.size(), (size_t)0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_reopen )
+{
+  vector<char> bytes(10, 'a');
+  writeFile(bytes);
+
+  MemoryMappedFile file;
+  file.open(fileName);
+  BOOST_CHECK_EQUAL( file.size(), (size_t)10 );
+
+  // opening again releases the previous mapping
+  bytes.assign(20, 'b');
+  writeFile(bytes);
+  file.open(fileName);
+  BOOST_REQUIRE_EQUAL( file.size(), (size_t)20 );
+  BOOST_CHECK_EQUAL( file.data()[19], 'b' );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_empty )
+{
+  writeFile(vector<char>());
+
+  MemoryMappedFile file;
+  file.open(fileName);
+  BOOST_CHECK( file.isOpen() );
+  BOOST_CHECK_EQUAL( file.size(), (size_t)0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_missing )
+{
+  MemoryMappedFile file;
+  BOOST_CHECK_THROW( file.open("utest-memoryMappedFile.missing"), FilesystemException );
+  BOOST_CHECK( !file.isOpen() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
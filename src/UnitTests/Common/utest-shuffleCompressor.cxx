@@ -0,0 +1,155 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test shuffle compressor"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstring>
+
+#include "Common/FilesystemException.hh"
+#include "Common/ShuffleCompressor.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct ShuffleCompressor_Fixture
+{
+  /// common setup for each test case
+  ShuffleCompressor_Fixture()
+  {
+  }
+  /// common tear-down for each test case
+  ~ShuffleCompressor_Fixture()
+  {
+  }
+
+  /// deterministic pseudo-random value in [-1,1]
+  CFreal random(CFuint& seed)
+  {
+    seed = seed*1103515245u + 12345u;
+    return 2.*((seed/65536u) % 32768u)/32767. - 1.;
+  }
+
+  /// smooth field with some noise, as the states of a mesh
+  void fillValues(const CFuint nbValues, vector<CFreal>& values)
+  {
+    CFuint seed = 19;
+    values.resize(nbValues);
+    for (CFuint i = 0; i < nbValues; ++i) {
+      values[i] = 101325.*(1. + 0.1*std::sin(1e-3*i)) + 1e-3*random(seed);
+    }
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ShuffleCompressor_TestSuite, ShuffleCompressor_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_roundTrip )
+{
+  vector<CFreal> values;
+  vector<char> out;
+  if (!ShuffleCompressor::isAvailable()) {
+    fillValues(10, values);
+    BOOST_CHECK_THROW( ShuffleCompressor::compress(reinterpret_cast<const char*>(&values[0]),
+						   values.size(), sizeof(CFreal), 6, out),
+		       FilesystemException );
+    return;
+  }
+
+  // the values are compressed as doubles, as 4 byte words and as bytes,
+  // after some bytes already in the output buffer
+  const CFuint nbValues[4] = {1, 7, 1000, 100000};
+  const CFuint valueSizes[3] = {1, 4, sizeof(CFreal)};
+  const int levels[2] = {1, 9};
+  for (CFuint n = 0; n < 4; ++n) {
+    fillValues(nbValues[n], values);
+    const char* data = reinterpret_cast<const char*>(&values[0]);
+    const size_t nbBytes = values.size()*sizeof(CFreal);
+    for (CFuint s = 0; s < 3; ++s) {
+      const size_t valueSize = valueSizes[s];
+      for (CFuint l = 0; l < 2; ++l) {
+	out.assign(3, 'h');
+	ShuffleCompressor::compress(data, nbBytes/valueSize, valueSize, levels[l], out);
+	BOOST_CHECK( out.size() > 3 );
+	BOOST_CHECK( out[0] == 'h' && out[1] == 'h' && out[2] == 'h' );
+
+	vector<char> result(nbBytes);
+	ShuffleCompressor::decompress(&out[3], out.size()-3, nbBytes/valueSize, valueSize, &result[0]);
+	BOOST_CHECK( memcmp(&result[0], data, nbBytes) == 0 );
+      }
+    }
+  }
+
+  // the shuffled doubles of a smooth field compress well
+  out.clear();
+  ShuffleCompressor::compress(reinterpret_cast<const char*>(&values[0]), values.size(),
+			      sizeof(CFreal), 6, out);
+  BOOST_CHECK( out.size() < values.size()*sizeof(CFreal)*3/4 );
+
+  // nothing is written for an empty array
+  out.clear();
+  ShuffleCompressor::compress(CFNULL, 0, sizeof(CFreal), 6, out);
+  BOOST_CHECK( out.empty() );
+  BOOST_CHECK_NO_THROW( ShuffleCompressor::decompress(CFNULL, 0, 0, sizeof(CFreal), CFNULL) );
+}
+
+BOOST_AUTO_TEST_CASE( test_corruptedData )
+{
+  if (!ShuffleCompressor::isAvailable()) return;
+
+  vector<CFreal> values;
+  fillValues(1000, values);
+  vector<char> out;
+  ShuffleCompressor::compress(reinterpret_cast<const char*>(&values[0]), values.size(),
+			      sizeof(CFreal), 6, out);
+  vector<CFreal> result(values.size()+1);
+  char* resultData = reinterpret_cast<char*>(&result[0]);
+
+  // truncated stream
+  BOOST_CHECK_THROW( ShuffleCompressor::decompress(&out[0], out.size()/2, values.size(),
+						   sizeof(CFreal), resultData),
+		     FilesystemException );
+
+  // more or fewer values than the compressed ones
+  BOOST_CHECK_THROW( ShuffleCompressor::decompress(&out[0], out.size(), values.size()+1,
+						   sizeof(CFreal), resultData),
+		     FilesystemException );
+  BOOST_CHECK_THROW( ShuffleCompressor::decompress(&out[0], out.size(), values.size()-1,
+						   sizeof(CFreal), resultData),
+		     FilesystemException );
+
+  // modified byte, detected by the zlib checksum
+  vector<char> corrupted(out);
+  corrupted[corrupted.size()/2] ^= 0x5a;
+  BOOST_CHECK_THROW( ShuffleCompressor::decompress(&corrupted[0], corrupted.size(), values.size(),
+						   sizeof(CFreal), resultData),
+		     FilesystemException );
+
+  // data which are not compressed at all
+  BOOST_CHECK_THROW( ShuffleCompressor::decompress(reinterpret_cast<const char*>(&values[0]),
+						   values.size()*sizeof(CFreal), values.size(),
+						   sizeof(CFreal), resultData),
+		     FilesystemException );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,191 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test asynchronous file writer"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/thread.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+
+#include "Common/FilesystemException.hh"
+#include "Common/StringOps.hh"
+#include "Framework/AsyncFileWriter.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// posts a file from another thread, to detect when post() blocks
+struct Poster
+{
+  Poster(const boost::filesystem::path& filepath, const std::string& content, bool& done) :
+    m_filepath(filepath), m_content(content), m_done(done)
+  {
+  }
+
+  void operator()()
+  {
+    AsyncFileWriter::getInstance().post(m_filepath, m_content);
+    m_done = true;
+  }
+
+  boost::filesystem::path m_filepath;
+  std::string m_content;
+  bool& m_done;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct AsyncFileWriter_Fixture
+{
+  /// common setup for each test case
+  AsyncFileWriter_Fixture() : dir("utest-asyncFileWriter.dir")
+  {
+    boost::filesystem::remove_all(dir);
+    boost::filesystem::create_directory(dir);
+  }
+  /// common tear-down for each test case
+  ~AsyncFileWriter_Fixture()
+  {
+    AsyncFileWriter::getInstance().setActive(false, 0);
+    boost::filesystem::remove_all(dir);
+  }
+
+  /// @return the content of the given file
+  std::string readFile(const boost::filesystem::path& filepath)
+  {
+    ifstream fin(filepath.string().c_str(), ios_base::in | ios_base::binary);
+    return std::string(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
+  }
+
+  /// directory of the written files
+  boost::filesystem::path dir;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( AsyncFileWriter_TestSuite, AsyncFileWriter_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_inactive )
+{
+  AsyncFileWriter& writer = AsyncFileWriter::getInstance();
+  writer.setActive(false, 0);
+  BOOST_CHECK( !writer.isActive() );
+
+  // the file is written before post() returns
+  std::string content = "inactive";
+  writer.post(dir / "a.txt", content);
+  BOOST_CHECK( content.empty() );
+  BOOST_CHECK_EQUAL( readFile(dir / "a.txt"), "inactive" );
+
+  content = "failure";
+  BOOST_CHECK_THROW( writer.post(dir / "none" / "a.txt", content), FilesystemException );
+}
+
+BOOST_AUTO_TEST_CASE( test_flushOrdering )
+{
+  AsyncFileWriter& writer = AsyncFileWriter::getInstance();
+  writer.setActive(true, 1024*1024);
+  BOOST_CHECK( writer.isActive() );
+
+  // the files are written in the order in which they are posted, so the
+  // last content posted for a path is the one found after the flush
+  const CFuint nbFiles = 20;
+  for (CFuint iPost = 0; iPost < 5; ++iPost) {
+    for (CFuint i = 0; i < nbFiles; ++i) {
+      std::string content = StringOps::to_str(i) + "-" + StringOps::to_str(iPost) + std::string(1000*i, 'x');
+      writer.post(dir / ("f" + StringOps::to_str(i)), content);
+      BOOST_CHECK( content.empty() );
+    }
+  }
+  writer.flush();
+
+  for (CFuint i = 0; i < nbFiles; ++i) {
+    BOOST_CHECK_EQUAL( readFile(dir / ("f" + StringOps::to_str(i))),
+		       StringOps::to_str(i) + "-4" + std::string(1000*i, 'x') );
+  }
+
+  // deactivating flushes the files posted so far
+  std::string content = "last";
+  writer.post(dir / "last.txt", content);
+  writer.setActive(false, 0);
+  BOOST_CHECK_EQUAL( readFile(dir / "last.txt"), "last" );
+}
+
+BOOST_AUTO_TEST_CASE( test_backpressure )
+{
+  AsyncFileWriter& writer = AsyncFileWriter::getInstance();
+  writer.setActive(true, 10);
+
+  // the background thread blocks on a FIFO until it is read, so the
+  // 6 bytes posted to it stay in the buffer
+  const boost::filesystem::path fifo = dir / "fifo";
+  BOOST_REQUIRE( mkfifo(fifo.string().c_str(), 0600) == 0 );
+  std::string content = "123456";
+  writer.post(fifo, content);
+
+  // 6 + 5 bytes exceed the buffer: post() waits for the FIFO to be drained
+  bool done = false;
+  boost::thread poster(Poster(dir / "b.txt", "abcde", done));
+  boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+  BOOST_CHECK( !done );
+
+  ifstream fin(fifo.string().c_str(), ios_base::in | ios_base::binary);
+  const std::string fifoContent((istreambuf_iterator<char>(fin)), istreambuf_iterator<char>());
+  BOOST_CHECK_EQUAL( fifoContent, "123456" );
+
+  poster.join();
+  BOOST_CHECK( done );
+  writer.flush();
+  BOOST_CHECK_EQUAL( readFile(dir / "b.txt"), "abcde" );
+
+  // a file larger than the buffer is accepted once the buffer is empty
+  content = std::string(100, 'y');
+  writer.post(dir / "c.txt", content);
+  writer.flush();
+  BOOST_CHECK_EQUAL( readFile(dir / "c.txt"), std::string(100, 'y') );
+}
+
+BOOST_AUTO_TEST_CASE( test_failure )
+{
+  AsyncFileWriter& writer = AsyncFileWriter::getInstance();
+  writer.setActive(true, 1024);
+
+  // the failure is reported by the next flush, the other files are written
+  std::string content = "failure";
+  writer.post(dir / "none" / "a.txt", content);
+  content = "success";
+  writer.post(dir / "b.txt", content);
+  BOOST_CHECK_THROW( writer.flush(), FilesystemException );
+  BOOST_CHECK_EQUAL( readFile(dir / "b.txt"), "success" );
+
+  // the failures are reported only once
+  BOOST_CHECK_NO_THROW( writer.flush() );
+
+  content = "failure";
+  writer.post(dir / "none" / "c.txt", content);
+  BOOST_CHECK_THROW( writer.setActive(false, 0), FilesystemException );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,123 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test graph coloring"
+
+#include <boost/test/unit_test.hpp>
+
+#include "MathTools/GraphColoring.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::MathTools;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct GraphColoring_Fixture
+{
+  /// common setup for each test case
+  GraphColoring_Fixture()
+  {
+  }
+  /// common tear-down for each test case
+  ~GraphColoring_Fixture()
+  {
+  }
+
+  /// faces of a 1D mesh of nbCells cells: face i joins cell i-1 and cell i,
+  /// the two boundary faces have a ghost (ID == nbCells) on one side
+  void build1DFaces(const CFuint nbCells, vector<CFuint>& ptr, vector<CFuint>& nodes)
+  {
+    const CFuint nbFaces = nbCells+1;
+    ptr.resize(nbFaces+1);
+    nodes.resize(2*nbFaces);
+    for (CFuint f = 0; f < nbFaces; ++f) {
+      ptr[f] = 2*f;
+      nodes[2*f]   = (f > 0) ? f-1 : nbCells;
+      nodes[2*f+1] = (f < nbCells) ? f : nbCells;
+    }
+    ptr[nbFaces] = 2*nbFaces;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( GraphColoring_TestSuite, GraphColoring_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_1DFaces )
+{
+  const CFuint nbCells = 10;
+  vector<CFuint> ptr;
+  vector<CFuint> nodes;
+  build1DFaces(nbCells, ptr, nodes);
+
+  vector<CFuint> colors;
+  const CFuint nbColors = GraphColoring::colorByNodes(nbCells+1, ptr, nodes, nbCells, colors);
+
+  // faces alternate between two colors, ghosts do not create conflicts
+  BOOST_CHECK_EQUAL( nbColors, 2u );
+  for (CFuint f = 0; f < colors.size(); ++f) {
+    BOOST_CHECK_EQUAL( colors[f], f%2 );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_noConflictInColor )
+{
+  // 2x2 quads sharing the central node, plus two isolated triangles
+  valarray<CFuint> pattern(4u, 6);
+  pattern[4] = pattern[5] = 3;
+  Common::ConnectivityTable<CFuint> cellNodes(pattern);
+  const CFuint conn[6][4] = {{0,1,4,3}, {1,2,5,4}, {3,4,7,6}, {4,5,8,7},
+			     {9,10,11,0}, {12,13,14,0}};
+  for (CFuint i = 0; i < 6; ++i) {
+    for (CFuint j = 0; j < pattern[i]; ++j) {
+      cellNodes(i,j) = conn[i][j];
+    }
+  }
+
+  vector<CFuint> colors;
+  const CFuint nbNodes = 15;
+  const CFuint nbColors = GraphColoring::colorByNodes(cellNodes, nbNodes, colors);
+  BOOST_CHECK_EQUAL( nbColors, 4u );
+
+  for (CFuint a = 0; a < 6; ++a) {
+    for (CFuint b = a+1; b < 6; ++b) {
+      if (colors[a] != colors[b]) continue;
+      for (CFuint i = 0; i < pattern[a]; ++i) {
+	for (CFuint j = 0; j < pattern[b]; ++j) {
+	  BOOST_CHECK( cellNodes(a,i) != cellNodes(b,j) );
+	}
+      }
+    }
+  }
+
+  vector<CFuint> colorPtr;
+  vector<CFuint> colorEntities;
+  GraphColoring::groupByColor(colors, nbColors, colorPtr, colorEntities);
+  BOOST_CHECK_EQUAL( colorPtr.size(), nbColors+1 );
+  BOOST_CHECK_EQUAL( colorPtr[nbColors], 6u );
+  for (CFuint c = 0; c < nbColors; ++c) {
+    for (CFuint k = colorPtr[c]; k < colorPtr[c+1]; ++k) {
+      BOOST_CHECK_EQUAL( colors[colorEntities[k]], c );
+      if (k > colorPtr[c]) {
+	BOOST_CHECK( colorEntities[k-1] < colorEntities[k] );
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,150 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test space filling curves"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+
+#include "MathTools/SpaceFillingCurve.hh"
+#include "MathTools/RCM.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::MathTools;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct SpaceFillingCurve_Fixture
+{
+  /// common setup for each test case
+  SpaceFillingCurve_Fixture()
+  {
+  }
+  /// common tear-down for each test case
+  ~SpaceFillingCurve_Fixture()
+  {
+  }
+
+  /// coordinates of the points of a structured grid with n points per direction,
+  /// numbered with the first direction running fastest
+  void buildGrid(const CFuint n, const CFuint dim, vector<CFreal>& coords)
+  {
+    CFuint nbPoints = 1;
+    for (CFuint d = 0; d < dim; ++d) nbPoints *= n;
+    coords.resize(nbPoints*dim);
+    for (CFuint i = 0; i < nbPoints; ++i) {
+      CFuint id = i;
+      for (CFuint d = 0; d < dim; ++d) {
+	coords[i*dim+d] = static_cast<CFreal>(id%n);
+	id /= n;
+      }
+    }
+  }
+
+  /// Manhattan distance between two grid points
+  CFuint distance(const vector<CFreal>& coords, const CFuint dim, const CFuint a, const CFuint b)
+  {
+    CFreal dist = 0.;
+    for (CFuint d = 0; d < dim; ++d) {
+      dist += std::abs(coords[a*dim+d] - coords[b*dim+d]);
+    }
+    return static_cast<CFuint>(dist + 0.5);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( SpaceFillingCurve_TestSuite, SpaceFillingCurve_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_HilbertUnitSquare )
+{
+  // first order curve: (0,0) -> (0,1) -> (1,1) -> (1,0)
+  const CFuint p[4][2] = {{0,0}, {0,1}, {1,1}, {1,0}};
+  for (CFuint i = 0; i < 4; ++i) {
+    BOOST_CHECK_EQUAL( SpaceFillingCurve::hilbertKey(p[i], 2, 1), i );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_HilbertNeighbors )
+{
+  // consecutive points along a Hilbert curve are always grid neighbors
+  for (CFuint dim = 2; dim <= 3; ++dim) {
+    vector<CFreal> coords;
+    buildGrid(8, dim, coords);
+    vector<CFuint> order;
+    SpaceFillingCurve::sortPoints(coords, dim, true, order);
+    BOOST_CHECK_EQUAL( order.size(), coords.size()/dim );
+    for (CFuint i = 1; i < order.size(); ++i) {
+      BOOST_CHECK_EQUAL( distance(coords, dim, order[i-1], order[i]), 1u );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_MortonPermutation )
+{
+  vector<CFreal> coords;
+  buildGrid(4, 2, coords);
+  vector<CFuint> order;
+  SpaceFillingCurve::sortPoints(coords, 2, false, order);
+
+  // the first four points along the Z curve fill the lower left quadrant
+  vector<bool> found(order.size(), false);
+  for (CFuint i = 0; i < order.size(); ++i) {
+    found[order[i]] = true;
+    if (i < 4) {
+      BOOST_CHECK( coords[order[i]*2] < 2. && coords[order[i]*2+1] < 2. );
+    }
+  }
+  for (CFuint i = 0; i < found.size(); ++i) {
+    BOOST_CHECK( found[i] );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_RCMGraph )
+{
+  // path graph numbered 0-2-4-1-3: RCM must give a bandwidth of one
+  const CFuint path[5] = {0, 2, 4, 1, 3};
+  vector<CFuint> ptr(6, 0);
+  vector<CFuint> adj;
+  for (CFuint v = 0; v < 5; ++v) {
+    for (CFuint k = 0; k < 5; ++k) {
+      if (path[k] != v) continue;
+      if (k > 0) adj.push_back(path[k-1]);
+      if (k < 4) adj.push_back(path[k+1]);
+    }
+    ptr[v+1] = adj.size();
+  }
+
+  vector<CFuint> order;
+  RCM::renumberGraph(ptr, adj, order);
+  BOOST_CHECK_EQUAL( order.size(), 5u );
+
+  vector<CFuint> newID(5);
+  for (CFuint i = 0; i < 5; ++i) {
+    newID[order[i]] = i;
+  }
+  for (CFuint v = 0; v < 5; ++v) {
+    for (CFuint i = ptr[v]; i < ptr[v+1]; ++i) {
+      const CFint band = static_cast<CFint>(newID[v]) - static_cast<CFint>(newID[adj[i]]);
+      BOOST_CHECK( band == 1 || band == -1 );
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////